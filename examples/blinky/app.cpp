@@ -35,28 +35,24 @@ extern "C" {
 
 
 App::App() : _interpreter(*this) {
+    // Constant queries, such as *IDN?, are answered over USBTMC
+    _interpreter.setResponseWriter(T76::Core::USB::Interface::usbtmcResponseWriter, &_usbInterface);
 }
 
-void App::_onUSBTMCDataReceived(const std::vector<uint8_t> &data, bool transfer_complete) {
-    for (const auto &byte : data) {
-        _interpreter.processInputCharacter(byte);
-    }
+void App::_onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) {
+    _interpreter.processInput(data, length);
 
     if (transfer_complete) {
         _interpreter.processInputCharacter('\n'); // Finalize the command if transfer is complete
     }
 }
 
-void App::_queryIDN(const std::vector<T76::SCPI::ParameterValue> &params) {
-    _usbInterface.sendUSBTMCBulkData("MTA Inc.,T76-Dev,0001,1.0");
-}
-
-void App::_resetInstrument(const std::vector<T76::SCPI::ParameterValue> &params) {
+void App::_resetInstrument(T76::SCPI::Parameters params) {
     _interpreter.reset();
     _ledState = LEDState::OFF;
 }
 
-void App::_setLEDState(const std::vector<T76::SCPI::ParameterValue> &params) {
+void App::_setLEDState(T76::SCPI::Parameters params) {
     LEDState newState = StringToLEDState(params[0].stringValue);
 
     if (newState == LEDState::OFF || newState == LEDState::ON || newState == LEDState::BLINK) {
@@ -66,15 +62,43 @@ void App::_setLEDState(const std::vector<T76::SCPI::ParameterValue> &params) {
     }
 }
 
-void App::_queryLEDState(const std::vector<T76::SCPI::ParameterValue> &params) {
+void App::_queryLEDState(T76::SCPI::Parameters params) {
     std::string stateStr = std::string(LEDStateToString(_ledState));
     _usbInterface.sendUSBTMCBulkData(stateStr);
 }
 
-void App::_crashSystem(const std::vector<T76::SCPI::ParameterValue> &params) {
+void App::_crashSystem(T76::SCPI::Parameters params) {
     triggerMemManageFault();
 }
 
+void App::_queryMemoryStats(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(T76::Core::Memory::allocationStatsReport());
+}
+
+void App::_queryMemoryTasks(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(T76::Core::Memory::taskAllocationStatsReport());
+}
+
+void App::_queryMemoryHistogram(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(T76::Core::Memory::allocationHistogramReport());
+}
+
+void App::_resetMemoryStats(T76::SCPI::Parameters params) {
+    T76::Core::Memory::resetAllocationStats();
+}
+
+void App::_queryUSBStats(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(_usbInterface.statsReport());
+}
+
+void App::_queryUSBLatency(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(_usbInterface.dispatchLatencyReport());
+}
+
+void App::_resetUSBStats(T76::SCPI::Parameters params) {
+    _usbInterface.resetStats();
+}
+
 bool App::activate() {
     return true;
 }
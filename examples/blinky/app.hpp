@@ -58,13 +58,19 @@ namespace T76 {
 
         App();
 
-        void _onUSBTMCDataReceived(const std::vector<uint8_t> &data, bool transfer_complete) override;
-
-        void _queryIDN(const std::vector<T76::SCPI::ParameterValue> &params);
-        void _resetInstrument(const std::vector<T76::SCPI::ParameterValue> &params);
-        void _setLEDState(const std::vector<T76::SCPI::ParameterValue> &params);
-        void _queryLEDState(const std::vector<T76::SCPI::ParameterValue> &params);
-        void _crashSystem(const std::vector<T76::SCPI::ParameterValue> &params);
+        void _onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) override;
+
+        void _resetInstrument(T76::SCPI::Parameters params);
+        void _setLEDState(T76::SCPI::Parameters params);
+        void _queryLEDState(T76::SCPI::Parameters params);
+        void _crashSystem(T76::SCPI::Parameters params);
+        void _queryMemoryStats(T76::SCPI::Parameters params);
+        void _queryMemoryTasks(T76::SCPI::Parameters params);
+        void _queryMemoryHistogram(T76::SCPI::Parameters params);
+        void _resetMemoryStats(T76::SCPI::Parameters params);
+        void _queryUSBStats(T76::SCPI::Parameters params);
+        void _queryUSBLatency(T76::SCPI::Parameters params);
+        void _resetUSBStats(T76::SCPI::Parameters params);
 
         bool activate();
         void makeSafe();
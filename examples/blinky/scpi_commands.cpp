@@ -13,11 +13,17 @@
 namespace T76 {
     class App {
     public:
-        void _queryIDN(const std::vector<T76::SCPI::ParameterValue> &);
-        void _resetInstrument(const std::vector<T76::SCPI::ParameterValue> &);
-        void _setLEDState(const std::vector<T76::SCPI::ParameterValue> &);
-        void _crashSystem(const std::vector<T76::SCPI::ParameterValue> &);
-        void _queryLEDState(const std::vector<T76::SCPI::ParameterValue> &);
+        void _resetInstrument(T76::SCPI::Parameters);
+        void _setLEDState(T76::SCPI::Parameters);
+        void _crashSystem(T76::SCPI::Parameters);
+        void _queryLEDState(T76::SCPI::Parameters);
+        void _queryMemoryStats(T76::SCPI::Parameters);
+        void _queryMemoryTasks(T76::SCPI::Parameters);
+        void _queryMemoryHistogram(T76::SCPI::Parameters);
+        void _resetMemoryStats(T76::SCPI::Parameters);
+        void _queryUSBStats(T76::SCPI::Parameters);
+        void _queryUSBLatency(T76::SCPI::Parameters);
+        void _resetUSBStats(T76::SCPI::Parameters);
     };
 }
 
@@ -27,134 +33,239 @@ namespace T76::SCPI {
  * Memory Usage Estimate:
  * 
  * Trie Structure:
- *   - Total nodes: 29
- *   - Children arrays: 24
- *   - Node size: 8 bytes each
- *   - Trie memory: 232 bytes
+ *   - Total nodes: 81
+ *   - Children arrays: 38
+ *   - Dense table filler nodes: 0 (0 bytes)
+ *   - Node size: 12 bytes each
+ *   - Compressed segments: 53 bytes
+ *   - Trie memory: 972 bytes
  * 
  * Command System:
- *   - Commands: 5 (60 bytes)
+ *   - Commands: 12 of up to 65535 (384 bytes)
+ *   - Index widths: 16-bit command index, 8-bit child count (no size cost, both fit the node's padding)
+ *   - Dispatch: handler pointers in the command table
  *   - Parameter descriptors: 16 bytes
  *   - String literals: 13 bytes
  * 
  * Total Memory Usage:
- *   - Code/Data (Flash): 321 bytes (0.01% of 2MB)
- *   - Runtime (SRAM): 64 bytes (0.01% of 264KB)
+ *   - Code/Data (Flash): 1438 bytes (0.03% of 2MB)
+ *   - Runtime (SRAM): 96 bytes (0.02% of 264KB)
+ *   - Parameter storage: 32 bytes, allocated once, included in runtime
  * 
  * Performance Characteristics:
- *   - Average lookup depth: ~7.7 character comparisons
- *   - Memory access pattern: Sequential (cache-friendly)
+ *   - Average lookup depth: ~6.0 node transitions
+ *   - Child lookups: 38 linear, 0 binary search, 0 dense
+ *   - Average character comparisons: 21.2 (21.2 with linear scans only)
  *   - Space complexity: O(total_command_chars)
  */    // Parameter descriptors for each command
-    const char* const command_2_param_0_choices[] = {
+    constexpr const char* command_2_param_0_choices[] = {
         "ON",
         "OFF",
         "BLINK",
     };
 
-    const ParameterDescriptor command_2_params[] = {
+    constexpr ParameterDescriptor command_2_params[] = {
         {
             .type = ParameterType::Enum,
             .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
             .choiceCount = 3,
             .choices = command_2_param_0_choices
         },
     };
 
+    static std::string_view command_0_constant(T76::App &) {
+        return std::string_view("MTA Inc.,T76-Dev,0001,1.0", 25);
+    }
+
+    // Segments of path-compressed trie nodes
+    template<>
+    constinit const char T76::SCPI::Interpreter<T76::App>::_trieSegments[] = "DN?STED:STATYSCRASHEMSTICS?ASKISTGRAM?ESRY:SB:NCY?M:";
+
     // Trie structure
-    const TrieNode _node__starIDN_children[] = {
-        { '?', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 0 } // Terminal: *IDN?
+    constexpr TrieNode _node__star_children[] = {
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 3, nullptr, 0, 0 }, // Terminal: *IDN?
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 0, 2, nullptr, 3, 1 } // Terminal: *RST
+    };
+    constexpr TrieNode _node_LED_colonSTATE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 4 } // Terminal: LED:STATe?
+    };
+    constexpr TrieNode _node_LED_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 4 }, // Terminal: LED:STATe?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 1, 0, _node_LED_colonSTATE_children, 0, 2 } // Terminal: LED:STATe
+    };
+    constexpr TrieNode _node_SYST_colonMEM_colonHIST_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 7 }, // Terminal: SYSTem:MEMory:HISTogram?
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 33, 7 } // Terminal: SYSTem:MEMory:HISTogram?
+    };
+    constexpr TrieNode _node_SYST_colonMEM_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 8 } // Terminal: SYSTem:MEMory:RESet
+    };
+    constexpr TrieNode _node_SYST_colonMEM_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 5 }, // Terminal: SYSTem:MEMory:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 21, 5 } // Terminal: SYSTem:MEMory:STATistics?
+    };
+    constexpr TrieNode _node_SYST_colonMEM_colonTASK_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 6 }, // Terminal: SYSTem:MEMory:TASKs?
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 6 } // Terminal: SYSTem:MEMory:TASKs?
+    };
+    constexpr TrieNode _node_SYST_colonMEM_colon_children[] = {
+        { 'H', 0, 2, 3, _node_SYST_colonMEM_colonHIST_children, 30, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYST_colonMEM_colonRES_children, 38, 8 }, // Terminal: SYSTem:MEMory:RESet
+        { 'S', 0, 2, 3, _node_SYST_colonMEM_colonSTAT_children, 9, 0 },
+        { 'T', 0, 2, 3, _node_SYST_colonMEM_colonTASK_children, 27, 0 }
     };
-    const TrieNode _node__starID_children[] = {
-        { 'N', 0, 1, _node__starIDN_children, 0 }
+    constexpr TrieNode _node_SYST_colonMEMORY_colonHIST_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 7 }, // Terminal: SYSTem:MEMory:HISTogram?
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 33, 7 } // Terminal: SYSTem:MEMory:HISTogram?
     };
-    const TrieNode _node__starI_children[] = {
-        { 'D', 0, 1, _node__starID_children, 0 }
+    constexpr TrieNode _node_SYST_colonMEMORY_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 8 } // Terminal: SYSTem:MEMory:RESet
     };
-    const TrieNode _node__starRS_children[] = {
-        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 1 } // Terminal: *RST
+    constexpr TrieNode _node_SYST_colonMEMORY_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 5 }, // Terminal: SYSTem:MEMory:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 21, 5 } // Terminal: SYSTem:MEMory:STATistics?
     };
-    const TrieNode _node__starR_children[] = {
-        { 'S', 0, 1, _node__starRS_children, 0 }
+    constexpr TrieNode _node_SYST_colonMEMORY_colonTASK_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 6 }, // Terminal: SYSTem:MEMory:TASKs?
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 6 } // Terminal: SYSTem:MEMory:TASKs?
     };
-    const TrieNode _node__star_children[] = {
-        { 'I', 0, 1, _node__starI_children, 0 },
-        { 'R', 0, 1, _node__starR_children, 0 }
+    constexpr TrieNode _node_SYST_colonMEMORY_colon_children[] = {
+        { 'H', 0, 2, 3, _node_SYST_colonMEMORY_colonHIST_children, 30, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYST_colonMEMORY_colonRES_children, 38, 8 }, // Terminal: SYSTem:MEMory:RESet
+        { 'S', 0, 2, 3, _node_SYST_colonMEMORY_colonSTAT_children, 9, 0 },
+        { 'T', 0, 2, 3, _node_SYST_colonMEMORY_colonTASK_children, 27, 0 }
     };
-    const TrieNode _node_LED_colonSTATE_children[] = {
-        { '?', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 4 } // Terminal: LED:STATe?
+    constexpr TrieNode _node_SYST_colonMEM_children[] = {
+        { ':', 0, 4, 0, _node_SYST_colonMEM_colon_children, 0, 0 },
+        { 'O', 0, 4, 3, _node_SYST_colonMEMORY_colon_children, 40, 0 }
     };
-    const TrieNode _node_LED_colonSTAT_children[] = {
-        { '?', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 4 }, // Terminal: LED:STATe?
-        { 'E', uint8_t(TrieNodeFlags::Terminal), 1, _node_LED_colonSTATE_children, 2 } // Terminal: LED:STATe
+    constexpr TrieNode _node_SYST_colonUSB_colonLAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 10 }, // Terminal: SYSTem:USB:LATency?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 46, 10 } // Terminal: SYSTem:USB:LATency?
     };
-    const TrieNode _node_LED_colonSTA_children[] = {
-        { 'T', uint8_t(TrieNodeFlags::Terminal), 2, _node_LED_colonSTAT_children, 2 } // Terminal: LED:STATe
+    constexpr TrieNode _node_SYST_colonUSB_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 11 } // Terminal: SYSTem:USB:RESet
     };
-    const TrieNode _node_LED_colonST_children[] = {
-        { 'A', 0, 1, _node_LED_colonSTA_children, 0 }
+    constexpr TrieNode _node_SYST_colonUSB_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 9 }, // Terminal: SYSTem:USB:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 21, 9 } // Terminal: SYSTem:USB:STATistics?
     };
-    const TrieNode _node_LED_colonS_children[] = {
-        { 'T', 0, 1, _node_LED_colonST_children, 0 }
+    constexpr TrieNode _node_SYST_colonUSB_colon_children[] = {
+        { 'L', 0, 2, 2, _node_SYST_colonUSB_colonLAT_children, 10, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYST_colonUSB_colonRES_children, 38, 11 }, // Terminal: SYSTem:USB:RESet
+        { 'S', 0, 2, 3, _node_SYST_colonUSB_colonSTAT_children, 9, 0 }
     };
-    const TrieNode _node_LED_colon_children[] = {
-        { 'S', 0, 1, _node_LED_colonS_children, 0 }
+    constexpr TrieNode _node_SYST_colon_children[] = {
+        { 'M', 0, 2, 2, _node_SYST_colonMEM_children, 19, 0 },
+        { 'U', 0, 3, 3, _node_SYST_colonUSB_colon_children, 43, 0 }
     };
-    const TrieNode _node_LED_children[] = {
-        { ':', 0, 1, _node_LED_colon_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonMEM_colonHIST_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 7 }, // Terminal: SYSTem:MEMory:HISTogram?
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 33, 7 } // Terminal: SYSTem:MEMory:HISTogram?
     };
-    const TrieNode _node_LE_children[] = {
-        { 'D', 0, 1, _node_LED_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonMEM_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 8 } // Terminal: SYSTem:MEMory:RESet
     };
-    const TrieNode _node_L_children[] = {
-        { 'E', 0, 1, _node_LE_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonMEM_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 5 }, // Terminal: SYSTem:MEMory:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 21, 5 } // Terminal: SYSTem:MEMory:STATistics?
     };
-    const TrieNode _node_SYS_colonCRAS_children[] = {
-        { 'H', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 3 } // Terminal: SYS:CRASH
+    constexpr TrieNode _node_SYSTEM_colonMEM_colonTASK_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 6 }, // Terminal: SYSTem:MEMory:TASKs?
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 6 } // Terminal: SYSTem:MEMory:TASKs?
     };
-    const TrieNode _node_SYS_colonCRA_children[] = {
-        { 'S', 0, 1, _node_SYS_colonCRAS_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonMEM_colon_children[] = {
+        { 'H', 0, 2, 3, _node_SYSTEM_colonMEM_colonHIST_children, 30, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYSTEM_colonMEM_colonRES_children, 38, 8 }, // Terminal: SYSTem:MEMory:RESet
+        { 'S', 0, 2, 3, _node_SYSTEM_colonMEM_colonSTAT_children, 9, 0 },
+        { 'T', 0, 2, 3, _node_SYSTEM_colonMEM_colonTASK_children, 27, 0 }
     };
-    const TrieNode _node_SYS_colonCR_children[] = {
-        { 'A', 0, 1, _node_SYS_colonCRA_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonMEMORY_colonHIST_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 7 }, // Terminal: SYSTem:MEMory:HISTogram?
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 33, 7 } // Terminal: SYSTem:MEMory:HISTogram?
     };
-    const TrieNode _node_SYS_colonC_children[] = {
-        { 'R', 0, 1, _node_SYS_colonCR_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonMEMORY_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 8 } // Terminal: SYSTem:MEMory:RESet
     };
-    const TrieNode _node_SYS_colon_children[] = {
-        { 'C', 0, 1, _node_SYS_colonC_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonMEMORY_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 5 }, // Terminal: SYSTem:MEMory:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 21, 5 } // Terminal: SYSTem:MEMory:STATistics?
     };
-    const TrieNode _node_SYS_children[] = {
-        { ':', 0, 1, _node_SYS_colon_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonMEMORY_colonTASK_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 6 }, // Terminal: SYSTem:MEMory:TASKs?
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 6 } // Terminal: SYSTem:MEMory:TASKs?
     };
-    const TrieNode _node_SY_children[] = {
-        { 'S', 0, 1, _node_SYS_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonMEMORY_colon_children[] = {
+        { 'H', 0, 2, 3, _node_SYSTEM_colonMEMORY_colonHIST_children, 30, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYSTEM_colonMEMORY_colonRES_children, 38, 8 }, // Terminal: SYSTem:MEMory:RESet
+        { 'S', 0, 2, 3, _node_SYSTEM_colonMEMORY_colonSTAT_children, 9, 0 },
+        { 'T', 0, 2, 3, _node_SYSTEM_colonMEMORY_colonTASK_children, 27, 0 }
     };
-    const TrieNode _node_S_children[] = {
-        { 'Y', 0, 1, _node_SY_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonMEM_children[] = {
+        { ':', 0, 4, 0, _node_SYSTEM_colonMEM_colon_children, 0, 0 },
+        { 'O', 0, 4, 3, _node_SYSTEM_colonMEMORY_colon_children, 40, 0 }
     };
-    const TrieNode _root_children[] = {
-        { '*', 0, 2, _node__star_children, 0 },
-        { 'L', 0, 1, _node_L_children, 0 },
-        { 'S', 0, 1, _node_S_children, 0 }
+    constexpr TrieNode _node_SYSTEM_colonUSB_colonLAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 10 }, // Terminal: SYSTem:USB:LATency?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 46, 10 } // Terminal: SYSTem:USB:LATency?
+    };
+    constexpr TrieNode _node_SYSTEM_colonUSB_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 11 } // Terminal: SYSTem:USB:RESet
+    };
+    constexpr TrieNode _node_SYSTEM_colonUSB_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 9 }, // Terminal: SYSTem:USB:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 21, 9 } // Terminal: SYSTem:USB:STATistics?
+    };
+    constexpr TrieNode _node_SYSTEM_colonUSB_colon_children[] = {
+        { 'L', 0, 2, 2, _node_SYSTEM_colonUSB_colonLAT_children, 10, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYSTEM_colonUSB_colonRES_children, 38, 11 }, // Terminal: SYSTem:USB:RESet
+        { 'S', 0, 2, 3, _node_SYSTEM_colonUSB_colonSTAT_children, 9, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colon_children[] = {
+        { 'M', 0, 2, 2, _node_SYSTEM_colonMEM_children, 19, 0 },
+        { 'U', 0, 3, 3, _node_SYSTEM_colonUSB_colon_children, 43, 0 }
+    };
+    constexpr TrieNode _node_SYST_children[] = {
+        { ':', 0, 2, 0, _node_SYST_colon_children, 0, 0 },
+        { 'E', 0, 2, 2, _node_SYSTEM_colon_children, 50, 0 }
+    };
+    constexpr TrieNode _node_SYS_children[] = {
+        { ':', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 14, 3 }, // Terminal: SYS:CRASH
+        { 'T', 0, 2, 0, _node_SYST_children, 0, 0 }
+    };
+    constexpr TrieNode _root_children[] = {
+        { '*', 0, 2, 0, _node__star_children, 0, 0 },
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 2, 7, _node_LED_colonSTAT_children, 5, 2 }, // Terminal: LED:STATe
+        { 'S', 0, 2, 2, _node_SYS_children, 12, 0 }
     };
     template<>
-    const TrieNode T76::SCPI::Interpreter<T76::App>::_trie = { '\0', 0, 3, _root_children, 0 };
+    constinit const TrieNode T76::SCPI::Interpreter<T76::App>::_trie = { '\0', 0, 3, 0, _root_children, 0, 0 };
 
     // Command handlers and parameters
     template<>
-    const Command<T76::App> T76::SCPI::Interpreter<T76::App>::_commands[] = {
-        { &T76::App::_queryIDN, 0, nullptr }, // *IDN?
-        { &T76::App::_resetInstrument, 0, nullptr }, // *RST
-        { &T76::App::_setLEDState, 1, command_2_params }, // LED:STATe
-        { &T76::App::_crashSystem, 0, nullptr }, // SYS:CRASH
-        { &T76::App::_queryLEDState, 0, nullptr }, // LED:STATe?
+    constinit const Command<T76::App> T76::SCPI::Interpreter<T76::App>::_commands[] = {
+        { nullptr, 0, nullptr, nullptr, nullptr, command_0_constant }, // 0: *IDN?
+        { &T76::App::_resetInstrument, 0, nullptr, nullptr, nullptr, nullptr }, // 1: *RST
+        { &T76::App::_setLEDState, 1, command_2_params, nullptr, nullptr, nullptr }, // 2: LED:STATe
+        { &T76::App::_crashSystem, 0, nullptr, nullptr, nullptr, nullptr }, // 3: SYS:CRASH
+        { &T76::App::_queryLEDState, 0, nullptr, nullptr, nullptr, nullptr }, // 4: LED:STATe?
+        { &T76::App::_queryMemoryStats, 0, nullptr, nullptr, nullptr, nullptr }, // 5: SYSTem:MEMory:STATistics?
+        { &T76::App::_queryMemoryTasks, 0, nullptr, nullptr, nullptr, nullptr }, // 6: SYSTem:MEMory:TASKs?
+        { &T76::App::_queryMemoryHistogram, 0, nullptr, nullptr, nullptr, nullptr }, // 7: SYSTem:MEMory:HISTogram?
+        { &T76::App::_resetMemoryStats, 0, nullptr, nullptr, nullptr, nullptr }, // 8: SYSTem:MEMory:RESet
+        { &T76::App::_queryUSBStats, 0, nullptr, nullptr, nullptr, nullptr }, // 9: SYSTem:USB:STATistics?
+        { &T76::App::_queryUSBLatency, 0, nullptr, nullptr, nullptr, nullptr }, // 10: SYSTem:USB:LATency?
+        { &T76::App::_resetUSBStats, 0, nullptr, nullptr, nullptr, nullptr }, // 11: SYSTem:USB:RESet
     };
 
     template<>
-    const size_t T76::SCPI::Interpreter<T76::App>::_commandCount = 5;
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_commandCount = 12;
+
+    template<>
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_maxParameterCount = 1;
 
     template<>
-    const size_t T76::SCPI::Interpreter<T76::App>::_maxParameterCount = 1;
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_maxStringParameterCount = 0;
 
 } // namespace
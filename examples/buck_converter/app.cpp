@@ -11,67 +11,453 @@
 #include <task.h>
 #include <tusb.h>
 
+#include <t76/acquisition_stream.hpp>
+#include <t76/boot_profile.hpp>
+#include <t76/executive.hpp>
+#include <t76/settings.hpp>
+#include <t76/timebase.hpp>
+
 
 using namespace T76;
 
 
+namespace {
+
+    // *SAV and *RCL slots are stored under consecutive settings keys
+    constexpr uint32_t stateSlotKeyBase = 0x0100;
+    constexpr uint32_t stateSlotCount = 10;
+
+    struct SavedState {
+        float kP;
+        float kI;
+        float kD;
+        float setPoint;
+    };
+
+    bool stateSlotKey(double slot, uint32_t &key) {
+        if (slot < 0 || slot >= stateSlotCount || slot != static_cast<uint32_t>(slot)) {
+            return false;
+        }
+
+        key = stateSlotKeyBase + static_cast<uint32_t>(slot);
+        return true;
+    }
+
+    bool jobIndex(double job, std::size_t &index) {
+        if (job < 0 || job >= T76::Core::Executive::jobCount() || job != static_cast<uint32_t>(job)) {
+            return false;
+        }
+
+        index = static_cast<std::size_t>(job);
+        return true;
+    }
+
+} // namespace
+
+
 App::App() : _interpreter(*this) {
+    // Constant queries, such as *IDN?, are answered over USBTMC
+    _interpreter.setResponseWriter(T76::Core::USB::Interface::usbtmcResponseWriter, &_usbInterface);
 }
 
-void App::_onUSBTMCDataReceived(const std::vector<uint8_t> &data, bool transfer_complete) {
-    for (const auto &byte : data) {
-        _interpreter.processInputCharacter(byte);
-    }
+void App::_onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) {
+    _interpreter.processInput(data, length);
 
     if (transfer_complete) {
         _interpreter.processInputCharacter('\n'); // Finalize the command if transfer is complete
     }
 }
 
-void App::_queryIDN(const std::vector<T76::SCPI::ParameterValue> &params) {
-    _usbInterface.sendUSBTMCBulkData("MTA Inc.,T76-Dev,0001,1.0");
+void App::_resetInstrument(T76::SCPI::Parameters params) {
+    _interpreter.reset();
 }
 
-void App::_resetInstrument(const std::vector<T76::SCPI::ParameterValue> &params) {
-    _interpreter.reset();
+void App::_saveState(double slot) {
+    uint32_t key;
+
+    if (!stateSlotKey(slot, key)) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    const SavedState state = {
+        .kP = _buckConverter.kP(),
+        .kI = _buckConverter.kI(),
+        .kD = _buckConverter.kD(),
+        .setPoint = _buckConverter.setPoint(),
+    };
+
+    if (!T76::Core::Settings::set(key, state)) {
+        _interpreter.addError(-310, "System error; settings store full");
+    }
 }
 
-void App::_setKp(const std::vector<T76::SCPI::ParameterValue> &params) {
-    _buckConverter.kP(static_cast<float>(params[0].numberValue));
+void App::_recallState(double slot) {
+    uint32_t key;
+    SavedState state;
+
+    if (!stateSlotKey(slot, key)) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    if (!T76::Core::Settings::get(key, state)) {
+        _interpreter.addError(-224, "Illegal parameter value; slot is empty");
+        return;
+    }
+
+    _buckConverter.kP(state.kP);
+    _buckConverter.kI(state.kI);
+    _buckConverter.kD(state.kD);
+    _buckConverter.setPoint(state.setPoint);
+}
+
+void App::_setKp(double value) {
+    _buckConverter.kP(static_cast<float>(value));
 }
 
-void App::_queryKp(const std::vector<T76::SCPI::ParameterValue> &params) {
+void App::_queryKp(T76::SCPI::Parameters params) {
     _usbInterface.sendUSBTMCBulkData(std::to_string(_buckConverter.kP()));
 }
 
-void App::_setKi(const std::vector<T76::SCPI::ParameterValue> &params) {
-    _buckConverter.kI(static_cast<float>(params[0].numberValue));
+void App::_setKi(double value) {
+    _buckConverter.kI(static_cast<float>(value));
 }
 
-void App::_queryKi(const std::vector<T76::SCPI::ParameterValue> &params) {
+void App::_queryKi(T76::SCPI::Parameters params) {
     _usbInterface.sendUSBTMCBulkData(std::to_string(_buckConverter.kI()));
 }
 
-void App::_setKd(const std::vector<T76::SCPI::ParameterValue> &params) {
-    _buckConverter.kD(static_cast<float>(params[0].numberValue));
+void App::_setKd(double value) {
+    _buckConverter.kD(static_cast<float>(value));
 }
 
-void App::_queryKd(const std::vector<T76::SCPI::ParameterValue> &params) {
+void App::_queryKd(T76::SCPI::Parameters params) {
     _usbInterface.sendUSBTMCBulkData(std::to_string(_buckConverter.kD()));
 }
 
-void App::_setTargetVoltage(const std::vector<T76::SCPI::ParameterValue> &params) {
-    _buckConverter.setPoint(static_cast<float>(params[0].numberValue));
+void App::_setTargetVoltage(double value) {
+    _buckConverter.setPoint(static_cast<float>(value));
 }
 
-void App::_queryTargetVoltage(const std::vector<T76::SCPI::ParameterValue> &params) {
+void App::_queryTargetVoltage(T76::SCPI::Parameters params) {
     _usbInterface.sendUSBTMCBulkData(std::to_string(_buckConverter.setPoint()));
 }
 
-void App::_querySensedVoltage(const std::vector<T76::SCPI::ParameterValue> &params) {
+void App::_querySensedVoltage(T76::SCPI::Parameters params) {
     _usbInterface.sendUSBTMCBulkData(std::to_string(_buckConverter.sensedVoltage()));
 }
 
+void App::_queryTickStats(T76::SCPI::Parameters params) {
+    const T76::Core::Executive::ExecutiveStats stats = T76::Core::Executive::stats();
+    char buffer[64];
+
+    snprintf(buffer, sizeof(buffer), "%lu,%lu,%lu,%lu,%lu",
+             (unsigned long)stats.tickRateHz, (unsigned long)stats.ticks, (unsigned long)stats.lateTicks,
+             (unsigned long)stats.maxTickCycles, (unsigned long)stats.cyclesPerTick);
+
+    _usbInterface.sendUSBTMCBulkData(std::string(buffer));
+}
+
+void App::_queryJobCount(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(std::to_string(T76::Core::Executive::jobCount()));
+}
+
+void App::_queryJobStats(double job) {
+    std::size_t index;
+    T76::Core::Executive::JobStats stats;
+
+    if (!jobIndex(job, index) || !T76::Core::Executive::jobStats(index, stats)) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    char buffer[160];
+
+    snprintf(buffer, sizeof(buffer), "\"%s\",%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu",
+             stats.name, (unsigned long)stats.runs, (unsigned long)stats.overruns,
+             (unsigned long)stats.consecutiveOverruns, (unsigned long)stats.maxConsecutiveOverruns, (unsigned long)stats.limitHits,
+             (unsigned long)stats.lastCycles, (unsigned long)stats.minCycles, (unsigned long)stats.meanCycles,
+             (unsigned long)stats.maxCycles, (unsigned long)stats.maxJitterCycles, (unsigned long)stats.budgetCycles);
+
+    _usbInterface.sendUSBTMCBulkData(std::string(buffer));
+}
+
+void App::_queryJobHistogram(double job) {
+    std::size_t index;
+    T76::Core::Executive::JobStats stats;
+
+    if (!jobIndex(job, index) || !T76::Core::Executive::jobStats(index, stats)) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    std::string response;
+
+    for (uint32_t count : stats.jitterHistogram) {
+        if (!response.empty()) {
+            response += ',';
+        }
+
+        response += std::to_string(count);
+    }
+
+    _usbInterface.sendUSBTMCBulkData(response);
+}
+
+void App::_setJobOverrunLimit(T76::SCPI::Parameters params) {
+    std::size_t index;
+    const double count = params[1].numberValue;
+
+    if (!jobIndex(params[0].numberValue, index) || count < 0 || count > UINT32_MAX || count != static_cast<uint32_t>(count)) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    // The choices are WARN, WARNING and FAULT
+    const T76::Core::Executive::OverrunAction action = params[2].enumIndex == 2 ?
+        T76::Core::Executive::OverrunAction::Fault : T76::Core::Executive::OverrunAction::Warn;
+
+    T76::Core::Executive::setOverrunLimit(index, static_cast<uint32_t>(count), action);
+}
+
+void App::_queryJobOverrunLimit(double job) {
+    std::size_t index;
+    T76::Core::Executive::JobStats stats;
+
+    if (!jobIndex(job, index) || !T76::Core::Executive::jobStats(index, stats)) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    const char *action = stats.overrunAction == T76::Core::Executive::OverrunAction::Fault ? "FAULT" : "WARN";
+
+    _usbInterface.sendUSBTMCBulkData(std::to_string(stats.overrunLimit) + "," + action);
+}
+
+void App::_resetExecutiveStats(T76::SCPI::Parameters params) {
+    T76::Core::Executive::resetStats();
+}
+
+void App::_queryTasks(T76::SCPI::Parameters params) {
+    T76::Core::TaskMonitor::TaskSample tasks[T76_IC_TASK_MONITOR_MAX_TASKS];
+    const std::size_t count = T76::Core::TaskMonitor::copyTasks(tasks, T76_IC_TASK_MONITOR_MAX_TASKS);
+    std::string response;
+
+    for (std::size_t i = 0; i < count; i++) {
+        char buffer[configMAX_TASK_NAME_LEN + 40];
+
+        snprintf(buffer, sizeof(buffer), "%s\"%s\",%u,%lu,%u", i ? "," : "", tasks[i].name, tasks[i].priority,
+                 (unsigned long)tasks[i].stackFreeBytes, tasks[i].loadPermille);
+        response += buffer;
+    }
+
+    _usbInterface.sendUSBTMCBulkData(response);
+}
+
+void App::_queryLoad(T76::SCPI::Parameters params) {
+    const T76::Core::TaskMonitor::Summary summary = T76::Core::TaskMonitor::summary();
+    char buffer[48];
+
+    if (summary.samples < 2) {
+        snprintf(buffer, sizeof(buffer), "9.91E37,9.91E37");
+    } else if (!summary.core1Valid) {
+        snprintf(buffer, sizeof(buffer), "%.1f,9.91E37", summary.core0LoadPermille / 10.0);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%.1f,%.1f", summary.core0LoadPermille / 10.0, summary.core1LoadPermille / 10.0);
+    }
+
+    _usbInterface.sendUSBTMCBulkData(std::string(buffer));
+}
+
+void App::_queryBootTimes(T76::SCPI::Parameters params) {
+    _sendBootTimes(false);
+}
+
+void App::_queryPreviousBootTimes(T76::SCPI::Parameters params) {
+    if (!T76::Core::BootProfile::hasPrevious()) {
+        _interpreter.addError(-230, "Data corrupt or stale");
+        return;
+    }
+
+    _sendBootTimes(true);
+}
+
+void App::_sendBootTimes(bool previous) {
+    std::string response;
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(T76::Core::BootProfile::Phase::Count); i++) {
+        const T76::Core::BootProfile::Phase phase = static_cast<T76::Core::BootProfile::Phase>(i);
+        const uint32_t time = T76::Core::BootProfile::time(phase, previous);
+        char buffer[40];
+
+        if (time == 0) {
+            snprintf(buffer, sizeof(buffer), "%s\"%s\",9.91E37", i ? "," : "", T76::Core::BootProfile::name(phase));
+        } else {
+            snprintf(buffer, sizeof(buffer), "%s\"%s\",%lu", i ? "," : "", T76::Core::BootProfile::name(phase), (unsigned long)time);
+        }
+
+        response += buffer;
+    }
+
+    _usbInterface.sendUSBTMCBulkData(response);
+}
+
+void App::_queryDeviceClock(T76::SCPI::Parameters params) {
+    char buffer[24];
+
+    snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long)T76::Core::Timebase::now());
+    _usbInterface.sendUSBTMCBulkData(std::string(buffer));
+}
+
+void App::_addClockSync(T76::SCPI::Parameters params) {
+    const double host = params[0].numberValue;
+    const double device = params[1].numberValue;
+    const double roundTrip = params[2].numberValue;
+
+    if (device < 0 || roundTrip < 0 || roundTrip > UINT32_MAX) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    // Fails for a point older than the last one
+    if (!T76::Core::Timebase::addSyncPoint(static_cast<int64_t>(host), static_cast<uint64_t>(device), static_cast<uint32_t>(roundTrip))) {
+        _interpreter.addError(-221, "Settings conflict");
+    }
+}
+
+void App::_queryClockSync(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(T76::Core::Timebase::syncReport());
+}
+
+void App::_resetClockSync(T76::SCPI::Parameters params) {
+    T76::Core::Timebase::resetSync();
+}
+
+void App::_queryProfile(T76::SCPI::Parameters params) {
+#if T76_SCPI_PROFILE
+    const double count = params[0].numberValue;
+
+    if (count < 1 || count != static_cast<uint32_t>(count)) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    _usbInterface.sendUSBTMCBulkData(_interpreter.profile.report(static_cast<size_t>(count)));
+#else
+    _interpreter.addError(-200, "Execution error; built without T76_SCPI_PROFILE");
+#endif
+}
+
+void App::_resetProfile(T76::SCPI::Parameters params) {
+#if T76_SCPI_PROFILE
+    _interpreter.profile.reset();
+#else
+    _interpreter.addError(-200, "Execution error; built without T76_SCPI_PROFILE");
+#endif
+}
+
+void App::_startStream(T76::SCPI::Parameters params) {
+    const double decimation = params[0].numberValue;
+
+    if (decimation < 1 || decimation > 256 || decimation != static_cast<uint32_t>(decimation)) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    // Fails for a decimation that is not a power of two, or before the converter is activated
+    if (!T76::Core::Acquisition::startStream(T76::Core::Acquisition::winUSBStreamSink(_usbInterface), static_cast<uint32_t>(decimation))) {
+        _interpreter.addError(-221, "Settings conflict");
+    }
+}
+
+void App::_stopStream(T76::SCPI::Parameters params) {
+    T76::Core::Acquisition::stopStream();
+}
+
+void App::_queryStreamStats(T76::SCPI::Parameters params) {
+    const T76::Core::Acquisition::StreamStats stats = T76::Core::Acquisition::streamStats();
+    char buffer[160];
+
+    snprintf(buffer, sizeof(buffer), "%d,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%llu", stats.streaming ? 1 : 0,
+             (unsigned long)stats.decimation, (unsigned long)stats.frames, (unsigned long)stats.conversions,
+             (unsigned long)stats.droppedConversions, (unsigned long)stats.ringOverruns, (unsigned long)stats.frameOverruns,
+             (unsigned long)stats.lastLatencyUs, (unsigned long)stats.maxLatencyUs, (unsigned long long)stats.lastFrameTimeUs);
+
+    _usbInterface.sendUSBTMCBulkData(std::string(buffer));
+}
+
+void App::_resetStreamStats(T76::SCPI::Parameters params) {
+    T76::Core::Acquisition::resetStreamStats();
+}
+
+void App::_setCaptureSource(T76::SCPI::Parameters params) {
+    // The choices are SOFT, SOFTWARE, LEV and LEVEL
+    _captureSettings.source = params[0].enumIndex < 2 ? T76::Core::Control::TriggerSource::Software : T76::Core::Control::TriggerSource::Level;
+}
+
+void App::_setCaptureLevel(T76::SCPI::Parameters params) {
+    // The channel choices are the short and long forms of each recorded value, in record order, then DUTY
+    static constexpr uint8_t channels[] = {0, 0, 1, 1, 2, 2, 3};
+    static constexpr T76::Core::Control::TriggerSlope slopes[] = {
+        T76::Core::Control::TriggerSlope::Rising,
+        T76::Core::Control::TriggerSlope::Falling,
+        T76::Core::Control::TriggerSlope::Either,
+    };
+
+    _captureSettings.channel = channels[params[0].enumIndex];
+    _captureSettings.level = static_cast<float>(params[1].numberValue);
+    _captureSettings.slope = slopes[params[2].enumIndex / 2];
+}
+
+void App::_armCapture(T76::SCPI::Parameters params) {
+    const double preTrigger = params[0].numberValue;
+    const double interval = params[1].numberValue;
+
+    if (preTrigger < 0 || preTrigger >= BuckConverter::captureDepth || preTrigger != static_cast<uint32_t>(preTrigger) ||
+        interval < 1 || interval > UINT32_MAX || interval != static_cast<uint32_t>(interval)) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    _captureSettings.preTrigger = static_cast<uint32_t>(preTrigger);
+    _captureSettings.interval = static_cast<uint32_t>(interval);
+
+    _buckConverter.capture().arm(_captureSettings);
+}
+
+void App::_forceCapture(T76::SCPI::Parameters params) {
+    _buckConverter.capture().trigger();
+}
+
+void App::_abortCapture(T76::SCPI::Parameters params) {
+    _buckConverter.capture().abort();
+}
+
+void App::_queryCaptureState(T76::SCPI::Parameters params) {
+    static const char *const names[] = {"IDLE", "ARMED", "TRIGGERED", "DONE"};
+
+    _usbInterface.sendUSBTMCBulkData(names[static_cast<uint8_t>(_buckConverter.capture().state())]);
+}
+
+void App::_queryCaptureData(T76::SCPI::Parameters params) {
+    T76::Core::Control::Capture &capture = _buckConverter.capture();
+    const float *records = capture.data();
+
+    if (records == nullptr) {
+        _interpreter.addError(-230, "Data corrupt or stale; no completed capture");
+        return;
+    }
+
+    // The records go out as they are in memory, as little-endian 32-bit floats
+    T76::SCPI::DataFormat format;
+    format.type = T76::SCPI::DataType::Real32;
+    format.byteOrder = T76::SCPI::ByteOrder::Swapped;
+
+    T76::SCPI::BlockEncoder<float> block(records, capture.channels() * capture.depth(), format);
+    _usbInterface.fillUSBTMCBulkData(block.size(), T76::SCPI::BlockEncoder<float>::fill, &block);
+}
+
 bool App::activate() {
     return true;
 }
@@ -96,8 +482,7 @@ void App::_initCore0() {
 void App::_startCore1() {
     _buckConverter.start();
 
-    for(;;) {
-        sleep_ms(100); // Allow time for the watchdog to be fed
-    }
+    // The PWM wrap interrupt ticks the executive, which runs the control loop and feeds the watchdog
+    T76::Core::Executive::run(BuckConverter::controlRateHz, T76::Core::Executive::TickSource::External);
 }
 
@@ -57,7 +57,7 @@ namespace T76 {
          * This override method processes incoming SCPI commands received
          * through the USB Test and Measurement Class interface.
          */
-        void _onUSBTMCDataReceived(const std::vector<uint8_t> &data, bool transfer_complete) override;
+        void _onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) override;
 
         /**
          * @brief Query instrument identification
@@ -66,7 +66,6 @@ namespace T76 {
          * Handles the *IDN? SCPI command to return instrument identification
          * information including manufacturer, model, serial number, and firmware version.
          */
-        void _queryIDN(const std::vector<T76::SCPI::ParameterValue> &params);
 
         /**
          * @brief Reset instrument to default state
@@ -75,16 +74,35 @@ namespace T76 {
          * Handles the *RST SCPI command to reset the buck converter to
          * its default operational state and parameters.
          */
-        void _resetInstrument(const std::vector<T76::SCPI::ParameterValue> &params);
+        void _resetInstrument(T76::SCPI::Parameters params);
+
+        /**
+         * @brief Save the instrument state to a memory slot
+         * @param slot The memory slot, from 0 to 9
+         * 
+         * Handles the *SAV SCPI command. The PID gains and the target voltage
+         * are stored in the settings store, which writes them to flash in the
+         * background, so the command completes straight away.
+         */
+        void _saveState(double slot);
+
+        /**
+         * @brief Recall the instrument state from a memory slot
+         * @param slot The memory slot, from 0 to 9
+         * 
+         * Handles the *RCL SCPI command. The state is read from the settings
+         * store's RAM cache and takes effect on the next control cycle.
+         */
+        void _recallState(double slot);
 
         /**
          * @brief Set PID controller proportional gain (Kp)
-         * @param params SCPI command parameters containing the new Kp value
+         * @param value The new Kp value
          * 
          * Handles setting the proportional gain parameter for the PID controller
          * used in buck converter voltage regulation.
          */
-        void _setKp(const std::vector<T76::SCPI::ParameterValue> &);
+        void _setKp(double value);
 
         /**
          * @brief Query PID controller proportional gain (Kp)
@@ -92,16 +110,16 @@ namespace T76 {
          * 
          * Returns the current proportional gain value of the PID controller.
          */
-        void _queryKp(const std::vector<T76::SCPI::ParameterValue> &);
+        void _queryKp(T76::SCPI::Parameters);
 
         /**
          * @brief Set PID controller integral gain (Ki)
-         * @param params SCPI command parameters containing the new Ki value
+         * @param value The new Ki value
          * 
          * Handles setting the integral gain parameter for the PID controller
          * used in buck converter voltage regulation.
          */
-        void _setKi(const std::vector<T76::SCPI::ParameterValue> &);
+        void _setKi(double value);
 
         /**
          * @brief Query PID controller integral gain (Ki)
@@ -109,16 +127,16 @@ namespace T76 {
          * 
          * Returns the current integral gain value of the PID controller.
          */
-        void _queryKi(const std::vector<T76::SCPI::ParameterValue> &);
+        void _queryKi(T76::SCPI::Parameters);
 
         /**
          * @brief Set PID controller derivative gain (Kd)
-         * @param params SCPI command parameters containing the new Kd value
+         * @param value The new Kd value
          * 
          * Handles setting the derivative gain parameter for the PID controller
          * used in buck converter voltage regulation.
          */
-        void _setKd(const std::vector<T76::SCPI::ParameterValue> &);
+        void _setKd(double value);
 
         /**
          * @brief Query PID controller derivative gain (Kd)
@@ -126,16 +144,16 @@ namespace T76 {
          * 
          * Returns the current derivative gain value of the PID controller.
          */
-        void _queryKd(const std::vector<T76::SCPI::ParameterValue> &);
+        void _queryKd(T76::SCPI::Parameters);
 
         /**
          * @brief Set target output voltage
-         * @param params SCPI command parameters containing the new target voltage value
+         * @param value The new target voltage, in volts
          * 
          * Sets the desired output voltage for the buck converter. The PID controller
          * will regulate the output to match this target voltage.
          */
-        void _setTargetVoltage(const std::vector<T76::SCPI::ParameterValue> &);
+        void _setTargetVoltage(double value);
 
         /**
          * @brief Query target output voltage
@@ -143,7 +161,7 @@ namespace T76 {
          * 
          * Returns the current target voltage setpoint for the buck converter.
          */
-        void _queryTargetVoltage(const std::vector<T76::SCPI::ParameterValue> &);
+        void _queryTargetVoltage(T76::SCPI::Parameters);
 
         /**
          * @brief Query sensed output voltage
@@ -152,7 +170,184 @@ namespace T76 {
          * Returns the actual measured output voltage from the buck converter's
          * feedback sensing circuit.
          */
-        void _querySensedVoltage(const std::vector<T76::SCPI::ParameterValue> &);
+        void _querySensedVoltage(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the executive's tick statistics
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryTickStats(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the number of executive jobs
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryJobCount(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the timing statistics of an executive job
+         * @param job Job index
+         * 
+         * Returns the job's name, run and overrun counts, and its execution
+         * times and largest jitter in CPU cycles.
+         */
+        void _queryJobStats(double job);
+
+        /**
+         * @brief Query the jitter histogram of an executive job
+         * @param job Job index
+         */
+        void _queryJobHistogram(double job);
+
+        /**
+         * @brief Set the consecutive overrun limit of an executive job
+         * @param params Job index, number of overruns, and WARN or FAULT
+         */
+        void _setJobOverrunLimit(T76::SCPI::Parameters params);
+
+        /**
+         * @brief Query the consecutive overrun limit of an executive job
+         * @param job Job index
+         */
+        void _queryJobOverrunLimit(double job);
+
+        /**
+         * @brief Reset the executive's timing statistics
+         * @param params SCPI command parameters (unused)
+         */
+        void _resetExecutiveStats(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the task monitor's latest sample of every task
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryTasks(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the load of both cores
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryLoad(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the boot profile of this boot
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryBootTimes(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the boot profile of the previous boot
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryPreviousBootTimes(T76::SCPI::Parameters);
+
+        /**
+         * @brief Send a boot profile as name,time pairs
+         * @param previous Whether to send the previous boot's profile
+         */
+        void _sendBootTimes(bool previous);
+
+        /**
+         * @brief Query the device time
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryDeviceClock(T76::SCPI::Parameters);
+
+        /**
+         * @brief Add a host clock measurement
+         * @param params SCPI command parameters: host time, device time and round trip
+         */
+        void _addClockSync(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the host clock estimate
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryClockSync(T76::SCPI::Parameters);
+
+        /**
+         * @brief Forget the host clock measurements
+         * @param params SCPI command parameters (unused)
+         */
+        void _resetClockSync(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the commands that take the longest
+         * @param params Maximum number of commands to report
+         */
+        void _queryProfile(T76::SCPI::Parameters params);
+
+        /**
+         * @brief Reset the command profile
+         * @param params SCPI command parameters (unused)
+         */
+        void _resetProfile(T76::SCPI::Parameters);
+
+        /**
+         * @brief Start streaming the output voltage over WinUSB
+         * @param params Decimation factor
+         */
+        void _startStream(T76::SCPI::Parameters params);
+
+        /**
+         * @brief Stop streaming
+         * @param params SCPI command parameters (unused)
+         */
+        void _stopStream(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the stream's statistics
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryStreamStats(T76::SCPI::Parameters);
+
+        /**
+         * @brief Reset the stream's counters
+         * @param params SCPI command parameters (unused)
+         */
+        void _resetStreamStats(T76::SCPI::Parameters);
+
+        /**
+         * @brief Select the trigger source of the next capture
+         * @param params SOFTware or LEVel
+         */
+        void _setCaptureSource(T76::SCPI::Parameters params);
+
+        /**
+         * @brief Set the level trigger of the next capture
+         * @param params Channel, level, and slope
+         */
+        void _setCaptureLevel(T76::SCPI::Parameters params);
+
+        /**
+         * @brief Arm a capture of the control loop
+         * @param params Pre-trigger records and control cycles per record
+         */
+        void _armCapture(T76::SCPI::Parameters params);
+
+        /**
+         * @brief Fire the trigger of the armed capture
+         * @param params SCPI command parameters (unused)
+         */
+        void _forceCapture(T76::SCPI::Parameters);
+
+        /**
+         * @brief Stop the capture
+         * @param params SCPI command parameters (unused)
+         */
+        void _abortCapture(T76::SCPI::Parameters);
+
+        /**
+         * @brief Query the state of the capture
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryCaptureState(T76::SCPI::Parameters);
+
+        /**
+         * @brief Send the completed capture as a binary block
+         * @param params SCPI command parameters (unused for query)
+         */
+        void _queryCaptureData(T76::SCPI::Parameters);
 
         /**
          * @brief Activate the buck converter application
@@ -206,6 +401,7 @@ namespace T76 {
 
     protected:
         BuckConverter _buckConverter; ///< Buck converter component instance
+        T76::Core::Control::CaptureSettings _captureSettings; ///< Trigger of the next capture, set by CAPTure:TRIGger
 
     }; // class App
 
@@ -6,57 +6,39 @@
 
 #include "buck.hpp"
 
-#include <algorithm>
-#include <cmath>
 #include <cstdint>
 
-#include <hardware/adc.h>
 #include <hardware/clocks.h>
 #include <hardware/gpio.h>
 #include <hardware/irq.h>
 #include <hardware/pwm.h>
 
+#include <t76/acquisition.hpp>
+#include <t76/acquisition_stream.hpp>
+#include <t76/boot_profile.hpp>
+#include <t76/capture.hpp>
+#include <t76/executive.hpp>
+#include <t76/pid.hpp>
+#include <t76/placement.hpp>
 
-using namespace T76;
-
-typedef struct {
-    float rawSetPoint           = 0.0f;
-    float filteredSetPoint      = 0.0f;
-
-    float rawMeasurement        = 0.0f;
-    float filteredMeasurement   = 0.0f;
-
-    float error                 = 0.0f;
-    float previousError         = 0.0f;
-
-    float integratorState       = 0.0f;
-    float filteredDerivativeState = 0.0f;
-    float dutyCycle             = 0.0f;
-} PIDControllerState;
 
-typedef struct {
-    float kP; ///< Proportional coefficient
-    float kI; ///< Integral coefficient
-    float kD; ///< Derivative coefficient
-    float filterTau; ///< Filter time constant
-    float filterAlphaR; ///< Filter setpoint coefficient / tick
-    float filterAlphaY; ///< Filter measurement coefficient / tick
-    float kAntiwindupGain; ///< Anti-windup gain
-    float dutyMin; ///< Minimum duty cycle
-    float dutyMax; ///> Maximum duty cycle
-} PIDControllerParameters;
+using namespace T76;
 
+// Everything the control loop touches lives in SCRATCH_X, next to the core 1 stack
+T76_CORE1_DATA static uint16_t _pwmTop;
+T76_CORE1_DATA static uint8_t _pwmPin = 15;
+T76_CORE1_DATA static uint _pwmSlice;
 
-static uint16_t _pwmTop;
-static uint8_t _pwmPin = 15;
-static uint _pwmSlice;
+static float _sliceFrequency = BuckConverter::controlRateHz;
+static constexpr uint32_t _adcConversionRateHz = 500000;
+T76_CORE1_DATA static uint _adcInputChannel = 0; // GPIO 26
 
-static float _sliceFrequency = 30000.0f;
-static uint _adcInputPin = 26;
-static uint _adcInputChannel = 0;
+// Tuned by the SCPI handlers on core 0 and stepped by the control loop on core 1
+T76_CORE1_DATA static T76::Core::Control::PID _pid(BuckConverter::controlRateHz);
 
-static PIDControllerParameters _pidParams;
-static PIDControllerState _pidControllerState;
+// Records of the control loop's state, armed and downloaded over SCPI
+static float _captureStorage[BuckConverter::captureChannels * BuckConverter::captureDepth];
+T76_CORE1_DATA static T76::Core::Control::Capture _capture(_captureStorage, BuckConverter::captureChannels, BuckConverter::captureDepth);
 
 
 BuckConverter::BuckConverter() : T76::Core::Safety::SafeableComponent() {
@@ -91,43 +73,40 @@ bool BuckConverter::activate() {
 
     pwm_set_enabled(_pwmSlice, false);
 
-    // Set up ADC
-
-    adc_init();
-    adc_gpio_init(_adcInputPin); // Example GPIO for ADC input
-
-    // Set parameters
-
-    const float sliceTime = 1.0f / _sliceFrequency;
+    // Convert the output voltage continuously, so the control loop never waits for the ADC
 
-    _pidParams = {
-        .kP = 0.08f,
-        .kI = 754.0f,
-        .kD = 27e-6f / 10.0f,
-        .filterTau = 3.18e-6f, // 50kHz corner
-        .filterAlphaR = 2.0f * (float)M_PI * 800.0f * sliceTime,
-        .filterAlphaY = 2.0f * (float)M_PI * 4000.0f * sliceTime,
-        .kAntiwindupGain = _sliceFrequency * 0.1f,
-        .dutyMin = 0.0f,
-        .dutyMax = 0.95f
-    };
-
-    if (_pidParams.filterAlphaR > 1.0f) {
-        _pidParams.filterAlphaR = 1.0f;
+    if (!T76::Core::Acquisition::start(1u << _adcInputChannel, _adcConversionRateHz)) {
+        return false;
     }
 
-    if (_pidParams.filterAlphaY > 1.0f) {
-        _pidParams.filterAlphaY = 1.0f;
-    }
+    // Set parameters, keeping any set point chosen before activation
+
+    _pid.update([](T76::Core::Control::PIDSettings &settings) {
+        settings.kP = 0.08f;
+        settings.kI = 754.0f;
+        settings.kD = 27e-6f / 10.0f;
+        settings.derivativeTau = 3.18e-6f; // 50kHz corner
+        settings.setPointCornerHz = 800.0f;
+        settings.measurementCornerHz = 4000.0f;
+        settings.antiwindupGain = _sliceFrequency * 0.1f;
+        settings.outputMin = 0.0f;
+        settings.outputMax = 0.95f;
+    });
 
     return true; // Return true if activation is successful
 }
 
-void BuckConverter::makeSafe() {
+void T76_CORE1_CODE BuckConverter::makeSafe() {
     pwm_set_enabled(_pwmSlice, false);
 }
 
 void BuckConverter::start() {
+    // The control loop runs on every tick, ahead of any other job
+    T76::Core::Executive::addJob("PID", _pidControlJob, nullptr, controlRateHz, UINT8_MAX);
+
+    // Streaming, when started over SCPI, happens between control loop iterations
+    T76::Core::Executive::addJob("Stream", _streamJob, nullptr, streamPumpRateHz, 0, T76::Core::Executive::JobContext::Background);
+
     pwm_clear_irq(_pwmSlice);
     pwm_set_irq_enabled(_pwmSlice, true);
     irq_set_priority(PWM_IRQ_WRAP, 1);
@@ -139,138 +118,100 @@ void BuckConverter::start() {
 }
 
 void BuckConverter::kP(float value) {
-    _pidParams.kP = value;
+    _pid.update([value](T76::Core::Control::PIDSettings &settings) { settings.kP = value; });
 }
 
 float BuckConverter::kP() const {
-    return _pidParams.kP;
+    return _pid.settings().kP;
 }
 
 void BuckConverter::kI(float value) {
-    _pidParams.kI = value;
+    _pid.update([value](T76::Core::Control::PIDSettings &settings) { settings.kI = value; });
 }
 
 float BuckConverter::kI() const {
-    return _pidParams.kI;
+    return _pid.settings().kI;
 }
 
 void BuckConverter::kD(float value) {
-    _pidParams.kD = value;
+    _pid.update([value](T76::Core::Control::PIDSettings &settings) { settings.kD = value; });
 }
 
 float BuckConverter::kD() const {
-    return _pidParams.kD;
+    return _pid.settings().kD;
 }
 
 void BuckConverter::setPoint(float value) {
-    _pidControllerState.rawSetPoint = value;
+    _pid.update([value](T76::Core::Control::PIDSettings &settings) { settings.setPoint = value; });
 }
 
 float BuckConverter::setPoint() const {
-    return _pidControllerState.filteredSetPoint;
+    return _pid.state().setPoint;
 }
 
 float BuckConverter::sensedVoltage() const {
-    return _pidControllerState.filteredMeasurement;
+    return _pid.state().measurement;
+}
+
+T76::Core::Control::Capture &BuckConverter::capture() {
+    return _capture;
 }
 
 /**
- * @brief PWM interrupt handler implementing the PID control loop
- * 
- * This function is called at the PWM frequency (30kHz) to execute the PID control algorithm
- * that regulates the buck converter output voltage. The PID controller uses a discrete-time
- * implementation with the following key features:
- * 
- * 1. Input/Output Filtering: Both setpoint and measurement are low-pass filtered to reduce
- *    noise and prevent derivative kick on setpoint changes.
+ * @brief PWM interrupt handler that ticks the core 1 executive
  * 
- * 2. PID Terms:
- *    - P (Proportional): Provides immediate response proportional to current error
- *    - I (Integral): Eliminates steady-state error by accumulating error over time
- *    - D (Derivative): Provides damping based on rate of error change to reduce overshoot
- * 
- * 3. Numerical Integration: Uses trapezoidal rule for more accurate integral calculation
- *    compared to simple rectangular integration.
+ * The interrupt is acknowledged first, so that a control loop that overruns
+ * its period shows up in the executive's statistics rather than as a missed
+ * interrupt.
+ */
+void T76_CORE1_CODE T76::_pwmIRQHandler() {
+    pwm_clear_irq(_pwmSlice);
+    T76::Core::Executive::tick();
+}
+
+/**
+ * @brief Executive job implementing the PID control loop
  * 
- * 4. Derivative Filtering: The derivative term is low-pass filtered to reduce high-frequency
- *    noise amplification that could destabilize the system.
+ * This function is called at the PWM frequency (30kHz) to regulate the buck converter
+ * output voltage. It reads the output voltage from the free-running ADC, runs one step of the PID controller, and
+ * sets the duty cycle of the next PWM period.
  * 
- * 5. Anti-windup: Prevents integrator windup during output saturation using back-calculation
- *    method, keeping the controller responsive when saturation limits are removed.
+ * The controller filters the set point and the measurement, integrates the error with
+ * the trapezoidal rule, filters the derivative term, and limits the integrator with
+ * back-calculation anti-windup while the duty cycle saturates. Its coefficients are
+ * computed on core 0 whenever a gain or the set point changes, so that each step is a
+ * handful of single-precision multiply-adds with no division.
  * 
- * The control equation is: u(t) = Kp*e(t) + Ki*∫e(t)dt + Kd*de(t)/dt
- * Where: e(t) = setpoint - measurement (error signal)
+ * After updating the duty cycle, the job hands the cycle's set point, measurement,
+ * error and duty cycle to the capture, which keeps them only while armed.
  */
-void T76::_pwmIRQHandler() {
- 
-    // Calculate the time step for this control iteration (constant at 30kHz = 33.33μs)
-    static const float sliceTime = 1.0f / _sliceFrequency;
-
-    // Feed safety watchdog to prevent system reset due to tight timing loop
-    T76::Core::Safety::feedWatchdogFromCore1();
-
-    // === STEP 1: INPUT FILTERING ===
-    // Apply first-order low-pass filters to both setpoint and measurement to reduce noise
-    // and prevent derivative kick on setpoint changes. The filter equation is:
-    // y[n] = y[n-1] + α*(x[n] - y[n-1]) where α determines the filter bandwidth
-    _pidControllerState.filteredSetPoint += _pidParams.filterAlphaR * (_pidControllerState.rawSetPoint - _pidControllerState.filteredSetPoint);
-
-    // === STEP 2: MEASUREMENT ACQUISITION ===
-    // Read ADC value and convert to actual voltage considering:
+void T76_CORE1_CODE T76::_pidControlJob(void *context) {
+    // Take the newest conversion, at most 2 µs old, and convert it to actual voltage considering:
     // - 12-bit ADC: 4095 max value
     // - 3.3V reference voltage
     // - 2x voltage divider in hardware (so multiply by 2 to get actual voltage)
-    adc_select_input(_adcInputChannel);
-    _pidControllerState.rawMeasurement = adc_read() * 3.3f / 4095.0f * 2.0f;
-    
-    // Filter the measurement to reduce ADC noise and improve control stability
-    _pidControllerState.filteredMeasurement += _pidParams.filterAlphaY * (_pidControllerState.rawMeasurement - _pidControllerState.filteredMeasurement);
-
-    // === STEP 3: ERROR CALCULATION ===
-    // Store previous error for derivative and integral calculations
-    _pidControllerState.previousError = _pidControllerState.error;
-    // Calculate current error: positive error means output voltage is too low
-    _pidControllerState.error = _pidControllerState.filteredSetPoint - _pidControllerState.filteredMeasurement;
-
-    // === STEP 4: INTEGRAL TERM (I) ===
-    // Use trapezoidal integration rule for better accuracy: ∫e dt ≈ (e[n] + e[n-1]) * Δt / 2
-    // This accumulates error over time to eliminate steady-state offset
-    _pidControllerState.integratorState += _pidParams.kI * sliceTime * 0.5f * (_pidControllerState.error + _pidControllerState.previousError);
-
-    // === STEP 5: DERIVATIVE TERM (D) ===
-    // Calculate filtered derivative using first-order low-pass filter to reduce noise amplification
-    // The derivative is computed on the error signal: de/dt ≈ (e[n] - e[n-1]) / Δt
-    // Filter coefficients for discrete first-order LPF: a = τ/(τ+Δt), b = Kd/(τ+Δt)
-    const float a = _pidParams.filterTau / (_pidParams.filterTau + sliceTime);
-    const float b = _pidParams.kD / (_pidParams.filterTau + sliceTime);
-    
-    // Apply the filtered derivative: y[n] = a*y[n-1] + b*(x[n] - x[n-1])
-    _pidControllerState.filteredDerivativeState = a * _pidControllerState.filteredDerivativeState + b * (_pidControllerState.error - _pidControllerState.previousError);
-
-    // === STEP 6: PID OUTPUT CALCULATION ===
-    // Combine all three PID terms: u = Kp*e + Ki*∫e + Kd*de/dt
-    float unclampedDutyCycle = _pidParams.kP * _pidControllerState.error + _pidControllerState.integratorState + _pidControllerState.filteredDerivativeState;
-    
-    // === STEP 7: OUTPUT SATURATION ===
-    // Clamp the duty cycle to physical limits (0% to 95% typically for buck converters)
-    // This prevents damage and ensures stable operation
-    float dutyCycle = std::clamp(unclampedDutyCycle, _pidParams.dutyMin, _pidParams.dutyMax);
-
-    // === STEP 8: ANTI-WINDUP (BACK-CALCULATION) ===
-    // When the output saturates, the integrator can continue to accumulate error (windup),
-    // causing poor transient response when saturation is removed. Back-calculation method
-    // feeds the difference between clamped and unclamped output back to the integrator
-    // with gain kAntiwindupGain to prevent this windup condition.
-    _pidControllerState.integratorState += _pidParams.kAntiwindupGain * (dutyCycle - unclampedDutyCycle);
-
-    // Store the final duty cycle for next iteration
-    _pidControllerState.dutyCycle = dutyCycle;
-
-    // === STEP 9: PWM OUTPUT UPDATE ===
+    const float measurement = T76::Core::Acquisition::latest(_adcInputChannel) * (3.3f / 4095.0f * 2.0f);
+
+    const float dutyCycle = _pid.step(measurement);
+
     // Convert duty cycle (0.0-1.0) to PWM compare value and update hardware
-    // The PWM peripheral compares this value against the counter to generate the switching signal
-    pwm_set_gpio_level(_pwmPin, static_cast<uint16_t>(_pidControllerState.dutyCycle * _pwmTop));
-    
-    // Clear the PWM interrupt flag to acknowledge this interrupt and prepare for the next cycle
-    pwm_clear_irq(_pwmSlice);
-}
\ No newline at end of file
+    pwm_set_gpio_level(_pwmPin, static_cast<uint16_t>(dutyCycle * _pwmTop));
+
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::FirstMeasurement);
+
+    // Record the cycle after the PWM update, so the capture never delays it
+    const T76::Core::Control::PIDState &state = _pid.state();
+    const float record[BuckConverter::captureChannels] = {state.setPoint, state.measurement, state.error, dutyCycle};
+
+    _capture.record(record);
+}
+
+/**
+ * @brief Executive job that feeds the acquisition stream
+ * 
+ * Runs in the background, preempted by the control loop, and does nothing
+ * until a stream is started.
+ */
+void T76_CORE1_CODE T76::_streamJob(void *context) {
+    T76::Core::Acquisition::pumpStream();
+}
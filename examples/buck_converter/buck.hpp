@@ -9,6 +9,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+#include <t76/capture.hpp>
 #include <t76/safety.hpp>
 
 
@@ -17,11 +21,27 @@ namespace T76 {
     /**
      * @brief PWM interrupt request handler
      * 
-     * Forward declaration for the PWM IRQ handler function that manages
-     * real-time PWM duty cycle updates based on PID controller output.
+     * Forward declaration for the PWM IRQ handler function, which ticks the
+     * core 1 executive once per PWM period.
      */
     void _pwmIRQHandler();
 
+    /**
+     * @brief PID control loop job
+     * 
+     * Forward declaration for the executive job that manages real-time PWM
+     * duty cycle updates based on PID controller output.
+     */
+    void _pidControlJob(void *context);
+
+    /**
+     * @brief Acquisition stream job
+     * 
+     * Forward declaration for the background executive job that moves new
+     * conversions of the output voltage into WinUSB stream frames.
+     */
+    void _streamJob(void *context);
+
     /**
      * @class BuckConverter
      * @brief PID-controlled buck converter implementation
@@ -70,6 +90,18 @@ namespace T76 {
          */
         const char* getComponentName() const override { return "BuckConverter"; }
 
+        /**
+         * @brief Get the safing priority
+         * @return SafingPriority::Power, so the power stage is switched off first
+         */
+        T76::Core::Safety::SafingPriority getSafingPriority() const override { return T76::Core::Safety::SafingPriority::Power; }
+
+        /**
+         * @brief Get the core that safes the converter
+         * @return SafingCore::Core1, which runs the PWM interrupt and control loop
+         */
+        T76::Core::Safety::SafingCore getSafingCore() const override { return T76::Core::Safety::SafingCore::Core1; }
+
         /**
          * @brief Set PID controller proportional gain (Kp)
          * @param value New proportional gain value
@@ -153,15 +185,31 @@ namespace T76 {
          */
         float sensedVoltage() const;
 
+        /**
+         * @brief Get the capture of the control loop's state
+         * @return The capture, which records the set point, measurement,
+         *         error and duty cycle of each cycle while armed
+         * 
+         * The capture is armed and read on core 0; the control loop
+         * records into it on core 1.
+         */
+        T76::Core::Control::Capture &capture();
+
         /**
          * @brief Start the buck converter operation
          * 
-         * Begins buck converter operation by enabling PWM generation
-         * and starting the control loop. This method initiates the
-         * voltage regulation process.
+         * Begins buck converter operation by registering the control loop
+         * with the core 1 executive and enabling PWM generation. The PWM
+         * wrap interrupt then ticks the executive at controlRateHz, so
+         * the caller must run the executive with TickSource::External.
          */
         void start();
 
+        static constexpr uint32_t controlRateHz = 30000; ///< Rate of the PWM and of the control loop
+        static constexpr uint32_t streamPumpRateHz = 1000; ///< Rate at which new conversions are moved into stream frames
+        static constexpr std::size_t captureChannels = 4; ///< Set point, measurement, error and duty cycle
+        static constexpr std::size_t captureDepth = 1024; ///< Records per capture, about 34 ms at the control rate
+
     protected:
 
     };
@@ -125,15 +125,25 @@ extern "C" {
 
 /* SMP port only */
 /* https://www.freertos.org/symmetric-multiprocessing-introduction.html */
+/* T76_IC_SMP runs the kernel on both cores; otherwise core 1 runs bare metal */
+#ifdef T76_IC_SMP
+#define configNUMBER_OF_CORES                   2
+#else
 #define configNUMBER_OF_CORES                   1
+#endif
 #define configNUM_CORES                         configNUMBER_OF_CORES
 #define configTICK_CORE                         0
 #define configRUN_MULTIPLE_PRIORITIES           1
 
 /* SMP Related config. */
+#ifdef T76_IC_SMP
+#define configUSE_CORE_AFFINITY                 1
+#define portSUPPORT_SMP                         1
+#else
 #define configUSE_CORE_AFFINITY                 0
-#define configUSE_PASSIVE_IDLE_HOOK             0
 #define portSUPPORT_SMP                         0
+#endif
+#define configUSE_PASSIVE_IDLE_HOOK             0
 
 
 /* RP2040 specific */
@@ -183,6 +193,9 @@ extern uint64_t time_us_64(void); // "hardware/timer.h"
 #define portGET_RUN_TIME_COUNTER_VALUE() (time_us_64()/100)
 
 /* A header file that defines trace macro can be included here. */
+#ifdef T76_IC_TRACE
+#include "t76/trace_hooks.h"
+#endif
 
 #ifdef __cplusplus
 }
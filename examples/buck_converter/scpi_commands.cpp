@@ -13,17 +13,46 @@
 namespace T76 {
     class App {
     public:
-        void _queryIDN(const std::vector<T76::SCPI::ParameterValue> &);
-        void _resetInstrument(const std::vector<T76::SCPI::ParameterValue> &);
-        void _setKp(const std::vector<T76::SCPI::ParameterValue> &);
-        void _queryKp(const std::vector<T76::SCPI::ParameterValue> &);
-        void _setKi(const std::vector<T76::SCPI::ParameterValue> &);
-        void _queryKi(const std::vector<T76::SCPI::ParameterValue> &);
-        void _setKd(const std::vector<T76::SCPI::ParameterValue> &);
-        void _queryKd(const std::vector<T76::SCPI::ParameterValue> &);
-        void _setTargetVoltage(const std::vector<T76::SCPI::ParameterValue> &);
-        void _queryTargetVoltage(const std::vector<T76::SCPI::ParameterValue> &);
-        void _querySensedVoltage(const std::vector<T76::SCPI::ParameterValue> &);
+        void _resetInstrument(T76::SCPI::Parameters);
+        void _saveState(double);
+        void _recallState(double);
+        void _setKp(double);
+        void _queryKp(T76::SCPI::Parameters);
+        void _setKi(double);
+        void _queryKi(T76::SCPI::Parameters);
+        void _setKd(double);
+        void _queryKd(T76::SCPI::Parameters);
+        void _setTargetVoltage(double);
+        void _queryTargetVoltage(T76::SCPI::Parameters);
+        void _querySensedVoltage(T76::SCPI::Parameters);
+        void _queryTickStats(T76::SCPI::Parameters);
+        void _queryJobCount(T76::SCPI::Parameters);
+        void _queryJobStats(double);
+        void _queryJobHistogram(double);
+        void _setJobOverrunLimit(T76::SCPI::Parameters);
+        void _queryJobOverrunLimit(double);
+        void _resetExecutiveStats(T76::SCPI::Parameters);
+        void _queryTasks(T76::SCPI::Parameters);
+        void _queryLoad(T76::SCPI::Parameters);
+        void _queryBootTimes(T76::SCPI::Parameters);
+        void _queryPreviousBootTimes(T76::SCPI::Parameters);
+        void _queryDeviceClock(T76::SCPI::Parameters);
+        void _addClockSync(T76::SCPI::Parameters);
+        void _queryClockSync(T76::SCPI::Parameters);
+        void _resetClockSync(T76::SCPI::Parameters);
+        void _queryProfile(T76::SCPI::Parameters);
+        void _resetProfile(T76::SCPI::Parameters);
+        void _startStream(T76::SCPI::Parameters);
+        void _stopStream(T76::SCPI::Parameters);
+        void _queryStreamStats(T76::SCPI::Parameters);
+        void _resetStreamStats(T76::SCPI::Parameters);
+        void _setCaptureSource(T76::SCPI::Parameters);
+        void _setCaptureLevel(T76::SCPI::Parameters);
+        void _armCapture(T76::SCPI::Parameters);
+        void _forceCapture(T76::SCPI::Parameters);
+        void _abortCapture(T76::SCPI::Parameters);
+        void _queryCaptureState(T76::SCPI::Parameters);
+        void _queryCaptureData(T76::SCPI::Parameters);
     };
 }
 
@@ -33,187 +62,854 @@ namespace T76::SCPI {
  * Memory Usage Estimate:
  * 
  * Trie Structure:
- *   - Total nodes: 39
- *   - Children arrays: 32
- *   - Node size: 8 bytes each
- *   - Trie memory: 312 bytes
+ *   - Total nodes: 241
+ *   - Children arrays: 120
+ *   - Dense table filler nodes: 0 (0 bytes)
+ *   - Node size: 12 bytes each
+ *   - Compressed segments: 136 bytes
+ *   - Trie memory: 2892 bytes
  * 
  * Command System:
- *   - Commands: 11 (132 bytes)
- *   - Parameter descriptors: 64 bytes
- *   - String literals: 0 bytes
+ *   - Commands: 41 of up to 65535 (1312 bytes)
+ *   - Index widths: 16-bit command index, 8-bit child count (no size cost, both fit the node's padding)
+ *   - Dispatch: handler pointers in the command table
+ *   - Parameter descriptors: 368 bytes
+ *   - String literals: 125 bytes
  * 
  * Total Memory Usage:
- *   - Code/Data (Flash): 508 bytes (0.01% of 2MB)
- *   - Runtime (SRAM): 64 bytes (0.01% of 264KB)
+ *   - Code/Data (Flash): 4833 bytes (0.12% of 2MB)
+ *   - Runtime (SRAM): 160 bytes (0.03% of 264KB)
+ *   - Parameter storage: 96 bytes, allocated once, included in runtime
  * 
  * Performance Characteristics:
- *   - Average lookup depth: ~6.8 character comparisons
- *   - Memory access pattern: Sequential (cache-friendly)
+ *   - Average lookup depth: ~6.1 node transitions
+ *   - Child lookups: 115 linear, 5 binary search, 0 dense
+ *   - Average character comparisons: 22.5 (25.2 with linear scans only)
  *   - Space complexity: O(total_command_chars)
  */    // Parameter descriptors for each command
-    const ParameterDescriptor command_2_params[] = {
+    constexpr const char* command_17_param_2_choices[] = {
+        "WARN",
+        "WARNING",
+        "FAULT",
+    };
+
+    constexpr const char* command_34_param_0_choices[] = {
+        "SOFT",
+        "SOFTWARE",
+        "LEV",
+        "LEVEL",
+    };
+
+    constexpr const char* command_35_param_0_choices[] = {
+        "SETP",
+        "SETPOINT",
+        "MEAS",
+        "MEASUREMENT",
+        "ERR",
+        "ERROR",
+        "DUTY",
+    };
+
+    constexpr const char* command_35_param_2_choices[] = {
+        "RIS",
+        "RISING",
+        "FALL",
+        "FALLING",
+        "EITH",
+        "EITHER",
+    };
+
+    constexpr ParameterDescriptor command_2_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_3_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_4_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_6_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_8_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_10_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_15_params[] = {
         {
             .type = ParameterType::Number,
             .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
             .choiceCount = 0,
             .choices = nullptr
         },
     };
 
-    const ParameterDescriptor command_4_params[] = {
+    constexpr ParameterDescriptor command_16_params[] = {
         {
             .type = ParameterType::Number,
             .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
             .choiceCount = 0,
             .choices = nullptr
         },
     };
 
-    const ParameterDescriptor command_6_params[] = {
+    constexpr ParameterDescriptor command_17_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
         {
             .type = ParameterType::Number,
             .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+        {
+            .type = ParameterType::Enum,
+            .defaultValue = {.enumValue = "WARN"},
+            .hasDefault = true,
+            .choiceCount = 3,
+            .choices = command_17_param_2_choices
+        },
+    };
+
+    constexpr ParameterDescriptor command_18_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_25_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_28_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 10},
+            .hasDefault = true,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_30_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 1},
+            .hasDefault = true,
             .choiceCount = 0,
             .choices = nullptr
         },
     };
 
-    const ParameterDescriptor command_8_params[] = {
+    constexpr ParameterDescriptor command_34_params[] = {
+        {
+            .type = ParameterType::Enum,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 4,
+            .choices = command_34_param_0_choices
+        },
+    };
+
+    constexpr ParameterDescriptor command_35_params[] = {
+        {
+            .type = ParameterType::Enum,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 7,
+            .choices = command_35_param_0_choices
+        },
         {
             .type = ParameterType::Number,
             .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
             .choiceCount = 0,
             .choices = nullptr
         },
+        {
+            .type = ParameterType::Enum,
+            .defaultValue = {.enumValue = "RIS"},
+            .hasDefault = true,
+            .choiceCount = 6,
+            .choices = command_35_param_2_choices
+        },
     };
 
+    constexpr ParameterDescriptor command_36_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 256},
+            .hasDefault = true,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 1},
+            .hasDefault = true,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    // Trampolines for typed handlers
+    static void command_2_trampoline(T76::App &target, Parameters params) {
+        target._saveState(params[0].numberValue);
+    }
+
+    static void command_3_trampoline(T76::App &target, Parameters params) {
+        target._recallState(params[0].numberValue);
+    }
+
+    static void command_4_trampoline(T76::App &target, Parameters params) {
+        target._setKp(params[0].numberValue);
+    }
+
+    static void command_6_trampoline(T76::App &target, Parameters params) {
+        target._setKi(params[0].numberValue);
+    }
+
+    static void command_8_trampoline(T76::App &target, Parameters params) {
+        target._setKd(params[0].numberValue);
+    }
+
+    static void command_10_trampoline(T76::App &target, Parameters params) {
+        target._setTargetVoltage(params[0].numberValue);
+    }
+
+    static void command_15_trampoline(T76::App &target, Parameters params) {
+        target._queryJobStats(params[0].numberValue);
+    }
+
+    static void command_16_trampoline(T76::App &target, Parameters params) {
+        target._queryJobHistogram(params[0].numberValue);
+    }
+
+    static void command_18_trampoline(T76::App &target, Parameters params) {
+        target._queryJobOverrunLimit(params[0].numberValue);
+    }
+
+    static std::string_view command_0_constant(T76::App &) {
+        return std::string_view("MTA Inc.,T76-Dev,0001,1.0", 25);
+    }
+
+    // Segments of path-compressed trie nodes
+    template<>
+    constinit const char T76::SCPI::Interpreter<T76::App>::_trieSegments[] = "DN?TLAVID:KT:VOLTSTXECICK?OB:OUNTATSTICS?ISTGRAM?IMESTIVE:ASKOAD?OOT:TIMPREVOUS?LOCCE?YNCRESROFLEM:AM:EAS:VOLT?APTRIGOURER:ORORCATA?RE:";
+
     // Trie structure
-    const TrieNode _node__starIDN_children[] = {
-        { '?', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 0 } // Terminal: *IDN?
+    constexpr TrieNode _node__starR_children[] = {
+        { 'C', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 3 }, // Terminal: *RCL
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 1 } // Terminal: *RST
+    };
+    constexpr TrieNode _node__star_children[] = {
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 3, nullptr, 0, 0 }, // Terminal: *IDN?
+        { 'R', 0, 2, 0, _node__starR_children, 0, 0 },
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 0, 2, nullptr, 5, 2 } // Terminal: *SAV
     };
-    const TrieNode _node__starID_children[] = {
-        { 'N', 0, 1, _node__starIDN_children, 0 }
+    constexpr TrieNode _node_CAPT_colonABOR_children[] = {
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 38 } // Terminal: CAPTure:ABORt
     };
-    const TrieNode _node__starI_children[] = {
-        { 'D', 0, 1, _node__starID_children, 0 }
+    constexpr TrieNode _node_CAPT_colonA_children[] = {
+        { 'B', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_CAPT_colonABOR_children, 123, 38 }, // Terminal: CAPTure:ABORt
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 47, 36 } // Terminal: CAPTure:ARM
     };
-    const TrieNode _node__starRS_children[] = {
-        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 1 } // Terminal: *RST
+    constexpr TrieNode _node_CAPT_colonFORC_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 37 } // Terminal: CAPTure:FORCe
     };
-    const TrieNode _node__starR_children[] = {
-        { 'S', 0, 1, _node__starRS_children, 0 }
+    constexpr TrieNode _node_CAPT_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 39 }, // Terminal: CAPTure:STATe?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 39 } // Terminal: CAPTure:STATe?
     };
-    const TrieNode _node__star_children[] = {
-        { 'I', 0, 1, _node__starI_children, 0 },
-        { 'R', 0, 1, _node__starR_children, 0 }
+    constexpr TrieNode _node_CAPT_colonTRIG_colonLEV_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 35 } // Terminal: CAPTure:TRIGger:LEVel
     };
-    const TrieNode _node_MEAS_colonVOLT_children[] = {
-        { '?', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 10 } // Terminal: MEAS:VOLT?
+    constexpr TrieNode _node_CAPT_colonTRIG_colonSOUR_children[] = {
+        { 'C', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 20, 34 } // Terminal: CAPTure:TRIGger:SOURce
     };
-    const TrieNode _node_MEAS_colonVOL_children[] = {
-        { 'T', 0, 1, _node_MEAS_colonVOLT_children, 0 }
+    constexpr TrieNode _node_CAPT_colonTRIG_colon_children[] = {
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_CAPT_colonTRIG_colonLEV_children, 74, 35 }, // Terminal: CAPTure:TRIGger:LEVel
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_CAPT_colonTRIG_colonSOUR_children, 117, 34 } // Terminal: CAPTure:TRIGger:SOURce
     };
-    const TrieNode _node_MEAS_colonVO_children[] = {
-        { 'L', 0, 1, _node_MEAS_colonVOL_children, 0 }
+    constexpr TrieNode _node_CAPT_colonTRIGGER_colonLEV_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 35 } // Terminal: CAPTure:TRIGger:LEVel
     };
-    const TrieNode _node_MEAS_colonV_children[] = {
-        { 'O', 0, 1, _node_MEAS_colonVO_children, 0 }
+    constexpr TrieNode _node_CAPT_colonTRIGGER_colonSOUR_children[] = {
+        { 'C', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 20, 34 } // Terminal: CAPTure:TRIGger:SOURce
     };
-    const TrieNode _node_MEAS_colon_children[] = {
-        { 'V', 0, 1, _node_MEAS_colonV_children, 0 }
+    constexpr TrieNode _node_CAPT_colonTRIGGER_colon_children[] = {
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_CAPT_colonTRIGGER_colonLEV_children, 74, 35 }, // Terminal: CAPTure:TRIGger:LEVel
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_CAPT_colonTRIGGER_colonSOUR_children, 117, 34 } // Terminal: CAPTure:TRIGger:SOURce
     };
-    const TrieNode _node_MEAS_children[] = {
-        { ':', 0, 1, _node_MEAS_colon_children, 0 }
+    constexpr TrieNode _node_CAPT_colonTRIG_children[] = {
+        { ':', 0, 2, 0, _node_CAPT_colonTRIG_colon_children, 0, 0 },
+        { 'G', 0, 2, 3, _node_CAPT_colonTRIGGER_colon_children, 120, 0 }
     };
-    const TrieNode _node_MEA_children[] = {
-        { 'S', 0, 1, _node_MEAS_children, 0 }
+    constexpr TrieNode _node_CAPT_colon_children[] = {
+        { 'A', 0, 2, 0, _node_CAPT_colonA_children, 0, 0 },
+        { 'D', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 128, 40 }, // Terminal: CAPTure:DATA?
+        { 'F', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_CAPT_colonFORC_children, 125, 37 }, // Terminal: CAPTure:FORCe
+        { 'S', 0, 2, 3, _node_CAPT_colonSTAT_children, 32, 0 },
+        { 'T', 0, 2, 3, _node_CAPT_colonTRIG_children, 114, 0 }
     };
-    const TrieNode _node_ME_children[] = {
-        { 'A', 0, 1, _node_MEA_children, 0 }
+    constexpr TrieNode _node_CAPTURE_colonABOR_children[] = {
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 38 } // Terminal: CAPTure:ABORt
     };
-    const TrieNode _node_M_children[] = {
-        { 'E', 0, 1, _node_ME_children, 0 }
+    constexpr TrieNode _node_CAPTURE_colonA_children[] = {
+        { 'B', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_CAPTURE_colonABOR_children, 123, 38 }, // Terminal: CAPTure:ABORt
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 47, 36 } // Terminal: CAPTure:ARM
     };
-    const TrieNode _node_PID_colonKD_children[] = {
-        { '?', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 7 } // Terminal: PID:KD?
+    constexpr TrieNode _node_CAPTURE_colonFORC_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 37 } // Terminal: CAPTure:FORCe
     };
-    const TrieNode _node_PID_colonKI_children[] = {
-        { '?', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 5 } // Terminal: PID:KI?
+    constexpr TrieNode _node_CAPTURE_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 39 }, // Terminal: CAPTure:STATe?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 39 } // Terminal: CAPTure:STATe?
     };
-    const TrieNode _node_PID_colonKP_children[] = {
-        { '?', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 3 } // Terminal: PID:KP?
+    constexpr TrieNode _node_CAPTURE_colonTRIG_colonLEV_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 35 } // Terminal: CAPTure:TRIGger:LEVel
     };
-    const TrieNode _node_PID_colonK_children[] = {
-        { 'D', uint8_t(TrieNodeFlags::Terminal), 1, _node_PID_colonKD_children, 6 }, // Terminal: PID:KD
-        { 'I', uint8_t(TrieNodeFlags::Terminal), 1, _node_PID_colonKI_children, 4 }, // Terminal: PID:KI
-        { 'P', uint8_t(TrieNodeFlags::Terminal), 1, _node_PID_colonKP_children, 2 } // Terminal: PID:KP
+    constexpr TrieNode _node_CAPTURE_colonTRIG_colonSOUR_children[] = {
+        { 'C', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 20, 34 } // Terminal: CAPTure:TRIGger:SOURce
     };
-    const TrieNode _node_PID_colon_children[] = {
-        { 'K', 0, 3, _node_PID_colonK_children, 0 }
+    constexpr TrieNode _node_CAPTURE_colonTRIG_colon_children[] = {
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_CAPTURE_colonTRIG_colonLEV_children, 74, 35 }, // Terminal: CAPTure:TRIGger:LEVel
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_CAPTURE_colonTRIG_colonSOUR_children, 117, 34 } // Terminal: CAPTure:TRIGger:SOURce
     };
-    const TrieNode _node_PID_children[] = {
-        { ':', 0, 1, _node_PID_colon_children, 0 }
+    constexpr TrieNode _node_CAPTURE_colonTRIGGER_colonLEV_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 35 } // Terminal: CAPTure:TRIGger:LEVel
     };
-    const TrieNode _node_PI_children[] = {
-        { 'D', 0, 1, _node_PID_children, 0 }
+    constexpr TrieNode _node_CAPTURE_colonTRIGGER_colonSOUR_children[] = {
+        { 'C', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 20, 34 } // Terminal: CAPTure:TRIGger:SOURce
     };
-    const TrieNode _node_P_children[] = {
-        { 'I', 0, 1, _node_PI_children, 0 }
+    constexpr TrieNode _node_CAPTURE_colonTRIGGER_colon_children[] = {
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_CAPTURE_colonTRIGGER_colonLEV_children, 74, 35 }, // Terminal: CAPTure:TRIGger:LEVel
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_CAPTURE_colonTRIGGER_colonSOUR_children, 117, 34 } // Terminal: CAPTure:TRIGger:SOURce
     };
-    const TrieNode _node_SET_colonVOLT_children[] = {
-        { '?', uint8_t(TrieNodeFlags::Terminal), 0, nullptr, 9 } // Terminal: SET:VOLT?
+    constexpr TrieNode _node_CAPTURE_colonTRIG_children[] = {
+        { ':', 0, 2, 0, _node_CAPTURE_colonTRIG_colon_children, 0, 0 },
+        { 'G', 0, 2, 3, _node_CAPTURE_colonTRIGGER_colon_children, 120, 0 }
     };
-    const TrieNode _node_SET_colonVOL_children[] = {
-        { 'T', uint8_t(TrieNodeFlags::Terminal), 1, _node_SET_colonVOLT_children, 8 } // Terminal: SET:VOLT
+    constexpr TrieNode _node_CAPTURE_colon_children[] = {
+        { 'A', 0, 2, 0, _node_CAPTURE_colonA_children, 0, 0 },
+        { 'D', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 128, 40 }, // Terminal: CAPTure:DATA?
+        { 'F', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_CAPTURE_colonFORC_children, 125, 37 }, // Terminal: CAPTure:FORCe
+        { 'S', 0, 2, 3, _node_CAPTURE_colonSTAT_children, 32, 0 },
+        { 'T', 0, 2, 3, _node_CAPTURE_colonTRIG_children, 114, 0 }
     };
-    const TrieNode _node_SET_colonVO_children[] = {
-        { 'L', 0, 1, _node_SET_colonVOL_children, 0 }
+    constexpr TrieNode _node_CAPT_children[] = {
+        { ':', uint8_t(TrieNodeFlags::BinarySearch), 5, 0, _node_CAPT_colon_children, 0, 0 },
+        { 'U', uint8_t(TrieNodeFlags::BinarySearch), 5, 3, _node_CAPTURE_colon_children, 132, 0 }
     };
-    const TrieNode _node_SET_colonV_children[] = {
-        { 'O', 0, 1, _node_SET_colonVO_children, 0 }
+    constexpr TrieNode _node_PID_colonKD_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 9 } // Terminal: PID:KD?
     };
-    const TrieNode _node_SET_colon_children[] = {
-        { 'V', 0, 1, _node_SET_colonV_children, 0 }
+    constexpr TrieNode _node_PID_colonKI_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 7 } // Terminal: PID:KI?
     };
-    const TrieNode _node_SET_children[] = {
-        { ':', 0, 1, _node_SET_colon_children, 0 }
+    constexpr TrieNode _node_PID_colonKP_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 5 } // Terminal: PID:KP?
     };
-    const TrieNode _node_SE_children[] = {
-        { 'T', 0, 1, _node_SET_children, 0 }
+    constexpr TrieNode _node_PID_colonK_children[] = {
+        { 'D', uint8_t(TrieNodeFlags::Terminal), 1, 0, _node_PID_colonKD_children, 0, 8 }, // Terminal: PID:KD
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 1, 0, _node_PID_colonKI_children, 0, 6 }, // Terminal: PID:KI
+        { 'P', uint8_t(TrieNodeFlags::Terminal), 1, 0, _node_PID_colonKP_children, 0, 4 } // Terminal: PID:KP
     };
-    const TrieNode _node_S_children[] = {
-        { 'E', 0, 1, _node_SE_children, 0 }
+    constexpr TrieNode _node_SET_colonVOLT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 11 } // Terminal: SET:VOLT?
     };
-    const TrieNode _root_children[] = {
-        { '*', 0, 2, _node__star_children, 0 },
-        { 'M', 0, 1, _node_M_children, 0 },
-        { 'P', 0, 1, _node_P_children, 0 },
-        { 'S', 0, 1, _node_S_children, 0 }
+    constexpr TrieNode _node_STR_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 33 } // Terminal: STReam:RESet
+    };
+    constexpr TrieNode _node_STR_colonSTAR_children[] = {
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 30 } // Terminal: STReam:STARt
+    };
+    constexpr TrieNode _node_STR_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 32 }, // Terminal: STReam:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 35, 32 } // Terminal: STReam:STATistics?
+    };
+    constexpr TrieNode _node_STR_colonSTA_children[] = {
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 0, _node_STR_colonSTAR_children, 0, 30 }, // Terminal: STReam:STARt
+        { 'T', 0, 2, 0, _node_STR_colonSTAT_children, 0, 0 }
+    };
+    constexpr TrieNode _node_STR_colonST_children[] = {
+        { 'A', 0, 2, 0, _node_STR_colonSTA_children, 0, 0 },
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 72, 31 } // Terminal: STReam:STOP
+    };
+    constexpr TrieNode _node_STR_colon_children[] = {
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_STR_colonRES_children, 51, 33 }, // Terminal: STReam:RESet
+        { 'S', 0, 2, 1, _node_STR_colonST_children, 3, 0 }
+    };
+    constexpr TrieNode _node_STREAM_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 33 } // Terminal: STReam:RESet
+    };
+    constexpr TrieNode _node_STREAM_colonSTAR_children[] = {
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 30 } // Terminal: STReam:STARt
+    };
+    constexpr TrieNode _node_STREAM_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 32 }, // Terminal: STReam:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 35, 32 } // Terminal: STReam:STATistics?
+    };
+    constexpr TrieNode _node_STREAM_colonSTA_children[] = {
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 0, _node_STREAM_colonSTAR_children, 0, 30 }, // Terminal: STReam:STARt
+        { 'T', 0, 2, 0, _node_STREAM_colonSTAT_children, 0, 0 }
+    };
+    constexpr TrieNode _node_STREAM_colonST_children[] = {
+        { 'A', 0, 2, 0, _node_STREAM_colonSTA_children, 0, 0 },
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 72, 31 } // Terminal: STReam:STOP
+    };
+    constexpr TrieNode _node_STREAM_colon_children[] = {
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_STREAM_colonRES_children, 51, 33 }, // Terminal: STReam:RESet
+        { 'S', 0, 2, 1, _node_STREAM_colonST_children, 3, 0 }
+    };
+    constexpr TrieNode _node_STR_children[] = {
+        { ':', 0, 2, 0, _node_STR_colon_children, 0, 0 },
+        { 'E', 0, 2, 3, _node_STREAM_colon_children, 99, 0 }
+    };
+    constexpr TrieNode _node_SYST_colonBOOT_colonTIM_colonPREV_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 23 }, // Terminal: SYSTem:BOOT:TIMes:PREVious?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 76, 23 } // Terminal: SYSTem:BOOT:TIMes:PREVious?
+    };
+    constexpr TrieNode _node_SYST_colonBOOT_colonTIMES_colonPREV_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 23 }, // Terminal: SYSTem:BOOT:TIMes:PREVious?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 76, 23 } // Terminal: SYSTem:BOOT:TIMes:PREVious?
+    };
+    constexpr TrieNode _node_SYST_colonBOOT_colonTIMES_children[] = {
+        { ':', 0, 2, 4, _node_SYST_colonBOOT_colonTIMES_colonPREV_children, 72, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 22 } // Terminal: SYSTem:BOOT:TIMes?
+    };
+    constexpr TrieNode _node_SYST_colonBOOT_colonTIM_children[] = {
+        { ':', 0, 2, 4, _node_SYST_colonBOOT_colonTIM_colonPREV_children, 72, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 22 }, // Terminal: SYSTem:BOOT:TIMes?
+        { 'E', 0, 2, 1, _node_SYST_colonBOOT_colonTIMES_children, 17, 0 }
+    };
+    constexpr TrieNode _node_SYST_colonCLOC_colonDEV_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 24 }, // Terminal: SYSTem:CLOCk:DEVice?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 3, nullptr, 83, 24 } // Terminal: SYSTem:CLOCk:DEVice?
+    };
+    constexpr TrieNode _node_SYST_colonCLOC_colonSYNC_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 27 } // Terminal: SYSTem:CLOCk:SYNC:RESet
+    };
+    constexpr TrieNode _node_SYST_colonCLOC_colonSYNC_children[] = {
+        { ':', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_SYST_colonCLOC_colonSYNC_colonRES_children, 89, 27 }, // Terminal: SYSTem:CLOCk:SYNC:RESet
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 26 } // Terminal: SYSTem:CLOCk:SYNC?
+    };
+    constexpr TrieNode _node_SYST_colonCLOC_colon_children[] = {
+        { 'D', 0, 2, 2, _node_SYST_colonCLOC_colonDEV_children, 74, 0 },
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 2, 3, _node_SYST_colonCLOC_colonSYNC_children, 86, 25 } // Terminal: SYSTem:CLOCk:SYNC
+    };
+    constexpr TrieNode _node_SYST_colonCLOCK_colonDEV_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 24 }, // Terminal: SYSTem:CLOCk:DEVice?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 3, nullptr, 83, 24 } // Terminal: SYSTem:CLOCk:DEVice?
+    };
+    constexpr TrieNode _node_SYST_colonCLOCK_colonSYNC_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 27 } // Terminal: SYSTem:CLOCk:SYNC:RESet
+    };
+    constexpr TrieNode _node_SYST_colonCLOCK_colonSYNC_children[] = {
+        { ':', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_SYST_colonCLOCK_colonSYNC_colonRES_children, 89, 27 }, // Terminal: SYSTem:CLOCk:SYNC:RESet
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 26 } // Terminal: SYSTem:CLOCk:SYNC?
+    };
+    constexpr TrieNode _node_SYST_colonCLOCK_colon_children[] = {
+        { 'D', 0, 2, 2, _node_SYST_colonCLOCK_colonDEV_children, 74, 0 },
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 2, 3, _node_SYST_colonCLOCK_colonSYNC_children, 86, 25 } // Terminal: SYSTem:CLOCk:SYNC
+    };
+    constexpr TrieNode _node_SYST_colonCLOC_children[] = {
+        { ':', 0, 2, 0, _node_SYST_colonCLOC_colon_children, 0, 0 },
+        { 'K', 0, 2, 1, _node_SYST_colonCLOCK_colon_children, 9, 0 }
+    };
+    constexpr TrieNode _node_SYST_colonEXEC_colonJOB_colonCOUN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 14 }, // Terminal: SYSTem:EXECutive:JOB:COUNt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 14 } // Terminal: SYSTem:EXECutive:JOB:COUNt?
+    };
+    constexpr TrieNode _node_SYST_colonEXEC_colonJOB_colonHIST_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 }, // Terminal: SYSTem:EXECutive:JOB:HISTogram?
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 44, 16 } // Terminal: SYSTem:EXECutive:JOB:HISTogram?
+    };
+    constexpr TrieNode _node_SYST_colonEXEC_colonJOB_colonLIMIT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 } // Terminal: SYSTem:EXECutive:JOB:LIMit?
+    };
+    constexpr TrieNode _node_SYST_colonEXEC_colonJOB_colonLIM_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 }, // Terminal: SYSTem:EXECutive:JOB:LIMit?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_SYST_colonEXEC_colonJOB_colonLIMIT_children, 3, 17 } // Terminal: SYSTem:EXECutive:JOB:LIMit
+    };
+    constexpr TrieNode _node_SYST_colonEXEC_colonJOB_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 15 }, // Terminal: SYSTem:EXECutive:JOB:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 35, 15 } // Terminal: SYSTem:EXECutive:JOB:STATistics?
+    };
+    constexpr TrieNode _node_SYST_colonEXEC_colonJOB_colon_children[] = {
+        { 'C', 0, 2, 3, _node_SYST_colonEXEC_colonJOB_colonCOUN_children, 29, 0 },
+        { 'H', 0, 2, 3, _node_SYST_colonEXEC_colonJOB_colonHIST_children, 41, 0 },
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_SYST_colonEXEC_colonJOB_colonLIM_children, 49, 17 }, // Terminal: SYSTem:EXECutive:JOB:LIMit
+        { 'S', 0, 2, 3, _node_SYST_colonEXEC_colonJOB_colonSTAT_children, 32, 0 }
+    };
+    constexpr TrieNode _node_SYST_colonEXEC_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 19 } // Terminal: SYSTem:EXECutive:RESet
+    };
+    constexpr TrieNode _node_SYST_colonEXEC_colon_children[] = {
+        { 'J', 0, 4, 3, _node_SYST_colonEXEC_colonJOB_colon_children, 26, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYST_colonEXEC_colonRES_children, 51, 19 }, // Terminal: SYSTem:EXECutive:RESet
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 22, 13 } // Terminal: SYSTem:EXECutive:TICK?
+    };
+    constexpr TrieNode _node_SYST_colonEXECUTIVE_colonJOB_colonCOUN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 14 }, // Terminal: SYSTem:EXECutive:JOB:COUNt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 14 } // Terminal: SYSTem:EXECutive:JOB:COUNt?
+    };
+    constexpr TrieNode _node_SYST_colonEXECUTIVE_colonJOB_colonHIST_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 }, // Terminal: SYSTem:EXECutive:JOB:HISTogram?
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 44, 16 } // Terminal: SYSTem:EXECutive:JOB:HISTogram?
+    };
+    constexpr TrieNode _node_SYST_colonEXECUTIVE_colonJOB_colonLIMIT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 } // Terminal: SYSTem:EXECutive:JOB:LIMit?
+    };
+    constexpr TrieNode _node_SYST_colonEXECUTIVE_colonJOB_colonLIM_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 }, // Terminal: SYSTem:EXECutive:JOB:LIMit?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_SYST_colonEXECUTIVE_colonJOB_colonLIMIT_children, 3, 17 } // Terminal: SYSTem:EXECutive:JOB:LIMit
+    };
+    constexpr TrieNode _node_SYST_colonEXECUTIVE_colonJOB_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 15 }, // Terminal: SYSTem:EXECutive:JOB:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 35, 15 } // Terminal: SYSTem:EXECutive:JOB:STATistics?
+    };
+    constexpr TrieNode _node_SYST_colonEXECUTIVE_colonJOB_colon_children[] = {
+        { 'C', 0, 2, 3, _node_SYST_colonEXECUTIVE_colonJOB_colonCOUN_children, 29, 0 },
+        { 'H', 0, 2, 3, _node_SYST_colonEXECUTIVE_colonJOB_colonHIST_children, 41, 0 },
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_SYST_colonEXECUTIVE_colonJOB_colonLIM_children, 49, 17 }, // Terminal: SYSTem:EXECutive:JOB:LIMit
+        { 'S', 0, 2, 3, _node_SYST_colonEXECUTIVE_colonJOB_colonSTAT_children, 32, 0 }
+    };
+    constexpr TrieNode _node_SYST_colonEXECUTIVE_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 19 } // Terminal: SYSTem:EXECutive:RESet
+    };
+    constexpr TrieNode _node_SYST_colonEXECUTIVE_colon_children[] = {
+        { 'J', 0, 4, 3, _node_SYST_colonEXECUTIVE_colonJOB_colon_children, 26, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYST_colonEXECUTIVE_colonRES_children, 51, 19 }, // Terminal: SYSTem:EXECutive:RESet
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 22, 13 } // Terminal: SYSTem:EXECutive:TICK?
+    };
+    constexpr TrieNode _node_SYST_colonEXEC_children[] = {
+        { ':', 0, 3, 0, _node_SYST_colonEXEC_colon_children, 0, 0 },
+        { 'U', 0, 3, 5, _node_SYST_colonEXECUTIVE_colon_children, 53, 0 }
+    };
+    constexpr TrieNode _node_SYST_colonPROF_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 29 } // Terminal: SYSTem:PROFile:RESet
+    };
+    constexpr TrieNode _node_SYST_colonPROFILE_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 29 } // Terminal: SYSTem:PROFile:RESet
+    };
+    constexpr TrieNode _node_SYST_colonPROFILE_children[] = {
+        { ':', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_SYST_colonPROFILE_colonRES_children, 89, 29 }, // Terminal: SYSTem:PROFile:RESet
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 28 } // Terminal: SYSTem:PROFile?
+    };
+    constexpr TrieNode _node_SYST_colonPROF_children[] = {
+        { ':', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_SYST_colonPROF_colonRES_children, 89, 29 }, // Terminal: SYSTem:PROFile:RESet
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 28 }, // Terminal: SYSTem:PROFile?
+        { 'I', 0, 2, 2, _node_SYST_colonPROFILE_children, 95, 0 }
+    };
+    constexpr TrieNode _node_SYST_colonTASK_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 20 }, // Terminal: SYSTem:TASKs?
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 20 } // Terminal: SYSTem:TASKs?
+    };
+    constexpr TrieNode _node_SYST_colon_children[] = {
+        { 'B', 0, 3, 7, _node_SYST_colonBOOT_colonTIM_children, 65, 0 },
+        { 'C', 0, 2, 3, _node_SYST_colonCLOC_children, 80, 0 },
+        { 'E', 0, 2, 3, _node_SYST_colonEXEC_children, 19, 0 },
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 61, 21 }, // Terminal: SYSTem:LOAD?
+        { 'P', 0, 3, 3, _node_SYST_colonPROF_children, 92, 0 },
+        { 'T', 0, 2, 3, _node_SYST_colonTASK_children, 58, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colonBOOT_colonTIM_colonPREV_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 23 }, // Terminal: SYSTem:BOOT:TIMes:PREVious?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 76, 23 } // Terminal: SYSTem:BOOT:TIMes:PREVious?
+    };
+    constexpr TrieNode _node_SYSTEM_colonBOOT_colonTIMES_colonPREV_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 23 }, // Terminal: SYSTem:BOOT:TIMes:PREVious?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 76, 23 } // Terminal: SYSTem:BOOT:TIMes:PREVious?
+    };
+    constexpr TrieNode _node_SYSTEM_colonBOOT_colonTIMES_children[] = {
+        { ':', 0, 2, 4, _node_SYSTEM_colonBOOT_colonTIMES_colonPREV_children, 72, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 22 } // Terminal: SYSTem:BOOT:TIMes?
+    };
+    constexpr TrieNode _node_SYSTEM_colonBOOT_colonTIM_children[] = {
+        { ':', 0, 2, 4, _node_SYSTEM_colonBOOT_colonTIM_colonPREV_children, 72, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 22 }, // Terminal: SYSTem:BOOT:TIMes?
+        { 'E', 0, 2, 1, _node_SYSTEM_colonBOOT_colonTIMES_children, 17, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colonCLOC_colonDEV_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 24 }, // Terminal: SYSTem:CLOCk:DEVice?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 3, nullptr, 83, 24 } // Terminal: SYSTem:CLOCk:DEVice?
+    };
+    constexpr TrieNode _node_SYSTEM_colonCLOC_colonSYNC_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 27 } // Terminal: SYSTem:CLOCk:SYNC:RESet
+    };
+    constexpr TrieNode _node_SYSTEM_colonCLOC_colonSYNC_children[] = {
+        { ':', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_SYSTEM_colonCLOC_colonSYNC_colonRES_children, 89, 27 }, // Terminal: SYSTem:CLOCk:SYNC:RESet
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 26 } // Terminal: SYSTem:CLOCk:SYNC?
+    };
+    constexpr TrieNode _node_SYSTEM_colonCLOC_colon_children[] = {
+        { 'D', 0, 2, 2, _node_SYSTEM_colonCLOC_colonDEV_children, 74, 0 },
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 2, 3, _node_SYSTEM_colonCLOC_colonSYNC_children, 86, 25 } // Terminal: SYSTem:CLOCk:SYNC
+    };
+    constexpr TrieNode _node_SYSTEM_colonCLOCK_colonDEV_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 24 }, // Terminal: SYSTem:CLOCk:DEVice?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 3, nullptr, 83, 24 } // Terminal: SYSTem:CLOCk:DEVice?
+    };
+    constexpr TrieNode _node_SYSTEM_colonCLOCK_colonSYNC_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 27 } // Terminal: SYSTem:CLOCk:SYNC:RESet
+    };
+    constexpr TrieNode _node_SYSTEM_colonCLOCK_colonSYNC_children[] = {
+        { ':', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_SYSTEM_colonCLOCK_colonSYNC_colonRES_children, 89, 27 }, // Terminal: SYSTem:CLOCk:SYNC:RESet
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 26 } // Terminal: SYSTem:CLOCk:SYNC?
+    };
+    constexpr TrieNode _node_SYSTEM_colonCLOCK_colon_children[] = {
+        { 'D', 0, 2, 2, _node_SYSTEM_colonCLOCK_colonDEV_children, 74, 0 },
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 2, 3, _node_SYSTEM_colonCLOCK_colonSYNC_children, 86, 25 } // Terminal: SYSTem:CLOCk:SYNC
+    };
+    constexpr TrieNode _node_SYSTEM_colonCLOC_children[] = {
+        { ':', 0, 2, 0, _node_SYSTEM_colonCLOC_colon_children, 0, 0 },
+        { 'K', 0, 2, 1, _node_SYSTEM_colonCLOCK_colon_children, 9, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXEC_colonJOB_colonCOUN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 14 }, // Terminal: SYSTem:EXECutive:JOB:COUNt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 14 } // Terminal: SYSTem:EXECutive:JOB:COUNt?
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXEC_colonJOB_colonHIST_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 }, // Terminal: SYSTem:EXECutive:JOB:HISTogram?
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 44, 16 } // Terminal: SYSTem:EXECutive:JOB:HISTogram?
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXEC_colonJOB_colonLIMIT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 } // Terminal: SYSTem:EXECutive:JOB:LIMit?
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXEC_colonJOB_colonLIM_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 }, // Terminal: SYSTem:EXECutive:JOB:LIMit?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_SYSTEM_colonEXEC_colonJOB_colonLIMIT_children, 3, 17 } // Terminal: SYSTem:EXECutive:JOB:LIMit
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXEC_colonJOB_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 15 }, // Terminal: SYSTem:EXECutive:JOB:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 35, 15 } // Terminal: SYSTem:EXECutive:JOB:STATistics?
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXEC_colonJOB_colon_children[] = {
+        { 'C', 0, 2, 3, _node_SYSTEM_colonEXEC_colonJOB_colonCOUN_children, 29, 0 },
+        { 'H', 0, 2, 3, _node_SYSTEM_colonEXEC_colonJOB_colonHIST_children, 41, 0 },
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_SYSTEM_colonEXEC_colonJOB_colonLIM_children, 49, 17 }, // Terminal: SYSTem:EXECutive:JOB:LIMit
+        { 'S', 0, 2, 3, _node_SYSTEM_colonEXEC_colonJOB_colonSTAT_children, 32, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXEC_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 19 } // Terminal: SYSTem:EXECutive:RESet
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXEC_colon_children[] = {
+        { 'J', 0, 4, 3, _node_SYSTEM_colonEXEC_colonJOB_colon_children, 26, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYSTEM_colonEXEC_colonRES_children, 51, 19 }, // Terminal: SYSTem:EXECutive:RESet
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 22, 13 } // Terminal: SYSTem:EXECutive:TICK?
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXECUTIVE_colonJOB_colonCOUN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 14 }, // Terminal: SYSTem:EXECutive:JOB:COUNt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 14 } // Terminal: SYSTem:EXECutive:JOB:COUNt?
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXECUTIVE_colonJOB_colonHIST_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 }, // Terminal: SYSTem:EXECutive:JOB:HISTogram?
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 44, 16 } // Terminal: SYSTem:EXECutive:JOB:HISTogram?
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXECUTIVE_colonJOB_colonLIMIT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 } // Terminal: SYSTem:EXECutive:JOB:LIMit?
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXECUTIVE_colonJOB_colonLIM_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 }, // Terminal: SYSTem:EXECutive:JOB:LIMit?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_SYSTEM_colonEXECUTIVE_colonJOB_colonLIMIT_children, 3, 17 } // Terminal: SYSTem:EXECutive:JOB:LIMit
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXECUTIVE_colonJOB_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 15 }, // Terminal: SYSTem:EXECutive:JOB:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 35, 15 } // Terminal: SYSTem:EXECutive:JOB:STATistics?
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXECUTIVE_colonJOB_colon_children[] = {
+        { 'C', 0, 2, 3, _node_SYSTEM_colonEXECUTIVE_colonJOB_colonCOUN_children, 29, 0 },
+        { 'H', 0, 2, 3, _node_SYSTEM_colonEXECUTIVE_colonJOB_colonHIST_children, 41, 0 },
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_SYSTEM_colonEXECUTIVE_colonJOB_colonLIM_children, 49, 17 }, // Terminal: SYSTem:EXECutive:JOB:LIMit
+        { 'S', 0, 2, 3, _node_SYSTEM_colonEXECUTIVE_colonJOB_colonSTAT_children, 32, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXECUTIVE_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 19 } // Terminal: SYSTem:EXECutive:RESet
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXECUTIVE_colon_children[] = {
+        { 'J', 0, 4, 3, _node_SYSTEM_colonEXECUTIVE_colonJOB_colon_children, 26, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYSTEM_colonEXECUTIVE_colonRES_children, 51, 19 }, // Terminal: SYSTem:EXECutive:RESet
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 22, 13 } // Terminal: SYSTem:EXECutive:TICK?
+    };
+    constexpr TrieNode _node_SYSTEM_colonEXEC_children[] = {
+        { ':', 0, 3, 0, _node_SYSTEM_colonEXEC_colon_children, 0, 0 },
+        { 'U', 0, 3, 5, _node_SYSTEM_colonEXECUTIVE_colon_children, 53, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colonPROF_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 29 } // Terminal: SYSTem:PROFile:RESet
+    };
+    constexpr TrieNode _node_SYSTEM_colonPROFILE_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 3, 29 } // Terminal: SYSTem:PROFile:RESet
+    };
+    constexpr TrieNode _node_SYSTEM_colonPROFILE_children[] = {
+        { ':', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_SYSTEM_colonPROFILE_colonRES_children, 89, 29 }, // Terminal: SYSTem:PROFile:RESet
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 28 } // Terminal: SYSTem:PROFile?
+    };
+    constexpr TrieNode _node_SYSTEM_colonPROF_children[] = {
+        { ':', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_SYSTEM_colonPROF_colonRES_children, 89, 29 }, // Terminal: SYSTem:PROFile:RESet
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 28 }, // Terminal: SYSTem:PROFile?
+        { 'I', 0, 2, 2, _node_SYSTEM_colonPROFILE_children, 95, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colonTASK_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 20 }, // Terminal: SYSTem:TASKs?
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 20 } // Terminal: SYSTem:TASKs?
+    };
+    constexpr TrieNode _node_SYSTEM_colon_children[] = {
+        { 'B', 0, 3, 7, _node_SYSTEM_colonBOOT_colonTIM_children, 65, 0 },
+        { 'C', 0, 2, 3, _node_SYSTEM_colonCLOC_children, 80, 0 },
+        { 'E', 0, 2, 3, _node_SYSTEM_colonEXEC_children, 19, 0 },
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 61, 21 }, // Terminal: SYSTem:LOAD?
+        { 'P', 0, 3, 3, _node_SYSTEM_colonPROF_children, 92, 0 },
+        { 'T', 0, 2, 3, _node_SYSTEM_colonTASK_children, 58, 0 }
+    };
+    constexpr TrieNode _node_SYST_children[] = {
+        { ':', uint8_t(TrieNodeFlags::BinarySearch), 6, 0, _node_SYST_colon_children, 0, 0 },
+        { 'E', uint8_t(TrieNodeFlags::BinarySearch), 6, 2, _node_SYSTEM_colon_children, 97, 0 }
+    };
+    constexpr TrieNode _node_S_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 1, 6, _node_SET_colonVOLT_children, 11, 10 }, // Terminal: SET:VOLT
+        { 'T', 0, 2, 1, _node_STR_children, 45, 0 },
+        { 'Y', 0, 2, 2, _node_SYST_children, 17, 0 }
+    };
+    constexpr TrieNode _root_children[] = {
+        { '*', 0, 3, 0, _node__star_children, 0, 0 },
+        { 'C', 0, 2, 3, _node_CAPT_children, 111, 0 },
+        { 'M', uint8_t(TrieNodeFlags::Terminal), 0, 9, nullptr, 102, 12 }, // Terminal: MEAS:VOLT?
+        { 'P', 0, 3, 4, _node_PID_colonK_children, 7, 0 },
+        { 'S', 0, 3, 0, _node_S_children, 0, 0 }
     };
     template<>
-    const TrieNode T76::SCPI::Interpreter<T76::App>::_trie = { '\0', 0, 4, _root_children, 0 };
+    constinit const TrieNode T76::SCPI::Interpreter<T76::App>::_trie = { '\0', uint8_t(TrieNodeFlags::BinarySearch), 5, 0, _root_children, 0, 0 };
 
     // Command handlers and parameters
     template<>
-    const Command<T76::App> T76::SCPI::Interpreter<T76::App>::_commands[] = {
-        { &T76::App::_queryIDN, 0, nullptr }, // *IDN?
-        { &T76::App::_resetInstrument, 0, nullptr }, // *RST
-        { &T76::App::_setKp, 1, command_2_params }, // PID:KP
-        { &T76::App::_queryKp, 0, nullptr }, // PID:KP?
-        { &T76::App::_setKi, 1, command_4_params }, // PID:KI
-        { &T76::App::_queryKi, 0, nullptr }, // PID:KI?
-        { &T76::App::_setKd, 1, command_6_params }, // PID:KD
-        { &T76::App::_queryKd, 0, nullptr }, // PID:KD?
-        { &T76::App::_setTargetVoltage, 1, command_8_params }, // SET:VOLT
-        { &T76::App::_queryTargetVoltage, 0, nullptr }, // SET:VOLT?
-        { &T76::App::_querySensedVoltage, 0, nullptr }, // MEAS:VOLT?
+    constinit const Command<T76::App> T76::SCPI::Interpreter<T76::App>::_commands[] = {
+        { nullptr, 0, nullptr, nullptr, nullptr, command_0_constant }, // 0: *IDN?
+        { &T76::App::_resetInstrument, 0, nullptr, nullptr, nullptr, nullptr }, // 1: *RST
+        { nullptr, 1, command_2_params, nullptr, command_2_trampoline, nullptr }, // 2: *SAV
+        { nullptr, 1, command_3_params, nullptr, command_3_trampoline, nullptr }, // 3: *RCL
+        { nullptr, 1, command_4_params, nullptr, command_4_trampoline, nullptr }, // 4: PID:KP
+        { &T76::App::_queryKp, 0, nullptr, nullptr, nullptr, nullptr }, // 5: PID:KP?
+        { nullptr, 1, command_6_params, nullptr, command_6_trampoline, nullptr }, // 6: PID:KI
+        { &T76::App::_queryKi, 0, nullptr, nullptr, nullptr, nullptr }, // 7: PID:KI?
+        { nullptr, 1, command_8_params, nullptr, command_8_trampoline, nullptr }, // 8: PID:KD
+        { &T76::App::_queryKd, 0, nullptr, nullptr, nullptr, nullptr }, // 9: PID:KD?
+        { nullptr, 1, command_10_params, nullptr, command_10_trampoline, nullptr }, // 10: SET:VOLT
+        { &T76::App::_queryTargetVoltage, 0, nullptr, nullptr, nullptr, nullptr }, // 11: SET:VOLT?
+        { &T76::App::_querySensedVoltage, 0, nullptr, nullptr, nullptr, nullptr }, // 12: MEAS:VOLT?
+        { &T76::App::_queryTickStats, 0, nullptr, nullptr, nullptr, nullptr }, // 13: SYSTem:EXECutive:TICK?
+        { &T76::App::_queryJobCount, 0, nullptr, nullptr, nullptr, nullptr }, // 14: SYSTem:EXECutive:JOB:COUNt?
+        { nullptr, 1, command_15_params, nullptr, command_15_trampoline, nullptr }, // 15: SYSTem:EXECutive:JOB:STATistics?
+        { nullptr, 1, command_16_params, nullptr, command_16_trampoline, nullptr }, // 16: SYSTem:EXECutive:JOB:HISTogram?
+        { &T76::App::_setJobOverrunLimit, 3, command_17_params, nullptr, nullptr, nullptr }, // 17: SYSTem:EXECutive:JOB:LIMit
+        { nullptr, 1, command_18_params, nullptr, command_18_trampoline, nullptr }, // 18: SYSTem:EXECutive:JOB:LIMit?
+        { &T76::App::_resetExecutiveStats, 0, nullptr, nullptr, nullptr, nullptr }, // 19: SYSTem:EXECutive:RESet
+        { &T76::App::_queryTasks, 0, nullptr, nullptr, nullptr, nullptr }, // 20: SYSTem:TASKs?
+        { &T76::App::_queryLoad, 0, nullptr, nullptr, nullptr, nullptr }, // 21: SYSTem:LOAD?
+        { &T76::App::_queryBootTimes, 0, nullptr, nullptr, nullptr, nullptr }, // 22: SYSTem:BOOT:TIMes?
+        { &T76::App::_queryPreviousBootTimes, 0, nullptr, nullptr, nullptr, nullptr }, // 23: SYSTem:BOOT:TIMes:PREVious?
+        { &T76::App::_queryDeviceClock, 0, nullptr, nullptr, nullptr, nullptr }, // 24: SYSTem:CLOCk:DEVice?
+        { &T76::App::_addClockSync, 3, command_25_params, nullptr, nullptr, nullptr }, // 25: SYSTem:CLOCk:SYNC
+        { &T76::App::_queryClockSync, 0, nullptr, nullptr, nullptr, nullptr }, // 26: SYSTem:CLOCk:SYNC?
+        { &T76::App::_resetClockSync, 0, nullptr, nullptr, nullptr, nullptr }, // 27: SYSTem:CLOCk:SYNC:RESet
+        { &T76::App::_queryProfile, 1, command_28_params, nullptr, nullptr, nullptr }, // 28: SYSTem:PROFile?
+        { &T76::App::_resetProfile, 0, nullptr, nullptr, nullptr, nullptr }, // 29: SYSTem:PROFile:RESet
+        { &T76::App::_startStream, 1, command_30_params, nullptr, nullptr, nullptr }, // 30: STReam:STARt
+        { &T76::App::_stopStream, 0, nullptr, nullptr, nullptr, nullptr }, // 31: STReam:STOP
+        { &T76::App::_queryStreamStats, 0, nullptr, nullptr, nullptr, nullptr }, // 32: STReam:STATistics?
+        { &T76::App::_resetStreamStats, 0, nullptr, nullptr, nullptr, nullptr }, // 33: STReam:RESet
+        { &T76::App::_setCaptureSource, 1, command_34_params, nullptr, nullptr, nullptr }, // 34: CAPTure:TRIGger:SOURce
+        { &T76::App::_setCaptureLevel, 3, command_35_params, nullptr, nullptr, nullptr }, // 35: CAPTure:TRIGger:LEVel
+        { &T76::App::_armCapture, 2, command_36_params, nullptr, nullptr, nullptr }, // 36: CAPTure:ARM
+        { &T76::App::_forceCapture, 0, nullptr, nullptr, nullptr, nullptr }, // 37: CAPTure:FORCe
+        { &T76::App::_abortCapture, 0, nullptr, nullptr, nullptr, nullptr }, // 38: CAPTure:ABORt
+        { &T76::App::_queryCaptureState, 0, nullptr, nullptr, nullptr, nullptr }, // 39: CAPTure:STATe?
+        { &T76::App::_queryCaptureData, 0, nullptr, nullptr, nullptr, nullptr }, // 40: CAPTure:DATA?
     };
 
     template<>
-    const size_t T76::SCPI::Interpreter<T76::App>::_commandCount = 11;
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_commandCount = 41;
+
+    template<>
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_maxParameterCount = 3;
 
     template<>
-    const size_t T76::SCPI::Interpreter<T76::App>::_maxParameterCount = 1;
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_maxStringParameterCount = 0;
 
 } // namespace
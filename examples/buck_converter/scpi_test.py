@@ -5,6 +5,7 @@ from time import sleep
 import sys
 import termios
 import os
+import time
 
 DEFAULT_RESOURCE_FRAGMENT = "USB0::0x2E8A::0x000A"
 
@@ -25,6 +26,28 @@ def send_scpi(command: str, resource_fragment: str = DEFAULT_RESOURCE_FRAGMENT)
         instrument.close()
 
 
+def sync_clock(count: int, interval: float, resource_fragment: str = DEFAULT_RESOURCE_FRAGMENT) -> str:
+    """Measure the host's clock against the device's and return the device's estimate."""
+    rm = pyvisa.ResourceManager()
+    resource = next((res for res in rm.list_resources()
+                    if resource_fragment in res), None)
+    if resource is None:
+        return "Device not found."
+    instrument = rm.open_resource(resource)
+    try:
+        for i in range(count):
+            sent = time.time_ns() // 1000
+            device = int(instrument.query("SYST:CLOC:DEV?"))
+            received = time.time_ns() // 1000
+            instrument.write(
+                f"SYST:CLOC:SYNC {(sent + received) // 2},{device},{received - sent}")
+            if i + 1 < count:
+                sleep(interval)
+        return instrument.query("SYST:CLOC:SYNC?")
+    finally:
+        instrument.close()
+
+
 def main() -> None:
     parser = argparse.ArgumentParser(
         description="Send a SCPI command to the connected instrument.")
@@ -58,6 +81,12 @@ def main() -> None:
         type=float,
         help="Set the target voltage setpoint.",
     )
+    parser.add_argument(
+        "-timesync",
+        type=int,
+        metavar="COUNT",
+        help="Synchronize the device's estimate of the host clock with COUNT measurements, one second apart.",
+    )
     parser.add_argument(
         "command",
         nargs="?",
@@ -158,6 +187,10 @@ def main() -> None:
         except KeyboardInterrupt:
             print("\nExiting PID monitoring.")
         return
+    elif args.timesync is not None:
+        response = sync_clock(args.timesync, 1.0, args.resource_fragment).strip()
+        print(f"points,offsetUs,driftPpb,roundTripUs,lastSyncUs: {response}")
+        return
     elif args.kp is not None:
         command = f"PID:KP {args.kp}"
     elif args.ki is not None:
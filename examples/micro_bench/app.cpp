@@ -0,0 +1,174 @@
+/**
+ * @file app.cpp
+ * @brief Micro-benchmark application implementation
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#include "app.hpp"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <hardware/clocks.h>
+
+#include <t76/safety.hpp>
+
+
+using namespace T76;
+
+
+App::App() : _interpreter(*this), _scpiTask(_interpreter, _usbInterface), _benchInterpreter(*this) {
+}
+
+void App::_onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) {
+    _scpiTask.receive(data, length, transfer_complete);
+}
+
+void App::_onUSBTMCClear() {
+    _scpiTask.clear();
+}
+
+uint8_t App::_onUSBTMCReadStatusByte() {
+    return _scpiTask.statusByte();
+}
+
+void App::_resetInstrument(T76::SCPI::Parameters params) {
+    _interpreter.reset();
+}
+
+void App::_queryClock(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(std::to_string(clock_get_hz(clk_sys)));
+}
+
+void App::_queryBenchmarks(T76::SCPI::Parameters params) {
+    std::string response;
+
+    for (const T76::Core::Bench::Benchmark *benchmark = T76::Core::Bench::Benchmark::first(); benchmark != nullptr; benchmark = benchmark->next()) {
+        char buffer[64];
+
+        snprintf(buffer, sizeof(buffer), "%s\"%s\",%u", response.empty() ? "" : ",", benchmark->name(), benchmark->core());
+        response += buffer;
+    }
+
+    _usbInterface.sendUSBTMCBulkData(response);
+}
+
+void App::_runBenchmarks(T76::SCPI::Parameters params) {
+    uint32_t samples;
+
+    if (!_samplesParameter(params, 0, samples)) {
+        return;
+    }
+
+    std::string response;
+
+    for (const T76::Core::Bench::Benchmark *benchmark = T76::Core::Bench::Benchmark::first(); benchmark != nullptr; benchmark = benchmark->next()) {
+        _appendResult(response, *benchmark, samples);
+    }
+
+    _usbInterface.sendUSBTMCBulkData(response);
+}
+
+void App::_runBenchmark(T76::SCPI::Parameters params) {
+    const T76::Core::Bench::Benchmark *benchmark = T76::Core::Bench::Benchmark::find(params[0].stringValue);
+    uint32_t samples;
+
+    if (benchmark == nullptr) {
+        _interpreter.addError(-224, "Illegal parameter value");
+        return;
+    }
+
+    if (!_samplesParameter(params, 1, samples)) {
+        return;
+    }
+
+    std::string response;
+
+    _appendResult(response, *benchmark, samples);
+    _usbInterface.sendUSBTMCBulkData(response);
+}
+
+void App::_nop(T76::SCPI::Parameters params) {
+    // Target of the SCPI benchmark; only the parsing and dispatch are measured
+}
+
+bool App::_samplesParameter(T76::SCPI::Parameters params, std::size_t index, uint32_t &samples) {
+    const double value = params[index].numberValue;
+
+    if (value < 1 || value > T76_IC_BENCH_MAX_SAMPLES || value != static_cast<uint32_t>(value)) {
+        _interpreter.addError(-222, "Data out of range");
+        return false;
+    }
+
+    samples = static_cast<uint32_t>(value);
+    return true;
+}
+
+void App::_appendResult(std::string &response, const T76::Core::Bench::Benchmark &benchmark, uint32_t samples) {
+    T76::Core::Bench::Result result;
+    char buffer[128];
+    const char *separator = response.empty() ? "" : ",";
+
+    if (T76::Core::Bench::run(benchmark, samples, result)) {
+        snprintf(buffer, sizeof(buffer), "%s\"%s\",%u,%lu,%lu,%lu,%lu,%lu", separator, benchmark.name(), benchmark.core(),
+                 (unsigned long)result.samples, (unsigned long)result.min, (unsigned long)result.median,
+                 (unsigned long)result.p99, (unsigned long)result.max);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%s\"%s\",%u,0,9.91E37,9.91E37,9.91E37,9.91E37", separator, benchmark.name(), benchmark.core());
+    }
+
+    response += buffer;
+}
+
+void App::_echoTask() {
+    uint32_t value;
+
+    for (;;) {
+        if (_ping.receive(value)) {
+            _pong.send(value);
+        }
+    }
+}
+
+bool App::activate() {
+    return true;
+}
+
+void App::makeSafe() {
+    // Nothing to make safe
+}
+
+const char* App::getComponentName() const {
+    return "App";
+}
+
+void App::_init() {
+    // Initialize stdio
+    stdio_init_all();
+}
+
+void App::_initCore0() {
+    _scpiTask.start();
+
+    // The echo task waits on _ping; core 1 waits on _pong with __wfe()
+    _ping.init();
+
+    xTaskCreate(
+        [](void* param) {
+            static_cast<App*>(param)->_echoTask();
+        },
+        "BenchEcho",
+        256,
+        this,
+        configMAX_PRIORITIES - 2,
+        nullptr
+    );
+}
+
+void App::_startCore1() {
+    for (;;) {
+        T76::Core::Safety::feedWatchdogFromCore1();
+        T76::Core::Bench::serviceCore1();
+    }
+}
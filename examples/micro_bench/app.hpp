@@ -0,0 +1,106 @@
+/**
+ * @file app.hpp
+ * @brief Micro-benchmark application class header file
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * This file contains the declaration of the App class of the `t76_bench`
+ * firmware, which runs the micro-benchmarks registered with T76_BENCH() and
+ * T76_BENCH_CORE1() and returns their results over USBTMC. The benchmarks
+ * of the framework's primitives are defined in `benchmarks.cpp`.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <cstdint>
+#include <string>
+
+#include <t76/app.hpp>
+#include <t76/bench.hpp>
+#include <t76/intercore.hpp>
+#include <t76/scpi_interpreter.hpp>
+#include <t76/scpi_task.hpp>
+
+
+namespace T76 {
+
+    /**
+     * @class App
+     * @brief Runs the registered micro-benchmarks on request
+     *
+     * Benchmarks run from the SCPI task, so that core 0 benchmarks are timed
+     * in an ordinary task and the USB stack keeps running while core 1
+     * benchmarks execute. Core 1 runs a loop that feeds the watchdog and
+     * runs the core 1 benchmarks that core 0 requests.
+     */
+    class App : public T76::Core::App {
+    public:
+
+        /**
+         * @brief SCPI command interpreter instance
+         */
+        T76::SCPI::Interpreter<T76::App> _interpreter;
+
+        /**
+         * @brief Task that executes SCPI commands, so that benchmark runs do not hold up the USB stack
+         */
+        T76::Core::SCPITask<T76::App> _scpiTask;
+
+        /**
+         * @brief Interpreter fed by the SCPI benchmark, separate from the one that serves the host
+         */
+        T76::SCPI::Interpreter<T76::App> _benchInterpreter;
+
+        /**
+         * @brief Channels of the inter-core round trip benchmark, from core 1 to the echo task and back
+         */
+        T76::Core::InterCore::Channel<uint32_t, 4> _ping;
+        T76::Core::InterCore::Channel<uint32_t, 4> _pong;
+
+        /**
+         * @brief Default constructor
+         */
+        App();
+
+        void _onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) override;
+        void _onUSBTMCClear() override;
+        uint8_t _onUSBTMCReadStatusByte() override;
+
+        void _resetInstrument(T76::SCPI::Parameters params);
+        void _queryClock(T76::SCPI::Parameters params);
+        void _queryBenchmarks(T76::SCPI::Parameters params);
+        void _runBenchmarks(T76::SCPI::Parameters params);
+        void _runBenchmark(T76::SCPI::Parameters params);
+        void _nop(T76::SCPI::Parameters params);
+
+        bool activate();
+        void makeSafe();
+        const char* getComponentName() const;
+
+        void _init();
+        void _initCore0();
+        void _startCore1();
+
+    protected:
+        /**
+         * @brief Read the sample count parameter of a run command
+         * @return true if the count is valid; otherwise, an error is added and false is returned.
+         */
+        bool _samplesParameter(T76::SCPI::Parameters params, std::size_t index, uint32_t &samples);
+
+        /**
+         * @brief Run a benchmark and append its result to a response
+         *
+         * Appends `"name",core,samples,min,median,p99,max`, with the
+         * statistics in cycles, or 9.91E37 in their place if the run failed.
+         */
+        void _appendResult(std::string &response, const T76::Core::Bench::Benchmark &benchmark, uint32_t samples);
+
+        /**
+         * @brief Task that sends every value received on _ping back on _pong
+         */
+        void _echoTask();
+
+    }; // class App
+
+}
@@ -0,0 +1,287 @@
+/**
+ * @file benchmarks.cpp
+ * @brief Micro-benchmarks of the framework's primitives
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Benchmarks that end in `_core1` run on core 1 from SRAM; the others run in
+ * the SCPI task on core 0. malloc() and free() go through T76MemoryAlloc()
+ * and T76MemoryFree(), so on core 1 they use the lock-free block pools up to
+ * 256 bytes and the inter-core FIFO to the memory service task above that.
+ * The DSP benchmarks process a block of dspBlock samples per call.
+ *
+ */
+
+#include "app.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <utility>
+
+#include <t76/dsp_average.hpp>
+#include <t76/dsp_biquad.hpp>
+#include <t76/dsp_fir.hpp>
+#include <t76/dsp_reduce.hpp>
+#include <t76/fixed_queue.hpp>
+#include <t76/safety.hpp>
+#include <t76/scpi_trie.hpp>
+
+
+extern T76::App app;
+
+
+namespace {
+
+    using T76::SCPI::TrieNode;
+    using T76::SCPI::TrieNodeFlags;
+
+    constexpr char scpiLine[] = "BENCH:NOP\n";
+
+    /**
+     * @brief Children 'A', 'B', ... of a trie node, as the SCPI generator lays them out
+     */
+    template<std::size_t... I>
+    constexpr std::array<TrieNode, sizeof...(I)> trieChildren(std::index_sequence<I...>) {
+        return {{ {static_cast<uint8_t>('A' + I), 0, 0, 0, nullptr, 0, 0}... }};
+    }
+
+    constexpr auto gLinearChildren = trieChildren(std::make_index_sequence<4>());
+    constexpr auto gBinaryChildren = trieChildren(std::make_index_sequence<16>());
+    constexpr auto gDenseChildren = trieChildren(std::make_index_sequence<26>());
+
+    TrieNode gLinearNode = {'\0', 0, 4, 0, gLinearChildren.data(), 0, 0};
+    TrieNode gBinaryNode = {'\0', uint8_t(TrieNodeFlags::BinarySearch), 16, 0, gBinaryChildren.data(), 0, 0};
+    TrieNode gDenseNode = {'\0', uint8_t(TrieNodeFlags::Dense), 26, 0, gDenseChildren.data(), 0, 0};
+
+    constexpr std::size_t dspBlock = 64;
+
+    float gFloatBlock[dspBlock];
+    int16_t gQ15Block[dspBlock];
+
+    /**
+     * @brief Fill the DSP blocks with a full-scale triangle wave
+     */
+    void fillDSPBlocks() {
+        for (std::size_t i = 0; i < dspBlock; i++) {
+            const int32_t value = static_cast<int32_t>(i < dspBlock / 2 ? i : dspBlock - i) * 2048 - 32768;
+
+            gQ15Block[i] = T76::Core::DSP::SIMD::saturate(value);
+            gFloatBlock[i] = value / 32768.0f;
+        }
+    }
+
+    /**
+     * @brief Design the 32 taps of the FIR benchmarks
+     */
+    const float *firTaps() {
+        static float taps[32];
+
+        T76::Core::DSP::lowPassFIR(taps, 32, 250000.0f, 10000.0f);
+        return taps;
+    }
+
+} // namespace
+
+
+// Memory
+
+T76_BENCH(memory_alloc_64) {
+    void *block;
+
+    state.measure([&]() { block = malloc(64); });
+    free(block);
+}
+
+T76_BENCH(memory_free_64) {
+    void *block = malloc(64);
+
+    state.measure([&]() { free(block); });
+}
+
+T76_BENCH_CORE1(memory_alloc_64_core1) {
+    void *block;
+
+    state.measure([&]() { block = malloc(64); });
+    free(block);
+}
+
+T76_BENCH_CORE1(memory_free_64_core1) {
+    void *block = malloc(64);
+
+    state.measure([&]() { free(block); });
+}
+
+T76_BENCH_CORE1(memory_alloc_proxy_core1) {
+    // Too large for the core 1 pools: a round trip through the inter-core FIFO to the memory service task
+    void *block;
+
+    state.measure([&]() { block = malloc(1024); });
+    free(block);
+}
+
+// Queues and channels
+
+T76_BENCH(fixed_queue_push_pop) {
+    static T76::Core::Utils::FixedSizeQueue<uint32_t> queue(16);
+    uint32_t value = 0;
+
+    state.measure([&]() {
+        queue.push(state.iteration());
+        queue.pop(value);
+    });
+
+    T76::Core::Bench::State::keep(value);
+}
+
+T76_BENCH_CORE1(intercore_channel_round_trip_core1) {
+    uint32_t value = 0;
+
+    state.measure([&]() {
+        app._ping.send(state.iteration());
+        app._pong.receive(value);
+    });
+
+    T76::Core::Bench::State::keep(value);
+}
+
+// SCPI
+
+T76_BENCH(scpi_process_line) {
+    state.measure([]() {
+        for (std::size_t i = 0; i < sizeof(scpiLine) - 1; i++) {
+            app._benchInterpreter.processInputCharacter(static_cast<uint8_t>(scpiLine[i]));
+        }
+    });
+}
+
+T76_BENCH(scpi_trie_linear) {
+    state.measure([]() { T76::Core::Bench::State::keep(gLinearNode.nextChild('D')); });
+}
+
+T76_BENCH(scpi_trie_binary) {
+    state.measure([]() { T76::Core::Bench::State::keep(gBinaryNode.nextChild('K')); });
+}
+
+T76_BENCH(scpi_trie_dense) {
+    state.measure([]() { T76::Core::Bench::State::keep(gDenseNode.nextChild('Z')); });
+}
+
+// DSP
+
+T76_BENCH_CORE1(dsp_biquad_f32_x2_core1) {
+    static T76::Core::DSP::Biquad<2> filter;
+
+    if (state.iteration() == 0) {
+        fillDSPBlocks();
+        filter.configure(0, T76::Core::DSP::lowPass(250000.0f, 5000.0f));
+        filter.configure(1, T76::Core::DSP::lowPass(250000.0f, 5000.0f));
+    }
+
+    float out[dspBlock];
+
+    state.measure([&]() { filter.process(gFloatBlock, out, dspBlock); });
+    T76::Core::Bench::State::keep(out[dspBlock - 1]);
+}
+
+T76_BENCH_CORE1(dsp_biquad_q15_x2_core1) {
+    static T76::Core::DSP::BiquadQ15<2> filter;
+
+    if (state.iteration() == 0) {
+        fillDSPBlocks();
+        filter.configure(0, T76::Core::DSP::lowPass(250000.0f, 5000.0f));
+        filter.configure(1, T76::Core::DSP::lowPass(250000.0f, 5000.0f));
+    }
+
+    int16_t out[dspBlock];
+
+    state.measure([&]() { filter.process(gQ15Block, out, dspBlock); });
+    T76::Core::Bench::State::keep(out[dspBlock - 1]);
+}
+
+T76_BENCH_CORE1(dsp_fir_f32_32_core1) {
+    static T76::Core::DSP::FIR<32> filter;
+
+    if (state.iteration() == 0) {
+        fillDSPBlocks();
+        filter.configure(firTaps());
+    }
+
+    float out[dspBlock];
+
+    state.measure([&]() { filter.process(gFloatBlock, out, dspBlock); });
+    T76::Core::Bench::State::keep(out[dspBlock - 1]);
+}
+
+T76_BENCH_CORE1(dsp_fir_q15_32_core1) {
+    static T76::Core::DSP::FIRQ15<32> filter;
+
+    if (state.iteration() == 0) {
+        fillDSPBlocks();
+        filter.configure(firTaps());
+    }
+
+    int16_t out[dspBlock];
+
+    state.measure([&]() { filter.process(gQ15Block, out, dspBlock); });
+    T76::Core::Bench::State::keep(out[dspBlock - 1]);
+}
+
+T76_BENCH_CORE1(dsp_decimate_q15_32x4_core1) {
+    static T76::Core::DSP::Decimator<T76::Core::DSP::FIRQ15<32>, 4> decimator;
+
+    if (state.iteration() == 0) {
+        fillDSPBlocks();
+        decimator.filter().configure(firTaps());
+    }
+
+    int16_t out[dspBlock / 4];
+
+    state.measure([&]() { decimator.process(gQ15Block, out, dspBlock); });
+    T76::Core::Bench::State::keep(out[0]);
+}
+
+T76_BENCH_CORE1(dsp_moving_average_16_core1) {
+    static T76::Core::DSP::MovingAverage<16> average;
+
+    if (state.iteration() == 0) {
+        fillDSPBlocks();
+    }
+
+    int16_t out[dspBlock];
+
+    state.measure([&]() { average.process(gQ15Block, out, dspBlock); });
+    T76::Core::Bench::State::keep(out[dspBlock - 1]);
+}
+
+T76_BENCH_CORE1(dsp_rms_q15_core1) {
+    if (state.iteration() == 0) {
+        fillDSPBlocks();
+    }
+
+    state.measure([]() { T76::Core::Bench::State::keep(T76::Core::DSP::rms(gQ15Block, dspBlock)); });
+}
+
+T76_BENCH_CORE1(dsp_rms_f32_core1) {
+    if (state.iteration() == 0) {
+        fillDSPBlocks();
+    }
+
+    state.measure([]() { T76::Core::Bench::State::keep(T76::Core::DSP::rms(gFloatBlock, dspBlock)); });
+}
+
+T76_BENCH_CORE1(dsp_min_max_q15_core1) {
+    if (state.iteration() == 0) {
+        fillDSPBlocks();
+    }
+
+    int16_t minimum, maximum;
+
+    state.measure([&]() { T76::Core::DSP::minMax(gQ15Block, dspBlock, minimum, maximum); });
+    T76::Core::Bench::State::keep(minimum);
+    T76::Core::Bench::State::keep(maximum);
+}
+
+// Safety
+
+T76_BENCH_CORE1(safety_feed_watchdog_core1) {
+    state.measure([]() { T76::Core::Safety::feedWatchdogFromCore1(); });
+}
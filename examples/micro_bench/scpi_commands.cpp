@@ -0,0 +1,142 @@
+/**
+ * @file scpi_commands.cpp
+ * 
+ * Autogenerated SCPI commands trie and handler pointers.
+ * Generated from App definition.
+ * 
+ */
+
+#include <t76/scpi_command.hpp>
+#include <t76/scpi_trie.hpp>
+#include <t76/scpi_interpreter.hpp>
+
+namespace T76 {
+    class App {
+    public:
+        void _resetInstrument(T76::SCPI::Parameters);
+        void _queryClock(T76::SCPI::Parameters);
+        void _queryBenchmarks(T76::SCPI::Parameters);
+        void _runBenchmarks(T76::SCPI::Parameters);
+        void _runBenchmark(T76::SCPI::Parameters);
+        void _nop(T76::SCPI::Parameters);
+    };
+}
+
+namespace T76::SCPI {
+
+/*
+ * Memory Usage Estimate:
+ * 
+ * Trie Structure:
+ *   - Total nodes: 15
+ *   - Children arrays: 6
+ *   - Dense table filler nodes: 0 (0 bytes)
+ *   - Node size: 12 bytes each
+ *   - Compressed segments: 28 bytes
+ *   - Trie memory: 180 bytes
+ * 
+ * Command System:
+ *   - Commands: 7 of up to 65535 (224 bytes)
+ *   - Index widths: 16-bit command index, 8-bit child count (no size cost, both fit the node's padding)
+ *   - Dispatch: handler pointers in the command table
+ *   - Parameter descriptors: 48 bytes
+ *   - String literals: 0 bytes
+ * 
+ * Total Memory Usage:
+ *   - Code/Data (Flash): 480 bytes (0.01% of 2MB)
+ *   - Runtime (SRAM): 384 bytes (0.07% of 264KB)
+ *   - Parameter storage: 320 bytes, allocated once, included in runtime
+ * 
+ * Performance Characteristics:
+ *   - Average lookup depth: ~2.8 node transitions
+ *   - Child lookups: 6 linear, 0 binary search, 0 dense
+ *   - Average character comparisons: 13.0 (13.0 with linear scans only)
+ *   - Space complexity: O(total_command_chars)
+ */    // Parameter descriptors for each command
+    constexpr ParameterDescriptor command_4_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 256},
+            .hasDefault = true,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_5_params[] = {
+        {
+            .type = ParameterType::String,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 256},
+            .hasDefault = true,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    static std::string_view command_0_constant(T76::App &) {
+        return std::string_view("MTA Inc.,T76-Bench,0001,1.0", 27);
+    }
+
+    // Segments of path-compressed trie nodes
+    template<>
+    constinit const char T76::SCPI::Interpreter<T76::App>::_trieSegments[] = "DN?STENCH:LOCIST?UNSINGE?OP";
+
+    // Trie structure
+    constexpr TrieNode _node__star_children[] = {
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 3, nullptr, 0, 0 }, // Terminal: *IDN?
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 0, 2, nullptr, 3, 1 } // Terminal: *RST
+    };
+    constexpr TrieNode _node_BENCH_colonCLOC_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 2 }, // Terminal: BENCH:CLOCk?
+        { 'K', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 2 } // Terminal: BENCH:CLOCk?
+    };
+    constexpr TrieNode _node_BENCH_colonRUN_colonSING_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 5 }, // Terminal: BENCH:RUN:SINGle?
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 0, 2, nullptr, 23, 5 } // Terminal: BENCH:RUN:SINGle?
+    };
+    constexpr TrieNode _node_BENCH_colonRUN_children[] = {
+        { ':', 0, 2, 4, _node_BENCH_colonRUN_colonSING_children, 19, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 4 } // Terminal: BENCH:RUN?
+    };
+    constexpr TrieNode _node_BENCH_colon_children[] = {
+        { 'C', 0, 2, 3, _node_BENCH_colonCLOC_children, 10, 0 },
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 13, 3 }, // Terminal: BENCH:LIST?
+        { 'N', uint8_t(TrieNodeFlags::Terminal), 0, 2, nullptr, 25, 6 }, // Terminal: BENCH:NOP
+        { 'R', 0, 2, 2, _node_BENCH_colonRUN_children, 17, 0 }
+    };
+    constexpr TrieNode _root_children[] = {
+        { '*', 0, 2, 0, _node__star_children, 0, 0 },
+        { 'B', 0, 4, 5, _node_BENCH_colon_children, 5, 0 }
+    };
+    template<>
+    constinit const TrieNode T76::SCPI::Interpreter<T76::App>::_trie = { '\0', 0, 2, 0, _root_children, 0, 0 };
+
+    // Command handlers and parameters
+    template<>
+    constinit const Command<T76::App> T76::SCPI::Interpreter<T76::App>::_commands[] = {
+        { nullptr, 0, nullptr, nullptr, nullptr, command_0_constant }, // 0: *IDN?
+        { &T76::App::_resetInstrument, 0, nullptr, nullptr, nullptr, nullptr }, // 1: *RST
+        { &T76::App::_queryClock, 0, nullptr, nullptr, nullptr, nullptr }, // 2: BENCH:CLOCk?
+        { &T76::App::_queryBenchmarks, 0, nullptr, nullptr, nullptr, nullptr }, // 3: BENCH:LIST?
+        { &T76::App::_runBenchmarks, 1, command_4_params, nullptr, nullptr, nullptr }, // 4: BENCH:RUN?
+        { &T76::App::_runBenchmark, 2, command_5_params, nullptr, nullptr, nullptr }, // 5: BENCH:RUN:SINGle?
+        { &T76::App::_nop, 0, nullptr, nullptr, nullptr, nullptr }, // 6: BENCH:NOP
+    };
+
+    template<>
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_commandCount = 7;
+
+    template<>
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_maxParameterCount = 2;
+
+    template<>
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_maxStringParameterCount = 1;
+
+} // namespace
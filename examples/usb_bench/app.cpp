@@ -0,0 +1,532 @@
+/**
+ * @file app.cpp
+ * @brief USB benchmark application implementation
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#include "app.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <tusb.h>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+
+using namespace T76;
+
+
+App::App() : _interpreter(*this), _scpiTask(_interpreter, _usbInterface) {
+    // Printable pattern, so that USBTMC responses are valid SCPI strings
+    for (size_t i = 0; i < _patternSize; i++) {
+        _pattern[i] = static_cast<uint8_t>('A' + (i % 26));
+    }
+
+    memcpy(_controlBuffer, _pattern, _controlBufferSize);
+
+    for (size_t i = 0; i < _traceSize; i++) {
+        _trace[i] = 1000.0f * sinf(2.0f * static_cast<float>(M_PI) * i / 48.0f);
+    }
+}
+
+void App::_onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) {
+    _scpiTask.receive(data, length, transfer_complete);
+}
+
+void App::_onUSBTMCClear() {
+    _scpiTask.clear();
+}
+
+uint8_t App::_onUSBTMCReadStatusByte() {
+    return _scpiTask.statusByte();
+}
+
+void App::_onVendorBytesReceived(const uint8_t *data, size_t length) {
+    _vendorBytesReceived.fetch_add(static_cast<uint32_t>(length), std::memory_order_relaxed);
+
+    if (_mode.load(std::memory_order_relaxed) == BenchMode::ECHO) {
+        _usbInterface.sendVendorBulkData(std::vector<uint8_t>(data, data + length));
+    }
+}
+
+void App::_onWinUSBBulkBytesReceived(const uint8_t *data, size_t length) {
+    _winUSBBytesReceived.fetch_add(static_cast<uint32_t>(length), std::memory_order_relaxed);
+
+    switch (_mode.load(std::memory_order_relaxed)) {
+        case BenchMode::ECHO:
+            _usbInterface.sendWinUSBBulkData(std::vector<uint8_t>(data, data + length));
+            break;
+
+        case BenchMode::RPC:
+            _scpiTask.receiveFrame(data, length);
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool App::_onWinUSBControlTransferIn(uint8_t port, const tusb_control_request_t *request) {
+    if (request->bRequest != _controlRequest || request->wLength > _controlBufferSize) {
+        return false; // Stall anything that is not a benchmark request
+    }
+
+    return _usbInterface.sendWinUSBControlTransferData(
+        port,
+        request,
+        std::vector<uint8_t>(_controlBuffer, _controlBuffer + request->wLength)
+    );
+}
+
+bool App::_onWinUSBControlTransferOutBytes(uint8_t request, uint16_t value, const uint8_t *data, size_t length) {
+    (void)value;
+
+    if (request != _controlRequest || length > _controlBufferSize) {
+        return false;
+    }
+
+    memcpy(_controlBuffer, data, length);
+    _controlLength = length;
+    _controlBytesReceived.fetch_add(static_cast<uint32_t>(length), std::memory_order_relaxed);
+
+    return true;
+}
+
+void App::_resetInstrument(T76::SCPI::Parameters params) {
+    _interpreter.reset();
+    _mode.store(BenchMode::ECHO, std::memory_order_relaxed);
+    _resetCount(params);
+}
+
+void App::_clearStatus(T76::SCPI::Parameters params) {
+    _interpreter.clearStatus();
+}
+
+void App::_queryEventStatus(T76::SCPI::Parameters params) {
+    _sendUnsigned(_interpreter.status.standardEvent.take());
+}
+
+void App::_setOperationComplete(T76::SCPI::Parameters params) {
+    _interpreter.operations.armOperationComplete();
+}
+
+void App::_queryOperationComplete(T76::SCPI::Parameters params) {
+    if (_scpiTask.waitForOperations()) {
+        _usbInterface.sendUSBTMCBulkData("1");
+    }
+}
+
+void App::_wait(T76::SCPI::Parameters params) {
+    _scpiTask.waitForOperations();
+}
+
+void App::_setEventStatusEnable(T76::SCPI::Parameters params) {
+    uint16_t mask;
+
+    if (_maskParameter(params, 0xFF, mask)) {
+        _interpreter.status.setEventStatusEnable(static_cast<uint8_t>(mask));
+    }
+}
+
+void App::_queryEventStatusEnable(T76::SCPI::Parameters params) {
+    _sendUnsigned(_interpreter.status.eventStatusEnable());
+}
+
+void App::_setServiceRequestEnable(T76::SCPI::Parameters params) {
+    uint16_t mask;
+
+    if (_maskParameter(params, 0xFF, mask)) {
+        _interpreter.status.setServiceRequestEnable(static_cast<uint8_t>(mask));
+    }
+}
+
+void App::_queryServiceRequestEnable(T76::SCPI::Parameters params) {
+    _sendUnsigned(_interpreter.status.serviceRequestEnable());
+}
+
+void App::_queryStatusByte(T76::SCPI::Parameters params) {
+    _sendUnsigned(_interpreter.statusByte());
+}
+
+void App::_queryOperationEvent(T76::SCPI::Parameters params) {
+    _sendUnsigned(_interpreter.status.operation.takeEvent());
+}
+
+void App::_queryOperationCondition(T76::SCPI::Parameters params) {
+    _sendUnsigned(_interpreter.status.operation.condition());
+}
+
+void App::_setOperationEnable(T76::SCPI::Parameters params) {
+    uint16_t mask;
+
+    if (_maskParameter(params, T76::SCPI::StatusRegister::ValidBits, mask)) {
+        _interpreter.status.operation.setEnable(mask);
+    }
+}
+
+void App::_queryOperationEnable(T76::SCPI::Parameters params) {
+    _sendUnsigned(_interpreter.status.operation.enable());
+}
+
+void App::_queryQuestionableEvent(T76::SCPI::Parameters params) {
+    _sendUnsigned(_interpreter.status.questionable.takeEvent());
+}
+
+void App::_queryQuestionableCondition(T76::SCPI::Parameters params) {
+    _sendUnsigned(_interpreter.status.questionable.condition());
+}
+
+void App::_setQuestionableEnable(T76::SCPI::Parameters params) {
+    uint16_t mask;
+
+    if (_maskParameter(params, T76::SCPI::StatusRegister::ValidBits, mask)) {
+        _interpreter.status.questionable.setEnable(mask);
+    }
+}
+
+void App::_queryQuestionableEnable(T76::SCPI::Parameters params) {
+    _sendUnsigned(_interpreter.status.questionable.enable());
+}
+
+void App::_presetStatus(T76::SCPI::Parameters params) {
+    _interpreter.status.preset();
+}
+
+bool App::_maskParameter(T76::SCPI::Parameters params, uint16_t max, uint16_t &mask) {
+    const double value = params[0].numberValue;
+
+    if (value < 0 || value > max || value != std::floor(value)) {
+        _interpreter.addError(-222, "Data out of range");
+        return false;
+    }
+
+    mask = static_cast<uint16_t>(value);
+    return true;
+}
+
+void App::_sendUnsigned(unsigned value) {
+    char buffer[8];
+    snprintf(buffer, sizeof(buffer), "%u", value);
+
+    _usbInterface.sendUSBTMCBulkData(buffer);
+}
+
+void App::_settle(T76::SCPI::Parameters params) {
+    if (params[0].numberValue < 1 || params[0].numberValue > 60000) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    if (_settling.exchange(true, std::memory_order_acq_rel)) {
+        _interpreter.addError(-213, "Init ignored; an operation is already running");
+        return;
+    }
+
+    // The operation is pending from now until the timer expires
+    _interpreter.operations.begin();
+    _interpreter.status.operation.set(_operationSettling);
+
+    const TickType_t period = std::max<TickType_t>(1, pdMS_TO_TICKS(static_cast<uint32_t>(params[0].numberValue)));
+
+    if (xTimerChangePeriod(_settleTimer, period, 0) != pdPASS) {
+        LOGE("USB bench: cannot start the settle timer\n");
+        _settling.store(false, std::memory_order_release);
+        _interpreter.status.operation.clear(_operationSettling);
+        _interpreter.operations.complete();
+    }
+}
+
+void App::_queryPayload(T76::SCPI::Parameters params) {
+    // The whole response, including the terminator, must fit in the bulk IN
+    // ring, since a message is only sent once it has been written in full
+    static constexpr size_t maxSize = T76_IC_USB_INTERFACE_BULK_IN_BUFFER_SIZE - 1;
+
+    if (params[0].numberValue < 0 || params[0].numberValue > maxSize) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    size_t remaining = static_cast<size_t>(params[0].numberValue);
+
+    while (remaining > 0) {
+        const size_t chunk = std::min(remaining, _patternSize);
+        _usbInterface.sendUSBTMCBulkData(_pattern, chunk, false);
+        remaining -= chunk;
+    }
+
+    const uint8_t newline = '\n';
+    _usbInterface.sendUSBTMCBulkData(&newline, 1, true);
+}
+
+void App::_queryTrace(T76::SCPI::Parameters params) {
+    if (params[0].numberValue < 1 || params[0].numberValue > _traceSize) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    const size_t points = static_cast<size_t>(params[0].numberValue);
+
+    if (_interpreter.dataFormat.type == T76::SCPI::DataType::ASCii) {
+        std::string response;
+        char value[16];
+
+        for (size_t i = 0; i < points; i++) {
+            snprintf(value, sizeof(value), i ? ",%.6g" : "%.6g", _trace[i]);
+            response += value;
+        }
+
+        // Text takes several times the room of a block, and must fit in the bulk IN ring as well
+        if (response.size() >= T76_IC_USB_INTERFACE_BULK_IN_BUFFER_SIZE) {
+            _interpreter.addError(-223, "Too much data");
+            return;
+        }
+
+        _usbInterface.sendUSBTMCBulkData(response);
+        return;
+    }
+
+    // The samples are converted as they are written into the bulk IN ring
+    T76::SCPI::BlockEncoder<float> block(_trace, points, _interpreter.dataFormat);
+    _usbInterface.fillUSBTMCBulkData(block.size(), T76::SCPI::BlockEncoder<float>::fill, &block);
+}
+
+void App::_setFormat(T76::SCPI::Parameters params) {
+    if (!_interpreter.dataFormat.setType(params[0].stringValue, params[1].numberValue)) {
+        _interpreter.addError(-224, "Illegal parameter value");
+    }
+}
+
+void App::_queryFormat(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(_interpreter.dataFormat.typeName());
+}
+
+void App::_setByteOrder(T76::SCPI::Parameters params) {
+    _interpreter.dataFormat.setByteOrder(params[0].stringValue);
+}
+
+void App::_queryByteOrder(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(_interpreter.dataFormat.byteOrderName());
+}
+
+void App::_setMode(T76::SCPI::Parameters params) {
+    // The choices are declared in the order of BenchMode
+    _mode.store(static_cast<BenchMode>(params[0].enumIndex), std::memory_order_relaxed);
+}
+
+void App::_queryMode(T76::SCPI::Parameters params) {
+    static const char *const names[] = {"ECHO", "SINK", "RPC"};
+
+    _usbInterface.sendUSBTMCBulkData(names[static_cast<uint32_t>(_mode.load(std::memory_order_relaxed))]);
+}
+
+void App::_queryCount(T76::SCPI::Parameters params) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%lu,%lu,%lu",
+             (unsigned long)_vendorBytesReceived.load(std::memory_order_relaxed),
+             (unsigned long)_winUSBBytesReceived.load(std::memory_order_relaxed),
+             (unsigned long)_controlBytesReceived.load(std::memory_order_relaxed));
+
+    _usbInterface.sendUSBTMCBulkData(std::string(buffer));
+}
+
+void App::_resetCount(T76::SCPI::Parameters params) {
+    _vendorBytesReceived.store(0, std::memory_order_relaxed);
+    _winUSBBytesReceived.store(0, std::memory_order_relaxed);
+    _controlBytesReceived.store(0, std::memory_order_relaxed);
+}
+
+void App::_sendVendor(T76::SCPI::Parameters params) {
+    _queueSend(false, params);
+}
+
+void App::_sendWinUSB(T76::SCPI::Parameters params) {
+    _queueSend(true, params);
+}
+
+void App::_queueSend(bool winUSB, T76::SCPI::Parameters params) {
+    if (params[0].numberValue < 1 || params[1].numberValue < 1 || params[1].numberValue > _patternSize) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    SendRequest request = {
+        .winUSB = winUSB,
+        .total = static_cast<uint32_t>(params[0].numberValue),
+        .frame = static_cast<uint32_t>(params[1].numberValue),
+    };
+
+    if (xQueueSend(_sendQueue, &request, 0) != pdTRUE) {
+        _interpreter.addError(-213, "Init ignored; a stream is already running");
+    }
+}
+
+void App::_senderTask() {
+    SendRequest request;
+
+    for (;;) {
+        if (xQueueReceive(_sendQueue, &request, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        uint32_t remaining = request.total;
+
+        while (remaining > 0) {
+            const uint32_t frame = std::min(remaining, request.frame);
+            const std::vector<uint8_t> data(_pattern, _pattern + frame);
+
+            if (request.winUSB) {
+                _usbInterface.sendWinUSBBulkData(data);
+            } else {
+                _usbInterface.sendVendorBulkData(data);
+            }
+
+            remaining -= frame;
+        }
+    }
+}
+
+void App::_queryUSBStats(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(_usbInterface.statsReport());
+}
+
+void App::_queryUSBLatency(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(_usbInterface.dispatchLatencyReport());
+}
+
+void App::_resetUSBStats(T76::SCPI::Parameters params) {
+    _usbInterface.resetStats();
+}
+
+void App::_trigger(T76::SCPI::Parameters params) {
+    _usbInterface.fireTrigger();
+}
+
+void App::_queryTriggerStats(T76::SCPI::Parameters params) {
+    const T76::Core::USB::Interface::TriggerStats stats = _usbInterface.triggerStats();
+    char buffer[96];
+
+    snprintf(buffer, sizeof(buffer), "%lu,%lu,%lu,%lu,%lu,%lu,%lu",
+             static_cast<unsigned long>(stats.fired), static_cast<unsigned long>(stats.delivered),
+             static_cast<unsigned long>(stats.missed), static_cast<unsigned long>(stats.lastLatencyUs),
+             static_cast<unsigned long>(stats.minLatencyUs), static_cast<unsigned long>(stats.maxLatencyUs),
+             static_cast<unsigned long>(stats.meanLatencyUs));
+
+    _usbInterface.sendUSBTMCBulkData(buffer);
+}
+
+void App::_resetTriggerStats(T76::SCPI::Parameters params) {
+    _usbInterface.resetTriggerStats();
+}
+
+void App::_setTraceState(T76::SCPI::Parameters params) {
+    if (params[0].booleanValue) {
+        T76::Core::Trace::start();
+    } else {
+        T76::Core::Trace::stop();
+    }
+}
+
+void App::_queryTraceState(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(T76::Core::Trace::stats().running ? "1" : "0");
+}
+
+void App::_queryTraceStats(T76::SCPI::Parameters params) {
+    const T76::Core::Trace::Stats stats = T76::Core::Trace::stats();
+    char buffer[48];
+
+    snprintf(buffer, sizeof(buffer), "%lu,%lu,%llu",
+             static_cast<unsigned long>(stats.events), static_cast<unsigned long>(stats.dropped),
+             static_cast<unsigned long long>(stats.bytesStreamed));
+
+    _usbInterface.sendUSBTMCBulkData(buffer);
+}
+
+void App::_queryFlightRecorder(T76::SCPI::Parameters params) {
+    _sendFlightRecorderEvents(false);
+}
+
+void App::_queryFlightRecorderFault(T76::SCPI::Parameters params) {
+    _sendFlightRecorderEvents(true);
+}
+
+void App::_sendFlightRecorderEvents(bool lastFault) {
+    using namespace T76::Core::Safety;
+
+    // Large enough for a whole ring, so kept out of the handler task's stack
+    static FlightRecorder::Event events[T76_SAFETY_FLIGHT_RECORDER_SIZE];
+
+    const size_t count = lastFault ? FlightRecorder::copyLastFault(events, T76_SAFETY_FLIGHT_RECORDER_SIZE)
+                                   : FlightRecorder::copyCurrent(events, T76_SAFETY_FLIGHT_RECORDER_SIZE);
+
+    // The records go out as they are in memory, as little-endian 32-bit words
+    T76::SCPI::DataFormat format;
+    format.type = T76::SCPI::DataType::Int32;
+    format.byteOrder = T76::SCPI::ByteOrder::Swapped;
+
+    T76::SCPI::BlockEncoder<int32_t> block(reinterpret_cast<const int32_t *>(events), count * sizeof(FlightRecorder::Event) / sizeof(int32_t), format);
+    _usbInterface.fillUSBTMCBulkData(block.size(), T76::SCPI::BlockEncoder<int32_t>::fill, &block);
+}
+
+void App::_onTrigger(void *context, uint32_t timestampUs) {
+    // An instrument would start its acquisition here
+}
+
+bool App::activate() {
+    return true;
+}
+
+void App::makeSafe() {
+    // Currently does nothing
+}
+
+const char* App::getComponentName() const {
+    return "App";
+}
+
+void App::_init() {
+    // Initialize stdio
+    stdio_init_all();
+}
+
+void App::_initCore0() {
+    _scpiTask.start();
+
+    _sendQueue = xQueueCreate(1, sizeof(SendRequest));
+
+    _settleTimer = xTimerCreate("BenchSettle", 1, pdFALSE, this, [](TimerHandle_t timer) {
+        App *app = static_cast<App*>(pvTimerGetTimerID(timer));
+
+        app->_settling.store(false, std::memory_order_release);
+        app->_interpreter.status.operation.clear(_operationSettling);
+        app->_interpreter.operations.complete();
+    });
+
+    xTaskCreate(
+        [](void* param) {
+            static_cast<App*>(param)->_senderTask();
+        },
+        "BenchSender",
+        1024,
+        this,
+        1,
+        nullptr
+    );
+}
+
+void App::_startCore1() {
+    // Triggers interrupt the loop below, so they are not held up by the sleep
+    _usbInterface.attachTriggerAction(_onTrigger, this);
+
+    for(;;) {
+        T76::Core::Safety::feedWatchdogFromCore1();
+        sleep_ms(100);
+    }
+}
@@ -0,0 +1,209 @@
+/**
+ * @file app.hpp
+ * @brief USB benchmark application class header file
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * This file contains the declaration of the App class which implements the
+ * device side of the USB transport benchmark. The host side lives in
+ * `usb_bench.py`.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <timers.h>
+
+#include <t76/app.hpp>
+#include <t76/scpi_interpreter.hpp>
+#include <t76/scpi_task.hpp>
+
+
+namespace T76 {
+
+    /**
+     * @brief What the benchmark does with vendor and WinUSB bulk OUT data
+     */
+    enum class BenchMode : uint32_t {
+        ECHO = 0,           ///< Send every packet straight back to the host
+        SINK = 1,           ///< Count the bytes and discard them
+        RPC = 2,            ///< Execute WinUSB frames as binary SCPI requests; vendor data is discarded
+    };
+
+    /**
+     * @class App
+     * @brief Device side of the USB throughput and latency benchmark
+     *
+     * The application exposes one test fixture per transport:
+     * - USBTMC: `BENCH:PAYLoad?` returns a response of any size up to the
+     *   bulk IN ring capacity
+     * - USBTMC binary blocks: `BENCH:TRACe?` returns a waveform in the format
+     *   selected by `FORMat:DATA` and `FORMat:BORDer`
+     * - Vendor and WinUSB bulk: OUT data is echoed back or counted, and
+     *   `BENCH:VENDor:SEND` / `BENCH:WINUSB:SEND` stream data to the host
+     * - Overlapped commands: `BENCH:SETTle` starts an operation that
+     *   completes on a timer, for `*OPC`, `*OPC?` and `*WAI`, and sets the
+     *   settling bit of `STATus:OPERation` while it runs, so that `*SRE`
+     *   and `STATus:OPERation:ENABle` can request service when it starts
+     *   or, through `*ESE 1;*OPC`, when it completes
+     * - Control transfers: vendor requests to the WinUSB interface store
+     *   (OUT) and return (IN) a payload of up to `_controlBufferSize` bytes
+     * - Triggers: USBTMC TRIGGER messages and `*TRG` are delivered to an
+     *   action on core 1, and `BENCH:TRIGger:STATistics?` reports the latency
+     *   from the USB callback to the action
+     */
+    class App : public T76::Core::App {
+    public:
+
+        /**
+         * @brief SCPI command interpreter instance
+         */
+        T76::SCPI::Interpreter<T76::App> _interpreter;
+
+        /**
+         * @brief Task that executes SCPI commands, so that slow handlers do not hold up the USB stack
+         */
+        T76::Core::SCPITask<T76::App> _scpiTask;
+
+        /**
+         * @brief Default constructor
+         */
+        App();
+
+        void _onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) override;
+        void _onUSBTMCClear() override;
+        uint8_t _onUSBTMCReadStatusByte() override;
+        void _onVendorBytesReceived(const uint8_t *data, size_t length) override;
+        void _onWinUSBBulkBytesReceived(const uint8_t *data, size_t length) override;
+        bool _onWinUSBControlTransferIn(uint8_t port, const tusb_control_request_t *request) override;
+        bool _onWinUSBControlTransferOutBytes(uint8_t request, uint16_t value, const uint8_t *data, size_t length) override;
+
+        void _resetInstrument(T76::SCPI::Parameters params);
+        void _clearStatus(T76::SCPI::Parameters params);
+        void _queryEventStatus(T76::SCPI::Parameters params);
+        void _setOperationComplete(T76::SCPI::Parameters params);
+        void _queryOperationComplete(T76::SCPI::Parameters params);
+        void _wait(T76::SCPI::Parameters params);
+        void _setEventStatusEnable(T76::SCPI::Parameters params);
+        void _queryEventStatusEnable(T76::SCPI::Parameters params);
+        void _setServiceRequestEnable(T76::SCPI::Parameters params);
+        void _queryServiceRequestEnable(T76::SCPI::Parameters params);
+        void _queryStatusByte(T76::SCPI::Parameters params);
+        void _queryOperationEvent(T76::SCPI::Parameters params);
+        void _queryOperationCondition(T76::SCPI::Parameters params);
+        void _setOperationEnable(T76::SCPI::Parameters params);
+        void _queryOperationEnable(T76::SCPI::Parameters params);
+        void _queryQuestionableEvent(T76::SCPI::Parameters params);
+        void _queryQuestionableCondition(T76::SCPI::Parameters params);
+        void _setQuestionableEnable(T76::SCPI::Parameters params);
+        void _queryQuestionableEnable(T76::SCPI::Parameters params);
+        void _presetStatus(T76::SCPI::Parameters params);
+        void _settle(T76::SCPI::Parameters params);
+        void _queryPayload(T76::SCPI::Parameters params);
+        void _queryTrace(T76::SCPI::Parameters params);
+        void _setFormat(T76::SCPI::Parameters params);
+        void _queryFormat(T76::SCPI::Parameters params);
+        void _setByteOrder(T76::SCPI::Parameters params);
+        void _queryByteOrder(T76::SCPI::Parameters params);
+        void _setMode(T76::SCPI::Parameters params);
+        void _queryMode(T76::SCPI::Parameters params);
+        void _queryCount(T76::SCPI::Parameters params);
+        void _resetCount(T76::SCPI::Parameters params);
+        void _sendVendor(T76::SCPI::Parameters params);
+        void _sendWinUSB(T76::SCPI::Parameters params);
+        void _queryUSBStats(T76::SCPI::Parameters params);
+        void _queryUSBLatency(T76::SCPI::Parameters params);
+        void _resetUSBStats(T76::SCPI::Parameters params);
+        void _trigger(T76::SCPI::Parameters params);
+        void _queryTriggerStats(T76::SCPI::Parameters params);
+        void _resetTriggerStats(T76::SCPI::Parameters params);
+        void _setTraceState(T76::SCPI::Parameters params);
+        void _queryTraceState(T76::SCPI::Parameters params);
+        void _queryTraceStats(T76::SCPI::Parameters params);
+        void _queryFlightRecorder(T76::SCPI::Parameters params);
+        void _queryFlightRecorderFault(T76::SCPI::Parameters params);
+        void _sendFlightRecorderEvents(bool lastFault);
+
+        bool activate();
+        void makeSafe();
+        const char* getComponentName() const;
+
+        void _init();
+        void _initCore0();
+        void _startCore1();
+
+    protected:
+        static constexpr uint8_t _controlRequest = 0x10;        ///< bRequest of the benchmark control transfers
+        static constexpr size_t _controlBufferSize = 4096;      ///< Largest control transfer payload
+        static constexpr size_t _patternSize = 4096;            ///< Largest frame sent by the IN streams
+        static constexpr size_t _traceSize = 480;               ///< Points in the test waveform; as REAL,32 they fit in the bulk IN ring
+        static constexpr uint16_t _operationSettling = 0x0002;  ///< STATus:OPERation bit set while BENCH:SETTle is pending
+
+        /**
+         * @brief A bulk IN stream queued for the sender task
+         */
+        struct SendRequest {
+            bool winUSB;            ///< true for WinUSB, false for vendor
+            uint32_t total;         ///< Total number of bytes to send
+            uint32_t frame;         ///< Bytes per send call
+        };
+
+        /**
+         * @brief Parse the size parameters of a SEND command and queue the stream
+         */
+        void _queueSend(bool winUSB, T76::SCPI::Parameters params);
+
+        /**
+         * @brief Read the enable mask parameter of a status command
+         *
+         * @param params The parameters of the command.
+         * @param max The largest valid mask.
+         * @param mask Where to store the mask.
+         * @return true if the mask is valid; otherwise, an error is added and false is returned.
+         */
+        bool _maskParameter(T76::SCPI::Parameters params, uint16_t max, uint16_t &mask);
+
+        /**
+         * @brief Send an unsigned integer as the response to a query
+         */
+        void _sendUnsigned(unsigned value);
+
+        /**
+         * @brief Task that runs queued bulk IN streams
+         *
+         * Sends block until the USB stack has room, so they are not made
+         * from the SCPI task, which would stop executing commands.
+         */
+        void _senderTask();
+
+        /**
+         * @brief Trigger action, run from the doorbell interrupt on core 1
+         *
+         * Does nothing: the latency to reach it is what the benchmark
+         * measures, and the interface counts the triggers it delivers.
+         */
+        static void _onTrigger(void *context, uint32_t timestampUs);
+
+        std::atomic<BenchMode> _mode{BenchMode::ECHO};          ///< What to do with bulk OUT data
+        std::atomic<uint32_t> _vendorBytesReceived{0};          ///< Vendor bulk OUT bytes received
+        std::atomic<uint32_t> _winUSBBytesReceived{0};          ///< WinUSB bulk OUT bytes received
+        std::atomic<uint32_t> _controlBytesReceived{0};         ///< Control OUT bytes received
+        std::atomic<bool> _settling{false};                     ///< Whether the BENCH:SETTle operation is pending
+
+        QueueHandle_t _sendQueue = nullptr;                     ///< Streams waiting for the sender task
+        TimerHandle_t _settleTimer = nullptr;                   ///< Completes the operation started by BENCH:SETTle
+
+        uint8_t _controlBuffer[_controlBufferSize];             ///< Payload returned by control IN transfers
+        size_t _controlLength = 0;                              ///< Bytes stored by the last control OUT transfer
+        uint8_t _pattern[_patternSize];                         ///< Data sent by responses and IN streams
+        float _trace[_traceSize];                               ///< Test waveform returned by BENCH:TRACe?
+
+    }; // class App
+
+}
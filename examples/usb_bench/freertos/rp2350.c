@@ -0,0 +1,5 @@
+#include <FreeRTOS.h>
+#include <task.h>
+
+// Note: The actual vApplicationStackOverflowHook implementation 
+// is now provided by the safety system in safety.cpp
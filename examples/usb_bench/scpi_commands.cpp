@@ -0,0 +1,827 @@
+/**
+ * @file scpi_commands.cpp
+ * 
+ * Autogenerated SCPI commands trie and handler pointers.
+ * Generated from App definition.
+ * 
+ */
+
+#include <t76/scpi_command.hpp>
+#include <t76/scpi_trie.hpp>
+#include <t76/scpi_interpreter.hpp>
+
+namespace T76 {
+    class App {
+    public:
+        void _resetInstrument(T76::SCPI::Parameters);
+        void _clearStatus(T76::SCPI::Parameters);
+        void _queryEventStatus(T76::SCPI::Parameters);
+        void _setOperationComplete(T76::SCPI::Parameters);
+        void _queryOperationComplete(T76::SCPI::Parameters);
+        void _wait(T76::SCPI::Parameters);
+        void _setEventStatusEnable(T76::SCPI::Parameters);
+        void _queryEventStatusEnable(T76::SCPI::Parameters);
+        void _setServiceRequestEnable(T76::SCPI::Parameters);
+        void _queryServiceRequestEnable(T76::SCPI::Parameters);
+        void _queryStatusByte(T76::SCPI::Parameters);
+        void _queryOperationEvent(T76::SCPI::Parameters);
+        void _queryOperationCondition(T76::SCPI::Parameters);
+        void _setOperationEnable(T76::SCPI::Parameters);
+        void _queryOperationEnable(T76::SCPI::Parameters);
+        void _queryQuestionableEvent(T76::SCPI::Parameters);
+        void _queryQuestionableCondition(T76::SCPI::Parameters);
+        void _setQuestionableEnable(T76::SCPI::Parameters);
+        void _queryQuestionableEnable(T76::SCPI::Parameters);
+        void _presetStatus(T76::SCPI::Parameters);
+        void _queryPayload(T76::SCPI::Parameters);
+        void _queryTrace(T76::SCPI::Parameters);
+        void _settle(T76::SCPI::Parameters);
+        void _setFormat(T76::SCPI::Parameters);
+        void _queryFormat(T76::SCPI::Parameters);
+        void _setByteOrder(T76::SCPI::Parameters);
+        void _queryByteOrder(T76::SCPI::Parameters);
+        void _setMode(T76::SCPI::Parameters);
+        void _queryMode(T76::SCPI::Parameters);
+        void _queryCount(T76::SCPI::Parameters);
+        void _resetCount(T76::SCPI::Parameters);
+        void _sendVendor(T76::SCPI::Parameters);
+        void _sendWinUSB(T76::SCPI::Parameters);
+        void _queryUSBStats(T76::SCPI::Parameters);
+        void _queryUSBLatency(T76::SCPI::Parameters);
+        void _resetUSBStats(T76::SCPI::Parameters);
+        void _trigger(T76::SCPI::Parameters);
+        void _queryTriggerStats(T76::SCPI::Parameters);
+        void _resetTriggerStats(T76::SCPI::Parameters);
+        void _setTraceState(T76::SCPI::Parameters);
+        void _queryTraceState(T76::SCPI::Parameters);
+        void _queryTraceStats(T76::SCPI::Parameters);
+        void _queryFlightRecorder(T76::SCPI::Parameters);
+        void _queryFlightRecorderFault(T76::SCPI::Parameters);
+    };
+}
+
+namespace T76::SCPI {
+
+/*
+ * Memory Usage Estimate:
+ * 
+ * Trie Structure:
+ *   - Total nodes: 247
+ *   - Children arrays: 121
+ *   - Dense table filler nodes: 0 (0 bytes)
+ *   - Node size: 12 bytes each
+ *   - Compressed segments: 145 bytes
+ *   - Trie memory: 2964 bytes
+ * 
+ * Command System:
+ *   - Commands: 47 of up to 65535 (1504 bytes)
+ *   - Index widths: 16-bit command index, 8-bit child count (no size cost, both fit the node's padding)
+ *   - Dispatch: handler pointers in the command table
+ *   - Parameter descriptors: 256 bytes
+ *   - String literals: 66 bytes
+ * 
+ * Total Memory Usage:
+ *   - Code/Data (Flash): 4935 bytes (0.12% of 2MB)
+ *   - Runtime (SRAM): 128 bytes (0.02% of 264KB)
+ *   - Parameter storage: 64 bytes, allocated once, included in runtime
+ * 
+ * Performance Characteristics:
+ *   - Average lookup depth: ~6.1 node transitions
+ *   - Child lookups: 119 linear, 2 binary search, 0 dense
+ *   - Average character comparisons: 21.7 (22.1 with linear scans only)
+ *   - Space complexity: O(total_command_chars)
+ */    // Parameter descriptors for each command
+    constexpr const char* command_26_param_0_choices[] = {
+        "ASC",
+        "ASCII",
+        "REAL",
+        "INT",
+        "INTEGER",
+    };
+
+    constexpr const char* command_28_param_0_choices[] = {
+        "NORM",
+        "NORMAL",
+        "SWAP",
+        "SWAPPED",
+    };
+
+    constexpr const char* command_30_param_0_choices[] = {
+        "ECHO",
+        "SINK",
+        "RPC",
+    };
+
+    constexpr ParameterDescriptor command_7_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_9_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_15_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_20_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_23_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_24_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_25_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_26_params[] = {
+        {
+            .type = ParameterType::Enum,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 5,
+            .choices = command_26_param_0_choices
+        },
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = true,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_28_params[] = {
+        {
+            .type = ParameterType::Enum,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 4,
+            .choices = command_28_param_0_choices
+        },
+    };
+
+    constexpr ParameterDescriptor command_30_params[] = {
+        {
+            .type = ParameterType::Enum,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 3,
+            .choices = command_30_param_0_choices
+        },
+    };
+
+    constexpr ParameterDescriptor command_34_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 4096},
+            .hasDefault = true,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_35_params[] = {
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+        {
+            .type = ParameterType::Number,
+            .defaultValue = {.numberValue = 4096},
+            .hasDefault = true,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    constexpr ParameterDescriptor command_42_params[] = {
+        {
+            .type = ParameterType::Boolean,
+            .defaultValue = {.numberValue = 0},
+            .hasDefault = false,
+            .choiceCount = 0,
+            .choices = nullptr
+        },
+    };
+
+    static std::string_view command_0_constant(T76::App &) {
+        return std::string_view("MTA Inc.,T76-USB-Bench,0001,1.0", 31);
+    }
+
+    // Segments of path-compressed trie nodes
+    template<>
+    constinit const char T76::SCPI::Interpreter<T76::App>::_trieSegments[] = "DN?STLSPCAIEB?RGATPERTIONENABONDTION?UESIONABLERESS:SB:TATSTICS?NCY?RACSTATECRDERFAULM:ENCH:AYLAD?ER:ETTODEOUNENDSENDR:SENDINUSB:SENDORMATAORDT:";
+
+    // Trie structure
+    constexpr TrieNode _node__starESE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 8 } // Terminal: *ESE?
+    };
+    constexpr TrieNode _node__starES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 1, 0, _node__starESE_children, 0, 7 }, // Terminal: *ESE
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 3 } // Terminal: *ESR?
+    };
+    constexpr TrieNode _node__starOPC_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 5 } // Terminal: *OPC?
+    };
+    constexpr TrieNode _node__starSRE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 10 } // Terminal: *SRE?
+    };
+    constexpr TrieNode _node__starS_children[] = {
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node__starSRE_children, 11, 9 }, // Terminal: *SRE
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 2, nullptr, 12, 11 } // Terminal: *STB?
+    };
+    constexpr TrieNode _node__star_children[] = {
+        { 'C', uint8_t(TrieNodeFlags::Terminal), 0, 2, nullptr, 5, 2 }, // Terminal: *CLS
+        { 'E', 0, 2, 1, _node__starES_children, 3, 0 },
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 3, nullptr, 0, 0 }, // Terminal: *IDN?
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node__starOPC_children, 7, 4 }, // Terminal: *OPC
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 0, 2, nullptr, 3, 1 }, // Terminal: *RST
+        { 'S', 0, 2, 0, _node__starS_children, 0, 0 },
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 2, nullptr, 14, 39 }, // Terminal: *TRG
+        { 'W', uint8_t(TrieNodeFlags::Terminal), 0, 2, nullptr, 9, 6 } // Terminal: *WAI
+    };
+    constexpr TrieNode _node_BENCH_colonCOUN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 32 }, // Terminal: BENCH:COUNt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 32 } // Terminal: BENCH:COUNt?
+    };
+    constexpr TrieNode _node_BENCH_colonMODE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 31 } // Terminal: BENCH:MODE?
+    };
+    constexpr TrieNode _node_BENCH_colonPAYL_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 23 }, // Terminal: BENCH:PAYLoad?
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 3, nullptr, 95, 23 } // Terminal: BENCH:PAYLoad?
+    };
+    constexpr TrieNode _node_BENCH_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 33 } // Terminal: BENCH:RESet
+    };
+    constexpr TrieNode _node_BENCH_colonSETT_children[] = {
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 11, 25 } // Terminal: BENCH:SETTle
+    };
+    constexpr TrieNode _node_BENCH_colonTRAC_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 24 }, // Terminal: BENCH:TRACe?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 24 } // Terminal: BENCH:TRACe?
+    };
+    constexpr TrieNode _node_BENCH_colonTRIG_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 41 } // Terminal: BENCH:TRIGger:RESet
+    };
+    constexpr TrieNode _node_BENCH_colonTRIG_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 40 }, // Terminal: BENCH:TRIGger:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 58, 40 } // Terminal: BENCH:TRIGger:STATistics?
+    };
+    constexpr TrieNode _node_BENCH_colonTRIG_colon_children[] = {
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_BENCH_colonTRIG_colonRES_children, 38, 41 }, // Terminal: BENCH:TRIGger:RESet
+        { 'S', 0, 2, 3, _node_BENCH_colonTRIG_colonSTAT_children, 55, 0 }
+    };
+    constexpr TrieNode _node_BENCH_colonTRIGGER_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 41 } // Terminal: BENCH:TRIGger:RESet
+    };
+    constexpr TrieNode _node_BENCH_colonTRIGGER_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 40 }, // Terminal: BENCH:TRIGger:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 58, 40 } // Terminal: BENCH:TRIGger:STATistics?
+    };
+    constexpr TrieNode _node_BENCH_colonTRIGGER_colon_children[] = {
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_BENCH_colonTRIGGER_colonRES_children, 38, 41 }, // Terminal: BENCH:TRIGger:RESet
+        { 'S', 0, 2, 3, _node_BENCH_colonTRIGGER_colonSTAT_children, 55, 0 }
+    };
+    constexpr TrieNode _node_BENCH_colonTRIG_children[] = {
+        { ':', 0, 2, 0, _node_BENCH_colonTRIG_colon_children, 0, 0 },
+        { 'G', 0, 2, 3, _node_BENCH_colonTRIGGER_colon_children, 98, 0 }
+    };
+    constexpr TrieNode _node_BENCH_colonTR_children[] = {
+        { 'A', 0, 2, 1, _node_BENCH_colonTRAC_children, 8, 0 },
+        { 'I', 0, 2, 1, _node_BENCH_colonTRIG_children, 15, 0 }
+    };
+    constexpr TrieNode _node_BENCH_colonVEND_children[] = {
+        { ':', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 113, 34 }, // Terminal: BENCH:VENDor:SEND
+        { 'O', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 117, 34 } // Terminal: BENCH:VENDor:SEND
+    };
+    constexpr TrieNode _node_BENCH_colon_children[] = {
+        { 'C', 0, 2, 3, _node_BENCH_colonCOUN_children, 107, 0 },
+        { 'M', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_BENCH_colonMODE_children, 104, 30 }, // Terminal: BENCH:MODE
+        { 'P', 0, 2, 3, _node_BENCH_colonPAYL_children, 92, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_BENCH_colonRES_children, 38, 33 }, // Terminal: BENCH:RESet
+        { 'S', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_BENCH_colonSETT_children, 101, 25 }, // Terminal: BENCH:SETTle
+        { 'T', 0, 2, 1, _node_BENCH_colonTR_children, 14, 0 },
+        { 'V', 0, 2, 3, _node_BENCH_colonVEND_children, 110, 0 },
+        { 'W', uint8_t(TrieNodeFlags::Terminal), 0, 10, nullptr, 123, 35 } // Terminal: BENCH:WINUSB:SEND
+    };
+    constexpr TrieNode _node_FORM_colonBORDER_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 29 } // Terminal: FORMat:BORDer?
+    };
+    constexpr TrieNode _node_FORM_colonBORD_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 29 }, // Terminal: FORMat:BORDer?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_FORM_colonBORDER_children, 14, 28 } // Terminal: FORMat:BORDer
+    };
+    constexpr TrieNode _node_FORM_colonDATA_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 27 } // Terminal: FORMat:DATA?
+    };
+    constexpr TrieNode _node_FORM_colon_children[] = {
+        { 'B', uint8_t(TrieNodeFlags::Terminal), 2, 3, _node_FORM_colonBORD_children, 139, 28 }, // Terminal: FORMat:BORDer
+        { 'D', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_FORM_colonDATA_children, 136, 26 } // Terminal: FORMat:DATA
+    };
+    constexpr TrieNode _node_FORMAT_colonBORDER_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 29 } // Terminal: FORMat:BORDer?
+    };
+    constexpr TrieNode _node_FORMAT_colonBORD_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 29 }, // Terminal: FORMat:BORDer?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_FORMAT_colonBORDER_children, 14, 28 } // Terminal: FORMat:BORDer
+    };
+    constexpr TrieNode _node_FORMAT_colonDATA_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 27 } // Terminal: FORMat:DATA?
+    };
+    constexpr TrieNode _node_FORMAT_colon_children[] = {
+        { 'B', uint8_t(TrieNodeFlags::Terminal), 2, 3, _node_FORMAT_colonBORD_children, 139, 28 }, // Terminal: FORMat:BORDer
+        { 'D', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_FORMAT_colonDATA_children, 136, 26 } // Terminal: FORMat:DATA
+    };
+    constexpr TrieNode _node_FORM_children[] = {
+        { ':', 0, 2, 0, _node_FORM_colon_children, 0, 0 },
+        { 'A', 0, 2, 2, _node_FORMAT_colon_children, 142, 0 }
+    };
+    constexpr TrieNode _node_STAT_colonOPER_colonCOND_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 14 }, // Terminal: STATus:OPERation:CONDition?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 32, 14 } // Terminal: STATus:OPERation:CONDition?
+    };
+    constexpr TrieNode _node_STAT_colonOPER_colonENABLE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 } // Terminal: STATus:OPERation:ENABle?
+    };
+    constexpr TrieNode _node_STAT_colonOPER_colonENAB_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 }, // Terminal: STATus:OPERation:ENABle?
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_STAT_colonOPER_colonENABLE_children, 11, 15 } // Terminal: STATus:OPERation:ENABle
+    };
+    constexpr TrieNode _node_STAT_colonOPER_colonEVEN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 13 }, // Terminal: STATus:OPERation:EVENt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 13 } // Terminal: STATus:OPERation:EVENt?
+    };
+    constexpr TrieNode _node_STAT_colonOPER_colonE_children[] = {
+        { 'N', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_STAT_colonOPER_colonENAB_children, 27, 15 }, // Terminal: STATus:OPERation:ENABle
+        { 'V', 0, 2, 2, _node_STAT_colonOPER_colonEVEN_children, 25, 0 }
+    };
+    constexpr TrieNode _node_STAT_colonOPER_colon_children[] = {
+        { 'C', 0, 2, 3, _node_STAT_colonOPER_colonCOND_children, 29, 0 },
+        { 'E', 0, 2, 0, _node_STAT_colonOPER_colonE_children, 0, 0 }
+    };
+    constexpr TrieNode _node_STAT_colonOPERATION_colonCOND_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 14 }, // Terminal: STATus:OPERation:CONDition?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 32, 14 } // Terminal: STATus:OPERation:CONDition?
+    };
+    constexpr TrieNode _node_STAT_colonOPERATION_colonENABLE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 } // Terminal: STATus:OPERation:ENABle?
+    };
+    constexpr TrieNode _node_STAT_colonOPERATION_colonENAB_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 }, // Terminal: STATus:OPERation:ENABle?
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_STAT_colonOPERATION_colonENABLE_children, 11, 15 } // Terminal: STATus:OPERation:ENABle
+    };
+    constexpr TrieNode _node_STAT_colonOPERATION_colonEVEN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 13 }, // Terminal: STATus:OPERation:EVENt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 13 } // Terminal: STATus:OPERation:EVENt?
+    };
+    constexpr TrieNode _node_STAT_colonOPERATION_colonE_children[] = {
+        { 'N', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_STAT_colonOPERATION_colonENAB_children, 27, 15 }, // Terminal: STATus:OPERation:ENABle
+        { 'V', 0, 2, 2, _node_STAT_colonOPERATION_colonEVEN_children, 25, 0 }
+    };
+    constexpr TrieNode _node_STAT_colonOPERATION_colon_children[] = {
+        { 'C', 0, 2, 3, _node_STAT_colonOPERATION_colonCOND_children, 29, 0 },
+        { 'E', 0, 2, 0, _node_STAT_colonOPERATION_colonE_children, 0, 0 }
+    };
+    constexpr TrieNode _node_STAT_colonOPERATION_children[] = {
+        { ':', 0, 2, 0, _node_STAT_colonOPERATION_colon_children, 0, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 12 } // Terminal: STATus:OPERation?
+    };
+    constexpr TrieNode _node_STAT_colonOPER_children[] = {
+        { ':', 0, 2, 0, _node_STAT_colonOPER_colon_children, 0, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 12 }, // Terminal: STATus:OPERation?
+        { 'A', 0, 2, 4, _node_STAT_colonOPERATION_children, 21, 0 }
+    };
+    constexpr TrieNode _node_STAT_colonPRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 22 } // Terminal: STATus:PRESet
+    };
+    constexpr TrieNode _node_STAT_colonQUES_colonCOND_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 19 }, // Terminal: STATus:QUEStionable:CONDition?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 32, 19 } // Terminal: STATus:QUEStionable:CONDition?
+    };
+    constexpr TrieNode _node_STAT_colonQUES_colonENABLE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 21 } // Terminal: STATus:QUEStionable:ENABle?
+    };
+    constexpr TrieNode _node_STAT_colonQUES_colonENAB_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 21 }, // Terminal: STATus:QUEStionable:ENABle?
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_STAT_colonQUES_colonENABLE_children, 11, 20 } // Terminal: STATus:QUEStionable:ENABle
+    };
+    constexpr TrieNode _node_STAT_colonQUES_colonEVEN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 }, // Terminal: STATus:QUEStionable:EVENt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 18 } // Terminal: STATus:QUEStionable:EVENt?
+    };
+    constexpr TrieNode _node_STAT_colonQUES_colonE_children[] = {
+        { 'N', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_STAT_colonQUES_colonENAB_children, 27, 20 }, // Terminal: STATus:QUEStionable:ENABle
+        { 'V', 0, 2, 2, _node_STAT_colonQUES_colonEVEN_children, 25, 0 }
+    };
+    constexpr TrieNode _node_STAT_colonQUES_colon_children[] = {
+        { 'C', 0, 2, 3, _node_STAT_colonQUES_colonCOND_children, 29, 0 },
+        { 'E', 0, 2, 0, _node_STAT_colonQUES_colonE_children, 0, 0 }
+    };
+    constexpr TrieNode _node_STAT_colonQUESTIONABLE_colonCOND_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 19 }, // Terminal: STATus:QUEStionable:CONDition?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 32, 19 } // Terminal: STATus:QUEStionable:CONDition?
+    };
+    constexpr TrieNode _node_STAT_colonQUESTIONABLE_colonENABLE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 21 } // Terminal: STATus:QUEStionable:ENABle?
+    };
+    constexpr TrieNode _node_STAT_colonQUESTIONABLE_colonENAB_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 21 }, // Terminal: STATus:QUEStionable:ENABle?
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_STAT_colonQUESTIONABLE_colonENABLE_children, 11, 20 } // Terminal: STATus:QUEStionable:ENABle
+    };
+    constexpr TrieNode _node_STAT_colonQUESTIONABLE_colonEVEN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 }, // Terminal: STATus:QUEStionable:EVENt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 18 } // Terminal: STATus:QUEStionable:EVENt?
+    };
+    constexpr TrieNode _node_STAT_colonQUESTIONABLE_colonE_children[] = {
+        { 'N', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_STAT_colonQUESTIONABLE_colonENAB_children, 27, 20 }, // Terminal: STATus:QUEStionable:ENABle
+        { 'V', 0, 2, 2, _node_STAT_colonQUESTIONABLE_colonEVEN_children, 25, 0 }
+    };
+    constexpr TrieNode _node_STAT_colonQUESTIONABLE_colon_children[] = {
+        { 'C', 0, 2, 3, _node_STAT_colonQUESTIONABLE_colonCOND_children, 29, 0 },
+        { 'E', 0, 2, 0, _node_STAT_colonQUESTIONABLE_colonE_children, 0, 0 }
+    };
+    constexpr TrieNode _node_STAT_colonQUESTIONABLE_children[] = {
+        { ':', 0, 2, 0, _node_STAT_colonQUESTIONABLE_colon_children, 0, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 17 } // Terminal: STATus:QUEStionable?
+    };
+    constexpr TrieNode _node_STAT_colonQUES_children[] = {
+        { ':', 0, 2, 0, _node_STAT_colonQUES_colon_children, 0, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 17 }, // Terminal: STATus:QUEStionable?
+        { 'T', 0, 2, 7, _node_STAT_colonQUESTIONABLE_children, 40, 0 }
+    };
+    constexpr TrieNode _node_STAT_colon_children[] = {
+        { 'O', 0, 3, 3, _node_STAT_colonOPER_children, 18, 0 },
+        { 'P', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_STAT_colonPRES_children, 47, 22 }, // Terminal: STATus:PRESet
+        { 'Q', 0, 3, 3, _node_STAT_colonQUES_children, 37, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colonOPER_colonCOND_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 14 }, // Terminal: STATus:OPERation:CONDition?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 32, 14 } // Terminal: STATus:OPERation:CONDition?
+    };
+    constexpr TrieNode _node_STATUS_colonOPER_colonENABLE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 } // Terminal: STATus:OPERation:ENABle?
+    };
+    constexpr TrieNode _node_STATUS_colonOPER_colonENAB_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 }, // Terminal: STATus:OPERation:ENABle?
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_STATUS_colonOPER_colonENABLE_children, 11, 15 } // Terminal: STATus:OPERation:ENABle
+    };
+    constexpr TrieNode _node_STATUS_colonOPER_colonEVEN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 13 }, // Terminal: STATus:OPERation:EVENt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 13 } // Terminal: STATus:OPERation:EVENt?
+    };
+    constexpr TrieNode _node_STATUS_colonOPER_colonE_children[] = {
+        { 'N', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_STATUS_colonOPER_colonENAB_children, 27, 15 }, // Terminal: STATus:OPERation:ENABle
+        { 'V', 0, 2, 2, _node_STATUS_colonOPER_colonEVEN_children, 25, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colonOPER_colon_children[] = {
+        { 'C', 0, 2, 3, _node_STATUS_colonOPER_colonCOND_children, 29, 0 },
+        { 'E', 0, 2, 0, _node_STATUS_colonOPER_colonE_children, 0, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colonOPERATION_colonCOND_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 14 }, // Terminal: STATus:OPERation:CONDition?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 32, 14 } // Terminal: STATus:OPERation:CONDition?
+    };
+    constexpr TrieNode _node_STATUS_colonOPERATION_colonENABLE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 } // Terminal: STATus:OPERation:ENABle?
+    };
+    constexpr TrieNode _node_STATUS_colonOPERATION_colonENAB_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 16 }, // Terminal: STATus:OPERation:ENABle?
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_STATUS_colonOPERATION_colonENABLE_children, 11, 15 } // Terminal: STATus:OPERation:ENABle
+    };
+    constexpr TrieNode _node_STATUS_colonOPERATION_colonEVEN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 13 }, // Terminal: STATus:OPERation:EVENt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 13 } // Terminal: STATus:OPERation:EVENt?
+    };
+    constexpr TrieNode _node_STATUS_colonOPERATION_colonE_children[] = {
+        { 'N', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_STATUS_colonOPERATION_colonENAB_children, 27, 15 }, // Terminal: STATus:OPERation:ENABle
+        { 'V', 0, 2, 2, _node_STATUS_colonOPERATION_colonEVEN_children, 25, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colonOPERATION_colon_children[] = {
+        { 'C', 0, 2, 3, _node_STATUS_colonOPERATION_colonCOND_children, 29, 0 },
+        { 'E', 0, 2, 0, _node_STATUS_colonOPERATION_colonE_children, 0, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colonOPERATION_children[] = {
+        { ':', 0, 2, 0, _node_STATUS_colonOPERATION_colon_children, 0, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 12 } // Terminal: STATus:OPERation?
+    };
+    constexpr TrieNode _node_STATUS_colonOPER_children[] = {
+        { ':', 0, 2, 0, _node_STATUS_colonOPER_colon_children, 0, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 12 }, // Terminal: STATus:OPERation?
+        { 'A', 0, 2, 4, _node_STATUS_colonOPERATION_children, 21, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colonPRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 22 } // Terminal: STATus:PRESet
+    };
+    constexpr TrieNode _node_STATUS_colonQUES_colonCOND_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 19 }, // Terminal: STATus:QUEStionable:CONDition?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 32, 19 } // Terminal: STATus:QUEStionable:CONDition?
+    };
+    constexpr TrieNode _node_STATUS_colonQUES_colonENABLE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 21 } // Terminal: STATus:QUEStionable:ENABle?
+    };
+    constexpr TrieNode _node_STATUS_colonQUES_colonENAB_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 21 }, // Terminal: STATus:QUEStionable:ENABle?
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_STATUS_colonQUES_colonENABLE_children, 11, 20 } // Terminal: STATus:QUEStionable:ENABle
+    };
+    constexpr TrieNode _node_STATUS_colonQUES_colonEVEN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 }, // Terminal: STATus:QUEStionable:EVENt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 18 } // Terminal: STATus:QUEStionable:EVENt?
+    };
+    constexpr TrieNode _node_STATUS_colonQUES_colonE_children[] = {
+        { 'N', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_STATUS_colonQUES_colonENAB_children, 27, 20 }, // Terminal: STATus:QUEStionable:ENABle
+        { 'V', 0, 2, 2, _node_STATUS_colonQUES_colonEVEN_children, 25, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colonQUES_colon_children[] = {
+        { 'C', 0, 2, 3, _node_STATUS_colonQUES_colonCOND_children, 29, 0 },
+        { 'E', 0, 2, 0, _node_STATUS_colonQUES_colonE_children, 0, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colonQUESTIONABLE_colonCOND_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 19 }, // Terminal: STATus:QUEStionable:CONDition?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 5, nullptr, 32, 19 } // Terminal: STATus:QUEStionable:CONDition?
+    };
+    constexpr TrieNode _node_STATUS_colonQUESTIONABLE_colonENABLE_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 21 } // Terminal: STATus:QUEStionable:ENABle?
+    };
+    constexpr TrieNode _node_STATUS_colonQUESTIONABLE_colonENAB_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 21 }, // Terminal: STATus:QUEStionable:ENABle?
+        { 'L', uint8_t(TrieNodeFlags::Terminal), 1, 1, _node_STATUS_colonQUESTIONABLE_colonENABLE_children, 11, 20 } // Terminal: STATus:QUEStionable:ENABle
+    };
+    constexpr TrieNode _node_STATUS_colonQUESTIONABLE_colonEVEN_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 18 }, // Terminal: STATus:QUEStionable:EVENt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 18 } // Terminal: STATus:QUEStionable:EVENt?
+    };
+    constexpr TrieNode _node_STATUS_colonQUESTIONABLE_colonE_children[] = {
+        { 'N', uint8_t(TrieNodeFlags::Terminal), 2, 2, _node_STATUS_colonQUESTIONABLE_colonENAB_children, 27, 20 }, // Terminal: STATus:QUEStionable:ENABle
+        { 'V', 0, 2, 2, _node_STATUS_colonQUESTIONABLE_colonEVEN_children, 25, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colonQUESTIONABLE_colon_children[] = {
+        { 'C', 0, 2, 3, _node_STATUS_colonQUESTIONABLE_colonCOND_children, 29, 0 },
+        { 'E', 0, 2, 0, _node_STATUS_colonQUESTIONABLE_colonE_children, 0, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colonQUESTIONABLE_children[] = {
+        { ':', 0, 2, 0, _node_STATUS_colonQUESTIONABLE_colon_children, 0, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 17 } // Terminal: STATus:QUEStionable?
+    };
+    constexpr TrieNode _node_STATUS_colonQUES_children[] = {
+        { ':', 0, 2, 0, _node_STATUS_colonQUES_colon_children, 0, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 17 }, // Terminal: STATus:QUEStionable?
+        { 'T', 0, 2, 7, _node_STATUS_colonQUESTIONABLE_children, 40, 0 }
+    };
+    constexpr TrieNode _node_STATUS_colon_children[] = {
+        { 'O', 0, 3, 3, _node_STATUS_colonOPER_children, 18, 0 },
+        { 'P', uint8_t(TrieNodeFlags::Terminal), 1, 3, _node_STATUS_colonPRES_children, 47, 22 }, // Terminal: STATus:PRESet
+        { 'Q', 0, 3, 3, _node_STATUS_colonQUES_children, 37, 0 }
+    };
+    constexpr TrieNode _node_STAT_children[] = {
+        { ':', 0, 3, 0, _node_STAT_colon_children, 0, 0 },
+        { 'U', 0, 3, 2, _node_STATUS_colon_children, 50, 0 }
+    };
+    constexpr TrieNode _node_SYST_colonREC_colonFAUL_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 46 }, // Terminal: SYSTem:RECorder:FAULt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 46 } // Terminal: SYSTem:RECorder:FAULt?
+    };
+    constexpr TrieNode _node_SYST_colonRECORDER_colonFAUL_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 46 }, // Terminal: SYSTem:RECorder:FAULt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 46 } // Terminal: SYSTem:RECorder:FAULt?
+    };
+    constexpr TrieNode _node_SYST_colonRECORDER_children[] = {
+        { ':', 0, 2, 4, _node_SYST_colonRECORDER_colonFAUL_children, 81, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 45 } // Terminal: SYSTem:RECorder?
+    };
+    constexpr TrieNode _node_SYST_colonREC_children[] = {
+        { ':', 0, 2, 4, _node_SYST_colonREC_colonFAUL_children, 81, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 45 }, // Terminal: SYSTem:RECorder?
+        { 'O', 0, 2, 4, _node_SYST_colonRECORDER_children, 77, 0 }
+    };
+    constexpr TrieNode _node_SYST_colonTRAC_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 44 }, // Terminal: SYSTem:TRACe:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 58, 44 } // Terminal: SYSTem:TRACe:STATistics?
+    };
+    constexpr TrieNode _node_SYST_colonTRACE_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 44 }, // Terminal: SYSTem:TRACe:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 58, 44 } // Terminal: SYSTem:TRACe:STATistics?
+    };
+    constexpr TrieNode _node_SYST_colonTRACE_children[] = {
+        { ':', 0, 2, 4, _node_SYST_colonTRACE_colonSTAT_children, 71, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 43 } // Terminal: SYSTem:TRACe?
+    };
+    constexpr TrieNode _node_SYST_colonTRAC_children[] = {
+        { ':', 0, 2, 4, _node_SYST_colonTRAC_colonSTAT_children, 71, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 43 }, // Terminal: SYSTem:TRACe?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 2, 0, _node_SYST_colonTRACE_children, 0, 42 } // Terminal: SYSTem:TRACe
+    };
+    constexpr TrieNode _node_SYST_colonUSB_colonLAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 37 }, // Terminal: SYSTem:USB:LATency?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 64, 37 } // Terminal: SYSTem:USB:LATency?
+    };
+    constexpr TrieNode _node_SYST_colonUSB_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 38 } // Terminal: SYSTem:USB:RESet
+    };
+    constexpr TrieNode _node_SYST_colonUSB_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 36 }, // Terminal: SYSTem:USB:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 58, 36 } // Terminal: SYSTem:USB:STATistics?
+    };
+    constexpr TrieNode _node_SYST_colonUSB_colon_children[] = {
+        { 'L', 0, 2, 2, _node_SYST_colonUSB_colonLAT_children, 16, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYST_colonUSB_colonRES_children, 38, 38 }, // Terminal: SYSTem:USB:RESet
+        { 'S', 0, 2, 3, _node_SYST_colonUSB_colonSTAT_children, 55, 0 }
+    };
+    constexpr TrieNode _node_SYST_colon_children[] = {
+        { 'R', 0, 3, 2, _node_SYST_colonREC_children, 75, 0 },
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 3, 3, _node_SYST_colonTRAC_children, 68, 42 }, // Terminal: SYSTem:TRACe
+        { 'U', 0, 3, 3, _node_SYST_colonUSB_colon_children, 52, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colonREC_colonFAUL_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 46 }, // Terminal: SYSTem:RECorder:FAULt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 46 } // Terminal: SYSTem:RECorder:FAULt?
+    };
+    constexpr TrieNode _node_SYSTEM_colonRECORDER_colonFAUL_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 46 }, // Terminal: SYSTem:RECorder:FAULt?
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 2, 46 } // Terminal: SYSTem:RECorder:FAULt?
+    };
+    constexpr TrieNode _node_SYSTEM_colonRECORDER_children[] = {
+        { ':', 0, 2, 4, _node_SYSTEM_colonRECORDER_colonFAUL_children, 81, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 45 } // Terminal: SYSTem:RECorder?
+    };
+    constexpr TrieNode _node_SYSTEM_colonREC_children[] = {
+        { ':', 0, 2, 4, _node_SYSTEM_colonREC_colonFAUL_children, 81, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 45 }, // Terminal: SYSTem:RECorder?
+        { 'O', 0, 2, 4, _node_SYSTEM_colonRECORDER_children, 77, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colonTRAC_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 44 }, // Terminal: SYSTem:TRACe:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 58, 44 } // Terminal: SYSTem:TRACe:STATistics?
+    };
+    constexpr TrieNode _node_SYSTEM_colonTRACE_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 44 }, // Terminal: SYSTem:TRACe:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 58, 44 } // Terminal: SYSTem:TRACe:STATistics?
+    };
+    constexpr TrieNode _node_SYSTEM_colonTRACE_children[] = {
+        { ':', 0, 2, 4, _node_SYSTEM_colonTRACE_colonSTAT_children, 71, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 43 } // Terminal: SYSTem:TRACe?
+    };
+    constexpr TrieNode _node_SYSTEM_colonTRAC_children[] = {
+        { ':', 0, 2, 4, _node_SYSTEM_colonTRAC_colonSTAT_children, 71, 0 },
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 43 }, // Terminal: SYSTem:TRACe?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 2, 0, _node_SYSTEM_colonTRACE_children, 0, 42 } // Terminal: SYSTem:TRACe
+    };
+    constexpr TrieNode _node_SYSTEM_colonUSB_colonLAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 37 }, // Terminal: SYSTem:USB:LATency?
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 4, nullptr, 64, 37 } // Terminal: SYSTem:USB:LATency?
+    };
+    constexpr TrieNode _node_SYSTEM_colonUSB_colonRES_children[] = {
+        { 'E', uint8_t(TrieNodeFlags::Terminal), 0, 1, nullptr, 4, 38 } // Terminal: SYSTem:USB:RESet
+    };
+    constexpr TrieNode _node_SYSTEM_colonUSB_colonSTAT_children[] = {
+        { '?', uint8_t(TrieNodeFlags::Terminal), 0, 0, nullptr, 0, 36 }, // Terminal: SYSTem:USB:STATistics?
+        { 'I', uint8_t(TrieNodeFlags::Terminal), 0, 6, nullptr, 58, 36 } // Terminal: SYSTem:USB:STATistics?
+    };
+    constexpr TrieNode _node_SYSTEM_colonUSB_colon_children[] = {
+        { 'L', 0, 2, 2, _node_SYSTEM_colonUSB_colonLAT_children, 16, 0 },
+        { 'R', uint8_t(TrieNodeFlags::Terminal), 1, 2, _node_SYSTEM_colonUSB_colonRES_children, 38, 38 }, // Terminal: SYSTem:USB:RESet
+        { 'S', 0, 2, 3, _node_SYSTEM_colonUSB_colonSTAT_children, 55, 0 }
+    };
+    constexpr TrieNode _node_SYSTEM_colon_children[] = {
+        { 'R', 0, 3, 2, _node_SYSTEM_colonREC_children, 75, 0 },
+        { 'T', uint8_t(TrieNodeFlags::Terminal), 3, 3, _node_SYSTEM_colonTRAC_children, 68, 42 }, // Terminal: SYSTem:TRACe
+        { 'U', 0, 3, 3, _node_SYSTEM_colonUSB_colon_children, 52, 0 }
+    };
+    constexpr TrieNode _node_SYST_children[] = {
+        { ':', 0, 3, 0, _node_SYST_colon_children, 0, 0 },
+        { 'E', 0, 3, 2, _node_SYSTEM_colon_children, 85, 0 }
+    };
+    constexpr TrieNode _node_S_children[] = {
+        { 'T', 0, 2, 2, _node_STAT_children, 16, 0 },
+        { 'Y', 0, 2, 2, _node_SYST_children, 3, 0 }
+    };
+    constexpr TrieNode _root_children[] = {
+        { '*', uint8_t(TrieNodeFlags::BinarySearch), 8, 0, _node__star_children, 0, 0 },
+        { 'B', uint8_t(TrieNodeFlags::BinarySearch), 8, 5, _node_BENCH_colon_children, 87, 0 },
+        { 'F', 0, 2, 3, _node_FORM_children, 133, 0 },
+        { 'S', 0, 2, 0, _node_S_children, 0, 0 }
+    };
+    template<>
+    constinit const TrieNode T76::SCPI::Interpreter<T76::App>::_trie = { '\0', 0, 4, 0, _root_children, 0, 0 };
+
+    // Command handlers and parameters
+    template<>
+    constinit const Command<T76::App> T76::SCPI::Interpreter<T76::App>::_commands[] = {
+        { nullptr, 0, nullptr, nullptr, nullptr, command_0_constant }, // 0: *IDN?
+        { &T76::App::_resetInstrument, 0, nullptr, nullptr, nullptr, nullptr }, // 1: *RST
+        { &T76::App::_clearStatus, 0, nullptr, nullptr, nullptr, nullptr }, // 2: *CLS
+        { &T76::App::_queryEventStatus, 0, nullptr, nullptr, nullptr, nullptr }, // 3: *ESR?
+        { &T76::App::_setOperationComplete, 0, nullptr, nullptr, nullptr, nullptr }, // 4: *OPC
+        { &T76::App::_queryOperationComplete, 0, nullptr, nullptr, nullptr, nullptr }, // 5: *OPC?
+        { &T76::App::_wait, 0, nullptr, nullptr, nullptr, nullptr }, // 6: *WAI
+        { &T76::App::_setEventStatusEnable, 1, command_7_params, nullptr, nullptr, nullptr }, // 7: *ESE
+        { &T76::App::_queryEventStatusEnable, 0, nullptr, nullptr, nullptr, nullptr }, // 8: *ESE?
+        { &T76::App::_setServiceRequestEnable, 1, command_9_params, nullptr, nullptr, nullptr }, // 9: *SRE
+        { &T76::App::_queryServiceRequestEnable, 0, nullptr, nullptr, nullptr, nullptr }, // 10: *SRE?
+        { &T76::App::_queryStatusByte, 0, nullptr, nullptr, nullptr, nullptr }, // 11: *STB?
+        { &T76::App::_queryOperationEvent, 0, nullptr, nullptr, nullptr, nullptr }, // 12: STATus:OPERation?
+        { &T76::App::_queryOperationEvent, 0, nullptr, nullptr, nullptr, nullptr }, // 13: STATus:OPERation:EVENt?
+        { &T76::App::_queryOperationCondition, 0, nullptr, nullptr, nullptr, nullptr }, // 14: STATus:OPERation:CONDition?
+        { &T76::App::_setOperationEnable, 1, command_15_params, nullptr, nullptr, nullptr }, // 15: STATus:OPERation:ENABle
+        { &T76::App::_queryOperationEnable, 0, nullptr, nullptr, nullptr, nullptr }, // 16: STATus:OPERation:ENABle?
+        { &T76::App::_queryQuestionableEvent, 0, nullptr, nullptr, nullptr, nullptr }, // 17: STATus:QUEStionable?
+        { &T76::App::_queryQuestionableEvent, 0, nullptr, nullptr, nullptr, nullptr }, // 18: STATus:QUEStionable:EVENt?
+        { &T76::App::_queryQuestionableCondition, 0, nullptr, nullptr, nullptr, nullptr }, // 19: STATus:QUEStionable:CONDition?
+        { &T76::App::_setQuestionableEnable, 1, command_20_params, nullptr, nullptr, nullptr }, // 20: STATus:QUEStionable:ENABle
+        { &T76::App::_queryQuestionableEnable, 0, nullptr, nullptr, nullptr, nullptr }, // 21: STATus:QUEStionable:ENABle?
+        { &T76::App::_presetStatus, 0, nullptr, nullptr, nullptr, nullptr }, // 22: STATus:PRESet
+        { &T76::App::_queryPayload, 1, command_23_params, nullptr, nullptr, nullptr }, // 23: BENCH:PAYLoad?
+        { &T76::App::_queryTrace, 1, command_24_params, nullptr, nullptr, nullptr }, // 24: BENCH:TRACe?
+        { &T76::App::_settle, 1, command_25_params, nullptr, nullptr, nullptr }, // 25: BENCH:SETTle
+        { &T76::App::_setFormat, 2, command_26_params, nullptr, nullptr, nullptr }, // 26: FORMat:DATA
+        { &T76::App::_queryFormat, 0, nullptr, nullptr, nullptr, nullptr }, // 27: FORMat:DATA?
+        { &T76::App::_setByteOrder, 1, command_28_params, nullptr, nullptr, nullptr }, // 28: FORMat:BORDer
+        { &T76::App::_queryByteOrder, 0, nullptr, nullptr, nullptr, nullptr }, // 29: FORMat:BORDer?
+        { &T76::App::_setMode, 1, command_30_params, nullptr, nullptr, nullptr }, // 30: BENCH:MODE
+        { &T76::App::_queryMode, 0, nullptr, nullptr, nullptr, nullptr }, // 31: BENCH:MODE?
+        { &T76::App::_queryCount, 0, nullptr, nullptr, nullptr, nullptr }, // 32: BENCH:COUNt?
+        { &T76::App::_resetCount, 0, nullptr, nullptr, nullptr, nullptr }, // 33: BENCH:RESet
+        { &T76::App::_sendVendor, 2, command_34_params, nullptr, nullptr, nullptr }, // 34: BENCH:VENDor:SEND
+        { &T76::App::_sendWinUSB, 2, command_35_params, nullptr, nullptr, nullptr }, // 35: BENCH:WINUSB:SEND
+        { &T76::App::_queryUSBStats, 0, nullptr, nullptr, nullptr, nullptr }, // 36: SYSTem:USB:STATistics?
+        { &T76::App::_queryUSBLatency, 0, nullptr, nullptr, nullptr, nullptr }, // 37: SYSTem:USB:LATency?
+        { &T76::App::_resetUSBStats, 0, nullptr, nullptr, nullptr, nullptr }, // 38: SYSTem:USB:RESet
+        { &T76::App::_trigger, 0, nullptr, nullptr, nullptr, nullptr }, // 39: *TRG
+        { &T76::App::_queryTriggerStats, 0, nullptr, nullptr, nullptr, nullptr }, // 40: BENCH:TRIGger:STATistics?
+        { &T76::App::_resetTriggerStats, 0, nullptr, nullptr, nullptr, nullptr }, // 41: BENCH:TRIGger:RESet
+        { &T76::App::_setTraceState, 1, command_42_params, nullptr, nullptr, nullptr }, // 42: SYSTem:TRACe
+        { &T76::App::_queryTraceState, 0, nullptr, nullptr, nullptr, nullptr }, // 43: SYSTem:TRACe?
+        { &T76::App::_queryTraceStats, 0, nullptr, nullptr, nullptr, nullptr }, // 44: SYSTem:TRACe:STATistics?
+        { &T76::App::_queryFlightRecorder, 0, nullptr, nullptr, nullptr, nullptr }, // 45: SYSTem:RECorder?
+        { &T76::App::_queryFlightRecorderFault, 0, nullptr, nullptr, nullptr, nullptr }, // 46: SYSTem:RECorder:FAULt?
+    };
+
+    template<>
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_commandCount = 47;
+
+    template<>
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_maxParameterCount = 2;
+
+    template<>
+    constinit const size_t T76::SCPI::Interpreter<T76::App>::_maxStringParameterCount = 0;
+
+} // namespace
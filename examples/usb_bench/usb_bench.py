@@ -0,0 +1,449 @@
+"""Host side of the t76_usb_bench firmware.
+
+Measures sustained throughput and round-trip latency for each transport
+exposed by Instrument Core across a sweep of payload sizes, and prints one
+JSON object per measurement so that results can be compared across builds.
+"""
+
+import argparse
+import json
+import os
+import statistics
+import struct
+import sys
+import time
+
+import pyvisa
+import usb.core
+import usb.util
+
+DEFAULT_RESOURCE_FRAGMENT = "USB0::0x2E8A::0x000A"
+DEFAULT_VENDOR_ID = 0x2E8A
+DEFAULT_PRODUCT_ID = 0x000A
+
+# Endpoint addresses, from t76/usb/usb_descriptors.h
+EPNUM_VENDOR_OUT = 0x05
+EPNUM_VENDOR_IN = 0x85
+EPNUM_WINUSB_OUT = 0x06
+EPNUM_WINUSB_IN = 0x86
+
+WINUSB_INTERFACE_SUBCLASS = 0x01
+WINUSB_INTERFACE_PROTOCOL = 0x02
+
+CONTROL_REQUEST = 0x10          # Matches App::_controlRequest
+CONTROL_MAX_SIZE = 4096         # Matches App::_controlBufferSize
+USBTMC_MAX_SIZE = 2047          # T76_IC_USB_INTERFACE_BULK_IN_BUFFER_SIZE - 1
+TRACE_MAX_POINTS = 480          # Matches App::_traceSize
+TRACE_MAX_ASCII_POINTS = 200    # As text, longer traces do not fit in the bulk IN ring
+SETTLE_MS = 20                  # Duration of the overlapped operation in the usbtmc-overlap test
+
+# WinUSB frames, from t76/updater/t76/updater/winusb_frame.h
+FRAME_HEADER = struct.Struct("<2sBBB3xI")
+FRAME_MAGIC = b"WU"
+FRAME_VERSION = 1
+FRAME_QUERY_REQUEST = 0x03
+FRAME_TEXT_RESPONSE = 0x81
+FRAME_ERROR_RESPONSE = 0x83
+
+# Opcodes of the binary requests, written by the SCPI generator
+OPCODES_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "scpi_opcodes.json")
+
+DEFAULT_SIZES = [1, 16, 64, 256, 1024, 4096, 16384]
+TESTS = ["usbtmc", "usbtmc-block", "usbtmc-ascii", "usbtmc-overlap", "vendor-echo", "vendor-in", "vendor-out",
+         "winusb-echo", "winusb-in", "winusb-out", "winusb-rpc", "control-out", "control-in", "trigger"]
+
+# Tests that do not depend on the payload size, and only run at the first size of the sweep
+SIZELESS_TESTS = ["trigger"]
+
+
+def percentile(samples, fraction):
+    """Return the given percentile of a list of samples, by nearest rank."""
+    ordered = sorted(samples)
+    index = min(len(ordered) - 1, max(0, int(round(fraction * len(ordered))) - 1))
+    return ordered[index]
+
+
+def summarize(test, size, iterations, payload_bytes, elapsed, latencies):
+    """Build one result record."""
+    result = {
+        "test": test,
+        "size": size,
+        "iterations": iterations,
+        "bytes": payload_bytes,
+        "seconds": round(elapsed, 6),
+        "mb_per_s": round(payload_bytes / elapsed / 1e6, 4) if elapsed > 0 else None,
+    }
+
+    if latencies:
+        micros = [value * 1e6 for value in latencies]
+        result.update({
+            "lat_min_us": round(min(micros), 1),
+            "lat_p50_us": round(percentile(micros, 0.50), 1),
+            "lat_p90_us": round(percentile(micros, 0.90), 1),
+            "lat_p99_us": round(percentile(micros, 0.99), 1),
+            "lat_max_us": round(max(micros), 1),
+            "lat_mean_us": round(statistics.fmean(micros), 1),
+        })
+
+    return result
+
+
+class Bench:
+    """Connections to the benchmark firmware over USBTMC and raw USB."""
+
+    def __init__(self, resource_fragment, vendor_id, product_id, timeout_ms):
+        self.timeout_ms = timeout_ms
+
+        rm = pyvisa.ResourceManager()
+        resource = next((res for res in rm.list_resources()
+                         if resource_fragment in res), None)
+        if resource is None:
+            raise RuntimeError("USBTMC device not found.")
+
+        self.instrument = rm.open_resource(resource)
+        self.instrument.timeout = timeout_ms
+        self.instrument.read_termination = "\n"
+
+        self.device = usb.core.find(idVendor=vendor_id, idProduct=product_id)
+        if self.device is None:
+            raise RuntimeError("USB device not found.")
+
+        config = self.device.get_active_configuration()
+        self.winusb_interface = None
+
+        for interface in config:
+            if (interface.bInterfaceClass == 0xFF
+                    and interface.bInterfaceSubClass == WINUSB_INTERFACE_SUBCLASS
+                    and interface.bInterfaceProtocol == WINUSB_INTERFACE_PROTOCOL):
+                self.winusb_interface = interface.bInterfaceNumber
+
+        if self.winusb_interface is None:
+            raise RuntimeError("WinUSB interface not found.")
+
+    def close(self):
+        self.instrument.write("*RST")
+        self.instrument.close()
+        usb.util.dispose_resources(self.device)
+
+    def query(self, command):
+        return self.instrument.query(command).strip()
+
+    def drain(self, endpoint):
+        """Discard anything left in an IN endpoint by a previous test."""
+        try:
+            while True:
+                self.device.read(endpoint, 4096, timeout=50)
+        except usb.core.USBTimeoutError:
+            pass
+
+    def read_exactly(self, endpoint, length):
+        received = 0
+        while received < length:
+            received += len(self.device.read(endpoint, max(64, min(length - received, 16384)),
+                                             timeout=self.timeout_ms))
+        return received
+
+    def usbtmc(self, size, iterations):
+        if size > USBTMC_MAX_SIZE:
+            return None
+
+        command = f"BENCH:PAYL? {size}"
+        latencies = []
+        start = time.perf_counter()
+
+        for _ in range(iterations):
+            begin = time.perf_counter()
+            response = self.instrument.query(command)
+            latencies.append(time.perf_counter() - begin)
+
+            if len(response) != size:
+                raise RuntimeError(f"USBTMC response of {len(response)} bytes, expected {size}")
+
+        elapsed = time.perf_counter() - start
+        return summarize("usbtmc", size, iterations, size * iterations, elapsed, latencies)
+
+    def overlap(self, size, iterations):
+        """Query a payload while an overlapped operation runs, then wait for it with *OPC?."""
+        if size > USBTMC_MAX_SIZE:
+            return None
+
+        command = f"BENCH:PAYL? {size}"
+        latencies = []
+        start = time.perf_counter()
+
+        for _ in range(iterations):
+            self.instrument.write(f"BENCH:SETT {SETTLE_MS}")
+
+            begin = time.perf_counter()
+            response = self.instrument.query(command)
+            latencies.append(time.perf_counter() - begin)
+
+            if len(response) != size:
+                raise RuntimeError(f"USBTMC response of {len(response)} bytes, expected {size}")
+
+            if self.query("*OPC?") != "1":
+                raise RuntimeError("*OPC? did not return 1")
+
+        elapsed = time.perf_counter() - start
+        return summarize("usbtmc-overlap", size, iterations, size * iterations, elapsed, latencies)
+
+    def rpc(self, size, iterations):
+        """Send BENCH:PAYLoad? <size> as a binary request over WinUSB and read the reply frame."""
+        if size > USBTMC_MAX_SIZE:
+            return None
+
+        with open(OPCODES_FILE, encoding="utf-8") as file:
+            opcodes = {command["syntax"]: command["opcode"] for command in json.load(file)["commands"]}
+
+        payload = struct.pack("<Hd", opcodes["BENCH:PAYLoad?"], size)
+        request = FRAME_HEADER.pack(FRAME_MAGIC, FRAME_VERSION, FRAME_QUERY_REQUEST, 0, len(payload)) + payload
+
+        self.instrument.write("BENCH:MODE RPC")
+        self.query("*OPC?")
+        self.drain(EPNUM_WINUSB_IN)
+
+        latencies = []
+        start = time.perf_counter()
+
+        for iteration in range(iterations):
+            tag = iteration & 0xFF
+            request = request[:4] + bytes([tag]) + request[5:]
+
+            begin = time.perf_counter()
+            self.device.write(EPNUM_WINUSB_OUT, request, timeout=self.timeout_ms)
+
+            reply = bytes(self.device.read(EPNUM_WINUSB_IN, FRAME_HEADER.size + size + 64, timeout=self.timeout_ms))
+            while len(reply) < FRAME_HEADER.size or len(reply) < FRAME_HEADER.size + FRAME_HEADER.unpack_from(reply)[4]:
+                reply += bytes(self.device.read(EPNUM_WINUSB_IN, 4096, timeout=self.timeout_ms))
+
+            latencies.append(time.perf_counter() - begin)
+
+            magic, _, frame_type, reply_tag, length = FRAME_HEADER.unpack_from(reply)
+            if magic != FRAME_MAGIC or reply_tag != tag:
+                raise RuntimeError("winusb-rpc: reply frame does not match the request")
+            if frame_type == FRAME_ERROR_RESPONSE:
+                raise RuntimeError(f"winusb-rpc: {reply[FRAME_HEADER.size:].decode(errors='replace')}")
+            if frame_type != FRAME_TEXT_RESPONSE or length != size:
+                raise RuntimeError(f"winusb-rpc: reply of {length} bytes, expected {size}")
+
+        elapsed = time.perf_counter() - start
+        self.instrument.write("BENCH:MODE ECHO")
+
+        return summarize("winusb-rpc", size, iterations, size * iterations, elapsed, latencies)
+
+    def trace(self, test, size, iterations):
+        """Read size / 4 points of the test waveform, as a REAL,32 block or as text."""
+        points = size // 4
+        binary = test == "usbtmc-block"
+
+        if points < 1 or points > (TRACE_MAX_POINTS if binary else TRACE_MAX_ASCII_POINTS):
+            return None
+
+        self.instrument.write("FORM:DATA REAL,32;BORD SWAP" if binary else "FORM:DATA ASC")
+
+        command = f"BENCH:TRAC? {points}"
+        latencies = []
+        start = time.perf_counter()
+
+        for _ in range(iterations):
+            begin = time.perf_counter()
+
+            if binary:
+                values = self.instrument.query_binary_values(command, datatype="f", is_big_endian=False)
+            else:
+                values = self.instrument.query_ascii_values(command)
+
+            latencies.append(time.perf_counter() - begin)
+
+            if len(values) != points:
+                raise RuntimeError(f"{test}: {len(values)} points, expected {points}")
+
+        elapsed = time.perf_counter() - start
+        self.instrument.write("FORM:DATA ASC")
+
+        return summarize(test, size, iterations, 4 * points * iterations, elapsed, latencies)
+
+    def echo(self, test, out_endpoint, in_endpoint, size, iterations):
+        self.instrument.write("BENCH:MODE ECHO")
+        self.drain(in_endpoint)
+
+        payload = bytes((i % 256 for i in range(size)))
+        latencies = []
+        start = time.perf_counter()
+
+        for _ in range(iterations):
+            begin = time.perf_counter()
+            self.device.write(out_endpoint, payload, timeout=self.timeout_ms)
+            self.read_exactly(in_endpoint, size)
+            latencies.append(time.perf_counter() - begin)
+
+        elapsed = time.perf_counter() - start
+        return summarize(test, size, iterations, 2 * size * iterations, elapsed, latencies)
+
+    def stream_in(self, test, command, in_endpoint, size, iterations):
+        self.drain(in_endpoint)
+
+        total = size * iterations
+        start = time.perf_counter()
+        self.instrument.write(f"{command} {total},{min(size, 4096)}")
+        self.read_exactly(in_endpoint, total)
+        elapsed = time.perf_counter() - start
+
+        return summarize(test, size, iterations, total, elapsed, [])
+
+    def stream_out(self, test, out_endpoint, counter_index, size, iterations):
+        self.instrument.write("BENCH:MODE SINK")
+        self.instrument.write("BENCH:RES")
+
+        payload = bytes((i % 256 for i in range(size)))
+        total = size * iterations
+        start = time.perf_counter()
+
+        for _ in range(iterations):
+            self.device.write(out_endpoint, payload, timeout=self.timeout_ms)
+
+        # The data has only been consumed once the firmware has counted it
+        deadline = start + self.timeout_ms / 1000 + total / 1e5
+        while int(self.query("BENCH:COUN?").split(",")[counter_index]) < total:
+            if time.perf_counter() > deadline:
+                raise RuntimeError(f"{test}: firmware did not receive all {total} bytes")
+
+        elapsed = time.perf_counter() - start
+        self.instrument.write("BENCH:MODE ECHO")
+
+        return summarize(test, size, iterations, total, elapsed, [])
+
+    def control(self, test, size, iterations):
+        if size > CONTROL_MAX_SIZE:
+            return None
+
+        payload = bytes((i % 256 for i in range(size)))
+        latencies = []
+        start = time.perf_counter()
+
+        for _ in range(iterations):
+            begin = time.perf_counter()
+
+            if test == "control-out":
+                self.device.ctrl_transfer(0x41, CONTROL_REQUEST, 0, self.winusb_interface,
+                                          payload, timeout=self.timeout_ms)
+            else:
+                data = self.device.ctrl_transfer(0xC1, CONTROL_REQUEST, 0, self.winusb_interface,
+                                                 size, timeout=self.timeout_ms)
+                if len(data) != size:
+                    raise RuntimeError(f"Control IN of {len(data)} bytes, expected {size}")
+
+            latencies.append(time.perf_counter() - begin)
+
+        elapsed = time.perf_counter() - start
+        return summarize(test, size, iterations, size * iterations, elapsed, latencies)
+
+    def trigger(self, size, iterations):
+        """Fire USBTMC TRIGGER messages, then *TRG, and read the latency to the core 1 action."""
+        result = {"test": "trigger", "iterations": iterations}
+
+        for name, fire in (("usbtmc", self.instrument.assert_trigger),
+                           ("trg", lambda: self.instrument.write("*TRG"))):
+            self.instrument.write("BENCH:TRIG:RES")
+            self.query("*OPC?")
+
+            for _ in range(iterations):
+                fire()
+
+            self.query("*OPC?")
+            fired, delivered, missed, _, minimum, maximum, mean = \
+                (int(value) for value in self.query("BENCH:TRIG:STAT?").split(","))
+
+            if delivered + missed != fired or fired != iterations:
+                raise RuntimeError(f"trigger: {fired} fired, {delivered} delivered, {missed} missed, "
+                                   f"expected {iterations}")
+
+            result.update({
+                f"{name}_delivered": delivered,
+                f"{name}_missed": missed,
+                f"{name}_lat_min_us": minimum,
+                f"{name}_lat_max_us": maximum,
+                f"{name}_lat_mean_us": mean,
+            })
+
+        return result
+
+    def run(self, test, size, iterations):
+        if test == "usbtmc":
+            return self.usbtmc(size, iterations)
+        if test == "usbtmc-overlap":
+            return self.overlap(size, iterations)
+        if test in ("usbtmc-block", "usbtmc-ascii"):
+            return self.trace(test, size, iterations)
+        if test == "vendor-echo":
+            return self.echo(test, EPNUM_VENDOR_OUT, EPNUM_VENDOR_IN, size, iterations)
+        if test == "winusb-echo":
+            return self.echo(test, EPNUM_WINUSB_OUT, EPNUM_WINUSB_IN, size, iterations)
+        if test == "vendor-in":
+            return self.stream_in(test, "BENCH:VEND:SEND", EPNUM_VENDOR_IN, size, iterations)
+        if test == "winusb-in":
+            return self.stream_in(test, "BENCH:WINUSB:SEND", EPNUM_WINUSB_IN, size, iterations)
+        if test == "vendor-out":
+            return self.stream_out(test, EPNUM_VENDOR_OUT, 0, size, iterations)
+        if test == "winusb-out":
+            return self.stream_out(test, EPNUM_WINUSB_OUT, 1, size, iterations)
+        if test == "winusb-rpc":
+            return self.rpc(size, iterations)
+        if test == "trigger":
+            return self.trigger(size, iterations)
+        return self.control(test, size, iterations)
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(
+        description="Measure USB throughput and latency against the t76_usb_bench firmware.")
+    parser.add_argument("-t", "--tests", nargs="+", choices=TESTS, default=TESTS,
+                        help="Tests to run (default: all).")
+    parser.add_argument("-s", "--sizes", nargs="+", type=int, default=DEFAULT_SIZES,
+                        help="Payload sizes to sweep, in bytes.")
+    parser.add_argument("-n", "--iterations", type=int, default=200,
+                        help="Transfers per test and size.")
+    parser.add_argument("-o", "--output", help="Write the JSON lines to this file instead of stdout.")
+    parser.add_argument("-r", "--resource-fragment", default=DEFAULT_RESOURCE_FRAGMENT,
+                        help="Substring used to select the VISA resource.")
+    parser.add_argument("--vid", type=lambda value: int(value, 0), default=DEFAULT_VENDOR_ID,
+                        help="USB vendor ID.")
+    parser.add_argument("--pid", type=lambda value: int(value, 0), default=DEFAULT_PRODUCT_ID,
+                        help="USB product ID.")
+    parser.add_argument("--timeout", type=int, default=2000, help="Transfer timeout, in ms.")
+    parser.add_argument("--stats", action="store_true",
+                        help="Also emit the firmware's SYSTem:USB counters after each test.")
+    args = parser.parse_args()
+
+    output = open(args.output, "w") if args.output else sys.stdout
+    bench = Bench(args.resource_fragment, args.vid, args.pid, args.timeout)
+
+    try:
+        identity = bench.query("*IDN?")
+        print(json.dumps({"device": identity, "timestamp": time.time()}), file=output, flush=True)
+
+        for test in args.tests:
+            if args.stats:
+                bench.instrument.write("SYST:USB:RES")
+
+            for size in args.sizes[:1] if test in SIZELESS_TESTS else args.sizes:
+                result = bench.run(test, size, args.iterations)
+
+                if result is not None:
+                    print(json.dumps(result), file=output, flush=True)
+
+            if args.stats:
+                print(json.dumps({
+                    "test": test,
+                    "usb_stats": [int(value) for value in bench.query("SYST:USB:STAT?").split(",")],
+                    "dispatch_latency": [int(value) for value in bench.query("SYST:USB:LAT?").split(",")],
+                }), file=output, flush=True)
+    finally:
+        bench.close()
+
+        if output is not sys.stdout:
+            output.close()
+
+
+if __name__ == "__main__":
+    main()
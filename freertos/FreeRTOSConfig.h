@@ -183,6 +183,9 @@ extern uint64_t time_us_64(void); // "hardware/timer.h"
 #define portGET_RUN_TIME_COUNTER_VALUE() (time_us_64()/100)
 
 /* A header file that defines trace macro can be included here. */
+#ifdef T76_IC_TRACE
+#include "t76/trace_hooks.h"
+#endif
 
 #ifdef __cplusplus
 }
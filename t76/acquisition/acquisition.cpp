@@ -0,0 +1,265 @@
+/**
+ * @file acquisition.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the free-running ADC acquisition.
+ *
+ * The ring holds T76_IC_ACQUISITION_DEPTH rounds of conversions, so its
+ * length is a multiple of the number of channels and slot i always holds the
+ * channel at position i % channels in the round-robin order. A power-of-two
+ * DMA address ring would not keep that property for three or five channels,
+ * so the data channel writes the ring once and chains to a second channel
+ * that rewrites its write address, which restarts it at the beginning; the
+ * ADC's FIFO covers the few cycles this takes.
+ *
+ * The readers find the newest conversion from the data channel's write
+ * address, and never wait for the DMA.
+ *
+ */
+
+#include "t76/acquisition.hpp"
+#include "acquisition_private.hpp"
+
+#include <cstring>
+
+#include <hardware/adc.h>
+#include <hardware/clocks.h>
+#include <hardware/dma.h>
+
+#include <t76/placement.hpp>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+
+namespace {
+
+    constexpr uint32_t maxConversionRateHz = 500000;
+    constexpr uint32_t maxRingLength = NUM_ADC_CHANNELS * T76_IC_ACQUISITION_DEPTH;
+    constexpr uint8_t notSelected = 0xff;
+
+    alignas(4) uint16_t gRing[maxRingLength];               // Word-aligned for the decimation kernels
+    uint16_t *gRingAddress = gRing;                         // Read by the reload channel
+
+    int gReloadChannel = -1;
+    bool gRunning = false;
+
+    // Used by the readers
+    T76_CORE1_DATA int gDataChannel = -1;
+    T76_CORE1_DATA uint32_t gLength = 0;
+    T76_CORE1_DATA uint32_t gChannels = 0;
+    T76_CORE1_DATA uint32_t gConversionRateHz = 0;
+    T76_CORE1_DATA uint8_t gPositions[NUM_ADC_CHANNELS];    // Position of each input in the round-robin order
+
+    /**
+     * @brief Index of the slot the DMA writes next
+     */
+    inline __attribute__((always_inline)) uint32_t nextIndex() {
+        const uint32_t next = (reinterpret_cast<uintptr_t>(dma_hw->ch[gDataChannel].write_addr) - reinterpret_cast<uintptr_t>(gRing)) / sizeof(uint16_t);
+
+        // At the end of the ring until the reload channel has restarted the data channel
+        return next >= gLength ? 0 : next;
+    }
+
+    /**
+     * @brief Index of the newest conversion of a channel in the ring
+     */
+    inline __attribute__((always_inline)) uint32_t newestIndex(uint32_t channel) {
+        const uint32_t next = nextIndex();
+        const uint32_t newest = next == 0 ? gLength - 1 : next - 1;
+        const uint32_t position = newest % gChannels;
+        const uint32_t back = position >= gPositions[channel] ? position - gPositions[channel] : position + gChannels - gPositions[channel];
+
+        return newest >= back ? newest - back : newest + gLength - back;
+    }
+
+    inline __attribute__((always_inline)) bool selected(uint32_t channel) {
+        return gDataChannel >= 0 && channel < NUM_ADC_CHANNELS && gPositions[channel] != notSelected;
+    }
+
+} // namespace
+
+
+bool T76::Core::Acquisition::start(uint32_t channelMask, uint32_t conversionRateHz) {
+    if (gRunning || channelMask == 0 || channelMask >= (1u << NUM_ADC_CHANNELS) ||
+        conversionRateHz == 0 || conversionRateHz > maxConversionRateHz) {
+        return false;
+    }
+
+    const int dataChannel = dma_claim_unused_channel(false);
+    const int reloadChannel = dma_claim_unused_channel(false);
+
+    if (dataChannel < 0 || reloadChannel < 0) {
+        LOGE("Acquisition: not enough free DMA channels\n");
+        if (dataChannel >= 0) {
+            dma_channel_unclaim(dataChannel);
+        }
+
+        if (reloadChannel >= 0) {
+            dma_channel_unclaim(reloadChannel);
+        }
+
+        return false;
+    }
+
+    adc_init();
+
+    uint32_t channels = 0;
+    uint32_t first = NUM_ADC_CHANNELS;
+
+    // The round robin visits the selected inputs in increasing order, starting from the selected one
+    for (uint32_t input = 0; input < NUM_ADC_CHANNELS; input++) {
+        if ((channelMask & (1u << input)) == 0) {
+            gPositions[input] = notSelected;
+            continue;
+        }
+
+        if (first == NUM_ADC_CHANNELS) {
+            first = input;
+        }
+
+        gPositions[input] = static_cast<uint8_t>(channels++);
+
+        if (input == NUM_ADC_CHANNELS - 1) {
+            adc_set_temp_sensor_enabled(true);
+        } else {
+            adc_gpio_init(ADC_BASE_PIN + input);
+        }
+    }
+
+    gChannels = channels;
+    gConversionRateHz = conversionRateHz;
+    gLength = channels * T76_IC_ACQUISITION_DEPTH;
+    std::memset(gRing, 0, sizeof(gRing));
+
+    adc_select_input(first);
+    adc_set_round_robin(channelMask);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_fifo_drain();
+
+    // A conversion takes 96 ADC clocks; dividers below that convert back to back
+    adc_set_clkdiv(static_cast<float>(clock_get_hz(clk_adc)) / conversionRateHz - 1.0f);
+
+    dma_channel_config data = dma_channel_get_default_config(dataChannel);
+    channel_config_set_transfer_data_size(&data, DMA_SIZE_16);
+    channel_config_set_read_increment(&data, false);
+    channel_config_set_write_increment(&data, true);
+    channel_config_set_dreq(&data, DREQ_ADC);
+    channel_config_set_chain_to(&data, reloadChannel);
+    dma_channel_configure(dataChannel, &data, gRing, &adc_hw->fifo, gLength, false);
+
+    // Writing the data channel's write address trigger restarts it with its full transfer count
+    dma_channel_config reload = dma_channel_get_default_config(reloadChannel);
+    channel_config_set_transfer_data_size(&reload, DMA_SIZE_32);
+    channel_config_set_read_increment(&reload, false);
+    channel_config_set_write_increment(&reload, false);
+    dma_channel_configure(reloadChannel, &reload, &dma_hw->ch[dataChannel].al2_write_addr_trig, &gRingAddress, 1, false);
+
+    gReloadChannel = reloadChannel;
+    gDataChannel = dataChannel;
+    gRunning = true;
+
+    dma_channel_start(dataChannel);
+    adc_run(true);
+
+    return true;
+}
+
+void T76::Core::Acquisition::stop() {
+    if (!gRunning) {
+        return;
+    }
+
+    adc_run(false);
+
+    // Stop the data channel from restarting before aborting both
+    dma_channel_config data = dma_get_channel_config(gDataChannel);
+    channel_config_set_chain_to(&data, gDataChannel);
+    dma_channel_set_config(gDataChannel, &data, false);
+
+    dma_channel_abort(gReloadChannel);
+    dma_channel_abort(gDataChannel);
+
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+    adc_set_round_robin(0);
+
+    const int dataChannel = gDataChannel;
+
+    gDataChannel = -1;
+    gRunning = false;
+
+    dma_channel_unclaim(dataChannel);
+    dma_channel_unclaim(gReloadChannel);
+    gReloadChannel = -1;
+}
+
+bool T76::Core::Acquisition::running() {
+    return gRunning;
+}
+
+uint16_t T76_CORE1_CODE T76::Core::Acquisition::latest(uint32_t channel) {
+    if (!selected(channel)) {
+        return 0;
+    }
+
+    return gRing[newestIndex(channel)];
+}
+
+uint32_t T76_CORE1_CODE T76::Core::Acquisition::sum(uint32_t channel, uint32_t count) {
+    if (!selected(channel)) {
+        return 0;
+    }
+
+    if (count > T76_IC_ACQUISITION_DEPTH) {
+        count = T76_IC_ACQUISITION_DEPTH;
+    }
+
+    uint32_t index = newestIndex(channel);
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        total += gRing[index];
+        index = index >= gChannels ? index - gChannels : index + gLength - gChannels;
+    }
+
+    return total;
+}
+
+std::size_t T76::Core::Acquisition::copy(uint32_t channel, uint16_t *samples, std::size_t maxSamples) {
+    if (!selected(channel)) {
+        return 0;
+    }
+
+    const std::size_t count = maxSamples < T76_IC_ACQUISITION_DEPTH ? maxSamples : T76_IC_ACQUISITION_DEPTH;
+    uint32_t index = newestIndex(channel);
+
+    for (std::size_t i = count; i > 0; i--) {
+        samples[i - 1] = gRing[index];
+        index = index >= gChannels ? index - gChannels : index + gLength - gChannels;
+    }
+
+    return count;
+}
+
+const uint16_t * T76_CORE1_CODE T76::Core::Acquisition::Private::ring() {
+    return gRing;
+}
+
+uint32_t T76_CORE1_CODE T76::Core::Acquisition::Private::ringLength() {
+    return gLength;
+}
+
+uint32_t T76_CORE1_CODE T76::Core::Acquisition::Private::ringChannels() {
+    return gChannels;
+}
+
+uint32_t T76_CORE1_CODE T76::Core::Acquisition::Private::conversionRateHz() {
+    return gConversionRateHz;
+}
+
+uint32_t T76_CORE1_CODE T76::Core::Acquisition::Private::ringNext() {
+    return gDataChannel >= 0 ? nextIndex() : 0;
+}
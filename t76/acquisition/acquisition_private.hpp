@@ -0,0 +1,43 @@
+/**
+ * @file acquisition_private.hpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Access to the acquisition ring for the stream stage. This file should only
+ * be included by the acquisition's implementation files and is not part of
+ * the public API.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+
+namespace T76::Core::Acquisition::Private {
+
+    /**
+     * @brief Start of the ring
+     */
+    const uint16_t *ring();
+
+    /**
+     * @brief Number of slots in use, a multiple of the number of channels; 0 before start()
+     */
+    uint32_t ringLength();
+
+    /**
+     * @brief Number of selected channels
+     */
+    uint32_t ringChannels();
+
+    /**
+     * @brief Total conversion rate passed to start()
+     */
+    uint32_t conversionRateHz();
+
+    /**
+     * @brief Index of the slot the DMA channel writes next
+     */
+    uint32_t ringNext();
+
+} // namespace T76::Core::Acquisition::Private
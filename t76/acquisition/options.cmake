@@ -0,0 +1,3 @@
+# Configurable options for ADC acquisition
+
+set(T76_IC_ACQUISITION_DEPTH 16 CACHE STRING "Number of conversions of each channel kept in the ADC acquisition ring")
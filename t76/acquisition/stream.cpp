@@ -0,0 +1,248 @@
+/**
+ * @file stream.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the acquisition stream.
+ *
+ * The settings reach the pump through SharedParams, so all of the pump's
+ * state belongs to the pump alone and a new stream starts cleanly wherever
+ * the previous one was. The pump reads the ring in whole runs of
+ * decimation rounds; because the decimation divides the depth, a run never
+ * straddles the end of the ring.
+ *
+ * There is no way to tell from the ring itself how many times the DMA has
+ * gone around it, so the pump estimates from the time since its previous
+ * call how many conversions have arrived, and treats the ring as overwritten
+ * when that comes within a run of its length.
+ *
+ */
+
+#include "t76/acquisition_stream.hpp"
+#include "t76/acquisition.hpp"
+#include "t76/decimate.hpp"
+#include "acquisition_private.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include <t76/placement.hpp>
+#include <t76/shared_params.hpp>
+#include <t76/timebase.hpp>
+
+
+using namespace T76::Core::Acquisition;
+
+
+namespace {
+
+    struct StreamSettings {
+        FrameSink sink;
+        uint32_t decimationLog2;
+        bool enabled;
+    };
+
+    T76::Core::InterCore::SharedParams<StreamSettings> gSettings(StreamSettings{{nullptr, nullptr, nullptr, 0}, 0, false});
+
+    // Pump state
+    bool gActive = false;
+    uint32_t gLength = 0;               // Ring length the pump synchronized to
+    uint32_t gChannels = 0;
+    uint32_t gRunLength = 0;            // Conversions per run of decimation rounds
+    uint32_t gRead = 0;                 // Next slot to read, at the start of a run
+    uint32_t gLastPumpUs = 0;
+    uint8_t *gFrame = nullptr;
+    std::size_t gFrameBytes = 0;        // Usable bytes of a frame, a whole number of rounds
+    std::size_t gFill = 0;
+    uint32_t gFrameOldestUs = 0;
+
+    // Counters, read from the other core
+    std::atomic<uint32_t> gFrames{0};
+    std::atomic<uint32_t> gConversions{0};
+    std::atomic<uint32_t> gDroppedConversions{0};
+    std::atomic<uint32_t> gRingOverruns{0};
+    std::atomic<uint32_t> gFrameOverruns{0};
+    std::atomic<uint32_t> gLastLatencyUs{0};
+    std::atomic<uint32_t> gMaxLatencyUs{0};
+    std::atomic<uint32_t> gLastFrameUs{0};
+    std::atomic<bool> gFrameCommitted{false};
+
+    inline __attribute__((always_inline)) uint32_t conversionsToUs(uint32_t conversions) {
+        return static_cast<uint32_t>(static_cast<uint64_t>(conversions) * 1000000 / T76::Core::Acquisition::Private::conversionRateHz());
+    }
+
+    /**
+     * @brief Skip to the newest whole run, abandoning any partly filled frame
+     */
+    void T76_CORE1_CODE resynchronize(uint32_t next, uint32_t nowUs) {
+        gRead = next - next % gRunLength;
+        gLastPumpUs = nowUs;
+        gFrame = nullptr;
+        gFill = 0;
+    }
+
+    /**
+     * @brief Pick up new settings, or a restarted acquisition
+     * @return Whether a stream is running
+     */
+    bool T76_CORE1_CODE synchronize() {
+        const bool changed = gSettings.refresh();
+        const StreamSettings &settings = gSettings.value();
+
+        if (!changed && gLength == T76::Core::Acquisition::Private::ringLength()) {
+            return gActive;
+        }
+
+        gLength = T76::Core::Acquisition::Private::ringLength();
+        gChannels = T76::Core::Acquisition::Private::ringChannels();
+        gActive = settings.enabled && gLength != 0;
+
+        if (gActive) {
+            const std::size_t roundBytes = gChannels * sizeof(int16_t);
+
+            gRunLength = gChannels << settings.decimationLog2;
+            gFrameBytes = settings.sink.frameSize - settings.sink.frameSize % roundBytes;
+            gActive = gFrameBytes != 0 && gLength % gRunLength == 0;
+
+            resynchronize(T76::Core::Acquisition::Private::ringNext(), T76::Core::Timebase::now32());
+        }
+
+        return gActive;
+    }
+
+} // namespace
+
+
+bool T76::Core::Acquisition::startStream(const FrameSink &sink, uint32_t decimation) {
+    const uint32_t channels = Private::ringChannels();
+
+    if (!running() || sink.acquire == nullptr || sink.commit == nullptr ||
+        decimation == 0 || (decimation & (decimation - 1)) != 0 || T76_IC_ACQUISITION_DEPTH % decimation != 0 ||
+        sink.frameSize < channels * sizeof(int16_t)) {
+        return false;
+    }
+
+    const uint32_t decimationLog2 = __builtin_ctz(decimation);
+
+    if (decimationLog2 > maxDecimationLog2) {
+        return false;
+    }
+
+    gSettings.publish({sink, decimationLog2, true});
+    return true;
+}
+
+void T76::Core::Acquisition::stopStream() {
+    gSettings.update([](StreamSettings &settings) { settings.enabled = false; });
+}
+
+void T76_CORE1_CODE T76::Core::Acquisition::pumpStream() {
+    if (!synchronize()) {
+        return;
+    }
+
+    const StreamSettings &settings = gSettings.value();
+    const uint16_t *ring = Private::ring();
+    const uint32_t next = Private::ringNext();
+    const uint32_t nowUs = T76::Core::Timebase::now32();
+
+    // Conversions that arrived since the previous pump, as far as the clock can tell
+    const uint64_t arrived = static_cast<uint64_t>(nowUs - gLastPumpUs) * Private::conversionRateHz() / 1000000;
+
+    gLastPumpUs = nowUs;
+
+    if (arrived + gRunLength >= gLength) {
+        const uint32_t abandoned = static_cast<uint32_t>(gFill / (gChannels * sizeof(int16_t))) * gRunLength;
+
+        gRingOverruns.fetch_add(1, std::memory_order_relaxed);
+        gDroppedConversions.fetch_add(static_cast<uint32_t>(arrived) + abandoned, std::memory_order_relaxed);
+        resynchronize(next, nowUs);
+        return;
+    }
+
+    // Whole runs written since the last read
+    uint32_t pending = (next >= gRead ? next - gRead : next + gLength - gRead);
+    pending -= pending % gRunLength;
+
+    while (pending != 0) {
+        if (gFrame == nullptr) {
+            gFrame = settings.sink.acquire(settings.sink.context);
+
+            if (gFrame == nullptr) {
+                gFrameOverruns.fetch_add(1, std::memory_order_relaxed);
+                gDroppedConversions.fetch_add(pending, std::memory_order_relaxed);
+                gRead = (gRead + pending) % gLength;
+                return;
+            }
+
+            // The frame's oldest conversion is the next one to be read
+            gFrameOldestUs = nowUs - conversionsToUs(next >= gRead ? next - gRead : next + gLength - gRead);
+        }
+
+        // As many runs as fit in the frame, up to the end of the ring
+        const uint32_t outputBytesPerRun = gChannels * sizeof(int16_t);
+        uint32_t runs = pending / gRunLength;
+        runs = std::min<uint32_t>(runs, (gFrameBytes - gFill) / outputBytesPerRun);
+        runs = std::min<uint32_t>(runs, (gLength - gRead) / gRunLength);
+
+        const std::size_t values = decimate(ring + gRead, static_cast<std::size_t>(runs) << settings.decimationLog2, gChannels,
+                                            settings.decimationLog2, reinterpret_cast<int16_t *>(gFrame + gFill));
+
+        gFill += values * sizeof(int16_t);
+        gRead += runs * gRunLength;
+        pending -= runs * gRunLength;
+        gConversions.fetch_add(runs * gRunLength, std::memory_order_relaxed);
+
+        if (gRead == gLength) {
+            gRead = 0;
+        }
+
+        if (gFill == gFrameBytes) {
+            if (settings.sink.commit(settings.sink.context, gFill)) {
+                const uint32_t latencyUs = T76::Core::Timebase::now32() - gFrameOldestUs;
+
+                gLastFrameUs.store(gFrameOldestUs, std::memory_order_relaxed);
+                gFrameCommitted.store(true, std::memory_order_relaxed);
+                gFrames.fetch_add(1, std::memory_order_relaxed);
+                gLastLatencyUs.store(latencyUs, std::memory_order_relaxed);
+
+                if (latencyUs > gMaxLatencyUs.load(std::memory_order_relaxed)) {
+                    gMaxLatencyUs.store(latencyUs, std::memory_order_relaxed);
+                }
+            } else {
+                gFrameOverruns.fetch_add(1, std::memory_order_relaxed);
+                gDroppedConversions.fetch_add(static_cast<uint32_t>(gFill / outputBytesPerRun) * gRunLength, std::memory_order_relaxed);
+            }
+
+            gFrame = nullptr;
+            gFill = 0;
+        }
+    }
+}
+
+StreamStats T76::Core::Acquisition::streamStats() {
+    const StreamSettings &settings = gSettings.current();
+
+    return {
+        .streaming = settings.enabled,
+        .decimation = 1u << settings.decimationLog2,
+        .frames = gFrames.load(std::memory_order_relaxed),
+        .conversions = gConversions.load(std::memory_order_relaxed),
+        .droppedConversions = gDroppedConversions.load(std::memory_order_relaxed),
+        .ringOverruns = gRingOverruns.load(std::memory_order_relaxed),
+        .frameOverruns = gFrameOverruns.load(std::memory_order_relaxed),
+        .lastLatencyUs = gLastLatencyUs.load(std::memory_order_relaxed),
+        .maxLatencyUs = gMaxLatencyUs.load(std::memory_order_relaxed),
+        .lastFrameTimeUs = gFrameCommitted.load(std::memory_order_relaxed) ? T76::Core::Timebase::extend(gLastFrameUs.load(std::memory_order_relaxed)) : 0,
+    };
+}
+
+void T76::Core::Acquisition::resetStreamStats() {
+    gFrames.store(0, std::memory_order_relaxed);
+    gConversions.store(0, std::memory_order_relaxed);
+    gDroppedConversions.store(0, std::memory_order_relaxed);
+    gRingOverruns.store(0, std::memory_order_relaxed);
+    gFrameOverruns.store(0, std::memory_order_relaxed);
+    gLastLatencyUs.store(0, std::memory_order_relaxed);
+    gMaxLatencyUs.store(0, std::memory_order_relaxed);
+    gFrameCommitted.store(false, std::memory_order_relaxed);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file acquisition.hpp
+ * @brief Free-running ADC acquisition into a DMA ring
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Reading the ADC with adc_read() starts a conversion and waits about 2 µs
+ * for it, which is a large share of a fast control loop's period. Instead,
+ * the acquisition runs the ADC continuously, cycling through the selected
+ * channels in round-robin order, and a pair of DMA channels copies every
+ * conversion into a ring that holds the last T76_IC_ACQUISITION_DEPTH
+ * conversions of each channel. A control loop then reads the newest
+ * conversion of a channel, or the mean of the last few, without waiting:
+ *
+ *     T76::Core::Acquisition::start((1 << 0) | (1 << 1), 500000);     // GPIO 26 and 27, 250 kS/s each
+ *
+ *     const uint16_t raw = T76::Core::Acquisition::latest(0);
+ *     const uint32_t sum = T76::Core::Acquisition::sum(1, 8);       // Oversampled by 8
+ *
+ * The RP2350's ADC has no hardware averaging, so oversampling is done by
+ * summing the newest conversions, which costs one load and one add per
+ * conversion. Values are raw 12-bit conversions.
+ *
+ * The readers are placed in SRAM and may be called from any core and from
+ * interrupt handlers.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace T76::Core::Acquisition {
+
+    /**
+     * @brief Start converting
+     * @param channelMask Bit n selects ADC input n; the last input is the temperature sensor
+     * @param conversionRateHz Total conversions per second, shared by the selected channels; at most 500 kHz
+     * @return false if no channel is selected, the rate is out of range, no DMA channel is free, or acquisition is running
+     *
+     * Initializes the ADC and the GPIOs of the selected inputs. Each channel
+     * is converted conversionRateHz / (number of channels) times per second.
+     */
+    bool start(uint32_t channelMask, uint32_t conversionRateHz);
+
+    /**
+     * @brief Stop converting and release the DMA channels
+     */
+    void stop();
+
+    /**
+     * @brief Whether acquisition is running
+     */
+    bool running();
+
+    /**
+     * @brief Get the newest conversion of a channel
+     * @param channel ADC input number; must have been selected by start()
+     * @return The raw 12-bit conversion, or 0 before the channel's first conversion
+     */
+    uint16_t latest(uint32_t channel);
+
+    /**
+     * @brief Sum the newest conversions of a channel
+     * @param channel ADC input number; must have been selected by start()
+     * @param count Number of conversions, at most T76_IC_ACQUISITION_DEPTH
+     * @return The sum of the raw conversions; divide by count for their mean
+     */
+    uint32_t sum(uint32_t channel, uint32_t count);
+
+    /**
+     * @brief Copy the newest conversions of a channel, oldest first
+     * @param channel ADC input number; must have been selected by start()
+     * @param samples Receives the raw conversions
+     * @param maxSamples Capacity of samples
+     * @return Number of conversions copied, at most T76_IC_ACQUISITION_DEPTH
+     */
+    std::size_t copy(uint32_t channel, uint16_t *samples, std::size_t maxSamples);
+
+} // namespace T76::Core::Acquisition
@@ -0,0 +1,146 @@
+/**
+ * @file acquisition_stream.hpp
+ * @brief Continuous streaming of the acquisition ring in fixed frames
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The stream turns the acquisition ring into an unbroken sequence of
+ * conversions for the host. pumpStream(), called periodically on core 1,
+ * takes every conversion written since its last call, optionally averages
+ * runs of 2^n rounds with decimate(), and packs the result, as little-endian
+ * int16 values interleaved like the ring, into fixed frames that it hands to
+ * a frame sink. The WinUSB stream of the USB interface is such a sink, and
+ * sends the frames without copying them again; so is the isochronous stream,
+ * through isoStreamSink(), for a fixed bandwidth of one frame per millisecond:
+ *
+ *     T76::Core::Acquisition::start(1 << 0, 500000);
+ *     T76::Core::Acquisition::startStream(T76::Core::Acquisition::winUSBStreamSink(_usbInterface), 1);
+ *
+ *     T76::Core::Executive::addJob("Stream", pumpJob, nullptr, 1000, 0, T76::Core::Executive::JobContext::Background);
+ *
+ * The ring must hold the conversions that arrive between two pumps, so
+ * streaming needs a T76_IC_ACQUISITION_DEPTH much larger than a control loop
+ * does; at 500 kS/s and a pump every millisecond, 2048 leaves a margin of
+ * three periods. When the pump falls behind the ring, or the sink has no free
+ * frame, conversions are dropped and counted, and the stream resumes with
+ * the newest ones.
+ *
+ * startStream(), stopStream() and resetStreamStats() must only be used from
+ * one context at a time, usually SCPI handlers on core 0; pumpStream() must
+ * only be called from one context, usually a background executive job.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace T76::Core::Acquisition {
+
+    /**
+     * @brief Destination of the stream's frames
+     *
+     * acquire() returns a frame of frameSize bytes, or nullptr if none is
+     * free; commit() publishes it with the given number of valid bytes. The
+     * sink must return the same frame from acquire() until it is committed.
+     */
+    struct FrameSink {
+        uint8_t *(*acquire)(void *context);                 ///< Get a free frame, or nullptr
+        bool (*commit)(void *context, std::size_t length);  ///< Publish the frame returned by acquire()
+        void *context;                                      ///< Passed to acquire() and commit()
+        std::size_t frameSize;                              ///< Size of each frame, in bytes
+    };
+
+    /**
+     * @brief Statistics of the stream
+     *
+     * The counters accumulate across streams until resetStreamStats().
+     */
+    struct StreamStats {
+        bool streaming;                 ///< Whether a stream is running
+        uint32_t decimation;            ///< Rounds averaged per output round
+        uint32_t frames;                ///< Frames committed to the sink
+        uint32_t conversions;           ///< Conversions consumed into committed or pending frames
+        uint32_t droppedConversions;    ///< Conversions lost to either kind of overrun
+        uint32_t ringOverruns;          ///< Pumps that found the ring overwritten since the previous one
+        uint32_t frameOverruns;         ///< Pumps that found no free frame in the sink
+        uint32_t lastLatencyUs;         ///< Time from the oldest conversion of the last frame to its commit
+        uint32_t maxLatencyUs;          ///< Longest such time
+        uint64_t lastFrameTimeUs;       ///< Timebase time of the oldest conversion of the last frame, 0 before the first
+    };
+
+    /**
+     * @brief Make a frame sink of an interface's WinUSB stream
+     * @param interface A USB interface built with T76_IC_USB_WINUSB_STREAM
+     *
+     * A template, so that the acquisition does not depend on the USB
+     * library.
+     */
+    template<typename Interface>
+    FrameSink winUSBStreamSink(Interface &interface) {
+        return {
+            [](void *context) { return static_cast<Interface *>(context)->acquireWinUSBStreamFrame(); },
+            [](void *context, std::size_t length) { return static_cast<Interface *>(context)->commitWinUSBStreamFrame(length); },
+            &interface,
+            Interface::winUSBStreamFrameSize,
+        };
+    }
+
+    /**
+     * @brief Make a frame sink of an interface's isochronous stream
+     * @param interface A USB interface built with T76_IC_USB_ISO_STREAM
+     *
+     * Each frame is sent in a USB frame of its own, so the stream must not
+     * produce more than T76_IC_USB_ISO_STREAM_PACKET_SIZE bytes per
+     * millisecond.
+     */
+    template<typename Interface>
+    FrameSink isoStreamSink(Interface &interface) {
+        return {
+            [](void *context) { return static_cast<Interface *>(context)->acquireIsoStreamFrame(); },
+            [](void *context, std::size_t length) { return static_cast<Interface *>(context)->commitIsoStreamFrame(length); },
+            &interface,
+            Interface::isoStreamFrameSize,
+        };
+    }
+
+    /**
+     * @brief Start streaming the acquisition ring
+     * @param sink Where to send the frames
+     * @param decimation Rounds averaged per output round: a power of two that divides T76_IC_ACQUISITION_DEPTH, up to 256; 1 streams every conversion
+     * @return false if acquisition is not running, the decimation is invalid, or a frame cannot hold one round
+     *
+     * The stream starts with the conversions that follow the pump's next
+     * call. Starting a running stream restarts it with the new settings;
+     * a partly filled frame is abandoned.
+     */
+    bool startStream(const FrameSink &sink, uint32_t decimation = 1);
+
+    /**
+     * @brief Stop streaming on the pump's next call
+     *
+     * A partly filled frame is abandoned.
+     */
+    void stopStream();
+
+    /**
+     * @brief Move the conversions written since the last call into frames
+     *
+     * Placed in SRAM. Call periodically while streaming, at least once per
+     * T76_IC_ACQUISITION_DEPTH rounds of conversions; returns at once when
+     * no stream is running.
+     */
+    void pumpStream();
+
+    /**
+     * @brief Get the stream's statistics
+     */
+    StreamStats streamStats();
+
+    /**
+     * @brief Reset the stream's counters
+     */
+    void resetStreamStats();
+
+} // namespace T76::Core::Acquisition
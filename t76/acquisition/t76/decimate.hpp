@@ -0,0 +1,139 @@
+/**
+ * @file decimate.hpp
+ * @brief Averaging kernels for interleaved 12-bit conversions
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * decimate() replaces each run of 2^n rounds of interleaved conversions with
+ * the mean of every channel over the run, which lowers the rate of a stream
+ * and its noise at the same time.
+ *
+ * The kernels work on two conversions at a time: 12-bit conversions leave
+ * four spare bits in each 16-bit half of a 32-bit word, so up to 16 words can
+ * be added as plain 32-bit integers before either half can carry into the
+ * other. The inner loops are therefore one load and one add per pair of
+ * conversions, without intrinsics; the halves are only separated once per
+ * run.
+ *
+ * decimate() is always inlined, so that it runs from wherever its caller is
+ * placed.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+namespace T76::Core::Acquisition {
+
+    /**
+     * @brief Largest decimation factor, as a power of two
+     */
+    static constexpr uint32_t maxDecimationLog2 = 8;
+
+    namespace Kernels {
+
+        /**
+         * @brief Number of words that can be added before a 16-bit half overflows
+         */
+        static constexpr uint32_t wordsPerChunk = 16;
+
+        inline __attribute__((always_inline)) uint32_t loadPair(const uint16_t *samples) {
+            uint32_t pair;
+
+            std::memcpy(&pair, samples, sizeof(pair));
+            return pair;
+        }
+
+    } // namespace Kernels
+
+    /**
+     * @brief Average runs of rounds of interleaved conversions
+     * @param in Conversions, channels per round, starting at the first channel of a round
+     * @param rounds Number of rounds in the input; a trailing partial run is ignored
+     * @param channels Number of interleaved channels
+     * @param factorLog2 Number of rounds averaged per output round, as a power of two; at most maxDecimationLog2
+     * @param out Receives (rounds >> factorLog2) * channels means, interleaved like the input
+     * @return Number of values written to out
+     *
+     * The means are truncated. With a factor of 1, the conversions are
+     * copied unchanged. out may point to the same buffer as in.
+     */
+    inline __attribute__((always_inline)) std::size_t decimate(const uint16_t *in, std::size_t rounds, uint32_t channels, uint32_t factorLog2, int16_t *out) {
+        const uint32_t factor = 1u << factorLog2;
+        const std::size_t groups = rounds >> factorLog2;
+
+        if (factorLog2 == 0) {
+            std::memmove(out, in, rounds * channels * sizeof(uint16_t));
+            return rounds * channels;
+        }
+
+        if (channels == 1) {
+            // Consecutive conversions pair up; the two halves of the sum are folded at the end of each run
+            for (std::size_t group = 0; group < groups; group++) {
+                uint32_t total = 0;
+
+                for (uint32_t first = 0; first < factor / 2; first += Kernels::wordsPerChunk) {
+                    const uint32_t words = factor / 2 - first < Kernels::wordsPerChunk ? factor / 2 - first : Kernels::wordsPerChunk;
+                    uint32_t pairs = 0;
+
+                    for (uint32_t word = 0; word < words; word++) {
+                        pairs += Kernels::loadPair(in + 2 * (first + word));
+                    }
+
+                    total += (pairs & 0xffff) + (pairs >> 16);
+                }
+
+                *out++ = static_cast<int16_t>(total >> factorLog2);
+                in += factor;
+            }
+        } else if (channels % 2 == 0) {
+            // Each round is channels / 2 words, and each half of a word always holds the same channel
+            for (std::size_t group = 0; group < groups; group++) {
+                for (uint32_t lane = 0; lane < channels; lane += 2) {
+                    uint32_t low = 0;
+                    uint32_t high = 0;
+
+                    for (uint32_t first = 0; first < factor; first += Kernels::wordsPerChunk) {
+                        const uint32_t rows = factor - first < Kernels::wordsPerChunk ? factor - first : Kernels::wordsPerChunk;
+                        uint32_t pairs = 0;
+
+                        for (uint32_t row = 0; row < rows; row++) {
+                            pairs += Kernels::loadPair(in + (first + row) * channels + lane);
+                        }
+
+                        low += pairs & 0xffff;
+                        high += pairs >> 16;
+                    }
+
+                    out[lane] = static_cast<int16_t>(low >> factorLog2);
+                    out[lane + 1] = static_cast<int16_t>(high >> factorLog2);
+                }
+
+                in += factor * channels;
+                out += channels;
+            }
+        } else {
+            // Odd numbers of channels do not pair up
+            for (std::size_t group = 0; group < groups; group++) {
+                for (uint32_t channel = 0; channel < channels; channel++) {
+                    uint32_t total = 0;
+
+                    for (uint32_t row = 0; row < factor; row++) {
+                        total += in[row * channels + channel];
+                    }
+
+                    out[channel] = static_cast<int16_t>(total >> factorLog2);
+                }
+
+                in += factor * channels;
+                out += channels;
+            }
+        }
+
+        return groups * channels;
+    }
+
+} // namespace T76::Core::Acquisition
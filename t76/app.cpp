@@ -28,7 +28,8 @@ App::App() : _usbInterface(*this) {
 /**
  * @brief Run the complete application initialization sequence
  * 
- * Executes the framework initialization in the following order:
+ * Executes the framework initialization in the following order, marking
+ * the end of each step in the boot profile:
  * 
  * 1. Safety System Initialization
  *    - Sets up fault detection and reporting infrastructure
@@ -38,6 +39,14 @@ App::App() : _usbInterface(*this) {
  * 2. Memory Management Initialization
  *    - Configures heap and memory allocation system
  *    - Sets up inter-core memory allocation service (if enabled)
+ *    - Claims the DMA channels of the bulk copy and fill service
+ *    - Initializes the USB interface, which attaches to the bus, so that the
+ *      host enumerates the device while the rest of startup runs
+ *    - Starts the task that outputs deferred log messages
+ *    - Starts the task that streams trace events (if enabled)
+ *    - Starts the task that samples task stacks and CPU loads (if enabled)
+ *    - Sets up the flash service that coordinates flash writes with Core 1
+ *    - Loads the persistent settings into RAM
  * 
  * 3. Application Early Initialization
  *    - Calls _init() hook for derived class setup
@@ -47,6 +56,8 @@ App::App() : _usbInterface(*this) {
  *    - Resets Core 1 to clean state
  *    - Launches Core 1 with _core1EntryPoint trampoline
  *    - Core 1 begins executing _startCore1() hook
+ *    - With T76_IC_SMP, creates a task pinned to Core 1 that runs the
+ *      trampoline once the scheduler has started both cores instead
  * 
  * 5. Watchdog Initialization
  *    - Configures dual-core watchdog protection system
@@ -58,7 +69,7 @@ App::App() : _usbInterface(*this) {
  *    - Typically creates FreeRTOS tasks for Core 0
  * 
  * 7. Scheduler Start
- *    - Starts FreeRTOS scheduler on Core 0
+ *    - Starts FreeRTOS scheduler on Core 0 (on both cores with T76_IC_SMP)
  *    - Begins task execution and system operation
  *    - Never returns under normal operation
  * 
@@ -70,21 +81,73 @@ App::App() : _usbInterface(*this) {
  * @note Safety faults will be reported if critical initialization fails
  */
 void App::run() {
+    T76::Core::BootProfile::init();
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::Run);
+
     // Initialize safety system first on Core 0
     T76::Core::Safety::init();
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::Safety);
     
     // Initialize memory management system
     T76::Core::Memory::init();
 
-    // Initialize USB interface
+    // Claim the channels of the DMA copy service; copies run on the CPU until then
+    T76::Core::DMA::init();
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::Memory);
+
+    // Initialize USB interface as early as possible, as enumeration takes
+    // the host a while
     _usbInterface.init();
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::USB);
+
+    // Start the task that outputs log messages
+    T76::Core::Log::init();
+
+#ifdef T76_IC_TRACE
+    // Stream trace events over the vendor bulk IN endpoint once a trace is started
+    T76::Core::Trace::setSink(_traceSink, this);
+    T76::Core::Trace::init();
+#endif
+
+#ifdef T76_IC_TASK_MONITOR
+    // Sample the stack high water mark and CPU load of every task
+    T76::Core::TaskMonitor::init();
+#endif
+
+    // Initialize the flash service, before Core 1 is launched
+    T76::Core::Flash::init();
+
+    // Load the settings, so that _init() can read them
+    T76::Core::Settings::init();
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::Services);
 
     // Perform application-specific initialization
     _init();
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::Init);
+
+#ifdef T76_IC_SMP
+    // The scheduler starts core 1; its initialization runs in a task pinned to it
+    TaskHandle_t core1Task = nullptr;
 
+    xTaskCreate(
+        [](void *param) {
+            _core1EntryPoint();
+            vTaskDelete(nullptr);
+        },
+        "Core1Init",
+        configMINIMAL_STACK_SIZE * 4,
+        nullptr,
+        configMAX_PRIORITIES - 1,
+        &core1Task
+    );
+
+    vTaskCoreAffinitySet(core1Task, 1u << 1);
+#else
     // Initialize Core 1
     multicore_reset_core1();
     multicore_launch_core1(_core1EntryPoint);
+#endif
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::Core1Launch);
 
     // Initialize dual-core watchdog system (must be done on Core 0)
     if (!T76::Core::Safety::watchdogInit()) {
@@ -94,8 +157,11 @@ void App::run() {
                                      __FILE__, __LINE__, __FUNCTION__);
     }
 
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::Watchdog);
+
     // Initialize Core 0
     _initCore0();
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::InitCore0);
 
     // Start the FreeRTOS scheduler
     vTaskStartScheduler();
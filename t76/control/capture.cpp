@@ -0,0 +1,59 @@
+/**
+ * @file capture.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the capture's control side. record() is inlined into the
+ * loop, so nothing here runs on core 1 and it stays in flash.
+ *
+ */
+
+#include "t76/capture.hpp"
+
+#include <algorithm>
+#include <limits>
+
+
+using namespace T76::Core::Control;
+
+
+Capture::Capture(float *storage, std::size_t channels, std::size_t depth) : _storage(storage), _channels(channels), _depth(depth) {
+}
+
+bool Capture::arm(const CaptureSettings &settings) {
+    if (settings.channel >= _channels || settings.preTrigger >= _depth || settings.interval == 0) {
+        return false;
+    }
+
+    // The recorder leaves everything alone until the store that arms it
+    _state.store(CaptureState::Idle, std::memory_order_release);
+
+    _settings = settings;
+    _write = 0;
+    _countdown = 1;
+    _preTriggerRemaining = settings.preTrigger;
+    _postTriggerRemaining = 0;
+    _previous = std::numeric_limits<float>::quiet_NaN();    // No crossing on the first record
+    _linear = false;
+    _forced.store(false, std::memory_order_relaxed);
+
+    _state.store(CaptureState::Armed, std::memory_order_release);
+    return true;
+}
+
+void Capture::abort() {
+    _state.store(CaptureState::Idle, std::memory_order_release);
+}
+
+const float *Capture::data() {
+    if (state() != CaptureState::Done) {
+        return nullptr;
+    }
+
+    // The oldest record is the one the recorder would have overwritten next
+    if (!_linear) {
+        std::rotate(_storage, _storage + _write * _channels, _storage + _depth * _channels);
+        _linear = true;
+    }
+
+    return _storage;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file pid.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the PID controller's writer side. Nothing here runs in
+ * the control loop, so it stays in flash.
+ *
+ */
+
+#include "t76/pid.hpp"
+
+#include <cmath>
+
+
+using namespace T76::Core::Control;
+
+
+namespace {
+
+    /**
+     * @brief Coefficient of a first-order low-pass filter with the given corner, capped at 1 (no filtering)
+     */
+    float filterAlpha(float cornerHz, float samplePeriod) {
+        if (cornerHz <= 0.0f) {
+            return 1.0f;
+        }
+
+        return std::min(2.0f * static_cast<float>(M_PI) * cornerHz * samplePeriod, 1.0f);
+    }
+
+} // namespace
+
+
+PID::PID(float sampleRateHz, const PIDSettings &settings) : _samplePeriod(1.0f / sampleRateHz), _settings(settings) {
+    _publish();
+}
+
+void PID::configure(const PIDSettings &settings) {
+    _settings = settings;
+    _publish();
+}
+
+void PID::_publish() {
+    const float derivativeDenominator = _settings.derivativeTau + _samplePeriod;
+
+    _coefficients.publish({
+        .kP = _settings.kP,
+        .kIHalfPeriod = _settings.kI * _samplePeriod * 0.5f,
+        .derivativeA = _settings.derivativeTau / derivativeDenominator,
+        .derivativeB = _settings.kD / derivativeDenominator,
+        .setPointAlpha = filterAlpha(_settings.setPointCornerHz, _samplePeriod),
+        .measurementAlpha = filterAlpha(_settings.measurementCornerHz, _samplePeriod),
+        .antiwindupGain = _settings.antiwindupGain,
+        .outputMin = _settings.outputMin,
+        .outputMax = _settings.outputMax,
+        .setPoint = _settings.setPoint,
+    });
+}
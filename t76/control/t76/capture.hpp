@@ -0,0 +1,246 @@
+/**
+ * @file capture.hpp
+ * @brief Triggered capture of control loop state, with pre-trigger history
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Polling a loop's state over SCPI shows it at the rate of USB round trips,
+ * which hides everything that happens within a few periods. A Capture works
+ * like an oscilloscope instead: once armed, the loop hands it one record of
+ * a few floats per cycle, such as its set point, measurement, error and
+ * output, and the capture keeps the last ones in a preallocated ring. When
+ * the trigger fires, it records as many more as are needed to fill the ring
+ * and stops, leaving a window that starts the chosen number of records
+ * before the trigger:
+ *
+ *     static float gStorage[4 * 1024];
+ *     T76_CORE1_DATA static T76::Core::Control::Capture gCapture(gStorage, 4, 1024);
+ *
+ *     gCapture.arm({.source = T76::Core::Control::TriggerSource::Level, .channel = 1, .level = 2.5f});  // Core 0
+ *
+ *     const float record[4] = {state.setPoint, state.measurement, state.error, state.output};
+ *     gCapture.record(record);                                                                       // Core 1
+ *
+ * record() is inlined into the loop and costs a copy of the record and a
+ * comparison per cycle while armed, and a single load otherwise; it never
+ * waits. Once the capture is Done, the loop leaves the ring alone, and core
+ * 0 reads the records in chronological order with data().
+ *
+ * arm(), trigger(), abort() and data() must only be used from one context at
+ * a time, and so must record().
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace T76::Core::Control {
+
+    /**
+     * @brief What fires the trigger of a capture
+     */
+    enum class TriggerSource : uint8_t {
+        Software,       ///< Only trigger()
+        Level,          ///< A channel crossing a level, or trigger()
+    };
+
+    /**
+     * @brief Which crossings of the level fire a level trigger
+     */
+    enum class TriggerSlope : uint8_t {
+        Rising,         ///< From below the level to at or above it
+        Falling,        ///< From above the level to at or below it
+        Either,         ///< Both
+    };
+
+    /**
+     * @brief Settings of a capture, given to arm()
+     */
+    struct CaptureSettings {
+        TriggerSource source = TriggerSource::Software; ///< What fires the trigger
+        uint8_t channel = 0;                            ///< Channel compared with the level
+        TriggerSlope slope = TriggerSlope::Rising;      ///< Crossings that fire a level trigger
+        float level = 0.0f;                             ///< Level of a level trigger
+        uint32_t preTrigger = 0;                        ///< Records kept from before the trigger; less than the depth
+        uint32_t interval = 1;                          ///< Cycles per record; 1 records every cycle
+    };
+
+    /**
+     * @brief State of a capture
+     */
+    enum class CaptureState : uint8_t {
+        Idle,           ///< Not armed; record() does nothing
+        Armed,          ///< Recording, and waiting for the trigger once the pre-trigger records are in
+        Triggered,      ///< Recording the records that follow the trigger
+        Done,           ///< The ring holds a complete capture; record() does nothing
+    };
+
+    /**
+     * @brief Triggered ring of fixed-size records
+     */
+    class Capture {
+    public:
+        /**
+         * @brief Construct a capture
+         * @param storage Room for channels * depth floats, which must outlive the capture
+         * @param channels Floats per record
+         * @param depth Records per capture
+         */
+        Capture(float *storage, std::size_t channels, std::size_t depth);
+
+        Capture(const Capture&) = delete;
+        Capture& operator=(const Capture&) = delete;
+
+        /**
+         * @brief Start a new capture
+         * @return false if the channel is out of range, preTrigger is not below the depth, or the interval is 0
+         *
+         * Discards any previous capture. The trigger is ignored until
+         * preTrigger records have been recorded.
+         */
+        bool arm(const CaptureSettings &settings);
+
+        /**
+         * @brief Fire the trigger, whatever the source
+         *
+         * The trigger fires on the first record at which the capture accepts
+         * it; it does nothing unless the capture is armed.
+         */
+        void trigger() {
+            _forced.store(true, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Stop an armed or triggered capture and return to Idle
+         */
+        void abort();
+
+        /**
+         * @brief Get the state of the capture
+         */
+        CaptureState state() const {
+            return _state.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Get the records of a completed capture, oldest first
+         * @return channels() * depth() floats, or nullptr if the capture is not Done
+         *
+         * Rotates the ring in place the first time it is called after a
+         * capture completes. The trigger record is at index preTrigger.
+         */
+        const float *data();
+
+        /**
+         * @brief Floats per record
+         */
+        std::size_t channels() const {
+            return _channels;
+        }
+
+        /**
+         * @brief Records per capture
+         */
+        std::size_t depth() const {
+            return _depth;
+        }
+
+        /**
+         * @brief Get the settings of the last arm()
+         */
+        const CaptureSettings &settings() const {
+            return _settings;
+        }
+
+        /**
+         * @brief Record one cycle of the loop
+         * @param values channels() floats
+         */
+        inline __attribute__((always_inline)) void record(const float *values) {
+            const CaptureState state = _state.load(std::memory_order_acquire);
+
+            if (state != CaptureState::Armed && state != CaptureState::Triggered) {
+                return;
+            }
+
+            if (--_countdown != 0) {
+                return;
+            }
+
+            _countdown = _settings.interval;
+
+            float *slot = _storage + _write * _channels;
+
+            for (std::size_t channel = 0; channel < _channels; channel++) {
+                slot[channel] = values[channel];
+            }
+
+            _write = _write + 1 == _depth ? 0 : _write + 1;
+
+            if (state == CaptureState::Armed) {
+                const float value = values[_settings.channel];
+                const bool crossed = _preTriggerRemaining == 0 && _crossed(_previous, value);
+
+                _previous = value;
+
+                if (_preTriggerRemaining != 0) {
+                    _preTriggerRemaining--;
+                } else if (crossed || _forced.load(std::memory_order_relaxed)) {
+                    // The trigger record is the first of the post-trigger records
+                    _postTriggerRemaining = static_cast<uint32_t>(_depth - _settings.preTrigger) - 1;
+                    _advance(CaptureState::Armed, _postTriggerRemaining == 0 ? CaptureState::Done : CaptureState::Triggered);
+                }
+            } else if (--_postTriggerRemaining == 0) {
+                _advance(CaptureState::Triggered, CaptureState::Done);
+            }
+        }
+
+    protected:
+        /**
+         * @brief Whether going from previous to value fires the level trigger
+         */
+        inline __attribute__((always_inline)) bool _crossed(float previous, float value) const {
+            if (_settings.source != TriggerSource::Level) {
+                return false;
+            }
+
+            const bool rising = previous < _settings.level && value >= _settings.level;
+            const bool falling = previous > _settings.level && value <= _settings.level;
+
+            switch (_settings.slope) {
+                case TriggerSlope::Rising:
+                    return rising;
+                case TriggerSlope::Falling:
+                    return falling;
+                default:
+                    return rising || falling;
+            }
+        }
+
+        /**
+         * @brief Move from one state to the next, unless abort() got there first
+         */
+        inline __attribute__((always_inline)) void _advance(CaptureState from, CaptureState to) {
+            _state.compare_exchange_strong(from, to, std::memory_order_release, std::memory_order_relaxed);
+        }
+
+        float *_storage;                                ///< channels * depth floats
+        std::size_t _channels;                          ///< Floats per record
+        std::size_t _depth;                             ///< Records per capture
+        CaptureSettings _settings;                      ///< Settings of the last arm()
+        std::atomic<CaptureState> _state{CaptureState::Idle};
+        std::atomic<bool> _forced{false};               ///< Set by trigger()
+
+        // Recorder's state, set up by arm() before the capture is armed
+        std::size_t _write = 0;                         ///< Next record to write
+        uint32_t _countdown = 1;                        ///< Cycles until the next record
+        uint32_t _preTriggerRemaining = 0;              ///< Records before the trigger is accepted
+        uint32_t _postTriggerRemaining = 0;             ///< Records until the capture is Done
+        float _previous = 0.0f;                         ///< Previous value of the trigger channel
+        bool _linear = false;                           ///< Whether data() has rotated the ring
+    };
+
+} // namespace T76::Core::Control
@@ -0,0 +1,183 @@
+/**
+ * @file pid.hpp
+ * @brief PID controller with precomputed coefficients for fast control loops
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The controller filters its set point and its measurement with first-order
+ * low-pass filters, integrates the error with the trapezoidal rule, filters
+ * the derivative of the error, and limits the integrator with back-calculation
+ * anti-windup when the output saturates.
+ *
+ * The settings (gains, filter corners, output limits and set point) are
+ * changed on the writer side, typically by SCPI handlers on core 0. Every
+ * change turns them into the coefficients of the discrete-time controller,
+ * divisions included, and publishes those through SharedParams, so that
+ * step(), called once per sample from the control interrupt on core 1, is a
+ * short sequence of single-precision multiply-adds:
+ *
+ *     T76_CORE1_DATA static T76::Core::Control::PID gPID(controlRateHz);
+ *
+ *     gPID.update([](T76::Core::Control::PIDSettings &settings) { settings.kP = 0.1f; });   // Core 0
+ *
+ *     const float duty = gPID.step(measuredVoltage);                                       // Core 1
+ *
+ * As with SharedParams, the writer side must only be used from one context
+ * at a time, and so must the reader side.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+
+#include <t76/shared_params.hpp>
+
+
+namespace T76::Core::Control {
+
+    /**
+     * @brief Settings of a PID controller, in physical units
+     */
+    struct PIDSettings {
+        float kP = 0.0f;                        ///< Proportional gain
+        float kI = 0.0f;                        ///< Integral gain, per second
+        float kD = 0.0f;                        ///< Derivative gain, in seconds
+        float derivativeTau = 0.0f;             ///< Time constant of the derivative filter, in seconds
+        float setPointCornerHz = 0.0f;          ///< Corner of the set point filter, or 0 to leave the set point unfiltered
+        float measurementCornerHz = 0.0f;       ///< Corner of the measurement filter, or 0 to leave the measurement unfiltered
+        float antiwindupGain = 0.0f;            ///< Gain with which the output saturation is fed back into the integrator
+        float outputMin = 0.0f;                 ///< Lowest output
+        float outputMax = 1.0f;                 ///< Highest output
+        float setPoint = 0.0f;                  ///< Set point
+    };
+
+    /**
+     * @brief Coefficients of the discrete-time controller, derived from PIDSettings
+     */
+    struct PIDCoefficients {
+        float kP;                               ///< Proportional gain
+        float kIHalfPeriod;                     ///< kI * T / 2, for the trapezoidal rule
+        float derivativeA;                      ///< tau / (tau + T)
+        float derivativeB;                      ///< kD / (tau + T)
+        float setPointAlpha;                    ///< Set point filter coefficient
+        float measurementAlpha;                 ///< Measurement filter coefficient
+        float antiwindupGain;                   ///< Back-calculation gain
+        float outputMin;                        ///< Lowest output
+        float outputMax;                        ///< Highest output
+        float setPoint;                         ///< Set point
+    };
+
+    /**
+     * @brief State of a PID controller, updated by step()
+     */
+    struct PIDState {
+        float setPoint = 0.0f;                  ///< Filtered set point
+        float measurement = 0.0f;               ///< Filtered measurement
+        float error = 0.0f;                     ///< Error of the last sample
+        float integrator = 0.0f;                ///< Integral term
+        float derivative = 0.0f;                ///< Filtered derivative term
+        float output = 0.0f;                    ///< Output of the last sample, after limiting
+    };
+
+    /**
+     * @brief PID controller whose coefficients are computed once per change
+     */
+    class PID {
+    public:
+        /**
+         * @brief Construct a controller
+         * @param sampleRateHz Rate at which step() is called
+         * @param settings Initial settings
+         */
+        explicit PID(float sampleRateHz, const PIDSettings &settings = PIDSettings());
+
+        PID(const PID&) = delete;
+        PID& operator=(const PID&) = delete;
+
+        /**
+         * @brief Replace all of the settings
+         *
+         * Writer side. The new coefficients take effect together on the
+         * reader's next step().
+         */
+        void configure(const PIDSettings &settings);
+
+        /**
+         * @brief Change some of the settings
+         * @param modify Callable that receives a reference to a copy of the current settings
+         *
+         * Writer side. The coefficients are recomputed once, whatever the
+         * number of fields changed.
+         */
+        template<typename Modify>
+        void update(Modify modify) {
+            modify(_settings);
+            _publish();
+        }
+
+        /**
+         * @brief Get the settings last applied on the writer side
+         */
+        const PIDSettings &settings() const {
+            return _settings;
+        }
+
+        /**
+         * @brief Run the controller for one sample
+         * @param measurement The process variable
+         * @return The limited output
+         *
+         * Reader side. Picks up newly published coefficients, if any, and
+         * then takes no division and no branch other than the output limits.
+         */
+        inline __attribute__((always_inline)) float step(float measurement) {
+            _coefficients.refresh();
+
+            const PIDCoefficients &c = _coefficients.value();
+            PIDState &s = _state;
+
+            // First-order low-pass filters: y[n] = y[n-1] + alpha * (x[n] - y[n-1])
+            s.setPoint += c.setPointAlpha * (c.setPoint - s.setPoint);
+            s.measurement += c.measurementAlpha * (measurement - s.measurement);
+
+            const float error = s.setPoint - s.measurement;
+
+            // Trapezoidal integral, and derivative filtered as y[n] = a * y[n-1] + b * (e[n] - e[n-1])
+            s.integrator += c.kIHalfPeriod * (error + s.error);
+            s.derivative = c.derivativeA * s.derivative + c.derivativeB * (error - s.error);
+
+            const float unlimited = c.kP * error + s.integrator + s.derivative;
+            const float output = std::clamp(unlimited, c.outputMin, c.outputMax);
+
+            // Back-calculation anti-windup
+            s.integrator += c.antiwindupGain * (output - unlimited);
+
+            s.error = error;
+            s.output = output;
+
+            return output;
+        }
+
+        /**
+         * @brief Get the controller's state
+         *
+         * Written by step(); reading it from the other core gives values
+         * that may be a sample apart, which is fine for reporting.
+         */
+        const PIDState &state() const {
+            return _state;
+        }
+
+    protected:
+        /**
+         * @brief Compute the coefficients of the current settings and publish them
+         */
+        void _publish();
+
+        float _samplePeriod;                                        ///< 1 / sampleRateHz
+        PIDSettings _settings;                                      ///< Writer's copy of the settings
+        T76::Core::InterCore::SharedParams<PIDCoefficients> _coefficients;
+        PIDState _state;                                            ///< Reader's state
+    };
+
+} // namespace T76::Core::Control
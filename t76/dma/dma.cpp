@@ -0,0 +1,287 @@
+/**
+ * @file dma.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the DMA copy and fill service.
+ *
+ * Each claimed channel is a slot that a transfer takes with a compare and
+ * exchange, so that tasks on either core can start transfers without a
+ * lock. The completion interrupt marks the slot done and notifies the task
+ * that started the transfer; the slot is only released by wait(), once that
+ * task has seen it done, so a handle can never refer to somebody else's
+ * transfer.
+ *
+ */
+
+#include "t76/dma.hpp"
+
+#include <atomic>
+#include <cstring>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/regs/addressmap.h>
+#include <pico/platform.h>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+
+using namespace T76::Core::DMA;
+
+
+static_assert(T76_IC_DMA_THRESHOLD >= 8, "The DMA threshold must leave room for the unaligned ends of a transfer");
+static_assert(configTASK_NOTIFICATION_ARRAY_ENTRIES > T76_IC_DMA_NOTIFY_INDEX, "The DMA service needs configTASK_NOTIFICATION_ARRAY_ENTRIES above T76_IC_DMA_NOTIFY_INDEX");
+
+
+namespace {
+
+    // DMA_IRQ_0 is left to the SDK's drivers and the application
+    constexpr uint irqIndex = 1;
+    constexpr uint irqNumber = DMA_IRQ_1;
+
+    struct Slot {
+        int channel = -1;
+        std::atomic<bool> busy{false};          // Taken by a transfer, until wait() sees it done
+        std::atomic<bool> done{false};          // Set by the completion interrupt
+        TaskHandle_t waiter = nullptr;          // Task that started the transfer
+        uint32_t pattern = 0;                   // Source of a fill, read over and over by the DMA
+    };
+
+    Slot gSlots[T76_IC_DMA_CHANNELS];
+    uint32_t gSlotCount = 0;
+    std::atomic<bool> gReady{false};
+
+    std::atomic<uint32_t> gTransfers{0};
+    std::atomic<uint32_t> gBytes{0};
+    std::atomic<uint32_t> gFallbacks{0};
+    std::atomic<uint32_t> gBusy{0};
+
+    /**
+     * @brief Whether the caller is a task that can block until the completion interrupt
+     */
+    bool callerCanBlock() {
+#ifndef T76_IC_SMP
+        if (get_core_num() != 0) {
+            return false;
+        }
+#endif
+
+        return __get_current_exception() == 0 && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+    }
+
+    bool inSRAM(const void *buffer, std::size_t length) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(buffer);
+
+        return address >= SRAM_BASE && address <= SRAM_END && length <= SRAM_END - address;
+    }
+
+    /**
+     * @brief Take a free slot
+     * @return Index of the slot, or -1 if every slot is busy
+     */
+    int32_t acquireSlot() {
+        for (uint32_t index = 0; index < gSlotCount; index++) {
+            bool expected = false;
+
+            if (gSlots[index].busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return static_cast<int32_t>(index);
+            }
+        }
+
+        return -1;
+    }
+
+    /**
+     * @brief Move bytes on the CPU
+     * @param source Bytes to copy, or nullptr to fill with value
+     */
+    void move(uint8_t *destination, const uint8_t *source, uint8_t value, std::size_t length) {
+        if (source) {
+            memcpy(destination, source, length);
+        } else {
+            memset(destination, value, length);
+        }
+    }
+
+    /**
+     * @brief Start a copy or a fill, or run it on the CPU
+     * @param source Bytes to copy, or nullptr to fill with value
+     */
+    Transfer start(uint8_t *destination, const uint8_t *source, uint8_t value, std::size_t length) {
+        if (length < T76_IC_DMA_THRESHOLD) {
+            move(destination, source, value, length);
+            return {};
+        }
+
+        if (!gReady.load(std::memory_order_acquire) || !callerCanBlock() ||
+            !inSRAM(destination, length) || (source && !inSRAM(source, length))) {
+            gFallbacks.fetch_add(1, std::memory_order_relaxed);
+            move(destination, source, value, length);
+            return {};
+        }
+
+        const int32_t index = acquireSlot();
+
+        if (index < 0) {
+            gFallbacks.fetch_add(1, std::memory_order_relaxed);
+            gBusy.fetch_add(1, std::memory_order_relaxed);
+            move(destination, source, value, length);
+            return {};
+        }
+
+        // Widest unit for which the source lines up with the destination once the destination is aligned
+        const uintptr_t offset = source ? reinterpret_cast<uintptr_t>(destination) ^ reinterpret_cast<uintptr_t>(source) : 0;
+        const std::size_t unit = (offset & 3) == 0 ? 4 : ((offset & 1) == 0 ? 2 : 1);
+        const std::size_t head = (unit - (reinterpret_cast<uintptr_t>(destination) & (unit - 1))) & (unit - 1);
+        const std::size_t count = (length - head) / unit;
+        const std::size_t body = count * unit;
+
+        // The unaligned ends go on the CPU, outside the bytes the DMA writes
+        move(destination, source, value, head);
+        move(destination + head + body, source ? source + head + body : nullptr, value, length - head - body);
+
+        Slot &slot = gSlots[index];
+
+        slot.pattern = value * 0x01010101u;
+        slot.waiter = xTaskGetCurrentTaskHandle();
+        slot.done.store(false, std::memory_order_release);
+
+        dma_channel_config config = dma_channel_get_default_config(slot.channel);
+        channel_config_set_transfer_data_size(&config, unit == 4 ? DMA_SIZE_32 : (unit == 2 ? DMA_SIZE_16 : DMA_SIZE_8));
+        channel_config_set_read_increment(&config, source != nullptr);
+        channel_config_set_write_increment(&config, true);
+
+        dma_channel_configure(slot.channel, &config, destination + head, source ? static_cast<const void *>(source + head) : &slot.pattern, count, true);
+
+        gTransfers.fetch_add(1, std::memory_order_relaxed);
+        gBytes.fetch_add(body, std::memory_order_relaxed);
+
+        return {index};
+    }
+
+    /**
+     * @brief Completion interrupt, shared with any other user of DMA_IRQ_1
+     */
+    void completionHandler() {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+        for (uint32_t index = 0; index < gSlotCount; index++) {
+            Slot &slot = gSlots[index];
+
+            if (!dma_irqn_get_channel_status(irqIndex, slot.channel)) {
+                continue;
+            }
+
+            dma_irqn_acknowledge_channel(irqIndex, slot.channel);
+            slot.done.store(true, std::memory_order_release);
+            vTaskNotifyGiveIndexedFromISR(slot.waiter, T76_IC_DMA_NOTIFY_INDEX, &higherPriorityTaskWoken);
+        }
+
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+
+} // namespace
+
+
+bool T76::Core::DMA::init() {
+    if (gReady.load(std::memory_order_acquire)) {
+        return true;
+    }
+
+    while (gSlotCount < T76_IC_DMA_CHANNELS) {
+        const int channel = dma_claim_unused_channel(false);
+
+        if (channel < 0) {
+            break;
+        }
+
+        gSlots[gSlotCount].channel = channel;
+        dma_irqn_set_channel_enabled(irqIndex, channel, true);
+        gSlotCount++;
+    }
+
+    if (gSlotCount == 0) {
+        LOGW("DMA: no free DMA channel; copies and fills run on the CPU\n");
+        return false;
+    }
+
+    irq_add_shared_handler(irqNumber, completionHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(irqNumber, true);
+
+    gReady.store(true, std::memory_order_release);
+    return true;
+}
+
+Transfer T76::Core::DMA::startCopy(void *destination, const void *source, std::size_t length) {
+    return start(static_cast<uint8_t *>(destination), static_cast<const uint8_t *>(source), 0, length);
+}
+
+Transfer T76::Core::DMA::startFill(void *destination, uint8_t value, std::size_t length) {
+    return start(static_cast<uint8_t *>(destination), nullptr, value, length);
+}
+
+bool T76::Core::DMA::wait(Transfer &transfer, uint32_t timeoutMs) {
+    if (transfer.slot < 0) {
+        return true;
+    }
+
+    Slot &slot = gSlots[transfer.slot];
+    const TickType_t timeout = timeoutMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+    const TickType_t startTick = xTaskGetTickCount();
+
+    // A notification may be left over from a transfer that completed after its wait() timed out
+    while (!slot.done.load(std::memory_order_acquire)) {
+        TickType_t remaining = portMAX_DELAY;
+
+        if (timeout != portMAX_DELAY) {
+            const TickType_t elapsed = xTaskGetTickCount() - startTick;
+
+            if (elapsed >= timeout) {
+                return false;
+            }
+
+            remaining = timeout - elapsed;
+        }
+
+        ulTaskNotifyTakeIndexed(T76_IC_DMA_NOTIFY_INDEX, pdTRUE, remaining);
+    }
+
+    slot.busy.store(false, std::memory_order_release);
+    transfer.slot = -1;
+    return true;
+}
+
+void T76::Core::DMA::copy(void *destination, const void *source, std::size_t length) {
+    Transfer transfer = startCopy(destination, source, length);
+
+    wait(transfer);
+}
+
+void T76::Core::DMA::fill(void *destination, uint8_t value, std::size_t length) {
+    Transfer transfer = startFill(destination, value, length);
+
+    wait(transfer);
+}
+
+Stats T76::Core::DMA::stats() {
+    return {
+        gSlotCount,
+        gTransfers.load(std::memory_order_relaxed),
+        gBytes.load(std::memory_order_relaxed),
+        gFallbacks.load(std::memory_order_relaxed),
+        gBusy.load(std::memory_order_relaxed),
+    };
+}
+
+void T76::Core::DMA::resetStats() {
+    gTransfers.store(0, std::memory_order_relaxed);
+    gBytes.store(0, std::memory_order_relaxed);
+    gFallbacks.store(0, std::memory_order_relaxed);
+    gBusy.store(0, std::memory_order_relaxed);
+}
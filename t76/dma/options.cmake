@@ -0,0 +1,6 @@
+# Configurable options for the DMA copy and fill service
+
+option(T76_IC_DMA_OFFLOAD "Move the large copies and fills of realloc(), calloc(), USBTMC responses and SCPI arbitrary blocks with DMA" OFF)
+set(T76_IC_DMA_CHANNELS 2 CACHE STRING "Number of DMA channels the copy and fill service claims at startup")
+set(T76_IC_DMA_THRESHOLD 1024 CACHE STRING "Smallest copy or fill moved by DMA rather than by the CPU (bytes, at least 8)")
+set(T76_IC_DMA_NOTIFY_INDEX 2 CACHE STRING "Task notification index that DMA completions wake the waiting task through; 0 belongs to stream buffers and 1 to the SCPI task")
@@ -0,0 +1,127 @@
+/**
+ * @file dma.hpp
+ * @brief Bulk copies and fills offloaded to spare DMA channels
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Copying or clearing a few kilobytes takes the CPU tens of microseconds, in
+ * which no other task on that core runs. The DMA service hands such moves to
+ * DMA channels that it claims at startup, and blocks the calling task on a
+ * task notification until the DMA completion interrupt wakes it, so that the
+ * core runs other tasks, such as the USB stack and the SCPI parser, while
+ * the bytes move:
+ *
+ *     T76::Core::DMA::copy(destination, source, length);
+ *
+ * Transfers can also be started and waited for separately, to overlap a
+ * move with other work of the same task:
+ *
+ *     T76::Core::DMA::Transfer transfer = T76::Core::DMA::startFill(buffer, 0, sizeof(buffer));
+ *
+ *     prepareHeader();
+ *     T76::Core::DMA::wait(transfer);
+ *
+ * Every transfer falls back to memcpy() or memset() on the calling core,
+ * which completes before start*() returns, when it is shorter than
+ * T76_IC_DMA_THRESHOLD bytes, when either buffer is outside SRAM (flash may
+ * be taken out of XIP mode under the DMA's feet), when the caller cannot
+ * block (an interrupt handler, before the scheduler starts, or core 1
+ * without T76_IC_SMP), or when every channel is busy. The functions can
+ * therefore be called from anywhere memcpy() can. The DMA moves words when
+ * the buffers allow it, and the CPU copies the unaligned ends.
+ *
+ * The completion wakes the task that started the transfer through its
+ * notification T76_IC_DMA_NOTIFY_INDEX, which must not be used by that task
+ * for anything else. With T76_IC_DMA_OFFLOAD, realloc(), calloc(), the
+ * USBTMC responses and the SCPI arbitrary blocks use the service for their
+ * large copies.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace T76::Core::DMA {
+
+    /**
+     * @brief Handle of a transfer started by startCopy() or startFill()
+     */
+    struct Transfer {
+        int32_t slot = -1;              ///< Index of the channel that runs the transfer, or -1 if it is complete
+    };
+
+    /**
+     * @brief Statistics of the service since boot or since resetStats()
+     */
+    struct Stats {
+        uint32_t channels;              ///< Channels claimed by init()
+        uint32_t transfers;             ///< Transfers run by DMA
+        uint32_t bytes;                 ///< Bytes moved by DMA, modulo 2^32
+        uint32_t fallbacks;             ///< Transfers above the threshold that ran on the CPU
+        uint32_t busy;                  ///< Of those, the ones that found every channel busy
+    };
+
+    /**
+     * @brief Claim the DMA channels and install the completion interrupt
+     * @return false if no channel could be claimed; every transfer then runs on the CPU
+     *
+     * Called by the app on core 0 during startup. Transfers requested before
+     * run on the CPU.
+     */
+    bool init();
+
+    /**
+     * @brief Start copying bytes
+     * @param destination Where to copy the bytes; must not overlap source
+     * @param source Bytes to copy
+     * @param length Number of bytes
+     * @return The transfer, to pass to wait()
+     *
+     * Neither buffer may be used until wait() returns.
+     */
+    Transfer startCopy(void *destination, const void *source, std::size_t length);
+
+    /**
+     * @brief Start setting bytes to a value
+     * @param destination Bytes to set
+     * @param value Value of every byte
+     * @param length Number of bytes
+     * @return The transfer, to pass to wait()
+     */
+    Transfer startFill(void *destination, uint8_t value, std::size_t length);
+
+    /**
+     * @brief Wait for a transfer to complete
+     * @param transfer The transfer; marked complete on success
+     * @param timeoutMs Longest wait, in milliseconds
+     * @return false if the transfer is still running after the timeout
+     *
+     * Must be called from the task that started the transfer, and called
+     * again after a timeout, as the transfer's channel is only released once
+     * wait() sees it complete.
+     */
+    bool wait(Transfer &transfer, uint32_t timeoutMs = UINT32_MAX);
+
+    /**
+     * @brief Copy bytes, like memcpy(), and return once they are copied
+     */
+    void copy(void *destination, const void *source, std::size_t length);
+
+    /**
+     * @brief Set bytes to a value, like memset(), and return once they are set
+     */
+    void fill(void *destination, uint8_t value, std::size_t length);
+
+    /**
+     * @brief Get the statistics of the service
+     */
+    Stats stats();
+
+    /**
+     * @brief Reset the counters of the service
+     */
+    void resetStats();
+
+} // namespace T76::Core::DMA
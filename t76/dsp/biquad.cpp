@@ -0,0 +1,101 @@
+/**
+ * @file biquad.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Design of biquad sections, after Robert Bristow-Johnson's Audio EQ
+ * Cookbook. Nothing here runs in a filter, so it stays in flash.
+ *
+ */
+
+#include "t76/dsp_biquad.hpp"
+
+#include <cmath>
+
+
+using namespace T76::Core::DSP;
+
+
+namespace {
+
+    /**
+     * @brief Cosine of the angular frequency, and the cookbook's alpha
+     */
+    struct Prewarp {
+        float cosine;
+        float alpha;
+    };
+
+    Prewarp prewarp(float sampleRateHz, float frequencyHz, float q) {
+        const float omega = 2.0f * static_cast<float>(M_PI) * frequencyHz / sampleRateHz;
+
+        return {std::cos(omega), std::sin(omega) / (2.0f * q)};
+    }
+
+    /**
+     * @brief Divide the coefficients by a0
+     */
+    BiquadCoefficients normalize(float b0, float b1, float b2, float a0, float a1, float a2) {
+        return {b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0};
+    }
+
+    /**
+     * @brief Round a coefficient to q15 after dividing it by 2^shift
+     * @return false if it does not fit
+     */
+    bool quantize(float coefficient, uint32_t shift, int32_t &value) {
+        value = static_cast<int32_t>(std::lround(std::ldexp(coefficient, 15 - static_cast<int>(shift))));
+        return value >= INT16_MIN && value <= INT16_MAX;
+    }
+
+} // namespace
+
+
+BiquadCoefficients T76::Core::DSP::lowPass(float sampleRateHz, float cornerHz, float q) {
+    const Prewarp p = prewarp(sampleRateHz, cornerHz, q);
+
+    return normalize((1.0f - p.cosine) / 2.0f, 1.0f - p.cosine, (1.0f - p.cosine) / 2.0f,
+                     1.0f + p.alpha, -2.0f * p.cosine, 1.0f - p.alpha);
+}
+
+BiquadCoefficients T76::Core::DSP::highPass(float sampleRateHz, float cornerHz, float q) {
+    const Prewarp p = prewarp(sampleRateHz, cornerHz, q);
+
+    return normalize((1.0f + p.cosine) / 2.0f, -(1.0f + p.cosine), (1.0f + p.cosine) / 2.0f,
+                     1.0f + p.alpha, -2.0f * p.cosine, 1.0f - p.alpha);
+}
+
+BiquadCoefficients T76::Core::DSP::bandPass(float sampleRateHz, float centerHz, float q) {
+    const Prewarp p = prewarp(sampleRateHz, centerHz, q);
+
+    return normalize(p.alpha, 0.0f, -p.alpha,
+                     1.0f + p.alpha, -2.0f * p.cosine, 1.0f - p.alpha);
+}
+
+BiquadCoefficients T76::Core::DSP::notch(float sampleRateHz, float centerHz, float q) {
+    const Prewarp p = prewarp(sampleRateHz, centerHz, q);
+
+    return normalize(1.0f, -2.0f * p.cosine, 1.0f,
+                     1.0f + p.alpha, -2.0f * p.cosine, 1.0f - p.alpha);
+}
+
+BiquadQ15Coefficients T76::Core::DSP::toQ15(const BiquadCoefficients &coefficients) {
+    BiquadQ15Coefficients result;
+
+    for (uint32_t shift = 0; shift <= 3; shift++) {
+        int32_t b0, b1, b2, a1, a2;
+
+        if (quantize(coefficients.b0, shift, b0) &&
+            quantize(coefficients.b1, shift, b1) &&
+            quantize(coefficients.b2, shift, b2) &&
+            quantize(-coefficients.a1, shift, a1) &&
+            quantize(-coefficients.a2, shift, a2)) {
+            result.b0 = b0;
+            result.b12 = SIMD::pack(b1, b2);
+            result.a12 = SIMD::pack(a1, a2);
+            result.shift = shift;
+            break;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file fir.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Design of FIR filters. Nothing here runs in a filter, so it stays in
+ * flash.
+ *
+ */
+
+#include "t76/dsp_fir.hpp"
+
+#include <cmath>
+
+
+void T76::Core::DSP::lowPassFIR(float *taps, std::size_t count, float sampleRateHz, float cornerHz) {
+    if (count == 0) {
+        return;
+    }
+
+    const float cutoff = cornerHz / sampleRateHz;
+    const float middle = (count - 1) / 2.0f;
+    float sum = 0.0f;
+
+    for (std::size_t index = 0; index < count; index++) {
+        const float t = index - middle;
+        const float sinc = t == 0.0f ? 2.0f * cutoff : std::sin(2.0f * static_cast<float>(M_PI) * cutoff * t) / (static_cast<float>(M_PI) * t);
+        const float window = count == 1 ? 1.0f : 0.54f - 0.46f * std::cos(2.0f * static_cast<float>(M_PI) * index / (count - 1));
+
+        taps[index] = sinc * window;
+        sum += taps[index];
+    }
+
+    for (std::size_t index = 0; index < count; index++) {
+        taps[index] /= sum;
+    }
+}
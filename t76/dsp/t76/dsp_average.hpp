@@ -0,0 +1,97 @@
+/**
+ * @file dsp_average.hpp
+ * @brief Moving average of integer samples
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The average keeps a running sum: every sample adds itself and subtracts
+ * the sample that leaves the window, so the cost does not depend on the
+ * length of the window. The sum is an integer, so it never drifts the way
+ * a floating-point running sum would; feed floats through a Biquad or FIR
+ * instead. Raw 12-bit conversions and q15 samples both fit, and a length
+ * that is a power of two turns the division into a shift:
+ *
+ *     static T76::Core::DSP::MovingAverage<16> gAverage;
+ *
+ *     const int16_t smoothed = gAverage.step(T76::Core::Acquisition::latest(0));
+ *
+ * The kernels are always inlined, so that they run from wherever their
+ * caller is placed.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace T76::Core::DSP {
+
+    /**
+     * @brief Moving average of the last Length samples
+     * @tparam Length Number of samples averaged; a power of two, at most 65536
+     *
+     * Until Length samples have been seen, the missing ones count as zero.
+     */
+    template<std::size_t Length>
+    class MovingAverage {
+        static_assert(Length > 0 && (Length & (Length - 1)) == 0 && Length <= 65536, "The length of a moving average must be a power of two up to 65536");
+
+    public:
+        using Sample = int16_t;
+
+        /**
+         * @brief Empty the window
+         */
+        void reset() {
+            for (int16_t &sample : _window) {
+                sample = 0;
+            }
+
+            _sum = 0;
+            _next = 0;
+        }
+
+        /**
+         * @brief Add a sample
+         * @return The mean of the window, rounded towards minus infinity
+         */
+        inline __attribute__((always_inline)) int16_t step(int16_t x) {
+            _sum += x - _window[_next];
+            _window[_next] = x;
+            _next = (_next + 1) & (Length - 1);
+
+            return static_cast<int16_t>(_sum >> _log2);
+        }
+
+        /**
+         * @brief Average a block of samples
+         * @param in Samples
+         * @param out Receives the mean after each sample; may be the same as in
+         * @param count Number of samples
+         * @return count
+         */
+        inline __attribute__((always_inline)) std::size_t process(const int16_t *in, int16_t *out, std::size_t count) {
+            for (std::size_t index = 0; index < count; index++) {
+                out[index] = step(in[index]);
+            }
+
+            return count;
+        }
+
+        /**
+         * @brief Sum of the window, for a mean with more resolution than step() returns
+         */
+        int32_t sum() const {
+            return _sum;
+        }
+
+    protected:
+        static constexpr uint32_t _log2 = __builtin_ctz(Length);
+
+        int16_t _window[Length] = {};
+        int32_t _sum = 0;
+        std::size_t _next = 0;
+    };
+
+} // namespace T76::Core::DSP
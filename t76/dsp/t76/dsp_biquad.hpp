@@ -0,0 +1,294 @@
+/**
+ * @file dsp_biquad.hpp
+ * @brief Cascades of second-order IIR sections, in float and q15
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Each section computes
+ *
+ *     y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ *
+ * and feeds the next. The coefficients come from the design functions below,
+ * which follow the Audio EQ Cookbook, and are set on core 0; the cascades
+ * then run on core 1, one sample at a time with step() in a control loop,
+ * or a block at a time with process():
+ *
+ *     static T76::Core::DSP::BiquadQ15<2> gFilter;
+ *
+ *     gFilter.configure(0, T76::Core::DSP::lowPass(250000.0f, 5000.0f));
+ *     gFilter.configure(1, T76::Core::DSP::lowPass(250000.0f, 5000.0f));
+ *
+ *     const int16_t filtered = gFilter.step(sample);
+ *
+ * Biquad runs in single precision, in transposed direct form II, which
+ * needs five multiply-adds and two state variables per section. process()
+ * runs the block through one section at a time, so that the section's
+ * coefficients and state stay in FPU registers for the whole block.
+ *
+ * BiquadQ15 runs in direct form I on q15 samples, with q15 coefficients
+ * scaled down by a power of two when any of them is 1 or more. The two
+ * previous inputs and the two previous outputs are each kept packed in a
+ * word, so that a section is one multiply and two SMLADs. As in CMSIS-DSP's
+ * fast q15 biquad, the 32-bit accumulator only has about one bit of headroom
+ * above a full-scale output, so use Biquad for filters with gain above 1.
+ *
+ * Configuring a section is not synchronized with step() or process(); do it
+ * before the filter runs, or publish whole filters through SharedParams.
+ * The kernels are always inlined, so that they run from wherever their
+ * caller is placed.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <t76/dsp_simd.hpp>
+
+
+namespace T76::Core::DSP {
+
+    /**
+     * @brief Coefficients of a section, normalized so that a0 is 1
+     */
+    struct BiquadCoefficients {
+        float b0 = 1.0f;
+        float b1 = 0.0f;
+        float b2 = 0.0f;
+        float a1 = 0.0f;
+        float a2 = 0.0f;
+    };
+
+    /**
+     * @brief Second-order low-pass section
+     * @param sampleRateHz Rate of the samples
+     * @param cornerHz -3 dB frequency when q is 1/sqrt(2); below half the sample rate
+     * @param q Quality factor; 1/sqrt(2) gives a Butterworth response
+     */
+    BiquadCoefficients lowPass(float sampleRateHz, float cornerHz, float q = 0.70710678f);
+
+    /**
+     * @brief Second-order high-pass section; the parameters are those of lowPass()
+     */
+    BiquadCoefficients highPass(float sampleRateHz, float cornerHz, float q = 0.70710678f);
+
+    /**
+     * @brief Band-pass section with a gain of 1 at the center frequency
+     * @param sampleRateHz Rate of the samples
+     * @param centerHz Center frequency
+     * @param q Center frequency divided by the -3 dB bandwidth
+     */
+    BiquadCoefficients bandPass(float sampleRateHz, float centerHz, float q);
+
+    /**
+     * @brief Notch section, for instance to remove mains pickup
+     * @param sampleRateHz Rate of the samples
+     * @param centerHz Frequency removed
+     * @param q Center frequency divided by the width of the notch
+     */
+    BiquadCoefficients notch(float sampleRateHz, float centerHz, float q);
+
+    /**
+     * @brief Single-precision cascade of biquad sections
+     * @tparam Sections Number of sections; each starts as a pass-through
+     */
+    template<std::size_t Sections>
+    class Biquad {
+    public:
+        using Sample = float;
+
+        /**
+         * @brief Set the coefficients of a section
+         * @param section Index of the section, from 0
+         */
+        void configure(std::size_t section, const BiquadCoefficients &coefficients) {
+            _coefficients[section] = coefficients;
+        }
+
+        /**
+         * @brief Clear the state of all sections
+         */
+        void reset() {
+            for (State &state : _state) {
+                state = State();
+            }
+        }
+
+        /**
+         * @brief Filter one sample
+         */
+        inline __attribute__((always_inline)) float step(float x) {
+            for (std::size_t section = 0; section < Sections; section++) {
+                const BiquadCoefficients &c = _coefficients[section];
+                State &s = _state[section];
+
+                const float y = c.b0 * x + s.z1;
+
+                s.z1 = c.b1 * x - c.a1 * y + s.z2;
+                s.z2 = c.b2 * x - c.a2 * y;
+                x = y;
+            }
+
+            return x;
+        }
+
+        /**
+         * @brief Filter a block of samples
+         * @param in Samples
+         * @param out Receives the filtered samples; may be the same as in
+         * @param count Number of samples
+         * @return count
+         */
+        inline __attribute__((always_inline)) std::size_t process(const float *in, float *out, std::size_t count) {
+            for (std::size_t section = 0; section < Sections; section++) {
+                const float b0 = _coefficients[section].b0;
+                const float b1 = _coefficients[section].b1;
+                const float b2 = _coefficients[section].b2;
+                const float a1 = _coefficients[section].a1;
+                const float a2 = _coefficients[section].a2;
+                float z1 = _state[section].z1;
+                float z2 = _state[section].z2;
+
+                for (std::size_t index = 0; index < count; index++) {
+                    const float x = in[index];
+                    const float y = b0 * x + z1;
+
+                    z1 = b1 * x - a1 * y + z2;
+                    z2 = b2 * x - a2 * y;
+                    out[index] = y;
+                }
+
+                _state[section] = {z1, z2};
+                in = out;
+            }
+
+            return count;
+        }
+
+    protected:
+        struct State {
+            float z1 = 0.0f;
+            float z2 = 0.0f;
+        };
+
+        BiquadCoefficients _coefficients[Sections];
+        State _state[Sections];
+    };
+
+    /**
+     * @brief Coefficients of a q15 section
+     *
+     * Every coefficient is divided by 2^shift and stored in q15; the
+     * feedback coefficients are stored negated, so that the whole section is
+     * a sum of products.
+     */
+    struct BiquadQ15Coefficients {
+        int32_t b0 = 1 << 14;           ///< b0, alone
+        uint32_t b12 = 0;               ///< b1 and b2, packed
+        uint32_t a12 = 0;               ///< -a1 and -a2, packed
+        uint32_t shift = 1;             ///< Power of two by which the coefficients are scaled down
+    };
+
+    /**
+     * @brief Convert the coefficients of a section to q15
+     *
+     * Picks the smallest shift for which every coefficient fits, up to 3
+     * (coefficients below 8 in magnitude), which covers every section designed above;
+     * a section that does not fit is replaced by a pass-through.
+     */
+    BiquadQ15Coefficients toQ15(const BiquadCoefficients &coefficients);
+
+    /**
+     * @brief q15 cascade of biquad sections
+     * @tparam Sections Number of sections; each starts as a pass-through
+     */
+    template<std::size_t Sections>
+    class BiquadQ15 {
+    public:
+        using Sample = int16_t;
+
+        /**
+         * @brief Set the coefficients of a section
+         * @param section Index of the section, from 0
+         */
+        void configure(std::size_t section, const BiquadCoefficients &coefficients) {
+            _coefficients[section] = toQ15(coefficients);
+        }
+
+        /**
+         * @brief Clear the state of all sections
+         */
+        void reset() {
+            for (State &state : _state) {
+                state = State();
+            }
+        }
+
+        /**
+         * @brief Filter one sample
+         */
+        inline __attribute__((always_inline)) int16_t step(int16_t x) {
+            for (std::size_t section = 0; section < Sections; section++) {
+                const BiquadQ15Coefficients &c = _coefficients[section];
+                State &s = _state[section];
+
+                const int16_t y = _section(c, x, s.x, s.y);
+
+                s.x = SIMD::pack(x, s.x);
+                s.y = SIMD::pack(y, s.y);
+                x = y;
+            }
+
+            return x;
+        }
+
+        /**
+         * @brief Filter a block of samples
+         * @param in Samples
+         * @param out Receives the filtered samples; may be the same as in
+         * @param count Number of samples
+         * @return count
+         */
+        inline __attribute__((always_inline)) std::size_t process(const int16_t *in, int16_t *out, std::size_t count) {
+            for (std::size_t section = 0; section < Sections; section++) {
+                const BiquadQ15Coefficients c = _coefficients[section];
+                uint32_t xs = _state[section].x;
+                uint32_t ys = _state[section].y;
+
+                for (std::size_t index = 0; index < count; index++) {
+                    const int16_t x = in[index];
+                    const int16_t y = _section(c, x, xs, ys);
+
+                    xs = SIMD::pack(x, xs);
+                    ys = SIMD::pack(y, ys);
+                    out[index] = y;
+                }
+
+                _state[section] = {xs, ys};
+                in = out;
+            }
+
+            return count;
+        }
+
+    protected:
+        struct State {
+            uint32_t x = 0;     ///< x[n-1] and x[n-2], packed
+            uint32_t y = 0;     ///< y[n-1] and y[n-2], packed
+        };
+
+        BiquadQ15Coefficients _coefficients[Sections];
+        State _state[Sections];
+
+        static inline __attribute__((always_inline)) int16_t _section(const BiquadQ15Coefficients &c, int16_t x, uint32_t xs, uint32_t ys) {
+            // q30 sum of products, rounded back to q15 and scaled back up by the coefficients' shift
+            int32_t accumulator = c.b0 * x + (1 << (14 - c.shift));
+
+            accumulator = SIMD::smlad(c.b12, xs, accumulator);
+            accumulator = SIMD::smlad(c.a12, ys, accumulator);
+
+            return SIMD::saturate(accumulator >> (15 - c.shift));
+        }
+    };
+
+} // namespace T76::Core::DSP
@@ -0,0 +1,308 @@
+/**
+ * @file dsp_fir.hpp
+ * @brief FIR filters and FIR decimators, in float and q15
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The delay line is stored twice, back to back, and every sample is written
+ * to both copies, so that the newest Taps samples are always contiguous and
+ * the output is a plain dot product without wrapping:
+ *
+ *     static T76::Core::DSP::FIRQ15<32> gFilter;
+ *     float taps[32];
+ *
+ *     T76::Core::DSP::lowPassFIR(taps, 32, 250000.0f, 10000.0f);
+ *     gFilter.configure(taps);
+ *
+ *     const int16_t filtered = gFilter.step(sample);
+ *
+ * FIR accumulates in single precision, four products at a time in separate
+ * registers, so that consecutive multiply-adds do not wait for each other.
+ * FIRQ15 multiplies two taps by two samples per SMLALD, into a 64-bit
+ * accumulator that cannot overflow, and needs an even number of taps; pad
+ * with a zero tap if need be.
+ *
+ * Decimator runs either filter at the output rate: every input is only
+ * written to the delay line, and the dot product is computed once per
+ * Factor inputs, which makes a FIR decimator about Factor times cheaper than
+ * filtering every sample and discarding most of them.
+ *
+ * As with the biquads, configure() is not synchronized with the filter, and
+ * the kernels are always inlined.
+ *
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <t76/dsp_simd.hpp>
+
+
+namespace T76::Core::DSP {
+
+    /**
+     * @brief Design a windowed-sinc low-pass filter
+     * @param taps Receives the taps, scaled for a gain of 1 at DC
+     * @param count Number of taps
+     * @param sampleRateHz Rate of the samples
+     * @param cornerHz -6 dB frequency; below half the sample rate
+     *
+     * Uses a Hamming window, for about 53 dB of stop-band attenuation.
+     * Before a decimator, place the corner below half the output rate.
+     */
+    void lowPassFIR(float *taps, std::size_t count, float sampleRateHz, float cornerHz);
+
+    /**
+     * @brief Single-precision FIR filter
+     * @tparam Taps Number of taps
+     */
+    template<std::size_t Taps>
+    class FIR {
+    public:
+        using Sample = float;
+
+        /**
+         * @brief Set the taps
+         * @param taps Taps applied to the newest sample first
+         */
+        void configure(const float *taps) {
+            for (std::size_t index = 0; index < Taps; index++) {
+                _taps[index] = taps[index];
+            }
+        }
+
+        /**
+         * @brief Clear the delay line
+         */
+        void reset() {
+            for (float &sample : _delay) {
+                sample = 0.0f;
+            }
+        }
+
+        /**
+         * @brief Add a sample to the delay line without computing an output
+         */
+        inline __attribute__((always_inline)) void push(float x) {
+            _newest = _newest == 0 ? Taps - 1 : _newest - 1;
+            _delay[_newest] = x;
+            _delay[_newest + Taps] = x;
+        }
+
+        /**
+         * @brief Compute the output for the samples in the delay line
+         */
+        inline __attribute__((always_inline)) float compute() const {
+            const float *window = _delay + _newest;
+            float sums[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            std::size_t index = 0;
+
+            for (; index + 4 <= Taps; index += 4) {
+                sums[0] += _taps[index] * window[index];
+                sums[1] += _taps[index + 1] * window[index + 1];
+                sums[2] += _taps[index + 2] * window[index + 2];
+                sums[3] += _taps[index + 3] * window[index + 3];
+            }
+
+            for (; index < Taps; index++) {
+                sums[0] += _taps[index] * window[index];
+            }
+
+            return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+        }
+
+        /**
+         * @brief Filter one sample
+         */
+        inline __attribute__((always_inline)) float step(float x) {
+            push(x);
+            return compute();
+        }
+
+        /**
+         * @brief Filter a block of samples
+         * @param in Samples
+         * @param out Receives the filtered samples; may be the same as in
+         * @param count Number of samples
+         * @return count
+         */
+        inline __attribute__((always_inline)) std::size_t process(const float *in, float *out, std::size_t count) {
+            for (std::size_t index = 0; index < count; index++) {
+                out[index] = step(in[index]);
+            }
+
+            return count;
+        }
+
+    protected:
+        float _taps[Taps] = {};
+        float _delay[2 * Taps] = {};
+        std::size_t _newest = 0;
+    };
+
+    /**
+     * @brief q15 FIR filter
+     * @tparam Taps Number of taps; must be even
+     */
+    template<std::size_t Taps>
+    class FIRQ15 {
+        static_assert(Taps % 2 == 0, "FIRQ15 takes taps in pairs; pad with a zero tap");
+
+    public:
+        using Sample = int16_t;
+
+        /**
+         * @brief Set the taps
+         * @param taps Taps applied to the newest sample first, each in [-1, 1); larger ones are saturated
+         */
+        void configure(const float *taps) {
+            for (std::size_t index = 0; index < Taps; index++) {
+                _taps[index] = SIMD::saturate(static_cast<int32_t>(std::lround(taps[index] * 32768.0f)));
+            }
+        }
+
+        /**
+         * @brief Set the taps from q15 values
+         */
+        void configure(const int16_t *taps) {
+            for (std::size_t index = 0; index < Taps; index++) {
+                _taps[index] = taps[index];
+            }
+        }
+
+        /**
+         * @brief Clear the delay line
+         */
+        void reset() {
+            for (int16_t &sample : _delay) {
+                sample = 0;
+            }
+        }
+
+        /**
+         * @brief Add a sample to the delay line without computing an output
+         */
+        inline __attribute__((always_inline)) void push(int16_t x) {
+            _newest = _newest == 0 ? Taps - 1 : _newest - 1;
+            _delay[_newest] = x;
+            _delay[_newest + Taps] = x;
+        }
+
+        /**
+         * @brief Compute the output for the samples in the delay line
+         */
+        inline __attribute__((always_inline)) int16_t compute() const {
+            // The window starts on an odd sample half of the time, which the M33 loads unaligned
+            const int16_t *window = _delay + _newest;
+            int64_t accumulator = 1 << 14;
+
+            for (std::size_t index = 0; index < Taps; index += 2) {
+                accumulator = SIMD::smlald(SIMD::load2(_taps + index), SIMD::load2(window + index), accumulator);
+            }
+
+            const int64_t y = accumulator >> 15;
+
+            return static_cast<int16_t>(y > INT16_MAX ? INT16_MAX : (y < INT16_MIN ? INT16_MIN : y));
+        }
+
+        /**
+         * @brief Filter one sample
+         */
+        inline __attribute__((always_inline)) int16_t step(int16_t x) {
+            push(x);
+            return compute();
+        }
+
+        /**
+         * @brief Filter a block of samples
+         * @param in Samples
+         * @param out Receives the filtered samples; may be the same as in
+         * @param count Number of samples
+         * @return count
+         */
+        inline __attribute__((always_inline)) std::size_t process(const int16_t *in, int16_t *out, std::size_t count) {
+            for (std::size_t index = 0; index < count; index++) {
+                out[index] = step(in[index]);
+            }
+
+            return count;
+        }
+
+    protected:
+        int16_t _taps[Taps] = {};
+        int16_t _delay[2 * Taps] = {};
+        std::size_t _newest = 0;
+    };
+
+    /**
+     * @brief FIR filter that keeps one output in Factor
+     * @tparam Filter FIR or FIRQ15
+     * @tparam Factor Inputs per output
+     */
+    template<typename Filter, uint32_t Factor>
+    class Decimator {
+        static_assert(Factor > 0, "A decimator keeps at least one output in Factor");
+
+    public:
+        using Sample = typename Filter::Sample;
+
+        /**
+         * @brief The filter, to configure() or reset()
+         */
+        Filter &filter() {
+            return _filter;
+        }
+
+        /**
+         * @brief Restart with an empty delay line, so that the next output comes after Factor inputs
+         */
+        void reset() {
+            _filter.reset();
+            _phase = 0;
+        }
+
+        /**
+         * @brief Take one sample
+         * @param x The sample
+         * @param out Receives the output, if there is one
+         * @return true if out was set
+         */
+        inline __attribute__((always_inline)) bool step(Sample x, Sample &out) {
+            _filter.push(x);
+
+            if (++_phase < Factor) {
+                return false;
+            }
+
+            _phase = 0;
+            out = _filter.compute();
+            return true;
+        }
+
+        /**
+         * @brief Decimate a block of samples
+         * @param in Samples
+         * @param out Receives the outputs; may be the same as in
+         * @param count Number of samples
+         * @return Number of outputs, about count / Factor depending on the inputs left over from the previous call
+         */
+        inline __attribute__((always_inline)) std::size_t process(const Sample *in, Sample *out, std::size_t count) {
+            std::size_t outputs = 0;
+
+            for (std::size_t index = 0; index < count; index++) {
+                if (step(in[index], out[outputs])) {
+                    outputs++;
+                }
+            }
+
+            return outputs;
+        }
+
+    protected:
+        Filter _filter;
+        uint32_t _phase = 0;
+    };
+
+} // namespace T76::Core::DSP
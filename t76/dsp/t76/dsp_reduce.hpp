@@ -0,0 +1,282 @@
+/**
+ * @file dsp_reduce.hpp
+ * @brief Block statistics and conversions between sample formats
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The reducers summarize a block of samples, such as the output of
+ * Acquisition::copy() or of a filter, into its mean, RMS value, minimum or
+ * maximum, for measurements that are reported once per block rather than
+ * once per sample:
+ *
+ *     int16_t samples[256];
+ *     int16_t minimum, maximum;
+ *
+ *     const std::size_t count = T76::Core::DSP::toQ15(conversions, samples, T76::Core::Acquisition::copy(0, conversions, 256));
+ *     const int16_t rms = T76::Core::DSP::rms(samples, count);
+ *
+ *     T76::Core::DSP::minMax(samples, count, minimum, maximum);
+ *
+ * The q15 versions take two samples per instruction: the mean adds pairs
+ * with SMLAD against a pair of ones, the RMS squares pairs with SMLALD, and
+ * minMax() compares pairs with SSUB16 and picks halves with SEL. The float
+ * versions keep four partial results in separate registers, so that
+ * consecutive operations on the FPU do not wait for each other.
+ *
+ * The kernels are always inlined, so that they run from wherever their
+ * caller is placed. Empty blocks give 0.
+ *
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <t76/dsp_simd.hpp>
+
+
+namespace T76::Core::DSP {
+
+    /**
+     * @brief Convert 12-bit conversions to q15 samples centered on mid-scale
+     * @param in Raw conversions, from 0 to 4095
+     * @param out Receives the samples, from -32768 to 32752; may be the same memory as in
+     * @param count Number of conversions
+     * @return count
+     *
+     * Conversions have four spare bits, so two of them are scaled with one
+     * shift of a word without either half spilling into the other.
+     */
+    inline __attribute__((always_inline)) std::size_t toQ15(const uint16_t *in, int16_t *out, std::size_t count) {
+        const int16_t *samples = reinterpret_cast<const int16_t *>(in);
+        std::size_t index = 0;
+
+        for (; index + 2 <= count; index += 2) {
+            SIMD::store2(out + index, (SIMD::load2(samples + index) << 4) ^ 0x80008000u);
+        }
+
+        if (index < count) {
+            out[index] = static_cast<int16_t>((in[index] << 4) ^ 0x8000u);
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Convert q15 samples to floats in [-1, 1)
+     * @return count
+     */
+    inline __attribute__((always_inline)) std::size_t toFloat(const int16_t *in, float *out, std::size_t count) {
+        for (std::size_t index = 0; index < count; index++) {
+            out[index] = in[index] * (1.0f / 32768.0f);
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Convert floats to q15 samples, saturating values outside [-1, 1)
+     * @return count
+     */
+    inline __attribute__((always_inline)) std::size_t toQ15(const float *in, int16_t *out, std::size_t count) {
+        for (std::size_t index = 0; index < count; index++) {
+            out[index] = SIMD::saturate(static_cast<int32_t>(std::lrintf(in[index] * 32768.0f)));
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Add two blocks of q15 samples, saturating each sum (QADD16)
+     * @param out Receives the sums; may be the same as either input
+     * @return count
+     */
+    inline __attribute__((always_inline)) std::size_t add(const int16_t *a, const int16_t *b, int16_t *out, std::size_t count) {
+        std::size_t index = 0;
+
+        for (; index + 2 <= count; index += 2) {
+            SIMD::store2(out + index, SIMD::qadd16(SIMD::load2(a + index), SIMD::load2(b + index)));
+        }
+
+        if (index < count) {
+            out[index] = SIMD::saturate(a[index] + b[index]);
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Subtract one block of q15 samples from another, saturating each difference (QSUB16)
+     * @param out Receives a - b; may be the same as either input
+     * @return count
+     */
+    inline __attribute__((always_inline)) std::size_t subtract(const int16_t *a, const int16_t *b, int16_t *out, std::size_t count) {
+        std::size_t index = 0;
+
+        for (; index + 2 <= count; index += 2) {
+            SIMD::store2(out + index, SIMD::qsub16(SIMD::load2(a + index), SIMD::load2(b + index)));
+        }
+
+        if (index < count) {
+            out[index] = SIMD::saturate(a[index] - b[index]);
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Mean of a block of q15 samples, rounded towards minus infinity
+     * @param count Number of samples, at most 65536
+     */
+    inline __attribute__((always_inline)) int16_t mean(const int16_t *samples, std::size_t count) {
+        int32_t sum = 0;
+        std::size_t index = 0;
+
+        for (; index + 2 <= count; index += 2) {
+            sum = SIMD::smlad(SIMD::load2(samples + index), 0x00010001u, sum);
+        }
+
+        if (index < count) {
+            sum += samples[index];
+        }
+
+        return count == 0 ? 0 : static_cast<int16_t>(sum >= 0 ? sum / static_cast<int32_t>(count) : -((-sum + static_cast<int32_t>(count) - 1) / static_cast<int32_t>(count)));
+    }
+
+    /**
+     * @brief Root mean square of a block of q15 samples
+     */
+    inline __attribute__((always_inline)) int16_t rms(const int16_t *samples, std::size_t count) {
+        int64_t squares = 0;
+        std::size_t index = 0;
+
+        for (; index + 2 <= count; index += 2) {
+            const uint32_t pair = SIMD::load2(samples + index);
+
+            squares = SIMD::smlald(pair, pair, squares);
+        }
+
+        if (index < count) {
+            squares += static_cast<int32_t>(samples[index]) * samples[index];
+        }
+
+        if (count == 0) {
+            return 0;
+        }
+
+        // The mean square is in q30, so its root is in q15; the FPU's square root is a single instruction
+        return SIMD::saturate(static_cast<int32_t>(std::sqrt(static_cast<float>(squares / static_cast<int64_t>(count)))));
+    }
+
+    /**
+     * @brief Smallest and largest of a block of q15 samples
+     * @param minimum Receives the smallest sample, or 0 for an empty block
+     * @param maximum Receives the largest sample, or 0 for an empty block
+     */
+    inline __attribute__((always_inline)) void minMax(const int16_t *samples, std::size_t count, int16_t &minimum, int16_t &maximum) {
+        if (count == 0) {
+            minimum = 0;
+            maximum = 0;
+            return;
+        }
+
+        uint32_t low = SIMD::pack(samples[0], samples[0]);
+        uint32_t high = low;
+        std::size_t index = 0;
+
+        for (; index + 2 <= count; index += 2) {
+            const uint32_t pair = SIMD::load2(samples + index);
+
+            low = SIMD::min16(low, pair);
+            high = SIMD::max16(high, pair);
+        }
+
+        if (index < count) {
+            const uint32_t pair = SIMD::pack(samples[index], samples[index]);
+
+            low = SIMD::min16(low, pair);
+            high = SIMD::max16(high, pair);
+        }
+
+        // Fold the halves
+        minimum = SIMD::low(low) < SIMD::high(low) ? SIMD::low(low) : SIMD::high(low);
+        maximum = SIMD::low(high) > SIMD::high(high) ? SIMD::low(high) : SIMD::high(high);
+    }
+
+    /**
+     * @brief Mean of a block of floats
+     */
+    inline __attribute__((always_inline)) float mean(const float *samples, std::size_t count) {
+        float sums[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        std::size_t index = 0;
+
+        for (; index + 4 <= count; index += 4) {
+            sums[0] += samples[index];
+            sums[1] += samples[index + 1];
+            sums[2] += samples[index + 2];
+            sums[3] += samples[index + 3];
+        }
+
+        for (; index < count; index++) {
+            sums[0] += samples[index];
+        }
+
+        return count == 0 ? 0.0f : ((sums[0] + sums[1]) + (sums[2] + sums[3])) / count;
+    }
+
+    /**
+     * @brief Root mean square of a block of floats
+     */
+    inline __attribute__((always_inline)) float rms(const float *samples, std::size_t count) {
+        float sums[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        std::size_t index = 0;
+
+        for (; index + 4 <= count; index += 4) {
+            sums[0] += samples[index] * samples[index];
+            sums[1] += samples[index + 1] * samples[index + 1];
+            sums[2] += samples[index + 2] * samples[index + 2];
+            sums[3] += samples[index + 3] * samples[index + 3];
+        }
+
+        for (; index < count; index++) {
+            sums[0] += samples[index] * samples[index];
+        }
+
+        return count == 0 ? 0.0f : std::sqrt(((sums[0] + sums[1]) + (sums[2] + sums[3])) / count);
+    }
+
+    /**
+     * @brief Smallest and largest of a block of floats
+     * @param minimum Receives the smallest sample, or 0 for an empty block
+     * @param maximum Receives the largest sample, or 0 for an empty block
+     */
+    inline __attribute__((always_inline)) void minMax(const float *samples, std::size_t count, float &minimum, float &maximum) {
+        if (count == 0) {
+            minimum = 0.0f;
+            maximum = 0.0f;
+            return;
+        }
+
+        // Two independent chains of VMINNM and VMAXNM
+        float lows[2] = {samples[0], samples[0]};
+        float highs[2] = {samples[0], samples[0]};
+        std::size_t index = 0;
+
+        for (; index + 2 <= count; index += 2) {
+            lows[0] = std::fmin(lows[0], samples[index]);
+            highs[0] = std::fmax(highs[0], samples[index]);
+            lows[1] = std::fmin(lows[1], samples[index + 1]);
+            highs[1] = std::fmax(highs[1], samples[index + 1]);
+        }
+
+        if (index < count) {
+            lows[0] = std::fmin(lows[0], samples[index]);
+            highs[0] = std::fmax(highs[0], samples[index]);
+        }
+
+        minimum = std::fmin(lows[0], lows[1]);
+        maximum = std::fmax(highs[0], highs[1]);
+    }
+
+} // namespace T76::Core::DSP
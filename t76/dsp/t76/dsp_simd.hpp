@@ -0,0 +1,140 @@
+/**
+ * @file dsp_simd.hpp
+ * @brief Packed 16-bit arithmetic of the Cortex-M33 DSP extension
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The q15 kernels handle two samples per instruction by packing them into a
+ * 32-bit word, the first sample in the low half. These wrappers use the
+ * ACLE intrinsics of the DSP extension, such as SMLAD (two multiplies and
+ * an accumulate) and QADD16 (two saturating adds), when the compiler targets
+ * it, as the SDK does for the RP2350's Arm cores, and plain C otherwise, so
+ * that the kernels also build for RISC-V and the host.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+#endif
+
+
+namespace T76::Core::DSP::SIMD {
+
+    /**
+     * @brief Load two consecutive samples; p need only be 2-byte aligned
+     */
+    inline __attribute__((always_inline)) uint32_t load2(const int16_t *p) {
+        uint32_t pair;
+
+        std::memcpy(&pair, p, sizeof(pair));
+        return pair;
+    }
+
+    /**
+     * @brief Store two samples packed by the other functions
+     */
+    inline __attribute__((always_inline)) void store2(int16_t *p, uint32_t pair) {
+        std::memcpy(p, &pair, sizeof(pair));
+    }
+
+    /**
+     * @brief Pack two samples, low first
+     */
+    inline __attribute__((always_inline)) uint32_t pack(int32_t low, int32_t high) {
+        return (static_cast<uint32_t>(low) & 0xffffu) | (static_cast<uint32_t>(high) << 16);
+    }
+
+    inline __attribute__((always_inline)) int16_t low(uint32_t pair) {
+        return static_cast<int16_t>(pair & 0xffffu);
+    }
+
+    inline __attribute__((always_inline)) int16_t high(uint32_t pair) {
+        return static_cast<int16_t>(pair >> 16);
+    }
+
+    /**
+     * @brief accumulator + low(x) * low(y) + high(x) * high(y) (SMLAD)
+     */
+    inline __attribute__((always_inline)) int32_t smlad(uint32_t x, uint32_t y, int32_t accumulator) {
+#if defined(__ARM_FEATURE_SIMD32)
+        return __smlad(static_cast<int16x2_t>(x), static_cast<int16x2_t>(y), accumulator);
+#else
+        return static_cast<int32_t>(static_cast<uint32_t>(accumulator)
+            + static_cast<uint32_t>(low(x) * low(y))
+            + static_cast<uint32_t>(high(x) * high(y)));
+#endif
+    }
+
+    /**
+     * @brief The same as smlad(), into a 64-bit accumulator that cannot overflow (SMLALD)
+     */
+    inline __attribute__((always_inline)) int64_t smlald(uint32_t x, uint32_t y, int64_t accumulator) {
+#if defined(__ARM_FEATURE_SIMD32)
+        return __smlald(static_cast<int16x2_t>(x), static_cast<int16x2_t>(y), accumulator);
+#else
+        return accumulator + static_cast<int32_t>(low(x)) * low(y) + static_cast<int32_t>(high(x)) * high(y);
+#endif
+    }
+
+    /**
+     * @brief Saturate to a 16-bit sample (SSAT)
+     */
+    inline __attribute__((always_inline)) int16_t saturate(int32_t value) {
+#if defined(__ARM_FEATURE_SAT)
+        return static_cast<int16_t>(__ssat(value, 16));
+#else
+        return static_cast<int16_t>(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+#endif
+    }
+
+    /**
+     * @brief Add two pairs of samples, saturating each sum (QADD16)
+     */
+    inline __attribute__((always_inline)) uint32_t qadd16(uint32_t x, uint32_t y) {
+#if defined(__ARM_FEATURE_SIMD32)
+        return static_cast<uint32_t>(__qadd16(static_cast<int16x2_t>(x), static_cast<int16x2_t>(y)));
+#else
+        return pack(saturate(low(x) + low(y)), saturate(high(x) + high(y)));
+#endif
+    }
+
+    /**
+     * @brief Subtract two pairs of samples, saturating each difference (QSUB16)
+     */
+    inline __attribute__((always_inline)) uint32_t qsub16(uint32_t x, uint32_t y) {
+#if defined(__ARM_FEATURE_SIMD32)
+        return static_cast<uint32_t>(__qsub16(static_cast<int16x2_t>(x), static_cast<int16x2_t>(y)));
+#else
+        return pack(saturate(low(x) - low(y)), saturate(high(x) - high(y)));
+#endif
+    }
+
+    /**
+     * @brief Smaller sample of each half (SSUB16, then SEL on the resulting flags)
+     */
+    inline __attribute__((always_inline)) uint32_t min16(uint32_t x, uint32_t y) {
+#if defined(__ARM_FEATURE_SIMD32)
+        __ssub16(static_cast<int16x2_t>(x), static_cast<int16x2_t>(y));
+        return static_cast<uint32_t>(__sel(static_cast<uint8x4_t>(y), static_cast<uint8x4_t>(x)));
+#else
+        return pack(low(x) < low(y) ? low(x) : low(y), high(x) < high(y) ? high(x) : high(y));
+#endif
+    }
+
+    /**
+     * @brief Larger sample of each half (SSUB16, then SEL on the resulting flags)
+     */
+    inline __attribute__((always_inline)) uint32_t max16(uint32_t x, uint32_t y) {
+#if defined(__ARM_FEATURE_SIMD32)
+        __ssub16(static_cast<int16x2_t>(x), static_cast<int16x2_t>(y));
+        return static_cast<uint32_t>(__sel(static_cast<uint8x4_t>(x), static_cast<uint8x4_t>(y)));
+#else
+        return pack(low(x) > low(y) ? low(x) : low(y), high(x) > high(y) ? high(x) : high(y));
+#endif
+    }
+
+} // namespace T76::Core::DSP::SIMD
@@ -0,0 +1,124 @@
+/**
+ * @file dsp_sink.hpp
+ * @brief Filtering of the acquisition stream on its way to the host
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * FilterSink sits between pumpStream() and another frame sink, and runs
+ * every committed frame through a filter in place before passing it on, so
+ * that the host receives filtered samples at no cost in copies:
+ *
+ *     static T76::Core::DSP::FilterSink<T76::Core::DSP::Decimator<T76::Core::DSP::FIRQ15<32>, 4>> gFilterSink(
+ *         T76::Core::Acquisition::winUSBStreamSink(_usbInterface));
+ *
+ *     float taps[32];
+ *
+ *     T76::Core::DSP::lowPassFIR(taps, 32, 500000.0f, 50000.0f);
+ *     gFilterSink.filter().filter().configure(taps);
+ *     T76::Core::Acquisition::startStream(gFilterSink.sink(), 1);
+ *
+ * The stream carries raw conversions, from 0 to 4095, which the filter
+ * treats as q15 samples of small amplitude; the gain of the filter is the
+ * same either way. Filters with q15 samples, such as BiquadQ15, FIRQ15,
+ * MovingAverage and decimators of FIRQ15, can be used.
+ *
+ * With several channels, each has a filter of its own. A decimator passes
+ * on fewer bytes than it receives, and so is only supported for a single
+ * channel; the stream's own decimation, which averages runs of rounds, works
+ * with any number. A frame that a decimator reduces to nothing is not passed
+ * on, and the stream fills the same frame again.
+ *
+ * The filters run in pumpStream(), from the context that calls it; do not
+ * configure them while the stream runs.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <t76/acquisition_stream.hpp>
+#include <t76/placement.hpp>
+
+
+namespace T76::Core::DSP {
+
+    /**
+     * @brief Frame sink that filters frames before passing them to another one
+     * @tparam Filter Filter with q15 samples and a process() method; for several channels, with a step() method that returns the output
+     * @tparam Channels Number of channels interleaved in the stream
+     */
+    template<typename Filter, std::size_t Channels = 1>
+    class FilterSink {
+        static_assert(Channels > 0, "A stream has at least one channel");
+
+    public:
+        /**
+         * @brief Constructor
+         * @param downstream Sink to which the filtered frames are passed
+         */
+        explicit FilterSink(const Acquisition::FrameSink &downstream) : _downstream(downstream) {
+        }
+
+        /**
+         * @brief The filter of a channel, to configure() or reset()
+         * @param channel Index of the channel in the stream, from 0
+         */
+        Filter &filter(std::size_t channel = 0) {
+            return _filters[channel];
+        }
+
+        /**
+         * @brief Reset the filters of all channels
+         */
+        void reset() {
+            for (Filter &filter : _filters) {
+                filter.reset();
+            }
+        }
+
+        /**
+         * @brief Make a frame sink to pass to startStream()
+         */
+        Acquisition::FrameSink sink() {
+            return {&FilterSink::_acquire, &FilterSink::_commit, this, _downstream.frameSize};
+        }
+
+    protected:
+        Acquisition::FrameSink _downstream;
+        Filter _filters[Channels];
+        int16_t *_frame = nullptr;
+
+        static uint8_t *_acquire(void *context) {
+            FilterSink *self = static_cast<FilterSink *>(context);
+            uint8_t *frame = self->_downstream.acquire(self->_downstream.context);
+
+            self->_frame = reinterpret_cast<int16_t *>(frame);
+            return frame;
+        }
+
+        static bool T76_CORE1_CODE _commit(void *context, std::size_t length) {
+            FilterSink *self = static_cast<FilterSink *>(context);
+            const std::size_t count = length / sizeof(int16_t);
+            std::size_t outputs = count;
+
+            if constexpr (Channels == 1) {
+                outputs = self->_filters[0].process(self->_frame, self->_frame, count);
+
+                if (outputs == 0) {
+                    return true;
+                }
+            } else {
+                // Frames hold whole rounds, so every round starts on channel 0
+                for (std::size_t index = 0; index < count; index += Channels) {
+                    for (std::size_t channel = 0; channel < Channels; channel++) {
+                        self->_frame[index + channel] = self->_filters[channel].step(self->_frame[index + channel]);
+                    }
+                }
+            }
+
+            return self->_downstream.commit(self->_downstream.context, outputs * sizeof(int16_t));
+        }
+    };
+
+} // namespace T76::Core::DSP
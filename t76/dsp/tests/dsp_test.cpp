@@ -0,0 +1,565 @@
+/**
+ * @file dsp_test.cpp
+ * @brief Test of the DSP kernels against plain reference implementations.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * On the host, the q15 kernels use the plain C versions of the SIMD
+ * wrappers, which compute the same results as the DSP extension's
+ * instructions. Integer kernels must match their references exactly;
+ * floating-point kernels, which reorder their sums, must match within a
+ * small tolerance.
+ *
+ */
+
+#include <t76/dsp_average.hpp>
+#include <t76/dsp_biquad.hpp>
+#include <t76/dsp_fir.hpp>
+#include <t76/dsp_reduce.hpp>
+#include <t76/dsp_sink.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace T76::Core::DSP;
+
+namespace {
+
+    constexpr std::size_t blockSize = 1001; // Odd, so that the kernels that take pairs also handle a last sample alone
+
+    void check(const char *name, bool passed, const std::string &detail = "") {
+        if (passed) {
+            std::cout << "✓ " << name << std::endl;
+        } else {
+            std::cout << "✗ " << name << (detail.empty() ? "" : " (" + detail + ")") << std::endl;
+        }
+    }
+
+    std::vector<int16_t> randomQ15(std::size_t count, int16_t amplitude, uint32_t seed) {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<int> distribution(-amplitude, amplitude);
+        std::vector<int16_t> samples(count);
+
+        for (int16_t &sample : samples) {
+            sample = static_cast<int16_t>(distribution(generator));
+        }
+
+        return samples;
+    }
+
+    std::vector<float> randomFloat(std::size_t count, uint32_t seed) {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        std::vector<float> samples(count);
+
+        for (float &sample : samples) {
+            sample = distribution(generator);
+        }
+
+        return samples;
+    }
+
+    int16_t saturate(int64_t value) {
+        return static_cast<int16_t>(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+    }
+
+    /**
+     * @brief Direct form I cascade in double precision
+     */
+    std::vector<double> referenceBiquad(const std::vector<BiquadCoefficients> &sections, const std::vector<double> &in) {
+        std::vector<double> signal = in;
+
+        for (const BiquadCoefficients &c : sections) {
+            double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+            for (double &sample : signal) {
+                const double y = c.b0 * sample + c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - c.a2 * y2;
+
+                x2 = x1;
+                x1 = sample;
+                y2 = y1;
+                y1 = y;
+                sample = y;
+            }
+        }
+
+        return signal;
+    }
+
+    /**
+     * @brief Amplitude of a section's steady-state response to a sine
+     */
+    double sineGain(const BiquadCoefficients &coefficients, float sampleRateHz, float frequencyHz) {
+        Biquad<1> filter;
+        double sumSquares = 0;
+        const int settle = 20000;
+        const int measure = static_cast<int>(sampleRateHz); // A whole number of periods of any whole frequency
+
+        filter.configure(0, coefficients);
+
+        for (int index = 0; index < settle + measure; index++) {
+            const float y = filter.step(static_cast<float>(std::sin(2 * M_PI * frequencyHz * index / sampleRateHz)));
+
+            if (index >= settle) {
+                sumSquares += static_cast<double>(y) * y;
+            }
+        }
+
+        return std::sqrt(2 * sumSquares / measure);
+    }
+
+    /**
+     * @brief The coefficients that a q15 section actually applies
+     */
+    BiquadCoefficients dequantize(const BiquadQ15Coefficients &c) {
+        const auto value = [&c](int32_t q15) {
+            return std::ldexp(static_cast<float>(q15), static_cast<int>(c.shift) - 15);
+        };
+
+        return { value(c.b0), value(SIMD::low(c.b12)), value(SIMD::high(c.b12)), -value(SIMD::low(c.a12)), -value(SIMD::high(c.a12)) };
+    }
+
+    void testMovingAverage() {
+        MovingAverage<8> average;
+        const std::vector<int16_t> in = randomQ15(blockSize, 32767, 1);
+        bool exact = true;
+
+        for (std::size_t index = 0; index < in.size(); index++) {
+            int32_t sum = 0;
+
+            for (std::size_t back = 0; back < 8 && back <= index; back++) {
+                sum += in[index - back];
+            }
+
+            const int16_t expected = static_cast<int16_t>(std::floor(sum / 8.0));
+
+            exact = exact && average.step(in[index]) == expected && average.sum() == sum;
+        }
+
+        check("MovingAverage matches the floor of the window mean", exact);
+
+        std::vector<int16_t> out(in.size());
+
+        average.reset();
+        average.process(in.data(), out.data(), in.size());
+
+        MovingAverage<8> stepped;
+        bool same = true;
+
+        for (std::size_t index = 0; index < in.size(); index++) {
+            same = same && out[index] == stepped.step(in[index]);
+        }
+
+        check("MovingAverage process() matches step() after reset()", same);
+    }
+
+    void testBiquadDesign() {
+        const float rate = 48000.0f;
+
+        check("Low-pass passes DC", std::fabs(sineGain(lowPass(rate, 1000.0f), rate, 10.0f) - 1.0) < 0.01);
+        check("Low-pass is -3 dB at the corner", std::fabs(sineGain(lowPass(rate, 1000.0f), rate, 1000.0f) - M_SQRT1_2) < 0.01);
+        check("High-pass blocks low frequencies", sineGain(highPass(rate, 1000.0f), rate, 10.0f) < 0.001);
+        check("High-pass is -3 dB at the corner", std::fabs(sineGain(highPass(rate, 1000.0f), rate, 1000.0f) - M_SQRT1_2) < 0.01);
+        check("Band-pass has a gain of 1 at the center", std::fabs(sineGain(bandPass(rate, 1000.0f, 2.0f), rate, 1000.0f) - 1.0) < 0.01);
+        check("Notch removes the center frequency", sineGain(notch(rate, 50.0f, 5.0f), rate, 50.0f) < 0.01);
+    }
+
+    void testBiquad() {
+        const std::vector<BiquadCoefficients> sections = { lowPass(250000.0f, 5000.0f), bandPass(250000.0f, 20000.0f, 3.0f) };
+        const std::vector<float> in = randomFloat(blockSize, 2);
+        const std::vector<double> expected = referenceBiquad(sections, std::vector<double>(in.begin(), in.end()));
+
+        Biquad<2> stepped;
+        Biquad<2> blocks;
+        std::vector<float> out(in.size());
+        double error = 0;
+        bool same = true;
+
+        for (std::size_t section = 0; section < sections.size(); section++) {
+            stepped.configure(section, sections[section]);
+            blocks.configure(section, sections[section]);
+        }
+
+        // Uneven blocks, so that the state carries over between calls
+        blocks.process(in.data(), out.data(), 100);
+        blocks.process(in.data() + 100, out.data() + 100, in.size() - 100);
+
+        for (std::size_t index = 0; index < in.size(); index++) {
+            const float y = stepped.step(in[index]);
+
+            error = std::max(error, std::fabs(y - expected[index]));
+            same = same && std::fabs(y - out[index]) < 1e-6f;
+        }
+
+        check("Biquad matches a double-precision cascade", error < 1e-5, "error " + std::to_string(error));
+        check("Biquad process() matches step()", same);
+
+        stepped.reset();
+        check("Biquad reset() clears the state", stepped.step(0.0f) == 0.0f);
+    }
+
+    void testBiquadQ15() {
+        const BiquadCoefficients design = lowPass(250000.0f, 20000.0f);
+        const std::vector<BiquadCoefficients> sections = { dequantize(toQ15(design)), dequantize(toQ15(design)) };
+        const std::vector<int16_t> in = randomQ15(blockSize, 16384, 3);
+        std::vector<double> scaled(in.size());
+
+        for (std::size_t index = 0; index < in.size(); index++) {
+            scaled[index] = in[index];
+        }
+
+        const std::vector<double> expected = referenceBiquad(sections, scaled);
+
+        BiquadQ15<2> stepped;
+        BiquadQ15<2> blocks;
+        std::vector<int16_t> out(in.size());
+        double error = 0;
+        bool same = true;
+
+        for (std::size_t section = 0; section < sections.size(); section++) {
+            stepped.configure(section, design);
+            blocks.configure(section, design);
+        }
+
+        blocks.process(in.data(), out.data(), 101);
+        blocks.process(in.data() + 101, out.data() + 101, in.size() - 101);
+
+        for (std::size_t index = 0; index < in.size(); index++) {
+            const int16_t y = stepped.step(in[index]);
+
+            error = std::max(error, std::fabs(y - expected[index]));
+            same = same && y == out[index];
+        }
+
+        // The reference uses the quantized coefficients, so only the rounding of each output remains
+        check("BiquadQ15 stays within a few LSBs of a double-precision cascade", error <= 8, "error " + std::to_string(error) + " LSB");
+        check("BiquadQ15 process() matches step()", same);
+
+        check("toQ15() scales coefficients of 1 or more", toQ15(lowPass(250000.0f, 5000.0f)).shift == 1);
+        check("toQ15() leaves small coefficients unscaled", toQ15({0.5f, 0.25f, 0.125f, -0.5f, 0.25f}).shift == 0);
+
+        BiquadQ15<1> passThrough;
+        bool passes = true;
+
+        passThrough.configure(0, {10.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+
+        for (int16_t sample : in) {
+            passes = passes && passThrough.step(sample) == sample;
+        }
+
+        check("BiquadQ15 passes samples through a section that does not fit", passes);
+
+        BiquadQ15<1> saturating;
+        int16_t last = 0;
+
+        saturating.configure(0, {3.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+
+        for (int index = 0; index < 4; index++) {
+            last = saturating.step(30000);
+        }
+
+        check("BiquadQ15 saturates instead of wrapping", last == INT16_MAX, "got " + std::to_string(last));
+    }
+
+    void testFIR() {
+        float taps[7];
+
+        lowPassFIR(taps, 7, 48000.0f, 4000.0f);
+
+        float sum = 0;
+        bool symmetric = true;
+
+        for (std::size_t index = 0; index < 7; index++) {
+            sum += taps[index];
+            symmetric = symmetric && std::fabs(taps[index] - taps[6 - index]) < 1e-6f;
+        }
+
+        check("lowPassFIR() has a gain of 1 at DC", std::fabs(sum - 1.0f) < 1e-5f);
+        check("lowPassFIR() is symmetric", symmetric);
+
+        // Seven taps, so that the sums of four products leave a remainder
+        const std::vector<float> in = randomFloat(blockSize, 4);
+        FIR<7> stepped;
+        FIR<7> blocks;
+        std::vector<float> out(in.size());
+        double error = 0;
+        bool same = true;
+
+        stepped.configure(taps);
+        blocks.configure(taps);
+        blocks.process(in.data(), out.data(), 10);
+        blocks.process(in.data() + 10, out.data() + 10, in.size() - 10);
+
+        for (std::size_t index = 0; index < in.size(); index++) {
+            double expected = 0;
+
+            for (std::size_t tap = 0; tap < 7 && tap <= index; tap++) {
+                expected += static_cast<double>(taps[tap]) * in[index - tap];
+            }
+
+            const float y = stepped.step(in[index]);
+
+            error = std::max(error, std::fabs(y - expected));
+            same = same && std::fabs(y - out[index]) < 1e-6f;
+        }
+
+        check("FIR matches a direct convolution", error < 1e-5, "error " + std::to_string(error));
+        check("FIR process() matches step()", same);
+    }
+
+    void testFIRQ15() {
+        const int16_t taps[6] = { 1000, -2000, 32767, -32768, 12345, -7 };
+        const std::vector<int16_t> in = randomQ15(blockSize, 32767, 5);
+        FIRQ15<6> filter;
+        bool exact = true;
+
+        filter.configure(taps);
+
+        for (std::size_t index = 0; index < in.size(); index++) {
+            int64_t sum = 1 << 14;
+
+            for (std::size_t tap = 0; tap < 6 && tap <= index; tap++) {
+                sum += static_cast<int64_t>(taps[tap]) * in[index - tap];
+            }
+
+            exact = exact && filter.step(in[index]) == saturate(sum >> 15);
+        }
+
+        check("FIRQ15 matches a rounded and saturated convolution", exact);
+
+        const float floatTaps[2] = { 0.5f, 2.0f };
+        FIRQ15<2> clipped;
+
+        clipped.configure(floatTaps);
+        clipped.step(0);
+        // 2.0 becomes 32767, and (32767 * 32767 + 16384) >> 15 is 32766
+        check("FIRQ15 saturates taps of 1 or more", clipped.step(32767) == 16384 && clipped.step(0) == 32766);
+    }
+
+    void testDecimator() {
+        float taps[8];
+
+        lowPassFIR(taps, 8, 48000.0f, 4000.0f);
+
+        const std::vector<int16_t> in = randomQ15(blockSize, 16384, 6);
+        FIRQ15<8> reference;
+        Decimator<FIRQ15<8>, 4> decimator;
+        std::vector<int16_t> expected;
+        std::vector<int16_t> out(in.size());
+
+        reference.configure(taps);
+        decimator.filter().configure(taps);
+
+        for (std::size_t index = 0; index < in.size(); index++) {
+            const int16_t y = reference.step(in[index]);
+
+            if (index % 4 == 3) {
+                expected.push_back(y);
+            }
+        }
+
+        // Blocks that are not multiples of the factor carry their phase over to the next call
+        std::size_t outputs = decimator.process(in.data(), out.data(), 7);
+        outputs += decimator.process(in.data() + 7, out.data() + outputs, in.size() - 7);
+        out.resize(outputs);
+
+        check("Decimator keeps every Factor-th output of its filter", out == expected,
+              std::to_string(outputs) + " outputs, expected " + std::to_string(expected.size()));
+
+        int16_t sample = 0;
+
+        decimator.reset();
+        check("Decimator reset() restarts the phase",
+              !decimator.step(1, sample) && !decimator.step(1, sample) && !decimator.step(1, sample) && decimator.step(1, sample));
+    }
+
+    void testReduce() {
+        std::vector<uint16_t> conversions(blockSize);
+        std::vector<int16_t> samples(blockSize);
+        bool converted = true;
+
+        for (std::size_t index = 0; index < conversions.size(); index++) {
+            conversions[index] = static_cast<uint16_t>((index * 37) % 4096);
+        }
+
+        conversions[0] = 0;
+        conversions[1] = 4095;
+        toQ15(conversions.data(), samples.data(), conversions.size());
+
+        for (std::size_t index = 0; index < conversions.size(); index++) {
+            converted = converted && samples[index] == static_cast<int16_t>(conversions[index] * 16 - 32768);
+        }
+
+        check("toQ15() centers 12-bit conversions on mid-scale", converted);
+
+        const float floats[4] = { -1.5f, -1.0f, 0.5f, 1.0f };
+        int16_t fromFloat[4];
+        float roundTrip[4];
+
+        toQ15(floats, fromFloat, 4);
+        toFloat(fromFloat, roundTrip, 4);
+        check("toQ15() saturates floats outside [-1, 1)",
+              fromFloat[0] == INT16_MIN && fromFloat[1] == INT16_MIN && fromFloat[2] == 16384 && fromFloat[3] == INT16_MAX);
+        check("toFloat() scales q15 samples to [-1, 1)", roundTrip[0] == -1.0f && roundTrip[2] == 0.5f);
+
+        const std::vector<int16_t> a = randomQ15(blockSize, 32767, 7);
+        const std::vector<int16_t> b = randomQ15(blockSize, 32767, 8);
+        std::vector<int16_t> sums(blockSize);
+        std::vector<int16_t> differences(blockSize);
+        bool added = true;
+
+        add(a.data(), b.data(), sums.data(), blockSize);
+        subtract(a.data(), b.data(), differences.data(), blockSize);
+
+        for (std::size_t index = 0; index < blockSize; index++) {
+            added = added && sums[index] == saturate(a[index] + b[index]) && differences[index] == saturate(a[index] - b[index]);
+        }
+
+        check("add() and subtract() saturate each sample", added);
+
+        int64_t sum = 0;
+        int64_t squares = 0;
+        int16_t minimum = a[0];
+        int16_t maximum = a[0];
+
+        for (int16_t sample : a) {
+            sum += sample;
+            squares += static_cast<int32_t>(sample) * sample;
+            minimum = std::min(minimum, sample);
+            maximum = std::max(maximum, sample);
+        }
+
+        int16_t foundMinimum, foundMaximum;
+        const double expectedRms = std::sqrt(static_cast<double>(squares) / blockSize);
+
+        minMax(a.data(), blockSize, foundMinimum, foundMaximum);
+        check("mean() of q15 samples rounds towards minus infinity",
+              mean(a.data(), blockSize) == static_cast<int16_t>(std::floor(static_cast<double>(sum) / blockSize)));
+        check("rms() of q15 samples", std::fabs(rms(a.data(), blockSize) - expectedRms) <= 1.0);
+        check("minMax() of q15 samples", foundMinimum == minimum && foundMaximum == maximum);
+
+        const int16_t negative[3] = { -3, -3, -4 };
+        check("mean() of negative samples rounds down", mean(negative, 3) == -4);
+
+        const std::vector<float> values = randomFloat(blockSize, 9);
+        double floatSum = 0;
+        double floatSquares = 0;
+        float floatMinimum = values[0];
+        float floatMaximum = values[0];
+        float foundFloatMinimum, foundFloatMaximum;
+
+        for (float value : values) {
+            floatSum += value;
+            floatSquares += static_cast<double>(value) * value;
+            floatMinimum = std::min(floatMinimum, value);
+            floatMaximum = std::max(floatMaximum, value);
+        }
+
+        minMax(values.data(), blockSize, foundFloatMinimum, foundFloatMaximum);
+        check("mean() of floats", std::fabs(mean(values.data(), blockSize) - floatSum / blockSize) < 1e-5);
+        check("rms() of floats", std::fabs(rms(values.data(), blockSize) - std::sqrt(floatSquares / blockSize)) < 1e-5);
+        check("minMax() of floats", foundFloatMinimum == floatMinimum && foundFloatMaximum == floatMaximum);
+
+        minMax(a.data(), 0, foundMinimum, foundMaximum);
+        minMax(values.data(), 0, foundFloatMinimum, foundFloatMaximum);
+        check("Empty blocks give 0",
+              mean(a.data(), 0) == 0 && rms(a.data(), 0) == 0 && foundMinimum == 0 && foundMaximum == 0 &&
+              mean(values.data(), 0) == 0.0f && rms(values.data(), 0) == 0.0f && foundFloatMinimum == 0.0f && foundFloatMaximum == 0.0f);
+    }
+
+    /**
+     * @brief Downstream frame sink that records what it is given
+     */
+    struct RecordingSink {
+        int16_t frame[64] = {};
+        std::size_t commits = 0;
+        std::size_t committedLength = 0;
+
+        static uint8_t *acquire(void *context) {
+            return reinterpret_cast<uint8_t *>(static_cast<RecordingSink *>(context)->frame);
+        }
+
+        static bool commit(void *context, std::size_t length) {
+            RecordingSink *self = static_cast<RecordingSink *>(context);
+
+            self->commits++;
+            self->committedLength = length;
+            return true;
+        }
+
+        T76::Core::Acquisition::FrameSink sink() {
+            return {&RecordingSink::acquire, &RecordingSink::commit, this, sizeof(frame)};
+        }
+    };
+
+    void testFilterSink() {
+        {
+            RecordingSink downstream;
+            FilterSink<MovingAverage<2>, 2> filterSink(downstream.sink());
+            T76::Core::Acquisition::FrameSink sink = filterSink.sink();
+            int16_t *frame = reinterpret_cast<int16_t *>(sink.acquire(sink.context));
+
+            // Channel 0 alternates between 0 and 100; channel 1 is constant
+            for (std::size_t index = 0; index < 8; index += 2) {
+                frame[index] = (index / 2) % 2 ? 100 : 0;
+                frame[index + 1] = 40;
+            }
+
+            sink.commit(sink.context, 8 * sizeof(int16_t));
+
+            check("FilterSink filters each channel on its own",
+                  downstream.frame[0] == 0 && downstream.frame[2] == 50 && downstream.frame[4] == 50 &&
+                  downstream.frame[1] == 20 && downstream.frame[3] == 40 && downstream.committedLength == 8 * sizeof(int16_t));
+        }
+
+        {
+            RecordingSink downstream;
+            FilterSink<Decimator<FIRQ15<2>, 4>> filterSink(downstream.sink());
+            T76::Core::Acquisition::FrameSink sink = filterSink.sink();
+            const int16_t taps[2] = { 16384, 16384 };
+
+            filterSink.filter().filter().configure(taps);
+
+            int16_t *frame = reinterpret_cast<int16_t *>(sink.acquire(sink.context));
+
+            for (std::size_t index = 0; index < 3; index++) {
+                frame[index] = 1000;
+            }
+
+            sink.commit(sink.context, 3 * sizeof(int16_t));
+            check("FilterSink does not pass on a frame decimated to nothing", downstream.commits == 0);
+
+            frame = reinterpret_cast<int16_t *>(sink.acquire(sink.context));
+
+            for (std::size_t index = 0; index < 8; index++) {
+                frame[index] = 1000;
+            }
+
+            sink.commit(sink.context, 8 * sizeof(int16_t));
+            check("FilterSink passes on the decimated samples",
+                  downstream.commits == 1 && downstream.committedLength == 2 * sizeof(int16_t) &&
+                  downstream.frame[0] == 1000 && downstream.frame[1] == 1000);
+        }
+    }
+
+} // namespace
+
+int main() {
+    std::cout << "=== DSP Test ===" << std::endl;
+
+    testMovingAverage();
+    testBiquadDesign();
+    testBiquad();
+    testBiquadQ15();
+    testFIR();
+    testFIRQ15();
+    testDecimator();
+    testReduce();
+    testFilterSink();
+
+    std::cout << "\n=== DSP Test Complete ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,541 @@
+/**
+ * @file executive.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the core 1 executive.
+ *
+ * Job statistics are written only by core 1, from the tick interrupt or the
+ * main loop. Each job's statistics are guarded by a sequence counter that is
+ * odd while they are being written, so that jobStats() can take a consistent
+ * snapshot from core 0 by retrying, without the job ever waiting for it.
+ *
+ * The tick path runs from SRAM and its state lives in SCRATCH_X, so that
+ * flash stalls never delay a job. Rescheduling the timer alarm calls into
+ * the SDK in flash; applications that need the lowest jitter tick the
+ * executive from their own interrupt.
+ *
+ */
+
+#include "t76/executive.hpp"
+
+#include <atomic>
+
+#include <pico/stdlib.h>
+#include <hardware/clocks.h>
+#include <hardware/structs/m33.h>
+#include <hardware/sync.h>
+#include <hardware/timer.h>
+
+#include <t76/flash.hpp>
+#include <t76/flight_recorder.hpp>
+#include <t76/placement.hpp>
+#include <t76/safety.hpp>
+#include <t76/trace.hpp>
+
+
+using namespace T76::Core::Executive;
+
+
+namespace {
+
+    struct Job {
+        const char *name;
+        JobFunction function;
+        void *context;
+        uint32_t rateHz;
+        uint8_t priority;
+        JobContext where;
+        uint32_t budgetUs;
+
+        // Set by run()
+        uint32_t periodTicks;
+        uint32_t countdown;
+        uint32_t periodCycles;
+        uint32_t budgetCycles;
+
+        std::atomic<bool> pending;              ///< Background job released and not yet run
+        std::atomic<bool> resetRequested;       ///< Statistics to be cleared before the next run
+        std::atomic<uint32_t> sequence;         ///< Odd while the statistics are being written
+        std::atomic<uint32_t> overrunLimit;     ///< Consecutive overruns that trigger overrunAction, or 0
+        std::atomic<OverrunAction> overrunAction;
+
+        // Statistics, written by core 1 only
+        uint32_t runs;
+        uint32_t overruns;
+        uint32_t lastCycles;
+        uint32_t minCycles;
+        uint32_t maxCycles;
+        uint64_t totalCycles;
+        uint32_t maxJitterCycles;
+        uint32_t lastStart;
+        uint32_t consecutiveOverruns;
+        uint32_t maxConsecutiveOverruns;
+        uint32_t limitHits;
+        uint32_t jitterHistogram[T76_IC_EXECUTIVE_JITTER_BINS];
+    };
+
+    T76_CORE1_DATA Job gJobs[T76_IC_EXECUTIVE_MAX_JOBS];
+    T76_CORE1_DATA uint8_t gOrder[T76_IC_EXECUTIVE_MAX_JOBS];       // Job indices, by context and then by decreasing priority
+    T76_CORE1_DATA std::atomic<uint32_t> gJobCount{0};
+    T76_CORE1_DATA std::atomic<bool> gRunning{false};
+
+    T76_CORE1_DATA uint32_t gTickRateHz = 0;
+    T76_CORE1_DATA uint32_t gCyclesPerTick = 0;
+    T76_CORE1_DATA uint32_t gCyclesPerUs = 1;
+    T76_CORE1_DATA std::atomic<uint32_t> gTicks{0};
+    T76_CORE1_DATA std::atomic<uint32_t> gLateTicks{0};
+    T76_CORE1_DATA std::atomic<uint32_t> gMaxTickCycles{0};
+    T76_CORE1_DATA std::atomic<bool> gTickResetRequested{false};
+    T76_CORE1_DATA std::atomic<uint32_t> gTickCycles{0};           // Cycles spent in the tick since run(), wrapping
+    T76_CORE1_DATA std::atomic<uint32_t> gIdleCycles{0};           // Cycles spent asleep since run(), wrapping
+
+    // Timer tick; the period is kept as whole microseconds plus a fraction, so rates that do not divide 1 MHz stay exact
+    T76_CORE1_DATA int gAlarm = -1;
+    T76_CORE1_DATA uint64_t gNextTickUs = 0;
+    T76_CORE1_DATA uint32_t gTickPeriodUs = 0;
+    T76_CORE1_DATA uint32_t gTickPeriodRemainder = 0;
+    T76_CORE1_DATA uint32_t gTickFraction = 0;
+
+    inline __attribute__((always_inline)) uint32_t cycles() {
+        return m33_hw->dwt_cyccnt;
+    }
+
+    void enableCycleCounter() {
+        m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+        m33_hw->dwt_cyccnt = 0;
+        m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+    }
+
+    void clearStats(Job &job) {
+        job.runs = 0;
+        job.overruns = 0;
+        job.lastCycles = 0;
+        job.minCycles = UINT32_MAX;
+        job.maxCycles = 0;
+        job.totalCycles = 0;
+        job.maxJitterCycles = 0;
+        job.consecutiveOverruns = 0;
+        job.maxConsecutiveOverruns = 0;
+        job.limitHits = 0;
+
+        for (uint32_t &count : job.jitterHistogram) {
+            count = 0;
+        }
+    }
+
+    /**
+     * @brief Histogram bin of a jitter: bin 0 is under 1 µs, bin n from 2^(n-1) µs up to 2^n µs, the last open-ended
+     */
+    inline __attribute__((always_inline)) uint32_t jitterBin(uint32_t jitterCycles) {
+        const uint32_t us = jitterCycles / gCyclesPerUs;
+        const uint32_t bin = us == 0 ? 0 : 32 - __builtin_clz(us);
+
+        return bin < T76_IC_EXECUTIVE_JITTER_BINS ? bin : T76_IC_EXECUTIVE_JITTER_BINS - 1;
+    }
+
+    /**
+     * @brief Count an overrun; called with the statistics being written
+     * @return true if the overrun completes a run of overrunLimit consecutive ones
+     */
+    bool T76_CORE1_CODE noteOverrun(Job &job) {
+        job.overruns++;
+        job.consecutiveOverruns++;
+
+        if (job.consecutiveOverruns > job.maxConsecutiveOverruns) {
+            job.maxConsecutiveOverruns = job.consecutiveOverruns;
+        }
+
+        const uint32_t limit = job.overrunLimit.load(std::memory_order_relaxed);
+
+        if (limit == 0 || job.consecutiveOverruns != limit) {
+            return false;
+        }
+
+        job.limitHits++;
+        return true;
+    }
+
+    /**
+     * @brief Act on a job that has reached its limit of consecutive overruns
+     */
+    void T76_CORE1_CODE overrunLimitReached(Job &job) {
+        T76::Core::Safety::FlightRecorder::record(T76::Core::Safety::FlightRecorder::EventId::DeadlineMissed,
+                                                  static_cast<uint32_t>(&job - gJobs), job.consecutiveOverruns);
+
+        if (job.overrunAction.load(std::memory_order_relaxed) == OverrunAction::Fault) {
+            T76::Core::Safety::reportFault(T76::Core::Safety::FaultType::DEADLINE_MISSED, job.name, __FILE__, __LINE__, __func__);
+        }
+    }
+
+    void T76_CORE1_CODE countOverrun(Job &job) {
+        T76::Core::Safety::FlightRecorder::record(T76::Core::Safety::FlightRecorder::EventId::ExecutiveOverrun, static_cast<uint32_t>(&job - gJobs));
+
+        job.sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        const bool limitReached = noteOverrun(job);
+        job.sequence.fetch_add(1, std::memory_order_release);
+
+        if (limitReached) {
+            overrunLimitReached(job);
+        }
+    }
+
+    void T76_CORE1_CODE runJob(Job &job) {
+        T76_TRACE_SPAN(job.name);
+
+        const uint32_t start = cycles();
+
+        job.function(job.context);
+
+        const uint32_t elapsed = cycles() - start;
+
+        job.sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        if (job.resetRequested.exchange(false, std::memory_order_relaxed)) {
+            clearStats(job);
+        }
+
+        // The first run after a reset has no previous start to measure the jitter against
+        if (job.runs > 0) {
+            const uint32_t interval = start - job.lastStart;
+            const uint32_t jitter = interval > job.periodCycles ? interval - job.periodCycles : job.periodCycles - interval;
+
+            if (jitter > job.maxJitterCycles) {
+                job.maxJitterCycles = jitter;
+            }
+
+            job.jitterHistogram[jitterBin(jitter)]++;
+        }
+
+        job.runs++;
+        job.lastStart = start;
+        job.lastCycles = elapsed;
+        job.totalCycles += elapsed;
+
+        if (elapsed < job.minCycles) {
+            job.minCycles = elapsed;
+        }
+
+        if (elapsed > job.maxCycles) {
+            job.maxCycles = elapsed;
+        }
+
+        bool limitReached = false;
+
+        if (elapsed > job.budgetCycles) {
+            limitReached = noteOverrun(job);
+            T76::Core::Safety::FlightRecorder::record(T76::Core::Safety::FlightRecorder::EventId::ExecutiveOverrun, static_cast<uint32_t>(&job - gJobs), elapsed);
+        } else {
+            job.consecutiveOverruns = 0;
+        }
+
+        job.sequence.fetch_add(1, std::memory_order_release);
+
+        if (limitReached) {
+            overrunLimitReached(job);
+        }
+    }
+
+    /**
+     * @brief Run the most important pending background job
+     * @return true if a job ran
+     */
+    bool T76_CORE1_CODE runBackgroundJob() {
+        const uint32_t count = gJobCount.load(std::memory_order_acquire);
+
+        for (uint32_t i = 0; i < count; i++) {
+            Job &job = gJobs[gOrder[i]];
+
+            if (job.where == JobContext::Background && job.pending.load(std::memory_order_acquire)) {
+                runJob(job);
+
+                // Cleared after the run, so that a release during the run counts as an overrun
+                job.pending.store(false, std::memory_order_release);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void scheduleNextTick() {
+        // A missed target means the tick ran for longer than its period, so the skipped ticks are dropped
+        while (true) {
+            gNextTickUs += gTickPeriodUs;
+            gTickFraction += gTickPeriodRemainder;
+
+            if (gTickFraction >= gTickRateHz) {
+                gTickFraction -= gTickRateHz;
+                gNextTickUs++;
+            }
+
+            if (!hardware_alarm_set_target(gAlarm, from_us_since_boot(gNextTickUs))) {
+                return;
+            }
+
+            gLateTicks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void T76_CORE1_CODE timerCallback(uint alarm) {
+        T76_TRACE_ISR_ENTER();
+
+        scheduleNextTick();
+        tick();
+
+        T76_TRACE_ISR_EXIT();
+    }
+
+} // namespace
+
+
+int T76::Core::Executive::addJob(const char *name, JobFunction function, void *context, uint32_t rateHz, uint8_t priority,
+                                 JobContext where, uint32_t budgetUs) {
+    const uint32_t index = gJobCount.load(std::memory_order_relaxed);
+
+    if (gRunning.load(std::memory_order_acquire) || function == nullptr || rateHz == 0 || index >= T76_IC_EXECUTIVE_MAX_JOBS) {
+        return -1;
+    }
+
+    Job &job = gJobs[index];
+
+    job.name = name;
+    job.function = function;
+    job.context = context;
+    job.rateHz = rateHz;
+    job.priority = priority;
+    job.where = where;
+    job.budgetUs = budgetUs;
+    job.overrunLimit.store(T76_IC_EXECUTIVE_OVERRUN_LIMIT, std::memory_order_relaxed);
+#ifdef T76_IC_EXECUTIVE_OVERRUN_FAULT
+    job.overrunAction.store(OverrunAction::Fault, std::memory_order_relaxed);
+#else
+    job.overrunAction.store(OverrunAction::Warn, std::memory_order_relaxed);
+#endif
+    clearStats(job);
+
+    // Insert into the run order: interrupt jobs first, then by decreasing priority, then by registration
+    uint32_t position = index;
+
+    while (position > 0) {
+        const Job &previous = gJobs[gOrder[position - 1]];
+        const bool before = (where == JobContext::Interrupt && previous.where == JobContext::Background) ||
+                            (where == previous.where && priority > previous.priority);
+
+        if (!before) {
+            break;
+        }
+
+        gOrder[position] = gOrder[position - 1];
+        position--;
+    }
+
+    gOrder[position] = static_cast<uint8_t>(index);
+    gJobCount.store(index + 1, std::memory_order_release);
+
+    return static_cast<int>(index);
+}
+
+void T76::Core::Executive::run(uint32_t tickRateHz, TickSource source) {
+    if (tickRateHz == 0) {
+        tickRateHz = 1;
+    }
+
+    enableCycleCounter();
+
+    const uint32_t systemHz = clock_get_hz(clk_sys);
+    const uint32_t count = gJobCount.load(std::memory_order_acquire);
+
+    gTickRateHz = tickRateHz;
+    gCyclesPerTick = systemHz / tickRateHz;
+    gCyclesPerUs = systemHz >= 1000000 ? systemHz / 1000000 : 1;
+
+    for (uint32_t i = 0; i < count; i++) {
+        Job &job = gJobs[i];
+
+        job.periodTicks = (tickRateHz + job.rateHz / 2) / job.rateHz;
+
+        if (job.periodTicks == 0) {
+            job.periodTicks = 1;
+        }
+
+        job.countdown = job.periodTicks;
+        job.periodCycles = gCyclesPerTick * job.periodTicks;
+        job.budgetCycles = job.budgetUs ? static_cast<uint32_t>(static_cast<uint64_t>(systemHz) * job.budgetUs / 1000000) : job.periodCycles;
+    }
+
+    gRunning.store(true, std::memory_order_release);
+
+    if (source == TickSource::Timer) {
+        // The SDK's alarm interrupt handler runs from flash, so core 1 must freeze during flash writes
+        T76::Core::Flash::setCore1KeepsRunning(false);
+
+        gAlarm = hardware_alarm_claim_unused(true);
+        gTickPeriodUs = 1000000 / tickRateHz;
+        gTickPeriodRemainder = 1000000 % tickRateHz;
+        gTickFraction = 0;
+        gNextTickUs = time_us_64();
+
+        // The alarm interrupt is enabled on this core, so ticks run on core 1
+        hardware_alarm_set_callback(gAlarm, timerCallback);
+        scheduleNextTick();
+    }
+
+    uint32_t lastFedTick = gTicks.load(std::memory_order_relaxed);
+
+    for (;;) {
+        const bool ranJob = runBackgroundJob();
+        const uint32_t ticks = gTicks.load(std::memory_order_relaxed);
+
+        // Only a loop that keeps up, driven by a tick that keeps running, keeps the watchdog happy
+        if (ticks != lastFedTick) {
+            T76::Core::Safety::feedWatchdogFromCore1();
+            lastFedTick = ticks;
+        }
+
+        if (!ranJob) {
+            // The tick that wakes the core runs before __wfe() returns, so its cycles are taken out of the sleep
+            const uint32_t sleepStart = cycles();
+            const uint32_t tickCyclesBefore = gTickCycles.load(std::memory_order_relaxed);
+
+            __wfe();
+
+            const uint32_t slept = cycles() - sleepStart;
+            const uint32_t ticked = gTickCycles.load(std::memory_order_relaxed) - tickCyclesBefore;
+
+            if (slept > ticked) {
+                gIdleCycles.store(gIdleCycles.load(std::memory_order_relaxed) + slept - ticked, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void T76_CORE1_CODE T76::Core::Executive::tick() {
+    if (!gRunning.load(std::memory_order_acquire)) {
+        return; // The job periods are only known once run() has been called
+    }
+
+    const uint32_t start = cycles();
+    const uint32_t count = gJobCount.load(std::memory_order_acquire);
+
+    for (uint32_t i = 0; i < count; i++) {
+        Job &job = gJobs[gOrder[i]];
+
+        if (--job.countdown != 0) {
+            continue;
+        }
+
+        job.countdown = job.periodTicks;
+
+        if (job.where == JobContext::Interrupt) {
+            runJob(job);
+        } else if (job.pending.exchange(true, std::memory_order_acq_rel)) {
+            countOverrun(job);
+        }
+    }
+
+    gTicks.fetch_add(1, std::memory_order_relaxed);
+
+    if (gTickResetRequested.exchange(false, std::memory_order_relaxed)) {
+        gMaxTickCycles.store(0, std::memory_order_relaxed);
+    }
+
+    const uint32_t elapsed = cycles() - start;
+
+    gTickCycles.store(gTickCycles.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+
+    if (elapsed > gMaxTickCycles.load(std::memory_order_relaxed)) {
+        gMaxTickCycles.store(elapsed, std::memory_order_relaxed);
+    }
+}
+
+std::size_t T76::Core::Executive::jobCount() {
+    return gJobCount.load(std::memory_order_acquire);
+}
+
+bool T76::Core::Executive::jobStats(std::size_t index, JobStats &stats) {
+    if (index >= gJobCount.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    Job &job = gJobs[index];
+    uint32_t sequence;
+
+    stats.name = job.name;
+    stats.rateHz = job.rateHz;
+    stats.priority = job.priority;
+    stats.context = job.where;
+    stats.overrunLimit = job.overrunLimit.load(std::memory_order_relaxed);
+    stats.overrunAction = job.overrunAction.load(std::memory_order_relaxed);
+
+    do {
+        sequence = job.sequence.load(std::memory_order_acquire);
+
+        if (sequence & 1) {
+            continue; // Being written on core 1
+        }
+
+        stats.runs = job.runs;
+        stats.overruns = job.overruns;
+        stats.lastCycles = job.lastCycles;
+        stats.minCycles = job.runs ? job.minCycles : 0;
+        stats.maxCycles = job.maxCycles;
+        stats.meanCycles = job.runs ? static_cast<uint32_t>(job.totalCycles / job.runs) : 0;
+        stats.maxJitterCycles = job.maxJitterCycles;
+        stats.budgetCycles = job.budgetCycles;
+        stats.consecutiveOverruns = job.consecutiveOverruns;
+        stats.maxConsecutiveOverruns = job.maxConsecutiveOverruns;
+        stats.limitHits = job.limitHits;
+
+        for (uint32_t i = 0; i < T76_IC_EXECUTIVE_JITTER_BINS; i++) {
+            stats.jitterHistogram[i] = job.jitterHistogram[i];
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) || job.sequence.load(std::memory_order_relaxed) != sequence);
+
+    return true;
+}
+
+bool T76::Core::Executive::setOverrunLimit(std::size_t index, uint32_t consecutiveOverruns, OverrunAction action) {
+    if (index >= gJobCount.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    Job &job = gJobs[index];
+
+    job.overrunAction.store(action, std::memory_order_relaxed);
+    job.overrunLimit.store(consecutiveOverruns, std::memory_order_relaxed);
+
+    return true;
+}
+
+uint32_t T76::Core::Executive::jitterBinLowerUs(std::size_t bin) {
+    return bin == 0 ? 0 : 1u << (bin - 1);
+}
+
+ExecutiveStats T76::Core::Executive::stats() {
+    ExecutiveStats stats;
+
+    stats.tickRateHz = gTickRateHz;
+    stats.ticks = gTicks.load(std::memory_order_relaxed);
+    stats.lateTicks = gLateTicks.load(std::memory_order_relaxed);
+    stats.maxTickCycles = gMaxTickCycles.load(std::memory_order_relaxed);
+    stats.cyclesPerTick = gCyclesPerTick;
+    stats.idleCycles = gIdleCycles.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+void T76::Core::Executive::resetStats() {
+    const uint32_t count = gJobCount.load(std::memory_order_acquire);
+
+    // Cleared by core 1 on each job's next run, so that the statistics are never written from two places
+    for (uint32_t i = 0; i < count; i++) {
+        gJobs[i].resetRequested.store(true, std::memory_order_relaxed);
+    }
+
+    gLateTicks.store(0, std::memory_order_relaxed);
+    gTickResetRequested.store(true, std::memory_order_relaxed);
+}
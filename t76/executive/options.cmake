@@ -0,0 +1,6 @@
+# Configurable options for the core 1 executive
+
+set(T76_IC_EXECUTIVE_MAX_JOBS 8 CACHE STRING "Maximum number of periodic jobs that can be registered with the core 1 executive")
+set(T76_IC_EXECUTIVE_JITTER_BINS 8 CACHE STRING "Number of power-of-two bins in each executive job's jitter histogram")
+set(T76_IC_EXECUTIVE_OVERRUN_LIMIT 0 CACHE STRING "Consecutive overruns of an executive job that trigger its overrun action by default; 0 disables the limit")
+option(T76_IC_EXECUTIVE_OVERRUN_FAULT "Report a fault, rather than only a warning, when an executive job reaches its overrun limit" OFF)
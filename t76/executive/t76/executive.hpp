@@ -0,0 +1,194 @@
+/**
+ * @file executive.hpp
+ * @brief Fixed-rate job scheduler for the bare-metal loop on core 1
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The executive runs periodic jobs (control loops, acquisition, housekeeping)
+ * on core 1 at fixed rates. A tick, generated by a hardware timer alarm or by
+ * the application from another interrupt such as a PWM wrap, drives every job;
+ * each job runs once every so many ticks.
+ *
+ * Jobs run in one of two contexts:
+ *
+ * - Interrupt jobs run inside the tick interrupt, in priority order. They are
+ *   meant for short, time-critical work such as a control loop.
+ * - Background jobs are released by the tick and run from the executive's
+ *   main loop, in priority order, where they can be preempted by the tick.
+ *
+ * For every job, the executive measures the execution time and the jitter of
+ * its start times with the Cortex-M33 cycle counter, and counts the overruns:
+ * runs that took longer than the job's budget, and releases of a background
+ * job that was still waiting to run. The jitter of each job is also kept as a
+ * histogram with power-of-two bins in microseconds, for tuning control loops.
+ *
+ * A job can be given a limit of consecutive overruns with setOverrunLimit().
+ * When a job overruns that many times in a row, the executive records a
+ * flight recorder event and, if the limit's action is OverrunAction::Fault,
+ * reports a DEADLINE_MISSED fault, which makes everything safe and resets the
+ * system long before the watchdog would notice a loop that is merely late.
+ *
+ * The main loop also feeds the core 1
+ * watchdog heartbeat whenever the tick has advanced, so a stuck tick or a
+ * background job that never returns is caught by the watchdog.
+ *
+ * Jobs are registered with addJob() before run() is called, on either core;
+ * run() is then called from App::_startCore1() and never returns.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace T76::Core::Executive {
+
+    /**
+     * @brief Function that implements a job
+     * @param context The context pointer passed to addJob()
+     */
+    using JobFunction = void (*)(void *context);
+
+    /**
+     * @brief Where a job runs
+     */
+    enum class JobContext {
+        Interrupt,      ///< Inside the tick interrupt
+        Background,     ///< From the executive's main loop, preemptible by the tick
+    };
+
+    /**
+     * @brief What generates the executive's tick
+     */
+    enum class TickSource {
+        Timer,          ///< A hardware timer alarm claimed by run()
+        External,       ///< The application calls tick(), for example from a PWM wrap interrupt
+    };
+
+    /**
+     * @brief What happens when a job reaches its limit of consecutive overruns
+     */
+    enum class OverrunAction : uint8_t {
+        Warn,           ///< Count it in JobStats::limitHits and record it in the flight recorder
+        Fault,          ///< As Warn, then report a DEADLINE_MISSED fault
+    };
+
+    /**
+     * @brief Timing statistics of one job, in CPU cycles
+     */
+    struct JobStats {
+        const char *name;               ///< Name given to addJob()
+        uint32_t rateHz;                ///< Rate the job runs at
+        uint8_t priority;               ///< Priority within its context; higher runs first
+        JobContext context;             ///< Where the job runs
+        uint32_t runs;                  ///< Number of times the job has run
+        uint32_t overruns;              ///< Runs over budget, plus releases missed while still pending
+        uint32_t lastCycles;            ///< Execution time of the last run
+        uint32_t minCycles;             ///< Shortest execution time
+        uint32_t maxCycles;             ///< Longest execution time
+        uint32_t meanCycles;            ///< Mean execution time
+        uint32_t maxJitterCycles;       ///< Largest deviation of the interval between two starts from the period
+        uint32_t budgetCycles;          ///< Longest acceptable execution time
+        uint32_t consecutiveOverruns;   ///< Overruns since the last run within budget
+        uint32_t maxConsecutiveOverruns; ///< Longest series of consecutive overruns
+        uint32_t limitHits;             ///< Number of times the overrun limit was reached
+        uint32_t overrunLimit;          ///< Consecutive overruns that trigger overrunAction, or 0 if disabled
+        OverrunAction overrunAction;    ///< What happens when the limit is reached
+        uint32_t jitterHistogram[T76_IC_EXECUTIVE_JITTER_BINS];    ///< Starts by jitter; see jitterBinLowerUs()
+    };
+
+    /**
+     * @brief Statistics of the tick itself
+     */
+    struct ExecutiveStats {
+        uint32_t tickRateHz;            ///< Rate of the tick
+        uint32_t ticks;                 ///< Number of ticks since run()
+        uint32_t lateTicks;             ///< Timer ticks skipped because the previous tick ran past them
+        uint32_t maxTickCycles;         ///< Longest time spent in one tick, including interrupt jobs
+        uint32_t cyclesPerTick;         ///< Length of a tick
+        uint32_t idleCycles;            ///< Cycles core 1 has spent asleep since run(); wraps, so use differences
+    };
+
+    /**
+     * @brief Register a periodic job
+     * @param name Name of the job, for statistics and traces; must remain valid
+     * @param function Function that implements the job
+     * @param context Passed to the function
+     * @param rateHz Rate at which the job runs; rounded to a whole number of ticks
+     * @param priority Priority within the job's context; higher priorities run first
+     * @param where Whether the job runs in the tick interrupt or in the background
+     * @param budgetUs Longest acceptable execution time in microseconds, or 0 for the job's period
+     * @return The job's index, or -1 if the job table is full, the rate is 0, or run() has been called
+     */
+    int addJob(const char *name, JobFunction function, void *context, uint32_t rateHz, uint8_t priority,
+               JobContext where = JobContext::Interrupt, uint32_t budgetUs = 0);
+
+    /**
+     * @brief Start the executive on the calling core
+     * @param tickRateHz Rate of the tick; every job's rate should divide it
+     * @param source What generates the tick
+     *
+     * Must be called on core 1, usually at the end of App::_startCore1().
+     * Enables the cycle counter, starts the tick and then runs background
+     * jobs, sleeping with __wfe() whenever none is pending.
+     */
+    [[noreturn]] void run(uint32_t tickRateHz, TickSource source = TickSource::Timer);
+
+    /**
+     * @brief Advance the executive by one tick
+     *
+     * Called by the timer alarm, or by the application's own interrupt
+     * handler with TickSource::External. Runs the interrupt jobs that are
+     * due and releases the background jobs that are due.
+     */
+    void tick();
+
+    /**
+     * @brief Get the number of registered jobs
+     */
+    std::size_t jobCount();
+
+    /**
+     * @brief Get a consistent snapshot of a job's statistics
+     * @param job Index returned by addJob()
+     * @param stats Receives the statistics
+     * @return true if the job exists
+     *
+     * Can be called from either core; never holds up the job.
+     */
+    bool jobStats(std::size_t job, JobStats &stats);
+
+    /**
+     * @brief Set how many consecutive overruns of a job are tolerated
+     * @param job Index returned by addJob()
+     * @param consecutiveOverruns Number of overruns in a row that trigger the action, or 0 to disable the limit
+     * @param action What to do when the limit is reached
+     * @return true if the job exists
+     *
+     * Jobs start with T76_IC_EXECUTIVE_OVERRUN_LIMIT, and with
+     * OverrunAction::Fault if T76_IC_EXECUTIVE_OVERRUN_FAULT is set. Can be
+     * called from either core at any time.
+     */
+    bool setOverrunLimit(std::size_t job, uint32_t consecutiveOverruns, OverrunAction action);
+
+    /**
+     * @brief Get the smallest jitter counted in a bin of JobStats::jitterHistogram
+     * @param bin Index of the bin
+     * @return The bin's lower bound in microseconds: 0 for bin 0, then 2^(bin - 1)
+     *
+     * Each bin ends where the next begins; the last has no upper bound.
+     */
+    uint32_t jitterBinLowerUs(std::size_t bin);
+
+    /**
+     * @brief Get the statistics of the tick
+     */
+    ExecutiveStats stats();
+
+    /**
+     * @brief Reset the statistics of every job and of the tick
+     */
+    void resetStats();
+
+} // namespace T76::Core::Executive
@@ -0,0 +1,430 @@
+/**
+ * @file flash.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the flash service.
+ *
+ * Core 1 is parked through a doorbell claimed for it alone. Core 0 moves the
+ * park state from Running to Requested and rings the doorbell; the doorbell
+ * handler on core 1 pends a spare interrupt of core 1 at the lowest priority,
+ * whose handler moves the state to Parked and spins until core 0 moves it
+ * back to Running. The doorbell interrupt is shared with handlers that want
+ * a high priority, such as safing, so the park itself cannot run from it.
+ * If core 1 does not park in time, core 0 moves the state back from Requested
+ * to Running itself, and whichever of the two exchanges fails knows that the
+ * other side got there first.
+ *
+ * The park handler, the code that runs with the flash out of XIP mode and
+ * the data it reads are always in SRAM, whatever the placement option says.
+ *
+ */
+
+#include "t76/flash.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+
+#include <pico/multicore.h>
+#include <hardware/flash.h>
+#include <hardware/irq.h>
+#include <hardware/structs/timer.h>
+#include <hardware/sync.h>
+#include <hardware/timer.h>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+
+// End of the application image, provided by the SDK's linker script
+extern "C" char __flash_binary_end;
+
+using namespace T76::Core::Flash;
+
+
+namespace {
+
+    enum ParkState : uint32_t {
+        Running,        // Core 1 runs normally
+        Requested,      // Core 0 waits for core 1 to park
+        Parked,         // Core 1 spins in SRAM; the flash can be taken out of XIP mode
+    };
+
+    std::atomic<uint32_t> gParkState{Running};
+    std::atomic<bool> gCore1Ready{false};
+
+#if defined(T76_IC_CORE1_IN_SRAM) && !defined(T76_IC_SMP)
+    std::atomic<bool> gCore1KeepsRunning{true};
+#else
+    std::atomic<bool> gCore1KeepsRunning{false};
+#endif
+
+    int gDoorbell = -1;
+    int gParkIrq = -1;                  // Spare interrupt of core 1 that parks it
+    SemaphoreHandle_t gMutex = nullptr;
+
+    // Every chunk is programmed from here, so that its data is never read from flash while the flash is busy
+    uint8_t gSectorBuffer[FLASH_SECTOR_SIZE] __attribute__((aligned(4)));
+
+    Stats gStats{};                     // Guarded by gMutex
+
+    struct Chunk {
+        uint32_t offset;
+        uint32_t eraseLength;
+        uint32_t programLength;
+    };
+
+    /**
+     * @brief Erase and program one chunk with core 0's interrupts disabled
+     * @return The time the flash was out of XIP mode, in microseconds
+     *
+     * Reads the timer register directly, so that nothing here calls into flash.
+     */
+    uint32_t __no_inline_not_in_flash_func(executeChunk)(const Chunk &chunk) {
+        const uint32_t interrupts = save_and_disable_interrupts();
+        const uint32_t start = timer_hw->timerawl;
+
+        if (chunk.eraseLength) {
+            flash_range_erase(chunk.offset, chunk.eraseLength);
+        }
+
+        if (chunk.programLength) {
+            flash_range_program(chunk.offset, gSectorBuffer, chunk.programLength);
+        }
+
+        const uint32_t elapsed = timer_hw->timerawl - start;
+
+        restore_interrupts(interrupts);
+        return elapsed;
+    }
+
+    /**
+     * @brief Doorbell handler that has core 1 park while core 0 uses the flash
+     *
+     * The doorbell interrupt is shared with the inter-core channels, the USB
+     * interface and safing, so the handler returns straight away for any
+     * other doorbell. Core 0 waits for the park before it touches the flash,
+     * so irq_set_pending() can still be called from flash here.
+     */
+    void __not_in_flash_func(doorbellHandler)() {
+        if (gDoorbell < 0 || !multicore_doorbell_is_set_current_core(gDoorbell)) {
+            return;
+        }
+
+        multicore_doorbell_clear_current_core(gDoorbell);
+        irq_set_pending(gParkIrq);
+    }
+
+    /**
+     * @brief Handler that parks core 1 while core 0 uses the flash
+     *
+     * Runs at the lowest priority on core 1, so that it only parks the core
+     * once no other interrupt handler is active. Core 0 may use the same
+     * spare interrupt for something else, as both cores share the vector
+     * table, so the handler is shared and only acts on core 1.
+     */
+    void __not_in_flash_func(parkHandler)() {
+        if (get_core_num() != 1) {
+            return;
+        }
+
+        const bool keepRunning = gCore1KeepsRunning.load(std::memory_order_relaxed);
+        const uint32_t interrupts = keepRunning ? 0 : save_and_disable_interrupts();
+        uint32_t expected = Requested;
+
+        // Core 0 may have given up waiting already
+        if (gParkState.compare_exchange_strong(expected, Parked, std::memory_order_acq_rel)) {
+            while (gParkState.load(std::memory_order_acquire) == Parked) {
+                tight_loop_contents();
+            }
+        }
+
+        if (!keepRunning) {
+            restore_interrupts(interrupts);
+        }
+    }
+
+    bool parkCore1(uint32_t &waitUs) {
+        const uint32_t start = time_us_32();
+
+        gParkState.store(Requested, std::memory_order_release);
+        multicore_doorbell_set_other_core(gDoorbell);
+
+        while (gParkState.load(std::memory_order_acquire) != Parked) {
+            if (time_us_32() - start < T76_IC_FLASH_PARK_TIMEOUT_MS * 1000) {
+                tight_loop_contents();
+                continue;
+            }
+
+            uint32_t expected = Requested;
+
+            if (gParkState.compare_exchange_strong(expected, Running, std::memory_order_acq_rel)) {
+                return false;
+            }
+
+            break; // Parked just as the timeout expired
+        }
+
+        waitUs = time_us_32() - start;
+        return true;
+    }
+
+    void releaseCore1() {
+        gParkState.store(Running, std::memory_order_release);
+    }
+
+    /**
+     * @brief Check that the caller may start an operation
+     *
+     * Operations run on core 0, which parks core 1. With T76_IC_SMP, a task
+     * on core 1 is moved to core 0 by execute() instead of being refused.
+     */
+    bool callerAllowed() {
+#ifdef T76_IC_SMP
+        if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+            return __get_current_exception() == 0;
+        }
+#endif
+
+        return get_core_num() == 0;
+    }
+
+    bool rangeAllowed(uint32_t offset, std::size_t length) {
+        const uint32_t imageEnd = reinterpret_cast<uintptr_t>(&__flash_binary_end) - XIP_BASE;
+
+        return length > 0 &&
+               offset >= imageEnd &&
+               offset <= PICO_FLASH_SIZE_BYTES &&
+               length <= PICO_FLASH_SIZE_BYTES - offset;
+    }
+
+    void countFailure() {
+        if (gMutex != nullptr) {
+            xSemaphoreTake(gMutex, portMAX_DELAY);
+            gStats.failures++;
+            xSemaphoreGive(gMutex);
+        }
+    }
+
+    /**
+     * @brief Run an operation as a sequence of sector-sized chunks
+     * @param offset Start of the range
+     * @param data Data to program, or nullptr to erase only
+     * @param length Length of the range
+     * @param eraseFirst Whether each chunk erases its sector before programming it
+     */
+    bool execute(uint32_t offset, const uint8_t *data, std::size_t length, bool eraseFirst) {
+        if (!gCore1Ready.load(std::memory_order_acquire)) {
+            LOGE("Flash: core 1 has not called Flash::core1Init()\n");
+            countFailure();
+            return false;
+        }
+
+#ifdef T76_IC_SMP
+        // Core 1 is the core that gets parked, so the caller runs on core 0 for the operation
+        const bool pinned = xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+        const UBaseType_t affinity = pinned ? vTaskCoreAffinityGet(nullptr) : tskNO_AFFINITY;
+
+        if (pinned) {
+            vTaskCoreAffinitySet(nullptr, 1u << 0);
+        }
+#endif
+
+        xSemaphoreTake(gMutex, portMAX_DELAY);
+
+        bool success = true;
+        std::size_t done = 0;
+
+        while (done < length) {
+            const std::size_t size = std::min<std::size_t>(length - done, FLASH_SECTOR_SIZE);
+            Chunk chunk = { static_cast<uint32_t>(offset + done), eraseFirst ? FLASH_SECTOR_SIZE : 0u, 0 };
+
+            if (data != nullptr) {
+                const std::size_t programLength = (size + FLASH_PAGE_SIZE - 1) & ~(std::size_t(FLASH_PAGE_SIZE) - 1);
+
+                // Programming 0xff leaves the rest of the last page erased
+                memcpy(gSectorBuffer, data + done, size);
+                memset(gSectorBuffer + size, 0xff, programLength - size);
+                chunk.programLength = static_cast<uint32_t>(programLength);
+            }
+
+            uint32_t waitUs = 0;
+
+            if (!parkCore1(waitUs)) {
+                LOGE("Flash: core 1 did not park within %d ms\n", T76_IC_FLASH_PARK_TIMEOUT_MS);
+                success = false;
+                break;
+            }
+
+            const uint32_t stallUs = executeChunk(chunk);
+
+            releaseCore1();
+
+            gStats.chunks++;
+            gStats.lastStallUs = stallUs;
+            gStats.maxStallUs = std::max(gStats.maxStallUs, stallUs);
+            gStats.totalStallUs += stallUs;
+            gStats.maxParkWaitUs = std::max(gStats.maxParkWaitUs, waitUs);
+
+            done += size;
+
+            // Let core 1's background work and the other core 0 tasks catch up before the next chunk
+            if (done < length && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+                vTaskDelay(pdMS_TO_TICKS(T76_IC_FLASH_CHUNK_GAP_MS));
+            }
+        }
+
+        if (success) {
+            gStats.operations++;
+        } else {
+            gStats.failures++;
+        }
+
+        xSemaphoreGive(gMutex);
+
+#ifdef T76_IC_SMP
+        if (pinned) {
+            vTaskCoreAffinitySet(nullptr, affinity);
+        }
+#endif
+
+        return success;
+    }
+
+} // namespace
+
+
+bool T76::Core::Flash::init() {
+    if (gMutex != nullptr) {
+        return true;
+    }
+
+    gMutex = xSemaphoreCreateMutex();
+
+    if (gMutex == nullptr) {
+        LOGE("Flash: cannot create the mutex\n");
+        return false;
+    }
+
+    // The doorbell only ever rings on core 1
+    gDoorbell = multicore_doorbell_claim_unused(1u << 1, false);
+
+    if (gDoorbell < 0) {
+        LOGE("Flash: no doorbell left for core 1\n");
+        return false;
+    }
+
+    // The vector table is shared by both cores; the interrupt is only enabled on core 1, by core1Init()
+    irq_add_shared_handler(multicore_doorbell_irq_num(gDoorbell), doorbellHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+
+    return true;
+}
+
+bool T76::Core::Flash::core1Init() {
+    if (gDoorbell < 0 || get_core_num() != 1) {
+        LOGE("Flash: core1Init() must run on core 1, after init()\n");
+        return false;
+    }
+
+    // Spare interrupts are local to a core, so this one is claimed by core 1 itself
+    gParkIrq = user_irq_claim_unused(false);
+
+    if (gParkIrq < 0) {
+        LOGE("Flash: no spare interrupt left on core 1\n");
+        return false;
+    }
+
+    // The lowest priority makes core 1 park only between other interrupt handlers, such as the control loop
+    irq_add_shared_handler(gParkIrq, parkHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_priority(gParkIrq, PICO_LOWEST_IRQ_PRIORITY);
+    irq_set_enabled(gParkIrq, true);
+    irq_set_enabled(multicore_doorbell_irq_num(gDoorbell), true);
+
+    gCore1Ready.store(true, std::memory_order_release);
+    return true;
+}
+
+void T76::Core::Flash::setCore1KeepsRunning(bool keepRunning) {
+#ifdef T76_IC_SMP
+    // Core 1 runs tasks and the kernel's interrupts from flash, so it is always frozen
+    (void)keepRunning;
+#else
+    gCore1KeepsRunning.store(keepRunning, std::memory_order_relaxed);
+#endif
+}
+
+bool T76::Core::Flash::erase(uint32_t offset, std::size_t length) {
+    if (gMutex == nullptr || !callerAllowed()) {
+        LOGE("Flash: erase() called before init(), or from a context that cannot block\n");
+        return false;
+    }
+
+    if ((offset % FLASH_SECTOR_SIZE) != 0 || (length % FLASH_SECTOR_SIZE) != 0 || !rangeAllowed(offset, length)) {
+        LOGE("Flash: erase() of %lu bytes at 0x%08lx is misaligned or outside the free flash\n", (unsigned long)length, (unsigned long)offset);
+        countFailure();
+        return false;
+    }
+
+    return execute(offset, nullptr, length, true);
+}
+
+bool T76::Core::Flash::program(uint32_t offset, const void *data, std::size_t length) {
+    if (gMutex == nullptr || !callerAllowed()) {
+        LOGE("Flash: program() called before init(), or from a context that cannot block\n");
+        return false;
+    }
+
+    if (data == nullptr || (offset % FLASH_PAGE_SIZE) != 0 || !rangeAllowed(offset, length)) {
+        LOGE("Flash: program() of %lu bytes at 0x%08lx is misaligned or outside the free flash\n", (unsigned long)length, (unsigned long)offset);
+        countFailure();
+        return false;
+    }
+
+    return execute(offset, static_cast<const uint8_t *>(data), length, false);
+}
+
+bool T76::Core::Flash::write(uint32_t offset, const void *data, std::size_t length) {
+    if (gMutex == nullptr || !callerAllowed()) {
+        LOGE("Flash: write() called before init(), or from a context that cannot block\n");
+        return false;
+    }
+
+    if (data == nullptr || (offset % FLASH_SECTOR_SIZE) != 0 || !rangeAllowed(offset, length)) {
+        LOGE("Flash: write() of %lu bytes at 0x%08lx is misaligned or outside the free flash\n", (unsigned long)length, (unsigned long)offset);
+        countFailure();
+        return false;
+    }
+
+    return execute(offset, static_cast<const uint8_t *>(data), length, true);
+}
+
+Stats T76::Core::Flash::stats() {
+    Stats stats{};
+
+    if (gMutex == nullptr) {
+        return stats;
+    }
+
+    xSemaphoreTake(gMutex, portMAX_DELAY);
+    stats = gStats;
+    xSemaphoreGive(gMutex);
+
+    stats.core1KeepsRunning = gCore1KeepsRunning.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void T76::Core::Flash::resetStats() {
+    if (gMutex == nullptr) {
+        return;
+    }
+
+    xSemaphoreTake(gMutex, portMAX_DELAY);
+    gStats = Stats{};
+    xSemaphoreGive(gMutex);
+}
@@ -0,0 +1,4 @@
+# Configurable options for the flash service
+
+set(T76_IC_FLASH_PARK_TIMEOUT_MS 100 CACHE STRING "How long a flash operation waits for core 1 to park before it fails (milliseconds)")
+set(T76_IC_FLASH_CHUNK_GAP_MS 1 CACHE STRING "Time given to other tasks between two sector-sized chunks of a flash operation (milliseconds)")
@@ -0,0 +1,122 @@
+/**
+ * @file flash.hpp
+ * @brief Flash erase and program operations that keep core 1 running
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Erasing or programming the flash takes it out of XIP mode, so neither core
+ * may execute from flash, or read data from it, while the operation is in
+ * progress. The SDK's multicore_lockout handles this by freezing the other
+ * core for the whole operation, which would stop the control loop on core 1
+ * for tens of milliseconds for every erased sector.
+ *
+ * The flash service instead parks core 1 in a spin loop in SRAM, entered from
+ * a spare interrupt at the lowest priority that a doorbell pends. Because that
+ * interrupt never preempts anything else, core 1 parks between control cycles, and
+ * because the loop leaves interrupts enabled, interrupt handlers and jobs that
+ * run from SRAM (see <t76/placement.hpp>) keep running while the flash is
+ * busy. Only the code that core 1 runs from flash, such as the executive's
+ * background jobs, waits for the operation to finish.
+ *
+ * If core 1's interrupt handlers may run from flash, setCore1KeepsRunning()
+ * switches the loop to disabling interrupts, which freezes core 1 the same way
+ * multicore_lockout does. This is the default when T76_IC_CORE1_IN_SRAM is
+ * off, and the executive selects it when it is driven by a timer alarm.
+ *
+ * Writes are split into sector-sized chunks. Core 1 is parked and core 0's
+ * interrupts are disabled for one chunk at a time; in between, core 1 is
+ * released and other core 0 tasks get to run. The time the flash is out of
+ * XIP mode is measured for every chunk and reported by stats().
+ *
+ * All operations must be called from FreeRTOS tasks on core 0, and may only
+ * target the flash beyond the end of the application image. With T76_IC_SMP,
+ * they may be called from tasks on either core: the caller is moved to core 0
+ * for the operation, and core 1, which then runs tasks from flash, is always
+ * frozen rather than left running.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace T76::Core::Flash {
+
+    /**
+     * @brief Statistics of the flash operations since boot or since resetStats()
+     */
+    struct Stats {
+        uint32_t operations;            ///< Completed erase, program and write calls
+        uint32_t failures;              ///< Calls rejected or abandoned because core 1 did not park
+        uint32_t chunks;                ///< Sector-sized chunks executed
+        uint32_t lastStallUs;           ///< Time the flash was unavailable during the last chunk
+        uint32_t maxStallUs;            ///< Longest time the flash was unavailable during one chunk
+        uint64_t totalStallUs;          ///< Total time the flash was unavailable
+        uint32_t maxParkWaitUs;         ///< Longest wait for core 1 to park before a chunk
+        bool core1KeepsRunning;         ///< Whether core 1 interrupts keep running during a chunk
+    };
+
+    /**
+     * @brief Initialize the flash service
+     * @return true if the service is ready
+     *
+     * Called by App::run() on core 0, before core 1 is launched.
+     */
+    bool init();
+
+    /**
+     * @brief Prepare core 1 to be parked during flash operations
+     * @return true if core 1 can be parked
+     *
+     * Called on core 1 by App before _startCore1(). Until it has been called,
+     * every flash operation fails.
+     */
+    bool core1Init();
+
+    /**
+     * @brief Choose whether core 1 interrupts keep running during flash operations
+     * @param keepRunning true to park core 1 with interrupts enabled, false to freeze it
+     *
+     * Only keep core 1 running if every interrupt handler that can run on it,
+     * and everything they call, is in SRAM.
+     */
+    void setCore1KeepsRunning(bool keepRunning);
+
+    /**
+     * @brief Erase a range of flash
+     * @param offset Offset from the start of flash; must be a multiple of the sector size
+     * @param length Number of bytes to erase; must be a multiple of the sector size
+     * @return true if the whole range was erased
+     */
+    bool erase(uint32_t offset, std::size_t length);
+
+    /**
+     * @brief Program a range of flash that has already been erased
+     * @param offset Offset from the start of flash; must be a multiple of the page size
+     * @param data Data to program; may be anywhere in memory, including flash
+     * @param length Number of bytes to program; the rest of the last page is left erased
+     * @return true if the whole range was programmed
+     */
+    bool program(uint32_t offset, const void *data, std::size_t length);
+
+    /**
+     * @brief Erase and program a range of flash, one sector at a time
+     * @param offset Offset from the start of flash; must be a multiple of the sector size
+     * @param data Data to write; may be anywhere in memory, including flash
+     * @param length Number of bytes to write; the rest of the last sector is left erased
+     * @return true if the whole range was written
+     */
+    bool write(uint32_t offset, const void *data, std::size_t length);
+
+    /**
+     * @brief Get the statistics of the flash operations
+     */
+    Stats stats();
+
+    /**
+     * @brief Reset the statistics of the flash operations
+     */
+    void resetStats();
+
+} // namespace T76::Core::Flash
@@ -0,0 +1,178 @@
+/**
+ * @file intercore.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Doorbell and wait handling for inter-core channels.
+ *
+ * All channels share the SIO doorbell interrupt on core 0. Each initialized
+ * channel claims its own doorbell and is recorded in a fixed table, and the
+ * shared handler gives the semaphore of every channel whose doorbell is set.
+ *
+ */
+
+#include "t76/intercore.hpp"
+
+#include <task.h>
+
+#include <pico/multicore.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
+
+#include <t76/placement.hpp>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+
+using namespace T76::Core::InterCore;
+
+
+// Channels that can wake a task on core 0; only ever appended to
+static ChannelBase *gChannels[T76_IC_INTERCORE_MAX_CHANNELS];
+static std::atomic<uint32_t> gChannelCount{0};
+
+
+/**
+ * @brief Whether the caller waits on the channel's semaphore rather than in __wfe()
+ *
+ * With T76_IC_SMP, tasks on either core block on the semaphore; the doorbell
+ * is still only taken on core 0, whose handler gives it wherever the task runs.
+ */
+static bool waitsInTask() {
+#ifdef T76_IC_SMP
+    return __get_current_exception() == 0 && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+#else
+    return get_core_num() == 0;
+#endif
+}
+
+
+bool ChannelBase::init() {
+    if (_wakeSemaphore != nullptr) {
+        return true;
+    }
+
+    const uint32_t index = gChannelCount.load(std::memory_order_relaxed);
+
+    if (get_core_num() != 0 || index >= T76_IC_INTERCORE_MAX_CHANNELS) {
+        LOGE("InterCore: channels must be initialized on core 0, up to %d of them\n", T76_IC_INTERCORE_MAX_CHANNELS);
+        return false;
+    }
+
+    // Only core 0 ever waits on the doorbell, so it is claimed for core 0 alone
+    _doorbell = multicore_doorbell_claim_unused(1u << 0, false);
+
+    if (_doorbell < 0) {
+        LOGE("InterCore: no doorbell left for a channel\n");
+        return false;
+    }
+
+    _wakeSemaphore = xSemaphoreCreateBinary();
+
+    if (_wakeSemaphore == nullptr) {
+        LOGE("InterCore: cannot create the wake semaphore of a channel\n");
+        multicore_doorbell_unclaim(_doorbell, 1u << 0);
+        _doorbell = -1;
+        return false;
+    }
+
+    gChannels[index] = this;
+    gChannelCount.store(index + 1, std::memory_order_release);
+
+    // The doorbell interrupt is shared with the USB interface, and each handler only acts on its own doorbells
+    static bool handlerAdded = false;
+
+    if (!handlerAdded) {
+        const uint doorbellIrq = multicore_doorbell_irq_num(_doorbell);
+
+        irq_add_shared_handler(doorbellIrq, _doorbellHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(doorbellIrq, true);
+        handlerAdded = true;
+    }
+
+    return true;
+}
+
+void T76_CORE1_CODE ChannelBase::_notify() {
+    // Pairs with the fence in _beginWait(): either the waiter sees the change, or this sees the waiter
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_doorbell >= 0 && _core0Waiting.load(std::memory_order_relaxed)) {
+        if (get_core_num() == 0) {
+            multicore_doorbell_set_current_core(_doorbell);
+        } else {
+            multicore_doorbell_set_other_core(_doorbell);
+        }
+    }
+
+    // Wakes core 1 if it waits on the channel in __wfe()
+    __sev();
+}
+
+void ChannelBase::_beginWait() {
+    if (waitsInTask()) {
+        _core0Waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+void ChannelBase::_endWait() {
+    if (waitsInTask()) {
+        _core0Waiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool ChannelBase::_sleep(uint64_t deadline) {
+    const bool forever = (deadline == UINT64_MAX);
+
+    if (!waitsInTask()) {
+        if (forever) {
+            __wfe();
+            return true;
+        }
+
+        return !best_effort_wfe_or_timeout(from_us_since_boot(deadline));
+    }
+
+    TickType_t ticks = portMAX_DELAY;
+
+    if (!forever) {
+        const uint64_t now = time_us_64();
+
+        if (now >= deadline) {
+            return false;
+        }
+
+        ticks = pdMS_TO_TICKS((deadline - now + 999) / 1000);
+
+        if (ticks == 0) {
+            ticks = 1;
+        }
+    }
+
+    if (_wakeSemaphore != nullptr) {
+        xSemaphoreTake(_wakeSemaphore, ticks);
+    } else {
+        vTaskDelay(1); // Not initialized, or no doorbell left: poll
+    }
+
+    return forever || time_us_64() < deadline;
+}
+
+void ChannelBase::_doorbellHandler() {
+    const uint32_t count = gChannelCount.load(std::memory_order_acquire);
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    for (uint32_t i = 0; i < count; i++) {
+        ChannelBase *channel = gChannels[i];
+
+        if (multicore_doorbell_is_set_current_core(channel->_doorbell)) {
+            multicore_doorbell_clear_current_core(channel->_doorbell);
+            xSemaphoreGiveFromISR(channel->_wakeSemaphore, &higherPriorityTaskWoken);
+        }
+    }
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
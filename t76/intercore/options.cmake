@@ -0,0 +1,3 @@
+# Configurable options for the inter-core channel library
+
+set(T76_IC_INTERCORE_MAX_CHANNELS 8 CACHE STRING "Maximum number of inter-core channels that can wake tasks on core 0")
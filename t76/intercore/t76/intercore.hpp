@@ -0,0 +1,229 @@
+/**
+ * @file intercore.hpp
+ * @brief Typed message channels between core 0 and core 1
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * A Channel carries values of one type from a producer on one core to a
+ * consumer on the other. The values are stored in a lock-free ring that is
+ * part of the channel object, so sending and receiving never allocate, never
+ * take a lock and can be done from interrupt handlers on either core.
+ *
+ * Waiting is adapted to each core:
+ *
+ * - On core 0, a task that waits for data or for room blocks on a FreeRTOS
+ *   semaphore. The other side rings an SIO doorbell after every send or
+ *   receive while a task is waiting, and the doorbell interrupt wakes the task.
+ * - On core 1, which runs bare metal, waiting is done with __wfe(). Every send
+ *   and receive executes __sev(), so the core wakes up as soon as there is
+ *   something to do.
+ * - With T76_IC_SMP, tasks on core 1 wait on the semaphore like those on
+ *   core 0; channels must still be initialized on core 0.
+ *
+ * Channels are usually placed in main SRAM as statics. Small, latency-critical
+ * channels can also be placed in one of the 4 kB scratch banks with the SDK's
+ * __scratch_x() or __scratch_y() attributes, so that their traffic does not
+ * compete with the other core's accesses to the striped main SRAM banks.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+
+#include <pico/time.h>
+
+#include <t76/ring_queue.hpp>
+
+
+namespace T76::Core::InterCore {
+
+    /**
+     * @brief Timeout that makes send() and receive() wait until they succeed
+     */
+    constexpr uint32_t WaitForever = UINT32_MAX;
+
+    /**
+     * @brief The part of a Channel that does not depend on the type of its values
+     *
+     * Handles the doorbell and the semaphore that let a task on core 0 wait
+     * for the other core.
+     */
+    class ChannelBase {
+    public:
+        ChannelBase(const ChannelBase&) = delete;
+        ChannelBase& operator=(const ChannelBase&) = delete;
+
+        /**
+         * @brief Prepare the channel for blocking waits on core 0
+         * @return true if tasks can be woken by the other core, false if not
+         *
+         * Must be called on core 0, before a task first waits on the channel.
+         * If no doorbell is left or the channel table is full, a task that
+         * waits on the channel polls it once per tick instead; sending and
+         * receiving are unaffected.
+         */
+        bool init();
+
+    protected:
+        ChannelBase() = default;
+
+        /**
+         * @brief Wake the other side after changing the channel's contents
+         *
+         * Called after every successful send and receive, by either side.
+         */
+        void _notify();
+
+        /**
+         * @brief Retry an operation until it succeeds or the timeout expires
+         * @param attempt Callable that tries the operation once
+         * @param timeoutMs Timeout in milliseconds, 0 to try once, or WaitForever
+         * @return true if the operation succeeded
+         */
+        template<typename Attempt>
+        bool _waitFor(Attempt attempt, uint32_t timeoutMs) {
+            if (attempt()) {
+                return true;
+            }
+
+            if (timeoutMs == 0) {
+                return false;
+            }
+
+            const uint64_t deadline = (timeoutMs == WaitForever) ? UINT64_MAX : time_us_64() + static_cast<uint64_t>(timeoutMs) * 1000;
+            bool result = false;
+
+            // The waiter must be visible before the final attempt, so that a concurrent notify is not missed
+            _beginWait();
+
+            while (!(result = attempt()) && _sleep(deadline)) {
+            }
+
+            _endWait();
+            return result;
+        }
+
+        void _beginWait();
+        void _endWait();
+
+        /**
+         * @brief Sleep until the other side notifies the channel or the deadline passes
+         * @return false if the deadline has passed
+         */
+        bool _sleep(uint64_t deadline);
+
+        static void _doorbellHandler();
+
+        int _doorbell = -1;                                 ///< Doorbell that wakes core 0, or -1
+        SemaphoreHandle_t _wakeSemaphore = nullptr;         ///< Given by the doorbell interrupt
+        std::atomic<bool> _core0Waiting{false};             ///< Whether a task on core 0 is waiting
+    };
+
+    /**
+     * @brief A single-producer, single-consumer channel between the two cores
+     * @tparam T The type of values carried by the channel
+     * @tparam N Number of values the channel can hold, must be a power of two
+     *
+     * The producer and the consumer may each be a task or an interrupt handler
+     * on either core, as long as each side only uses the channel from one
+     * context at a time. The try functions never block and are safe in
+     * interrupt handlers; send() and receive() may wait and must only be
+     * called from a task on core 0 or from the main loop on core 1.
+     */
+    template<typename T, std::size_t N>
+    class Channel : public ChannelBase {
+    public:
+        /**
+         * @brief Send a value without waiting
+         * @param value The value to send
+         * @return true if the value was queued, false if the channel is full
+         */
+        bool trySend(const T& value) {
+            if (!_queue.push(value)) {
+                return false;
+            }
+
+            _notify();
+            return true;
+        }
+
+        /**
+         * @brief Send a value without waiting (move version)
+         * @param value The value to send; only moved from if it was queued
+         * @return true if the value was queued, false if the channel is full
+         */
+        bool trySend(T&& value) {
+            if (!_queue.push(std::move(value))) {
+                return false;
+            }
+
+            _notify();
+            return true;
+        }
+
+        /**
+         * @brief Send a value, waiting for room if the channel is full
+         * @param value The value to send
+         * @param timeoutMs How long to wait, in milliseconds, or WaitForever
+         * @return true if the value was queued, false if the timeout expired
+         */
+        bool send(const T& value, uint32_t timeoutMs = WaitForever) {
+            return _waitFor([&]() { return trySend(value); }, timeoutMs);
+        }
+
+        /**
+         * @brief Receive a value without waiting
+         * @param out Reference to store the received value
+         * @return true if a value was received, false if the channel is empty
+         */
+        bool tryReceive(T& out) {
+            if (!_queue.tryPop(out)) {
+                return false;
+            }
+
+            _notify();
+            return true;
+        }
+
+        /**
+         * @brief Receive a value, waiting for one if the channel is empty
+         * @param out Reference to store the received value
+         * @param timeoutMs How long to wait, in milliseconds, or WaitForever
+         * @return true if a value was received, false if the timeout expired
+         */
+        bool receive(T& out, uint32_t timeoutMs = WaitForever) {
+            return _waitFor([&]() { return tryReceive(out); }, timeoutMs);
+        }
+
+        /**
+         * @brief Get the number of values waiting in the channel
+         */
+        std::size_t size() const {
+            return _queue.size();
+        }
+
+        /**
+         * @brief Check whether the channel is empty
+         */
+        bool empty() const {
+            return _queue.empty();
+        }
+
+        /**
+         * @brief Get the number of values the channel can hold
+         */
+        static constexpr std::size_t capacity() {
+            return N;
+        }
+
+    protected:
+        T76::Core::Utils::SPSCRingQueue<T, N, T76::Core::Utils::OverflowPolicy::Reject> _queue;
+    };
+
+} // namespace T76::Core::InterCore
@@ -0,0 +1,133 @@
+/**
+ * @file shared_params.hpp
+ * @brief Parameter blocks published atomically from one core to the other
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Control loops on core 1 typically read a struct of parameters (gains,
+ * limits, a set point) on every cycle while core 0 changes them in response
+ * to commands. Writing the fields one by one lets the loop see a mix of old
+ * and new values, and locking the struct would add jitter to the loop.
+ *
+ * SharedParams solves this with three copies of the struct. The writer fills
+ * a copy the reader is not using and publishes it with a single atomic
+ * exchange; the reader picks up the newest published copy, again with a
+ * single exchange, and otherwise keeps using the copy it already has. Neither
+ * side ever waits for the other, and the reader always sees a complete struct.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace T76::Core::InterCore {
+
+    /**
+     * @brief A parameter struct shared between one writer and one reader without locks
+     * @tparam T The type of the parameter struct; must be copy-assignable
+     *
+     * The writer uses publish() or update(), typically from a task on core 0;
+     * the reader calls refresh() and value(), typically at the start of a
+     * control loop interrupt on core 1. Each side must only be used from one
+     * context at a time, so several tasks that change the same parameters
+     * must serialize their updates.
+     *
+     * Because the reader only ever sees whole structs, a change to a gain and
+     * the matching change to a limit always take effect in the same cycle.
+     * If the writer publishes several times between two refreshes, the reader
+     * skips straight to the newest value.
+     */
+    template<typename T>
+    class SharedParams {
+        static_assert(std::is_copy_assignable_v<T>, "SharedParams requires a copy-assignable type");
+        static_assert(std::atomic<uint8_t>::is_always_lock_free, "SharedParams requires lock-free 8-bit atomics");
+
+    public:
+        /**
+         * @brief Construct the shared parameters with an initial value
+         * @param initial The value seen by the reader until the first publish()
+         */
+        explicit SharedParams(const T& initial = T()) : _buffers{initial, initial, initial}, _current(initial) {
+        }
+
+        SharedParams(const SharedParams&) = delete;
+        SharedParams& operator=(const SharedParams&) = delete;
+
+        /**
+         * @brief Publish a complete new set of parameters
+         * @param value The new parameters
+         *
+         * Writer side. The reader sees the new value on its next refresh().
+         */
+        void publish(const T& value) {
+            _current = value;
+            _publishCurrent();
+        }
+
+        /**
+         * @brief Change some of the parameters and publish the result
+         * @param modify Callable that receives a reference to a copy of the current parameters
+         *
+         * Writer side. Several fields can be changed without the reader ever
+         * seeing only some of the changes.
+         */
+        template<typename Modify>
+        void update(Modify modify) {
+            modify(_current);
+            _publishCurrent();
+        }
+
+        /**
+         * @brief Get the parameters last published by the writer
+         *
+         * Writer side; the reader may not have picked them up yet.
+         */
+        const T& current() const {
+            return _current;
+        }
+
+        /**
+         * @brief Pick up the newest published parameters, if any
+         * @return true if new parameters were picked up
+         *
+         * Reader side. Costs one atomic load when nothing has changed.
+         */
+        bool refresh() {
+            if ((_middle.load(std::memory_order_relaxed) & _freshFlag) == 0) {
+                return false;
+            }
+
+            _readIndex = _middle.exchange(_readIndex, std::memory_order_acq_rel) & _indexMask;
+            return true;
+        }
+
+        /**
+         * @brief Get the parameters picked up by the last refresh()
+         *
+         * Reader side. The reference remains valid and unchanged until the
+         * next refresh().
+         */
+        const T& value() const {
+            return _buffers[_readIndex];
+        }
+
+    protected:
+        static constexpr uint8_t _indexMask = 0x03;
+        static constexpr uint8_t _freshFlag = 0x04;
+
+        void _publishCurrent() {
+            _buffers[_writeIndex] = _current;
+            _writeIndex = _middle.exchange(_writeIndex | _freshFlag, std::memory_order_acq_rel) & _indexMask;
+        }
+
+        T _buffers[3];                          ///< Copies owned by the writer, the reader and neither
+        T _current;                             ///< Writer's copy of the last published parameters
+        uint8_t _writeIndex = 0;                ///< Buffer the writer fills next
+        uint8_t _readIndex = 1;                 ///< Buffer the reader is using
+        std::atomic<uint8_t> _middle{2};        ///< Buffer waiting to be picked up, with _freshFlag if unread
+    };
+
+} // namespace T76::Core::InterCore
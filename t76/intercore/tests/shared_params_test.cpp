@@ -0,0 +1,173 @@
+/**
+ * @file shared_params_test.cpp
+ * @brief Test of the SharedParams triple buffer.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The protocol is first checked from a single thread, then with a writer
+ * thread and a reader thread, which stand in for the task on core 0 and the
+ * control loop on core 1.
+ *
+ */
+
+#include <t76/shared_params.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using T76::Core::InterCore::SharedParams;
+
+namespace {
+
+    constexpr uint32_t refreshCount = 200000;
+    constexpr auto maxReadTime = std::chrono::seconds(1);
+    constexpr int fieldCount = 64;
+
+    void check(const char *name, bool passed, const std::string &detail = "") {
+        if (passed) {
+            std::cout << "✓ " << name << std::endl;
+        } else {
+            std::cout << "✗ " << name << (detail.empty() ? "" : " (" + detail + ")") << std::endl;
+        }
+    }
+
+    /**
+     * @brief Parameters whose fields all hold the sequence number of the publish that wrote them.
+     *
+     * The struct is larger than any atomic store, so a reader that sees a
+     * buffer while it is being written finds fields that do not match.
+     */
+    struct Params {
+        uint32_t fields[fieldCount] = {};
+
+        explicit Params(uint32_t sequence = 0) {
+            for (uint32_t &field : fields) {
+                field = sequence;
+            }
+        }
+
+        bool whole() const {
+            for (uint32_t field : fields) {
+                if (field != fields[0]) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+} // namespace
+
+int main() {
+    std::cout << "=== SharedParams Test ===" << std::endl;
+
+    {
+        SharedParams<Params> params(Params(7));
+
+        check("Reader sees the initial value", params.value().fields[0] == 7 && params.value().whole());
+        check("Nothing to pick up before the first publish", !params.refresh());
+
+        params.publish(Params(1));
+        check("Writer sees its publish at once", params.current().fields[0] == 1);
+        check("Reader keeps its value until it refreshes", params.value().fields[0] == 7);
+        check("Refresh picks up a publish", params.refresh() && params.value().fields[0] == 1);
+        check("A publish is picked up only once", !params.refresh() && params.value().fields[0] == 1);
+    }
+
+    {
+        SharedParams<Params> params;
+
+        // Each number of publishes between two refreshes leaves the buffers in a different arrangement
+        bool newest = true;
+        uint32_t sequence = 0;
+
+        for (int round = 0; round < 64; round++) {
+            const int publishes = 1 + round % 5;
+
+            for (int i = 0; i < publishes; i++) {
+                params.publish(Params(++sequence));
+            }
+
+            newest = newest && params.refresh() && params.value().fields[0] == sequence && params.value().whole();
+        }
+
+        check("Refresh skips to the newest of several publishes", newest);
+    }
+
+    {
+        SharedParams<Params> params;
+
+        params.publish(Params(3));
+        params.update([](Params &value) { value.fields[0] = 4; });
+        check("Update starts from the last publish",
+              params.refresh() && params.value().fields[0] == 4 && params.value().fields[1] == 3);
+    }
+
+    {
+        SharedParams<Params> params;
+        std::atomic<bool> done{false};
+        uint32_t published = 0;
+
+        // The writer keeps publishing until the reader has picked up enough values
+        std::thread writer([&]() {
+            while (!done.load(std::memory_order_relaxed)) {
+                params.publish(Params(++published));
+                std::this_thread::yield(); // Lets the reader run on a single-core host
+            }
+        });
+
+        uint32_t refreshes = 0;
+        uint32_t torn = 0;
+        uint32_t changed = 0;
+        uint32_t backwards = 0;
+        uint32_t last = 0;
+
+        const auto read = [&]() {
+            // The value picked up last must stay as it was while the writer goes on publishing
+            if (!params.value().whole() || params.value().fields[0] != last) {
+                changed++;
+            }
+
+            if (!params.refresh()) {
+                return;
+            }
+
+            const Params &value = params.value();
+            refreshes++;
+
+            if (!value.whole()) {
+                torn++;
+            }
+
+            if (value.fields[0] < last) {
+                backwards++;
+            }
+
+            last = value.fields[0];
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+
+        while (refreshes < refreshCount && std::chrono::steady_clock::now() - start < maxReadTime) {
+            read();
+        }
+
+        done.store(true, std::memory_order_relaxed);
+        writer.join();
+        read();
+
+        check("Concurrent reads see whole publishes", torn == 0, std::to_string(torn) + " torn reads");
+        check("Values do not change until the next refresh", changed == 0, std::to_string(changed) + " changed values");
+        check("Concurrent reads never go backwards", backwards == 0, std::to_string(backwards) + " older values");
+        check("Reader ends on the last publish", last == published,
+              "last read " + std::to_string(last) + " of " + std::to_string(published));
+        std::cout << "  " << refreshes << " values picked up while the writer was publishing" << std::endl;
+    }
+
+    std::cout << "\n=== SharedParams Test Complete ===" << std::endl;
+    return 0;
+}
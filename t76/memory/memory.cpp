@@ -4,33 +4,186 @@
  */
 
 #include "t76/memory.hpp"
+#include "memory_private.hpp"
 
 #include <cstring>
 #include <FreeRTOS.h>
 #include <pico/sync.h>
 #include <hardware/sync.h>
 
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+#ifdef T76_IC_DMA_OFFLOAD
+#include <t76/dma.hpp>
+#endif
+
 #ifdef T76_USE_GLOBAL_LOCKS
 #include <task.h>
 #include <pico/stdlib.h>
 #include <pico/multicore.h>
+#include <hardware/irq.h>
+
+#include <atomic>
 
 // Inter-core memory allocation commands
-#define MEMORY_CMD_ALLOC 0x80000000
-#define MEMORY_CMD_FREE  0x80000001
+#define MEMORY_CMD_ALLOC  0x80000000
+#define MEMORY_CMD_FREE   0x80000001
 
-// Forward declaration
+// Forward declarations
 static void memoryServiceTask(void* pvParameters);
+static void memoryDoorbellHandler();
+
+// Handle of the memory service task, notified from the doorbell interrupt
+static TaskHandle_t gMemoryServiceTaskHandle = nullptr;
+
+// SIO doorbell that wakes the memory service task, or -1 if none was left
+static int gMemoryDoorbell = -1;
+
+static_assert((T76_MEMORY_CORE1_FREE_RING_SIZE & (T76_MEMORY_CORE1_FREE_RING_SIZE - 1)) == 0,
+              "T76_MEMORY_CORE1_FREE_RING_SIZE must be a power of two");
+
+/**
+ * @brief Single-producer, single-consumer ring of pointers freed on Core 1
+ * 
+ * Core 1 is the only writer of the head index and Core 0 (memory service task)
+ * is the only writer of the tail index, so pushing and draining never need a lock.
+ */
+static void* gCore1FreeRing[T76_MEMORY_CORE1_FREE_RING_SIZE];
+static std::atomic<uint32_t> gCore1FreeRingHead{0};
+static std::atomic<uint32_t> gCore1FreeRingTail{0};
 #endif
 
+/**
+ * @brief Copy the contents of a block that is being moved
+ * 
+ * With T76_IC_DMA_OFFLOAD, large blocks are copied by DMA while the calling
+ * task blocks, so that other tasks run in the meantime.
+ */
+static void copyBlock(void* destination, const void* source, size_t size) {
+    #ifdef T76_IC_DMA_OFFLOAD
+        T76::Core::DMA::copy(destination, source, size);
+    #else
+        memcpy(destination, source, size);
+    #endif
+}
+
+/**
+ * @brief Zero a newly allocated block, by DMA under the same conditions as copyBlock()
+ */
+static void clearBlock(void* block, size_t size) {
+    #ifdef T76_IC_DMA_OFFLOAD
+        T76::Core::DMA::fill(block, 0, size);
+    #else
+        memset(block, 0, size);
+    #endif
+}
+
 void T76::Core::Memory::init() {
+    #ifdef T76_MEMORY_USE_STATS
+        // Start counting first so that the pool and slab regions show up as in use
+        if (!statsInit()) {
+            LOGE("Memory: cannot start allocation statistics\n");
+        }
+    #endif
+
+    #ifdef T76_MEMORY_USE_SLAB
+        if (!slabInit()) {
+            LOGE("Memory: cannot carve the slab region; small allocations use the heap\n");
+        }
+    #endif
+
     #ifdef T76_USE_GLOBAL_LOCKS
+        // Carve the core 1 block pools before core 1 is launched
+        if (!core1PoolInit()) {
+            LOGE("Memory: cannot carve the core 1 block pools\n");
+        }
+
         // Start memory service task on core 0 to handle core 1 requests
-        xTaskCreate(memoryServiceTask, "MemSvc", 512, NULL, configMAX_PRIORITIES - 1, NULL);
+        xTaskCreate(memoryServiceTask, "MemSvc", 512, NULL, configMAX_PRIORITIES - 1, &gMemoryServiceTaskHandle);
+
+        // The FreeRTOS port owns the SIO FIFO interrupt, so core 1 wakes the task through a
+        // doorbell. Its interrupt is shared, and the handler only acts on this doorbell.
+        gMemoryDoorbell = multicore_doorbell_claim_unused(1u << 0, false);
+
+        if (gMemoryDoorbell < 0) {
+            LOGE("Memory: no doorbell left; the memory service polls once per tick\n");
+        } else {
+            const uint doorbellIrq = multicore_doorbell_irq_num(gMemoryDoorbell);
+
+            irq_add_shared_handler(doorbellIrq, memoryDoorbellHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+            irq_set_enabled(doorbellIrq, true);
+        }
     #endif
 }
 
 #ifdef T76_USE_GLOBAL_LOCKS
+void T76::Core::Memory::signalMemoryService() {
+    // Never blocks; the service task drains the FIFO, the free ring and
+    // the pool service on every wake-up
+    if (gMemoryDoorbell < 0) {
+        return;
+    }
+
+    if (get_core_num() == 0) {
+        multicore_doorbell_set_current_core(gMemoryDoorbell);
+    } else {
+        multicore_doorbell_set_other_core(gMemoryDoorbell);
+    }
+}
+
+/**
+ * @brief Doorbell handler running on Core 0
+ * 
+ * Clears the doorbell and hands the work to the memory service task through
+ * a task notification. A doorbell rung before the scheduler starts is only
+ * cleared, since the task drains everything on its first run anyway.
+ */
+static void memoryDoorbellHandler() {
+    if (!multicore_doorbell_is_set_current_core(gMemoryDoorbell)) {
+        return;
+    }
+
+    multicore_doorbell_clear_current_core(gMemoryDoorbell);
+
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return;
+    }
+
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(gMemoryServiceTaskHandle, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+/**
+ * @brief Free every pointer queued in the Core 1 free ring
+ * 
+ * Runs on Core 0 from the memory service task. The tail is published and the
+ * head re-read with sequentially-consistent ordering, pairing with
+ * core1_deferred_free(): either this loop sees a pointer pushed concurrently,
+ * or Core 1 sees the ring as empty and rings the doorbell again.
+ */
+static void drainCore1FreeRing() {
+    uint32_t tail = gCore1FreeRingTail.load(std::memory_order_relaxed);
+
+    while (true) {
+        const uint32_t head = gCore1FreeRingHead.load(std::memory_order_seq_cst);
+
+        if (tail == head) {
+            break;
+        }
+
+        while (tail != head) {
+            vPortFree(gCore1FreeRing[tail & (T76_MEMORY_CORE1_FREE_RING_SIZE - 1)]);
+            tail++;
+        }
+
+        gCore1FreeRingTail.store(tail, std::memory_order_seq_cst);
+    }
+}
+
 /**
  * @brief FreeRTOS task that handles memory allocation requests from Core 1
  * 
@@ -38,11 +191,24 @@ void T76::Core::Memory::init() {
  * requests from Core 1 via the inter-core FIFO. It ensures all heap operations
  * are performed within the FreeRTOS environment on Core 0.
  * 
+ * Core 1 rings a doorbell after each request it pushes into the FIFO. The
+ * task drains every pending request in a single batch, then sleeps until the
+ * doorbell interrupt notifies it, so it does not wake up at all while Core 1
+ * is idle. If no doorbell was left, it polls once per tick instead.
+ * 
+ * On every wake-up the task also drains the Core 1 deferred free ring and
+ * refills the Core 1 block pools whenever Core 1 reports that a size class
+ * is running low.
+ * 
  * @param pvParameters Unused FreeRTOS task parameter
  */
 static void memoryServiceTask(void* pvParameters) {
+    (void)pvParameters;
+
+    // The first pass picks up anything Core 1 sent before the scheduler started
     while (1) {
-        if (multicore_fifo_rvalid()) {
+        // Drain all pending requests in one batch
+        while (multicore_fifo_rvalid()) {
             uint32_t cmd = multicore_fifo_pop_blocking();
             
             if ((cmd & 0xFF000000) == 0x80000000) {
@@ -63,9 +229,12 @@ static void memoryServiceTask(void* pvParameters) {
                 }
             }
         }
-        
-        // Small delay to prevent busy waiting
-        vTaskDelay(pdMS_TO_TICKS(1));
+
+        drainCore1FreeRing();
+        T76::Core::Memory::core1PoolService();
+
+        // A doorbell rung during the pass leaves a notification pending, so nothing is missed
+        ulTaskNotifyTake(pdTRUE, gMemoryDoorbell < 0 ? 1 : portMAX_DELAY);
     }
 }
 
@@ -81,6 +250,7 @@ static void memoryServiceTask(void* pvParameters) {
 static void* core1_alloc_proxy(size_t size) {
     multicore_fifo_push_blocking(MEMORY_CMD_ALLOC);
     multicore_fifo_push_blocking((uint32_t)size);
+    T76::Core::Memory::signalMemoryService();
     return (void*)multicore_fifo_pop_blocking();
 }
 
@@ -88,93 +258,296 @@ static void* core1_alloc_proxy(size_t size) {
  * @brief Core 1 proxy function for memory deallocation
  * 
  * Sends free request to Core 0 via inter-core FIFO and waits for acknowledgment.
- * This function blocks until Core 0 processes the request.
+ * This function blocks until Core 0 processes the request. Only used when the
+ * deferred free ring is full.
  * 
  * @param ptr Pointer to memory to free
  */
 static void core1_free_proxy(void* ptr) {
     multicore_fifo_push_blocking(MEMORY_CMD_FREE);
     multicore_fifo_push_blocking((uint32_t)ptr);
+    T76::Core::Memory::signalMemoryService();
     multicore_fifo_pop_blocking(); // Wait for acknowledge
 }
+
+/**
+ * @brief Queue a Core 1 free for the memory service task without blocking
+ * 
+ * Pushes the pointer into the deferred free ring. The doorbell is only rung
+ * when the ring was empty, since a non-empty ring means the service task has
+ * already been woken and has not finished draining yet.
+ * 
+ * @param ptr Pointer to memory to free
+ * @return true if the free was queued, false if the ring is full
+ */
+static bool core1_deferred_free(void* ptr) {
+    const uint32_t head = gCore1FreeRingHead.load(std::memory_order_relaxed);
+
+    if (head - gCore1FreeRingTail.load(std::memory_order_acquire) >= T76_MEMORY_CORE1_FREE_RING_SIZE) {
+        return false;
+    }
+
+    gCore1FreeRing[head & (T76_MEMORY_CORE1_FREE_RING_SIZE - 1)] = ptr;
+    gCore1FreeRingHead.store(head + 1, std::memory_order_seq_cst);
+
+    if (gCore1FreeRingTail.load(std::memory_order_seq_cst) == head) {
+        T76::Core::Memory::signalMemoryService();
+    }
+
+    return true;
+}
+#endif
+
+#ifdef T76_MEMORY_USE_STATS
+/**
+ * @brief Get the usable size of a block returned by T76MemoryAlloc()
+ * 
+ * @param ptr Pointer to a Core 1 pool block or a heap block
+ * @return Usable size of the block in bytes
+ */
+static size_t blockUsableSize(void* ptr) {
+    #ifdef T76_USE_GLOBAL_LOCKS
+        const size_t poolBlockSize = T76::Core::Memory::core1PoolBlockSize(ptr);
+
+        if (poolBlockSize > 0) {
+            return poolBlockSize;
+        }
+    #endif
+
+    return T76::Core::Memory::heapUsableSize(ptr);
+}
 #endif
 
 /**
  * @brief Core memory allocation function
  * 
  * Allocates memory from the FreeRTOS heap. Behavior depends on T76_USE_GLOBAL_LOCKS:
- * - When enabled: Core 0 allocates directly, Core 1 proxies through Core 0
- * - When disabled: Direct allocation (assumes single-core usage)
+ * - When enabled: Core 0 allocates directly, Core 1 allocates from its lock-free
+ *   block pool and only proxies through Core 0 for large or pool-exhausted requests
+ * - When disabled: Direct allocation (assumes single-core usage, or T76_IC_SMP)
  * 
  * @param size Number of bytes to allocate
  * @return Pointer to allocated memory, or NULL if allocation failed
  */
 void *T76MemoryAlloc(size_t size) {
+    void* ptr;
+
     #ifdef T76_USE_GLOBAL_LOCKS
         if (get_core_num() == 0) {
             // Core 0: Direct FreeRTOS allocation
-            return pvPortMalloc(size);
+            ptr = pvPortMalloc(size);
         } else {
-            // Core 1: Proxy through core 0
-            return core1_alloc_proxy(size);
+            // Core 1: Lock-free pool first, proxy through core 0 as a fallback
+            ptr = T76::Core::Memory::core1PoolAlloc(size);
+
+            if (ptr == nullptr) {
+                ptr = core1_alloc_proxy(size);
+            }
         }
     #else
-        // Single core mode - assume only core 0 allocates
-        return pvPortMalloc(size);
+        // Single core mode - assume only core 0 allocates, or SMP mode, where the kernel locks the heap on both cores
+        ptr = pvPortMalloc(size);
+    #endif
+
+    #ifdef T76_MEMORY_USE_STATS
+        if (ptr) {
+            T76::Core::Memory::statsRecordAlloc(size, blockUsableSize(ptr));
+        } else {
+            T76::Core::Memory::statsRecordFailure(size);
+        }
     #endif
+
+    return ptr;
 }
 
 /**
  * @brief Core memory deallocation function
  * 
  * Frees memory back to the FreeRTOS heap. Behavior depends on T76_USE_GLOBAL_LOCKS:
- * - When enabled: Core 0 frees directly, Core 1 proxies through Core 0
- * - When disabled: Direct deallocation (assumes single-core usage)
+ * - When enabled: Pool blocks are returned lock-free from either core; other
+ *   blocks are freed directly on Core 0 and queued to Core 0 from Core 1
+ *   through a non-blocking deferred free ring
+ * - When disabled: Direct deallocation (assumes single-core usage, or T76_IC_SMP)
  * 
  * @param ptr Pointer to memory to free (NULL is safely ignored)
  */
 void T76MemoryFree(void* ptr) {
     if (ptr == NULL) return;
+
+    #ifdef T76_MEMORY_USE_STATS
+        T76::Core::Memory::statsRecordFree(blockUsableSize(ptr));
+    #endif
     
     #ifdef T76_USE_GLOBAL_LOCKS
+        if (T76::Core::Memory::core1PoolFree(ptr)) {
+            // Block belonged to the core 1 pool
+            return;
+        }
+
         if (get_core_num() == 0) {
             // Core 0: Direct FreeRTOS free
             vPortFree(ptr);
         } else {
-            // Core 1: Proxy through core 0
-            core1_free_proxy(ptr);
+            // Core 1: Defer to core 0 without blocking, handshake only if the ring is full
+            if (!core1_deferred_free(ptr)) {
+                core1_free_proxy(ptr);
+            }
         }
     #else
-        // Single core mode - assume only core 0 frees
+        // Single core mode - assume only core 0 frees, or SMP mode, where the kernel locks the heap on both cores
         vPortFree(ptr);
     #endif
 }
 
+/**
+ * @brief Core memory reallocation function
+ * 
+ * Resizes a previously allocated block using the allocator metadata to learn
+ * its current size:
+ * - Requests that fit in the current block are served in place; on Core 0,
+ *   heap blocks are also shrunk and the tail is returned to the heap
+ * - Larger requests allocate a new block and copy only the old contents
+ * 
+ * @param ptr Pointer to previously allocated memory (NULL to allocate new)
+ * @param size New size in bytes (0 to free memory)
+ * @return Pointer to resized memory, or NULL if allocation failed (in which
+ *         case the original block is left untouched)
+ */
+void* T76MemoryRealloc(void* ptr, size_t size) {
+    if (ptr == nullptr) {
+        return T76MemoryAlloc(size); // If ptr is null, allocate new memory
+    }
+
+    if (size == 0) {
+        T76MemoryFree(ptr); // If size is zero, free the memory
+        return nullptr;
+    }
+
+    size_t oldSize;
+    bool isHeapBlock = true;
+
+    #ifdef T76_USE_GLOBAL_LOCKS
+        oldSize = T76::Core::Memory::core1PoolBlockSize(ptr);
+
+        if (oldSize > 0) {
+            isHeapBlock = false;
+        } else {
+            oldSize = T76::Core::Memory::heapUsableSize(ptr);
+        }
+    #else
+        oldSize = T76::Core::Memory::heapUsableSize(ptr);
+    #endif
+
+    if (size <= oldSize) {
+        bool canShrink = isHeapBlock;
+
+        #ifdef T76_USE_GLOBAL_LOCKS
+            // Core 1 must not touch the heap directly
+            canShrink = canShrink && get_core_num() == 0;
+        #endif
+
+        if (canShrink) {
+            T76::Core::Memory::heapShrinkInPlace(ptr, size);
+
+            #ifdef T76_MEMORY_USE_STATS
+                T76::Core::Memory::statsRecordResize(oldSize, T76::Core::Memory::heapUsableSize(ptr));
+            #endif
+        }
+
+        return ptr;
+    }
+
+    void* newPtr = T76MemoryAlloc(size);
+
+    if (newPtr) {
+        copyBlock(newPtr, ptr, oldSize); // Copy only the old contents
+        T76MemoryFree(ptr); // Free old memory
+    }
+
+    return newPtr;
+}
+
+/**
+ * @brief Object allocation function used by the C++ new overrides
+ * 
+ * Tries the slab front-end first when T76_MEMORY_USE_SLAB is enabled and
+ * otherwise falls through to T76MemoryAlloc(). In multi-core mode, Core 1
+ * always bypasses the slab in favor of its own lock-free pool.
+ * 
+ * @param size Number of bytes to allocate
+ * @return Pointer to allocated memory, or NULL if allocation failed
+ */
+static inline void* T76MemoryNew(size_t size) {
+    #ifdef T76_MEMORY_USE_SLAB
+        #ifdef T76_USE_GLOBAL_LOCKS
+        if (get_core_num() == 0)
+        #endif
+        {
+            void* ptr = T76::Core::Memory::slabAlloc(size);
+
+            if (ptr) {
+                #ifdef T76_MEMORY_USE_STATS
+                    T76::Core::Memory::statsRecordAlloc(size, T76::Core::Memory::slabBlockSize(ptr));
+                #endif
+
+                return ptr;
+            }
+        }
+    #endif
+
+    return T76MemoryAlloc(size);
+}
+
+/**
+ * @brief Object deallocation function used by the C++ delete overrides
+ * 
+ * Returns slab blocks to their class and hands everything else to T76MemoryFree().
+ * 
+ * @param ptr Pointer to memory to free (NULL is safely ignored)
+ */
+static inline void T76MemoryDelete(void* ptr) {
+    #ifdef T76_MEMORY_USE_SLAB
+        #ifdef T76_MEMORY_USE_STATS
+            const size_t slabBlockSize = T76::Core::Memory::slabBlockSize(ptr);
+        #endif
+
+        if (T76::Core::Memory::slabFree(ptr)) {
+            #ifdef T76_MEMORY_USE_STATS
+                T76::Core::Memory::statsRecordFree(slabBlockSize);
+            #endif
+
+            return;
+        }
+    #endif
+
+    T76MemoryFree(ptr);
+}
+
 /**
  * @brief C++ new operator override (single object)
  * @param size Size in bytes to allocate
  * @return Pointer to allocated memory
  */
-void * operator new( size_t size ) { return T76MemoryAlloc( size ); } 
+void * operator new( size_t size ) { return T76MemoryNew( size ); } 
 
 /**
  * @brief C++ new[] operator override (array allocation)
  * @param size Size in bytes to allocate
  * @return Pointer to allocated memory
  */
-void * operator new[]( size_t size ) { return T76MemoryAlloc(size); } 
+void * operator new[]( size_t size ) { return T76MemoryNew(size); } 
 
 /**
  * @brief C++ delete operator override (single object)
  * @param ptr Pointer to memory to free
  */
-void operator delete( void * ptr ) { T76MemoryFree ( ptr ); } 
+void operator delete( void * ptr ) { T76MemoryDelete ( ptr ); } 
 
 /**
  * @brief C++ delete[] operator override (array deallocation)
  * @param ptr Pointer to memory to free
  */
-void operator delete[]( void * ptr ) { T76MemoryFree ( ptr ); }
+void operator delete[]( void * ptr ) { T76MemoryDelete ( ptr ); }
 
 /**
  * @brief C malloc function override
@@ -206,7 +579,7 @@ extern "C" void* calloc(size_t num, size_t size) {
     void* ptr = T76MemoryAlloc(num * size);
 
     if (ptr) {
-        memset(ptr, 0, num * size); // Initialize allocated memory to zero
+        clearBlock(ptr, num * size); // Initialize allocated memory to zero
     }
 
     return ptr;
@@ -215,30 +588,15 @@ extern "C" void* calloc(size_t num, size_t size) {
 /**
  * @brief C realloc function override
  * 
- * Resizes a previously allocated memory block. Note: This implementation 
- * always copies the entire old size, which may be inefficient for large
- * blocks being grown. Consider this limitation for performance-critical code.
+ * Resizes a previously allocated memory block, in place whenever possible.
+ * See T76MemoryRealloc() for details.
  * 
  * @param ptr Pointer to previously allocated memory (NULL to allocate new)
  * @param size New size in bytes (0 to free memory)
  * @return Pointer to resized memory, or NULL if allocation failed
  */
 extern "C" void* realloc(void* ptr, size_t size) {
-    if (ptr == nullptr) {
-        return T76MemoryAlloc(size); // If ptr is null, allocate new memory
-    }
-
-    if (size == 0) {
-        T76MemoryFree(ptr); // If size is zero, free the memory
-        return nullptr;
-    }
-    
-    void* newPtr = T76MemoryAlloc(size);
-    if (newPtr) {
-        memcpy(newPtr, ptr, size); // Copy old data to new memory
-        T76MemoryFree(ptr); // Free old memory
-    }
-    return newPtr;
+    return T76MemoryRealloc(ptr, size);
 }
 
 /**
@@ -259,7 +617,7 @@ extern "C" void* __wrap_malloc(size_t size) {
 extern "C" void* __wrap_calloc(size_t num, size_t size) {
     void* ptr = T76MemoryAlloc(num * size);
     if (ptr) {
-        memset(ptr, 0, num * size); // Initialize allocated memory to zero
+        clearBlock(ptr, num * size); // Initialize allocated memory to zero
     }
     return ptr;
 }
@@ -267,26 +625,14 @@ extern "C" void* __wrap_calloc(size_t num, size_t size) {
 /**
  * @brief Linker wrapper for realloc (used with --wrap=realloc)
  * 
- * Resizes a previously allocated memory block. Same limitations as regular realloc.
+ * Resizes a previously allocated memory block. Same behavior as regular realloc.
  * 
  * @param ptr Pointer to previously allocated memory (NULL to allocate new)
  * @param size New size in bytes (0 to free memory)
  * @return Pointer to resized memory, or NULL if allocation failed
  */
 extern "C" void* __wrap_realloc(void* ptr, size_t size) {
-    if (ptr == nullptr) {
-        return T76MemoryAlloc(size); // If ptr is null, allocate new memory
-    }
-    if (size == 0) {
-        T76MemoryFree(ptr); // If size is zero, free the memory
-        return nullptr;
-    }
-    void* newPtr = T76MemoryAlloc(size);
-    if (newPtr) {
-        memcpy(newPtr, ptr, size); // Copy old data to new memory
-        T76MemoryFree(ptr); // Free old memory
-    }
-    return newPtr;
+    return T76MemoryRealloc(ptr, size);
 }
 
 /**
@@ -0,0 +1,45 @@
+/**
+ * @file memory_arena.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Storage management for the scoped bump-pointer arena.
+ */
+
+#include "t76/memory_arena.hpp"
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+namespace T76::Core::Memory {
+
+    Arena::Arena(size_t capacity) :
+        _buffer(static_cast<uint8_t*>(::operator new(capacity))),
+        _capacity(_buffer == nullptr ? 0 : capacity),
+        _used(0),
+        _highWaterMark(0),
+        _failedCount(0),
+        _ownsBuffer(true) {
+
+        if (_buffer == nullptr) {
+            LOGE("Memory: no heap left for a %lu-byte arena\n", (unsigned long)capacity);
+        }
+    }
+
+    Arena::Arena(void* buffer, size_t capacity) :
+        _buffer(static_cast<uint8_t*>(buffer)),
+        _capacity(buffer == nullptr ? 0 : capacity),
+        _used(0),
+        _highWaterMark(0),
+        _failedCount(0),
+        _ownsBuffer(false) {
+    }
+
+    Arena::~Arena() {
+        if (_ownsBuffer) {
+            ::operator delete(_buffer);
+        }
+    }
+
+} // namespace T76::Core::Memory
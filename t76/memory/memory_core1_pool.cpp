@@ -0,0 +1,283 @@
+/**
+ * @file memory_core1_pool.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Lock-free block pool for Core 1 allocations in multi-core mode.
+ *
+ * When T76_USE_GLOBAL_LOCKS is enabled, small allocations made on Core 1 are
+ * served from fixed-size block pools instead of being proxied to Core 0
+ * through the inter-core FIFO. This keeps allocation and deallocation on
+ * Core 1 down to a handful of atomic instructions with no dependency on the
+ * FreeRTOS scheduler.
+ *
+ * Design:
+ * - Blocks are grouped into power-of-two size classes (32 to 256 bytes)
+ * - Each class is backed by up to T76_MEMORY_CORE1_POOL_MAX_CHUNKS contiguous
+ *   chunks carved from the FreeRTOS heap on Core 0
+ * - Free blocks form a per-class Treiber stack. The stack head packs a 16-bit
+ *   block index with a 16-bit ABA tag, so push and pop are a single
+ *   compare-and-swap that is safe from both cores
+ * - Ownership is determined by address range, so blocks can be freed from
+ *   either core without any per-block header
+ * - When a class runs low, Core 1 raises a refill flag, rings the memory
+ *   service task through the inter-core FIFO, and the task carves another
+ *   chunk on Core 0 in the background
+ *
+ * Chunks are never returned to the heap once carved.
+ */
+
+#include "memory_private.hpp"
+
+#ifdef T76_USE_GLOBAL_LOCKS
+
+#include <atomic>
+
+#include <FreeRTOS.h>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+namespace T76::Core::Memory {
+
+    static constexpr uint16_t POOL_EMPTY_INDEX = 0xFFFF;            ///< Sentinel index marking an empty stack
+    static constexpr uint32_t POOL_INDEX_MASK = 0x0000FFFF;         ///< Block index portion of a stack head
+    static constexpr uint32_t POOL_TAG_INCREMENT = 0x00010000;      ///< ABA tag increment applied on every update
+
+    /**
+     * @brief Block sizes for each pool class, in ascending order
+     */
+    static constexpr uint32_t POOL_CLASS_SIZES[T76_MEMORY_CORE1_POOL_CLASS_COUNT] = { 32, 64, 128, 256 };
+
+    static_assert(POOL_CLASS_SIZES[T76_MEMORY_CORE1_POOL_CLASS_COUNT - 1] == T76_MEMORY_CORE1_POOL_MAX_BLOCK_SIZE,
+                  "Largest Core 1 pool class must match T76_MEMORY_CORE1_POOL_MAX_BLOCK_SIZE");
+
+    /**
+     * @brief State for a single pool size class
+     */
+    struct PoolClass {
+        uint32_t blockSize;                                         ///< Size of each block in bytes
+        std::atomic<uint32_t> head;                                 ///< Free stack head (tag << 16 | index)
+        std::atomic<uint32_t> freeCount;                            ///< Approximate number of free blocks
+        std::atomic<uint32_t> chunkCount;                           ///< Number of chunks published to both cores
+        uint8_t* chunks[T76_MEMORY_CORE1_POOL_MAX_CHUNKS];          ///< Base address of each chunk
+    };
+
+    static PoolClass gPoolClasses[T76_MEMORY_CORE1_POOL_CLASS_COUNT];
+
+    /**
+     * @brief Set by Core 1 when a class drops below the low watermark
+     */
+    static std::atomic<bool> gPoolRefillRequested{false};
+
+    /**
+     * @brief Translate a block index into its address
+     */
+    static inline uint8_t* blockAddress(const PoolClass& poolClass, uint32_t index) {
+        const uint32_t chunk = index / T76_MEMORY_CORE1_POOL_BLOCKS_PER_CHUNK;
+        const uint32_t offset = index % T76_MEMORY_CORE1_POOL_BLOCKS_PER_CHUNK;
+
+        return poolClass.chunks[chunk] + offset * poolClass.blockSize;
+    }
+
+    /**
+     * @brief Push a block onto a class's free stack
+     *
+     * The index of the next free block is stored in the first two bytes of
+     * the freed block itself.
+     */
+    static inline void pushBlock(PoolClass& poolClass, uint16_t index) {
+        uint16_t* nextSlot = reinterpret_cast<uint16_t*>(blockAddress(poolClass, index));
+        uint32_t oldHead = poolClass.head.load(std::memory_order_relaxed);
+        uint32_t newHead;
+
+        do {
+            *nextSlot = static_cast<uint16_t>(oldHead & POOL_INDEX_MASK);
+            newHead = ((oldHead + POOL_TAG_INCREMENT) & ~POOL_INDEX_MASK) | index;
+        } while (!poolClass.head.compare_exchange_weak(oldHead, newHead,
+                                                       std::memory_order_release,
+                                                       std::memory_order_relaxed));
+
+        poolClass.freeCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pop a block from a class's free stack
+     *
+     * @return Pointer to the block, or nullptr if the stack is empty
+     */
+    static inline void* popBlock(PoolClass& poolClass) {
+        uint32_t oldHead = poolClass.head.load(std::memory_order_acquire);
+
+        while (true) {
+            const uint16_t index = static_cast<uint16_t>(oldHead & POOL_INDEX_MASK);
+
+            if (index == POOL_EMPTY_INDEX) {
+                return nullptr;
+            }
+
+            uint8_t* block = blockAddress(poolClass, index);
+
+            // If another core wins the race, the tag changes and the CAS below
+            // fails, so a stale read of the next index here is harmless.
+            const uint16_t next = *reinterpret_cast<volatile uint16_t*>(block);
+            const uint32_t newHead = ((oldHead + POOL_TAG_INCREMENT) & ~POOL_INDEX_MASK) | next;
+
+            if (poolClass.head.compare_exchange_weak(oldHead, newHead,
+                                                     std::memory_order_acquire,
+                                                     std::memory_order_acquire)) {
+                poolClass.freeCount.fetch_sub(1, std::memory_order_relaxed);
+                return block;
+            }
+        }
+    }
+
+    /**
+     * @brief Carve a new chunk from the FreeRTOS heap and publish its blocks
+     *
+     * Must only be called from Core 0. The chunk pointer is published before
+     * any of its blocks become reachable through the free stack.
+     *
+     * @return true if a chunk was added, false if the class is at its chunk
+     *         limit or the heap is exhausted
+     */
+    static bool addChunk(PoolClass& poolClass) {
+        const uint32_t chunkIndex = poolClass.chunkCount.load(std::memory_order_relaxed);
+
+        if (chunkIndex >= T76_MEMORY_CORE1_POOL_MAX_CHUNKS) {
+            return false;
+        }
+
+        uint8_t* chunk = static_cast<uint8_t*>(pvPortMalloc(poolClass.blockSize * T76_MEMORY_CORE1_POOL_BLOCKS_PER_CHUNK));
+
+        if (chunk == nullptr) {
+            LOGW("Memory: no heap left for another chunk of %lu-byte core 1 blocks\n", (unsigned long)poolClass.blockSize);
+            return false;
+        }
+
+        poolClass.chunks[chunkIndex] = chunk;
+        poolClass.chunkCount.store(chunkIndex + 1, std::memory_order_release);
+
+        const uint32_t firstIndex = chunkIndex * T76_MEMORY_CORE1_POOL_BLOCKS_PER_CHUNK;
+
+        for (uint32_t i = 0; i < T76_MEMORY_CORE1_POOL_BLOCKS_PER_CHUNK; i++) {
+            pushBlock(poolClass, static_cast<uint16_t>(firstIndex + i));
+        }
+
+        return true;
+    }
+
+    bool core1PoolInit() {
+        bool success = true;
+
+        for (uint32_t i = 0; i < T76_MEMORY_CORE1_POOL_CLASS_COUNT; i++) {
+            PoolClass& poolClass = gPoolClasses[i];
+
+            poolClass.blockSize = POOL_CLASS_SIZES[i];
+            poolClass.head.store(POOL_EMPTY_INDEX, std::memory_order_relaxed);
+            poolClass.freeCount.store(0, std::memory_order_relaxed);
+            poolClass.chunkCount.store(0, std::memory_order_relaxed);
+
+            if (!addChunk(poolClass)) {
+                success = false;
+            }
+        }
+
+        return success;
+    }
+
+    void* core1PoolAlloc(size_t size) {
+        if (size > T76_MEMORY_CORE1_POOL_MAX_BLOCK_SIZE) {
+            return nullptr;
+        }
+
+        // Start from the smallest class that fits and move up if it is exhausted
+        for (uint32_t i = 0; i < T76_MEMORY_CORE1_POOL_CLASS_COUNT; i++) {
+            PoolClass& poolClass = gPoolClasses[i];
+
+            if (size > poolClass.blockSize) {
+                continue;
+            }
+
+            void* block = popBlock(poolClass);
+
+            if (poolClass.freeCount.load(std::memory_order_relaxed) < T76_MEMORY_CORE1_POOL_LOW_WATERMARK) {
+                // Only ring the doorbell on the first request since the last service run
+                if (!gPoolRefillRequested.exchange(true, std::memory_order_relaxed)) {
+                    signalMemoryService();
+                }
+            }
+
+            if (block != nullptr) {
+                return block;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Find the pool class and block index that own a pointer
+     *
+     * @return Pointer to the owning class, or nullptr if the pointer does not
+     *         belong to any pool chunk
+     */
+    static PoolClass* findBlock(const void* ptr, uint16_t& index) {
+        const uint8_t* address = static_cast<const uint8_t*>(ptr);
+
+        for (uint32_t i = 0; i < T76_MEMORY_CORE1_POOL_CLASS_COUNT; i++) {
+            PoolClass& poolClass = gPoolClasses[i];
+            const uint32_t chunkCount = poolClass.chunkCount.load(std::memory_order_acquire);
+            const uint32_t chunkBytes = poolClass.blockSize * T76_MEMORY_CORE1_POOL_BLOCKS_PER_CHUNK;
+
+            for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+                const uint8_t* base = poolClass.chunks[chunk];
+
+                if (address >= base && address < base + chunkBytes) {
+                    const uint32_t offset = static_cast<uint32_t>(address - base) / poolClass.blockSize;
+                    index = static_cast<uint16_t>(chunk * T76_MEMORY_CORE1_POOL_BLOCKS_PER_CHUNK + offset);
+                    return &poolClass;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool core1PoolFree(void* ptr) {
+        uint16_t index;
+        PoolClass* poolClass = findBlock(ptr, index);
+
+        if (poolClass == nullptr) {
+            return false;
+        }
+
+        pushBlock(*poolClass, index);
+        return true;
+    }
+
+    size_t core1PoolBlockSize(const void* ptr) {
+        uint16_t index;
+        const PoolClass* poolClass = findBlock(ptr, index);
+
+        return poolClass == nullptr ? 0 : poolClass->blockSize;
+    }
+
+    void core1PoolService() {
+        if (!gPoolRefillRequested.exchange(false, std::memory_order_relaxed)) {
+            return;
+        }
+
+        for (uint32_t i = 0; i < T76_MEMORY_CORE1_POOL_CLASS_COUNT; i++) {
+            PoolClass& poolClass = gPoolClasses[i];
+
+            if (poolClass.freeCount.load(std::memory_order_relaxed) < T76_MEMORY_CORE1_POOL_LOW_WATERMARK) {
+                addChunk(poolClass);
+            }
+        }
+    }
+
+} // namespace T76::Core::Memory
+
+#endif // T76_USE_GLOBAL_LOCKS
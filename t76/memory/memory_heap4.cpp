@@ -0,0 +1,81 @@
+/**
+ * @file memory_heap4.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Block metadata helpers for the FreeRTOS heap_4 allocator backend.
+ *
+ * heap_4 does not expose the size of an allocated block, so these helpers
+ * mirror its block header layout in order to implement in-place realloc.
+ * Only compiled when T76_MEMORY_ALLOCATOR is FREERTOS (the default).
+ */
+
+#include "memory_private.hpp"
+
+#ifndef T76_MEMORY_ALLOCATOR_TLSF
+
+#include <FreeRTOS.h>
+
+namespace T76::Core::Memory {
+
+    /**
+     * @brief Mirror of the heap_4 block header that precedes every heap allocation
+     *
+     * heap_4 stores the total block size (header included) in xBlockSize and marks
+     * allocated blocks by setting its most significant bit. Allocated blocks always
+     * have a null pxNextFreeBlock.
+     */
+    typedef struct HeapBlockHeader {
+        struct HeapBlockHeader* nextFreeBlock;  ///< Mirrors BlockLink_t::pxNextFreeBlock
+        size_t blockSize;                       ///< Mirrors BlockLink_t::xBlockSize
+    } HeapBlockHeader;
+
+    static const size_t HEAP_HEADER_SIZE = (sizeof(HeapBlockHeader) + (portBYTE_ALIGNMENT - 1)) & ~((size_t)portBYTE_ALIGNMENT_MASK);
+    static const size_t HEAP_MINIMUM_BLOCK_SIZE = HEAP_HEADER_SIZE << 1;
+    static const size_t HEAP_BLOCK_ALLOCATED_BIT = ((size_t)1) << ((sizeof(size_t) * 8) - 1);
+
+#if defined(configENABLE_HEAP_PROTECTOR) && (configENABLE_HEAP_PROTECTOR == 1)
+    // Heap protector obfuscates block pointers, so in-place splitting is not possible
+    #define T76_MEMORY_HEAP_CAN_SPLIT 0
+#else
+    #define T76_MEMORY_HEAP_CAN_SPLIT 1
+#endif
+
+    /**
+     * @brief Get the heap_4 header of an allocated heap block
+     */
+    static inline HeapBlockHeader* heapBlockHeader(void* ptr) {
+        return (HeapBlockHeader*)((uint8_t*)ptr - HEAP_HEADER_SIZE);
+    }
+
+    size_t heapUsableSize(void* ptr) {
+        return (heapBlockHeader(ptr)->blockSize & ~HEAP_BLOCK_ALLOCATED_BIT) - HEAP_HEADER_SIZE;
+    }
+
+    void heapShrinkInPlace(void* ptr, size_t size) {
+#if T76_MEMORY_HEAP_CAN_SPLIT
+        // Split the block in two and hand the tail back to heap_4 as if it were
+        // a separate allocation; vPortFree() coalesces it with adjacent free blocks
+        HeapBlockHeader* header = heapBlockHeader(ptr);
+        const size_t blockSize = header->blockSize & ~HEAP_BLOCK_ALLOCATED_BIT;
+        const size_t wantedSize = HEAP_HEADER_SIZE + ((size + portBYTE_ALIGNMENT_MASK) & ~((size_t)portBYTE_ALIGNMENT_MASK));
+
+        // Only split off tails that heap_4 could track as a block of their own
+        if (blockSize - wantedSize < HEAP_MINIMUM_BLOCK_SIZE) {
+            return;
+        }
+
+        HeapBlockHeader* tail = (HeapBlockHeader*)((uint8_t*)header + wantedSize);
+        tail->nextFreeBlock = nullptr;
+        tail->blockSize = (blockSize - wantedSize) | HEAP_BLOCK_ALLOCATED_BIT;
+        header->blockSize = wantedSize | HEAP_BLOCK_ALLOCATED_BIT;
+
+        vPortFree((uint8_t*)tail + HEAP_HEADER_SIZE);
+#else
+        (void)ptr;
+        (void)size;
+#endif
+    }
+
+} // namespace T76::Core::Memory
+
+#endif // T76_MEMORY_ALLOCATOR_TLSF
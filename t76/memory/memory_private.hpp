@@ -0,0 +1,216 @@
+/**
+ * @file memory_private.hpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Private internal definitions for the memory management system.
+ *
+ * This file contains the declarations shared between the memory system
+ * implementation files. It is not part of the public API and should only
+ * be included by files in the memory library.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace T76::Core::Memory {
+
+    /**
+     * @brief Get the number of usable bytes in an allocated heap block
+     *
+     * Implemented by the active allocator backend (heap_4 or TLSF) by reading
+     * the block header that precedes the allocation.
+     *
+     * @param ptr Pointer returned by pvPortMalloc()
+     * @return Usable size of the block in bytes
+     */
+    size_t heapUsableSize(void* ptr);
+
+    /**
+     * @brief Shrink an allocated heap block in place
+     *
+     * Returns the unused tail of the block to the heap when it is large enough
+     * to form a block of its own. Must only be called from Core 0.
+     *
+     * @param ptr Pointer returned by pvPortMalloc()
+     * @param size New size in bytes (must not exceed the current usable size)
+     */
+    void heapShrinkInPlace(void* ptr, size_t size);
+
+} // namespace T76::Core::Memory
+
+#ifdef T76_MEMORY_USE_STATS
+
+namespace T76::Core::Memory {
+
+    /**
+     * @brief Start allocation instrumentation
+     *
+     * Until this has been called, the record functions below do nothing.
+     *
+     * @return true if instrumentation was started, false otherwise
+     */
+    bool statsInit();
+
+    /**
+     * @brief Record a successful allocation for the calling task or core
+     *
+     * @param requestedSize Number of bytes requested
+     * @param blockSize Usable size of the block that was returned
+     */
+    void statsRecordAlloc(size_t requestedSize, size_t blockSize);
+
+    /**
+     * @brief Record a failed allocation
+     *
+     * @param requestedSize Number of bytes requested
+     */
+    void statsRecordFailure(size_t requestedSize);
+
+    /**
+     * @brief Record a free for the calling task or core
+     *
+     * @param blockSize Usable size of the block being freed
+     */
+    void statsRecordFree(size_t blockSize);
+
+    /**
+     * @brief Record an in-place resize by realloc
+     *
+     * @param oldBlockSize Usable size of the block before the resize
+     * @param newBlockSize Usable size of the block after the resize
+     */
+    void statsRecordResize(size_t oldBlockSize, size_t newBlockSize);
+
+} // namespace T76::Core::Memory
+
+#endif // T76_MEMORY_USE_STATS
+
+#ifdef T76_MEMORY_USE_SLAB
+
+// === Slab Front-End Configuration ===
+#define T76_MEMORY_SLAB_CLASS_COUNT 6               ///< Number of slab size classes (8 to 256 bytes)
+#define T76_MEMORY_SLAB_MAX_BLOCK_SIZE 256          ///< Largest request (bytes) served by the slab
+
+namespace T76::Core::Memory {
+
+    /**
+     * @brief Carve the slab region from the FreeRTOS heap
+     *
+     * Until this has been called, slabAlloc() always returns nullptr so that
+     * objects constructed before initialization come from the heap.
+     *
+     * @return true if the slab region was carved, false otherwise
+     */
+    bool slabInit();
+
+    /**
+     * @brief Allocate a block from the slab
+     *
+     * @param size Number of bytes requested
+     * @return Pointer to a block of at least size bytes, or nullptr if the
+     *         request is too large or its class is exhausted (a miss)
+     */
+    void* slabAlloc(size_t size);
+
+    /**
+     * @brief Return a block to the slab
+     *
+     * Safe to call from either core. Pointers outside the slab region are
+     * left untouched.
+     *
+     * @param ptr Pointer to release
+     * @return true if the pointer belonged to the slab and was released
+     */
+    bool slabFree(void* ptr);
+
+    /**
+     * @brief Get the usable size of a slab block
+     *
+     * @param ptr Pointer to query
+     * @return Block size in bytes, or 0 if the pointer does not belong to the slab
+     */
+    size_t slabBlockSize(const void* ptr);
+
+} // namespace T76::Core::Memory
+
+#endif // T76_MEMORY_USE_SLAB
+
+#ifdef T76_USE_GLOBAL_LOCKS
+
+// === Core 1 Block Pool Configuration ===
+#define T76_MEMORY_CORE1_POOL_CLASS_COUNT 4         ///< Number of block size classes in the Core 1 pool
+#define T76_MEMORY_CORE1_POOL_MAX_BLOCK_SIZE 256    ///< Largest request (bytes) served by the Core 1 pool
+
+static_assert(T76_MEMORY_CORE1_POOL_BLOCKS_PER_CHUNK * T76_MEMORY_CORE1_POOL_MAX_CHUNKS < 0xFFFF,
+              "Core 1 pool classes are limited to 65534 blocks each");
+static_assert(T76_MEMORY_CORE1_POOL_LOW_WATERMARK < T76_MEMORY_CORE1_POOL_BLOCKS_PER_CHUNK,
+              "Core 1 pool low watermark must be smaller than a chunk");
+
+namespace T76::Core::Memory {
+
+    /**
+     * @brief Carve the initial chunk of every Core 1 pool class
+     *
+     * Must be called on Core 0 before Core 1 is launched. Classes that
+     * cannot be carved are left empty, in which case Core 1 allocations
+     * of that size fall back to the inter-core FIFO proxy.
+     *
+     * @return true if every class received its initial chunk, false otherwise
+     */
+    bool core1PoolInit();
+
+    /**
+     * @brief Allocate a block from the Core 1 pool
+     *
+     * Lock-free; never blocks and never waits on Core 0. Raises a refill
+     * request when the class drops below T76_MEMORY_CORE1_POOL_LOW_WATERMARK.
+     *
+     * @param size Number of bytes requested
+     * @return Pointer to a block of at least size bytes, or nullptr if the
+     *         request is too large or the matching classes are exhausted
+     */
+    void* core1PoolAlloc(size_t size);
+
+    /**
+     * @brief Return a block to the Core 1 pool
+     *
+     * Lock-free and safe to call from either core. Pointers that do not
+     * belong to the pool are left untouched.
+     *
+     * @param ptr Pointer to release
+     * @return true if the pointer belonged to the pool and was released,
+     *         false if it must be freed through the FreeRTOS heap
+     */
+    bool core1PoolFree(void* ptr);
+
+    /**
+     * @brief Get the usable size of a Core 1 pool block
+     *
+     * @param ptr Pointer to query
+     * @return Block size in bytes, or 0 if the pointer does not belong to the pool
+     */
+    size_t core1PoolBlockSize(const void* ptr);
+
+    /**
+     * @brief Service pending Core 1 pool refill requests
+     *
+     * Called by the memory service task on Core 0 every time it wakes up.
+     * Carves a new chunk from the FreeRTOS heap for every class that is
+     * running low.
+     */
+    void core1PoolService();
+
+    /**
+     * @brief Wake the memory service task from Core 1 without blocking
+     *
+     * Rings the memory service's SIO doorbell. Used after each FIFO request,
+     * by the deferred free ring and by the Core 1 pool to request a
+     * background refill.
+     */
+    void signalMemoryService();
+
+} // namespace T76::Core::Memory
+
+#endif // T76_USE_GLOBAL_LOCKS
@@ -0,0 +1,257 @@
+/**
+ * @file memory_slab.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Size-class slab front-end for small C++ allocations.
+ *
+ * When T76_MEMORY_USE_SLAB is enabled, the new/delete overrides first try to
+ * serve requests of up to 256 bytes from fixed-size slabs before falling back
+ * to the FreeRTOS heap. This keeps the many short-lived objects created on the
+ * USB and SCPI paths out of the heap_4 first-fit walk.
+ *
+ * Design:
+ * - Power-of-two size classes from 8 to 256 bytes
+ * - All slabs are carved from the FreeRTOS heap in a single region at init,
+ *   so ownership can be checked with one address range comparison
+ * - Each class keeps an intrusive free list protected by a dedicated
+ *   critical section, which is safe from both cores and from interrupts
+ * - A request whose class is empty counts as a miss and falls through to
+ *   the heap; hit and miss counters are kept per class for tuning
+ *
+ * The slab region is never returned to the heap.
+ */
+
+#include "t76/memory.hpp"
+#include "memory_private.hpp"
+
+#ifdef T76_MEMORY_USE_SLAB
+
+#include <FreeRTOS.h>
+#include <pico/critical_section.h>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+namespace T76::Core::Memory {
+
+    /**
+     * @brief Block sizes for each slab class, in ascending order
+     */
+    static constexpr uint32_t SLAB_CLASS_SIZES[T76_MEMORY_SLAB_CLASS_COUNT] = { 8, 16, 32, 64, 128, 256 };
+
+    static_assert(SLAB_CLASS_SIZES[T76_MEMORY_SLAB_CLASS_COUNT - 1] == T76_MEMORY_SLAB_MAX_BLOCK_SIZE,
+                  "Largest slab class must match T76_MEMORY_SLAB_MAX_BLOCK_SIZE");
+
+    /**
+     * @brief Free block link stored in the first word of every free slab block
+     */
+    struct SlabFreeBlock {
+        SlabFreeBlock* next;                ///< Next free block in the same class
+    };
+
+    /**
+     * @brief State for a single slab class
+     */
+    struct SlabClass {
+        uint8_t* base;                      ///< First block of the class
+        uint8_t* end;                       ///< One past the last block of the class
+        SlabFreeBlock* freeList;            ///< Head of the free list
+        uint32_t freeCount;                 ///< Number of blocks on the free list
+        uint32_t hits;                      ///< Requests served by this class
+        uint32_t misses;                    ///< Requests that fell through to the heap
+    };
+
+    static SlabClass gSlabClasses[T76_MEMORY_SLAB_CLASS_COUNT];
+
+    static uint8_t* gSlabRegionStart = nullptr;
+    static uint8_t* gSlabRegionEnd = nullptr;
+
+    static critical_section_t gSlabCriticalSection;
+
+    /**
+     * @brief Set once the slab region has been carved; until then every
+     *        request falls through to the heap
+     */
+    static volatile bool gSlabInitialized = false;
+
+    /**
+     * @brief Map a request size to its slab class
+     *
+     * @return Class index, or T76_MEMORY_SLAB_CLASS_COUNT if the request is too large
+     */
+    static inline uint32_t slabClassForSize(size_t size) {
+        for (uint32_t i = 0; i < T76_MEMORY_SLAB_CLASS_COUNT; i++) {
+            if (size <= SLAB_CLASS_SIZES[i]) {
+                return i;
+            }
+        }
+
+        return T76_MEMORY_SLAB_CLASS_COUNT;
+    }
+
+    bool slabInit() {
+        if (gSlabInitialized) {
+            return true;
+        }
+
+        size_t regionSize = 0;
+
+        for (uint32_t i = 0; i < T76_MEMORY_SLAB_CLASS_COUNT; i++) {
+            regionSize += SLAB_CLASS_SIZES[i] * T76_MEMORY_SLAB_BLOCKS_PER_CLASS;
+        }
+
+        uint8_t* region = static_cast<uint8_t*>(pvPortMalloc(regionSize));
+
+        if (region == nullptr) {
+            LOGE("Memory: no heap left for the %lu-byte slab region\n", (unsigned long)regionSize);
+            return false;
+        }
+
+        critical_section_init(&gSlabCriticalSection);
+
+        uint8_t* cursor = region;
+
+        for (uint32_t i = 0; i < T76_MEMORY_SLAB_CLASS_COUNT; i++) {
+            SlabClass& slabClass = gSlabClasses[i];
+            const uint32_t blockSize = SLAB_CLASS_SIZES[i];
+
+            slabClass.base = cursor;
+            slabClass.end = cursor + blockSize * T76_MEMORY_SLAB_BLOCKS_PER_CLASS;
+            slabClass.freeList = nullptr;
+            slabClass.freeCount = 0;
+            slabClass.hits = 0;
+            slabClass.misses = 0;
+
+            // Thread the blocks in reverse so that they are handed out in address order
+            for (uint32_t block = T76_MEMORY_SLAB_BLOCKS_PER_CLASS; block > 0; block--) {
+                SlabFreeBlock* freeBlock = reinterpret_cast<SlabFreeBlock*>(cursor + (block - 1) * blockSize);
+                freeBlock->next = slabClass.freeList;
+                slabClass.freeList = freeBlock;
+                slabClass.freeCount++;
+            }
+
+            cursor = slabClass.end;
+        }
+
+        gSlabRegionStart = region;
+        gSlabRegionEnd = cursor;
+        gSlabInitialized = true;
+
+        return true;
+    }
+
+    void* slabAlloc(size_t size) {
+        if (!gSlabInitialized) {
+            return nullptr;
+        }
+
+        const uint32_t classIndex = slabClassForSize(size);
+
+        if (classIndex == T76_MEMORY_SLAB_CLASS_COUNT) {
+            return nullptr;
+        }
+
+        SlabClass& slabClass = gSlabClasses[classIndex];
+
+        critical_section_enter_blocking(&gSlabCriticalSection);
+
+        SlabFreeBlock* block = slabClass.freeList;
+
+        if (block != nullptr) {
+            slabClass.freeList = block->next;
+            slabClass.freeCount--;
+            slabClass.hits++;
+        } else {
+            slabClass.misses++;
+        }
+
+        critical_section_exit(&gSlabCriticalSection);
+
+        return block;
+    }
+
+    bool slabFree(void* ptr) {
+        uint8_t* address = static_cast<uint8_t*>(ptr);
+
+        if (address < gSlabRegionStart || address >= gSlabRegionEnd) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < T76_MEMORY_SLAB_CLASS_COUNT; i++) {
+            SlabClass& slabClass = gSlabClasses[i];
+
+            if (address < slabClass.end) {
+                SlabFreeBlock* block = reinterpret_cast<SlabFreeBlock*>(address);
+
+                critical_section_enter_blocking(&gSlabCriticalSection);
+                block->next = slabClass.freeList;
+                slabClass.freeList = block;
+                slabClass.freeCount++;
+                critical_section_exit(&gSlabCriticalSection);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    size_t slabBlockSize(const void* ptr) {
+        const uint8_t* address = static_cast<const uint8_t*>(ptr);
+
+        if (address < gSlabRegionStart || address >= gSlabRegionEnd) {
+            return 0;
+        }
+
+        for (uint32_t i = 0; i < T76_MEMORY_SLAB_CLASS_COUNT; i++) {
+            if (address < gSlabClasses[i].end) {
+                return SLAB_CLASS_SIZES[i];
+            }
+        }
+
+        return 0;
+    }
+
+    uint8_t slabClassCount() {
+        return T76_MEMORY_SLAB_CLASS_COUNT;
+    }
+
+    bool slabClassStats(uint8_t index, SlabClassStats& stats) {
+        if (index >= T76_MEMORY_SLAB_CLASS_COUNT || !gSlabInitialized) {
+            return false;
+        }
+
+        const SlabClass& slabClass = gSlabClasses[index];
+
+        critical_section_enter_blocking(&gSlabCriticalSection);
+        stats.blockSize = SLAB_CLASS_SIZES[index];
+        stats.blockCount = T76_MEMORY_SLAB_BLOCKS_PER_CLASS;
+        stats.freeCount = slabClass.freeCount;
+        stats.hits = slabClass.hits;
+        stats.misses = slabClass.misses;
+        critical_section_exit(&gSlabCriticalSection);
+
+        return true;
+    }
+
+} // namespace T76::Core::Memory
+
+#else
+
+namespace T76::Core::Memory {
+
+    uint8_t slabClassCount() {
+        return 0;
+    }
+
+    bool slabClassStats(uint8_t index, SlabClassStats& stats) {
+        (void)index;
+        (void)stats;
+        return false;
+    }
+
+} // namespace T76::Core::Memory
+
+#endif // T76_MEMORY_USE_SLAB
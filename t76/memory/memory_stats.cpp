@@ -0,0 +1,390 @@
+/**
+ * @file memory_stats.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Optional allocation instrumentation for the memory management system.
+ *
+ * When T76_MEMORY_USE_STATS is enabled, every allocation and free that goes
+ * through T76MemoryAlloc()/T76MemoryFree() (and the slab front-end) is counted:
+ * - Allocation and free counts and bytes per FreeRTOS task, for Core 1, and
+ *   for allocations made outside of any task (interrupts, startup); with
+ *   T76_IC_SMP, Core 1 runs tasks and its allocations are counted per task
+ * - A power-of-two histogram of requested sizes
+ * - Bytes in use and the peak since the last reset
+ *
+ * Byte counts are based on the usable size of each block, so that frees can
+ * be attributed without per-block bookkeeping. Heap figures (free bytes,
+ * minimum ever free, largest free block) come from FreeRTOS and are always
+ * reported, even when instrumentation is disabled.
+ *
+ * Counters are protected by a critical section, which is safe from both cores
+ * and from interrupts. Allocations made before init() are not counted.
+ */
+
+#include "t76/memory.hpp"
+#include "memory_private.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#ifdef T76_MEMORY_USE_STATS
+
+#include <pico/stdlib.h>
+#include <pico/critical_section.h>
+
+namespace T76::Core::Memory {
+
+    static constexpr uint8_t STATS_ENTRY_CORE1 = 0;         ///< Entry collecting all Core 1 allocations
+    static constexpr uint8_t STATS_ENTRY_NO_TASK = 1;       ///< Entry collecting allocations made outside of a task
+    static constexpr uint8_t STATS_ENTRY_OTHER = 2;         ///< Entry collecting tasks that did not fit in the table
+    static constexpr uint8_t STATS_FIRST_TASK_ENTRY = 3;
+    static constexpr uint8_t STATS_ENTRY_COUNT = STATS_FIRST_TASK_ENTRY + T76_MEMORY_STATS_MAX_TASKS;
+
+    static_assert(STATS_ENTRY_COUNT <= 255, "T76_MEMORY_STATS_MAX_TASKS is too large");
+
+    /**
+     * @brief Counters attributed to a single task
+     */
+    struct StatsEntry {
+        TaskHandle_t task;                  ///< Owning task, nullptr for the fixed entries
+        TaskAllocationStats stats;          ///< Counters and name reported to callers
+    };
+
+    static StatsEntry gStatsEntries[STATS_ENTRY_COUNT];
+    static uint8_t gStatsEntryCount = STATS_FIRST_TASK_ENTRY;
+
+    static uint32_t gStatsAllocCount = 0;
+    static uint32_t gStatsFreeCount = 0;
+    static uint32_t gStatsFailedCount = 0;
+    static uint32_t gStatsBytesInUse = 0;
+    static uint32_t gStatsPeakBytesInUse = 0;
+    static uint32_t gStatsHistogram[T76_MEMORY_STATS_HISTOGRAM_BUCKETS];
+
+    static critical_section_t gStatsCriticalSection;
+    static volatile bool gStatsInitialized = false;
+
+    /**
+     * @brief Map a requested size to its histogram bucket
+     */
+    static inline uint32_t histogramBucket(size_t size) {
+        if (size <= 16) {
+            return 0;
+        }
+
+        // Bucket n holds sizes in (2^(n+3), 2^(n+4)]
+        const uint32_t bucket = (32 - __builtin_clz(static_cast<uint32_t>(size - 1))) - 4;
+
+        return bucket < T76_MEMORY_STATS_HISTOGRAM_BUCKETS ? bucket : T76_MEMORY_STATS_HISTOGRAM_BUCKETS - 1;
+    }
+
+    static void initEntry(StatsEntry& entry, TaskHandle_t task, const char* name) {
+        memset(&entry, 0, sizeof(entry));
+        entry.task = task;
+        strncpy(entry.stats.name, name, T76_MEMORY_STATS_TASK_NAME_LENGTH - 1);
+    }
+
+    /**
+     * @brief Find the entry that the current caller's allocations are attributed to
+     *
+     * Must be called with the statistics critical section held. Tasks seen for
+     * the first time are added to the table while there is room.
+     */
+    static StatsEntry& currentEntry() {
+        #ifndef T76_IC_SMP
+            if (get_core_num() != 0) {
+                return gStatsEntries[STATS_ENTRY_CORE1];
+            }
+        #endif
+
+        if (__get_current_exception() != 0 || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+            return gStatsEntries[STATS_ENTRY_NO_TASK];
+        }
+
+        TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+        for (uint8_t i = STATS_FIRST_TASK_ENTRY; i < gStatsEntryCount; i++) {
+            if (gStatsEntries[i].task == task) {
+                return gStatsEntries[i];
+            }
+        }
+
+        if (gStatsEntryCount == STATS_ENTRY_COUNT) {
+            return gStatsEntries[STATS_ENTRY_OTHER];
+        }
+
+        StatsEntry& entry = gStatsEntries[gStatsEntryCount++];
+        initEntry(entry, task, pcTaskGetName(task));
+        return entry;
+    }
+
+    bool statsInit() {
+        if (gStatsInitialized) {
+            return true;
+        }
+
+        critical_section_init(&gStatsCriticalSection);
+
+        initEntry(gStatsEntries[STATS_ENTRY_CORE1], nullptr, "(core1)");
+        initEntry(gStatsEntries[STATS_ENTRY_NO_TASK], nullptr, "(none)");
+        initEntry(gStatsEntries[STATS_ENTRY_OTHER], nullptr, "(other)");
+
+        // Account for everything allocated before instrumentation started
+        gStatsBytesInUse = configTOTAL_HEAP_SIZE - xPortGetFreeHeapSize();
+        gStatsPeakBytesInUse = gStatsBytesInUse;
+
+        gStatsInitialized = true;
+        return true;
+    }
+
+    void statsRecordAlloc(size_t requestedSize, size_t blockSize) {
+        if (!gStatsInitialized) {
+            return;
+        }
+
+        critical_section_enter_blocking(&gStatsCriticalSection);
+
+        StatsEntry& entry = currentEntry();
+        entry.stats.allocCount++;
+        entry.stats.allocBytes += blockSize;
+
+        gStatsAllocCount++;
+        gStatsHistogram[histogramBucket(requestedSize)]++;
+        gStatsBytesInUse += blockSize;
+
+        if (gStatsBytesInUse > gStatsPeakBytesInUse) {
+            gStatsPeakBytesInUse = gStatsBytesInUse;
+        }
+
+        critical_section_exit(&gStatsCriticalSection);
+    }
+
+    void statsRecordFailure(size_t requestedSize) {
+        if (!gStatsInitialized) {
+            return;
+        }
+
+        critical_section_enter_blocking(&gStatsCriticalSection);
+        gStatsFailedCount++;
+        gStatsHistogram[histogramBucket(requestedSize)]++;
+        critical_section_exit(&gStatsCriticalSection);
+    }
+
+    void statsRecordFree(size_t blockSize) {
+        if (!gStatsInitialized) {
+            return;
+        }
+
+        critical_section_enter_blocking(&gStatsCriticalSection);
+
+        StatsEntry& entry = currentEntry();
+        entry.stats.freeCount++;
+        entry.stats.freeBytes += blockSize;
+
+        gStatsFreeCount++;
+        gStatsBytesInUse = blockSize < gStatsBytesInUse ? gStatsBytesInUse - blockSize : 0;
+
+        critical_section_exit(&gStatsCriticalSection);
+    }
+
+    void statsRecordResize(size_t oldBlockSize, size_t newBlockSize) {
+        if (!gStatsInitialized || oldBlockSize == newBlockSize) {
+            return;
+        }
+
+        critical_section_enter_blocking(&gStatsCriticalSection);
+
+        StatsEntry& entry = currentEntry();
+
+        if (newBlockSize > oldBlockSize) {
+            entry.stats.allocBytes += newBlockSize - oldBlockSize;
+            gStatsBytesInUse += newBlockSize - oldBlockSize;
+
+            if (gStatsBytesInUse > gStatsPeakBytesInUse) {
+                gStatsPeakBytesInUse = gStatsBytesInUse;
+            }
+        } else {
+            const size_t released = oldBlockSize - newBlockSize;
+
+            entry.stats.freeBytes += released;
+            gStatsBytesInUse = released < gStatsBytesInUse ? gStatsBytesInUse - released : 0;
+        }
+
+        critical_section_exit(&gStatsCriticalSection);
+    }
+
+    bool allocationStats(AllocationStats& stats) {
+        memset(&stats, 0, sizeof(stats));
+
+        HeapStats_t heapStats;
+        vPortGetHeapStats(&heapStats);
+
+        stats.heapFreeBytes = heapStats.xAvailableHeapSpaceInBytes;
+        stats.minHeapFreeBytes = heapStats.xMinimumEverFreeBytesRemaining;
+        stats.largestFreeBlock = heapStats.xSizeOfLargestFreeBlockInBytes;
+
+        if (!gStatsInitialized) {
+            return false;
+        }
+
+        critical_section_enter_blocking(&gStatsCriticalSection);
+        stats.allocCount = gStatsAllocCount;
+        stats.freeCount = gStatsFreeCount;
+        stats.failedCount = gStatsFailedCount;
+        stats.bytesInUse = gStatsBytesInUse;
+        stats.peakBytesInUse = gStatsPeakBytesInUse;
+        memcpy(stats.histogram, gStatsHistogram, sizeof(stats.histogram));
+        critical_section_exit(&gStatsCriticalSection);
+
+        return true;
+    }
+
+    uint8_t taskAllocationStatsCount() {
+        return gStatsInitialized ? gStatsEntryCount : 0;
+    }
+
+    bool taskAllocationStats(uint8_t index, TaskAllocationStats& stats) {
+        if (!gStatsInitialized || index >= gStatsEntryCount) {
+            return false;
+        }
+
+        critical_section_enter_blocking(&gStatsCriticalSection);
+        stats = gStatsEntries[index].stats;
+        critical_section_exit(&gStatsCriticalSection);
+
+        return true;
+    }
+
+    void resetAllocationStats() {
+        if (!gStatsInitialized) {
+            return;
+        }
+
+        critical_section_enter_blocking(&gStatsCriticalSection);
+
+        // Keep the task table and bytes in use, which describe live state
+        for (uint8_t i = 0; i < gStatsEntryCount; i++) {
+            TaskAllocationStats& stats = gStatsEntries[i].stats;
+            stats.allocCount = 0;
+            stats.freeCount = 0;
+            stats.allocBytes = 0;
+            stats.freeBytes = 0;
+        }
+
+        gStatsAllocCount = 0;
+        gStatsFreeCount = 0;
+        gStatsFailedCount = 0;
+        gStatsPeakBytesInUse = gStatsBytesInUse;
+        memset(gStatsHistogram, 0, sizeof(gStatsHistogram));
+
+        critical_section_exit(&gStatsCriticalSection);
+    }
+
+} // namespace T76::Core::Memory
+
+#else
+
+namespace T76::Core::Memory {
+
+    bool allocationStats(AllocationStats& stats) {
+        memset(&stats, 0, sizeof(stats));
+
+        HeapStats_t heapStats;
+        vPortGetHeapStats(&heapStats);
+
+        stats.heapFreeBytes = heapStats.xAvailableHeapSpaceInBytes;
+        stats.minHeapFreeBytes = heapStats.xMinimumEverFreeBytesRemaining;
+        stats.largestFreeBlock = heapStats.xSizeOfLargestFreeBlockInBytes;
+
+        return false;
+    }
+
+    uint8_t taskAllocationStatsCount() {
+        return 0;
+    }
+
+    bool taskAllocationStats(uint8_t index, TaskAllocationStats& stats) {
+        (void)index;
+        (void)stats;
+        return false;
+    }
+
+    void resetAllocationStats() {
+    }
+
+} // namespace T76::Core::Memory
+
+#endif // T76_MEMORY_USE_STATS
+
+namespace T76::Core::Memory {
+
+    uint32_t histogramBucketLimit(uint8_t bucket) {
+        if (bucket >= T76_MEMORY_STATS_HISTOGRAM_BUCKETS - 1) {
+            return 0;
+        }
+
+        return 16u << bucket;
+    }
+
+    std::string allocationStatsReport() {
+        AllocationStats stats;
+        allocationStats(stats);
+
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), "%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu",
+                 (unsigned long)stats.allocCount,
+                 (unsigned long)stats.freeCount,
+                 (unsigned long)stats.failedCount,
+                 (unsigned long)stats.bytesInUse,
+                 (unsigned long)stats.peakBytesInUse,
+                 (unsigned long)stats.heapFreeBytes,
+                 (unsigned long)stats.minHeapFreeBytes,
+                 (unsigned long)stats.largestFreeBlock);
+
+        return std::string(buffer);
+    }
+
+    std::string taskAllocationStatsReport() {
+        std::string report;
+        const uint8_t count = taskAllocationStatsCount();
+
+        for (uint8_t i = 0; i < count; i++) {
+            TaskAllocationStats stats;
+
+            if (!taskAllocationStats(i, stats)) {
+                continue;
+            }
+
+            char buffer[96];
+            snprintf(buffer, sizeof(buffer), "%s\"%s\",%lu,%lu,%lu,%lu",
+                     report.empty() ? "" : ",",
+                     stats.name,
+                     (unsigned long)stats.allocCount,
+                     (unsigned long)stats.freeCount,
+                     (unsigned long)stats.allocBytes,
+                     (unsigned long)stats.freeBytes);
+
+            report += buffer;
+        }
+
+        return report;
+    }
+
+    std::string allocationHistogramReport() {
+        AllocationStats stats;
+        allocationStats(stats);
+
+        std::string report;
+
+        for (uint8_t i = 0; i < T76_MEMORY_STATS_HISTOGRAM_BUCKETS; i++) {
+            char buffer[16];
+            snprintf(buffer, sizeof(buffer), i == 0 ? "%lu" : ",%lu", (unsigned long)stats.histogram[i]);
+            report += buffer;
+        }
+
+        return report;
+    }
+
+} // namespace T76::Core::Memory
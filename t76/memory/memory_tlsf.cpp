@@ -0,0 +1,422 @@
+/**
+ * @file memory_tlsf.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Two-level segregated-fit (TLSF) heap for deterministic real-time builds.
+ *
+ * When T76_MEMORY_ALLOCATOR is set to TLSF, this file replaces FreeRTOS heap_4
+ * by providing pvPortMalloc(), vPortFree() and the heap statistics functions.
+ * Every allocation in the system, including FreeRTOS kernel objects and the
+ * T76MemoryAlloc()/T76MemoryFree() wrappers, then runs in constant time.
+ *
+ * Design:
+ * - A first-level index selects the power-of-two range of a block size and a
+ *   second-level index splits each range into 16 linear subranges
+ * - One bitmap per level records which free lists are non-empty, so finding a
+ *   suitable block takes two find-first-set operations regardless of heap state
+ * - Allocation rounds the request up to the next subrange (good fit), so any
+ *   block found is guaranteed to be large enough without walking a list
+ * - Every block carries an 8-byte header holding its size and a pointer to the
+ *   physically previous block, which makes coalescing on free O(1)
+ * - Blocks are 8-byte aligned, matching portBYTE_ALIGNMENT on the RP2350
+ *
+ * The heap occupies a static array of configTOTAL_HEAP_SIZE bytes and is
+ * initialized lazily on the first allocation, so it is usable from static
+ * constructors. Thread safety matches heap_4: operations suspend the scheduler,
+ * and Core 1 never touches the heap directly (see T76_USE_GLOBAL_LOCKS).
+ */
+
+#include "memory_private.hpp"
+
+#ifdef T76_MEMORY_ALLOCATOR_TLSF
+
+#include <cstddef>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+namespace T76::Core::Memory {
+
+    static constexpr uint32_t TLSF_ALIGN_SIZE_LOG2 = 3;                  ///< log2 of the block alignment
+    static constexpr uint32_t TLSF_ALIGN_SIZE = 1u << TLSF_ALIGN_SIZE_LOG2;
+    static constexpr uint32_t TLSF_SL_INDEX_COUNT_LOG2 = 4;              ///< log2 of the number of second-level lists
+    static constexpr uint32_t TLSF_SL_INDEX_COUNT = 1u << TLSF_SL_INDEX_COUNT_LOG2;
+    static constexpr uint32_t TLSF_FL_INDEX_MAX = 20;                    ///< Largest supported block is 2^20 bytes
+    static constexpr uint32_t TLSF_FL_INDEX_SHIFT = TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_SIZE_LOG2;
+    static constexpr uint32_t TLSF_FL_INDEX_COUNT = TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1;
+    static constexpr uint32_t TLSF_SMALL_BLOCK_SIZE = 1u << TLSF_FL_INDEX_SHIFT;
+
+    static constexpr uint32_t TLSF_BLOCK_FREE = 0x1;                     ///< Size flag marking a free block
+    static constexpr uint32_t TLSF_SIZE_MASK = ~(TLSF_ALIGN_SIZE - 1);
+
+    static_assert(TLSF_ALIGN_SIZE == portBYTE_ALIGNMENT, "TLSF alignment must match portBYTE_ALIGNMENT");
+    static_assert(configTOTAL_HEAP_SIZE < (1u << TLSF_FL_INDEX_MAX), "configTOTAL_HEAP_SIZE exceeds the TLSF first-level range");
+
+    /**
+     * @brief TLSF block header
+     *
+     * Only size and prevPhysical are present in allocated blocks; the free list
+     * links live in the payload and are only valid while the block is free.
+     */
+    struct TlsfBlock {
+        uint32_t size;                      ///< Total block size (header included) with flags in the low bits
+        TlsfBlock* prevPhysical;            ///< Physically previous block, nullptr for the first block
+        TlsfBlock* nextFree;                ///< Next block in the same free list
+        TlsfBlock* prevFree;                ///< Previous block in the same free list
+    };
+
+    static constexpr uint32_t TLSF_HEADER_SIZE = offsetof(TlsfBlock, nextFree);    ///< Bytes of TlsfBlock present in allocated blocks
+    static constexpr uint32_t TLSF_MIN_BLOCK_SIZE = sizeof(TlsfBlock);           ///< Smallest block able to hold the free list links
+
+    static_assert(TLSF_HEADER_SIZE % TLSF_ALIGN_SIZE == 0, "TLSF header must preserve payload alignment");
+
+    /**
+     * @brief Heap storage, replacing the ucHeap array of heap_4
+     */
+    static uint8_t gTlsfHeap[configTOTAL_HEAP_SIZE] __attribute__((aligned(8)));
+
+    static uint32_t gTlsfFirstLevelBitmap = 0;
+    static uint32_t gTlsfSecondLevelBitmap[TLSF_FL_INDEX_COUNT];
+    static TlsfBlock* gTlsfFreeLists[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+
+    static bool gTlsfInitialized = false;
+    static size_t gTlsfFreeBytes = 0;
+    static size_t gTlsfMinimumEverFreeBytes = 0;
+    static size_t gTlsfSuccessfulAllocations = 0;
+    static size_t gTlsfSuccessfulFrees = 0;
+
+    static inline uint32_t blockSize(const TlsfBlock* block) {
+        return block->size & TLSF_SIZE_MASK;
+    }
+
+    static inline bool blockIsFree(const TlsfBlock* block) {
+        return (block->size & TLSF_BLOCK_FREE) != 0;
+    }
+
+    static inline TlsfBlock* nextPhysical(const TlsfBlock* block) {
+        return (TlsfBlock*)((uint8_t*)block + blockSize(block));
+    }
+
+    static inline uint32_t findLastSet(uint32_t value) {
+        return 31 - __builtin_clz(value);
+    }
+
+    static inline uint32_t findFirstSet(uint32_t value) {
+        return __builtin_ctz(value);
+    }
+
+    /**
+     * @brief Map a block size to the free list that holds blocks of that size
+     */
+    static inline void mappingInsert(uint32_t size, uint32_t& firstLevel, uint32_t& secondLevel) {
+        if (size < TLSF_SMALL_BLOCK_SIZE) {
+            firstLevel = 0;
+            secondLevel = size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT);
+        } else {
+            const uint32_t lastSet = findLastSet(size);
+            secondLevel = (size >> (lastSet - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+            firstLevel = lastSet - (TLSF_FL_INDEX_SHIFT - 1);
+        }
+    }
+
+    /**
+     * @brief Map a request to the first free list whose blocks are all large enough
+     */
+    static inline void mappingSearch(uint32_t size, uint32_t& firstLevel, uint32_t& secondLevel) {
+        if (size >= TLSF_SMALL_BLOCK_SIZE) {
+            size += (1u << (findLastSet(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+        }
+
+        mappingInsert(size, firstLevel, secondLevel);
+    }
+
+    static void insertFreeBlock(TlsfBlock* block) {
+        uint32_t firstLevel, secondLevel;
+        mappingInsert(blockSize(block), firstLevel, secondLevel);
+
+        TlsfBlock* head = gTlsfFreeLists[firstLevel][secondLevel];
+        block->nextFree = head;
+        block->prevFree = nullptr;
+
+        if (head != nullptr) {
+            head->prevFree = block;
+        }
+
+        gTlsfFreeLists[firstLevel][secondLevel] = block;
+        gTlsfFirstLevelBitmap |= 1u << firstLevel;
+        gTlsfSecondLevelBitmap[firstLevel] |= 1u << secondLevel;
+    }
+
+    static void removeFreeBlock(TlsfBlock* block) {
+        uint32_t firstLevel, secondLevel;
+        mappingInsert(blockSize(block), firstLevel, secondLevel);
+
+        if (block->prevFree != nullptr) {
+            block->prevFree->nextFree = block->nextFree;
+        } else {
+            gTlsfFreeLists[firstLevel][secondLevel] = block->nextFree;
+
+            if (block->nextFree == nullptr) {
+                gTlsfSecondLevelBitmap[firstLevel] &= ~(1u << secondLevel);
+
+                if (gTlsfSecondLevelBitmap[firstLevel] == 0) {
+                    gTlsfFirstLevelBitmap &= ~(1u << firstLevel);
+                }
+            }
+        }
+
+        if (block->nextFree != nullptr) {
+            block->nextFree->prevFree = block->prevFree;
+        }
+    }
+
+    /**
+     * @brief Find a free block of at least size bytes using the bitmaps
+     *
+     * @return A free block (still on its free list), or nullptr if none is large enough
+     */
+    static TlsfBlock* findSuitableBlock(uint32_t size) {
+        uint32_t firstLevel, secondLevel;
+        mappingSearch(size, firstLevel, secondLevel);
+
+        if (firstLevel >= TLSF_FL_INDEX_COUNT) {
+            return nullptr;
+        }
+
+        uint32_t secondLevelMap = gTlsfSecondLevelBitmap[firstLevel] & (~0u << secondLevel);
+
+        if (secondLevelMap == 0) {
+            // No suitable list at this level; move up to the next non-empty range
+            const uint32_t firstLevelMap = (firstLevel + 1 < 32) ? (gTlsfFirstLevelBitmap & (~0u << (firstLevel + 1))) : 0;
+
+            if (firstLevelMap == 0) {
+                return nullptr;
+            }
+
+            firstLevel = findFirstSet(firstLevelMap);
+            secondLevelMap = gTlsfSecondLevelBitmap[firstLevel];
+        }
+
+        secondLevel = findFirstSet(secondLevelMap);
+        return gTlsfFreeLists[firstLevel][secondLevel];
+    }
+
+    /**
+     * @brief Split the tail of a block into a new free block if it is large enough
+     *
+     * @return Number of bytes released, or 0 if the block was not split
+     */
+    static uint32_t splitBlock(TlsfBlock* block, uint32_t size) {
+        const uint32_t remaining = blockSize(block) - size;
+
+        if (remaining < TLSF_MIN_BLOCK_SIZE) {
+            return 0;
+        }
+
+        TlsfBlock* rest = (TlsfBlock*)((uint8_t*)block + size);
+        rest->size = remaining | TLSF_BLOCK_FREE;
+        rest->prevPhysical = block;
+        block->size = size | (block->size & TLSF_BLOCK_FREE);
+
+        TlsfBlock* next = nextPhysical(rest);
+        next->prevPhysical = rest;
+
+        // Keep the invariant that no two free blocks are physically adjacent
+        if (blockIsFree(next)) {
+            removeFreeBlock(next);
+            rest->size += blockSize(next);
+            nextPhysical(rest)->prevPhysical = rest;
+        }
+
+        insertFreeBlock(rest);
+        return remaining;
+    }
+
+    /**
+     * @brief Set up the heap as a single free block followed by a sentinel
+     */
+    static void tlsfInit() {
+        const uint32_t heapSize = configTOTAL_HEAP_SIZE & TLSF_SIZE_MASK;
+
+        TlsfBlock* first = (TlsfBlock*)gTlsfHeap;
+        first->size = (heapSize - TLSF_HEADER_SIZE) | TLSF_BLOCK_FREE;
+        first->prevPhysical = nullptr;
+
+        // Zero-sized, permanently allocated sentinel that stops coalescing at the end
+        TlsfBlock* sentinel = nextPhysical(first);
+        sentinel->size = 0;
+        sentinel->prevPhysical = first;
+
+        insertFreeBlock(first);
+
+        gTlsfFreeBytes = blockSize(first);
+        gTlsfMinimumEverFreeBytes = gTlsfFreeBytes;
+        gTlsfInitialized = true;
+    }
+
+    /**
+     * @brief Convert a request into a block size
+     *
+     * @return Block size in bytes, or 0 if the request cannot be satisfied
+     */
+    static inline uint32_t adjustRequestSize(size_t wantedSize) {
+        if (wantedSize == 0 || wantedSize > (1u << TLSF_FL_INDEX_MAX)) {
+            return 0;
+        }
+
+        const uint32_t size = (static_cast<uint32_t>(wantedSize) + TLSF_HEADER_SIZE + (TLSF_ALIGN_SIZE - 1)) & TLSF_SIZE_MASK;
+        return size < TLSF_MIN_BLOCK_SIZE ? TLSF_MIN_BLOCK_SIZE : size;
+    }
+
+    size_t heapUsableSize(void* ptr) {
+        const TlsfBlock* block = (const TlsfBlock*)((uint8_t*)ptr - TLSF_HEADER_SIZE);
+        return blockSize(block) - TLSF_HEADER_SIZE;
+    }
+
+    void heapShrinkInPlace(void* ptr, size_t size) {
+        TlsfBlock* block = (TlsfBlock*)((uint8_t*)ptr - TLSF_HEADER_SIZE);
+        const uint32_t wantedSize = adjustRequestSize(size);
+
+        if (wantedSize == 0 || wantedSize >= blockSize(block)) {
+            return;
+        }
+
+        vTaskSuspendAll();
+        gTlsfFreeBytes += splitBlock(block, wantedSize);
+        (void)xTaskResumeAll();
+    }
+
+} // namespace T76::Core::Memory
+
+using namespace T76::Core::Memory;
+
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+extern "C" void vApplicationMallocFailedHook(void);
+#endif
+
+extern "C" void* pvPortMalloc(size_t xWantedSize) {
+    const uint32_t size = adjustRequestSize(xWantedSize);
+    void* ptr = nullptr;
+
+    vTaskSuspendAll();
+    {
+        if (!gTlsfInitialized) {
+            tlsfInit();
+        }
+
+        TlsfBlock* block = size > 0 ? findSuitableBlock(size) : nullptr;
+
+        if (block != nullptr) {
+            removeFreeBlock(block);
+            splitBlock(block, size);
+            block->size &= ~TLSF_BLOCK_FREE;
+
+            gTlsfFreeBytes -= blockSize(block);
+
+            if (gTlsfFreeBytes < gTlsfMinimumEverFreeBytes) {
+                gTlsfMinimumEverFreeBytes = gTlsfFreeBytes;
+            }
+
+            gTlsfSuccessfulAllocations++;
+            ptr = (uint8_t*)block + TLSF_HEADER_SIZE;
+        }
+
+        traceMALLOC(ptr, xWantedSize);
+    }
+    (void)xTaskResumeAll();
+
+    #if (configUSE_MALLOC_FAILED_HOOK == 1)
+    {
+        if (ptr == nullptr) {
+            vApplicationMallocFailedHook();
+        }
+    }
+    #endif
+
+    return ptr;
+}
+
+extern "C" void vPortFree(void* pv) {
+    if (pv == nullptr) {
+        return;
+    }
+
+    TlsfBlock* block = (TlsfBlock*)((uint8_t*)pv - TLSF_HEADER_SIZE);
+
+    configASSERT(!blockIsFree(block));
+
+    vTaskSuspendAll();
+    {
+        gTlsfFreeBytes += blockSize(block);
+        gTlsfSuccessfulFrees++;
+        traceFREE(pv, blockSize(block));
+
+        block->size |= TLSF_BLOCK_FREE;
+
+        // Coalesce with the physically previous block
+        TlsfBlock* previous = block->prevPhysical;
+
+        if (previous != nullptr && blockIsFree(previous)) {
+            removeFreeBlock(previous);
+            previous->size += blockSize(block);
+            block = previous;
+            nextPhysical(block)->prevPhysical = block;
+        }
+
+        // Coalesce with the physically next block
+        TlsfBlock* next = nextPhysical(block);
+
+        if (blockIsFree(next)) {
+            removeFreeBlock(next);
+            block->size += blockSize(next);
+            nextPhysical(block)->prevPhysical = block;
+        }
+
+        insertFreeBlock(block);
+    }
+    (void)xTaskResumeAll();
+}
+
+extern "C" size_t xPortGetFreeHeapSize(void) {
+    return gTlsfFreeBytes;
+}
+
+extern "C" size_t xPortGetMinimumEverFreeHeapSize(void) {
+    return gTlsfMinimumEverFreeBytes;
+}
+
+extern "C" void vPortGetHeapStats(HeapStats_t* pxHeapStats) {
+    size_t largest = 0;
+    size_t smallest = SIZE_MAX;
+    size_t freeBlocks = 0;
+
+    vTaskSuspendAll();
+    {
+        if (!gTlsfInitialized) {
+            tlsfInit();
+        }
+
+        // Walk the physical block chain up to the sentinel; statistics only, not O(1)
+        for (const TlsfBlock* block = (const TlsfBlock*)gTlsfHeap; blockSize(block) != 0; block = nextPhysical(block)) {
+            if (blockIsFree(block)) {
+                const size_t size = blockSize(block);
+
+                largest = size > largest ? size : largest;
+                smallest = size < smallest ? size : smallest;
+                freeBlocks++;
+            }
+        }
+
+        pxHeapStats->xAvailableHeapSpaceInBytes = gTlsfFreeBytes;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = gTlsfMinimumEverFreeBytes;
+        pxHeapStats->xNumberOfSuccessfulAllocations = gTlsfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = gTlsfSuccessfulFrees;
+    }
+    (void)xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = largest;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = freeBlocks > 0 ? smallest : 0;
+    pxHeapStats->xNumberOfFreeBlocks = freeBlocks;
+}
+
+#endif // T76_MEMORY_ALLOCATOR_TLSF
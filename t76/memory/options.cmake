@@ -0,0 +1,32 @@
+# Configurable options for the memory library
+
+option(T76_USE_GLOBAL_LOCKS "Enable the use of global locks to allow safe memory allocation from core 1" OFF)
+
+# Core 1 Block Pool Configuration (only used when T76_USE_GLOBAL_LOCKS is ON) ===
+set(T76_MEMORY_CORE1_POOL_BLOCKS_PER_CHUNK 16 CACHE STRING "Number of blocks carved from the FreeRTOS heap each time a core 1 pool class is refilled")
+set(T76_MEMORY_CORE1_POOL_MAX_CHUNKS 4 CACHE STRING "Maximum number of chunks each core 1 pool class can grow to")
+set(T76_MEMORY_CORE1_POOL_LOW_WATERMARK 4 CACHE STRING "Free block count below which core 0 refills a core 1 pool class in the background")
+
+# Core 1 Deferred Free Configuration (only used when T76_USE_GLOBAL_LOCKS is ON) ===
+set(T76_MEMORY_CORE1_FREE_RING_SIZE 32 CACHE STRING "Number of core 1 frees that can be queued to core 0 without blocking (power of two)")
+
+# Slab Front-End Configuration ===
+option(T76_MEMORY_USE_SLAB "Serve small C++ new/delete requests (up to 256 bytes) from size-class slabs before the FreeRTOS heap" OFF)
+set(T76_MEMORY_SLAB_BLOCKS_PER_CLASS 32 CACHE STRING "Number of blocks in each slab size class")
+
+# Heap Allocator Configuration ===
+set(T76_MEMORY_ALLOCATOR FREERTOS CACHE STRING "Heap allocator backing pvPortMalloc: FREERTOS (heap_4 first-fit) or TLSF (constant-time two-level segregated fit)")
+set_property(CACHE T76_MEMORY_ALLOCATOR PROPERTY STRINGS FREERTOS TLSF)
+
+# The TLSF allocator replaces heap_4, so the FreeRTOS heap library must not be linked alongside it
+if(T76_MEMORY_ALLOCATOR STREQUAL "TLSF")
+    set(T76_MEMORY_FREERTOS_HEAP_LIBRARY "" CACHE INTERNAL "")
+elseif(T76_MEMORY_ALLOCATOR STREQUAL "FREERTOS")
+    set(T76_MEMORY_FREERTOS_HEAP_LIBRARY FreeRTOS-Kernel-Heap4 CACHE INTERNAL "")
+else()
+    message(FATAL_ERROR "Unknown T76_MEMORY_ALLOCATOR '${T76_MEMORY_ALLOCATOR}' — expected FREERTOS or TLSF")
+endif()
+
+# Allocation Instrumentation Configuration ===
+option(T76_MEMORY_USE_STATS "Count allocations and frees per task, build a size histogram and track peak usage" OFF)
+set(T76_MEMORY_STATS_MAX_TASKS 16 CACHE STRING "Number of FreeRTOS tasks tracked individually by the allocation instrumentation")
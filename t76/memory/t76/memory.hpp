@@ -26,11 +26,42 @@
  * Mode 2: T76_USE_GLOBAL_LOCKS = 1 (Multi-Core Mode)
  * - Supports memory allocation from both Core 0 (FreeRTOS) and Core 1 (bare metal)
  * - Core 0: Direct calls to FreeRTOS heap functions, protected by FreeRTOS scheduler
- * - Core 1: Proxy requests through inter-core FIFO to a memory service task on Core 0
+ * - Core 1: Small requests (up to 256 bytes) are served from lock-free block pools
+ *   carved from the FreeRTOS heap, so they never wait on Core 0
+ * - Core 1: Large or pool-exhausted requests are proxied through the inter-core FIFO
+ *   to a memory service task on Core 0
+ * - The memory service task refills the Core 1 pools in the background
+ * - Core 1 frees of heap blocks are queued in a non-blocking ring that the memory
+ *   service task drains in batches; only a full ring falls back to a FIFO handshake
  * - All actual heap operations occur on Core 0, ensuring thread safety
  * - Memory service task runs at high priority to minimize allocation latency
+ * - Memory service task sleeps until woken by an SIO doorbell, then drains
+ *   all pending requests in one batch
  * - Uses hardware FIFO for efficient inter-core communication
  * 
+ * With T76_IC_SMP, both cores run FreeRTOS tasks and the SMP kernel's
+ * scheduler lock makes the heap safe from either core, so allocations go to
+ * pvPortMalloc/vPortFree directly, as in Mode 1. T76_USE_GLOBAL_LOCKS cannot
+ * be combined with it.
+ * 
+ * Slab Front-End:
+ * ===============
+ * 
+ * When T76_MEMORY_USE_SLAB is enabled, the C++ new/delete overrides first try to
+ * serve requests of up to 256 bytes from power-of-two slab classes (8 to 256 bytes)
+ * carved from the FreeRTOS heap at init. Requests whose class is exhausted fall
+ * through to the heap, and per-class hit/miss counters are available through
+ * slabClassStats() to help tune T76_MEMORY_SLAB_BLOCKS_PER_CLASS.
+ * 
+ * Heap Allocator:
+ * ===============
+ * 
+ * T76_MEMORY_ALLOCATOR selects the allocator behind pvPortMalloc/vPortFree. The
+ * default, FREERTOS, links FreeRTOS heap_4 (first-fit with coalescing). TLSF
+ * replaces heap_4 with a two-level segregated-fit allocator whose allocation and
+ * free times are constant regardless of heap state, with the same thread-safety
+ * guarantees in both multi-core modes.
+ * 
  * In both modes, all memory comes from the single FreeRTOS heap, ensuring consistent
  * memory management across the entire system. The heap size is controlled by the
  * configTOTAL_HEAP_SIZE macro in FreeRTOSConfig.h.
@@ -39,7 +70,57 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+
+#define T76_MEMORY_STATS_HISTOGRAM_BUCKETS 10       ///< Number of allocation size histogram buckets (16 bytes to >4 KB)
+#define T76_MEMORY_STATS_TASK_NAME_LENGTH 16        ///< Maximum task name length, including the terminator
+
 namespace T76::Core::Memory {
+
+    /**
+     * @brief Usage counters for a single slab size class
+     */
+    struct SlabClassStats {
+        uint32_t blockSize;     ///< Size of each block in bytes
+        uint32_t blockCount;    ///< Total number of blocks in the class
+        uint32_t freeCount;     ///< Number of blocks currently free
+        uint32_t hits;          ///< Allocations served by the class
+        uint32_t misses;        ///< Allocations that fell through to the heap because the class was empty
+    };
+
+    /**
+     * @brief System-wide allocation counters and heap figures
+     * 
+     * Byte counts use the usable size of each block. The heap fields come from
+     * FreeRTOS and are valid even when T76_MEMORY_USE_STATS is disabled.
+     */
+    struct AllocationStats {
+        uint32_t allocCount;        ///< Successful allocations since the last reset
+        uint32_t freeCount;         ///< Frees since the last reset
+        uint32_t failedCount;       ///< Failed allocations since the last reset
+        uint32_t bytesInUse;        ///< Bytes currently allocated (approximate)
+        uint32_t peakBytesInUse;    ///< Highest bytesInUse since the last reset
+        uint32_t heapFreeBytes;     ///< Bytes currently free in the FreeRTOS heap
+        uint32_t minHeapFreeBytes;  ///< Lowest heapFreeBytes since boot
+        uint32_t largestFreeBlock;  ///< Size of the largest free heap block
+        uint32_t histogram[T76_MEMORY_STATS_HISTOGRAM_BUCKETS]; ///< Requests per size bucket, see histogramBucketLimit()
+    };
+
+    /**
+     * @brief Allocation counters attributed to a single task
+     * 
+     * Besides one entry per FreeRTOS task, fixed entries collect Core 1
+     * ("(core1)"), allocations made outside of any task such as interrupts and
+     * startup code ("(none)"), and tasks that did not fit in the table ("(other)").
+     */
+    struct TaskAllocationStats {
+        char name[T76_MEMORY_STATS_TASK_NAME_LENGTH];   ///< Task name captured when the task first allocated
+        uint32_t allocCount;        ///< Allocations made by the task
+        uint32_t freeCount;         ///< Frees made by the task
+        uint32_t allocBytes;        ///< Bytes allocated by the task
+        uint32_t freeBytes;         ///< Bytes freed by the task
+    };
     
     /**
      * @brief Initializes the memory allocation routines, which override
@@ -53,11 +134,103 @@ namespace T76::Core::Memory {
      * 
      *        When T76_USE_GLOBAL_LOCKS is enabled (1):
      *        - Enables multi-core memory allocation support
+     *        - Carves the Core 1 block pools from the FreeRTOS heap
      *        - Starts a memory service task on Core 0 to handle Core 1 requests
      *        - Core 1 can safely allocate/free memory via inter-core communication
      *        - All allocations still come from the single FreeRTOS heap
      * 
+     *        When T76_MEMORY_USE_SLAB is enabled, also carves the slab region
+     *        used by the new/delete overrides.
+     * 
      */
     void init();
 
+    /**
+     * @brief Get the number of slab size classes
+     * 
+     * @return Number of classes, or 0 if T76_MEMORY_USE_SLAB is disabled
+     */
+    uint8_t slabClassCount();
+
+    /**
+     * @brief Get the usage counters of a slab size class
+     * 
+     * @param index Class index, from 0 to slabClassCount() - 1 (smallest first)
+     * @param stats Output structure receiving the counters
+     * @return true if the counters were retrieved, false if the index is invalid
+     *         or the slab is disabled or not yet initialized
+     */
+    bool slabClassStats(uint8_t index, SlabClassStats& stats);
+
+    /**
+     * @brief Get the system-wide allocation counters
+     * 
+     * @param stats Output structure receiving the counters
+     * @return true if the counters are valid, false if T76_MEMORY_USE_STATS is
+     *         disabled or not yet initialized (only the heap fields are filled in)
+     */
+    bool allocationStats(AllocationStats& stats);
+
+    /**
+     * @brief Get the number of entries in the per-task allocation table
+     * 
+     * @return Number of entries, or 0 if T76_MEMORY_USE_STATS is disabled
+     */
+    uint8_t taskAllocationStatsCount();
+
+    /**
+     * @brief Get the allocation counters of a per-task table entry
+     * 
+     * @param index Entry index, from 0 to taskAllocationStatsCount() - 1
+     * @param stats Output structure receiving the counters
+     * @return true if the counters were retrieved, false if the index is invalid
+     *         or T76_MEMORY_USE_STATS is disabled
+     */
+    bool taskAllocationStats(uint8_t index, TaskAllocationStats& stats);
+
+    /**
+     * @brief Clear all allocation counters and restart peak tracking from the
+     *        current usage
+     */
+    void resetAllocationStats();
+
+    /**
+     * @brief Get the largest request size counted in a histogram bucket
+     * 
+     * Bucket 0 counts requests of up to 16 bytes, and every following bucket
+     * doubles the limit. The last bucket counts everything larger.
+     * 
+     * @param bucket Bucket index
+     * @return Upper bound in bytes (inclusive), or 0 for the unbounded last bucket
+     */
+    uint32_t histogramBucketLimit(uint8_t bucket);
+
+    /**
+     * @brief Format the system-wide counters as a SCPI response
+     * 
+     * Suitable as the response to a SYSTem:MEMory:STATistics? query.
+     * 
+     * @return "allocs,frees,failed,inUse,peak,heapFree,minHeapFree,largestFree"
+     */
+    std::string allocationStatsReport();
+
+    /**
+     * @brief Format the per-task table as a SCPI response
+     * 
+     * Suitable as the response to a SYSTem:MEMory:TASKs? query.
+     * 
+     * @return One "name",allocs,frees,allocBytes,freeBytes group per entry,
+     *         separated by commas; empty if T76_MEMORY_USE_STATS is disabled
+     */
+    std::string taskAllocationStatsReport();
+
+    /**
+     * @brief Format the allocation size histogram as a SCPI response
+     * 
+     * Suitable as the response to a SYSTem:MEMory:HISTogram? query.
+     * 
+     * @return Comma-separated request counts, smallest bucket first
+     */
+    std::string allocationHistogramReport();
+
 } // namespace T76::IC::Sys::Memory
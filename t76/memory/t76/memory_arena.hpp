@@ -0,0 +1,292 @@
+/**
+ * @file memory_arena.hpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Scoped bump-pointer arena for short-lived temporaries.
+ *
+ * Many allocations only live for the duration of a single SCPI command or USB
+ * transfer. Serving them from an Arena replaces a heap allocation and free per
+ * object with a pointer increment, and releases everything allocated during a
+ * scope in one step when the scope ends, without leaving holes in the heap.
+ *
+ * Usage:
+ *
+ *     T76::Core::Memory::Arena arena(1024);
+ *
+ *     {
+ *         T76::Core::Memory::ArenaScope scope(arena);
+ *         T76::Core::Memory::ArenaVector<uint8_t> data{T76::Core::Memory::ArenaAllocator<uint8_t>(arena)};
+ *         data.resize(64);
+ *         // ...
+ *     } // Everything allocated from the arena inside the scope is released here
+ *
+ * Design:
+ * - Storage is a single block, either supplied by the caller or allocated from
+ *   the heap once when the arena is constructed
+ * - allocate() bumps a pointer; individual frees are no-ops, except that the
+ *   most recent allocation can be rolled back, which keeps vector growth cheap
+ * - ArenaScope records the current position and rewinds to it on destruction,
+ *   so scopes can be nested
+ * - ArenaAllocator adapts an arena to the C++ allocator requirements. When the
+ *   arena is exhausted, it falls back to the heap transparently, so containers
+ *   never fail just because a temporary grew larger than expected
+ *
+ * Arenas are not thread-safe; each arena must only be used by one task or core
+ * at a time.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace T76::Core::Memory {
+
+    /**
+     * @brief Bump-pointer arena allocator
+     */
+    class Arena {
+    public:
+        /**
+         * @brief Position in the arena, as returned by mark()
+         */
+        typedef size_t Marker;
+
+        /**
+         * @brief Construct an arena that allocates its storage from the heap
+         *
+         * If the storage cannot be allocated, the arena has a capacity of zero
+         * and every allocation fails (ArenaAllocator then uses the heap directly).
+         *
+         * @param capacity Size of the arena in bytes
+         */
+        explicit Arena(size_t capacity);
+
+        /**
+         * @brief Construct an arena on caller-supplied storage
+         *
+         * The storage must outlive the arena and is not freed by it.
+         *
+         * @param buffer Storage for the arena
+         * @param capacity Size of the storage in bytes
+         */
+        Arena(void* buffer, size_t capacity);
+
+        /**
+         * @brief Destroy the arena, releasing its storage if it owns it
+         */
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /**
+         * @brief Allocate a block from the arena
+         *
+         * @param size Number of bytes requested
+         * @param alignment Required alignment, must be a power of two
+         * @return Pointer to the block, or nullptr if the arena is exhausted
+         */
+        inline void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(_buffer);
+            const uintptr_t start = (base + _used + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+            const size_t end = (start - base) + size;
+
+            if (end > _capacity) {
+                _failedCount++;
+                return nullptr;
+            }
+
+            _used = end;
+
+            if (_used > _highWaterMark) {
+                _highWaterMark = _used;
+            }
+
+            return reinterpret_cast<void*>(start);
+        }
+
+        /**
+         * @brief Release a block allocated from the arena
+         *
+         * Only the most recent allocation is actually reclaimed; everything
+         * else is released when the enclosing scope ends or the arena is reset.
+         *
+         * @param ptr Pointer returned by allocate()
+         * @param size Size that was passed to allocate()
+         */
+        inline void deallocate(void* ptr, size_t size) {
+            const size_t offset = static_cast<size_t>(static_cast<uint8_t*>(ptr) - _buffer);
+
+            if (offset + size == _used) {
+                _used = offset;
+            }
+        }
+
+        /**
+         * @brief Check whether a pointer lies within the arena's storage
+         *
+         * @param ptr Pointer to check
+         * @return true if the pointer was allocated from this arena
+         */
+        inline bool owns(const void* ptr) const {
+            const uint8_t* address = static_cast<const uint8_t*>(ptr);
+            return address >= _buffer && address < _buffer + _capacity;
+        }
+
+        /**
+         * @brief Get the current position, for use with rewind()
+         */
+        inline Marker mark() const {
+            return _used;
+        }
+
+        /**
+         * @brief Release every allocation made since a marker was taken
+         *
+         * @param marker Value previously returned by mark()
+         */
+        inline void rewind(Marker marker) {
+            if (marker < _used) {
+                _used = marker;
+            }
+        }
+
+        /**
+         * @brief Release every allocation in the arena
+         */
+        inline void reset() {
+            _used = 0;
+        }
+
+        /**
+         * @brief Get the number of bytes currently allocated
+         */
+        inline size_t used() const {
+            return _used;
+        }
+
+        /**
+         * @brief Get the size of the arena in bytes
+         */
+        inline size_t capacity() const {
+            return _capacity;
+        }
+
+        /**
+         * @brief Get the highest number of bytes ever allocated at once
+         *
+         * Useful for sizing the arena.
+         */
+        inline size_t highWaterMark() const {
+            return _highWaterMark;
+        }
+
+        /**
+         * @brief Get the number of allocations that did not fit in the arena
+         */
+        inline uint32_t failedCount() const {
+            return _failedCount;
+        }
+
+    protected:
+        uint8_t* _buffer;           ///< Arena storage
+        size_t _capacity;           ///< Size of the storage in bytes
+        size_t _used;               ///< Offset of the first free byte
+        size_t _highWaterMark;      ///< Highest value of _used
+        uint32_t _failedCount;      ///< Allocations that did not fit
+        bool _ownsBuffer;           ///< Whether the storage was allocated by the arena
+    };
+
+    /**
+     * @brief Release everything allocated from an arena during a scope
+     *
+     * Records the arena position on construction and rewinds to it on
+     * destruction. Scopes can be nested, but must be destroyed in reverse
+     * order of construction.
+     */
+    class ArenaScope {
+    public:
+        explicit ArenaScope(Arena& arena) : _arena(arena), _marker(arena.mark()) {}
+
+        ~ArenaScope() {
+            _arena.rewind(_marker);
+        }
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+    protected:
+        Arena& _arena;              ///< Arena being scoped
+        Arena::Marker _marker;      ///< Position to rewind to
+    };
+
+    /**
+     * @brief STL-compatible allocator that serves requests from an Arena
+     *
+     * Requests that do not fit in the arena are served from the heap and
+     * freed normally, so containers keep working when the arena is full.
+     *
+     * @tparam T Element type
+     */
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        typedef T value_type;
+
+        explicit ArenaAllocator(Arena& arena) noexcept : _arena(&arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : _arena(other.arena()) {}
+
+        T* allocate(size_t count) {
+            void* ptr = _arena->allocate(count * sizeof(T), alignof(T));
+
+            if (ptr == nullptr) {
+                ptr = ::operator new(count * sizeof(T));
+            }
+
+            return static_cast<T*>(ptr);
+        }
+
+        void deallocate(T* ptr, size_t count) noexcept {
+            if (_arena->owns(ptr)) {
+                _arena->deallocate(ptr, count * sizeof(T));
+            } else {
+                ::operator delete(ptr);
+            }
+        }
+
+        Arena* arena() const noexcept {
+            return _arena;
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept {
+            return _arena == other.arena();
+        }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+            return _arena != other.arena();
+        }
+
+    protected:
+        Arena* _arena;              ///< Arena serving the requests
+    };
+
+    /**
+     * @brief Vector whose storage comes from an Arena
+     */
+    template <typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+    /**
+     * @brief String whose storage comes from an Arena
+     */
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+} // namespace T76::Core::Memory
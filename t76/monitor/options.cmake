@@ -0,0 +1,7 @@
+# Configurable options for the task monitor
+
+option(T76_IC_TASK_MONITOR "Periodically sample the stack high water mark and CPU load of every task, and the load of core 1" OFF)
+set(T76_IC_TASK_MONITOR_MAX_TASKS 24 CACHE STRING "Number of FreeRTOS tasks the task monitor keeps samples of")
+set(T76_IC_TASK_MONITOR_PERIOD_MS 1000 CACHE STRING "Interval between two samples, over which CPU loads are measured (milliseconds)")
+set(T76_IC_TASK_MONITOR_TASK_PRIORITY 1 CACHE STRING "FreeRTOS priority of the task that takes the samples")
+set(T76_IC_TASK_MONITOR_TASK_STACK_SIZE "(configMINIMAL_STACK_SIZE * 2)" CACHE STRING "Stack size of the task that takes the samples")
@@ -0,0 +1,82 @@
+/**
+ * @file task_monitor.hpp
+ * @brief Periodic sampler of task stacks and CPU loads
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The task monitor runs a low-priority task that, every
+ * T76_IC_TASK_MONITOR_PERIOD_MS, takes one snapshot of every FreeRTOS task
+ * with uxTaskGetSystemState() and keeps, for each one, its stack high water
+ * mark and the share of core 0 it used since the previous sample. It also
+ * measures the load of core 1 from the time the executive spends asleep.
+ *
+ * The resulting table is small and can be copied at any time from a task,
+ * for example to answer an SCPI query:
+ *
+ *     T76::Core::TaskMonitor::TaskSample tasks[T76_IC_TASK_MONITOR_MAX_TASKS];
+ *     const std::size_t count = T76::Core::TaskMonitor::copyTasks(tasks, T76_IC_TASK_MONITOR_MAX_TASKS);
+ *
+ * A stack whose high water mark stays large after the instrument has been
+ * through all of its modes can be shrunk, and the memory given to something
+ * more useful.
+ *
+ * The sampler is only built in when the T76_IC_TASK_MONITOR CMake option is
+ * on; otherwise, init() does nothing and the queries return no samples.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <FreeRTOS.h>
+
+
+namespace T76::Core::TaskMonitor {
+
+    /**
+     * @brief Latest sample of one task
+     */
+    struct TaskSample {
+        char name[configMAX_TASK_NAME_LEN];     ///< Name of the task
+        uint32_t number;                        ///< FreeRTOS task number
+        uint8_t priority;                       ///< Current priority
+        uint32_t stackFreeBytes;                ///< Least free stack since the task started (high water mark)
+        uint16_t loadPermille;                  ///< Share of core 0 used during the last period, in tenths of a percent
+    };
+
+    /**
+     * @brief Totals of the latest sample
+     */
+    struct Summary {
+        uint32_t samples;                       ///< Number of samples taken since boot
+        uint32_t periodMs;                      ///< Length of the period the loads are measured over
+        uint32_t taskCount;                     ///< Number of tasks in the table
+        uint32_t missingTasks;                  ///< Tasks that did not fit in the table
+        uint16_t core0LoadPermille;             ///< Share of core 0 not spent in the idle task
+        uint16_t core1LoadPermille;             ///< Share of core 1 not spent asleep in the executive
+        bool core1Valid;                        ///< False if the executive is not running, so core 1's load is unknown
+    };
+
+    /**
+     * @brief Create the task that takes the samples
+     * @return true if the task was created, or the monitor is not built in
+     *
+     * Called by App::run().
+     */
+    bool init();
+
+    /**
+     * @brief Copy the latest sample of every task
+     * @param tasks Receives the samples, in the order FreeRTOS lists the tasks
+     * @param maxTasks Capacity of tasks
+     * @return Number of samples copied; 0 before the first two samples
+     */
+    std::size_t copyTasks(TaskSample *tasks, std::size_t maxTasks);
+
+    /**
+     * @brief Get the totals of the latest sample
+     */
+    Summary summary();
+
+} // namespace T76::Core::TaskMonitor
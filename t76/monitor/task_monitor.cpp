@@ -0,0 +1,202 @@
+/**
+ * @file task_monitor.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the task monitor.
+ *
+ * Each pass takes one uxTaskGetSystemState() snapshot, which holds the
+ * scheduler for as long as it takes to walk the task lists, and works out
+ * the loads from the difference with the previous snapshot's run time
+ * counters, matching tasks by number. The table is built outside of any
+ * critical section and then published, and copied out, in a short one.
+ *
+ */
+
+#include "t76/task_monitor.hpp"
+
+#ifdef T76_IC_TASK_MONITOR
+
+#include <algorithm>
+#include <cstring>
+
+#include <task.h>
+
+#include <hardware/clocks.h>
+#include <hardware/timer.h>
+
+#include <t76/executive.hpp>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+
+using namespace T76::Core::TaskMonitor;
+
+
+namespace {
+
+    TaskHandle_t gTask = nullptr;
+
+    // Snapshot taken by the last pass, and the run time counters of the one before
+    TaskStatus_t gStatus[T76_IC_TASK_MONITOR_MAX_TASKS];
+    uint32_t gPreviousNumbers[T76_IC_TASK_MONITOR_MAX_TASKS];
+    configRUN_TIME_COUNTER_TYPE gPreviousRunTimes[T76_IC_TASK_MONITOR_MAX_TASKS];
+    UBaseType_t gPreviousCount = 0;
+    configRUN_TIME_COUNTER_TYPE gPreviousTotal = 0;
+
+    // Core 1 idle time at the previous pass
+    uint32_t gPreviousIdleCycles = 0;
+    uint32_t gPreviousUs = 0;
+
+    // Table being built, and the one published to readers
+    TaskSample gWorking[T76_IC_TASK_MONITOR_MAX_TASKS];
+    TaskSample gPublished[T76_IC_TASK_MONITOR_MAX_TASKS];
+    Summary gSummary = {};
+
+    bool isIdleTask(const TaskStatus_t &status) {
+        return status.uxCurrentPriority == tskIDLE_PRIORITY &&
+               std::strncmp(status.pcTaskName, configIDLE_TASK_NAME, sizeof(configIDLE_TASK_NAME) - 1) == 0;
+    }
+
+    configRUN_TIME_COUNTER_TYPE previousRunTime(uint32_t number, configRUN_TIME_COUNTER_TYPE current) {
+        for (UBaseType_t i = 0; i < gPreviousCount; i++) {
+            if (gPreviousNumbers[i] == number) {
+                return gPreviousRunTimes[i];
+            }
+        }
+
+        return current; // Created since the previous pass; its load shows from the next one
+    }
+
+    uint16_t permille(uint64_t part, uint64_t whole) {
+        if (whole == 0) {
+            return 0;
+        }
+
+        return static_cast<uint16_t>(std::min<uint64_t>(part * 1000 / whole, 1000));
+    }
+
+    void sample() {
+        configRUN_TIME_COUNTER_TYPE total;
+        const UBaseType_t taskCount = uxTaskGetNumberOfTasks();
+        const UBaseType_t count = uxTaskGetSystemState(gStatus, T76_IC_TASK_MONITOR_MAX_TASKS, &total);
+
+        const uint32_t nowUs = time_us_32();
+        const T76::Core::Executive::ExecutiveStats executive = T76::Core::Executive::stats();
+
+        // uxTaskGetSystemState() returns nothing if the array is too small, in which case every task is reported missing
+        const configRUN_TIME_COUNTER_TYPE elapsed = total - gPreviousTotal;
+        const bool firstPass = gSummary.samples == 0;
+        uint32_t idlePermille = 0;
+
+        for (UBaseType_t i = 0; i < count; i++) {
+            const TaskStatus_t &status = gStatus[i];
+            TaskSample &task = gWorking[i];
+
+            std::strncpy(task.name, status.pcTaskName, sizeof(task.name) - 1);
+            task.name[sizeof(task.name) - 1] = '\0';
+            task.number = status.xTaskNumber;
+            task.priority = static_cast<uint8_t>(status.uxCurrentPriority);
+            task.stackFreeBytes = static_cast<uint32_t>(status.usStackHighWaterMark) * sizeof(StackType_t);
+            task.loadPermille = firstPass ? 0 : permille(status.ulRunTimeCounter - previousRunTime(status.xTaskNumber, status.ulRunTimeCounter), elapsed);
+
+            if (isIdleTask(status)) {
+                idlePermille += task.loadPermille;
+            }
+        }
+
+        for (UBaseType_t i = 0; i < count; i++) {
+            gPreviousNumbers[i] = gStatus[i].xTaskNumber;
+            gPreviousRunTimes[i] = gStatus[i].ulRunTimeCounter;
+        }
+
+        gPreviousCount = count;
+        gPreviousTotal = total;
+
+        // The executive counts core 1's sleep in cycles; the period is measured on core 0's timer
+        const uint64_t periodCycles = static_cast<uint64_t>(nowUs - gPreviousUs) * (clock_get_hz(clk_sys) / 1000000);
+        const bool core1Valid = !firstPass && executive.ticks != 0;
+        const uint16_t core1Idle = core1Valid ? permille(executive.idleCycles - gPreviousIdleCycles, periodCycles) : 0;
+
+        gPreviousIdleCycles = executive.idleCycles;
+        gPreviousUs = nowUs;
+
+        taskENTER_CRITICAL();
+
+        std::copy(gWorking, gWorking + count, gPublished);
+
+        gSummary.samples++;
+        gSummary.periodMs = T76_IC_TASK_MONITOR_PERIOD_MS;
+        gSummary.taskCount = count;
+        gSummary.missingTasks = taskCount > count ? taskCount - count : 0;
+        gSummary.core0LoadPermille = firstPass ? 0 : static_cast<uint16_t>(1000 - std::min<uint32_t>(idlePermille, 1000));
+        gSummary.core1LoadPermille = core1Valid ? 1000 - core1Idle : 0;
+        gSummary.core1Valid = core1Valid;
+
+        taskEXIT_CRITICAL();
+    }
+
+    void monitorTask(void *) {
+        TickType_t lastWake = xTaskGetTickCount();
+
+        for (;;) {
+            sample();
+            vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(T76_IC_TASK_MONITOR_PERIOD_MS));
+        }
+    }
+
+} // namespace
+
+
+bool T76::Core::TaskMonitor::init() {
+    if (gTask != nullptr) {
+        return true;
+    }
+
+    if (xTaskCreate(monitorTask, "TaskMon", T76_IC_TASK_MONITOR_TASK_STACK_SIZE, nullptr, T76_IC_TASK_MONITOR_TASK_PRIORITY, &gTask) != pdPASS) {
+        LOGE("TaskMonitor: cannot create the monitor task\n");
+        gTask = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+std::size_t T76::Core::TaskMonitor::copyTasks(TaskSample *tasks, std::size_t maxTasks) {
+    taskENTER_CRITICAL();
+
+    // The first sample has no previous run times to measure loads against
+    const std::size_t count = gSummary.samples > 1 ? std::min<std::size_t>(gSummary.taskCount, maxTasks) : 0;
+
+    std::copy(gPublished, gPublished + count, tasks);
+
+    taskEXIT_CRITICAL();
+
+    return count;
+}
+
+Summary T76::Core::TaskMonitor::summary() {
+    taskENTER_CRITICAL();
+    const Summary summary = gSummary;
+    taskEXIT_CRITICAL();
+
+    return summary;
+}
+
+#else
+
+bool T76::Core::TaskMonitor::init() {
+    return true;
+}
+
+std::size_t T76::Core::TaskMonitor::copyTasks(TaskSample *tasks, std::size_t maxTasks) {
+    return 0;
+}
+
+T76::Core::TaskMonitor::Summary T76::Core::TaskMonitor::summary() {
+    return {};
+}
+
+#endif // T76_IC_TASK_MONITOR
@@ -0,0 +1,9 @@
+# Configurable options for the application framework
+
+set(T76_IC_SCPI_TASK_STACK_SIZE 1024 CACHE STRING "Stack size for the SCPI task (in words)")
+set(T76_IC_SCPI_TASK_PRIORITY 1 CACHE STRING "Priority for the SCPI task")
+set(T76_IC_SCPI_TASK_CORE_AFFINITY 0x2 CACHE STRING "Mask of the cores the SCPI task may run on with T76_IC_SMP (bit 0 for core 0, bit 1 for core 1)")
+set(T76_IC_SCPI_TASK_BUFFER_SIZE 1024 CACHE STRING "Size of the stream buffer that feeds the SCPI task (in bytes)")
+set(T76_IC_SCPI_TASK_HANDLER_BUDGET_US 10000 CACHE STRING "Time the SCPI task may spend on one batch of input before it is counted as an overrun (in us)")
+set(T76_IC_SCPI_TASK_STATUS_POLL_MS 10 CACHE STRING "Longest time between two updates of the status byte by the SCPI task while it is idle (in ms)")
+set(T76_IC_SCPI_TASK_FRAME_SIZE 1024 CACHE STRING "Largest WinUSB request frame executed by the SCPI task, including its header (in bytes, 0 to disable)")
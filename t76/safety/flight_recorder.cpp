@@ -0,0 +1,110 @@
+/**
+ * @file flight_recorder.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the retained flight recorder.
+ *
+ * Both rings and the state that says which one is recording live in the
+ * .uninitialized_data section, like the safety system's shared fault
+ * memory, so nothing the startup code does clears them. A magic number tells
+ * a power-on, after which the contents are garbage, from a reset.
+ */
+
+#include "t76/flight_recorder.hpp"
+
+#include <algorithm>
+
+#include <t76/placement.hpp>
+
+#include "safety_private.hpp"
+
+
+namespace T76::Core::Safety::FlightRecorder {
+
+    /**
+     * @brief Magic number that marks the retained recorder state as valid
+     */
+    static constexpr uint32_t FLIGHT_RECORDER_MAGIC = 0x46524543;
+
+    /**
+     * @brief Retained recorder state
+     */
+    struct RetainedState {
+        uint32_t magic;                 ///< FLIGHT_RECORDER_MAGIC once initialized
+        uint32_t activeRing;            ///< Index of the ring being recorded into
+        uint32_t lastFaultValid;        ///< Nonzero if the other ring holds the record of a fault
+        Ring rings[2];                  ///< The two rings
+    };
+
+    static RetainedState gRetained __attribute__((section(".uninitialized_data"))) __attribute__((aligned(4)));
+
+    T76_CORE1_DATA Ring *gActiveRing = nullptr;
+
+    /**
+     * @brief Copy the events of a ring, oldest first
+     */
+    static std::size_t copyRing(const Ring &ring, Event *events, std::size_t maxEvents, std::size_t first) {
+        const uint32_t head = ring.head.load(std::memory_order_acquire);
+        const uint32_t available = std::min<uint32_t>(head, T76_SAFETY_FLIGHT_RECORDER_SIZE);
+
+        if (first >= available) {
+            return 0;
+        }
+
+        const std::size_t count = std::min<std::size_t>(available - first, maxEvents);
+        const uint32_t oldest = head - available;
+
+        for (std::size_t i = 0; i < count; i++) {
+            events[i] = ring.events[(oldest + first + i) & (T76_SAFETY_FLIGHT_RECORDER_SIZE - 1)];
+        }
+
+        return count;
+    }
+
+    void init(bool previousBootFaulted) {
+        if (gActiveRing != nullptr) {
+            return;
+        }
+
+        if (gRetained.magic != FLIGHT_RECORDER_MAGIC || gRetained.activeRing > 1) {
+            // Power-on: nothing worth keeping
+            gRetained.magic = FLIGHT_RECORDER_MAGIC;
+            gRetained.activeRing = 0;
+            gRetained.lastFaultValid = 0;
+            previousBootFaulted = false;
+        } else if (previousBootFaulted) {
+            // Keep what led up to the fault, and record into the other ring
+            gRetained.activeRing ^= 1;
+            gRetained.lastFaultValid = 1;
+        }
+
+        Ring &ring = gRetained.rings[gRetained.activeRing];
+        ring.head.store(0, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_release);
+        gActiveRing = &ring;
+
+        record(EventId::Boot, previousBootFaulted ? 1 : 0);
+    }
+
+    bool hasLastFault() {
+        return gActiveRing != nullptr && gRetained.lastFaultValid != 0;
+    }
+
+    std::size_t copyLastFault(Event *events, std::size_t maxEvents, std::size_t first) {
+        if (!hasLastFault()) {
+            return 0;
+        }
+
+        return copyRing(gRetained.rings[gRetained.activeRing ^ 1], events, maxEvents, first);
+    }
+
+    std::size_t copyCurrent(Event *events, std::size_t maxEvents, std::size_t first) {
+        if (gActiveRing == nullptr) {
+            return 0;
+        }
+
+        return copyRing(*gActiveRing, events, maxEvents, first);
+    }
+
+} // namespace T76::Core::Safety::FlightRecorder
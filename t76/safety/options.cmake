@@ -12,12 +12,15 @@ SET(T76_SAFETY_FAULTCOUNT_RESET_SECONDS 0 CACHE STRING "Number of seconds after
 # Dual-Core Watchdog System Configuration ===
 SET(T76_SAFETY_DEFAULT_WATCHDOG_TIMEOUT_MS 5000 CACHE STRING "Hardware watchdog timeout in milliseconds (5 seconds)")
 SET(T76_SAFETY_CORE1_HEARTBEAT_TIMEOUT_MS 2000 CACHE STRING "Core 1 heartbeat timeout in milliseconds (2 seconds)")
+option(T76_SAFETY_CORE1_HEARTBEAT_COUNTER "Make the Core 1 heartbeat a counter increment, checked for progress by the watchdog manager task, instead of a timestamp" OFF)
 SET(T76_SAFETY_WATCHDOG_TASK_PERIOD_MS 500 CACHE STRING "Watchdog manager task check period in milliseconds (500ms)")
 SET(T76_SAFETY_WATCHDOG_TASK_PRIORITY 1 CACHE STRING "FreeRTOS priority for watchdog manager task (lowest priority)")
 SET(T76_SAFETY_WATCHDOG_TASK_STACK_SIZE "(configMINIMAL_STACK_SIZE * 2)" CACHE STRING "Stack size for watchdog task")
 
 # Component Registry Configuration ===
 SET(T76_SAFETY_MAX_REGISTERED_COMPONENTS 32 CACHE STRING "Maximum number of SafeableComponent objects that can be registered")
+SET(T76_SAFETY_FLIGHT_RECORDER_SIZE 256 CACHE STRING "Number of events kept by the flight recorder, in each of its two rings; must be a power of two")
+SET(T76_SAFETY_SAFING_TIMEOUT_US 200 CACHE STRING "Time the safing core waits for the other core to safe its components before safing them itself (microseconds)")
 
 # Safety Monitor Configuration ===
 SET(T76_SAFETY_MONITOR_USB_TASK_STACK_SIZE 256 CACHE STRING "Stack size for Safety Monitor USB task (words)")
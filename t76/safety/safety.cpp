@@ -21,6 +21,7 @@
 
 #include <hardware/watchdog.h>
 
+#include "t76/flight_recorder.hpp"
 #include "t76/safety.hpp"
 #include "safety_monitor.hpp"
 #include "safety_private.hpp"
@@ -172,12 +173,20 @@ namespace T76::Core::Safety {
             }
         }
 
+        // Keep the events that led up to the fault, if there was one
+        FlightRecorder::init(wasWatchdogReboot && !isFirstBoot);
+
         // Clear the safety system reset flag and watchdog failure core for next boot
         gSharedFaultSystem->safetySystemReset = false;
         gSharedFaultSystem->watchdogFailureCore = T76_SAFETY_INVALID_CORE_ID;  // Reset for next boot cycle
 
         makeAllComponentsSafe();
 
+        // Let Core 0 safe its own components when Core 1 faults
+        if (get_core_num() == 0) {
+            safingInit();
+        }
+
         // Check reboot count and handle safety monitor
         if (gSharedFaultSystem->rebootCount >= T76_SAFETY_MAX_REBOOTS) {
             // Too many consecutive reboots - enter safety monitor to display fault history
@@ -213,9 +222,11 @@ namespace T76::Core::Safety {
      * information and triggers immediate system recovery through the safety mechanism.
      * 
      * The function performs the following sequence:
-     * 1. Ensures shared memory is available (immediate reset if not)
-     * 2. Populates detailed fault information in shared memory
-     * 3. Triggers fault handling sequence (safing functions + system reset)
+     * 1. Makes all components safe, in priority order and on both cores
+     * 2. Ensures shared memory is available (immediate reset if not)
+     * 3. Populates detailed fault information in shared memory, including
+     *    the time it took to make every component safe
+     * 4. Triggers fault handling sequence (system reset)
      * 
      * Optimized for minimal stack usage and direct operation on shared memory
      * to ensure reliability even under severe fault conditions.
@@ -235,6 +246,17 @@ namespace T76::Core::Safety {
                      const char* file,
                      uint32_t line,
                      const char* function) {
+
+        // Turn the outputs off before spending any time on the report
+        const uint32_t faultCycles = cycles();
+        SafingResult safing;
+
+        FlightRecorder::record(FlightRecorder::EventId::Fault, static_cast<uint32_t>(type), line);
+        safeAllComponents(true, safing);
+
+        const uint32_t timeToSafeCycles = cycles() - faultCycles;
+
+        FlightRecorder::record(FlightRecorder::EventId::Safed, safing.componentsSafed, timeToSafeCycles);
         
         // Ensure shared memory is available
         if (!gSharedFaultSystem) {
@@ -247,6 +269,11 @@ namespace T76::Core::Safety {
 
         // Populate fault information directly in shared memory
         populateFaultInfo(type, description, file, line, function);
+
+        gSharedFaultSystem->lastFaultInfo.timeToSafeCycles = timeToSafeCycles;
+        gSharedFaultSystem->lastFaultInfo.remoteSafingCycles = safing.remoteCycles;
+        gSharedFaultSystem->lastFaultInfo.componentsSafed = safing.componentsSafed;
+        gSharedFaultSystem->lastFaultInfo.remoteSafingTimedOut = safing.remoteTimedOut;
         
         // Handle fault with minimal overhead
         handleFault();
@@ -11,48 +11,119 @@
  * 
  * The registry is self-initializing and works from the very beginning of the
  * application's lifetime, even before C++ runtime initialization is complete.
- * It uses its own dedicated critical section for thread synchronization.
+ * Mutations are serialized by its own dedicated critical section and publish
+ * a new snapshot of the component list; readers, including the fault path,
+ * copy the current snapshot without taking a lock.
  * 
  * Key design principles:
  * - Self-initializing memory structures
  * - Thread-safe for multi-core operation
  * - Minimal memory footprint
  * - No persistence across reboots
- * - Uses dedicated spinlock for better isolation
+ * - Uses dedicated spinlock for mutations only
  * - No exception handling (not supported by target system)
+ * 
+ * Safing is bounded and runs on both cores at once. The core that safes
+ * copies the registry into a plan sorted by SafingPriority, rings a doorbell
+ * that has the other core safe the components assigned to it, and safes its
+ * own and the unassigned ones. Each component is claimed before it is safed,
+ * so that when the other core does not finish within
+ * T76_SAFETY_SAFING_TIMEOUT_US, this core can safe what is left without
+ * calling makeSafe() twice.
  */
 
+#include <atomic>
 #include <cstring>
 #include <cstdint>
 
+#include <FreeRTOS.h>
+
 // Pico SDK includes
 #include <pico/stdlib.h>
 #include <pico/critical_section.h>
+#include <pico/multicore.h>
+#include <hardware/irq.h>
+#include <hardware/structs/m33.h>
+#include <hardware/sync.h>
+#include <hardware/timer.h>
+
+#include <t76/placement.hpp>
 
 #include "t76/safety.hpp"
 #include "safety_private.hpp"
 
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
 namespace T76::Core::Safety {
 
+    /**
+     * @brief One published version of the registry
+     * 
+     * The sequence number is odd while the snapshot is being rewritten, so a
+     * reader that sees it unchanged and even across its copy has a
+     * consistent list.
+     */
+    struct RegistrySnapshot {
+        std::atomic<uint32_t> sequence;                                         ///< Odd while being written
+        uint32_t componentCount;                                                ///< Number of registered components
+        SafeableComponent* components[T76_SAFETY_MAX_REGISTERED_COMPONENTS];   ///< Array of registered components
+    };
+
     /**
      * @brief Component registry structure
      * 
-     * Simple array-based storage for registered components.
+     * Two snapshots of the component list; the one selected by the low bit of
+     * the generation is current. Mutations are serialized by the registry
+     * critical section, rewrite the other snapshot and then publish it by
+     * incrementing the generation, so readers never take a lock and the
+     * current snapshot is never written while it is current.
      * Self-initializes on first use.
      */
     struct ComponentRegistry {
         uint32_t magic;                                                         ///< Magic number for validation
-        uint32_t componentCount;                                                ///< Number of registered components
-        SafeableComponent* components[T76_SAFETY_MAX_REGISTERED_COMPONENTS];   ///< Array of registered components
+        std::atomic<uint32_t> generation;                                       ///< Number of snapshots published
+        RegistrySnapshot snapshots[2];                                          ///< Current and next snapshot
         bool initialized;                                                       ///< Registry initialization flag
     };
 
-    // Global component registry (normal memory, not persistent)
-    static ComponentRegistry gComponentRegistry = {0};
+    // Global component registry (normal memory, not persistent). Zeroed
+    // before any constructor runs, so an uninitialized registry reads as empty
+    static ComponentRegistry gComponentRegistry;
 
-    // Dedicated critical section for component registry synchronization
+    // Dedicated critical section that serializes registry mutations
     static critical_section_t gComponentRegistryCriticalSection;
 
+    /**
+     * @brief Components being safed, in the order they are safed
+     * 
+     * Filled by the core that safes; read by the other core's doorbell
+     * handler. Both cores claim a component before calling makeSafe().
+     */
+    struct SafingPlan {
+        SafeableComponent* components[T76_SAFETY_MAX_REGISTERED_COMPONENTS];   ///< Components sorted by priority
+        SafingCore cores[T76_SAFETY_MAX_REGISTERED_COMPONENTS];                ///< Core that safes each component
+        std::atomic<bool> claimed[T76_SAFETY_MAX_REGISTERED_COMPONENTS];       ///< Set by the core that safes each component
+        uint32_t count;                                                         ///< Number of components in the plan
+    };
+
+    T76_CORE1_DATA static SafingPlan gSafingPlan;
+
+    // Set while a plan is being carried out, so that only one core runs it
+    T76_CORE1_DATA static std::atomic<bool> gSafingActive{false};
+
+    // Handshake with the other core's doorbell handler
+    T76_CORE1_DATA static std::atomic<bool> gSafingRemoteDone{false};
+    T76_CORE1_DATA static std::atomic<uint32_t> gSafingRemoteCycles{0};
+    T76_CORE1_DATA static std::atomic<uint32_t> gSafingCount{0};
+    T76_CORE1_DATA static bool gSafingPark = false;
+
+    // Doorbell shared by both cores, and whether each core handles it
+    T76_CORE1_DATA static int gSafingDoorbell = -1;
+    T76_CORE1_DATA static std::atomic<bool> gSafingCoreReady[NUM_CORES];
+
     /**
      * @brief Initialize the component registry if not already initialized
      * 
@@ -72,12 +143,15 @@ namespace T76::Core::Safety {
         critical_section_enter_blocking(&gComponentRegistryCriticalSection);
         
         if (!gComponentRegistry.initialized) {
-            // Clear the entire structure
-            memset(&gComponentRegistry, 0, sizeof(ComponentRegistry));
-            
-            // Set up the registry
+            // Set up the registry with two empty snapshots
+            for (RegistrySnapshot &snapshot : gComponentRegistry.snapshots) {
+                snapshot.sequence.store(0, std::memory_order_relaxed);
+                snapshot.componentCount = 0;
+                memset(snapshot.components, 0, sizeof(snapshot.components));
+            }
+
+            gComponentRegistry.generation.store(0, std::memory_order_relaxed);
             gComponentRegistry.magic = COMPONENT_REGISTRY_MAGIC;
-            gComponentRegistry.componentCount = 0;
             gComponentRegistry.initialized = true;
         }
         
@@ -91,8 +165,73 @@ namespace T76::Core::Safety {
      */
     static bool isRegistryValid() {
         return (gComponentRegistry.initialized && 
-                gComponentRegistry.magic == COMPONENT_REGISTRY_MAGIC &&
-                gComponentRegistry.componentCount <= T76_SAFETY_MAX_REGISTERED_COMPONENTS);
+                gComponentRegistry.magic == COMPONENT_REGISTRY_MAGIC);
+    }
+
+    /**
+     * @brief Copy the current snapshot without taking a lock
+     * 
+     * Retries if a writer rewrote the snapshot during the copy, which needs
+     * two mutations on the other core within the copy. A mutation interrupted
+     * on this core only ever holds the snapshot that is not current.
+     * 
+     * @param components Receives the registered components
+     * @return Number of components copied
+     */
+    static uint32_t T76_CORE1_CODE copyRegistrySnapshot(SafeableComponent** components) {
+        while (true) {
+            const uint32_t generation = gComponentRegistry.generation.load(std::memory_order_acquire);
+            const RegistrySnapshot &snapshot = gComponentRegistry.snapshots[generation & 1];
+            const uint32_t sequence = snapshot.sequence.load(std::memory_order_acquire);
+
+            if (sequence & 1) {
+                continue;
+            }
+
+            uint32_t count = snapshot.componentCount;
+
+            if (count > T76_SAFETY_MAX_REGISTERED_COMPONENTS) {
+                count = T76_SAFETY_MAX_REGISTERED_COMPONENTS;
+            }
+
+            for (uint32_t i = 0; i < count; i++) {
+                components[i] = snapshot.components[i];
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (snapshot.sequence.load(std::memory_order_relaxed) == sequence) {
+                return count;
+            }
+        }
+    }
+
+    /**
+     * @brief Start rewriting the snapshot that is not current
+     * 
+     * Must be called inside the registry critical section. The returned
+     * snapshot starts as a copy of the current one.
+     */
+    static RegistrySnapshot &beginRegistryUpdate() {
+        const uint32_t generation = gComponentRegistry.generation.load(std::memory_order_relaxed);
+        const RegistrySnapshot &current = gComponentRegistry.snapshots[generation & 1];
+        RegistrySnapshot &next = gComponentRegistry.snapshots[(generation + 1) & 1];
+
+        next.sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        next.componentCount = current.componentCount;
+        memcpy(next.components, current.components, sizeof(next.components));
+
+        return next;
+    }
+
+    /**
+     * @brief Publish the snapshot prepared by beginRegistryUpdate()
+     */
+    static void publishRegistryUpdate(RegistrySnapshot &next) {
+        next.sequence.fetch_add(1, std::memory_order_release);
+        gComponentRegistry.generation.fetch_add(1, std::memory_order_release);
     }
 
     bool registerComponent(SafeableComponent* component) {
@@ -103,27 +242,32 @@ namespace T76::Core::Safety {
         // Ensure registry is initialized
         ensureRegistryInitialized();
 
-        // Thread-safe registration
+        // Mutations are serialized; readers use the published snapshot
         critical_section_enter_blocking(&gComponentRegistryCriticalSection);
         
         bool success = false;
         
         if (isRegistryValid()) {
+            const uint32_t generation = gComponentRegistry.generation.load(std::memory_order_relaxed);
+            const RegistrySnapshot &current = gComponentRegistry.snapshots[generation & 1];
+
             // Check if we have space for another component
-            if (gComponentRegistry.componentCount < T76_SAFETY_MAX_REGISTERED_COMPONENTS) {
+            if (current.componentCount < T76_SAFETY_MAX_REGISTERED_COMPONENTS) {
                 // Check if component is already registered
                 bool alreadyRegistered = false;
-                for (uint32_t i = 0; i < gComponentRegistry.componentCount; i++) {
-                    if (gComponentRegistry.components[i] == component) {
+                for (uint32_t i = 0; i < current.componentCount; i++) {
+                    if (current.components[i] == component) {
                         alreadyRegistered = true;
                         break;
                     }
                 }
                 
                 if (!alreadyRegistered) {
-                    // Add component to registry
-                    gComponentRegistry.components[gComponentRegistry.componentCount] = component;
-                    gComponentRegistry.componentCount++;
+                    // Add component to the next snapshot and publish it
+                    RegistrySnapshot &next = beginRegistryUpdate();
+                    next.components[next.componentCount] = component;
+                    next.componentCount++;
+                    publishRegistryUpdate(next);
                     success = true;
                 }
             }
@@ -141,23 +285,29 @@ namespace T76::Core::Safety {
         // Ensure registry is initialized
         ensureRegistryInitialized();
 
-        // Thread-safe unregistration
+        // Mutations are serialized; readers use the published snapshot
         critical_section_enter_blocking(&gComponentRegistryCriticalSection);
         
         bool success = false;
         
         if (isRegistryValid()) {
+            const uint32_t generation = gComponentRegistry.generation.load(std::memory_order_relaxed);
+            const RegistrySnapshot &current = gComponentRegistry.snapshots[generation & 1];
+
             // Find the component in the registry
-            for (uint32_t i = 0; i < gComponentRegistry.componentCount; i++) {
-                if (gComponentRegistry.components[i] == component) {
+            for (uint32_t i = 0; i < current.componentCount; i++) {
+                if (current.components[i] == component) {
+                    RegistrySnapshot &next = beginRegistryUpdate();
+
                     // Remove component by shifting remaining components down
-                    for (uint32_t j = i; j < gComponentRegistry.componentCount - 1; j++) {
-                        gComponentRegistry.components[j] = gComponentRegistry.components[j + 1];
+                    for (uint32_t j = i; j < next.componentCount - 1; j++) {
+                        next.components[j] = next.components[j + 1];
                     }
                     
                     // Clear the last slot and decrement count
-                    gComponentRegistry.components[gComponentRegistry.componentCount - 1] = nullptr;
-                    gComponentRegistry.componentCount--;
+                    next.components[next.componentCount - 1] = nullptr;
+                    next.componentCount--;
+                    publishRegistryUpdate(next);
                     success = true;
                     break;
                 }
@@ -169,78 +319,228 @@ namespace T76::Core::Safety {
     }
 
     bool activateAllComponents(const char** failingComponentName) {
-        // Ensure registry is initialized
-        ensureRegistryInitialized();
-
         // Clear the output parameter initially
         if (failingComponentName != nullptr) {
             *failingComponentName = nullptr;
         }
 
-        // Thread-safe activation
-        critical_section_enter_blocking(&gComponentRegistryCriticalSection);
+        // Work from a copy of the current snapshot, without holding a lock during activation
+        SafeableComponent* localComponents[T76_SAFETY_MAX_REGISTERED_COMPONENTS];
+        const uint32_t localCount = copyRegistrySnapshot(localComponents);
         
-        if (isRegistryValid()) {
-            // Create a local copy of components to avoid holding the lock during activation
-            SafeableComponent* localComponents[T76_SAFETY_MAX_REGISTERED_COMPONENTS];
-            uint32_t localCount = gComponentRegistry.componentCount;
-            
-            for (uint32_t i = 0; i < localCount; i++) {
-                localComponents[i] = gComponentRegistry.components[i];
-            }
-            
-            critical_section_exit(&gComponentRegistryCriticalSection);
-            
-            // Call activate() on each component (outside the critical section)
-            for (uint32_t i = 0; i < localCount; i++) {
-                if (localComponents[i] != nullptr) {
-                    if (!localComponents[i]->activate()) {
-                        // If any component fails to activate, capture the component name
-                        if (failingComponentName != nullptr) {
-                            *failingComponentName = localComponents[i]->getComponentName();
-                        }
-                        
-                        // Make all components safe and return false
-                        makeAllComponentsSafe();
-                        return false;
+        // Call activate() on each component
+        for (uint32_t i = 0; i < localCount; i++) {
+            if (localComponents[i] != nullptr) {
+                if (!localComponents[i]->activate()) {
+                    // If any component fails to activate, capture the component name
+                    if (failingComponentName != nullptr) {
+                        *failingComponentName = localComponents[i]->getComponentName();
                     }
+                    
+                    // Make all components safe and return false
+                    makeAllComponentsSafe();
+                    return false;
                 }
             }
-        } else {
-            critical_section_exit(&gComponentRegistryCriticalSection);
         }
         
         return true;
     }
 
-    void makeAllComponentsSafe() {
-        // Ensure registry is initialized
-        ensureRegistryInitialized();
+    uint32_t T76_CORE1_CODE cycles() {
+        return m33_hw->dwt_cyccnt;
+    }
 
-        // Thread-safe safing
-        critical_section_enter_blocking(&gComponentRegistryCriticalSection);
-        
-        if (isRegistryValid()) {
-            // Create a local copy of components to avoid holding the lock during safing
-            SafeableComponent* localComponents[T76_SAFETY_MAX_REGISTERED_COMPONENTS];
-            uint32_t localCount = gComponentRegistry.componentCount;
-            
-            for (uint32_t i = 0; i < localCount; i++) {
-                localComponents[i] = gComponentRegistry.components[i];
-            }
-            
-            critical_section_exit(&gComponentRegistryCriticalSection);
-            
-            // Call makeSafe() on each component (outside the critical section)
-            for (uint32_t i = 0; i < localCount; i++) {
-                if (localComponents[i] != nullptr) {
-                    localComponents[i]->makeSafe();
-                    // makeSafe() must be reliable - continue safing other components
+    /**
+     * @brief Safe the planned components that belong to the given core
+     * 
+     * Walks the plan in priority order and safes every unclaimed component
+     * assigned to the core, and those assigned to no core when includeAny
+     * is true. Passing SafingCore::Any safes every unclaimed component.
+     */
+    static void T76_CORE1_CODE safePlannedComponents(SafingCore core, bool includeAny) {
+        for (uint32_t i = 0; i < gSafingPlan.count; i++) {
+            const SafingCore owner = gSafingPlan.cores[i];
+
+            if (core != SafingCore::Any && owner != core && !(includeAny && owner == SafingCore::Any)) {
+                continue;
+            }
+
+            if (gSafingPlan.claimed[i].exchange(true, std::memory_order_acq_rel)) {
+                continue;
+            }
+
+            // makeSafe() must be reliable - continue safing other components
+            gSafingPlan.components[i]->makeSafe();
+            gSafingCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Doorbell handler that safes the components belonging to this core
+     * 
+     * Runs on the core that did not start the safing, ahead of the other
+     * handlers of the doorbell interrupt, at configMAX_SYSCALL_INTERRUPT_PRIORITY.
+     * On the fault path it then parks the core until the reset.
+     */
+    static void T76_CORE1_CODE safingDoorbellHandler() {
+        if (gSafingDoorbell < 0 || !multicore_doorbell_is_set_current_core(gSafingDoorbell)) {
+            return;
+        }
+
+        multicore_doorbell_clear_current_core(gSafingDoorbell);
+
+        if (!gSafingActive.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        const uint32_t start = cycles();
+
+        safePlannedComponents(get_core_num() == 0 ? SafingCore::Core0 : SafingCore::Core1, false);
+
+        gSafingRemoteCycles.store(cycles() - start, std::memory_order_relaxed);
+        gSafingRemoteDone.store(true, std::memory_order_release);
+
+        if (gSafingPark) {
+            save_and_disable_interrupts();
+
+            while (true) {
+                tight_loop_contents();
+            }
+        }
+    }
+
+    void safingInit() {
+        const uint core = get_core_num();
+
+        // Time-to-safe is measured with the core's own cycle counter
+        m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+        m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+
+        // Core 0 claims the doorbell before Core 1 is launched
+        if (gSafingDoorbell < 0) {
+            if (core != 0) {
+                return;
+            }
+
+            gSafingDoorbell = multicore_doorbell_claim_unused((1u << NUM_CORES) - 1, false);
+
+            if (gSafingDoorbell < 0) {
+                LOGE("Safety: no doorbell left for parallel safing\n");
+                return;
+            }
+        }
+
+        const uint doorbellIrq = multicore_doorbell_irq_num(gSafingDoorbell);
+
+        // The doorbell interrupt is shared, and safing must run ahead of every other handler. Other
+        // handlers call FreeRTOS, so the interrupt cannot be raised above configMAX_SYSCALL_INTERRUPT_PRIORITY,
+        // which still preempts every interrupt at the SDK's default priority.
+        irq_add_shared_handler(doorbellIrq, safingDoorbellHandler, PICO_SHARED_IRQ_HANDLER_HIGHEST_ORDER_PRIORITY);
+        irq_set_priority(doorbellIrq, configMAX_SYSCALL_INTERRUPT_PRIORITY);
+        irq_set_enabled(doorbellIrq, true);
+
+        gSafingCoreReady[core].store(true, std::memory_order_release);
+    }
+
+    void core1Init() {
+        if (get_core_num() != 1) {
+            return;
+        }
+
+        safingInit();
+    }
+
+    void safeAllComponents(bool parkOtherCore, SafingResult &result) {
+        result = SafingResult{};
+
+        // Another core is already safing everything
+        if (gSafingActive.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+
+        // Build the plan from the current snapshot; no lock is taken, so a
+        // fault never waits on a registry mutation, even one it interrupted
+        SafeableComponent* registered[T76_SAFETY_MAX_REGISTERED_COMPONENTS];
+        const uint32_t registeredCount = copyRegistrySnapshot(registered);
+
+        gSafingPlan.count = 0;
+
+        // Insertion sort by priority, keeping registration order within a class
+        for (uint32_t i = 0; i < registeredCount; i++) {
+            SafeableComponent* component = registered[i];
+
+            if (component == nullptr) {
+                continue;
+            }
+
+            const SafingPriority priority = component->getSafingPriority();
+            uint32_t j = gSafingPlan.count;
+
+            while (j > 0 && gSafingPlan.components[j - 1]->getSafingPriority() > priority) {
+                gSafingPlan.components[j] = gSafingPlan.components[j - 1];
+                gSafingPlan.cores[j] = gSafingPlan.cores[j - 1];
+                j--;
+            }
+
+            gSafingPlan.components[j] = component;
+            gSafingPlan.cores[j] = component->getSafingCore();
+            gSafingPlan.count++;
+        }
+
+        const uint core = get_core_num();
+        const uint otherCore = core ^ 1;
+        const SafingCore thisSafingCore = core == 0 ? SafingCore::Core0 : SafingCore::Core1;
+        const SafingCore otherSafingCore = core == 0 ? SafingCore::Core1 : SafingCore::Core0;
+
+        bool remoteRequested = false;
+
+        for (uint32_t i = 0; i < gSafingPlan.count; i++) {
+            gSafingPlan.claimed[i].store(false, std::memory_order_relaxed);
+            remoteRequested |= (gSafingPlan.cores[i] == otherSafingCore);
+        }
+
+        gSafingCount.store(0, std::memory_order_relaxed);
+        remoteRequested &= gSafingCoreReady[otherCore].load(std::memory_order_acquire);
+
+        // Let the other core start on its components before this one starts on its own
+        if (remoteRequested) {
+            gSafingPark = parkOtherCore;
+            gSafingRemoteDone.store(false, std::memory_order_relaxed);
+            gSafingRemoteCycles.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            multicore_doorbell_set_other_core(gSafingDoorbell);
+        }
+
+        safePlannedComponents(thisSafingCore, true);
+
+        if (remoteRequested) {
+            const uint32_t start = time_us_32();
+
+            while (!gSafingRemoteDone.load(std::memory_order_acquire)) {
+                if (time_us_32() - start >= T76_SAFETY_SAFING_TIMEOUT_US) {
+                    result.remoteTimedOut = true;
+                    break;
                 }
+
+                tight_loop_contents();
             }
-        } else {
-            critical_section_exit(&gComponentRegistryCriticalSection);
+
+            result.remoteCycles = gSafingRemoteCycles.load(std::memory_order_relaxed);
         }
+
+        // Whatever the other core did not claim in time, or could not be asked to safe
+        safePlannedComponents(SafingCore::Any, true);
+
+        result.componentsSafed = static_cast<uint16_t>(gSafingCount.load(std::memory_order_relaxed));
+
+        gSafingActive.store(false, std::memory_order_release);
+    }
+
+    void makeAllComponentsSafe() {
+        SafingResult result;
+        safeAllComponents(false, result);
     }
 
     SafeableComponent::SafeableComponent() {
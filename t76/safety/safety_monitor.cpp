@@ -15,11 +15,15 @@
 #include <task.h>
 
 // Pico SDK includes
+#include <pico/error.h>
 #include <pico/stdlib.h>
+#include <pico/stdio/driver.h>
 #include <pico/time.h>
+#include <hardware/clocks.h>
 #include <tusb.h>
 
 
+#include "t76/flight_recorder.hpp"
 #include "t76/safety.hpp"
 
 
@@ -50,6 +54,49 @@ namespace T76::Core {
         // Forward declaration of shared fault system structure
         namespace Safety = T76::Core::Safety;
 
+        /**
+         * @brief stdio driver of the CDC port.
+         *
+         * Replaces the driver of pico_stdio_usb, which runs `tud_task()` from
+         * whichever task prints, concurrently with tinyUSBTask().
+         */
+        static stdio_driver_t gCDCStdioDriver;
+
+        /**
+         * @brief stdio output hook; queues the output in TinyUSB's FIFO.
+         *
+         * Waits for up to PICO_STDIO_USB_STDOUT_TIMEOUT_US for the host to
+         * drain a full FIFO, then drops the rest of the output.
+         */
+        static void cdcStdioOutChars(const char *buffer, int length) {
+            int written = 0;
+            TickType_t waited = 0;
+
+            while (written < length && tud_cdc_connected()) {
+                const uint32_t count = tud_cdc_write(buffer + written, static_cast<uint32_t>(length - written));
+                tud_cdc_write_flush();
+                written += static_cast<int>(count);
+
+                if (count == 0) {
+                    if (__get_current_exception() != 0 || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING ||
+                        waited >= pdMS_TO_TICKS(PICO_STDIO_USB_STDOUT_TIMEOUT_US / 1000)) {
+                        break;
+                    }
+
+                    vTaskDelay(1);
+                    waited++;
+                }
+            }
+        }
+
+        /**
+         * @brief stdio input hook; reads what the host has sent.
+         */
+        static int cdcStdioInChars(char *buffer, int length) {
+            const uint32_t count = tud_cdc_read(buffer, static_cast<uint32_t>(length));
+            return count > 0 ? static_cast<int>(count) : PICO_ERROR_NO_DATA;
+        }
+
         /**
          * @brief FreeRTOS task for TinyUSB device processing
          * 
@@ -57,8 +104,10 @@ namespace T76::Core {
          * during Safety Monitor operation. This enables console output over USB
          * for fault reporting and system status information.
          * 
-         * The task runs continuously with a 10ms delay between TinyUSB task
-         * executions to balance responsiveness with system resource usage.
+         * With the FreeRTOS OSAL, `tud_task()` blocks on the TinyUSB event
+         * queue, so the task only runs when the USB interrupt has posted work.
+         * It is the only caller of `tud_task()`; console output only queues
+         * data through the CDC stdio driver.
          * 
          * @param param Unused task parameter (required by FreeRTOS task signature)
          * 
@@ -75,7 +124,6 @@ namespace T76::Core {
             // Main loop for TinyUSB task
             while (true) {
                 tud_task(); // tinyusb device task
-                vTaskDelay(pdMS_TO_TICKS(1));
             }
         }
 
@@ -99,6 +147,7 @@ namespace T76::Core {
                 case T76::Core::Safety::FaultType::RESOURCE_EXHAUSTED: return "RESOURCE_EXHAUSTED";
                 case T76::Core::Safety::FaultType::WATCHDOG_TIMEOUT: return "WATCHDOG_TIMEOUT";
                 case T76::Core::Safety::FaultType::ACTIVATION_FAILED: return "ACTIVATION_FAILED";
+                case T76::Core::Safety::FaultType::DEADLINE_MISSED: return "DEADLINE_MISSED";
                 default: return "INVALID";
             }
         }
@@ -131,6 +180,19 @@ namespace T76::Core {
                 printf("Min Heap Free: %lu bytes\n", faultInfo.minHeapFreeBytes);
             }
 
+            if (faultInfo.timeToSafeCycles > 0) {
+                const uint32_t cyclesPerUs = clock_get_hz(clk_sys) / 1000000;
+
+                printf("Time to Safe: %lu cycles (%lu us), %u components\n",
+                       faultInfo.timeToSafeCycles, faultInfo.timeToSafeCycles / cyclesPerUs, faultInfo.componentsSafed);
+
+                if (faultInfo.remoteSafingTimedOut) {
+                    printf("Other Core Safing: timed out\n");
+                } else if (faultInfo.remoteSafingCycles > 0) {
+                    printf("Other Core Safing: %lu cycles\n", faultInfo.remoteSafingCycles);
+                }
+            }
+
             // Print comprehensive stack information
             printf("\n--- Stack Information ---\n");
             if (faultInfo.stackInfo.isValidStackInfo) {
@@ -147,6 +209,34 @@ namespace T76::Core {
             printf("==============================\n\n");
         }
 
+    /**
+     * @brief Print the flight recorder events that led up to the last fault.
+     * Copies a few events at a time, so that no buffer the size of the ring is needed.
+     */
+        static void printFlightRecorderToConsole() {
+            if (!Safety::FlightRecorder::hasLastFault()) {
+                return;
+            }
+
+            printf("--- FLIGHT RECORDER (oldest first) ---\n");
+            printf("Time (us)   Core  Event   Arg0        Arg1\n");
+
+            Safety::FlightRecorder::Event events[16];
+            std::size_t first = 0;
+            std::size_t count;
+
+            while ((count = Safety::FlightRecorder::copyLastFault(events, 16, first)) > 0) {
+                for (std::size_t i = 0; i < count; i++) {
+                    printf("%10lu  %4u  0x%04X  0x%08lX  0x%08lX\n",
+                           events[i].timestamp, events[i].core, events[i].id, events[i].arg0, events[i].arg1);
+                }
+
+                first += count;
+            }
+
+            printf("\n");
+        }
+
     /**
      * @brief Print fault history and reboot limit status.
      */
@@ -172,6 +262,8 @@ namespace T76::Core {
                 printFaultInfoToConsole(Safety::gSharedFaultSystem->faultHistory[i]);
             }
 
+            printFlightRecorderToConsole();
+
             printf("System halted to prevent infinite reboot loop.\n");
             printf("Manual intervention required.\n\n");
         }
@@ -232,8 +324,15 @@ namespace T76::Core {
          * @note Provides infinite loop fallback if scheduler fails to start
          */
         void runSafetyMonitor() {
-            // Initialize stdio for output
+            // Initialize stdio for output, and route it through the CDC port
             stdio_init_all();
+
+            gCDCStdioDriver.out_chars = cdcStdioOutChars;
+            gCDCStdioDriver.in_chars = cdcStdioInChars;
+#if PICO_STDIO_ENABLE_CRLF_SUPPORT
+            gCDCStdioDriver.crlf_enabled = PICO_STDIO_DEFAULT_CRLF;
+#endif
+            stdio_set_driver_enabled(&gCDCStdioDriver, true);
             
             // Create FreeRTOS tasks for Safety Monitor operation
             xTaskCreate(
@@ -114,8 +114,8 @@ namespace T76::Core::Safety {
         gSharedFaultSystem->lastFaultInfo.stackInfo.isMainStack = (currentSP == mainStackPointer);
         
         // Get stack information based on context
-        if (get_core_num() == 0) {
-            // Core 0 - FreeRTOS context
+        if (coreRunsFreeRTOS()) {
+            // FreeRTOS context
             uint32_t ipsr;
             __asm volatile ("MRS %0, IPSR" : "=r" (ipsr));
             bool inInterrupt = (ipsr & 0x1FF) != 0;
@@ -189,8 +189,8 @@ namespace T76::Core::Safety {
     static inline void getHeapStats() {
         if (!gSharedFaultSystem) return;
         
-        if (get_core_num() == 0) {
-            // On Core 0, we can use FreeRTOS heap functions
+        if (coreRunsFreeRTOS()) {
+            // With FreeRTOS on this core, we can use its heap functions
             gSharedFaultSystem->lastFaultInfo.heapFreeBytes = xPortGetFreeHeapSize();
             gSharedFaultSystem->lastFaultInfo.minHeapFreeBytes = xPortGetMinimumEverFreeHeapSize();
         } else {
@@ -242,8 +242,8 @@ namespace T76::Core::Safety {
         __asm volatile ("MRS %0, IPSR" : "=r" (ipsr));
         bool inInterrupt = (ipsr & 0x1FF) != 0;
 
-        if (get_core_num() == 0 && !inInterrupt) {
-            // Only available on Core 0 in task context
+        if (coreRunsFreeRTOS() && !inInterrupt) {
+            // Only available in task context on a core that runs FreeRTOS
             TaskHandle_t currentTask = xTaskGetCurrentTaskHandle();
             if (currentTask != nullptr) {
                 gSharedFaultSystem->lastFaultInfo.taskHandle = reinterpret_cast<uint32_t>(currentTask);
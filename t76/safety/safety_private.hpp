@@ -63,7 +63,7 @@
  * This constant is used to validate that the shared memory structure
  * has been properly initialized and is not corrupted.
  */
-#define FAULT_SYSTEM_MAGIC 0x54F3570
+#define FAULT_SYSTEM_MAGIC 0x54F3571
 
 /**
  * @brief Magic number for component registry validation
@@ -105,6 +105,7 @@ namespace T76::Core::Safety {
         RESOURCE_EXHAUSTED,       ///< System resource exhaustion
         WATCHDOG_TIMEOUT,         ///< Hardware watchdog timeout (Core 1 hang)
         ACTIVATION_FAILED,        ///< Activation failed at startup
+        DEADLINE_MISSED,          ///< Executive job reached its limit of consecutive overruns
     };
 
     /**
@@ -125,8 +126,21 @@ namespace T76::Core::Safety {
         bool isInInterrupt;                                     ///< True if fault occurred in interrupt context
         uint32_t interruptNumber;                               ///< Interrupt number (if in interrupt)
         StackInfo stackInfo;                                    ///< Stack information at time of fault
+        uint32_t timeToSafeCycles;                              ///< Cycles from the fault report until every component was safe
+        uint32_t remoteSafingCycles;                            ///< Cycles the other core spent safing its components (0 if it took no part)
+        uint16_t componentsSafed;                               ///< Number of components made safe
+        bool remoteSafingTimedOut;                              ///< True if the other core did not finish within T76_SAFETY_SAFING_TIMEOUT_US
     } FaultInfo;
 
+    /**
+     * @brief Outcome of safing all components
+     */
+    struct SafingResult {
+        uint32_t remoteCycles;                  ///< Cycles the other core spent safing its components
+        uint16_t componentsSafed;               ///< Number of components made safe
+        bool remoteTimedOut;                    ///< True if the other core did not finish in time
+    };
+
     /**
      * @brief Shared memory structure for inter-core fault communication
      * 
@@ -244,6 +258,48 @@ namespace T76::Core::Safety {
      */
     void clearFaultHistory();
 
+    /**
+     * @brief Read the calling core's cycle counter
+     * 
+     * Each core has its own counter, so only differences taken on the same
+     * core are meaningful.
+     */
+    uint32_t cycles();
+
+    /**
+     * @brief Enable the calling core's safing doorbell and cycle counter
+     * 
+     * Called by init() on Core 0 and by core1Init() on Core 1.
+     */
+    void safingInit();
+
+    /**
+     * @brief Make all registered components safe, in parallel on both cores
+     * 
+     * Implements makeAllComponentsSafe(). When parkOtherCore is true, as on
+     * the fault path, the other core stays in its doorbell handler with
+     * interrupts disabled after safing its components, so that nothing it
+     * runs can turn an output back on before the reset.
+     * 
+     * @param parkOtherCore Whether to leave the other core parked
+     * @param result Receives the number of components safed and the other core's timing
+     */
+    void safeAllComponents(bool parkOtherCore, SafingResult &result);
+
+    /**
+     * @brief Whether the calling core runs FreeRTOS tasks
+     * 
+     * Only Core 0 does, unless T76_IC_SMP runs the scheduler on both cores.
+     * Task names, stack marks and heap figures are only captured where it does.
+     */
+    inline bool coreRunsFreeRTOS() {
+#ifdef T76_IC_SMP
+        return true;
+#else
+        return get_core_num() == 0;
+#endif
+    }
+
 
 
 } // namespace T76::Core::Safety
\ No newline at end of file
@@ -10,7 +10,9 @@
  * - Hardware watchdog is only fed when both cores are confirmed healthy
  * 
  * Architecture:
- * - Core 1 calls sendCore1Heartbeat() periodically to indicate it's alive
+ * - Core 1 calls sendCore1Heartbeat() periodically to indicate it's alive; with
+ *   T76_SAFETY_CORE1_HEARTBEAT_COUNTER it only increments a shared counter,
+ *   which keeps timer reads out of control-loop interrupts
  * - Core 0 runs a FreeRTOS watchdog manager task that:
  *   * Receives heartbeats from Core 1
  *   * Monitors Core 0 FreeRTOS task health
@@ -28,11 +30,21 @@
  * 2. Core 1 calls sendCore1Heartbeat() periodically (at least every 1 second)
  * 3. Core 0 watchdog manager automatically handles hardware watchdog feeding
  * 4. System reset occurs if either core fails to respond within timeout
+ * 
+ * With T76_IC_SMP, both cores run FreeRTOS tasks. The manager task is pinned
+ * to Core 0, and the Core 1 heartbeat is sent by a task of the same low
+ * priority pinned to Core 1, so that each core proves that it still gets to
+ * its idle-level work.
  */
 
 #include "safety_private.hpp"
+#include "t76/flight_recorder.hpp"
 #include "t76/safety.hpp"
 
+#include <hardware/timer.h>
+
+#include <t76/placement.hpp>
+
 namespace T76::Core::Safety {
 
     // Inter-core communication constants - now using centralized configuration
@@ -54,7 +66,15 @@ namespace T76::Core::Safety {
     
     // Shared memory for inter-core communication
     // 32-bit writes are atomic on ARM Cortex-M33, so no synchronization needed
-    static volatile uint32_t gCore1LastHeartbeat = 0;
+    // The timestamp is in microseconds, so that core 1 can take it with a single
+    // register read rather than a call into flash
+#ifdef T76_SAFETY_CORE1_HEARTBEAT_COUNTER
+    // In counter mode, core 1 only increments this counter; the manager task
+    // detects progress by comparing it across its check periods
+    T76_CORE1_DATA static volatile uint32_t gCore1HeartbeatCount = 0;
+#else
+    T76_CORE1_DATA static volatile uint32_t gCore1LastHeartbeat = 0;
+#endif
     
     // Watchdog failure core is stored in persistent shared memory (gSharedFaultSystem->watchdogFailureCore)
     // This survives hardware resets and allows accurate fault reporting after reboot
@@ -78,13 +98,34 @@ namespace T76::Core::Safety {
         (void)pvParameters;
         
         TickType_t lastWakeTime = xTaskGetTickCount();
+
+#ifdef T76_SAFETY_CORE1_HEARTBEAT_COUNTER
+        uint32_t lastCount = 0;
+        uint32_t lastProgress = time_us_32();
+        bool core1Started = false;
+#endif
         
         while (true) {
+#ifdef T76_SAFETY_CORE1_HEARTBEAT_COUNTER
+            // Check if Core 1 has advanced its counter recently
+            uint32_t currentTime = time_us_32();
+            uint32_t count = gCore1HeartbeatCount;  // Read shared counter
+
+            if (count != lastCount) {
+                lastCount = count;
+                lastProgress = currentTime;
+                core1Started = true;
+            }
+
+            bool core1Healthy = core1Started &&
+                               (currentTime - lastProgress) < CORE1_HEARTBEAT_TIMEOUT_MS * 1000;
+#else
             // Check if Core 1 heartbeat is still fresh
-            uint32_t currentTime = to_ms_since_boot(get_absolute_time());
+            uint32_t currentTime = time_us_32();
             uint32_t lastHeartbeat = gCore1LastHeartbeat;  // Read shared timestamp
             bool core1Healthy = (lastHeartbeat > 0) && 
-                               (currentTime - lastHeartbeat) < CORE1_HEARTBEAT_TIMEOUT_MS;
+                               (currentTime - lastHeartbeat) < CORE1_HEARTBEAT_TIMEOUT_MS * 1000;
+#endif
             
             // Check Core 0 health (basic FreeRTOS scheduler health)
             bool core0Healthy = (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
@@ -97,8 +138,10 @@ namespace T76::Core::Safety {
                 // Record which core failed first (for hardware watchdog handler)
                 if (!core0Healthy && gSharedFaultSystem->watchdogFailureCore == T76_SAFETY_INVALID_CORE_ID) {
                     gSharedFaultSystem->watchdogFailureCore = 0;  // Core 0 failed
+                    FlightRecorder::record(FlightRecorder::EventId::WatchdogUnhealthy, 0);
                 } else if (!core1Healthy && gSharedFaultSystem->watchdogFailureCore == T76_SAFETY_INVALID_CORE_ID) {
                     gSharedFaultSystem->watchdogFailureCore = 1;  // Core 1 failed
+                    FlightRecorder::record(FlightRecorder::EventId::WatchdogUnhealthy, 1);
                 }
                 // Don't feed watchdog - let hardware watchdog reset the system
             }
@@ -108,6 +151,28 @@ namespace T76::Core::Safety {
         }
     }
 
+#ifdef T76_IC_SMP
+    /**
+     * @brief Task pinned to Core 1 that sends its heartbeat
+     * 
+     * Runs at the manager task's priority, so that a Core 1 saturated by
+     * higher-priority tasks stops the heartbeat just as a saturated Core 0
+     * stops the manager task.
+     * 
+     * @param pvParameters Unused task parameter
+     */
+    static void watchdogHeartbeatTask(void* pvParameters) {
+        (void)pvParameters;
+
+        TickType_t lastWakeTime = xTaskGetTickCount();
+
+        while (true) {
+            feedWatchdogFromCore1();
+            vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(WATCHDOG_TASK_PERIOD_MS));
+        }
+    }
+#endif
+
     /**
      * @brief Initialize dual-core watchdog protection system
      * 
@@ -144,25 +209,53 @@ namespace T76::Core::Safety {
         watchdog_enable(T76_SAFETY_DEFAULT_WATCHDOG_TIMEOUT_MS, 1);
 
         // Initialize shared memory for heartbeat communication
+#ifdef T76_SAFETY_CORE1_HEARTBEAT_COUNTER
+        gCore1HeartbeatCount = 0;
+#else
         gCore1LastHeartbeat = 0;
+#endif
         // watchdogFailureCore is now initialized in init()
 
         // Create the watchdog manager task with lowest priority
         // This ensures it only runs when no other tasks need CPU time,
         // which better reflects actual system health
+        TaskHandle_t managerTask = nullptr;
+
         BaseType_t result = xTaskCreate(
             watchdogManagerTask,
             "WatchdogMgr",
             T76_SAFETY_WATCHDOG_TASK_STACK_SIZE,  // Give it enough stack
             nullptr,
             T76_SAFETY_WATCHDOG_TASK_PRIORITY,    // Lowest priority - only runs when system is idle
-            nullptr
+            &managerTask
+        );
+
+        if (result != pdPASS) {
+            return false;
+        }
+
+#ifdef T76_IC_SMP
+        // Each core's health is measured by a task that cannot migrate to the other
+        vTaskCoreAffinitySet(managerTask, 1u << 0);
+
+        TaskHandle_t heartbeatTask = nullptr;
+
+        result = xTaskCreate(
+            watchdogHeartbeatTask,
+            "WatchdogHb",
+            configMINIMAL_STACK_SIZE,
+            nullptr,
+            T76_SAFETY_WATCHDOG_TASK_PRIORITY,
+            &heartbeatTask
         );
 
         if (result != pdPASS) {
             return false;
         }
 
+        vTaskCoreAffinitySet(heartbeatTask, 1u << 1);
+#endif
+
         gWatchdogInitialized = true;
         return true;
     }
@@ -179,18 +272,28 @@ namespace T76::Core::Safety {
      * healthy and continues feeding the hardware watchdog.
      * 
      * @note Should be called only from Core 1
+     * @note With T76_IC_SMP, called by the safety system's own heartbeat task;
+     *       the application must not call it
      * @note Safe to call from any context on Core 1 (interrupt or main thread)
      * @note Must be called regularly (at least every 1 second)
-     * @note No-op if called from Core 0 or if watchdog system not initialized
+     * @note No-op if called from Core 0 or if watchdog system not initialized,
+     *       except in counter mode (T76_SAFETY_CORE1_HEARTBEAT_COUNTER), where
+     *       the call only increments a counter and must not be made from Core 0
      */
-    void feedWatchdogFromCore1() {
+    void T76_CORE1_CODE feedWatchdogFromCore1() {
+#ifdef T76_SAFETY_CORE1_HEARTBEAT_COUNTER
+        // Single writer, so a plain increment is enough; the manager task only
+        // looks for a change in value
+        gCore1HeartbeatCount = gCore1HeartbeatCount + 1;
+#else
         // Only send heartbeats from Core 1
         if (get_core_num() != 1 || !gWatchdogInitialized) {
             return;
         }
 
         // Update shared timestamp (32-bit write is atomic on ARM Cortex-M33)
-        gCore1LastHeartbeat = to_ms_since_boot(get_absolute_time());
+        gCore1LastHeartbeat = time_us_32();
+#endif
     }
 
 } // namespace T76::Core::Safety
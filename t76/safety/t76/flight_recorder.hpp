@@ -0,0 +1,151 @@
+/**
+ * @file flight_recorder.hpp
+ * @brief Retained ring of recent events for post-fault analysis
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The flight recorder keeps the most recent events in a ring of compact
+ * binary records in uninitialized RAM, next to the safety system's fault
+ * information, so that it survives the watchdog reset that follows a fault.
+ * Recording an event claims a slot with one atomic increment and fills in
+ * the timestamp, core, event id and two arguments, so it can be used in
+ * interrupt handlers and on core 1:
+ *
+ *     constexpr uint16_t OvercurrentTrip = 0x0100;      // EventId::Application and above
+ *
+ *     T76::Core::Safety::FlightRecorder::record(OvercurrentTrip, current, limit);
+ *
+ * When the system boots after a fault, the ring that was recording is kept as
+ * the record of that fault and recording continues in a second ring. The kept
+ * ring stays available, through copyLastFault(), until the next fault. The
+ * safety monitor prints it with the fault history.
+ *
+ * Event ids below EventId::Application are used by the framework.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <pico/platform.h>
+
+#include <t76/timebase.hpp>
+
+
+namespace T76::Core::Safety::FlightRecorder {
+
+    /**
+     * @brief Ids of the events recorded by the framework
+     */
+    enum class EventId : uint16_t {
+        Boot                = 0x0001,   ///< The recorder started; arg0 is 1 if the previous boot faulted
+        Fault               = 0x0002,   ///< A fault was reported; arg0 is the FaultType, arg1 the line
+        Safed               = 0x0003,   ///< Components were made safe; arg0 is their count, arg1 the cycles it took
+        WatchdogUnhealthy   = 0x0004,   ///< The watchdog manager stopped feeding; arg0 is the failing core
+        ExecutiveOverrun    = 0x0005,   ///< An executive job overran its budget; arg0 is the job id, arg1 the cycles it ran
+        DeadlineMissed      = 0x0006,   ///< An executive job reached its overrun limit; arg0 is the job id, arg1 the consecutive overruns
+
+        Application         = 0x0100,   ///< First id available to applications
+    };
+
+    /**
+     * @brief A recorded event
+     */
+    struct Event {
+        uint32_t timestamp;             ///< Timebase::now32() when the event was recorded
+        uint16_t id;                    ///< Event id
+        uint8_t core;                   ///< Core that recorded the event
+        uint8_t reserved;
+        uint32_t arg0;                  ///< First argument, meaning defined by the event
+        uint32_t arg1;                  ///< Second argument, meaning defined by the event
+    };
+
+    static_assert(sizeof(Event) == 16, "Flight recorder events must be 16 bytes");
+    static_assert((T76_SAFETY_FLIGHT_RECORDER_SIZE & (T76_SAFETY_FLIGHT_RECORDER_SIZE - 1)) == 0,
+                  "T76_SAFETY_FLIGHT_RECORDER_SIZE must be a power of two");
+
+    /**
+     * @brief One ring of events
+     */
+    struct Ring {
+        std::atomic<uint32_t> head;                             ///< Number of events recorded into the ring
+        Event events[T76_SAFETY_FLIGHT_RECORDER_SIZE];          ///< The events; slot head % size is the next
+    };
+
+    /**
+     * @brief The ring being recorded into, or nullptr before init()
+     */
+    extern Ring *gActiveRing;
+
+    /**
+     * @brief Start recording
+     *
+     * Called by Safety::init(). When the previous boot ended in a fault, the
+     * ring it recorded into is kept for copyLastFault() and recording
+     * continues in the other ring; otherwise the active ring starts over.
+     *
+     * @param previousBootFaulted Whether the last reset was caused by a fault
+     */
+    void init(bool previousBootFaulted);
+
+    /**
+     * @brief Record an event
+     *
+     * Does nothing before init(). Safe to call from any core and from
+     * interrupt handlers; when two events are recorded at the same time, both
+     * are kept.
+     *
+     * @param id Event id; applications use EventId::Application and above
+     * @param arg0 First argument
+     * @param arg1 Second argument
+     */
+    inline __attribute__((always_inline)) void record(uint16_t id, uint32_t arg0 = 0, uint32_t arg1 = 0) {
+        Ring *ring = gActiveRing;
+
+        if (ring == nullptr) {
+            return;
+        }
+
+        Event &event = ring->events[ring->head.fetch_add(1, std::memory_order_relaxed) & (T76_SAFETY_FLIGHT_RECORDER_SIZE - 1)];
+
+        event.timestamp = T76::Core::Timebase::now32();
+        event.id = id;
+        event.core = static_cast<uint8_t>(get_core_num());
+        event.arg0 = arg0;
+        event.arg1 = arg1;
+    }
+
+    inline __attribute__((always_inline)) void record(EventId id, uint32_t arg0 = 0, uint32_t arg1 = 0) {
+        record(static_cast<uint16_t>(id), arg0, arg1);
+    }
+
+    /**
+     * @brief Whether a record of an earlier fault is available
+     */
+    bool hasLastFault();
+
+    /**
+     * @brief Copy the events that led up to the last fault, oldest first
+     *
+     * @param events Receives the events
+     * @param maxEvents Capacity of events
+     * @param first Index of the first event to copy, counting from the oldest
+     * @return Number of events copied; 0 if no fault has been recorded
+     */
+    std::size_t copyLastFault(Event *events, std::size_t maxEvents, std::size_t first = 0);
+
+    /**
+     * @brief Copy the events recorded since boot, oldest first
+     *
+     * Events recorded during the copy may be missing or partly written.
+     *
+     * @param events Receives the events
+     * @param maxEvents Capacity of events
+     * @param first Index of the first event to copy, counting from the oldest
+     * @return Number of events copied
+     */
+    std::size_t copyCurrent(Event *events, std::size_t maxEvents, std::size_t first = 0);
+
+} // namespace T76::Core::Safety::FlightRecorder
@@ -72,6 +72,33 @@
 
 namespace T76::Core::Safety {
 
+    /**
+     * @brief Order in which components are made safe
+     * 
+     * When the system faults, components are safed one priority class at a
+     * time, starting with Power, so that the outputs that can do harm are
+     * turned off first.
+     */
+    enum class SafingPriority : uint8_t {
+        Power = 0,      ///< Power stages and other outputs that must be off first
+        High,           ///< Actuators and peripherals that should be off soon after
+        Normal,         ///< Everything else
+    };
+
+    /**
+     * @brief Core that makes a component safe
+     * 
+     * A component whose peripherals are driven from one core is best safed by
+     * that core, which then runs its safing in parallel with the core that
+     * faulted. Components that can be safed from anywhere use Any and are
+     * safed by the faulting core.
+     */
+    enum class SafingCore : uint8_t {
+        Any = 0,        ///< Safed by whichever core faulted
+        Core0,          ///< Safed by core 0
+        Core1,          ///< Safed by core 1
+    };
+
     /**
      * @brief Abstract base class for components that can participate in safety operations
      * 
@@ -128,6 +155,32 @@ namespace T76::Core::Safety {
          * enter a known safe state.
          */
         virtual void makeSafe() = 0;
+
+        /**
+         * @brief Get the priority class in which the component is made safe
+         * 
+         * Override to return SafingPriority::Power for power stages and other
+         * outputs that must be turned off before anything else.
+         * 
+         * @return The component's safing priority (Normal by default)
+         */
+        virtual SafingPriority getSafingPriority() const {
+            return SafingPriority::Normal;
+        }
+
+        /**
+         * @brief Get the core that makes the component safe
+         * 
+         * Override when the component's peripherals are owned by one core, so
+         * that core safes them in parallel with the other. If that core does
+         * not respond within T76_SAFETY_SAFING_TIMEOUT_US, the faulting core
+         * safes the component itself.
+         * 
+         * @return The component's safing core (Any by default)
+         */
+        virtual SafingCore getSafingCore() const {
+            return SafingCore::Any;
+        }
     };
 
     /**
@@ -139,6 +192,18 @@ namespace T76::Core::Safety {
      */
     void init();
 
+    /**
+     * @brief Let Core 1 safe its own components when the system faults
+     * 
+     * Enables the safing doorbell interrupt on Core 1, so that a fault on
+     * Core 0 has Core 1 safe the components whose getSafingCore() is Core1 in
+     * parallel. init() does the same for Core 0. Until this is called, the
+     * faulting core safes every component itself.
+     * 
+     * @note Must be called on Core 1, after init() has run on Core 0
+     */
+    void core1Init();
+
     /**
      * @brief Initialize dual-core watchdog protection system
      * 
@@ -161,11 +226,16 @@ namespace T76::Core::Safety {
      * 
      * This function should be called periodically by Core 1 to indicate that
      * it's still operational. The heartbeat updates a shared memory timestamp
-     * that is monitored by the watchdog manager task running on Core 0.
+     * that is monitored by the watchdog manager task running on Core 0. With
+     * T76_SAFETY_CORE1_HEARTBEAT_COUNTER, it only increments a shared counter,
+     * and the manager task checks that the counter keeps changing; this suits
+     * callers in fast control interrupts.
      * 
      * @note Should be called only from Core 1 at least every 1 second
      * @note Safe to call from any context on Core 1 (interrupt or main thread)
      * @note No-op if called from Core 0 or if watchdog system not initialized
+     * @note With T76_IC_SMP, a task created by watchdogInit() sends the
+     *       heartbeat, and the application must not call this
      */
     void feedWatchdogFromCore1();
 
@@ -223,6 +293,12 @@ namespace T76::Core::Safety {
      * This is typically called during system shutdown or fault recovery to ensure
      * all components enter a safe state.
      * 
+     * Components are safed in order of their SafingPriority. Those that belong
+     * to the other core are safed by it, through a doorbell interrupt, while
+     * this core safes its own and those that can be safed anywhere; the call
+     * returns once both cores are done, or after T76_SAFETY_SAFING_TIMEOUT_US,
+     * in which case this core safes whatever is left.
+     * 
      * @note Thread-safe for multi-core operation
      * @note Components are safed outside of critical sections to avoid deadlocks
      * @note Continues safing other components even if some fail
@@ -29,6 +29,12 @@
 
 #define CFG_TUSB_RHPORT0_MODE   (OPT_MODE_DEVICE)
 
+// Use the FreeRTOS OSAL so that tud_task() blocks on the TinyUSB event queue
+// instead of having to be polled. The Pico SDK defaults to OPT_OS_PICO on the
+// command line, so override it here.
+#undef CFG_TUSB_OS
+#define CFG_TUSB_OS             (OPT_OS_FREERTOS)
+
 #define CFG_TUD_CDC             (1)
 
 // CDC FIFO size of TX and RX
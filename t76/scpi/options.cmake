@@ -0,0 +1,5 @@
+# Configurable options for the SCPI library
+
+set(T76_SCPI_ERROR_QUEUE_SIZE 16 CACHE STRING "Number of errors the SCPI error queue holds, including the overflow error")
+option(T76_SCPI_DISPATCH "Call SCPI handlers from a generated switch with constant parameter counts instead of through the command table" OFF)
+option(T76_SCPI_PROFILE "Count the calls and the parse and handler cycles of every SCPI command, for diagnostic builds" OFF)
@@ -14,9 +14,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <vector>
+#include <span>
+#include <string_view>
 
 #include "scpi_parameter.hpp"
 
@@ -26,14 +28,86 @@ namespace T76::SCPI {
     template <typename TargetT> class Interpreter; // Forward declaration of Interpreter template class
     class ConcreteInterpreter; // Forward declaration of ConcreteInterpreter class
 
+    /**
+     * @brief A piece of an arbitrary data block delivered to a chunk handler
+     * 
+     * Chunks arrive in order and without gaps; the last chunk is the one for
+     * which `offset + length == totalSize`. The data is only valid for the
+     * duration of the call.
+     */
+    struct ABDChunk {
+        const uint8_t *data;    // The bytes of this chunk
+        size_t length;          // The number of bytes in this chunk
+        size_t offset;          // The offset of this chunk in the block
+        size_t totalSize;       // The size of the whole block, as declared by its header
+    };
+
+    /**
+     * @brief The parsed parameters of a command, as passed to its handlers
+     * 
+     * The span refers to the interpreter's parameter storage, which is
+     * reused by the next command, so it is only valid for the duration of
+     * the call.
+     */
+    using Parameters = std::span<const ParameterValue>;
+
+    template <typename TargetT>
+    using CommandHandler = void (TargetT::*)(Parameters);
+
+    /**
+     * @brief Handler for the chunks of a streamed arbitrary data block
+     * 
+     * The parameters that precede the block have already been parsed and
+     * are passed with every chunk. Chunks are delivered before the command
+     * is complete, so the handler must be prepared for the command to be
+     * rejected afterwards, in which case the regular handler is not called.
+     */
     template <typename TargetT>
-    using CommandHandler = void (TargetT::*)(const std::vector<ParameterValue> &);
+    using ABDChunkHandler = void (TargetT::*)(Parameters, const ABDChunk &);
+
+    /**
+     * @brief Function that calls a typed handler with unpacked parameters
+     * 
+     * `trie_generator.py` generates one for every command with a typed
+     * handler, which takes one argument of the matching C++ type per
+     * parameter (for example, `void _setLevel(double, LevelMode, bool)`)
+     * instead of the generic parameter span.
+     */
+    template <typename TargetT>
+    using CommandTrampoline = void (*)(TargetT &, Parameters);
+
+    /**
+     * @brief Function that returns the response of a constant query
+     * 
+     * `trie_generator.py` generates one for every command declared with
+     * `constant` in the YAML file. The response, without its terminator,
+     * must stay valid for as long as the interpreter exists: it is either a
+     * string literal, which stays in flash, or the result of a handler that
+     * is only called the first time the query is received.
+     */
+    template <typename TargetT>
+    using ConstantResponse = std::string_view (*)(TargetT &);
+
+    /**
+     * @brief Function that sends a response to the host
+     * 
+     * Set with `Interpreter::setResponseWriter()`. The response does not
+     * include its terminator, which the writer adds.
+     * 
+     * @param context The context passed to `setResponseWriter()`.
+     * @param response The response to send.
+     * @return true if the response was sent, false otherwise.
+     */
+    using ResponseWriter = bool (*)(void *context, std::string_view response);
 
     template <typename TargetT>
     struct Command {
-        CommandHandler<TargetT> handler;  // The function to call when the command is executed.
+        CommandHandler<TargetT> handler;  // The function to call when the command is executed, or nullptr if it has a trampoline.
         uint8_t parameterCount; // The number of parameters for the command.
         const ParameterDescriptor *parameterDescriptors; // Pointer to parameter descriptors
+        ABDChunkHandler<TargetT> chunkHandler; // Receives the final block parameter as it arrives, or nullptr to buffer it
+        CommandTrampoline<TargetT> trampoline; // Calls the command's typed handler, or nullptr if the handler is untyped
+        ConstantResponse<TargetT> constant; // Returns the response of a constant query, or nullptr if the command has a handler
     };
 
 } // namespace T76::SCPI
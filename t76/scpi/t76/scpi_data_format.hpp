@@ -0,0 +1,341 @@
+/**
+ * @file scpi_data_format.hpp
+ * @brief Response data format and binary block encoder for the SCPI interpreter.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * DataFormat holds the settings of the standard `FORMat:DATA` and
+ * `FORMat:BORDer` commands, which select how numeric arrays are returned:
+ * as ASCII text, or as a definite-length arbitrary block (`#<n><length>`)
+ * of packed 32-bit floats or 16- or 32-bit integers, in either byte order.
+ *
+ * BlockEncoder writes such a block, including its preamble and the response
+ * terminator, directly into a transmit buffer. Its fill() function has the
+ * signature of `T76::Core::Utils::MessageFillFunction`, so that a whole
+ * response can be written with a single call like:
+ *
+ * ```cpp
+ * T76::SCPI::BlockEncoder<float> block(samples, count, _interpreter.dataFormat);
+ * _usbInterface.fillUSBTMCBulkData(block.size(), T76::SCPI::BlockEncoder<float>::fill, &block);
+ * ```
+ *
+ * Samples are converted, and byte-swapped if needed, as they are copied, so
+ * the response costs one pass over the data instead of a text conversion of
+ * every sample.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <strings.h>
+#include <type_traits>
+
+
+namespace T76::SCPI {
+
+    /**
+     * @brief The type of the samples in a numeric response, as set by `FORMat:DATA`
+     */
+    enum class DataType : uint8_t {
+        ASCii,          // Comma-separated text
+        Real32,         // IEEE 754 single-precision floats
+        Int16,          // Signed 16-bit integers
+        Int32,          // Signed 32-bit integers
+    };
+
+    /**
+     * @brief The byte order of binary samples, as set by `FORMat:BORDer`
+     */
+    enum class ByteOrder : uint8_t {
+        Normal,         // Most significant byte first, as required by IEEE 488.2
+        Swapped,        // Least significant byte first, the native order of the RP2350
+    };
+
+    /**
+     * @brief The format of numeric responses
+     *
+     * The defaults, ASCII in normal byte order, are those that `*RST` restores.
+     */
+    struct DataFormat {
+        DataType type = DataType::ASCii;
+        ByteOrder byteOrder = ByteOrder::Normal;
+
+        /**
+         * @brief Set the data type from the parameters of `FORMat:DATA`.
+         *
+         * @param name The type, `ASCii`, `REAL` or `INTeger`, in short or long form.
+         * @param length The size of each sample in bits, or 0 for the type's default:
+         *               32 for `REAL` and 16 for `INTeger`. `ASCii` ignores it.
+         * @return true if the format was changed, false if the combination is not supported.
+         */
+        bool setType(std::string_view name, double length = 0) {
+            if (_matches(name, "ASC", "ASCII")) {
+                type = DataType::ASCii;
+            } else if (_matches(name, "REAL", "REAL") && (length == 0 || length == 32)) {
+                type = DataType::Real32;
+            } else if (_matches(name, "INT", "INTEGER") && (length == 0 || length == 16)) {
+                type = DataType::Int16;
+            } else if (_matches(name, "INT", "INTEGER") && length == 32) {
+                type = DataType::Int32;
+            } else {
+                return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Set the byte order from the parameter of `FORMat:BORDer`.
+         *
+         * @param name `NORMal` or `SWAPped`, in short or long form.
+         * @return true if the byte order was changed, false if the name is not valid.
+         */
+        bool setByteOrder(std::string_view name) {
+            if (_matches(name, "NORM", "NORMAL")) {
+                byteOrder = ByteOrder::Normal;
+            } else if (_matches(name, "SWAP", "SWAPPED")) {
+                byteOrder = ByteOrder::Swapped;
+            } else {
+                return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Get the `FORMat:DATA?` reply for the current type, such as `REAL,32`.
+         */
+        const char *typeName() const {
+            switch (type) {
+                case DataType::Real32:
+                    return "REAL,32";
+                case DataType::Int16:
+                    return "INT,16";
+                case DataType::Int32:
+                    return "INT,32";
+                default:
+                    return "ASC,0";
+            }
+        }
+
+        /**
+         * @brief Get the `FORMat:BORDer?` reply for the current byte order.
+         */
+        const char *byteOrderName() const {
+            return byteOrder == ByteOrder::Swapped ? "SWAP" : "NORM";
+        }
+
+        /**
+         * @brief Get the size of a binary sample in bytes, or 0 for ASCII.
+         */
+        size_t sampleSize() const {
+            switch (type) {
+                case DataType::Real32:
+                case DataType::Int32:
+                    return 4;
+                case DataType::Int16:
+                    return 2;
+                default:
+                    return 0;
+            }
+        }
+
+    protected:
+        static bool _matches(std::string_view name, const char *shortForm, const char *longForm) {
+            auto equals = [name](const char *keyword) {
+                return strlen(keyword) == name.size() && strncasecmp(name.data(), keyword, name.size()) == 0;
+            };
+
+            return equals(shortForm) || equals(longForm);
+        }
+    };
+
+    /**
+     * @brief Writes an array of samples as a binary block response
+     * @tparam SampleT The type of the samples: float, int16_t or int32_t.
+     *
+     * The response consists of the `#<n><length>` preamble, the samples
+     * converted to the binary type of the data format, and a newline that
+     * ends the response. Integers are rounded and saturated when a float is
+     * converted to them.
+     *
+     * The encoder only keeps a pointer to the samples, which must stay valid
+     * until the response has been written. An ASCII data format has no binary
+     * encoding; in that case, the encoder writes 32-bit floats, so handlers
+     * are expected to check `DataFormat::type` and send text themselves.
+     */
+    template<typename SampleT>
+    class BlockEncoder {
+        static_assert(std::is_same_v<SampleT, float> || std::is_same_v<SampleT, int16_t> || std::is_same_v<SampleT, int32_t>,
+                      "BlockEncoder samples must be float, int16_t or int32_t");
+
+    public:
+        /**
+         * @brief Create an encoder for a block of samples.
+         *
+         * @param samples The samples to send.
+         * @param count The number of samples.
+         * @param format The data format; ASCII is sent as 32-bit floats.
+         */
+        BlockEncoder(const SampleT *samples, size_t count, const DataFormat &format) :
+            _samples(samples),
+            _count(count),
+            _type(format.type == DataType::ASCii ? DataType::Real32 : format.type),
+            _swap(format.byteOrder == ByteOrder::Normal) {
+            DataFormat binary = format;
+            binary.type = _type;
+            _sampleSize = binary.sampleSize();
+
+            // Preamble: `#`, the number of length digits, then the length
+            char digits[24];
+            const int length = snprintf(digits, sizeof(digits), "%zu", _count * _sampleSize);
+            _preambleLength = static_cast<size_t>(snprintf(_preamble, sizeof(_preamble), "#%d%s", length, digits));
+        }
+
+        /**
+         * @brief Get the size of the whole response, including the preamble and terminator.
+         */
+        size_t size() const {
+            return _preambleLength + _count * _sampleSize + 1;
+        }
+
+        /**
+         * @brief Write part of the response.
+         *
+         * @param destination Where to write the bytes.
+         * @param offset The offset in the response of the first byte to write.
+         * @param length The number of bytes to write.
+         */
+        void write(uint8_t *destination, size_t offset, size_t length) const {
+            const size_t dataSize = _count * _sampleSize;
+
+            // Preamble
+            if (offset < _preambleLength) {
+                const size_t count = std::min(length, _preambleLength - offset);
+
+                memcpy(destination, _preamble + offset, count);
+                destination += count;
+                offset += count;
+                length -= count;
+            }
+
+            // Samples
+            if (length > 0 && offset < _preambleLength + dataSize) {
+                const size_t count = std::min(length, _preambleLength + dataSize - offset);
+
+                _writeSamples(destination, offset - _preambleLength, count);
+                destination += count;
+                offset += count;
+                length -= count;
+            }
+
+            // Terminator
+            if (length > 0) {
+                *destination = '\n';
+            }
+        }
+
+        /**
+         * @brief Fill callback with the signature of `T76::Core::Utils::MessageFillFunction`.
+         *
+         * @param context Pointer to the BlockEncoder.
+         */
+        static void fill(void *context, uint8_t *destination, size_t offset, size_t length) {
+            static_cast<const BlockEncoder*>(context)->write(destination, offset, length);
+        }
+
+    protected:
+        const SampleT *_samples;        // The samples to send
+        size_t _count;                  // The number of samples
+        DataType _type;                 // The binary type of the samples in the block
+        bool _swap;                     // Whether samples are byte-swapped from the native little-endian order
+        size_t _sampleSize;             // The size of each encoded sample in bytes
+        char _preamble[24];             // The `#<n><length>` preamble
+        size_t _preambleLength;         // The length of the preamble
+
+        /**
+         * @brief Convert a sample to the block's type, in native byte order.
+         */
+        uint32_t _encode(SampleT sample) const {
+            switch (_type) {
+                case DataType::Int16:
+                    return static_cast<uint16_t>(_toInteger<int16_t>(sample));
+                case DataType::Int32:
+                    return static_cast<uint32_t>(_toInteger<int32_t>(sample));
+                default: {
+                    const float value = static_cast<float>(sample);
+                    uint32_t bits;
+                    memcpy(&bits, &value, sizeof(bits));
+                    return bits;
+                }
+            }
+        }
+
+        template<typename IntegerT>
+        static IntegerT _toInteger(SampleT sample) {
+            if constexpr (std::is_floating_point_v<SampleT>) {
+                if (!(sample == sample)) {
+                    return 0; // NaN
+                }
+
+                const float rounded = std::nearbyint(sample);
+
+                if (rounded <= static_cast<float>(std::numeric_limits<IntegerT>::min())) {
+                    return std::numeric_limits<IntegerT>::min();
+                }
+
+                if (rounded >= static_cast<float>(std::numeric_limits<IntegerT>::max())) {
+                    return std::numeric_limits<IntegerT>::max();
+                }
+
+                return static_cast<IntegerT>(rounded);
+            } else {
+                return static_cast<IntegerT>(std::clamp<int64_t>(sample, std::numeric_limits<IntegerT>::min(), std::numeric_limits<IntegerT>::max()));
+            }
+        }
+
+        /**
+         * @brief Write `length` bytes of the encoded samples, starting at byte `offset`.
+         */
+        void _writeSamples(uint8_t *destination, size_t offset, size_t length) const {
+            // Samples whose encoding is their native representation are copied in one step
+            const bool native = !_swap && sizeof(SampleT) == _sampleSize &&
+                                (std::is_floating_point_v<SampleT> == (_type == DataType::Real32));
+
+            if (native) {
+                memcpy(destination, reinterpret_cast<const uint8_t*>(_samples) + offset, length);
+                return;
+            }
+
+            size_t index = offset / _sampleSize;
+            size_t skip = offset % _sampleSize;
+
+            while (length > 0) {
+                uint32_t value = _encode(_samples[index++]);
+
+                if (_swap) {
+                    value = _sampleSize == 2 ? __builtin_bswap16(static_cast<uint16_t>(value)) : __builtin_bswap32(value);
+                }
+
+                // A transmit buffer that wraps can split a sample in two
+                uint8_t bytes[4];
+                memcpy(bytes, &value, sizeof(bytes));
+
+                const size_t count = std::min(length, _sampleSize - skip);
+                memcpy(destination, bytes + skip, count);
+
+                destination += count;
+                length -= count;
+                skip = 0;
+            }
+        }
+    };
+
+} // namespace T76::SCPI
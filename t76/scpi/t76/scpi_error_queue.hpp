@@ -0,0 +1,169 @@
+/**
+ * @file scpi_error_queue.hpp
+ * @brief Fixed-size error queue for the SCPI interpreter.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The error queue is a ring of `(code, message)` entries whose messages point
+ * to strings with static storage duration, so that reporting an error never
+ * allocates and the queue has a fixed size. Errors are only formatted as SCPI
+ * error replies (`code,"message"`) when they are read.
+ *
+ * When the queue fills up, the most recent error is replaced with
+ * `-350,"Queue overflow"` and further errors are discarded until room is
+ * made by reading the queue, as required by SCPI. Reading an empty queue
+ * returns `0,"No error"`.
+ *
+ * The size of the queue is set by the `T76_SCPI_ERROR_QUEUE_SIZE` CMake
+ * option.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#ifndef T76_SCPI_ERROR_QUEUE_SIZE
+#define T76_SCPI_ERROR_QUEUE_SIZE 16
+#endif
+
+
+namespace T76::SCPI {
+
+    /**
+     * @brief An error waiting in the error queue
+     */
+    struct Error {
+        int16_t code;           // The SCPI error number
+        const char *message;    // The error description, which must have static storage duration
+    };
+
+    /**
+     * @class ErrorQueue
+     * @brief Bounded queue of SCPI errors with SCPI overflow handling
+     */
+    class ErrorQueue {
+    public:
+        static constexpr size_t Capacity = T76_SCPI_ERROR_QUEUE_SIZE; // Number of errors the queue holds, including the overflow error
+
+        static constexpr int16_t NoErrorCode = 0;
+        static constexpr int16_t OverflowCode = -350;
+
+        static_assert(Capacity >= 2, "The SCPI error queue must hold at least one error and the overflow error");
+
+        /**
+         * @brief Add an error to the queue.
+         *
+         * @param code The SCPI error number.
+         * @param message The error description; only the pointer is stored, so it
+         *                must have static storage duration, like a string literal.
+         * @return true if the error was queued, or false if the queue was full and
+         *         the error was replaced by, or discarded after, the overflow error.
+         */
+        bool push(int16_t code, const char *message) {
+            if (_count == Capacity) {
+                return false; // Already overflowed; only the oldest errors are kept
+            }
+
+            if (_count == Capacity - 1) {
+                _entries[(_head + _count++) % Capacity] = {OverflowCode, "Queue overflow"};
+                return false;
+            }
+
+            _entries[(_head + _count++) % Capacity] = {code, message};
+            return true;
+        }
+
+        /**
+         * @brief Remove the oldest error from the queue.
+         *
+         * @param error Where to store the error; set to `0,"No error"` if the queue is empty.
+         * @return true if an error was removed, false if the queue was empty.
+         */
+        bool pop(Error &error) {
+            if (_count == 0) {
+                error = {NoErrorCode, "No error"};
+                return false;
+            }
+
+            error = _entries[_head];
+            _head = (_head + 1) % Capacity;
+            _count--;
+
+            return true;
+        }
+
+        /**
+         * @brief Check whether the queue is empty.
+         */
+        bool empty() const {
+            return _count == 0;
+        }
+
+        /**
+         * @brief Get the number of errors in the queue, including the overflow error.
+         */
+        size_t size() const {
+            return _count;
+        }
+
+        /**
+         * @brief Discard all errors.
+         */
+        void clear() {
+            _head = 0;
+            _count = 0;
+        }
+
+        /**
+         * @brief Format an error as a SCPI error reply.
+         *
+         * The message is quoted, and quotation marks within it are escaped in the
+         * same way as by `Interpreter::formatString()`. The reply is truncated if
+         * it does not fit in the buffer.
+         *
+         * @param error The error to format.
+         * @param buffer Where to store the reply, which is always null-terminated.
+         * @param size The size of the buffer in bytes; must be at least 1.
+         * @return The length of the reply, not including the null terminator.
+         */
+        static size_t format(const Error &error, char *buffer, size_t size) {
+            int written = snprintf(buffer, size, "%d,\"", error.code);
+            size_t length = written > 0 ? static_cast<size_t>(written) : 0;
+
+            if (length >= size) {
+                return size - 1;
+            }
+
+            for (const char *c = error.message; *c; ++c) {
+                const size_t needed = *c == '"' ? 2 : 1;
+
+                if (length + needed >= size) {
+                    buffer[length] = '\0';
+                    return length;
+                }
+
+                if (*c == '"') {
+                    buffer[length++] = '\\';
+                }
+
+                buffer[length++] = *c;
+            }
+
+            if (length + 1 < size) {
+                buffer[length++] = '"';
+            }
+
+            buffer[length] = '\0';
+            return length;
+        }
+
+    protected:
+        Error _entries[Capacity];   // Ring of queued errors
+        size_t _head = 0;           // Index of the oldest error
+        size_t _count = 0;          // Number of queued errors
+
+    }; // class ErrorQueue
+
+} // namespace T76::SCPI
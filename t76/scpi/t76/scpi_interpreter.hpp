@@ -18,14 +18,15 @@
  * template that uses your command handler class.
  * 
  * The interpreter works by breaking down each SCPI command into a trie structure 
- * that is traversed as data is fed into it one character at a time by a call to 
- * processInputCharacter(). The interpreter will parse the command 
+ * that is traversed as data is fed into it, either one character at a time by a
+ * call to processInputCharacter() or a buffer at a time by a call to
+ * processInput(). The interpreter will parse the command 
  * and its parameters, and then call the appropriate command handler with 
  * the parsed parameters. 
  * 
- * Command handlers are expected to take a vector of ParameterValue objects
- * representing the parsed parameters. Note that the interpreter already verifies
- * that the correct number and types of parameters are provided before calling
+ * Command handlers are expected to take a span of ParameterValue objects
+ * (`T76::SCPI::Parameters`) representing the parsed parameters. Note that
+ * the interpreter already verifies that the correct number and types of parameters are provided before calling
  * the handler, so you can assume that the parameters are valid, but you must still
  * handle any semantic errors that may arise during command execution. For example,
  * if a command expects a parameter to be within a certain range, you must check
@@ -34,7 +35,102 @@
  * 
  * Errors can be reported by calling the `addError` method. You will need to 
  * add a `SYSTem:ERROR?` command to your command set to retrieve errors and
- * output them to the output stream according to SCPI specifications.
+ * output them to the output stream according to SCPI specifications, for
+ * example with `nextError()`. Errors are kept in a fixed-size queue, and
+ * only formatted when they are read.
+ * 
+ * Arbitrary data block parameters are passed to handlers as a view
+ * (`dataValue`, `dataLength`) over the interpreter's receive buffer, which
+ * stays valid until the handler returns. A command can instead declare a
+ * `chunk_handler` in the YAML file, in which case its final arbitrary data
+ * block is not buffered: the chunk handler is called with each piece of the
+ * block as it arrives, and the regular handler is called once the command
+ * is complete.
+ * 
+ * Parameters are parsed as soon as they are received, into storage that is
+ * allocated once, when the interpreter is created, and sized from the limits
+ * that `trie_generator.py` writes next to the command table. Processing
+ * commands therefore does not allocate memory, and the parameters passed to
+ * a handler, including string views, are only valid until it returns.
+ * 
+ * Commands can also be declared `typed` in the YAML file, in which case the
+ * generator emits a trampoline that calls the handler with one argument of
+ * the matching C++ type per parameter, with enums passed as generated enum
+ * classes whose values are resolved while parsing.
+ * 
+ * A line can hold several commands separated by semicolons, as in IEEE 488.2
+ * compound program messages: `SOUR:VOLT 1;CURR 0.1;:OUTP ON` sets
+ * `SOUR:VOLT` and `SOUR:CURR` and then `OUTP`. Each header is resolved
+ * relative to the last colon of the header before it, unless it starts with
+ * a colon; common commands (`*IDN?`) are always resolved from the root and
+ * leave the path unchanged. Parameters are separated by commas or whitespace,
+ * which, like semicolons, are taken literally between quotation marks.
+ * A command that cannot be parsed discards the rest of the line.
+ * 
+ * Parameters that have a default value in the YAML file can be omitted from
+ * the end of a command, in which case the handler receives the default.
+ * 
+ * The `dataFormat` member holds the settings of the standard `FORMat:DATA`
+ * and `FORMat:BORDer` commands, which an application can declare and
+ * implement with `DataFormat::setType()` and `DataFormat::setByteOrder()`.
+ * Numeric arrays can then be returned as binary blocks written straight into
+ * the transmit buffer by a `BlockEncoder` (see scpi_data_format.hpp).
+ * 
+ * A handler can make its command overlapped by calling `operations.begin()`
+ * before it returns and `operations.complete()` once the operation is done,
+ * so that the following commands are parsed and executed in the meantime.
+ * The `operations` tracker and the standard event status register implement
+ * `*OPC`, `*OPC?` and `*WAI` (see scpi_operations.hpp).
+ * 
+ * The `status` member holds the IEEE 488.2 and SCPI status registers: the
+ * standard event status register and its `*ESE` mask, the `*SRE` mask, and
+ * the `STATus:OPERation` and `STATus:QUEStionable` registers, whose condition
+ * bits can be set from any task, interrupt or core (see scpi_status.hpp).
+ * Errors added with `addError()` set the matching standard event, and
+ * `statusByte()` summarizes the registers as returned by `*STB?`.
+ * 
+ * Commands can also be executed without parsing any text, with
+ * `executeBinary()`. `trie_generator.py` assigns every command an opcode, its
+ * position in the YAML file, and the request carries that opcode and the
+ * command's parameters packed in little-endian order: numbers as 64-bit
+ * IEEE 754 doubles, booleans as one byte, enums as the one-byte index of the
+ * choice in the YAML file, strings as a 16-bit length followed by the bytes,
+ * and arbitrary data blocks as a 32-bit length followed by the data.
+ * Trailing parameters with a default can be omitted. The command then runs
+ * the same handler as its text form.
+ * 
+ * Each interpreter is a session with its own parse state, error queue, data
+ * format and status registers, while the command trie and table are static
+ * and shared by every interpreter of the same target. A target can own one
+ * interpreter per transport, such as USBTMC and CDC, and handlers find the
+ * session that called them with `current()`. Sessions that are fed from
+ * different tasks can share a `TargetLock` (see scpi_target_lock.hpp), which
+ * is held while any of their handlers runs.
+ * 
+ * Queries whose response never changes, such as `*IDN?`, can be declared
+ * with `constant` in the YAML file instead of a handler. Their response is
+ * either a string that the generator stores in flash, or the result of a
+ * handler that is only called the first time, and the interpreter sends it
+ * with the writer set by `setResponseWriter()`, so that answering them
+ * neither builds a string nor allocates.
+ * 
+ * The generated command table, trie and parameter descriptors are constant
+ * initialized, so they stay in flash. With `trie_generator.py --dispatch`
+ * (the `T76_SCPI_DISPATCH` CMake option), the generator also emits a switch
+ * that calls every handler directly and checks its parameter count against
+ * a constant, instead of calling through the member function pointers and
+ * trampolines of the table, which then only describes the parameters.
+ * 
+ * With `trie_generator.py --profile` (the `T76_SCPI_PROFILE` CMake option),
+ * every session also keeps the `profile` of its commands: how often each
+ * one ran and the cycles spent parsing it and in its handler, with the
+ * commands that take the longest reported by `profile.report()`, for
+ * example in response to `SYSTem:PROFile?` (see scpi_profile.hpp). Without
+ * the option, the interpreter does not measure anything.
+ * 
+ * Handlers that need temporary buffers for the duration of a single command
+ * can allocate them from `commandArena()`. Everything allocated from the arena
+ * is released in one step once the handler returns.
  * 
  * Note that the interpreter automatically determines whether the caller has issued
  * the correct number of parameters of the appropriate type for each command, and will
@@ -46,16 +142,41 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
-#include <queue>
 #include <vector>
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <strings.h>
 
+#include <t76/memory_arena.hpp>
+#include <t76/trace.hpp>
+
+#ifdef T76_IC_DMA_OFFLOAD
+#include <t76/dma.hpp>
+#endif
+
 #include "scpi_trie.hpp"
 #include "scpi_command.hpp"
+#include "scpi_data_format.hpp"
+#include "scpi_error_queue.hpp"
+#include "scpi_operations.hpp"
+#include "scpi_status.hpp"
+#include "scpi_target_lock.hpp"
+
+#ifndef T76_SCPI_GENERATED_DISPATCH
+#define T76_SCPI_GENERATED_DISPATCH 0
+#endif
+
+#ifndef T76_SCPI_PROFILE
+#define T76_SCPI_PROFILE 0
+#endif
+
+#if T76_SCPI_PROFILE
+#include "scpi_profile.hpp"
+#endif
 
 
 namespace T76::SCPI {
@@ -86,8 +207,21 @@ namespace T76::SCPI {
         static constexpr int SCPIErrorUndefinedHeader = -113;
         static constexpr int SCPIErrorInvalidBlockData = -161;
         static constexpr int SCPIErrorTooMuchData = -223;
+        static constexpr int SCPIErrorDeviceSpecific = -300;
+
+        static constexpr size_t DefaultCommandArenaSize = 512; // Default size of the per-command arena in bytes
+
+        ErrorQueue errorQueue; // Queue to store errors until they are read.
+
+        DataFormat dataFormat; // Format of numeric responses, as set by FORMat:DATA and FORMat:BORDer.
+
+        Status status; // Status registers summarized in the status byte.
+
+        OperationTracker operations{status.standardEvent}; // Overlapped operations that *OPC, *OPC? and *WAI wait for.
 
-        std::queue<std::string> errorQueue; // Queue to store error messages.
+#if T76_SCPI_PROFILE
+        CommandProfile profile{_commandNames, _commandCount}; // Calls and cycles of every command of this session.
+#endif
 
         /**
          * @brief Constructor for the SCPI interpreter.
@@ -95,9 +229,14 @@ namespace T76::SCPI {
          * Initializes the interpreter with the specified target for command execution.
          * 
          * @param target Reference to the target interpreter implementation.
-         * @param abdMaxSize Maximum allowed size for ABD (Arbitrary Data Block) parameters in bytes. Default is 256 bytes.
+         * @param abdMaxSize Maximum combined size of the ABD (Arbitrary Data Block) parameters of a single
+         *                   command in bytes. Default is 256 bytes. The block buffer is allocated once, at
+         *                   this size. Blocks delivered to a chunk handler can be of any size; for those,
+         *                   the space left in the buffer is used to stage the chunks that
+         *                   processInputCharacter() accumulates before calling the handler.
+         * @param commandArenaSize Size of the per-command arena in bytes. Default is DefaultCommandArenaSize.
          */
-        Interpreter(TargetT &target, size_t abdMaxSize = 256);
+        Interpreter(TargetT &target, size_t abdMaxSize = 256, size_t commandArenaSize = DefaultCommandArenaSize);
 
         /**
          * @brief Get the maximum number of parameters allowed for commands.
@@ -116,16 +255,122 @@ namespace T76::SCPI {
          */
         void processInputCharacter(uint8_t character);
 
+        /**
+         * @brief Process a buffer of input characters.
+         * 
+         * This method has the same effect as calling processInputCharacter()
+         * for every byte in the buffer, but handles runs of bytes at once:
+         * command segments are compared with memcmp(), parameters are
+         * case-folded a word at a time and copied in one step, arbitrary data
+         * block payloads are appended to the block buffer in one step, and
+         * input that follows an error is skipped with memchr().
+         * 
+         * @param data The input characters to process.
+         * @param length The number of characters in the buffer.
+         */
+        void processInput(const uint8_t *data, size_t length);
+
         /**
          * @brief Fully resets the interpreter.
          * 
          * This clears the current command, parameters, and resets the
          * interpreter state to prepare for a new command input. The
-         * error queue is also cleared.
+         * error queue is also cleared, the data format is set back
+         * to ASCII in normal byte order, and a pending `*OPC` is cancelled.
+         * Operations that are still running remain pending.
          * 
          */
         void reset();
 
+        /**
+         * @brief Clears the status data structures, as `*CLS` does.
+         * 
+         * This empties the error queue, clears the standard event status
+         * register and the `STATus:OPERation` and `STATus:QUEStionable`
+         * event registers, and cancels a pending `*OPC`. Enable masks and
+         * condition registers are kept.
+         * 
+         */
+        void clearStatus();
+
+        /**
+         * @brief Computes the status byte, as returned by `*STB?`.
+         * 
+         * @param messageAvailable Whether a response is waiting to be read, which sets MAV.
+         * @return The status byte, with MSS set if any bit enabled by `*SRE` is set.
+         */
+        uint8_t statusByte(bool messageAvailable = false) const;
+
+        /**
+         * @brief Discards the program message being received.
+         * 
+         * This drops the partly received command, its parameters and the
+         * header path of a compound message, as required by a device clear,
+         * without clearing the error queue or the data format.
+         * 
+         */
+        void discardInput();
+
+        /**
+         * @brief Executes a command from its opcode and packed parameters.
+         * 
+         * The command is executed as if it had been received as text, except
+         * that errors are returned instead of being added to the error queue,
+         * so that a binary request can report its own failure. The partly
+         * received text command, if any, is not affected.
+         * 
+         * @param opcode The opcode of the command, as assigned by `trie_generator.py`.
+         * @param payload The packed parameters, which must stay valid until the call returns.
+         * @param length The size of the packed parameters in bytes.
+         * @param error Where to store the first error reported while decoding or
+         *              executing the command; set to `0,"No error"` on success.
+         * @return true if the command was executed without error, false otherwise.
+         */
+        bool executeBinary(uint16_t opcode, const uint8_t *payload, size_t length, Error &error);
+
+        /**
+         * @brief Sets the lock held while the handlers of this session run.
+         * 
+         * Give the same lock to every session of a target whose handlers must
+         * not run concurrently, because the sessions are fed from different
+         * tasks. The lock must outlive the interpreter.
+         * 
+         * @param lock The lock, or nullptr to call the handlers without locking.
+         */
+        void setTargetLock(TargetLock *lock);
+
+        /**
+         * @brief Sets the function that sends the responses of constant queries.
+         * 
+         * Handlers can use the same writer through `sendResponse()`, so that
+         * their responses go to the session that received the command.
+         * 
+         * @param writer The function that sends a response, such as
+         *               `T76::Core::USB::Interface::usbtmcResponseWriter()`.
+         * @param context Passed to the writer.
+         */
+        void setResponseWriter(ResponseWriter writer, void *context);
+
+        /**
+         * @brief Sends a response with the writer set by `setResponseWriter()`.
+         * 
+         * @param response The response, without its terminator.
+         * @return true if the response was sent; false if it could not be, or if no writer is set.
+         */
+        bool sendResponse(std::string_view response);
+
+        /**
+         * @brief Gets the session whose handler is running.
+         * 
+         * Handlers that are shared by several sessions use this to add errors
+         * to, and send responses over, the session that received the command.
+         * The result is only meaningful within a handler, and only when the
+         * sessions of the target share a lock or are fed from the same task.
+         * 
+         * @return The interpreter that called the running handler, or nullptr outside of a handler.
+         */
+        static Interpreter *current();
+
         /**
          * @brief Formats a string for output.
          * 
@@ -148,13 +393,35 @@ namespace T76::SCPI {
         /**
          * @brief Add an error to the error queue.
          * 
-         * This method formats the error as a SCPI error reply (`number,"string"`) and
-         * adds it to the `errorQueue`.
+         * This method adds the error to the `errorQueue`, without formatting it or
+         * allocating memory, and sets the standard event that matches its class.
+         * If the queue is full, the most recent error is replaced with
+         * `-350,"Queue overflow"`.
          * 
          * @param errorNumber The error number.
-         * @param errorString The error string.
+         * @param errorString The error string. Only the pointer is stored, so it must
+         *                    have static storage duration, like a string literal.
+         */
+        void addError(int errorNumber, const char *errorString);
+
+        /**
+         * @brief Remove the oldest error from the error queue and format it.
+         * 
+         * This method formats the error as a SCPI error reply (`number,"string"`),
+         * as expected in response to `SYSTem:ERRor?`.
+         * 
+         * @param buffer Where to store the reply, which is always null-terminated.
+         * @param size The size of the buffer in bytes.
+         * @return The length of the reply; `0,"No error"` if the queue is empty.
          */
-        void addError(int errorNumber, const std::string &errorString);
+        size_t nextError(char *buffer, size_t size);
+
+        /**
+         * @brief Remove the oldest error from the error queue and format it.
+         * 
+         * @return The SCPI error reply; `0,"No error"` if the queue is empty.
+         */
+        std::string nextError();
 
         /**
          * @brief Collects all errors from the error queue.
@@ -166,45 +433,202 @@ namespace T76::SCPI {
          */
         std::vector<std::string> errors();
 
+        /**
+         * @brief Get the per-command arena.
+         * 
+         * Command handlers can use this arena, directly or through
+         * `T76::Core::Memory::ArenaAllocator`, for temporaries that only
+         * need to live until the handler returns. The arena is rewound after
+         * every command, so pointers into it must not be retained.
+         * 
+         * @return Reference to the per-command arena.
+         */
+        T76::Core::Memory::Arena &commandArena();
+
     protected:
         InterpreterStatus _status; // Current status of the interpreter.
         TrieNode *_currentNode; // Current node in the trie for command parsing.
+        uint8_t _segmentIndex; // Number of characters of the current node's segment already matched.
+        bool _headerStarted; // Whether any character of the current command's header has been received.
+
+        TrieNode *_pathNode; // Node that the headers of a compound program message are resolved from.
+        uint8_t _pathSegmentIndex; // Number of characters of the path node's segment that precede the path.
 
-        std::vector<std::string> _parameters; // Vector to store raw parameters for the current command.
+        std::unique_ptr<ParameterValue[]> _parameterValues; // Parsed parameters of the current command, `_maxParameterCount` long.
+        std::unique_ptr<ParameterValue[]> _binaryParameterValues; // Decoded parameters of a binary request, `_maxParameterCount` long.
+        Error *_binaryError = nullptr; // Receives the errors of the binary request being executed, instead of the error queue.
+        size_t _parameterCount; // Number of parameters received for the current command.
+        bool _parameterError; // Whether a parameter of the current command could not be parsed.
+
+        std::unique_ptr<char[]> _stringStorage; // Unescaped string parameters, one parameter buffer per string parameter.
+        size_t _stringStorageUsed; // Bytes of string storage used by the current command.
 
         uint8_t _buffer[256]; // Buffer for partial parameter storage.
         size_t _bufferIndex; // Current index in the buffer for partial parameter storage.
+        bool _quoted; // Whether the parameter being received is inside quotation marks.
+        bool _escaped; // Whether the previous character of a quoted parameter was a backslash.
 
         // ABD (Arbitrary Data Block) parsing state
         uint8_t _abdSizeLength; // Number of digits that represent the data size (1-9)
         size_t _abdExpectedSize; // Expected total size of the ABD data block
-        std::vector<uint8_t> _abdDataBuffer; // Buffer to store ABD binary data
+        std::vector<uint8_t> _abdDataBuffer; // Buffer to store ABD binary data, or stage chunks of a streamed block; never grows past `_abdMaxSize`
         size_t _abdBytesRead; // Number of ABD data bytes read so far
-        size_t _abdMaxSize; // Maximum allowed size for ABD data blocks
+        size_t _abdChunkOffset; // Offset of the next chunk of a streamed block
+        size_t _abdStagingOffset; // Offset in `_abdDataBuffer` where the chunks of a streamed block are staged
+        bool _abdStreaming; // Whether the current block is being delivered to a chunk handler
+        size_t _abdMaxSize; // Maximum combined size of the ABD data blocks of a command
 
         TargetT &_target; // Reference to the target for command execution.
+        TargetLock *_targetLock = nullptr; // Lock held while a handler runs, shared with the other sessions of the target.
+        ResponseWriter _responseWriter = nullptr; // Sends the responses of constant queries.
+        void *_responseContext = nullptr; // Passed to the response writer.
+
+        inline static Interpreter *_current = nullptr; // Session whose handler is running.
+
+        T76::Core::Memory::Arena _commandArena; // Arena for temporaries that live for a single command
 
         static const TrieNode _trie; // Trie for command parsing.
+        static const char _trieSegments[]; // Segments of path-compressed trie nodes.
         static const Command<TargetT> _commands[]; // Array of commands.
         static const size_t _commandCount; // Number of commands.
         static const size_t _maxParameterCount; // Maximum number of parameters.
+        static const size_t _maxStringParameterCount; // Maximum number of string and block parameters of a single command.
+
+#if T76_SCPI_PROFILE
+        static const char *const _commandNames[]; // Syntax of every command, generated by `trie_generator.py --profile`.
+#endif
 
         /**
-         * @brief Reset the interpreter state for a new command.
+         * @brief Reset the interpreter state for a new program message.
          * 
          * This method resets the interpreter state, clearing the current command
-         * and parameters, and preparing for the next command input.
+         * and parameters, and preparing for the next command input. Headers are
+         * resolved from the root of the trie again.
          * 
          */
         void _resetState();
 
+        /**
+         * @brief Reset the interpreter state for the next command of a program message.
+         * 
+         * This method clears the current command and parameters, but keeps the
+         * header path, so that the next header is resolved relative to it.
+         */
+        void _resetCommandState();
+
         /**
          * @brief Finalize the current command processing.
          * 
          * This method finalizes the current command processing, checking if the
          * command is valid and executing it with the parsed parameters.
+         * 
+         * @param endOfMessage true if the command ends the program message, false
+         *                     if it is followed by another command after a semicolon.
+         */
+        void _finalizeCurrentCommand(bool endOfMessage); // Finalize the current command processing.
+
+        /**
+         * @brief Check the parameters of a command and call its handler, holding the target lock.
+         * 
+         * @param command The command to execute.
+         * @param parameters The parameters of the command.
+         * @param parameterError Whether a parameter could not be parsed.
+         */
+        void _callHandler(const Command<TargetT> &command, Parameters parameters, bool parameterError);
+
+        /**
+         * @brief Check the number of parameters of a command, adding an error if it is wrong.
+         * 
+         * Count errors take precedence over data type errors, as in the order
+         * in which a host would fix them.
+         * 
+         * @param count The number of parameters received, including defaults.
+         * @param expected The number of parameters the command takes.
+         * @param parameterError Whether a parameter could not be parsed.
+         * @return true if the handler can be called, false otherwise.
+         */
+        bool _checkParameters(size_t count, size_t expected, bool parameterError);
+
+        /**
+         * @brief Send the response of a constant query through the response writer.
+         * 
+         * @param response The response, without its terminator.
+         */
+        void _writeConstant(std::string_view response);
+
+#if T76_SCPI_GENERATED_DISPATCH
+        /**
+         * @brief Check the parameters of a command and call its handler.
+         * 
+         * Generated by `trie_generator.py --dispatch` as a switch over the
+         * command index, whose cases call the handlers directly. Called with
+         * the target lock held.
+         * 
+         * @param commandIndex The index of the command in `_commands`.
+         * @param parameters The parameters of the command.
+         * @param parameterError Whether a parameter could not be parsed.
+         */
+        void _dispatch(size_t commandIndex, Parameters parameters, bool parameterError);
+#endif
+
+        /**
+         * @brief Call the chunk handler of a command, holding the target lock.
+         * 
+         * @param command The command whose block is being received.
+         * @param parameters The parameters that precede the block.
+         * @param chunk The chunk of the block.
+         */
+        void _callChunkHandler(const Command<TargetT> &command, Parameters parameters, const ABDChunk &chunk);
+
+        /**
+         * @brief Track quotation marks in a parameter character.
+         * 
+         * @param byte The character, which is part of the parameter.
+         */
+        void _trackQuotes(uint8_t byte);
+
+        /**
+         * @brief Get the command that the input received so far names.
+         * 
+         * @return The command, or nullptr if the input does not name a command.
+         */
+        const Command<TargetT> *_currentCommand() const;
+
+        /**
+         * @brief Get the descriptor of the next parameter of the current command.
+         * 
+         * @return The descriptor, or nullptr if the input does not name a command
+         *         or the command does not take another parameter.
+         */
+        const ParameterDescriptor *_nextParameterDescriptor() const;
+
+        /**
+         * @brief Add the default values of the optional parameters that a command omits.
+         * 
+         * @param command The command whose parameters are being completed.
+         */
+        void _addDefaultParameters(const Command<TargetT> &command);
+
+        /**
+         * @brief Decode the packed parameters of a binary request.
+         * 
+         * @param command The command whose parameters are decoded.
+         * @param payload The packed parameters.
+         * @param length The size of the packed parameters in bytes.
+         * @return true if the parameters were decoded; otherwise, an error is added and false is returned.
+         */
+        bool _decodeBinaryParameters(const Command<TargetT> &command, const uint8_t *payload, size_t length);
+
+        /**
+         * @brief Parse a completed parameter and add it to the parameters of the current command.
+         * 
+         * Parameters that do not parse are recorded so that the error can be
+         * reported when the command completes, after any error in the number
+         * of parameters.
+         * 
+         * @param input The raw parameter.
          */
-        void _finalizeCurrentCommand(); // Finalize the current command processing.
+        void _addParameter(std::string_view input);
 
         /**
          * @brief Parse a parameter based on its descriptor.
@@ -214,55 +638,264 @@ namespace T76::SCPI {
          * 
          * @param descriptor The descriptor for the parameter to parse.
          * @param input The input string to parse.
-         * @param value The output `ParameterValue` object to fill with the parsed value.
-         * @return true if the parameter was successfully parsed, false otherwise.
+         * @return The parsed value, or a value of type Invalid if parsing fails.
          */
-        ParameterValue _parseParameter(const ParameterDescriptor &descriptor, const std::string &input) const;
+        ParameterValue _parseParameter(const ParameterDescriptor &descriptor, std::string_view input);
 
         /**
          * @brief Parse a number from a string
          * 
          * This method parses a number from a string input, handling scientific notation
-         * and SCPI suffixes (e.g., T, G, M, k, m) 
+         * and SCPI suffixes (e.g., T, G, M, k, m). All digits are accumulated into a
+         * 64-bit integer mantissa, which plain integers use as-is; other numbers are
+         * scaled once, from a table of powers of ten, by the combined exponent of
+         * their decimals, exponent and suffix.
          * 
          * @param input The input string to parse.
-         * @param result The output variable to store the parsed number.
-         * @return true if the number was successfully parsed, false otherwise.
+         * @return A ParameterValue containing the number, or an invalid type if parsing fails.
          */
-        ParameterValue _parseNumber(const std::string &input) const; // Parse a number without exceptions
+        ParameterValue _parseNumber(std::string_view input) const; // Parse a number without exceptions
 
         /**
          * @brief Parse a string parameter.
          * 
          * This method checks that strings are delimited by quotation marks and
-         * handles escaped quotation marks within the string.
+         * handles escaped quotation marks within the string. The unescaped
+         * string is stored in the string storage.
          * 
          * @param input The input string to parse.
          * @return A ParameterValue containing the parsed string or an invalid type if parsing fails.
          */
-        ParameterValue _parseString(const std::string &input) const;
+        ParameterValue _parseString(std::string_view input);
+
+        /**
+         * @brief Copy a raw parameter to the string storage.
+         * 
+         * @return A view over the copy, or nullptr if there is no room for it.
+         */
+        char *_storeString(std::string_view input);
+
+        /**
+         * @brief Check whether a parameter matches a keyword, ignoring case.
+         */
+        static bool _matchesKeyword(std::string_view input, const char *keyword);
 
         /**
          * @brief Complete ABD parameter parsing.
          * 
-         * This method creates a ParameterValue with ArbitraryData type from the
-         * completed ABD data buffer and adds it to the parameters vector.
+         * This method adds a view over the completed block, which stays in the
+         * ABD data buffer until the command completes, to the parameters, so
+         * that the handler can receive the data without copying it.
          */
         void _completeABDParameter();
+
+        /**
+         * @brief Start delivering a block to the current command's chunk handler, if it has one.
+         * 
+         * The parameters that precede the block have already been parsed, so
+         * that the chunk handler can use them.
+         * 
+         * @return true if the block will be streamed, or false if it must be
+         *         buffered. If the parameters are invalid, true is returned and
+         *         the interpreter is put in the error state.
+         */
+        bool _beginStreamingABD();
+
+        /**
+         * @brief Pass a chunk of a streamed block to the chunk handler.
+         */
+        void _deliverABDChunk(const uint8_t *data, size_t length);
+
+        /**
+         * @brief Pass any chunk staged by processInputCharacter() to the chunk handler.
+         */
+        void _flushABDChunk();
+
+        /**
+         * @brief Convert ASCII lowercase characters to uppercase.
+         * 
+         * Bytes are processed four at a time; bytes outside of `a`-`z` are
+         * copied unchanged, the same as toupper() in the C locale.
+         * 
+         * @param destination Where to store the converted characters.
+         * @param source The characters to convert.
+         * @param length The number of characters to convert.
+         */
+        static void _foldCase(uint8_t *destination, const uint8_t *source, size_t length);
+
+        /**
+         * @brief Match input against the rest of the current node's segment.
+         * 
+         * @return The number of bytes matched, or 0 if the next byte must
+         *         go through processInputCharacter().
+         */
+        size_t _consumeSegment(const uint8_t *data, size_t length);
+
+        /**
+         * @brief Append a run of non-delimiter bytes to the parameter buffer.
+         * 
+         * @return The number of bytes appended, or 0 if the next byte must
+         *         go through processInputCharacter().
+         */
+        size_t _consumeArgument(const uint8_t *data, size_t length);
+
+        /**
+         * @brief Append bytes to the arbitrary data block being received.
+         * 
+         * @return The number of bytes appended.
+         */
+        size_t _consumeABDData(const uint8_t *data, size_t length);
+
+        /**
+         * @brief Skip input up to the end of the program message that caused an error.
+         * 
+         * @return The number of bytes skipped, not including the line terminator.
+         */
+        size_t _skipToEndOfCommand(const uint8_t *data, size_t length);
     };
 
     // Template implementation
     template<typename TargetT>
-    Interpreter<TargetT>::Interpreter(TargetT &target, size_t abdMaxSize) :
+    Interpreter<TargetT>::Interpreter(TargetT &target, size_t abdMaxSize, size_t commandArenaSize) :
           _target(target),
-          _abdMaxSize(abdMaxSize) {
+          _abdMaxSize(abdMaxSize),
+          _commandArena(commandArenaSize) {
+        // All parameter storage is allocated up front, so that commands can be processed without allocating
+        _parameterValues = std::make_unique<ParameterValue[]>(_maxParameterCount);
+        _binaryParameterValues = std::make_unique<ParameterValue[]>(_maxParameterCount);
+        _stringStorage = std::make_unique<char[]>(_maxStringParameterCount * sizeof(_buffer));
+        _abdDataBuffer.reserve(_abdMaxSize);
+
         _resetState();
     }
 
     template<typename TargetT>
     void Interpreter<TargetT>::reset() {
         _resetState();
-        errorQueue = std::queue<std::string>(); // Clear the error queue
+        errorQueue.clear(); // Clear the error queue
+        dataFormat = DataFormat();
+        operations.disarm();
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::clearStatus() {
+        errorQueue.clear();
+        status.clear();
+        operations.disarm();
+    }
+
+    template<typename TargetT>
+    uint8_t Interpreter<TargetT>::statusByte(bool messageAvailable) const {
+        return status.statusByte(!errorQueue.empty(), messageAvailable);
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::discardInput() {
+        _resetState();
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::setTargetLock(TargetLock *lock) {
+        _targetLock = lock;
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::setResponseWriter(ResponseWriter writer, void *context) {
+        _responseWriter = writer;
+        _responseContext = context;
+    }
+
+    template<typename TargetT>
+    bool Interpreter<TargetT>::sendResponse(std::string_view response) {
+        return _responseWriter && _responseWriter(_responseContext, response);
+    }
+
+    template<typename TargetT>
+    Interpreter<TargetT> *Interpreter<TargetT>::current() {
+        return _current;
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_callHandler(const Command<TargetT> &command, Parameters parameters, bool parameterError) {
+#if T76_SCPI_PROFILE
+        profile.beginHandler();
+#endif
+
+        if (_targetLock) {
+            _targetLock->lock();
+        }
+
+        // Handlers can feed another session from their own task, so the caller's session is restored afterwards
+        Interpreter *previous = _current;
+        _current = this;
+
+#if T76_SCPI_GENERATED_DISPATCH
+        // The generated switch checks the parameters against the constant arity of each command
+        _dispatch(static_cast<size_t>(&command - _commands), parameters, parameterError);
+#else
+        if (!_checkParameters(parameters.size(), command.parameterCount, parameterError)) {
+            // The error has been added
+        } else if (command.constant) {
+            _writeConstant(command.constant(_target));
+        } else if (command.trampoline) {
+            // Typed handlers are called with the parameters unpacked
+            command.trampoline(_target, parameters);
+        } else {
+            (_target.*command.handler)(parameters);
+        }
+#endif
+
+        _current = previous;
+
+        if (_targetLock) {
+            _targetLock->unlock();
+        }
+
+#if T76_SCPI_PROFILE
+        profile.endHandler(static_cast<size_t>(&command - _commands));
+#endif
+    }
+
+    template<typename TargetT>
+    bool Interpreter<TargetT>::_checkParameters(size_t count, size_t expected, bool parameterError) {
+        if (count > expected) {
+            addError(SCPIErrorParameterNotAllowed, "Parameter not allowed");
+        } else if (count < expected) {
+            addError(SCPIErrorMissingParameter, "Missing parameter");
+        } else if (parameterError) {
+            addError(SCPIErrorDataTypeError, "Data type error");
+        } else {
+            return true;
+        }
+
+        return false;
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_writeConstant(std::string_view response) {
+        if (!_responseWriter) {
+            addError(SCPIErrorDeviceSpecific, "Device-specific error; no response writer");
+        } else {
+            _responseWriter(_responseContext, response);
+        }
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_callChunkHandler(const Command<TargetT> &command, Parameters parameters, const ABDChunk &chunk) {
+        if (_targetLock) {
+            _targetLock->lock();
+        }
+
+        Interpreter *previous = _current;
+        _current = this;
+
+        (_target.*command.chunkHandler)(parameters, chunk);
+
+        _current = previous;
+
+        if (_targetLock) {
+            _targetLock->unlock();
+        }
     }
 
     template<typename TargetT>
@@ -296,6 +929,11 @@ namespace T76::SCPI {
         return preamble;
     }
 
+    template<typename TargetT>
+    T76::Core::Memory::Arena &Interpreter<TargetT>::commandArena() {
+        return _commandArena;
+    }
+
     template<typename TargetT>
     size_t Interpreter<TargetT>::maxParameterCount() const {
         return _maxParameterCount;
@@ -303,6 +941,10 @@ namespace T76::SCPI {
 
     template<typename TargetT>
     void Interpreter<TargetT>::processInputCharacter(uint8_t byte) {
+#if T76_SCPI_PROFILE
+        CommandProfile::InputScope profileScope(profile);
+#endif
+
         // Process the byte based on the current status
 
         // Command and ordinary parameter parsing are case-insensitive, but
@@ -317,16 +959,56 @@ namespace T76::SCPI {
 
                 if (byte == '\n' || byte == '\r') {
                     // End of command, finalize the current command
-                    _finalizeCurrentCommand();
+                    _finalizeCurrentCommand(true);
+                } else if (byte == ';') {
+                    // End of one command of a compound message
+                    _finalizeCurrentCommand(false);
                 } else if (byte == ' ' || byte == '\t') {
-                    // Space indicates the end of the command, switch to argument parsing
-                    _status = InterpreterStatus::ParsingArgument;
+                    // Space indicates the end of the command, switch to argument parsing,
+                    // unless it precedes the header
+                    if (_headerStarted) {
+                        _status = InterpreterStatus::ParsingArgument;
+                    }
                 } else {
-                    // Continue parsing the command
-                    TrieNode *nextNode = _currentNode->nextChild(byte);
+                    if (!_headerStarted) {
+                        _headerStarted = true;
+
+                        // Common commands and headers that start with a colon are resolved
+                        // from the root; only the colon changes the path of the message
+                        if (byte == ':' || byte == '*') {
+                            _currentNode = const_cast<TrieNode*>(&_trie);
+                            _segmentIndex = 0;
+
+                            if (byte == ':') {
+                                _pathNode = _currentNode;
+                                _pathSegmentIndex = 0;
+                                break;
+                            }
+                        }
+                    }
+
+                    // Continue parsing the command, first through the rest of the
+                    // current node's segment and then into its children
+                    TrieNode *nextNode = nullptr;
+
+                    if (_segmentIndex < _currentNode->segmentLength) {
+                        if (_trieSegments[_currentNode->segmentOffset + _segmentIndex] == byte) {
+                            _segmentIndex++;
+                            nextNode = _currentNode;
+                        }
+                    } else {
+                        nextNode = _currentNode->nextChild(byte);
+                        _segmentIndex = 0;
+                    }
 
                     if (nextNode) {
                         _currentNode = nextNode;
+
+                        // The next command of the message is resolved relative to the last colon
+                        if (byte == ':') {
+                            _pathNode = _currentNode;
+                            _pathSegmentIndex = _segmentIndex;
+                        }
                     } else {
                         addError(SCPIErrorUndefinedHeader, "Undefined header");
                         _status = InterpreterStatus::Error;
@@ -344,35 +1026,42 @@ namespace T76::SCPI {
                     break;
                 }
 
-                // If the byte is space or newline, attempt to parse the current parameter
-                if (byte == ' ' || byte == '\t' || byte == '\n' || byte == '\r') {
+                // If the byte is a separator or ends the command, attempt to parse the current parameter
+                if (byte == '\n' || byte == '\r' || (!_quoted && (byte == ' ' || byte == '\t' || byte == ',' || byte == ';'))) {
                     // If buffer is empty, we can ignore the byte and continue
                     if (_bufferIndex != 0) {
                         // Ensure that we are not exceeding the maximum number of parameters
-                        if (_parameters.size() >= _maxParameterCount) {
-                            // If we exceed the number of parameters, set the status to error
-                            _status = InterpreterStatus::Error;
+                        if (_parameterCount >= _maxParameterCount) {
+                            // If we exceed the number of parameters, set the status to error,
+                            // unless this byte already ends the command
                             addError(SCPIErrorParameterNotAllowed, "Parameter not allowed");
+
+                            if (byte == '\n' || byte == '\r') {
+                                _resetState();
+                            } else {
+                                // The rest of a compound message is discarded
+                                _status = InterpreterStatus::Error;
+                            }
+
                             return;
                         }
 
-                        // Make a copy of the buffer to a string
-                        _buffer[_bufferIndex] = '\0'; // Null-terminate the buffer
-                        const char* rawParameterValue = reinterpret_cast<const char*>(_buffer);
-
-                        // Create a new parameter value and add it to the parameters vector
-                        _parameters.push_back(rawParameterValue);
+                        // Parse the parameter now, while it is still in the buffer
+                        _addParameter(std::string_view(reinterpret_cast<const char*>(_buffer), _bufferIndex));
                     }
                     
                     // If we are at the end of the command, finalize it
                     if (byte == '\n' || byte == '\r') {
-                        _finalizeCurrentCommand();
+                        _finalizeCurrentCommand(true);
+                    } else if (byte == ';') {
+                        _finalizeCurrentCommand(false);
                     }
 
                     // Reset the buffer index for the next parameter
                     _bufferIndex = 0;   
                 } else {
                     // Otherwise, accumulate the byte in the buffer
+                    _trackQuotes(byte);
 
                     if (_bufferIndex < sizeof(_buffer) - 1) {
                         _buffer[_bufferIndex++] = byte;
@@ -409,13 +1098,14 @@ namespace T76::SCPI {
                         if (_abdExpectedSize == 0) {
                             addError(SCPIErrorInvalidBlockData, "Invalid block data");
                             _status = InterpreterStatus::Error;
-                        } else if (_abdExpectedSize > _abdMaxSize) {
+                        } else if (_beginStreamingABD()) {
+                            // The block goes straight to the chunk handler
+                        } else if (_abdExpectedSize > _abdMaxSize - _abdDataBuffer.size()) {
                             addError(SCPIErrorTooMuchData, "Too much data");
                             _status = InterpreterStatus::Error;
                         } else {
-                            // Initialize data buffer and start reading data
-                            _abdDataBuffer.clear();
-                            _abdDataBuffer.reserve(_abdExpectedSize);
+                            // Append the block to the data buffer; blocks of the same
+                            // command are kept back to back until it completes
                             _abdBytesRead = 0;
                             _status = InterpreterStatus::ParsingABDData;
                         }
@@ -429,14 +1119,30 @@ namespace T76::SCPI {
 
             case InterpreterStatus::ParsingABDData:
                 // Read binary data byte (including \n, \r, and any other byte)
-                _abdDataBuffer.push_back(byte);
                 _abdBytesRead++;
+
+                if (!_abdStreaming) {
+                    _abdDataBuffer.push_back(byte);
+                } else if (_abdDataBuffer.size() < _abdMaxSize) {
+                    // Streamed blocks are staged and handed over a chunk at a time
+                    _abdDataBuffer.push_back(byte);
+
+                    if (_abdDataBuffer.size() >= _abdMaxSize || _abdBytesRead >= _abdExpectedSize) {
+                        _flushABDChunk();
+                    }
+                } else {
+                    // Earlier blocks of the command fill the buffer, so there is no room to stage
+                    _deliverABDChunk(&byte, 1);
+                }
                 
                 // Check if we've now reached the expected size
                 if (_abdBytesRead >= _abdExpectedSize) {
                     // All data received, complete the ABD parameter
                     _completeABDParameter();
-                    _status = InterpreterStatus::ParsingArgument;
+
+                    if (_status == InterpreterStatus::ParsingABDData) {
+                        _status = InterpreterStatus::ParsingArgument;
+                    }
                 }
                 break;
 
@@ -453,9 +1159,371 @@ namespace T76::SCPI {
     }
 
     template<typename TargetT>
-    void Interpreter<TargetT>::addError(int errorNumber, const std::string &errorString) {
-        // Add an error to the error queue
-        errorQueue.push(std::to_string(errorNumber) + "," + formatString(errorString));
+    void Interpreter<TargetT>::processInput(const uint8_t *data, size_t length) {
+#if T76_SCPI_PROFILE
+        CommandProfile::InputScope profileScope(profile);
+#endif
+
+        while (length > 0) {
+            size_t consumed = 0;
+
+            switch (_status) {
+                case InterpreterStatus::ParsingCommand:
+                    consumed = _consumeSegment(data, length);
+                    break;
+
+                case InterpreterStatus::ParsingArgument:
+                    consumed = _consumeArgument(data, length);
+                    break;
+
+                case InterpreterStatus::ParsingABDData:
+                    consumed = _consumeABDData(data, length);
+                    break;
+
+                case InterpreterStatus::Error:
+                    consumed = _skipToEndOfCommand(data, length);
+                    break;
+
+                default:
+                    break;
+            }
+
+            if (consumed == 0) {
+                // Delimiters, child lookups and state changes take the per-character path
+                processInputCharacter(*data);
+                consumed = 1;
+            }
+
+            data += consumed;
+            length -= consumed;
+        }
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_foldCase(uint8_t *destination, const uint8_t *source, size_t length) {
+        size_t i = 0;
+
+        for (; i + sizeof(uint32_t) <= length; i += sizeof(uint32_t)) {
+            uint32_t word;
+            memcpy(&word, source + i, sizeof(word));
+
+            // The high bit of each byte of `lower` is set if that byte is in 'a'-'z'
+            const uint32_t low = word & 0x7F7F7F7F;
+            const uint32_t lower = (low + 0x1F1F1F1F) & ~(low + 0x05050505) & ~word & 0x80808080;
+
+            word ^= lower >> 2;
+            memcpy(destination + i, &word, sizeof(word));
+        }
+
+        for (; i < length; ++i) {
+            destination[i] = toupper(source[i]);
+        }
+    }
+
+    template<typename TargetT>
+    size_t Interpreter<TargetT>::_consumeSegment(const uint8_t *data, size_t length) {
+        if (!_headerStarted) {
+            // Leading colons and common commands change where the header is resolved from
+            return 0;
+        }
+
+        const size_t remaining = _currentNode->segmentLength - _segmentIndex;
+        const size_t count = std::min(remaining, length);
+        const char *segment = &_trieSegments[_currentNode->segmentOffset + _segmentIndex];
+
+        size_t matched = 0;
+        uint8_t folded[32];
+
+        while (matched < count) {
+            const size_t chunk = std::min(count - matched, sizeof(folded));
+
+            _foldCase(folded, data + matched, chunk);
+
+            if (memcmp(folded, segment + matched, chunk) != 0) {
+                // Let the per-character path find the mismatch and report it
+                break;
+            }
+
+            matched += chunk;
+        }
+
+        // The next command of the message is resolved relative to the last colon
+        for (size_t i = matched; i > 0; --i) {
+            if (segment[i - 1] == ':') {
+                _pathNode = _currentNode;
+                _pathSegmentIndex = static_cast<uint8_t>(_segmentIndex + i);
+                break;
+            }
+        }
+
+        _segmentIndex += matched;
+        return matched;
+    }
+
+    template<typename TargetT>
+    size_t Interpreter<TargetT>::_consumeArgument(const uint8_t *data, size_t length) {
+        if (_bufferIndex == 0 && data[0] == '#') {
+            return 0;
+        }
+
+        // Leave the byte that overflows the buffer to the per-character path, which reports it
+        length = std::min(length, sizeof(_buffer) - 1 - _bufferIndex);
+
+        size_t count = 0;
+
+        while (count < length) {
+            const uint8_t byte = data[count];
+
+            if (byte == '\n' || byte == '\r' || (!_quoted && (byte == ' ' || byte == '\t' || byte == ',' || byte == ';'))) {
+                break;
+            }
+
+            _trackQuotes(byte);
+            count++;
+        }
+
+        _foldCase(&_buffer[_bufferIndex], data, count);
+        _bufferIndex += count;
+
+        return count;
+    }
+
+    template<typename TargetT>
+    size_t Interpreter<TargetT>::_consumeABDData(const uint8_t *data, size_t length) {
+        const size_t count = std::min(length, _abdExpectedSize - _abdBytesRead);
+
+        if (_abdStreaming) {
+            // Pass the input straight through, after anything staged so far
+            _flushABDChunk();
+            _deliverABDChunk(data, count);
+#ifdef T76_IC_DMA_OFFLOAD
+        } else if (count >= T76_IC_DMA_THRESHOLD) {
+            // Large chunks move by DMA while the task blocks; the buffer's capacity is reserved, so resize() never reallocates
+            const size_t offset = _abdDataBuffer.size();
+
+            _abdDataBuffer.resize(offset + count);
+            T76::Core::DMA::copy(_abdDataBuffer.data() + offset, data, count);
+#endif
+        } else {
+            _abdDataBuffer.insert(_abdDataBuffer.end(), data, data + count);
+        }
+
+        _abdBytesRead += count;
+
+        if (_abdBytesRead >= _abdExpectedSize) {
+            _completeABDParameter();
+
+            if (_status == InterpreterStatus::ParsingABDData) {
+                _status = InterpreterStatus::ParsingArgument;
+            }
+        }
+
+        return count;
+    }
+
+    template<typename TargetT>
+    size_t Interpreter<TargetT>::_skipToEndOfCommand(const uint8_t *data, size_t length) {
+        const uint8_t *end = static_cast<const uint8_t*>(memchr(data, '\n', length));
+        size_t count = end ? static_cast<size_t>(end - data) : length;
+
+        end = static_cast<const uint8_t*>(memchr(data, '\r', count));
+        if (end) {
+            count = static_cast<size_t>(end - data);
+        }
+
+        return count;
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::addError(int errorNumber, const char *errorString) {
+        status.setErrorEvent(errorNumber);
+
+        // The errors of a binary request are returned to its sender
+        if (_binaryError) {
+            if (_binaryError->code == ErrorQueue::NoErrorCode) {
+                *_binaryError = {static_cast<int16_t>(errorNumber), errorString};
+            }
+
+            return;
+        }
+
+        // Add an error to the error queue; it is formatted when it is read
+        errorQueue.push(static_cast<int16_t>(errorNumber), errorString);
+    }
+
+    template<typename TargetT>
+    bool Interpreter<TargetT>::executeBinary(uint16_t opcode, const uint8_t *payload, size_t length, Error &error) {
+#if T76_SCPI_PROFILE
+        // Decoding the parameters counts as parsing the command
+        CommandProfile::InputScope profileScope(profile);
+        profile.discardParse();
+#endif
+
+        error = {ErrorQueue::NoErrorCode, "No error"};
+        _binaryError = &error;
+
+        if (opcode >= _commandCount) {
+            addError(SCPIErrorUndefinedHeader, "Undefined header");
+        } else {
+            const Command<TargetT> &command = _commands[opcode];
+
+            // Release everything the handler allocates from the command arena once it returns
+            T76::Core::Memory::ArenaScope commandScope(_commandArena);
+
+            if (_decodeBinaryParameters(command, payload, length)) {
+                const Parameters parameters(_binaryParameterValues.get(), command.parameterCount);
+                const ParameterValue *block = command.parameterCount > 0 ? &parameters.back() : nullptr;
+
+                // A block meant for a chunk handler has already been received in full, so it is a single chunk
+                if (command.chunkHandler && block && block->type == ParameterType::ArbitraryData) {
+                    const ABDChunk chunk = {block->dataValue, block->dataLength, 0, block->dataLength};
+                    ParameterValue &value = _binaryParameterValues[command.parameterCount - 1];
+
+                    _callChunkHandler(command, parameters.first(command.parameterCount - 1), chunk);
+                    value.dataValue = nullptr;
+                }
+
+                _callHandler(command, parameters, false);
+            }
+        }
+
+        _binaryError = nullptr;
+        return error.code == ErrorQueue::NoErrorCode;
+    }
+
+    template<typename TargetT>
+    bool Interpreter<TargetT>::_decodeBinaryParameters(const Command<TargetT> &command, const uint8_t *payload, size_t length) {
+        size_t offset = 0;
+
+        const auto read = [&](void *destination, size_t size) {
+            if (length - offset < size) {
+                return false;
+            }
+
+            memcpy(destination, payload + offset, size);
+            offset += size;
+            return true;
+        };
+
+        for (uint8_t i = 0; i < command.parameterCount; i++) {
+            const ParameterDescriptor &descriptor = command.parameterDescriptors[i];
+            ParameterValue value(ParameterType::Invalid);
+
+            if (offset == length && descriptor.hasDefault) {
+                // Omitted trailing parameters take their defaults, as in text commands
+                switch (descriptor.type) {
+                    case ParameterType::String:
+                        value = ParameterValue(std::string_view(descriptor.defaultValue.stringValue));
+                        break;
+
+                    case ParameterType::Number:
+                        value = ParameterValue(descriptor.defaultValue.numberValue);
+                        break;
+
+                    case ParameterType::Boolean:
+                        value = ParameterValue(descriptor.defaultValue.booleanValue);
+                        break;
+
+                    case ParameterType::Enum:
+                        value = _parseParameter(descriptor, descriptor.defaultValue.enumValue);
+                        break;
+
+                    default:
+                        break;
+                }
+            } else if (offset == length) {
+                addError(SCPIErrorMissingParameter, "Missing parameter");
+                return false;
+            } else {
+                switch (descriptor.type) {
+                    case ParameterType::Number: {
+                        double number;
+
+                        if (read(&number, sizeof(number)) && number == number) {
+                            value = ParameterValue(number);
+                        }
+
+                        break;
+                    }
+
+                    case ParameterType::Boolean: {
+                        uint8_t boolean;
+
+                        if (read(&boolean, sizeof(boolean)) && boolean <= 1) {
+                            value = ParameterValue(boolean != 0);
+                        }
+
+                        break;
+                    }
+
+                    case ParameterType::Enum: {
+                        uint8_t index;
+
+                        if (read(&index, sizeof(index)) && index < descriptor.choiceCount) {
+                            value = ParameterValue(std::string_view(descriptor.choices[index]), true);
+                            value.enumIndex = index;
+                        }
+
+                        break;
+                    }
+
+                    case ParameterType::String: {
+                        uint16_t size;
+
+                        if (read(&size, sizeof(size)) && length - offset >= size) {
+                            value = ParameterValue(std::string_view(reinterpret_cast<const char*>(payload + offset), size));
+                            offset += size;
+                        }
+
+                        break;
+                    }
+
+                    case ParameterType::ArbitraryData: {
+                        uint32_t size;
+
+                        if (read(&size, sizeof(size)) && length - offset >= size) {
+                            value = ParameterValue(payload + offset, size);
+                            offset += size;
+                        }
+
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+            }
+
+            if (value.type == ParameterType::Invalid) {
+                addError(SCPIErrorDataTypeError, "Data type error");
+                return false;
+            }
+
+            _binaryParameterValues[i] = value;
+        }
+
+        if (offset != length) {
+            addError(SCPIErrorParameterNotAllowed, "Parameter not allowed");
+            return false;
+        }
+
+        return true;
+    }
+
+    template<typename TargetT>
+    size_t Interpreter<TargetT>::nextError(char *buffer, size_t size) {
+        Error error;
+        errorQueue.pop(error);
+
+        return ErrorQueue::format(error, buffer, size);
+    }
+
+    template<typename TargetT>
+    std::string Interpreter<TargetT>::nextError() {
+        char buffer[sizeof(_buffer)];
+        const size_t length = nextError(buffer, sizeof(buffer));
+
+        return std::string(buffer, length);
     }
 
     template<typename TargetT>
@@ -463,8 +1531,7 @@ namespace T76::SCPI {
         std::vector<std::string> errorMessages;
 
         while (!errorQueue.empty()) {
-            errorMessages.push_back(errorQueue.front());
-            errorQueue.pop();
+            errorMessages.push_back(nextError());
         }
         
         return errorMessages;
@@ -472,87 +1539,256 @@ namespace T76::SCPI {
 
     template<typename TargetT>
     void Interpreter<TargetT>::_resetState() {
-        // Reset the interpreter state for a new command
+        // Reset the interpreter state for a new program message
+        _pathNode = const_cast<TrieNode*>(&_trie);
+        _pathSegmentIndex = 0;
+
+        _resetCommandState();
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_resetCommandState() {
+        // Reset the interpreter state for a new command, which starts at the current path
         _status = InterpreterStatus::ParsingCommand;
-        _currentNode = const_cast<TrieNode*>(&_trie);
-        _parameters.clear();
+        _currentNode = _pathNode;
+        _segmentIndex = _pathSegmentIndex;
+        _headerStarted = false;
+        _parameterCount = 0;
+        _parameterError = false;
+        _stringStorageUsed = 0;
         _bufferIndex = 0;
+        _quoted = false;
+        _escaped = false;
         
         // Reset ABD parsing state
         _abdSizeLength = 0;
         _abdExpectedSize = 0;
         _abdDataBuffer.clear();
         _abdBytesRead = 0;
+        _abdChunkOffset = 0;
+        _abdStagingOffset = 0;
+        _abdStreaming = false;
+
+#if T76_SCPI_PROFILE
+        // A command that was not executed does not carry its parse time over to the next one
+        profile.discardParse();
+#endif
     }
 
     template<typename TargetT>
-    void Interpreter<TargetT>::_finalizeCurrentCommand() {
-        // Finalize the current command processing
-        if (_currentNode->terminal()) {
-            // If the command is valid, process the parameters
-            Command<TargetT> command = _commands[_currentNode->commandIndex];
-            std::vector<ParameterValue> parsedParameters;
+    const Command<TargetT> *Interpreter<TargetT>::_currentCommand() const {
+        if (!_currentNode->terminal() || _segmentIndex != _currentNode->segmentLength) {
+            return nullptr;
+        }
 
-            if (_parameters.size() > command.parameterCount) {
-                addError(SCPIErrorParameterNotAllowed, "Parameter not allowed");
+        return &_commands[_currentNode->commandIndex];
+    }
 
-                _resetState();
-                return;
-            } 
-            
-            if (_parameters.size() < command.parameterCount) {
-                addError(SCPIErrorMissingParameter, "Missing parameter");
-                _resetState();
-                return;
+    template<typename TargetT>
+    const ParameterDescriptor *Interpreter<TargetT>::_nextParameterDescriptor() const {
+        const Command<TargetT> *command = _currentCommand();
+
+        if (command == nullptr || command->parameterDescriptors == nullptr || _parameterCount >= command->parameterCount) {
+            return nullptr;
+        }
+
+        return &command->parameterDescriptors[_parameterCount];
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_addParameter(std::string_view input) {
+        const ParameterDescriptor *descriptor = _nextParameterDescriptor();
+        ParameterValue value(ParameterType::Invalid);
+
+        // Parameters the command does not take are only counted
+        if (descriptor) {
+            value = _parseParameter(*descriptor, input);
+
+            if (value.type == ParameterType::Invalid) {
+                _parameterError = true;
             }
-            
-            // Parse parameters only if the command expects them
-            if (command.parameterCount > 0 && command.parameterDescriptors != nullptr) {
-                size_t parameterIndex = 0;
-                for (const auto &param : _parameters) {
-                    auto value = _parseParameter(command.parameterDescriptors[parameterIndex++], param);
-
-                    if (value.type == ParameterType::Invalid) {
-                        addError(SCPIErrorDataTypeError, "Data type error");
-                        _resetState();
-                        return;
-                    }
+        }
 
-                    parsedParameters.push_back(value);
-                }
+        _parameterValues[_parameterCount++] = value;
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_addDefaultParameters(const Command<TargetT> &command) {
+        // Optional parameters always follow the required ones
+        while (_parameterCount < command.parameterCount && command.parameterDescriptors[_parameterCount].hasDefault) {
+            const ParameterDescriptor &descriptor = command.parameterDescriptors[_parameterCount];
+            ParameterValue value(ParameterType::Invalid);
+
+            switch (descriptor.type) {
+                case ParameterType::String:
+                    value = ParameterValue(std::string_view(descriptor.defaultValue.stringValue));
+                    break;
+
+                case ParameterType::Number:
+                    value = ParameterValue(descriptor.defaultValue.numberValue);
+                    break;
+
+                case ParameterType::Boolean:
+                    value = ParameterValue(descriptor.defaultValue.booleanValue);
+                    break;
+
+                case ParameterType::Enum:
+                    // Resolves the index of the choice, like a parameter that was sent
+                    value = _parseParameter(descriptor, descriptor.defaultValue.enumValue);
+                    break;
+
+                default:
+                    break;
             }
 
-            (_target.*command.handler)(parsedParameters);
+            _parameterValues[_parameterCount++] = value;
+        }
+    }
+
+    template<typename TargetT>
+    bool Interpreter<TargetT>::_beginStreamingABD() {
+        const Command<TargetT> *command = _currentCommand();
+
+        // Only the command's last parameter can be streamed
+        if (command == nullptr || command->chunkHandler == nullptr || _parameterCount + 1 != command->parameterCount) {
+            return false;
+        }
 
-        } else if (_currentNode == &_trie) {
+        if (_parameterError) {
+            addError(SCPIErrorDataTypeError, "Data type error");
+            _status = InterpreterStatus::Error;
+            return true;
+        }
+
+        // The handler sees the block as a view with no data and the total size
+        _parameterValues[_parameterCount++] = ParameterValue(nullptr, _abdExpectedSize);
+
+        // Chunks are staged after any blocks that precede this one
+        _abdStagingOffset = _abdDataBuffer.size();
+        _abdBytesRead = 0;
+        _abdChunkOffset = 0;
+        _abdStreaming = true;
+        _status = InterpreterStatus::ParsingABDData;
+
+        return true;
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_deliverABDChunk(const uint8_t *data, size_t length) {
+        if (length == 0) {
+            return;
+        }
+
+        const Command<TargetT> &command = _commands[_currentNode->commandIndex];
+        const ABDChunk chunk = {
+            .data = data,
+            .length = length,
+            .offset = _abdChunkOffset,
+            .totalSize = _abdExpectedSize,
+        };
+
+        _abdChunkOffset += length;
+        _callChunkHandler(command, Parameters(_parameterValues.get(), _parameterCount), chunk);
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_flushABDChunk() {
+        _deliverABDChunk(_abdDataBuffer.data() + _abdStagingOffset, _abdDataBuffer.size() - _abdStagingOffset);
+        _abdDataBuffer.resize(_abdStagingOffset);
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_finalizeCurrentCommand(bool endOfMessage) {
+        T76_TRACE_SPAN("scpi.command");
+
+        // Finalize the current command processing
+        const Command<TargetT> *command = _currentCommand();
+
+        if (command) {
+            // Release everything the handler allocates from the command arena once it returns
+            T76::Core::Memory::ArenaScope commandScope(_commandArena);
+
+            // The parameters have already been parsed; only the errors are left to report
+            _addDefaultParameters(*command);
+
+            _callHandler(*command, Parameters(_parameterValues.get(), _parameterCount), _parameterError);
+
+        } else if (!_headerStarted) {
             // No command was entered (empty input), do nothing
         } else {
             addError(SCPIErrorUndefinedHeader, "Undefined header");
         }
 
         // Reset the state for the next command
-        _resetState();
+        if (endOfMessage) {
+            _resetState();
+        } else {
+            _resetCommandState();
+        }
+    }
+
+    template<typename TargetT>
+    void Interpreter<TargetT>::_trackQuotes(uint8_t byte) {
+        // Separators between quotation marks are part of the string; escaped
+        // quotation marks, as understood by _parseString(), do not end it
+        if (_escaped) {
+            _escaped = false;
+        } else if (_quoted) {
+            if (byte == '\\') {
+                _escaped = true;
+            } else if (byte == '"') {
+                _quoted = false;
+            }
+        } else if (byte == '"') {
+            _quoted = true;
+        }
+    }
+
+    template<typename TargetT>
+    char *Interpreter<TargetT>::_storeString(std::string_view input) {
+        if (input.size() > _maxStringParameterCount * sizeof(_buffer) - _stringStorageUsed) {
+            return nullptr;
+        }
+
+        char *copy = &_stringStorage[_stringStorageUsed];
+
+        memcpy(copy, input.data(), input.size());
+        _stringStorageUsed += input.size();
+
+        return copy;
+    }
+
+    template<typename TargetT>
+    bool Interpreter<TargetT>::_matchesKeyword(std::string_view input, const char *keyword) {
+        return strlen(keyword) == input.size() && strncasecmp(input.data(), keyword, input.size()) == 0;
     }
 
     template<typename TargetT>
-    ParameterValue Interpreter<TargetT>::_parseString(const std::string &input) const {
+    ParameterValue Interpreter<TargetT>::_parseString(std::string_view input) {
         if (input.size() < 2 || input.front() != '"' || input.back() != '"') {
             return ParameterValue(ParameterType::Invalid); // Invalid string format
         }
 
-        std::string parsedString;
+        // The unescaped string is never longer than the input, so reserve room for all of it
+        char *parsedString = _storeString(input.substr(1, input.size() - 2));
+
+        if (parsedString == nullptr) {
+            return ParameterValue(ParameterType::Invalid);
+        }
+
+        size_t length = 0;
         bool escape = false;
 
         for (size_t i = 1; i < input.size() - 1; ++i) { // Skip the surrounding quotes
             char currentChar = input[i];
 
             if (escape) {
-                parsedString.push_back(currentChar);
+                parsedString[length++] = currentChar;
                 escape = false;
             } else if (currentChar == '\\') {
                 escape = true;
             } else {
-                parsedString.push_back(currentChar);
+                parsedString[length++] = currentChar;
             }
         }
 
@@ -560,11 +1796,11 @@ namespace T76::SCPI {
             return ParameterValue(ParameterType::Invalid); // Unfinished escape sequence
         }
 
-        return ParameterValue(parsedString);
+        return ParameterValue(std::string_view(parsedString, length));
     }
 
     template<typename TargetT>
-    ParameterValue Interpreter<TargetT>::_parseParameter(const ParameterDescriptor &descriptor, const std::string &input) const {
+    ParameterValue Interpreter<TargetT>::_parseParameter(const ParameterDescriptor &descriptor, std::string_view input) {
         switch (descriptor.type) {
             case ParameterType::String:
                 return _parseString(input);
@@ -573,9 +1809,9 @@ namespace T76::SCPI {
                 return _parseNumber(input);
 
             case ParameterType::Boolean:
-                if (strcasecmp(input.c_str(), "true") == 0 || input == "1") {
+                if (_matchesKeyword(input, "true") || input == "1") {
                     return ParameterValue(true);
-                } else if (strcasecmp(input.c_str(), "false") == 0 || input == "0") {
+                } else if (_matchesKeyword(input, "false") || input == "0") {
                     return ParameterValue(false);
                 } else {
                     return ParameterValue(ParameterType::Invalid); // Invalid boolean format
@@ -584,197 +1820,225 @@ namespace T76::SCPI {
             case ParameterType::Enum:
                 // Check if the input matches any of the choices, case-insensitive
                 for (uint8_t i = 0; i < descriptor.choiceCount; ++i) {
-                    if (strcasecmp(input.c_str(), descriptor.choices[i]) == 0) {
-                        return ParameterValue(descriptor.choices[i], true); // Return as enum value
+                    if (_matchesKeyword(input, descriptor.choices[i])) {
+                        ParameterValue value(std::string_view(descriptor.choices[i]), true); // Return as enum value
+                        value.enumIndex = i;
+                        return value;
                     }
                 }
 
                 return ParameterValue(ParameterType::Invalid); // No matching enum value found
 
-            case ParameterType::ArbitraryData:
-                // For ABD, the input string already contains the binary data
-                // Create a ParameterValue with ArbitraryData type
-                {
-                    ParameterValue value(ParameterType::ArbitraryData);
-                    value.stringValue = input; // Binary data stored in stringValue
-                    return value;
+            case ParameterType::ArbitraryData: {
+                // Plain text passed to a block parameter is handed over as-is, as a
+                // view over a copy of the raw parameter, which lives until the command completes
+                const char *copy = _storeString(input);
+
+                if (copy == nullptr) {
+                    return ParameterValue(ParameterType::Invalid);
                 }
 
+                return ParameterValue(reinterpret_cast<const uint8_t*>(copy), input.size());
+            }
+
             default:
                 return ParameterValue(ParameterType::Invalid); // No matching parameter type found
         }
     }
 
     template<typename TargetT>
-    ParameterValue Interpreter<TargetT>::_parseNumber(const std::string &input) const {
-        if (input == "") {
-            return ParameterValue(ParameterType::Invalid);
-        }
-
-        const char *ptr = input.c_str();
-        double value = 0.0;
-        double sign = 1.0;
-        bool hasDigits = false;
+    ParameterValue Interpreter<TargetT>::_parseNumber(std::string_view input) const {
+        // Exact powers of ten; every double up to 1e22 is exactly representable
+        static constexpr double powersOfTen[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+        };
+        static constexpr int maxExactPower = 22;
+
+        // SCPI suffixes, as powers of ten. Parameters are case-folded before they
+        // are parsed, so in practice `M` is always Mega and `m` (milli) is only
+        // reachable by callers that pass unfolded input.
+        static constexpr struct {
+            char suffix;
+            int8_t exponent;
+        } suffixes[] = {
+            {'T', 12}, {'t', 12},   // Tera
+            {'G', 9}, {'g', 9},     // Giga
+            {'M', 6},               // Mega
+            {'K', 3}, {'k', 3},     // Kilo
+            {'m', -3},              // Milli
+            {'U', -6}, {'u', -6},   // Micro
+            {'N', -9}, {'n', -9},   // Nano
+            {'P', -12}, {'p', -12}, // Pico
+            {'F', -15}, {'f', -15}, // Femto
+            {'A', -18}, {'a', -18}, // Atto
+        };
+
+        // Digits beyond this many are dropped, so the mantissa cannot overflow
+        static constexpr uint64_t mantissaLimit = 1000000000000000000ULL;
+
+        const char *ptr = input.data();
+        const char *end = input.data() + input.size();
+
+        auto isDigit = [&](const char *position) {
+            return position < end && *position >= '0' && *position <= '9';
+        };
 
         // Skip leading whitespace
-        while (*ptr == ' ' || *ptr == '\t') {
+        while (ptr < end && (*ptr == ' ' || *ptr == '\t')) {
             ptr++;
         }
 
         // Handle sign
-        if (*ptr == '-') {
-            sign = -1.0;
-            ptr++;
-        } else if (*ptr == '+') {
+        bool negative = false;
+
+        if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+            negative = (*ptr == '-');
             ptr++;
         }
 
-        // Parse integer part
-        while (*ptr >= '0' && *ptr <= '9') {
-            value = value * 10.0 + (*ptr - '0');
+        // Accumulate all digits, before and after the decimal point, into a
+        // 64-bit mantissa; `exponent` is the power of ten it must be scaled by
+        uint64_t mantissa = 0;
+        int exponent = 0;
+        bool hasDigits = false;
+
+        while (isDigit(ptr)) {
+            if (mantissa < mantissaLimit) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*ptr - '0');
+            } else {
+                exponent++;
+            }
+
             hasDigits = true;
             ptr++;
         }
 
-        // Parse decimal part
-        if (*ptr == '.') {
+        bool isInteger = true;
+
+        if (ptr < end && *ptr == '.') {
+            isInteger = false;
             ptr++;
-            double decimal = 0.0;
-            double divisor = 1.0;
-            
-            while (*ptr >= '0' && *ptr <= '9') {
-                decimal = decimal * 10.0 + (*ptr - '0');
-                divisor *= 10.0;
+
+            while (isDigit(ptr)) {
+                if (mantissa < mantissaLimit) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*ptr - '0');
+                    exponent--;
+                }
+
                 hasDigits = true;
                 ptr++;
             }
-            
-            value += decimal / divisor;
+        }
+
+        if (!hasDigits) {
+            return ParameterValue(ParameterType::Invalid); // Invalid format or no digits found
         }
 
         // Handle scientific notation (e.g., 1.23e-4)
-        if (*ptr == 'e' || *ptr == 'E') {
+        if (ptr < end && (*ptr == 'e' || *ptr == 'E')) {
+            isInteger = false;
             ptr++;
-            double expSign = 1.0;
-            double exponent = 0.0;
-            
-            if (*ptr == '-') {
-                expSign = -1.0;
-                ptr++;
-            } else if (*ptr == '+') {
-                ptr++;
-            }
-            
-            bool hasExpDigits = false;
-            while (*ptr >= '0' && *ptr <= '9') {
-                exponent = exponent * 10.0 + (*ptr - '0');
-                hasExpDigits = true;
+
+            bool negativeExponent = false;
+
+            if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+                negativeExponent = (*ptr == '-');
                 ptr++;
             }
-            
-            if (!hasExpDigits) {
+
+            if (!isDigit(ptr)) {
                 return ParameterValue(ParameterType::Invalid); // Invalid scientific notation
             }
-            
-            // Apply exponent (simple power of 10 calculation)
-            exponent *= expSign;
-            while (exponent > 0) {
-                value *= 10.0;
-                exponent--;
-            }
-            while (exponent < 0) {
-                value /= 10.0;
-                exponent++;
+
+            // Anything this large over- or underflows anyway
+            int explicitExponent = 0;
+
+            while (isDigit(ptr)) {
+                if (explicitExponent < 100000) {
+                    explicitExponent = explicitExponent * 10 + (*ptr - '0');
+                }
+
+                ptr++;
             }
+
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
         }
 
         // Handle SCPI suffixes
-        if (*ptr != '\0') {
-            double multiplier = 1.0;
-            
-            switch (*ptr) {
-                case 'T': case 't':  // Tera (10^12)
-                    multiplier = 1e12;
-                    ptr++;
-                    break;
-                case 'G': case 'g':  // Giga (10^9)
-                    multiplier = 1e9;
-                    ptr++;
-                    break;
-                case 'M':            // Mega (10^6) - case sensitive to avoid conflict with milli
-                    multiplier = 1e6;
+        if (ptr < end) {
+            for (const auto &entry : suffixes) {
+                if (entry.suffix == *ptr) {
+                    isInteger = false;
+                    exponent += entry.exponent;
                     ptr++;
                     break;
-                case 'k': case 'K':  // Kilo (10^3)
-                    multiplier = 1e3;
-                    ptr++;
-                    break;
-                case 'm':            // Milli (10^-3) - case sensitive to avoid conflict with Mega
-                    multiplier = 1e-3;
-                    ptr++;
-                    break;
-                case 'u': case 'U':  // Micro (10^-6)
-                    multiplier = 1e-6;
-                    ptr++;
-                    break;
-                case 'n': case 'N':  // Nano (10^-9)
-                    multiplier = 1e-9;
-                    ptr++;
-                    break;
-                case 'p': case 'P':  // Pico (10^-12)
-                    multiplier = 1e-12;
-                    ptr++;
-                    break;
-                case 'f': case 'F':  // Femto (10^-15)
-                    multiplier = 1e-15;
-                    ptr++;
-                    break;
-                case 'a': case 'A':  // Atto (10^-18)
-                    multiplier = 1e-18;
-                    ptr++;
-                    break;
-                default:
-                    // No suffix found, continue with validation
-                    break;
+                }
             }
-            
-            value *= multiplier;
         }
 
         // Skip trailing whitespace
-        while (*ptr == ' ' || *ptr == '\t') {
+        while (ptr < end && (*ptr == ' ' || *ptr == '\t')) {
             ptr++;
         }
 
-        // Check if we've consumed the entire string and found at least one digit
-        if (*ptr != '\0' || !hasDigits) {
-            return ParameterValue(ParameterType::Invalid); // Invalid format or no digits found
+        // Check if we've consumed the entire string
+        if (ptr != end) {
+            return ParameterValue(ParameterType::Invalid);
         }
 
-        return ParameterValue(value * sign); // Return the parsed number as a ParameterValue
+        double value = static_cast<double>(mantissa);
+
+        // Plain integers are converted exactly, up to 2^53; everything else is
+        // scaled once by the combined power of ten of its decimals, exponent and suffix
+        if (!isInteger || exponent != 0) {
+            while (exponent > maxExactPower) {
+                value *= powersOfTen[maxExactPower];
+                exponent -= maxExactPower;
+            }
+
+            while (exponent < -maxExactPower) {
+                value /= powersOfTen[maxExactPower];
+                exponent += maxExactPower;
+            }
+
+            if (exponent > 0) {
+                value *= powersOfTen[exponent];
+            } else if (exponent < 0) {
+                value /= powersOfTen[-exponent];
+            }
+        }
+
+        return ParameterValue(negative ? -value : value); // Return the parsed number as a ParameterValue
     }
 
     template<typename TargetT>
     void Interpreter<TargetT>::_completeABDParameter() {
-        // Ensure we don't exceed maximum parameter count
-        if (_parameters.size() >= _maxParameterCount) {
-            addError(SCPIErrorParameterNotAllowed, "Parameter not allowed");
-            _status = InterpreterStatus::Error;
-            return;
+        if (_abdStreaming) {
+            // The block has been delivered, and its parameter was added when it started
+            _abdStreaming = false;
+        } else {
+            // Ensure we don't exceed maximum parameter count
+            if (_parameterCount >= _maxParameterCount) {
+                addError(SCPIErrorParameterNotAllowed, "Parameter not allowed");
+                _status = InterpreterStatus::Error;
+                return;
+            }
+
+            // Blocks are only accepted by block parameters
+            const ParameterDescriptor *descriptor = _nextParameterDescriptor();
+
+            if (descriptor && descriptor->type != ParameterType::ArbitraryData) {
+                _parameterError = true;
+            }
+
+            // The data stays in the buffer, which never reallocates, until the command completes
+            _parameterValues[_parameterCount++] = ParameterValue(_abdDataBuffer.data() + _abdDataBuffer.size() - _abdExpectedSize, _abdExpectedSize);
         }
 
-        // Create a string from the binary data buffer
-        // Note: std::string can handle binary data including null bytes
-        std::string abdData(reinterpret_cast<const char*>(_abdDataBuffer.data()), _abdDataBuffer.size());
-        
-        // Add the ABD parameter to the parameters vector
-        // We store it as a string for now - the _parseParameter method will handle ArbitraryData type
-        _parameters.push_back(abdData);
-        
         // Reset ABD state for potential next parameter
         _abdSizeLength = 0;
         _abdExpectedSize = 0;
-        _abdDataBuffer.clear();
         _abdBytesRead = 0;
     }
 
@@ -0,0 +1,113 @@
+/**
+ * @file scpi_operations.hpp
+ * @brief Operation-complete tracking for overlapped SCPI commands.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Command handlers normally run to completion before the next command is
+ * parsed. A handler that starts a long operation, such as a sweep, a settle
+ * or a flash write, can instead make it overlapped: it calls begin() before
+ * returning, and whatever finishes the operation calls complete() later, from
+ * any task, interrupt or core. The interpreter then goes on with the next
+ * command while the operation runs.
+ *
+ * The tracker provides the state behind the IEEE 488.2 synchronization
+ * commands:
+ *
+ * - `*OPC` arms the tracker with armOperationComplete(), and the
+ *   `OperationComplete` bit of the event status register is set once no
+ *   operation is pending.
+ * - `*OPC?` and `*WAI` wait until idle() is true, for example with
+ *   `T76::Core::SCPITask::waitForOperations()`, then `*OPC?` responds `1`.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "scpi_status.hpp"
+
+
+namespace T76::SCPI {
+
+    /**
+     * @class OperationTracker
+     * @brief Counts the pending overlapped operations
+     */
+    class OperationTracker {
+    public:
+        /**
+         * @brief Create a tracker that reports completion in an event status register.
+         *
+         * @param eventStatus The register whose `OperationComplete` bit is set by `*OPC`.
+         */
+        explicit OperationTracker(EventStatusRegister &eventStatus) : _eventStatus(eventStatus) {
+        }
+
+        /**
+         * @brief Start an overlapped operation.
+         *
+         * Call this from the handler that starts the operation, before it returns.
+         */
+        void begin() {
+            _pending.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief Finish an overlapped operation.
+         *
+         * Can be called from any task, interrupt or core, once for every call to begin().
+         */
+        void complete() {
+            if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                _signalIfIdle();
+            }
+        }
+
+        /**
+         * @brief Get the number of pending operations.
+         */
+        uint32_t pending() const {
+            return _pending.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Check whether no operation is pending.
+         */
+        bool idle() const {
+            return pending() == 0;
+        }
+
+        /**
+         * @brief Set the `OperationComplete` event once no operation is pending, as `*OPC` does.
+         *
+         * If no operation is pending, the event is set immediately.
+         */
+        void armOperationComplete() {
+            _armed.store(true, std::memory_order_release);
+            _signalIfIdle();
+        }
+
+        /**
+         * @brief Cancel a pending `*OPC`, as `*RST` and `*CLS` do.
+         */
+        void disarm() {
+            _armed.store(false, std::memory_order_release);
+        }
+
+    protected:
+        EventStatusRegister &_eventStatus;      // Register that receives the OperationComplete event
+        std::atomic<uint32_t> _pending{0};      // Number of operations started and not completed
+        std::atomic<bool> _armed{false};        // Whether `*OPC` is waiting for the operations to complete
+
+        void _signalIfIdle() {
+            // Both complete() and armOperationComplete() can get here; only one of them sets the event
+            if (idle() && _armed.exchange(false, std::memory_order_acq_rel)) {
+                _eventStatus.set(StandardEvent::OperationComplete);
+            }
+        }
+
+    }; // class OperationTracker
+
+} // namespace T76::SCPI
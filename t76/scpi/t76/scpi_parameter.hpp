@@ -11,7 +11,8 @@
 
 #pragma once
 
-#include <string>
+#include <string_view>
+#include <cstddef>
 #include <cstdint>
 
 
@@ -42,10 +43,19 @@ namespace T76::SCPI {
      * @brief ParameterValue union
      * 
      * This union represents the value of a parameter, which can be one of several types:
-     * - stringValue: A pointer to a string value.
+     * - stringValue: A view over a string value, or over the matching choice of an enum.
      * - numberValue: A numeric value (double).
      * - booleanValue: A boolean value (true/false).
-     * - enumValue: A pointer to a string representing an enum value.
+     * - enumIndex: For enums, the index of the matching choice, which typed
+     *   handlers receive as a generated enum.
+     * - dataValue, dataLength: For arbitrary data blocks, a view over the
+     *   interpreter's receive buffer that is valid until the handler returns.
+     *   For a block delivered to a chunk handler, dataValue is nullptr and
+     *   dataLength is the total size of the block.
+     * 
+     * Parameter values do not own any memory, so they are trivially copyable.
+     * String views point into the interpreter's parameter storage and, like
+     * block views, are only valid until the handler returns.
      * 
      */
     struct ParameterValue {
@@ -53,56 +63,24 @@ namespace T76::SCPI {
         union {
             double numberValue;
             bool booleanValue;
+            uint8_t enumIndex;
         };
-        std::string stringValue;
+        std::string_view stringValue;
+        const uint8_t *dataValue = nullptr;
+        size_t dataLength = 0;
 
         ParameterValue() : type(ParameterType::Number), numberValue(0) {}
-        ParameterValue(ParameterType type) : type(type), numberValue(0) {
-            if (type == ParameterType::String || type == ParameterType::Enum || type == ParameterType::ArbitraryData) {
-                stringValue = "";
-            }
-        }
+        ParameterValue(ParameterType type) : type(type), numberValue(0) {}
 
-        ParameterValue(const ParameterValue& other)
-            : type(other.type),
-              numberValue(other.numberValue),
-              stringValue(other.stringValue) {}
+        ParameterValue(const uint8_t *data, size_t length)
+            : type(ParameterType::ArbitraryData), numberValue(0), dataValue(data), dataLength(length) {}
 
-        ParameterValue(const std::string str, bool isEnum = false) {
-            numberValue = 0; // Default value for number
-            type = isEnum ? ParameterType::Enum : ParameterType::String;
-            stringValue = std::move(str);
-        }
+        ParameterValue(std::string_view str, bool isEnum = false)
+            : type(isEnum ? ParameterType::Enum : ParameterType::String), numberValue(0), stringValue(str) {}
 
         ParameterValue(double num) : type(ParameterType::Number), numberValue(num) {}
 
         ParameterValue(bool boolean) : type(ParameterType::Boolean), booleanValue(boolean) {}
-
-        ParameterValue& operator=(const ParameterValue& other) {
-            if (this != &other) {
-                type = other.type;
-                numberValue = other.numberValue;
-                stringValue = other.stringValue;
-            }
-            return *this;
-        }
-
-        ParameterValue(ParameterValue&& other) noexcept
-            : type(other.type),
-              numberValue(other.numberValue),
-              stringValue(std::move(other.stringValue)) {}
-
-        ParameterValue& operator=(ParameterValue&& other) noexcept {
-            if (this != &other) {
-                type = other.type;
-                numberValue = other.numberValue;
-                stringValue = std::move(other.stringValue);
-            }
-            
-            return *this;
-        }
-
-        ~ParameterValue() = default;
     };
 
     /**
@@ -131,12 +109,15 @@ namespace T76::SCPI {
      * 
      * - type: The type of the parameter (string, number, boolean, or enum).
      * - defaultValue: The default value for the parameter.
+     * - hasDefault: Whether the parameter is optional, in which case the
+     *   interpreter passes `defaultValue` to the handler when it is omitted.
      * - choiceCount: The number of choices available for enum parameters.
      * - choices: A pointer to an array of choices for enum parameters, if applicable.
      */
     struct ParameterDescriptor {
         ParameterType type;                 // The type of the parameter
         ParameterDescriptorValue defaultValue;        // The value of the parameter
+        bool hasDefault;                    // Whether the parameter can be omitted
         uint8_t choiceCount;                // Number of choices for enum parameters
         const char * const *choices;       // Pointer to array of choices for enum parameters, if applicable
     };
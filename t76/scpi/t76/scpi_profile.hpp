@@ -0,0 +1,230 @@
+/**
+ * @file scpi_profile.hpp
+ * @brief Per-command execution profile of a SCPI session.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * When the interpreter is built with `T76_SCPI_PROFILE` (the CMake option of
+ * the same name), every session keeps, for each command of the table, the
+ * number of times it ran, the CPU cycles spent in its handler, in total and
+ * at most, and the cycles spent parsing it, so that a diagnostic build shows
+ * which commands dominate the time of an instrument in the field.
+ *
+ * Cycles are read from the DWT cycle counter. Parse cycles are the time spent
+ * in processInput() and processInputCharacter() between the end of the
+ * previous command and the start of the handler, including any chunk
+ * handler, or the time spent decoding the parameters of a binary request.
+ * Handler cycles are measured around the call to the handler, and include
+ * any wait for the target lock. Both include the time of interrupts and of
+ * higher priority tasks that preempt the session.
+ *
+ * Without the option, this header is not included and the interpreter keeps
+ * no profile.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <hardware/structs/m33.h>
+
+
+namespace T76::SCPI {
+
+    /**
+     * @brief Profile of a single command
+     */
+    struct CommandProfileEntry {
+        uint32_t calls;             ///< Number of times the handler was called
+        uint32_t maxHandlerCycles;  ///< Longest call of the handler
+        uint64_t handlerCycles;     ///< Cycles spent in the handler, over all calls
+        uint64_t parseCycles;       ///< Cycles spent parsing the command, over all calls
+    };
+
+    /**
+     * @class CommandProfile
+     * @brief Cycle counts of the commands of a session, indexed like the command table
+     */
+    class CommandProfile {
+    public:
+        /**
+         * @brief Keeps the parse clock running while input is processed.
+         *
+         * The interpreter's input entry points can call each other, as
+         * processInput() does processInputCharacter(), so only the outermost
+         * scope starts and stops the clock.
+         */
+        class InputScope {
+        public:
+            explicit InputScope(CommandProfile &profile) : _profile(profile) {
+                if (_profile._inputDepth++ == 0) {
+                    _profile._parseStart = cycles();
+                }
+            }
+
+            ~InputScope() {
+                if (--_profile._inputDepth == 0) {
+                    _profile._parseCycles += cycles() - _profile._parseStart;
+                }
+            }
+
+            InputScope(const InputScope &) = delete;
+            InputScope &operator=(const InputScope &) = delete;
+
+        private:
+            CommandProfile &_profile;
+        };
+
+        /**
+         * @brief Create an empty profile.
+         *
+         * @param names The syntax of every command, as generated by `trie_generator.py --profile`.
+         * @param count The number of commands.
+         */
+        CommandProfile(const char *const *names, size_t count) :
+              _names(names),
+              _count(count),
+              _entries(std::make_unique<CommandProfileEntry[]>(count)) {
+            m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+            m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+        }
+
+        /**
+         * @brief Read the cycle counter.
+         */
+        static inline __attribute__((always_inline)) uint32_t cycles() {
+            return m33_hw->dwt_cyccnt;
+        }
+
+        /**
+         * @brief Stop the parse clock of the current command and start timing its handler.
+         */
+        void beginHandler() {
+            const uint32_t now = cycles();
+
+            if (_inputDepth > 0) {
+                _parseCycles += now - _parseStart;
+            }
+
+            _handlerStart = now;
+        }
+
+        /**
+         * @brief Record the handler that has just returned, and start the parse clock of the next command.
+         *
+         * @param commandIndex The index of the command in the command table.
+         */
+        void endHandler(size_t commandIndex) {
+            const uint32_t now = cycles();
+            const uint32_t handlerCycles = now - _handlerStart;
+            CommandProfileEntry &entry = _entries[commandIndex];
+
+            entry.calls++;
+            entry.handlerCycles += handlerCycles;
+            entry.maxHandlerCycles = std::max(entry.maxHandlerCycles, handlerCycles);
+            entry.parseCycles += _parseCycles;
+
+            _parseCycles = 0;
+            _parseStart = now;
+        }
+
+        /**
+         * @brief Drop the parse cycles of a command whose handler was not called.
+         */
+        void discardParse() {
+            _parseCycles = 0;
+            _parseStart = cycles();
+        }
+
+        /**
+         * @brief Clear the counts of every command.
+         */
+        void reset() {
+            std::fill_n(_entries.get(), _count, CommandProfileEntry{});
+        }
+
+        /**
+         * @brief Get the number of commands in the profile.
+         */
+        size_t size() const {
+            return _count;
+        }
+
+        /**
+         * @brief Get the profile of a command.
+         *
+         * @param commandIndex The index of the command in the command table, which is also its opcode.
+         */
+        const CommandProfileEntry &operator[](size_t commandIndex) const {
+            return _entries[commandIndex];
+        }
+
+        /**
+         * @brief Get the syntax of a command, as written in the YAML file.
+         */
+        const char *name(size_t commandIndex) const {
+            return _names[commandIndex];
+        }
+
+        /**
+         * @brief Format the commands that spent the most cycles in their handlers as a SCPI response.
+         *
+         * Suitable as the response to a `SYSTem:PROFile?` query. Commands that
+         * never ran are left out.
+         *
+         * @param limit The maximum number of commands to report.
+         * @return A group of `"syntax",calls,handlerCycles,maxHandlerCycles,parseCycles`
+         *         per command, in decreasing order of handler cycles.
+         */
+        std::string report(size_t limit) const {
+            std::vector<uint16_t> order;
+
+            for (size_t i = 0; i < _count; i++) {
+                if (_entries[i].calls > 0) {
+                    order.push_back(static_cast<uint16_t>(i));
+                }
+            }
+
+            limit = std::min(limit, order.size());
+
+            std::partial_sort(order.begin(), order.begin() + limit, order.end(), [this](uint16_t a, uint16_t b) {
+                return _entries[a].handlerCycles > _entries[b].handlerCycles;
+            });
+
+            std::string response;
+
+            for (size_t i = 0; i < limit; i++) {
+                const CommandProfileEntry &entry = _entries[order[i]];
+                char buffer[64];
+
+                snprintf(buffer, sizeof(buffer), "\",%lu,%llu,%lu,%llu",
+                         (unsigned long)entry.calls,
+                         (unsigned long long)entry.handlerCycles,
+                         (unsigned long)entry.maxHandlerCycles,
+                         (unsigned long long)entry.parseCycles);
+
+                response += response.empty() ? "\"" : ",\"";
+                response += _names[order[i]];
+                response += buffer;
+            }
+
+            return response;
+        }
+
+    protected:
+        const char *const *_names; // Syntax of every command, in flash.
+        size_t _count; // Number of commands.
+        std::unique_ptr<CommandProfileEntry[]> _entries; // Profile of every command, `_count` long.
+
+        uint32_t _parseStart = 0; // Counter when the parse clock last started.
+        uint32_t _parseCycles = 0; // Parse cycles of the current command so far.
+        uint32_t _handlerStart = 0; // Counter when the running handler was called.
+        uint8_t _inputDepth = 0; // Number of nested input scopes.
+    };
+
+} // namespace T76::SCPI
@@ -0,0 +1,357 @@
+/**
+ * @file scpi_status.hpp
+ * @brief IEEE 488.2 and SCPI status registers for the SCPI interpreter.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The status subsystem reports instrument events to the host through the
+ * status byte (STB):
+ *
+ * - The standard event status register (ESR) latches events, like the
+ *   completion of pending operations or a command error, until the host
+ *   reads it with `*ESR?`. Its bits that are set in the `*ESE` enable mask
+ *   are summarized in the ESB bit of the status byte.
+ * - The `STATus:OPERation` and `STATus:QUEStionable` registers follow
+ *   instrument conditions, such as settling or an overcurrent. Changes of a
+ *   condition bit are latched as events, through the transition filters, and
+ *   the events enabled by `STATus:...:ENABle` are summarized in the OPER and
+ *   QUES bits of the status byte.
+ * - Status byte bits that are set in the `*SRE` enable mask set the master
+ *   summary bit (MSS), which requests service from the host.
+ *
+ * Every register is a single atomic, so conditions and events can be set
+ * with atomic ORs from any task, interrupt or core, without locks. The enable
+ * masks are only evaluated when the status byte is computed, which
+ * `T76::Core::SCPITask` does on core 0 to send an SRQ whenever MSS is set.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+
+namespace T76::SCPI {
+
+    /**
+     * @brief The bits of the standard event status register
+     */
+    enum StandardEvent : uint8_t {
+        OperationComplete   = 0x01,     // All pending operations have completed since `*OPC`
+        RequestControl      = 0x02,     // The device requests control of the bus
+        QueryError          = 0x04,     // A response was lost or requested when none was available
+        DeviceError         = 0x08,     // A device-specific error occurred
+        ExecutionError      = 0x10,     // A command could not be executed
+        CommandError        = 0x20,     // A command could not be parsed
+        UserRequest         = 0x40,     // The user asked for service
+        PowerOn             = 0x80,     // The device was powered on
+    };
+
+    /**
+     * @class EventStatusRegister
+     * @brief The standard event status register
+     */
+    class EventStatusRegister {
+    public:
+        /**
+         * @brief Latch one or more events.
+         *
+         * @param events The `StandardEvent` bits to set.
+         */
+        void set(uint8_t events) {
+            _value.fetch_or(events, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief Read the register without clearing it.
+         */
+        uint8_t value() const {
+            return _value.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Read and clear the register, as `*ESR?` does.
+         */
+        uint8_t take() {
+            return _value.exchange(0, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief Clear the register, as `*CLS` does.
+         */
+        void clear() {
+            _value.store(0, std::memory_order_release);
+        }
+
+    protected:
+        std::atomic<uint8_t> _value{0}; // Latched StandardEvent bits
+
+    }; // class EventStatusRegister
+
+    /**
+     * @brief The bits of the status byte
+     */
+    enum StatusByte : uint8_t {
+        ErrorAvailable      = 0x04,     // The error queue is not empty
+        QuestionableSummary = 0x08,     // An enabled STATus:QUEStionable event is set
+        MessageAvailable    = 0x10,     // A response is waiting to be read
+        EventStatusSummary  = 0x20,     // An enabled standard event is set
+        MasterSummary       = 0x40,     // An enabled status byte bit is set; requests service
+        OperationSummary    = 0x80,     // An enabled STATus:OPERation event is set
+    };
+
+    /**
+     * @class StatusRegister
+     * @brief A SCPI status register, such as `STATus:OPERation` or `STATus:QUEStionable`
+     *
+     * The condition register follows the state of the instrument. Condition
+     * bits that go from 0 to 1 and are set in the positive transition filter,
+     * or go from 1 to 0 and are set in the negative transition filter, latch
+     * the matching bits of the event register, which the host reads and clears
+     * with `STATus:...[:EVENt]?`. Bit 15 is not used, as required by SCPI.
+     */
+    class StatusRegister {
+    public:
+        static constexpr uint16_t ValidBits = 0x7FFF; // Bits that can be set in any of the registers
+
+        /**
+         * @brief Set condition bits, latching the events of those that were clear.
+         *
+         * @param conditions The condition bits to set.
+         */
+        void set(uint16_t conditions) {
+            conditions &= ValidBits;
+
+            const uint16_t previous = _condition.fetch_or(conditions, std::memory_order_acq_rel);
+            const uint16_t rising = conditions & ~previous & _positiveTransitions.load(std::memory_order_relaxed);
+
+            if (rising) {
+                _event.fetch_or(rising, std::memory_order_acq_rel);
+            }
+        }
+
+        /**
+         * @brief Clear condition bits, latching the events of those that were set.
+         *
+         * @param conditions The condition bits to clear.
+         */
+        void clear(uint16_t conditions) {
+            conditions &= ValidBits;
+
+            const uint16_t previous = _condition.fetch_and(static_cast<uint16_t>(~conditions), std::memory_order_acq_rel);
+            const uint16_t falling = conditions & previous & _negativeTransitions.load(std::memory_order_relaxed);
+
+            if (falling) {
+                _event.fetch_or(falling, std::memory_order_acq_rel);
+            }
+        }
+
+        /**
+         * @brief Latch events directly, regardless of the condition register.
+         *
+         * @param events The event bits to set.
+         */
+        void setEvent(uint16_t events) {
+            _event.fetch_or(events & ValidBits, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief Read the condition register, as `STATus:...:CONDition?` does.
+         */
+        uint16_t condition() const {
+            return _condition.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Read the event register without clearing it.
+         */
+        uint16_t event() const {
+            return _event.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Read and clear the event register, as `STATus:...[:EVENt]?` does.
+         */
+        uint16_t takeEvent() {
+            return _event.exchange(0, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief Clear the event register, as `*CLS` does.
+         */
+        void clearEvent() {
+            _event.store(0, std::memory_order_release);
+        }
+
+        /**
+         * @brief Set the enable mask of the summary bit, as `STATus:...:ENABle` does.
+         */
+        void setEnable(uint16_t enable) {
+            _enable.store(enable & ValidBits, std::memory_order_release);
+        }
+
+        /**
+         * @brief Get the enable mask of the summary bit.
+         */
+        uint16_t enable() const {
+            return _enable.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Set the transition filters.
+         *
+         * @param positive Condition bits whose 0 to 1 transitions are latched.
+         * @param negative Condition bits whose 1 to 0 transitions are latched.
+         */
+        void setTransitions(uint16_t positive, uint16_t negative) {
+            _positiveTransitions.store(positive & ValidBits, std::memory_order_relaxed);
+            _negativeTransitions.store(negative & ValidBits, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Check whether an enabled event is set.
+         */
+        bool summary() const {
+            return (event() & enable()) != 0;
+        }
+
+        /**
+         * @brief Restore the enable mask and the transition filters to their defaults, as `STATus:PRESet` does.
+         *
+         * Events are disabled, and only positive transitions are latched.
+         */
+        void preset() {
+            setEnable(0);
+            setTransitions(ValidBits, 0);
+        }
+
+    protected:
+        std::atomic<uint16_t> _condition{0};                        // Current conditions
+        std::atomic<uint16_t> _event{0};                            // Latched events
+        std::atomic<uint16_t> _enable{0};                           // Events summarized in the status byte
+        std::atomic<uint16_t> _positiveTransitions{ValidBits};      // Conditions latched when they are set
+        std::atomic<uint16_t> _negativeTransitions{0};              // Conditions latched when they are cleared
+
+    }; // class StatusRegister
+
+    /**
+     * @class Status
+     * @brief The status registers of an instrument, and the status byte that summarizes them
+     */
+    class Status {
+    public:
+        EventStatusRegister standardEvent;      // The standard event status register, read by *ESR?
+        StatusRegister operation;               // STATus:OPERation
+        StatusRegister questionable;            // STATus:QUEStionable
+
+        /**
+         * @brief Set the standard event enable mask, as `*ESE` does.
+         */
+        void setEventStatusEnable(uint8_t enable) {
+            _eventStatusEnable.store(enable, std::memory_order_release);
+        }
+
+        /**
+         * @brief Get the standard event enable mask, as returned by `*ESE?`.
+         */
+        uint8_t eventStatusEnable() const {
+            return _eventStatusEnable.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Set the service request enable mask, as `*SRE` does; the MSS bit is ignored.
+         */
+        void setServiceRequestEnable(uint8_t enable) {
+            _serviceRequestEnable.store(enable & ~StatusByte::MasterSummary, std::memory_order_release);
+        }
+
+        /**
+         * @brief Get the service request enable mask, as returned by `*SRE?`.
+         */
+        uint8_t serviceRequestEnable() const {
+            return _serviceRequestEnable.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Compute the status byte, as returned by `*STB?`.
+         *
+         * @param errorAvailable Whether the error queue holds an error.
+         * @param messageAvailable Whether a response is waiting to be read.
+         * @return The status byte, with MSS set if any bit enabled by `*SRE` is set.
+         */
+        uint8_t statusByte(bool errorAvailable, bool messageAvailable) const {
+            uint8_t stb = 0;
+
+            if (errorAvailable) {
+                stb |= StatusByte::ErrorAvailable;
+            }
+
+            if (questionable.summary()) {
+                stb |= StatusByte::QuestionableSummary;
+            }
+
+            if (messageAvailable) {
+                stb |= StatusByte::MessageAvailable;
+            }
+
+            if (standardEvent.value() & eventStatusEnable()) {
+                stb |= StatusByte::EventStatusSummary;
+            }
+
+            if (operation.summary()) {
+                stb |= StatusByte::OperationSummary;
+            }
+
+            if (stb & serviceRequestEnable()) {
+                stb |= StatusByte::MasterSummary;
+            }
+
+            return stb;
+        }
+
+        /**
+         * @brief Set the standard event that matches the class of a SCPI error.
+         *
+         * Command errors (-100 to -199), execution errors (-200 to -299),
+         * device-specific errors (-300 to -399, and positive numbers) and
+         * query errors (-400 to -499) each set their bit of the standard
+         * event status register.
+         *
+         * @param errorNumber The number of the error.
+         */
+        void setErrorEvent(int errorNumber) {
+            if (errorNumber <= -100 && errorNumber > -200) {
+                standardEvent.set(StandardEvent::CommandError);
+            } else if (errorNumber <= -200 && errorNumber > -300) {
+                standardEvent.set(StandardEvent::ExecutionError);
+            } else if ((errorNumber <= -300 && errorNumber > -400) || errorNumber > 0) {
+                standardEvent.set(StandardEvent::DeviceError);
+            } else if (errorNumber <= -400 && errorNumber > -500) {
+                standardEvent.set(StandardEvent::QueryError);
+            }
+        }
+
+        /**
+         * @brief Clear every event register, as `*CLS` does; enable masks are kept.
+         */
+        void clear() {
+            standardEvent.clear();
+            operation.clearEvent();
+            questionable.clearEvent();
+        }
+
+        /**
+         * @brief Restore the SCPI status registers to their defaults, as `STATus:PRESet` does.
+         */
+        void preset() {
+            operation.preset();
+            questionable.preset();
+        }
+
+    protected:
+        std::atomic<uint8_t> _eventStatusEnable{0};     // Standard events summarized in ESB
+        std::atomic<uint8_t> _serviceRequestEnable{0};  // Status byte bits that set MSS
+
+    }; // class Status
+
+} // namespace T76::SCPI
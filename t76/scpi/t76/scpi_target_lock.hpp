@@ -0,0 +1,47 @@
+/**
+ * @file scpi_target_lock.hpp
+ * @brief Lock that serializes the handlers of interpreter sessions sharing a target.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * An interpreter instance is a session: it holds its own parse state, error
+ * queue, data format and status registers, while the command trie and the
+ * command table are static and shared by every interpreter of the same
+ * target type. A target can therefore own one interpreter per transport,
+ * for example one fed from USBTMC and one fed from CDC, and each session
+ * parses its own input without disturbing the other.
+ *
+ * Sessions that are fed from different tasks can call into the target at
+ * the same time. If the handlers are not safe to run concurrently, give the
+ * sessions the same TargetLock, which the interpreter holds for as long as a
+ * handler or chunk handler runs. The interface is platform-neutral;
+ * `T76::Core::SCPIMutex` (`<t76/scpi_mutex.hpp>`) implements it with a
+ * FreeRTOS mutex.
+ *
+ */
+
+#pragma once
+
+
+namespace T76::SCPI {
+
+    /**
+     * @class TargetLock
+     * @brief A lock held by an interpreter while it calls into its target
+     */
+    class TargetLock {
+    public:
+        virtual ~TargetLock() = default;
+
+        /**
+         * @brief Acquire the lock, waiting as long as needed.
+         */
+        virtual void lock() = 0;
+
+        /**
+         * @brief Release the lock.
+         */
+        virtual void unlock() = 0;
+
+    }; // class TargetLock
+
+} // namespace T76::SCPI
@@ -4,9 +4,11 @@
  * @copyright Copyright (c) 2025 MTA, Inc.
  * 
  * This file defines the TrieNode structure used in the SCPI interpreter.
- * A trie node represents a single character in a SCPI command and contains
- * information about its children, flags indicating whether it is a terminal
- * or invalid node, and the index of the command it represents.
+ * A trie node represents a single character in a SCPI command, optionally
+ * followed by a segment of characters that chains of single-child nodes have
+ * been collapsed into, and contains information about its children, flags
+ * indicating whether it is a terminal or invalid node, and the index of the
+ * command it represents.
  * 
  */
 
@@ -25,10 +27,18 @@ namespace T76::SCPI {
      * 
      * This enum represents the flags that can be set for a TrieNode.
      * - Terminal: Indicates that this node is a terminal node (i.e., it represents a complete command).
-     * - Invalid: Indicates that this node is a null node (i.e., it does not represent a valid command).
+     * - BinarySearch: The children are looked up by binary search instead of a linear scan.
+     * - Dense: The children are a jump table indexed by character, starting at the
+     *   character of the first child. Gaps are filled with null nodes whose character
+     *   is '\0'.
+     *
+     * The lookup flags are chosen per node by trie_generator.py; children are always
+     * sorted by character.
      */
     enum class TrieNodeFlags : uint8_t {
         Terminal = 0x01,                            // Indicates that this node is a terminal node
+        BinarySearch = 0x02,                        // Children are found by binary search
+        Dense = 0x04,                               // Children are indexed directly by character
     };
 
     /**
@@ -38,16 +48,30 @@ namespace T76::SCPI {
      * Each node contains:
      * - character: The character represented by this node.
      * - flags: Flags indicating whether this node is terminal or invalid.
-     * - childCount: The number of children this node has.
-     * - children: A pointer to an array of child nodes.
+     * - childCount: The number of entries in the children array, including any
+     *   null nodes that fill the gaps of a dense node.
+     * - segmentLength: The number of characters that must follow `character`
+     *   before any child can be matched, or 0 if the node is not compressed.
+     * - children: A pointer to an array of child nodes, sorted by character.
+     * - segmentOffset: The offset of the segment in the interpreter's
+     *   `_trieSegments` pool.
      * - commandIndex: The index of the command this node represents (if any).
+     *
+     * A compressed node is only terminal after its whole segment has been matched.
+     *
+     * commandIndex is 16 bits wide so that an interpreter can have up to 65535
+     * commands; it occupies what would otherwise be padding, so the node is the
+     * same 12 bytes as with an 8-bit index. childCount stays 8 bits, since a node
+     * can have at most one child per character.
      */
     struct TrieNode {
         const uint8_t character;                    // The character represented by this node
         const uint8_t flags;                        // Flags indicating whether this node is terminal or invalid
         const uint8_t childCount = 0;               // The number of children this node has
+        const uint8_t segmentLength = 0;            // The number of characters in this node's segment
         const TrieNode *children;                   // Pointer to an array of child nodes
-        const uint8_t commandIndex = 0;             // The index of the command this node represents (if any)
+        const uint16_t segmentOffset = 0;           // Offset of this node's segment in the segment pool
+        const uint16_t commandIndex = 0;            // The index of the command this node represents (if any)
 
         bool terminal();                            // Check if this node is a terminal node (i.e., it represents a complete command)
 
@@ -6,7 +6,6 @@
  */
 
 #include "concrete_interpreter.hpp"
-#include "stream_local.hpp"
 #include "test_command.hpp"
 #include <iostream>
 #include <string>
@@ -43,10 +42,10 @@ int main() {
         std::cout << "\n--- Testing ABD Error Conditions ---" << std::endl;
         
         // Test 6: Invalid size length digit (0)
-        test_command("TEST:ABD:SIMPLE #0", "", "103");
+        test_command("TEST:ABD:SIMPLE #0", "", "-161");
         
         // Test 7: Invalid size length digit (non-numeric)
-        test_command("TEST:ABD:SIMPLE #A15HELLO", "", "103");
+        test_command("TEST:ABD:SIMPLE #A15HELLO", "", "-161");
         
         std::cout << "\n--- Testing ABD Edge Cases ---" << std::endl;
         
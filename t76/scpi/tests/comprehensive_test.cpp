@@ -6,7 +6,6 @@
  */
 
 #include "concrete_interpreter.hpp"
-#include "stream_local.hpp"
 #include "test_command.hpp" // Include the extracted test_command header
 #include <iostream>
 #include <cstring> // For strncpy
@@ -33,7 +32,7 @@ int main() {
         test_command("TEST:ABD:SIMPLE #14TEST", "TEST:ABD:SIMPLE executed with ABD data: size=4 bytes");
         
         // Test commands with multiple parameters
-        test_command("TEST:MULTI:TWO 123 \"test_string\"", "TEST:MULTI:TWO executed with first: 123.000000, second: test_string");
+        test_command("TEST:MULTI:TWO 123 \"test_string\"", "TEST:MULTI:TWO executed with first: 123.000000, second: TEST_STRING");
         
         // Test numeric variations
         test_command("TEST:NUMERIC:INTEGER 42", "TEST:NUMERIC:INTEGER executed with value:");
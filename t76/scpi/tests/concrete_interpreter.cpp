@@ -14,66 +14,36 @@
 using namespace T76::SCPI;
 
 
-// Helper method to format parameters for output
-std::string ConcreteInterpreter::_formatParameters(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
-    if (params.empty()) {
-        return "NO_PARAMS";
-    }
-    
-    std::ostringstream oss;
-    for (size_t i = 0; i < params.size(); ++i) {
-        if (i > 0) {
-            oss << ",";
-        }
-        // Note: For testing purposes, we'll assume parameter types based on context
-        // In a real implementation, we'd need to track parameter types
-        oss << "PARAM" << i;
-    }
-    return oss.str();
-}
+namespace {
 
-std::string ConcreteInterpreter::_formatParameter(const ParameterValue &param, ParameterType type) {
-    std::ostringstream oss;
-    
-    switch (type) {
-        case ParameterType::String:
-        case ParameterType::Enum:
-            oss << "\"" << param.stringValue << "\"";
-            break;
-        case ParameterType::Number:
-            oss << std::fixed << std::setprecision(6) << param.numberValue;
-            break;
-        case ParameterType::Boolean:
-            oss << (param.booleanValue ? "TRUE" : "FALSE");
-            break;
-        default:
-            oss << "UNKNOWN";
-            break;
+    // Sends a response over the session whose handler is running
+    void respond(const std::string &response) {
+        Interpreter<ConcreteInterpreter>::current()->sendResponse(response);
     }
-    
-    return oss.str();
-}
+
+} // namespace
+
 
 // Basic test commands
-void ConcreteInterpreter::_testSimple(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
-    interpreter.outputStream.write("TEST:SIMPLE executed\n");
+void ConcreteInterpreter::_testSimple(Parameters) {
+    respond("TEST:SIMPLE executed\n");
 }
 
-void ConcreteInterpreter::_queryTestSimple(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
-    interpreter.outputStream.write("SIMPLE_QUERY_RESPONSE\n");
+void ConcreteInterpreter::_queryTestSimple(Parameters) {
+    respond("SIMPLE_QUERY_RESPONSE\n");
 }
 
-void ConcreteInterpreter::_testMixedCase(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
-    interpreter.outputStream.write("TEST:COMmand:OPTional:SYNtax executed\n");
+void ConcreteInterpreter::_testMixedCase(Parameters) {
+    respond("TEST:COMmand:OPTional:SYNtax executed\n");
 }
 
 // ABD test commands
-void ConcreteInterpreter::_testABDSimple(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testABDSimple(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:ABD:SIMPLE executed with ABD data: ";
     
     if (!params.empty() && params[0].type == ParameterType::ArbitraryData) {
-        const std::string& abdData = params[0].stringValue;
+        const std::string_view abdData(reinterpret_cast<const char *>(params[0].dataValue), params[0].dataLength);
         oss << "size=" << abdData.size() << " bytes, ";
         
         // Display first 8 bytes as hex for debugging
@@ -103,11 +73,11 @@ void ConcreteInterpreter::_testABDSimple(const std::vector<ParameterValue> &para
     }
     
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
 // Commands with single parameters
-void ConcreteInterpreter::_testNumber(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testNumber(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:NUMBER executed with value: ";
     if (!params.empty()) {
@@ -116,10 +86,10 @@ void ConcreteInterpreter::_testNumber(const std::vector<ParameterValue> &params,
         oss << "NO_PARAM";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
-void ConcreteInterpreter::_testString(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testString(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:STRING executed with text: ";
     if (!params.empty()) {
@@ -128,10 +98,10 @@ void ConcreteInterpreter::_testString(const std::vector<ParameterValue> &params,
         oss << "NO_PARAM";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
-void ConcreteInterpreter::_testBoolean(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testBoolean(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:BOOLEAN executed with state: ";
     if (!params.empty()) {
@@ -140,10 +110,10 @@ void ConcreteInterpreter::_testBoolean(const std::vector<ParameterValue> &params
         oss << "NO_PARAM";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
-void ConcreteInterpreter::_testEnum(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testEnum(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:ENUM executed with option: ";
     if (!params.empty()) {
@@ -152,11 +122,11 @@ void ConcreteInterpreter::_testEnum(const std::vector<ParameterValue> &params, I
         oss << "NO_PARAM";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
 // Commands with multiple parameters
-void ConcreteInterpreter::_testMultiTwo(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testMultiTwo(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:MULTI:TWO executed with ";
     if (params.size() >= 2) {
@@ -166,11 +136,11 @@ void ConcreteInterpreter::_testMultiTwo(const std::vector<ParameterValue> &param
         oss << "insufficient parameters (" << params.size() << "/2)";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
 // Commands with optional parameters
-void ConcreteInterpreter::_testOptionalSingle(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testOptionalSingle(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:OPTIONAL:SINGLE executed with ";
     if (params.size() >= 1) {
@@ -184,10 +154,10 @@ void ConcreteInterpreter::_testOptionalSingle(const std::vector<ParameterValue>
         oss << "missing required parameter";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
-void ConcreteInterpreter::_testOptionalMultiple(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testOptionalMultiple(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:OPTIONAL:MULTIPLE executed with ";
     if (params.size() >= 1) {
@@ -208,11 +178,11 @@ void ConcreteInterpreter::_testOptionalMultiple(const std::vector<ParameterValue
         oss << "missing required parameter";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
 // Numeric parameter variations
-void ConcreteInterpreter::_testInteger(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testInteger(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:NUMERIC:INTEGER executed with value: ";
     if (!params.empty()) {
@@ -221,10 +191,10 @@ void ConcreteInterpreter::_testInteger(const std::vector<ParameterValue> &params
         oss << "NO_PARAM";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
-void ConcreteInterpreter::_testFloat(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testFloat(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:NUMERIC:FLOAT executed with value: ";
     if (!params.empty()) {
@@ -233,10 +203,10 @@ void ConcreteInterpreter::_testFloat(const std::vector<ParameterValue> &params,
         oss << "NO_PARAM";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
-void ConcreteInterpreter::_testRange(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testRange(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:NUMERIC:RANGE executed with ";
     if (params.size() >= 2) {
@@ -246,11 +216,11 @@ void ConcreteInterpreter::_testRange(const std::vector<ParameterValue> &params,
         oss << "insufficient parameters (" << params.size() << "/2)";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
 // String parameter variations
-void ConcreteInterpreter::_testQuotedString(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testQuotedString(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:STRING:QUOTED executed with text: ";
     if (!params.empty()) {
@@ -259,11 +229,11 @@ void ConcreteInterpreter::_testQuotedString(const std::vector<ParameterValue> &p
         oss << "NO_PARAM";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
 // Enum parameter variations
-void ConcreteInterpreter::_testEnumMixed(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testEnumMixed(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:ENUM:MIXED executed with option: ";
     if (!params.empty()) {
@@ -272,10 +242,10 @@ void ConcreteInterpreter::_testEnumMixed(const std::vector<ParameterValue> &para
         oss << "NO_PARAM";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
-void ConcreteInterpreter::_testEnumNumeric(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testEnumNumeric(Parameters params) {
     std::ostringstream oss;
     oss << "TEST:ENUM:NUMERIC executed with option: ";
     if (!params.empty()) {
@@ -284,11 +254,11 @@ void ConcreteInterpreter::_testEnumNumeric(const std::vector<ParameterValue> &pa
         oss << "NO_PARAM";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
 // Query commands with parameters
-void ConcreteInterpreter::_queryTestParam(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_queryTestParam(Parameters params) {
     std::ostringstream oss;
     oss << "QUERY_PARAM_RESPONSE:";
     if (!params.empty()) {
@@ -297,10 +267,10 @@ void ConcreteInterpreter::_queryTestParam(const std::vector<ParameterValue> &par
         oss << "NO_CHANNEL";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
-void ConcreteInterpreter::_queryTestMulti(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_queryTestMulti(Parameters params) {
     std::ostringstream oss;
     oss << "QUERY_MULTI_RESPONSE:";
     if (params.size() >= 2) {
@@ -310,11 +280,11 @@ void ConcreteInterpreter::_queryTestMulti(const std::vector<ParameterValue> &par
         oss << "INSUFFICIENT_PARAMS";
     }
     oss << "\n";
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
 // Error handling test commands
-void ConcreteInterpreter::_testErrorSimulate(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
+void ConcreteInterpreter::_testErrorSimulate(Parameters params) {
     std::ostringstream oss;
     if (!params.empty()) {
         int errorCode = static_cast<int>(params[0].numberValue);
@@ -322,20 +292,34 @@ void ConcreteInterpreter::_testErrorSimulate(const std::vector<ParameterValue> &
     } else {
         oss << "ERROR 102: No error code provided\n";
     }
-    interpreter.outputStream.write(oss.str().c_str());
+    respond(oss.str());
 }
 
-void ConcreteInterpreter::_testErrorInvalid(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
-    interpreter.outputStream.write("ERROR 200: Invalid operation executed\n");
+void ConcreteInterpreter::_testErrorInvalid(Parameters) {
+    respond("ERROR 200: Invalid operation executed\n");
 }
 
 // System error query command
 
-void ConcreteInterpreter::_querySystemError(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter) {
-    if (!interpreter.errorQueue.empty()) {
-        interpreter.outputStream.write(interpreter.errorQueue.front());
-        interpreter.errorQueue.pop();
-    } else {
-        interpreter.outputStream.write("0,\"NO ERROR\"\n");
-    }
+void ConcreteInterpreter::_querySystemError(Parameters) {
+    respond(Interpreter<ConcreteInterpreter>::current()->nextError() + "\n");
+}
+
+// Overlapped operations and their synchronization
+
+void ConcreteInterpreter::_testOverlap(Parameters) {
+    Interpreter<ConcreteInterpreter>::current()->operations.begin();
+    respond("TEST:OVERLAP started\n");
+}
+
+void ConcreteInterpreter::_clearStatus(Parameters) {
+    Interpreter<ConcreteInterpreter>::current()->clearStatus();
+}
+
+void ConcreteInterpreter::_queryEventStatus(Parameters) {
+    respond(std::to_string(Interpreter<ConcreteInterpreter>::current()->status.standardEvent.take()) + "\n");
+}
+
+void ConcreteInterpreter::_setOperationComplete(Parameters) {
+    Interpreter<ConcreteInterpreter>::current()->operations.armOperationComplete();
 }
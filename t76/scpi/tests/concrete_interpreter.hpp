@@ -7,67 +7,64 @@
 
 #pragma once
 
-#include "../interpreter.hpp"
-#include "test_instantiations.hpp"
-#include <sstream>
+#include <t76/scpi_interpreter.hpp>
 
 
 namespace T76::SCPI {
 
     class ConcreteInterpreter {
     public:
-        // Test command handlers referenced in commands.cpp
+        // Test command handlers referenced by the command table generated from commands.yaml
         
         // Basic test commands
-        void _testSimple(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _queryTestSimple(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _testMixedCase(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _testSimple(Parameters params);
+        void _queryTestSimple(Parameters params);
+        void _testMixedCase(Parameters params);
         
         // ABD test commands
-        void _testABDSimple(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _testABDSimple(Parameters params);
         
         // Commands with single parameters
-        void _testNumber(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _testString(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _testBoolean(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _testEnum(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _testNumber(Parameters params);
+        void _testString(Parameters params);
+        void _testBoolean(Parameters params);
+        void _testEnum(Parameters params);
         
         // Commands with multiple parameters
-        void _testMultiTwo(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _testMultiTwo(Parameters params);
         
         // Commands with optional parameters
-        void _testOptionalSingle(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _testOptionalMultiple(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _testOptionalSingle(Parameters params);
+        void _testOptionalMultiple(Parameters params);
         
         // Numeric parameter variations
-        void _testInteger(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _testFloat(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _testRange(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _testInteger(Parameters params);
+        void _testFloat(Parameters params);
+        void _testRange(Parameters params);
         
         // String parameter variations
-        void _testQuotedString(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _testQuotedString(Parameters params);
         
         // Enum parameter variations
-        void _testEnumMixed(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _testEnumNumeric(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _testEnumMixed(Parameters params);
+        void _testEnumNumeric(Parameters params);
         
         // Query commands with parameters
-        void _queryTestParam(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _queryTestMulti(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _queryTestParam(Parameters params);
+        void _queryTestMulti(Parameters params);
         
         // Error handling test commands
-        void _testErrorSimulate(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        void _testErrorInvalid(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _testErrorSimulate(Parameters params);
+        void _testErrorInvalid(Parameters params);
 
         // System error query command
-        void _querySystemError(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
+        void _querySystemError(Parameters params);
 
-    private:
-        // Helper method to format parameters for output
-        std::string _formatParameters(const std::vector<ParameterValue> &params, Interpreter<ConcreteInterpreter> &interpreter);
-        
-        // Helper method to format a single parameter
-        std::string _formatParameter(const ParameterValue &param, ParameterType type);
+        // Overlapped operations and their synchronization
+        void _testOverlap(Parameters params);
+        void _clearStatus(Parameters params);
+        void _queryEventStatus(Parameters params);
+        void _setOperationComplete(Parameters params);
     };
 
 } // namespace T76::SCPI
@@ -0,0 +1,138 @@
+/**
+ * @file opc_test.cpp
+ * @brief Test of the sequencing of overlapped commands with *OPC.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Overlapped operations are started by TEST:OVERLAP and completed by the
+ * test, either directly or from other threads, as a timer or the other core
+ * would complete them on the device.
+ *
+ */
+
+#include "concrete_interpreter.hpp"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief An interpreter that keeps its state across the messages it is fed.
+     */
+    struct Session {
+        T76::SCPI::ConcreteInterpreter target;
+        T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter{target};
+        std::string output;
+
+        Session() {
+            interpreter.setResponseWriter(appendResponse, &output);
+        }
+
+        // Feeds a message and returns the responses it produced
+        std::string send(const std::string &message) {
+            output.clear();
+            interpreter.processInput(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+            return output;
+        }
+
+        static bool appendResponse(void *context, std::string_view response) {
+            static_cast<std::string*>(context)->append(response);
+            return true;
+        }
+    };
+
+    void check(const char *name, const std::string &actual, const std::string &expected) {
+        if (actual == expected) {
+            std::cout << "✓ " << name << std::endl;
+        } else {
+            std::cout << "✗ " << name << " (expected '" << expected << "', got '" << actual << "')" << std::endl;
+        }
+    }
+
+} // namespace
+
+int main() {
+    std::cout << "=== SCPI OPC Sequencing Test ===" << std::endl;
+
+    {
+        Session session;
+
+        // With nothing pending, *OPC sets the bit at once, and *ESR? clears it
+        check("*OPC when idle", session.send("*OPC\n*ESR?\n"), "1\n");
+        check("*ESR? clears the event", session.send("*ESR?\n"), "0\n");
+    }
+
+    {
+        Session session;
+
+        // The commands after an overlapped one run while it is pending
+        check("Commands run while operations are pending",
+              session.send("TEST:OVERLAP\nTEST:OVERLAP\n*OPC\nTEST:SIMPLE\n*ESR?\n"),
+              "TEST:OVERLAP started\nTEST:OVERLAP started\nTEST:SIMPLE executed\n0\n");
+
+        session.interpreter.operations.complete();
+        check("Not complete with one operation pending", session.send("*ESR?\n"), "0\n");
+
+        session.interpreter.operations.complete();
+        check("Complete once the last operation completes", session.send("*ESR?\n"), "1\n");
+
+        // The event is set once per *OPC
+        session.send("TEST:OVERLAP\n");
+        session.interpreter.operations.complete();
+        check("Not set again without *OPC", session.send("*ESR?\n"), "0\n");
+    }
+
+    {
+        Session session;
+
+        // An operation started after *OPC delays the event like the earlier ones
+        session.send("TEST:OVERLAP\n*OPC\nTEST:OVERLAP\n");
+        session.interpreter.operations.complete();
+        check("Not complete with a later operation pending", session.send("*ESR?\n"), "0\n");
+
+        session.interpreter.operations.complete();
+        check("Complete after the later operation", session.send("*ESR?\n"), "1\n");
+    }
+
+    {
+        Session session;
+
+        // *CLS cancels a pending *OPC
+        session.send("TEST:OVERLAP\n*OPC\n*CLS\n");
+        session.interpreter.operations.complete();
+        check("*CLS cancels *OPC", session.send("*ESR?\n"), "0\n");
+    }
+
+    {
+        Session session;
+
+        // Operations that complete concurrently set the event exactly once, after the last one
+        const int operations = 64;
+        std::string message;
+
+        for (int i = 0; i < operations; i++) {
+            message += "TEST:OVERLAP\n";
+        }
+
+        session.send(message + "*OPC\n");
+
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < operations; i++) {
+            threads.emplace_back([&session]() {
+                session.interpreter.operations.complete();
+            });
+        }
+
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+
+        check("Concurrent completions leave nothing pending", std::to_string(session.interpreter.operations.pending()), "0");
+        check("Concurrent completions set the event", session.send("*ESR?\n"), "1\n");
+    }
+
+    std::cout << "\n=== OPC Test Complete ===" << std::endl;
+    return 0;
+}
@@ -6,17 +6,14 @@
  */
 
 #include "concrete_interpreter.hpp"
-#include "stream_local.hpp"
 #include "test_command.hpp"
 #include <iostream>
 #include <sstream>
 
 void test_parameter_count_limit() {
-    T76::SCPI::TestInputStream input("TEST:MULTI:TWO 123 \"test_string\"\n");
-    T76::SCPI::TestOutputStream output;
     T76::SCPI::ConcreteInterpreter target;
 
-    T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(input, output, target);
+    T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(target);
 
 
     std::cout << "\n=== Testing Parameter Count Limit ===" << std::endl;
@@ -35,7 +32,7 @@ void test_parameter_count_limit() {
         for (size_t i = 0; i <= interpreter.maxParameterCount(); ++i) {
             excessive_params += " \"param" + std::to_string(i) + "\"";
         }
-        test_command(excessive_params.c_str(), "", "100,\"Too many parameters\"");
+        test_command(excessive_params.c_str(), "", "-108,\"Parameter not allowed\"");
     }
 
     // Test 3: Command with exactly the maximum number of parameters
@@ -10,11 +10,11 @@ int main() {
     
     // Test with incorrect parameter count (1)
     std::cout << "\nTest 2: Incorrect parameter count (1)" << std::endl;
-    test_command("TEST:SIMPLE param1", "", "102");  // Expecting some error code
+    test_command("TEST:SIMPLE param1", "", "-108");  // Parameter not allowed
     
     // Test with incorrect parameter count (2)
     std::cout << "\nTest 3: Incorrect parameter count (2)" << std::endl;
-    test_command("TEST:SIMPLE param1 param2", "", "102");  // Expecting some error code
+    test_command("TEST:SIMPLE param1 param2", "", "-108");  // Parameter not allowed
     
     return 0;
 }
@@ -0,0 +1,358 @@
+/**
+ * @file scpi_bench.cpp
+ * @brief Host-side benchmark of the SCPI parser.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Feeds workloads of short commands, deep headers, numeric-heavy commands
+ * and arbitrary data blocks to an interpreter, in packets the size of a
+ * USBTMC transfer, and reports for each workload the commands and bytes
+ * parsed per second, the time and, on x86, the TSC cycles per byte, and the
+ * heap allocations per command, counted by replacing the global `operator new`.
+ *
+ * The results are written as a single JSON document, so that runs before
+ * and after a parser change can be compared by a script:
+ *
+ *     scpi_bench [--min-time <seconds>] [--packet <bytes>] [--filter <name>] [-o <file>]
+ *
+ * The benchmark exits with a non-zero status if a workload reports an
+ * error or does not reach its handlers, so that a broken parser is not
+ * mistaken for a fast one.
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SCPI_BENCH_HAS_TSC 1
+#else
+#define SCPI_BENCH_HAS_TSC 0
+#endif
+
+#include <t76/scpi_interpreter.hpp>
+
+
+// Allocation counting
+
+namespace {
+    std::atomic<uint64_t> allocationCount{0};
+}
+
+void *operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (void *pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+
+namespace T76::SCPI {
+
+    /**
+     * @brief Handlers of the benchmark commands, which only count their calls
+     */
+    class BenchTarget {
+    public:
+        uint64_t calls = 0;             // Handler calls, including chunk handlers
+        double sum = 0;                 // Keeps the parameters observable
+        uint64_t responses = 0;         // Constant responses written
+
+        void _short(Parameters params);
+        void _number(Parameters params);
+        void _numbers(Parameters params);
+        void _block(Parameters params);
+        void _blockChunk(Parameters params, const ABDChunk &chunk);
+
+        static bool writeResponse(void *context, std::string_view) {
+            static_cast<BenchTarget*>(context)->responses++;
+            return true;
+        }
+    };
+
+    // The handlers are defined out of line, because the generated command table takes their addresses
+
+    void BenchTarget::_short(Parameters) {
+        calls++;
+    }
+
+    void BenchTarget::_number(Parameters params) {
+        calls++;
+        sum += params[0].numberValue;
+    }
+
+    void BenchTarget::_numbers(Parameters params) {
+        calls++;
+
+        for (const ParameterValue &value : params) {
+            sum += value.numberValue;
+        }
+    }
+
+    void BenchTarget::_block(Parameters params) {
+        calls++;
+        sum += static_cast<double>(params[0].dataLength);
+    }
+
+    void BenchTarget::_blockChunk(Parameters, const ABDChunk &chunk) {
+        sum += static_cast<double>(chunk.length);
+    }
+
+} // namespace T76::SCPI
+
+
+namespace {
+
+    using T76::SCPI::BenchTarget;
+    using T76::SCPI::Interpreter;
+
+    /**
+     * @brief A workload: a program message repeated for as long as the benchmark runs
+     */
+    struct Workload {
+        const char *name;               // Name reported in the results
+        std::string message;            // One or more commands, each ending with a newline
+        size_t commands;                // Number of commands in the message
+        size_t calls;                   // Handler calls per message, to check that the commands ran
+        size_t responses;               // Constant responses per message
+    };
+
+    struct Result {
+        const char *name;
+        uint64_t commands;
+        uint64_t bytes;
+        double seconds;
+        uint64_t cycles;
+        uint64_t allocations;
+    };
+
+    uint64_t readCycles() {
+#if SCPI_BENCH_HAS_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    std::string repeat(const std::string &command, size_t count) {
+        std::string message;
+
+        for (size_t i = 0; i < count; i++) {
+            message += command;
+        }
+
+        return message;
+    }
+
+    std::string block(size_t size) {
+        const std::string digits = std::to_string(size);
+        std::string data(size, '\0');
+
+        for (size_t i = 0; i < size; i++) {
+            data[i] = static_cast<char>(i * 31 + 7); // Includes newlines and quotation marks
+        }
+
+        return "#" + std::to_string(digits.size()) + digits + data;
+    }
+
+    std::vector<Workload> workloads() {
+        std::vector<Workload> list;
+
+        list.push_back({"short", repeat("*CLS\n*OPC?\n", 32), 64, 64, 0});
+        list.push_back({"constant", repeat("*IDN?\n", 64), 64, 0, 64});
+        list.push_back({"deep-short", repeat("SOUR1:VOLT:LEV:IMM:AMPL?\n", 32), 32, 32, 0});
+        list.push_back({"deep-long", repeat("SOURCE1:VOLTAGE:LEVEL:IMMEDIATE:AMPLITUDE?\n", 32), 32, 32, 0});
+        list.push_back({"deep-number", repeat("SOURce1:VOLTage:LEVel:IMMediate:AMPLitude 1.25\n", 32), 32, 32, 0});
+        list.push_back({"compound", repeat("SOUR1:VOLT:LEV:IMM:AMPL 1;:SOUR1:CURR:LEV:IMM:AMPL 0.5;*OPC?\n", 16), 48, 48, 0});
+        list.push_back({"numeric", repeat("CONF:SWE 1.25e-3,2.5,-3.75E+2,42,0.001,1e6\n", 32), 32, 32, 0});
+        list.push_back({"numeric-suffix", repeat("CONF:SWE 10m,1.5k,-2u,3M,0.5,100\n", 32), 32, 32, 0});
+        list.push_back({"block-1k", "DATA:BLOC " + block(1024) + "\n", 1, 1, 0});
+        list.push_back({"block-16k", "DATA:BLOC " + block(16384) + "\n", 1, 1, 0});
+        list.push_back({"stream-64k", "DATA:STR " + block(65536) + "\n", 1, 1, 0});
+
+        return list;
+    }
+
+    /**
+     * @brief Run a workload until it has run for at least minSeconds.
+     *
+     * @return The totals, or a result with no commands if the workload failed.
+     */
+    Result run(const Workload &workload, size_t packetSize, double minSeconds) {
+        BenchTarget target;
+        Interpreter<BenchTarget> interpreter(target, 16384 + 16);
+        interpreter.setResponseWriter(BenchTarget::writeResponse, &target);
+
+        const uint8_t *data = reinterpret_cast<const uint8_t*>(workload.message.data());
+        const size_t length = workload.message.size();
+
+        const auto feed = [&]() {
+            for (size_t offset = 0; offset < length; offset += packetSize) {
+                interpreter.processInput(data + offset, std::min(packetSize, length - offset));
+            }
+        };
+
+        // Warm up the caches, and check that the workload is parsed as intended
+        feed();
+
+        if (!interpreter.errorQueue.empty() || target.calls != workload.calls || target.responses != workload.responses) {
+            fprintf(stderr, "%s: %s, %llu of %zu handler calls\n", workload.name,
+                    interpreter.nextError().c_str(), static_cast<unsigned long long>(target.calls), workload.calls);
+            return {workload.name, 0, 0, 0, 0, 0};
+        }
+
+        uint64_t iterations = 0;
+        uint64_t cycles = 0;
+        const uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        const auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+
+        // The clock is only read every few iterations, so that it does not dominate short workloads
+        do {
+            const uint64_t cyclesBefore = readCycles();
+
+            for (int i = 0; i < 16; i++) {
+                feed();
+            }
+
+            cycles += readCycles() - cyclesBefore;
+            iterations += 16;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < minSeconds);
+
+        const uint64_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+        if (!interpreter.errorQueue.empty()) {
+            fprintf(stderr, "%s: %s\n", workload.name, interpreter.nextError().c_str());
+            return {workload.name, 0, 0, 0, 0, 0};
+        }
+
+        return {workload.name, iterations * workload.commands, iterations * length, elapsed, cycles, allocations};
+    }
+
+    void usage(const char *program) {
+        fprintf(stderr, "Usage: %s [--min-time <seconds>] [--packet <bytes>] [--filter <name>] [-o <file>]\n", program);
+    }
+
+} // namespace
+
+
+int main(int argc, char **argv) {
+    double minSeconds = 0.2;
+    size_t packetSize = 64;
+    const char *filter = nullptr;
+    const char *outputPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+
+        if (strcmp(argv[i], "--min-time") == 0 && hasValue) {
+            minSeconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--packet") == 0 && hasValue) {
+            packetSize = static_cast<size_t>(atol(argv[++i]));
+        } else if (strcmp(argv[i], "--filter") == 0 && hasValue) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (packetSize == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE *output = outputPath ? fopen(outputPath, "w") : stdout;
+
+    if (!output) {
+        perror(outputPath);
+        return 2;
+    }
+
+    bool failed = false;
+    bool first = true;
+
+    fprintf(output, "{\n  \"benchmark\": \"scpi_bench\",\n  \"packet_size\": %zu,\n  \"tsc\": %s,\n  \"results\": [",
+            packetSize, SCPI_BENCH_HAS_TSC ? "true" : "false");
+
+    for (const Workload &workload : workloads()) {
+        if (filter && !strstr(workload.name, filter)) {
+            continue;
+        }
+
+        const Result result = run(workload, packetSize, minSeconds);
+
+        if (result.commands == 0) {
+            failed = true;
+            continue;
+        }
+
+        const double bytes = static_cast<double>(result.bytes);
+        const double commands = static_cast<double>(result.commands);
+
+        fprintf(output, "%s\n    {\"name\": \"%s\", \"commands\": %llu, \"bytes\": %llu, \"seconds\": %.6f, "
+                        "\"commands_per_s\": %.0f, \"mb_per_s\": %.3f, \"ns_per_command\": %.2f, \"ns_per_byte\": %.3f, ",
+                first ? "" : ",", result.name,
+                static_cast<unsigned long long>(result.commands), static_cast<unsigned long long>(result.bytes),
+                result.seconds, commands / result.seconds, bytes / result.seconds / 1e6,
+                result.seconds * 1e9 / commands, result.seconds * 1e9 / bytes);
+
+        if (SCPI_BENCH_HAS_TSC) {
+            fprintf(output, "\"cycles_per_byte\": %.3f, ", static_cast<double>(result.cycles) / bytes);
+        } else {
+            fprintf(output, "\"cycles_per_byte\": null, ");
+        }
+
+        fprintf(output, "\"allocations_per_command\": %.4f}", static_cast<double>(result.allocations) / commands);
+        first = false;
+    }
+
+    fprintf(output, "\n  ]\n}\n");
+
+    if (output != stdout) {
+        fclose(output);
+    }
+
+    return failed ? 1 : 0;
+}
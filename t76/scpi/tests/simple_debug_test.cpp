@@ -6,7 +6,7 @@
  */
 
 #include "concrete_interpreter.hpp"
-#include "stream_local.hpp"
+#include "test_command.hpp"
 #include <iostream>
 #include <string>
 
@@ -17,72 +17,33 @@ int main() {
         // Test with just one extra parameter  
         std::cout << "\nTesting with 1 parameter to TEST:SIMPLE (expects 0):" << std::endl;
         {
-            T76::SCPI::TestInputStream input(std::string("TEST:SIMPLE param0\n"));
-            T76::SCPI::TestOutputStream output;
-            
-            T76::SCPI::ConcreteInterpreter concreteInterpreter;
-            T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(input, output, concreteInterpreter);
-
-            interpreter.processInputStream();
-            
-            std::string result = output.getOutput();
-            std::vector<std::string> errorQueue = interpreter.errors();
-            std::string errors;
-            for (const auto& error : errorQueue) {
-                errors += error + "\n";
-            }
+            CommandResult result = run_command("TEST:SIMPLE param0");
             
             std::cout << "Input: TEST:SIMPLE param0" << std::endl;
-            std::cout << "Output: '" << result << "'" << std::endl;
-            std::cout << "Errors: '" << errors << "'" << std::endl;
+            std::cout << "Output: '" << result.output << "'" << std::endl;
+            std::cout << "Errors: '" << result.errors << "'" << std::endl;
             std::cout << "✓ EXPECTED: Error because TEST:SIMPLE expects 0 parameters but got 1" << std::endl;
         }
         
         // Test with exactly max parameters
         std::cout << "\nTesting with 3 parameters to TEST:SIMPLE (expects 0):" << std::endl;
         {
-            T76::SCPI::TestInputStream input(std::string("TEST:SIMPLE param0 param1 param2\n"));
-            T76::SCPI::TestOutputStream output;
-            
-            T76::SCPI::ConcreteInterpreter concreteInterpreter;
-            T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(input, output, concreteInterpreter);
-
-            interpreter.processInputStream();
-            
-            std::string result = output.getOutput();
-            std::vector<std::string> errorQueue = interpreter.errors();
-            std::string errors;
-            for (const auto& error : errorQueue) {
-                errors += error + "\n";
-            }
+            CommandResult result = run_command("TEST:SIMPLE param0 param1 param2");
             
             std::cout << "Input: TEST:SIMPLE param0 param1 param2" << std::endl;
-            std::cout << "Output: '" << result << "'" << std::endl;
-            std::cout << "Errors: '" << errors << "'" << std::endl;
+            std::cout << "Output: '" << result.output << "'" << std::endl;
+            std::cout << "Errors: '" << result.errors << "'" << std::endl;
             std::cout << "✓ EXPECTED: Error because TEST:SIMPLE expects 0 parameters but got 3" << std::endl;
         }
         
         // Test with max+1 parameters (should hit global limit)
         std::cout << "\nTesting with 4 parameters to TEST:SIMPLE (exceeds global max of 3):" << std::endl;
         {
-            T76::SCPI::TestInputStream input(std::string("TEST:SIMPLE param0 param1 param2 param3\n"));
-            T76::SCPI::TestOutputStream output;
-            
-            T76::SCPI::ConcreteInterpreter concreteInterpreter;
-            T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(input, output, concreteInterpreter);
-
-            interpreter.processInputStream();
-            
-            std::string result = output.getOutput();
-            std::vector<std::string> errorQueue = interpreter.errors();
-            std::string errors;
-            for (const auto& error : errorQueue) {
-                errors += error + "\n";
-            }
+            CommandResult result = run_command("TEST:SIMPLE param0 param1 param2 param3");
             
             std::cout << "Input: TEST:SIMPLE param0 param1 param2 param3" << std::endl;
-            std::cout << "Output: '" << result << "'" << std::endl;
-            std::cout << "Errors: '" << errors << "'" << std::endl;
+            std::cout << "Output: '" << result.output << "'" << std::endl;
+            std::cout << "Errors: '" << result.errors << "'" << std::endl;
             std::cout << "✓ EXPECTED: Error because too many parameters exceed global limit" << std::endl;
         }
         
@@ -1,34 +1,43 @@
 #include "test_command.hpp"
 #include "concrete_interpreter.hpp"
-#include "stream_local.hpp"
 #include <iostream>
 
-void test_command(const char* command, const std::string& expected_output_search, const std::string& expected_error_search) {
-    std::cout << "\n--- Testing: " << command << " ---" << std::endl;
+namespace {
+
+    bool appendResponse(void *context, std::string_view response) {
+        static_cast<std::string*>(context)->append(response);
+        return true;
+    }
+
+} // namespace
 
-    T76::SCPI::TestInputStream input((std::string(command) + "\n").c_str());
-    T76::SCPI::TestOutputStream output;
+CommandResult run_command(const std::string& command, size_t abdMaxSize) {
+    CommandResult result;
 
     T76::SCPI::ConcreteInterpreter target;
-    T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(input, output, target);
+    T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(target, abdMaxSize);
+    interpreter.setResponseWriter(appendResponse, &result.output);
 
-    interpreter.processInputStream();
+    const std::string input = command + "\n";
+    interpreter.processInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
 
-    std::string result = output.getOutput();
-    std::cout << "Output: " << result << std::endl;
+    for (const auto& error : interpreter.errors()) {
+        result.errors += error + "\n";
+    }
 
-    std::string errors = "";
+    return result;
+}
 
-    std::vector<std::string> errorQueue = interpreter.errors();
+void test_command(const char* command, const std::string& expected_output_search, const std::string& expected_error_search, size_t abdMaxSize) {
+    std::cout << "\n--- Testing: " << command << " ---" << std::endl;
 
-    for (const auto& error : errorQueue) {
-        errors += error + "\n";
-    }
+    CommandResult result = run_command(command, abdMaxSize);
 
-    std::cout << "Errors: " << errors << std::endl;
+    std::cout << "Output: " << result.output << std::endl;
+    std::cout << "Errors: " << result.errors << std::endl;
 
     if (expected_output_search.size() > 0) {
-        if (result.find(expected_output_search) == 0) {
+        if (result.output.find(expected_output_search) == 0) {
             std::cout << "✓ OUTPUT PASS" << std::endl;
         } else {
             std::cout << "✗ OUTPUT FAIL (expected to start with: " << expected_output_search << ")" << std::endl;
@@ -36,7 +45,7 @@ void test_command(const char* command, const std::string& expected_output_search
     }
 
     if (expected_error_search.size() > 0) {
-        if (errors.find(expected_error_search) != std::string::npos) {
+        if (result.errors.find(expected_error_search) != std::string::npos) {
             std::cout << "✓ ERROR PASS" << std::endl;
         } else {
             std::cout << "✗ ERROR FAIL (expected error: " << expected_error_search << ")" << std::endl;
@@ -1,15 +1,34 @@
 #ifndef TEST_COMMAND_HPP
 #define TEST_COMMAND_HPP
 
+#include <cstddef>
 #include <string>
 
+/**
+ * @brief Output and errors of a command run by run_command().
+ */
+struct CommandResult {
+    std::string output;     // Responses sent by the handlers, concatenated
+    std::string errors;     // Formatted errors, one per line
+};
+
+/**
+ * @brief Feeds a SCPI command, followed by a newline, to a fresh interpreter.
+ *
+ * @param command The SCPI command to execute.
+ * @param abdMaxSize The largest arbitrary data block the interpreter accepts.
+ * @return The responses and errors the command produced.
+ */
+CommandResult run_command(const std::string& command, size_t abdMaxSize = 256);
+
 /**
  * @brief Executes a SCPI command and validates its output and errors.
- * 
+ *
  * @param command The SCPI command to execute.
  * @param expected_output_search Optional string to search for in the output.
  * @param expected_error_search Optional string to search for in the errors.
+ * @param abdMaxSize The largest arbitrary data block the interpreter accepts.
  */
-void test_command(const char* command, const std::string& expected_output_search = "", const std::string& expected_error_search = "");
+void test_command(const char* command, const std::string& expected_output_search = "", const std::string& expected_error_search = "", size_t abdMaxSize = 256);
 
 #endif // TEST_COMMAND_HPP
@@ -1,6 +1,5 @@
 #include <iostream>
-#include "concrete_interpreter.hpp"
-#include "stream_local.hpp"
+#include "test_command.hpp"
 
 int main() {
     std::cout << "=== Testing Configurable ABD Size Limit ===" << std::endl;
@@ -8,20 +7,11 @@ int main() {
     // Test 1: ABD within limit (16 bytes max, 4 bytes data)
     std::cout << "\nTest 1: ABD within limit (16 bytes max, 4 bytes data)" << std::endl;
     {
-        T76::SCPI::TestInputStream input("TEST:ABD:SIMPLE #14TEST\n");
-        T76::SCPI::TestOutputStream output;
-        T76::SCPI::ConcreteInterpreter handler;
-        T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(input, output, handler, 16);
+        CommandResult result = run_command("TEST:ABD:SIMPLE #14TEST", 16);
         
-        interpreter.processInputStream();
-        
-        std::cout << "Output: " << output.getOutput() << std::endl;
-        auto errors = interpreter.errors();
-        std::cout << "Errors: ";
-        for (const auto& error : errors) {
-            std::cout << error << " ";
-        }
-        std::cout << std::endl;
+        std::cout << "Output: " << result.output << std::endl;
+        const std::string &errors = result.errors;
+        std::cout << "Errors: " << errors << std::endl;
         
         if (errors.empty()) {
             std::cout << "✓ PASS - ABD within limit accepted" << std::endl;
@@ -33,30 +23,13 @@ int main() {
     // Test 2: ABD exceeding limit (16 bytes max, 20 bytes data)
     std::cout << "\nTest 2: ABD exceeding limit (16 bytes max, 20 bytes data)" << std::endl;
     {
-        T76::SCPI::TestInputStream input("TEST:ABD:SIMPLE #220TWENTY_BYTE_DATA_STR\n");
-        T76::SCPI::TestOutputStream output;
-        T76::SCPI::ConcreteInterpreter handler;
-        T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(input, output, handler, 16);
-        
-        interpreter.processInputStream();
-        
-        std::cout << "Output: " << output.getOutput() << std::endl;
-        auto errors = interpreter.errors();
-        std::cout << "Errors: ";
-        for (const auto& error : errors) {
-            std::cout << error << " ";
-        }
-        std::cout << std::endl;
+        CommandResult result = run_command("TEST:ABD:SIMPLE #220TWENTY_BYTE_DATA_STR", 16);
         
-        bool found_size_error = false;
-        for (const auto& error : errors) {
-            if (error.find("ABD data size too large") != std::string::npos) {
-                found_size_error = true;
-                break;
-            }
-        }
+        std::cout << "Output: " << result.output << std::endl;
+        const std::string &errors = result.errors;
+        std::cout << "Errors: " << errors << std::endl;
         
-        if (found_size_error) {
+        if (errors.find("Too much data") != std::string::npos) {
             std::cout << "✓ PASS - ABD exceeding limit rejected" << std::endl;
         } else {
             std::cout << "✗ FAIL - ABD exceeding limit should be rejected" << std::endl;
@@ -66,20 +39,11 @@ int main() {
     // Test 3: Default limit (1MB - should accept larger data)
     std::cout << "\nTest 3: Default limit (1MB - should accept the same large data)" << std::endl;
     {
-        T76::SCPI::TestInputStream input("TEST:ABD:SIMPLE #220TWENTY_BYTE_DATA_STR\n");
-        T76::SCPI::TestOutputStream output;
-        T76::SCPI::ConcreteInterpreter handler;
-        T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(input, output, handler); // Default 1MB limit
+        CommandResult result = run_command("TEST:ABD:SIMPLE #220TWENTY_BYTE_DATA_STR", 1024 * 1024);
         
-        interpreter.processInputStream();
-        
-        std::cout << "Output: " << output.getOutput() << std::endl;
-        auto errors = interpreter.errors();
-        std::cout << "Errors: ";
-        for (const auto& error : errors) {
-            std::cout << error << " ";
-        }
-        std::cout << std::endl;
+        std::cout << "Output: " << result.output << std::endl;
+        const std::string &errors = result.errors;
+        std::cout << "Errors: " << errors << std::endl;
         
         if (errors.empty()) {
             std::cout << "✓ PASS - Same data accepted with default limit" << std::endl;
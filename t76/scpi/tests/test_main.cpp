@@ -6,25 +6,17 @@
  */
 
 #include "concrete_interpreter.hpp"
-#include "stream_local.hpp"
+#include "test_command.hpp"
 #include <iostream>
 #include <string>
 
 int main() {
     try {
-        // Create test input and output streams
-        T76::SCPI::TestInputStream input(std::string("TEST:SIMPLE\n"));
-        T76::SCPI::TestOutputStream output;
-        
-        // Create interpreter instance
-        T76::SCPI::ConcreteInterpreter target;
-        T76::SCPI::Interpreter<T76::SCPI::ConcreteInterpreter> interpreter(input, output, target);
-        
-        // Process input
-        interpreter.processInputStream();
+        // Run a single command through a fresh interpreter
+        CommandResult result = run_command("TEST:SIMPLE");
         
         // Check output
-        std::cout << "Output: " << output.getOutput() << std::endl;
+        std::cout << "Output: " << result.output << std::endl;
         
         return 0;
     } catch (const std::exception& e) {
@@ -16,6 +16,42 @@ bool TrieNode::terminal() {
 }
 
 TrieNode *TrieNode::nextChild(uint8_t character) {
+    if (childCount == 0) {
+        return nullptr;
+    }
+
+    if (flags & static_cast<uint8_t>(TrieNodeFlags::Dense)) {
+        // Wide nodes: the children array is a jump table starting at the first
+        // child's character; unused slots hold '\0' and never match
+        const uint8_t first = children[0].character;
+
+        if (character >= first && character - first < childCount && children[character - first].character == character) {
+            return const_cast<TrieNode*>(&children[character - first]);
+        }
+
+        return nullptr;
+    }
+
+    if (flags & static_cast<uint8_t>(TrieNodeFlags::BinarySearch)) {
+        uint8_t low = 0;
+        uint8_t high = childCount;
+
+        while (low < high) {
+            const uint8_t middle = low + (high - low) / 2;
+            const uint8_t candidate = children[middle].character;
+
+            if (candidate == character) {
+                return const_cast<TrieNode*>(&children[middle]);
+            } else if (candidate < character) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        return nullptr;
+    }
+
     for (uint8_t i = 0; i < childCount; ++i) {
         if (children[i].character == character) {
             return const_cast<TrieNode*>(&children[i]);
@@ -25,4 +61,3 @@ TrieNode *TrieNode::nextChild(uint8_t character) {
     // If no child with the given character is found, return the null node
     return nullptr;
 }
-
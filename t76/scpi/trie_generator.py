@@ -12,12 +12,14 @@ For information on the expected YAML format, refer to the documentation or the e
 """
 
 import argparse
+import json
+import os
 import re
 import sys
 
 from dataclasses import dataclass
 from itertools import product
-from typing import Any, List, Optional
+from typing import Any, List, Optional, Union
 
 try:
     import yaml
@@ -34,6 +36,15 @@ class SCPIDefinitionParameter:
     description: str
     default: Optional[Any] = None
     choices: Optional[List[str]] = None
+    enum_name: Optional[str] = None
+
+    # C++ argument type of each parameter type in a typed handler
+    TYPED_ARGUMENTS = {
+        'number': 'double',
+        'boolean': 'bool',
+        'string': 'std::string_view',
+        'arbitrarydata': 'std::span<const uint8_t>',
+    }
 
     def validate(self) -> None:
         """Validate the parameter to ensure it meets the SCPI definition requirements."""
@@ -91,6 +102,37 @@ class SCPIDefinitionParameter:
                 f"Invalid parameter name '{self.name}'. It must start with a letter or underscore and contain only alphanumeric characters and underscores."
             )
 
+        if self.enum_name is not None:
+            if self.type != 'enum':
+                raise ValueError(
+                    f"Parameter '{self.name}' has an enum_name, but is not an enum")
+
+            if not isinstance(self.enum_name, str) or not re.match(r'^[a-zA-Z_][a-zA-Z0-9_]*$', self.enum_name):
+                raise ValueError(
+                    f"Invalid enum_name '{self.enum_name}' for parameter '{self.name}'")
+
+    def enum_type_name(self, handler: str) -> str:
+        """Name of the enum generated for this parameter of a typed handler."""
+        if self.enum_name:
+            return self.enum_name
+
+        # For example, `mode` of `_setLevel` becomes `SetLevelMode`
+        words = re.split(r'_+', handler.strip('_')) + re.split(r'_+', self.name)
+        return ''.join(word[:1].upper() + word[1:] for word in words if word)
+
+    def enumerators(self) -> List[str]:
+        """C++ enumerator names for the choices of an enum parameter, in order."""
+        names = []
+        for choice in self.choices:
+            name = re.sub(r'[^A-Za-z0-9_]', '_', str(choice))
+            if not name or name[0].isdigit():
+                name = '_' + name
+            if name in names:
+                raise ValueError(
+                    f"Choices of parameter '{self.name}' map to the same enumerator '{name}'")
+            names.append(name)
+        return names
+
     def __str__(self) -> str:
         """String representation of the parameter for debugging."""
         result = f"{self.type}, name='{self.name}', description='{self.description}'"
@@ -115,18 +157,21 @@ class SCPIDefinitionParameter:
             type=data['type'],
             description=data['description'],
             default=data.get('default'),
-            choices=data.get('choices')
+            choices=data.get('choices'),
+            enum_name=data.get('enum_name')
         )
 
 
 @dataclass
 class SCPIDefinitionCommand:
-    """Represents a SCPI command definition, including its syntax, description, response, handler, and parameters."""
+    """Represents a SCPI command definition, including its syntax, description, constant response, handler, and parameters."""
     syntax: str
     description: str
-    response: Optional[str] = None
+    constant: Optional[Union[str, bool]] = None
     handler: Optional[str] = None
     parameters: Optional[List[SCPIDefinitionParameter]] = None
+    chunk_handler: Optional[str] = None
+    typed: Optional[bool] = None
 
     def validate(self) -> None:
         """Validate the SCPIDefinitionCommand to ensure all fields are correctly set."""
@@ -138,20 +183,68 @@ class SCPIDefinitionCommand:
         if not re.match(r'^([\*]?([A-Z_0-9]+[a-z_0-9]*)(:[A-Z_0-9]+[a-z_0-9]*)*)(\?)?$', self.syntax):
             raise ValueError(f"Invalid SCPI command syntax '{self.syntax}'")
 
-        if (not self.handler and not self.response) or (self.handler and self.response):
-            raise ValueError(
-                "Command must have either a handler or a response, but not both")
+        if self.constant is not None and not isinstance(self.constant, (str, bool)):
+            raise ValueError(f"'constant' of '{self.syntax}' must be a string or a boolean")
+
+        # A constant string needs no handler; a constant computed once needs
+        # the handler that computes it
+        if isinstance(self.constant, str):
+            if self.handler:
+                raise ValueError(
+                    f"Command '{self.syntax}' must have either a handler or a constant string, but not both")
+        elif not self.handler:
+            raise ValueError(f"Command '{self.syntax}' must have a handler or a constant string")
 
-        if self.response and not isinstance(self.response, str):
-            raise ValueError("Command response must be a string if provided")
+        if isinstance(self.constant, str) and any(ord(c) < 0x20 or ord(c) == 0x7F for c in self.constant):
+            raise ValueError(f"Constant response of '{self.syntax}' cannot hold control characters")
+
+        if self.is_constant():
+            if not self.syntax.endswith('?') or self.parameters or self.chunk_handler or self.typed:
+                raise ValueError(
+                    f"Constant command '{self.syntax}' must be a query without parameters, chunk handler or typed handler")
 
         if self.handler and not isinstance(self.handler, str):
             raise ValueError("Command handler must be a string if provided")
 
+        if self.chunk_handler is not None:
+            if not isinstance(self.chunk_handler, str) or not self.handler:
+                raise ValueError(
+                    f"Chunk handler of '{self.syntax}' must be a string, and requires a handler")
+
+            # Only the last parameter can be streamed, since the chunk handler
+            # runs while the block arrives
+            if not self.parameters or self.parameters[-1].type != 'arbitrarydata':
+                raise ValueError(
+                    f"Command '{self.syntax}' has a chunk handler, so its last parameter must be arbitrarydata")
+
+        if self.typed is not None and not isinstance(self.typed, bool):
+            raise ValueError(f"'typed' of '{self.syntax}' must be a boolean")
+
+        if self.typed and self.chunk_handler:
+            # A streamed block has no data by the time the handler runs
+            raise ValueError(
+                f"Command '{self.syntax}' has a chunk handler, so its handler cannot be typed")
+
         if self.parameters:
+            # Counted by Command::parameterCount
+            if len(self.parameters) > SCPITrie.MAX_PARAMETERS:
+                raise ValueError(
+                    f"Command '{self.syntax}' has {len(self.parameters)} parameters, "
+                    f"at most {SCPITrie.MAX_PARAMETERS} are supported")
+
             for param in self.parameters:
                 param.validate()
 
+            # Omitted parameters can only be filled in from the end
+            optional = [param.default is not None for param in self.parameters]
+            if any(optional) and not all(optional[optional.index(True):]):
+                raise ValueError(
+                    f"Optional parameters of '{self.syntax}' must follow all of its required parameters")
+
+    def is_constant(self) -> bool:
+        """Whether the command answers with a constant response instead of calling a handler."""
+        return isinstance(self.constant, str) or self.constant is True
+
     def __str__(self) -> str:
         """String representation of the command for debugging."""
         params_str = '\n         - '.join(
@@ -171,11 +264,24 @@ class SCPIDefinitionCommand:
         return cls(
             syntax=data['syntax'],
             description=data['description'],
-            response=data.get('response'),
+            # `response` is the older name of a constant string
+            constant=data.get('constant', data.get('response')),
             handler=data.get('handler'),
-            parameters=parameters
+            parameters=parameters,
+            chunk_handler=data.get('chunk_handler'),
+            typed=data.get('typed')
         )
 
+    def typed_arguments(self) -> List[str]:
+        """C++ argument types of the command's typed handler, one per parameter."""
+        arguments = []
+        for param in self.parameters or []:
+            if param.type == 'enum':
+                arguments.append(param.enum_type_name(self.handler))
+            else:
+                arguments.append(SCPIDefinitionParameter.TYPED_ARGUMENTS[param.type])
+        return arguments
+
 
 @dataclass
 class SCPIDefinition:
@@ -188,6 +294,7 @@ class SCPIDefinition:
     class_name: str
     output_file: str
     commands: List[SCPIDefinitionCommand]
+    typed_handlers: bool = False
 
     def validate(self) -> None:
         """Validate the SCPIDefinition to ensure all fields are correctly set."""
@@ -207,9 +314,54 @@ class SCPIDefinition:
         if not self.commands or not isinstance(self.commands, list):
             raise ValueError("Commands must be a non-empty list")
 
+        # Commands are indexed by TrieNode::commandIndex
+        if len(self.commands) > SCPITrie.MAX_COMMANDS:
+            raise ValueError(
+                f"{len(self.commands)} commands defined, at most {SCPITrie.MAX_COMMANDS} are supported")
+
+        if not isinstance(self.typed_handlers, bool):
+            raise ValueError("typed_handlers must be a boolean")
+
         for command in self.commands:
             command.validate()
 
+        # Commands follow the definition-wide setting unless they say otherwise.
+        # Constant commands have no handler to type.
+        for command in self.commands:
+            if command.typed is None:
+                command.typed = self.typed_handlers and command.handler is not None \
+                    and command.chunk_handler is None and not command.is_constant()
+            elif command.typed and not command.handler:
+                raise ValueError(f"Command '{command.syntax}' has no handler to type")
+
+        # A handler called from several commands must have a single signature
+        signatures = {}
+        for command in self.commands:
+            if command.handler:
+                signature = 'constant' if command.is_constant() else \
+                    command.typed_arguments() if command.typed else None
+                if signatures.setdefault(command.handler, signature) != signature:
+                    raise ValueError(
+                        f"Handler '{command.handler}' is used by commands with different typed signatures")
+
+        self.typed_enums()
+
+    def typed_enums(self) -> dict:
+        """Enums used by typed handlers, by name, as lists of (enumerator, choice) pairs."""
+        enums = {}
+        for command in self.commands:
+            if not command.typed:
+                continue
+            for param in command.parameters or []:
+                if param.type != 'enum':
+                    continue
+                name = param.enum_type_name(command.handler)
+                values = list(zip(param.enumerators(), param.choices))
+                if enums.setdefault(name, values) != values:
+                    raise ValueError(
+                        f"Enum '{name}' is used by parameters with different choices")
+        return enums
+
     @classmethod
     def from_dict(cls, data: dict) -> 'SCPIDefinition':
         """Create a SCPIDefinition from a dictionary, properly instantiating commands."""
@@ -222,7 +374,8 @@ class SCPIDefinition:
             namespace=data['namespace'],
             class_name=data['class_name'],
             output_file=data['output_file'],
-            commands=commands
+            commands=commands,
+            typed_handlers=data.get('typed_handlers', False)
         )
 
 
@@ -231,15 +384,23 @@ class SCPITrieNode:
     A node in the trie data structure for SCPI commands.
 
     Each node represents a character in the command syntax and can have multiple children.
-    If a node is terminal, it indicates the end of a command syntax.
+    If a node is terminal, it indicates the end of a command syntax. After path
+    compression, a node can also carry a segment of characters that must follow
+    its own character before any of its children.
     """
 
     def __init__(self, character: str = '', terminal: bool = False):
         self.character = character
+        self.segment = ''
         self.children = {}
         self.terminal = terminal
         self.command_index: Optional[int] = None
 
+    @property
+    def text(self) -> str:
+        """All the characters matched by this node."""
+        return self.character + self.segment
+
     def add_child(self, node: 'SCPITrieNode') -> None:
         """Add a child node to this node."""
         if node.character in self.children:
@@ -249,14 +410,82 @@ class SCPITrieNode:
 
 
 class SCPITrie:
-    def __init__(self, commands: List[SCPIDefinitionCommand]):
+    # Largest number of commands that TrieNode::commandIndex, a uint16_t, can index
+    MAX_COMMANDS = 65535
+
+    # Largest number of entries in a children array; childCount is a uint8_t
+    MAX_CHILDREN = 255
+
+    # Largest number of parameters; Command::parameterCount is a uint8_t
+    MAX_PARAMETERS = 255
+
+    # Longest segment a single node can hold; segmentLength is a uint8_t
+    MAX_SEGMENT_LENGTH = 255
+
+    # Largest segment pool that segmentOffset, a uint16_t, can address
+    MAX_SEGMENT_POOL_SIZE = 65535
+
+    def __init__(self, commands: List[SCPIDefinitionCommand],
+                 linear_max: int = 4, dense_min: int = 8, compress: bool = True):
         self.root = SCPITrieNode()
         self.commands = commands
 
+        # Child lookup strategy thresholds; see _lookup_strategy()
+        self.linear_max = linear_max
+        self.dense_min = dense_min
+
         # Insert all commands into the trie
         for command in commands:
             self._insert_command(command)
 
+        if compress:
+            for child in self.root.children.values():
+                self._compress(child)
+
+        self.segment_pool = self._build_segment_pool()
+
+    def _compress(self, node: SCPITrieNode) -> None:
+        """Collapse chains of single-child nodes into string segments.
+
+        A node absorbs its only child for as long as it is not terminal, so that
+        the interpreter can only stop on a node's last character. The root is
+        never compressed, since an empty command must stay on the root.
+        """
+        while not node.terminal and len(node.children) == 1 \
+                and len(node.segment) < self.MAX_SEGMENT_LENGTH:
+            child = next(iter(node.children.values()))
+            node.segment += child.character
+            node.children = child.children
+            node.terminal = child.terminal
+            node.command_index = child.command_index
+
+        for child in node.children.values():
+            self._compress(child)
+
+    def _build_segment_pool(self) -> str:
+        """Pack the segments of all nodes into one string.
+
+        Segments already contained in the pool, which is common for the long
+        and short forms of the same header, are stored only once.
+        """
+        pool = ''
+
+        def walk(node: SCPITrieNode) -> None:
+            nonlocal pool
+            if node.segment and node.segment not in pool:
+                pool += node.segment
+            for child in node.children.values():
+                walk(child)
+
+        walk(self.root)
+
+        if len(pool) > self.MAX_SEGMENT_POOL_SIZE:
+            raise ValueError(
+                f"Trie segments need {len(pool)} bytes, more than the "
+                f"{self.MAX_SEGMENT_POOL_SIZE} addressable by a node")
+
+        return pool
+
     def _insert_command(self, command: SCPIDefinitionCommand) -> None:
         """Insert a command into the trie."""
         # Handle the command syntax character by character to preserve special characters
@@ -275,8 +504,14 @@ class SCPITrie:
                 current_node = current_node.children[char]
 
             # Mark the final node as terminal and assign the handler
+            command_index = self.commands.index(command)
+            if current_node.terminal and current_node.command_index != command_index:
+                raise ValueError(
+                    f"'{variation}' matches both '{self.commands[current_node.command_index].syntax}' "
+                    f"and '{command.syntax}'")
+
             current_node.terminal = True
-            current_node.command_index = self.commands.index(command)
+            current_node.command_index = command_index
 
     def _generate_command_variations(self, syntax: str) -> List[str]:
         """Generate all possible variations of a command syntax."""
@@ -305,15 +540,16 @@ class SCPITrie:
                 # Special characters remain as-is
                 segment_variations.append([segment])
             else:
-                # Generate abbreviated and full forms
-                match = re.match(r'([A-Z_0-9]+)([a-z_0-9]*)', segment)
+                # Generate abbreviated and full forms; a numeric suffix, as in
+                # CHANnel2, belongs to both forms
+                match = re.match(r'([A-Z_0-9]+)([a-z_0-9]*?)([0-9]*)$', segment)
                 if match:
-                    upper_part, lower_part = match.groups()
+                    upper_part, lower_part, suffix = match.groups()
                     if lower_part:
                         segment_variations.append(
-                            [upper_part, upper_part + lower_part])
+                            [upper_part + suffix, upper_part + lower_part + suffix])
                     else:
-                        segment_variations.append([upper_part])
+                        segment_variations.append([upper_part + suffix])
                 else:
                     segment_variations.append([segment])
 
@@ -335,23 +571,58 @@ class SCPITrie:
 {prefix} -> 
     {self.commands[node.command_index]}\n"""
             for child in node.children.values():
-                result += _print_node(child, prefix + child.character)
+                result += _print_node(child, prefix + child.text)
             return result
 
         return _print_node(self.root)
 
-    def generate_cpp_code(self, scpi_definition: SCPIDefinition) -> str:
-        """Generate C++ code for the trie and commands."""
-        code = self._generate_cpp_header(scpi_definition)
+    def generate_cpp_code(self, scpi_definition: SCPIDefinition, header_include: Optional[str] = None,
+                          dispatch: bool = False, profile: bool = False) -> str:
+        """Generate C++ code for the trie and commands.
+
+        header_include is how the generated code includes the header written by
+        generate_header(), which is required if typed handlers take enums.
+
+        With dispatch, the handlers are called from a generated switch instead
+        of through the command table, which then only describes the parameters
+        and chunk handlers; the interpreter must be built with
+        T76_SCPI_GENERATED_DISPATCH.
+
+        With profile, the syntax of every command is also emitted as a table
+        that names the entries of the interpreter's command profile; the
+        interpreter must be built with T76_SCPI_PROFILE.
+        """
+        if scpi_definition.typed_enums() and not header_include:
+            raise ValueError(
+                "Typed handlers take enum parameters, so a header must be generated with --header")
+
+        code = self._generate_cpp_header(scpi_definition, header_include)
         code += self._generate_class_declaration(scpi_definition)
         code += self._generate_scpi_namespace_start()
-        code += self._generate_memory_comment(scpi_definition)
+        code += self._generate_memory_comment(scpi_definition, dispatch)
         code += self._generate_parameter_descriptors(scpi_definition)
+        if not dispatch:
+            code += self._generate_trampolines(scpi_definition)
+        code += self._generate_constant_responses(scpi_definition)
+        code += self._generate_segment_pool(scpi_definition)
         code += self._generate_trie_structure(self.root, scpi_definition)
-        code += self._generate_commands_array(scpi_definition)
+        code += self._generate_commands_array(scpi_definition, dispatch)
+        if dispatch:
+            code += self._generate_dispatch(scpi_definition)
+        if profile:
+            code += self._generate_command_names(scpi_definition)
         code += self._generate_cpp_footer()
         return code
 
+    def _generate_segment_pool(self, scpi_definition: SCPIDefinition) -> str:
+        """Generate the string that holds the segments of compressed nodes."""
+        escaped = self.segment_pool.replace('\\', '\\\\').replace('"', '\\"')
+
+        code = "    // Segments of path-compressed trie nodes\n"
+        code += "    template<>\n"
+        code += f"    constinit const char T76::SCPI::Interpreter<{scpi_definition.namespace}::{scpi_definition.class_name}>::_trieSegments[] = \"{escaped}\";\n\n"
+        return code
+
     def _generate_trie_structure(self, root: SCPITrieNode, scpi_definition: SCPIDefinition) -> str:
         """Generate the nested trie structure in C++."""
         code = "    // Trie structure\n"
@@ -366,7 +637,7 @@ class SCPITrie:
 
         # Output the root node
         code += "    template<>\n"
-        code += f"    const TrieNode T76::SCPI::Interpreter<{scpi_definition.namespace}::{scpi_definition.class_name}>::_trie = {root_def};\n"
+        code += f"    constinit const TrieNode T76::SCPI::Interpreter<{scpi_definition.namespace}::{scpi_definition.class_name}>::_trie = {root_def};\n"
 
         code += "\n"
         return code
@@ -379,15 +650,26 @@ class SCPITrie:
             sorted_children = sorted(
                 node.children.values(), key=lambda n: n.character)
             for child in sorted_children:
-                child_path = node_path + child.character
+                child_path = node_path + child.text
                 child_name = self._collect_node_definitions(
                     child, definitions, child_path)
                 child_names.append(child_name)
 
+        # Dense nodes are indexed by character, so fill the gaps between
+        # children with null nodes
+        strategy = self._lookup_strategy(node)
+        if strategy == 'dense':
+            first = ord(sorted_children[0].character)
+            slots = ["{ '\\0', 0, 0, 0, nullptr, 0, 0 } // Unused"] * \
+                (ord(sorted_children[-1].character) - first + 1)
+            for child, child_name in zip(sorted_children, child_names):
+                slots[ord(child.character) - first] = child_name
+            child_names = slots
+
         # Generate the children array if there are children
         if child_names:
             children_array_name = f"{self._generate_node_name(node_path)}_children"
-            children_def = f"    const TrieNode {children_array_name}[] = {{\n"
+            children_def = f"    constexpr TrieNode {children_array_name}[] = {{\n"
             for i, child_name in enumerate(child_names):
                 # Split the child_name into node definition and comment
                 if " // " in child_name:
@@ -411,7 +693,11 @@ class SCPITrie:
         flags = []
         if node.terminal:
             flags.append("TrieNodeFlags::Terminal")
-        flags_str = "uint8_t(" + " | ".join(flags) + ")" if flags else "0"
+        if strategy == 'binary':
+            flags.append("TrieNodeFlags::BinarySearch")
+        elif strategy == 'dense':
+            flags.append("TrieNodeFlags::Dense")
+        flags_str = " | ".join(f"uint8_t({flag})" for flag in flags) if flags else "0"
 
         # Handle special characters
         char = node.character
@@ -427,7 +713,13 @@ class SCPITrie:
         cmd_index = node.command_index if node.command_index is not None else 0
         child_count = len(child_names)
 
-        node_def = f"{{ {char_str}, {flags_str}, {child_count}, {children_ref}, {cmd_index} }}"
+        if child_count > self.MAX_CHILDREN:
+            raise ValueError(
+                f"Node '{node_path}' needs {child_count} child entries, "
+                f"at most {self.MAX_CHILDREN} are supported")
+        segment_offset = self.segment_pool.find(node.segment) if node.segment else 0
+
+        node_def = f"{{ {char_str}, {flags_str}, {child_count}, {len(node.segment)}, {children_ref}, {segment_offset}, {cmd_index} }}"
 
         # Add comment for terminal nodes
         if node.terminal and node.command_index is not None:
@@ -436,6 +728,93 @@ class SCPITrie:
 
         return node_def
 
+    def _lookup_strategy(self, node: SCPITrieNode) -> str:
+        """Choose how the firmware looks up the children of a node.
+
+        Small nodes are scanned linearly, which is cheapest for a handful of
+        children. Wide nodes whose characters are close together become a
+        jump table indexed by character, provided the gaps cost no more
+        entries than there are children. Everything else uses binary search.
+        """
+        count = len(node.children)
+
+        if count <= self.linear_max:
+            return 'linear'
+
+        span = ord(max(node.children)) - ord(min(node.children)) + 1
+        if count >= self.dense_min and span - count <= count:
+            return 'dense'
+
+        return 'binary'
+
+    @staticmethod
+    def _lookup_compares(characters: List[str], character: str, strategy: str) -> int:
+        """Count the character comparisons needed to find a child."""
+        if strategy == 'dense':
+            return 1
+
+        if strategy == 'linear':
+            return characters.index(character) + 1
+
+        low, high, compares = 0, len(characters), 0
+        while low < high:
+            middle = (low + high) // 2
+            compares += 1
+            if characters[middle] == character:
+                break
+            if characters[middle] < character:
+                low = middle + 1
+            else:
+                high = middle
+
+        return compares
+
+    def calculate_lookup_cost(self) -> dict:
+        """Compare the cost of the selected lookup strategies against linear scans.
+
+        Returns the average number of character comparisons needed to match a
+        complete command, with and without the per-node strategies, together
+        with the number of nodes using each strategy and the null nodes added
+        to fill dense jump tables.
+        """
+        strategies = {'linear': 0, 'binary': 0, 'dense': 0}
+        filler_nodes = 0
+        totals = []
+
+        def walk(node: SCPITrieNode, linear_cost: int, selected_cost: int) -> None:
+            nonlocal filler_nodes
+
+            if node.terminal:
+                totals.append((linear_cost, selected_cost))
+
+            if not node.children:
+                return
+
+            strategy = self._lookup_strategy(node)
+            strategies[strategy] += 1
+
+            characters = sorted(node.children)
+            if strategy == 'dense':
+                filler_nodes += ord(characters[-1]) - ord(characters[0]) + 1 - len(characters)
+
+            for character in characters:
+                # Segment characters are compared one by one after the lookup
+                child = node.children[character]
+                walk(child,
+                     linear_cost + self._lookup_compares(characters, character, 'linear') + len(child.segment),
+                     selected_cost + self._lookup_compares(characters, character, strategy) + len(child.segment))
+
+        walk(self.root, 0, 0)
+
+        return {
+            'linear_compares': sum(cost[0] for cost in totals) / len(totals) if totals else 0.0,
+            'selected_compares': sum(cost[1] for cost in totals) / len(totals) if totals else 0.0,
+            'linear_nodes': strategies['linear'],
+            'binary_nodes': strategies['binary'],
+            'dense_nodes': strategies['dense'],
+            'filler_nodes': filler_nodes,
+        }
+
     def _generate_node_name(self, node_path: str) -> str:
         """Generate a unique name for a node based on its path."""
         if not node_path:
@@ -454,9 +833,9 @@ class SCPITrie:
 
         return f"_node_{safe_path}"
 
-    def _generate_cpp_header(self, scpi_definition: SCPIDefinition) -> str:
+    def _generate_cpp_header(self, scpi_definition: SCPIDefinition, header_include: Optional[str] = None) -> str:
         """Generate the C++ file header."""
-        return f'''/**
+        code = f'''/**
  * @file {scpi_definition.output_file}
  * 
  * Autogenerated SCPI commands trie and handler pointers.
@@ -469,6 +848,40 @@ class SCPITrie:
 #include <t76/scpi_interpreter.hpp>
 
 '''
+        if header_include:
+            code += f'#include "{header_include}"\n\n'
+        return code
+
+    def generate_header(self, scpi_definition: SCPIDefinition, header_file: str) -> str:
+        """Generate the header that declares the enums taken by typed handlers.
+
+        The application includes this header from the declaration of its
+        handler class; the enumerators are the indices of the choices, as
+        resolved by the interpreter while parsing.
+        """
+        code = f'''/**
+ * @file {os.path.basename(header_file)}
+ * 
+ * Autogenerated enums for the typed SCPI handlers of {scpi_definition.class_name}.
+ * Generated from {scpi_definition.class_name} definition.
+ * 
+ */
+
+#pragma once
+
+#include <cstdint>
+
+'''
+        code += f"namespace {scpi_definition.namespace} {{\n\n"
+
+        for name, values in scpi_definition.typed_enums().items():
+            code += f"    enum class {name} : uint8_t {{\n"
+            for index, (enumerator, choice) in enumerate(values):
+                code += f"        {enumerator} = {index}, // {choice}\n"
+            code += "    };\n\n"
+
+        code += "}\n"
+        return code
 
     def _generate_class_declaration(self, scpi_definition: SCPIDefinition) -> str:
         """Generate the class declaration with all handler method signatures."""
@@ -476,10 +889,22 @@ class SCPITrie:
         code += f"    class {scpi_definition.class_name} {{\n"
         code += "    public:\n"
 
+        # Several commands can share a handler, but it can only be declared once
+        declared = set()
         for command in scpi_definition.commands:
-            if command.handler:
+            if command.handler and command.handler not in declared:
                 handler_name = command.handler
-                code += f"        void {handler_name}(const std::vector<T76::SCPI::ParameterValue> &);\n"
+                declared.add(handler_name)
+                if command.is_constant():
+                    code += f"        std::string_view {handler_name}();\n"
+                elif command.typed:
+                    arguments = ', '.join(command.typed_arguments())
+                    code += f"        void {handler_name}({arguments});\n"
+                else:
+                    code += f"        void {handler_name}(T76::SCPI::Parameters);\n"
+            if command.chunk_handler and command.chunk_handler not in declared:
+                declared.add(command.chunk_handler)
+                code += f"        void {command.chunk_handler}(T76::SCPI::Parameters, const T76::SCPI::ABDChunk &);\n"
 
         code += "    };\n"
         code += "}\n\n"
@@ -498,7 +923,7 @@ class SCPITrie:
             if command.parameters:
                 for j, param in enumerate(command.parameters):
                     if param.choices:
-                        code += f"    const char* const command_{i}_param_{j}_choices[] = {{\n"
+                        code += f"    constexpr const char* command_{i}_param_{j}_choices[] = {{\n"
                         for choice in param.choices:
                             code += f"        \"{choice}\",\n"
                         code += "    };\n\n"
@@ -506,7 +931,7 @@ class SCPITrie:
         # Then generate the parameter descriptors
         for i, command in enumerate(scpi_definition.commands):
             if command.parameters:
-                code += f"    const ParameterDescriptor command_{i}_params[] = {{\n"
+                code += f"    constexpr ParameterDescriptor command_{i}_params[] = {{\n"
                 for j, param in enumerate(command.parameters):
                     code += "        {\n"
 
@@ -538,6 +963,9 @@ class SCPITrie:
                     else:
                         code += "            .defaultValue = {.numberValue = 0},\n"
 
+                    has_default = param.default is not None and param.type != 'arbitrarydata'
+                    code += f"            .hasDefault = {'true' if has_default else 'false'},\n"
+
                     # Generate choices for enum parameters
                     if param.choices:
                         code += f"            .choiceCount = {len(param.choices)},\n"
@@ -551,18 +979,90 @@ class SCPITrie:
 
         return code
 
-    def _generate_commands_array(self, scpi_definition: SCPIDefinition) -> str:
-        """Generate the commands array in C++."""
+    def _typed_arguments(self, scpi_definition: SCPIDefinition, command: SCPIDefinitionCommand,
+                         params: str) -> List[str]:
+        """Generate the arguments of a typed handler, unpacked from the parameter span named params."""
+        arguments = []
+        for j, param in enumerate(command.parameters or []):
+            if param.type == 'number':
+                arguments.append(f"{params}[{j}].numberValue")
+            elif param.type == 'boolean':
+                arguments.append(f"{params}[{j}].booleanValue")
+            elif param.type == 'string':
+                arguments.append(f"{params}[{j}].stringValue")
+            elif param.type == 'enum':
+                enum_type = f"{scpi_definition.namespace}::{param.enum_type_name(command.handler)}"
+                arguments.append(f"static_cast<{enum_type}>({params}[{j}].enumIndex)")
+            else:
+                arguments.append(
+                    f"std::span<const uint8_t>({params}[{j}].dataValue, {params}[{j}].dataLength)")
+
+        return arguments
+
+    def _generate_trampolines(self, scpi_definition: SCPIDefinition) -> str:
+        """Generate the functions that unpack the parameters of typed handlers."""
+        target = f"{scpi_definition.namespace}::{scpi_definition.class_name}"
+        code = ""
+
+        for i, command in enumerate(scpi_definition.commands):
+            if not command.typed:
+                continue
+
+            arguments = self._typed_arguments(scpi_definition, command, "params")
+
+            if not code:
+                code = "    // Trampolines for typed handlers\n"
+
+            unused = "" if arguments else "\n        (void)params;"
+            code += f"    static void command_{i}_trampoline({target} &target, Parameters params) {{{unused}\n"
+            code += f"        target.{command.handler}({', '.join(arguments)});\n"
+            code += "    }\n\n"
+
+        return code
+
+    def _generate_constant_responses(self, scpi_definition: SCPIDefinition) -> str:
+        """Generate the functions that return the responses of constant queries."""
+        target = f"{scpi_definition.namespace}::{scpi_definition.class_name}"
+        code = ""
+
+        for i, command in enumerate(scpi_definition.commands):
+            if isinstance(command.constant, str):
+                # The literal stays in flash; its length is known here, so it is never measured
+                literal = command.constant.replace('\\', '\\\\').replace('"', '\\"')
+                length = len(command.constant.encode('utf-8'))
+                code += f"    static std::string_view command_{i}_constant({target} &) {{\n"
+                code += f"        return std::string_view(\"{literal}\", {length});\n"
+                code += "    }\n\n"
+            elif command.constant is True:
+                # Computed by the handler the first time the query is received
+                code += f"    static std::string_view command_{i}_constant({target} &target) {{\n"
+                code += f"        static const std::string_view response = target.{command.handler}();\n"
+                code += "        return response;\n"
+                code += "    }\n\n"
+
+        return code
+
+    def _generate_commands_array(self, scpi_definition: SCPIDefinition, dispatch: bool = False) -> str:
+        """Generate the commands array in C++.
+
+        With dispatch, the generated switch calls the handlers, so the table
+        leaves out their pointers.
+        """
         code = "    // Command handlers and parameters\n"
         code += "    template<>\n"
-        code += f"    const Command<{scpi_definition.namespace}::{scpi_definition.class_name}> T76::SCPI::Interpreter<{scpi_definition.namespace}::{scpi_definition.class_name}>::_commands[] = {{\n"
+        code += f"    constinit const Command<{scpi_definition.namespace}::{scpi_definition.class_name}> T76::SCPI::Interpreter<{scpi_definition.namespace}::{scpi_definition.class_name}>::_commands[] = {{\n"
 
-        # Track maximum parameter count
+        # Track maximum parameter count, and how many of a command's parameters
+        # can need string storage in the interpreter
         max_param_count = 0
+        max_string_param_count = 0
 
         for i, command in enumerate(scpi_definition.commands):
-            # Generate member function pointer syntax
-            if command.handler:
+            # Generate member function pointer syntax; typed handlers are
+            # called through their trampoline instead
+            if dispatch or command.typed or command.is_constant():
+                handler_ref = "nullptr"
+            elif command.handler:
                 handler_ref = f"&{scpi_definition.namespace}::{scpi_definition.class_name}::{command.handler}"
             else:
                 handler_ref = "nullptr"
@@ -570,6 +1070,9 @@ class SCPITrie:
             # Count parameters
             param_count = len(command.parameters) if command.parameters else 0
             max_param_count = max(max_param_count, param_count)
+            string_param_count = sum(1 for param in (command.parameters or [])
+                                     if param.type in ('string', 'arbitrarydata'))
+            max_string_param_count = max(max_string_param_count, string_param_count)
 
             # Generate parameter descriptor reference
             if command.parameters:
@@ -577,20 +1080,143 @@ class SCPITrie:
             else:
                 param_ref = "nullptr"
 
-            code += f"        {{ {handler_ref}, {param_count}, {param_ref} }}, // {command.syntax}\n"
+            if command.chunk_handler:
+                chunk_handler_ref = f"&{scpi_definition.namespace}::{scpi_definition.class_name}::{command.chunk_handler}"
+            else:
+                chunk_handler_ref = "nullptr"
+
+            trampoline_ref = f"command_{i}_trampoline" if command.typed and not dispatch else "nullptr"
+            constant_ref = f"command_{i}_constant" if command.is_constant() and not dispatch else "nullptr"
+
+            code += f"        {{ {handler_ref}, {param_count}, {param_ref}, {chunk_handler_ref}, {trampoline_ref}, {constant_ref} }}, // {i}: {command.syntax}\n"
 
         code += "    };\n\n"
 
         # Generate command count constant
         code += "    template<>\n"
-        code += f"    const size_t T76::SCPI::Interpreter<{scpi_definition.namespace}::{scpi_definition.class_name}>::_commandCount = {len(scpi_definition.commands)};\n\n"
+        code += f"    constinit const size_t T76::SCPI::Interpreter<{scpi_definition.namespace}::{scpi_definition.class_name}>::_commandCount = {len(scpi_definition.commands)};\n\n"
 
         # Generate maximum parameter count constant
         code += "    template<>\n"
-        code += f"    const size_t T76::SCPI::Interpreter<{scpi_definition.namespace}::{scpi_definition.class_name}>::_maxParameterCount = {max_param_count};\n\n"
+        code += f"    constinit const size_t T76::SCPI::Interpreter<{scpi_definition.namespace}::{scpi_definition.class_name}>::_maxParameterCount = {max_param_count};\n\n"
+
+        # Generate maximum string parameter count constant
+        code += "    template<>\n"
+        code += f"    constinit const size_t T76::SCPI::Interpreter<{scpi_definition.namespace}::{scpi_definition.class_name}>::_maxStringParameterCount = {max_string_param_count};\n\n"
+
+        return code
+
+    def _generate_dispatch(self, scpi_definition: SCPIDefinition) -> str:
+        """Generate the switch that checks the parameters of a command and calls its handler.
+
+        Each case checks the parameter count against a constant and calls the
+        handler directly, so the compiler can inline the check and the
+        unpacking of typed parameters.
+        """
+        target = f"{scpi_definition.namespace}::{scpi_definition.class_name}"
+
+        code = "#if !T76_SCPI_GENERATED_DISPATCH\n"
+        code += "#error \"Generated with --dispatch; build the interpreter with T76_SCPI_GENERATED_DISPATCH (the T76_SCPI_DISPATCH CMake option)\"\n"
+        code += "#endif\n\n"
+        code += "    // Handler dispatch, with the parameter count of each command as a constant\n"
+        code += "    template<>\n"
+        code += f"    void T76::SCPI::Interpreter<{target}>::_dispatch(size_t commandIndex, Parameters parameters, bool parameterError) {{\n"
+        code += "        switch (commandIndex) {\n"
+
+        for i, command in enumerate(scpi_definition.commands):
+            param_count = len(command.parameters) if command.parameters else 0
 
+            if command.is_constant():
+                call = f"_writeConstant(command_{i}_constant(_target));"
+            elif command.typed:
+                call = f"_target.{command.handler}({', '.join(self._typed_arguments(scpi_definition, command, 'parameters'))});"
+            else:
+                call = f"_target.{command.handler}(parameters);"
+
+            code += f"            case {i}: // {command.syntax}\n"
+            code += f"                if (_checkParameters(parameters.size(), {param_count}, parameterError)) {{\n"
+            code += f"                    {call}\n"
+            code += "                }\n"
+            code += "                break;\n\n"
+
+        code += "            default:\n"
+        code += "                break;\n"
+        code += "        }\n"
+        code += "    }\n\n"
         return code
 
+    def _generate_command_names(self, scpi_definition: SCPIDefinition) -> str:
+        """Generate the syntax of every command, indexed like the command table, for the command profile."""
+        target = f"{scpi_definition.namespace}::{scpi_definition.class_name}"
+
+        code = "#if !T76_SCPI_PROFILE\n"
+        code += "#error \"Generated with --profile; build the interpreter with T76_SCPI_PROFILE (the T76_SCPI_PROFILE CMake option)\"\n"
+        code += "#endif\n\n"
+        code += "    // Command names, for the per-command profile\n"
+        code += "    template<>\n"
+        code += f"    constinit const char *const T76::SCPI::Interpreter<{target}>::_commandNames[] = {{\n"
+
+        for i, command in enumerate(scpi_definition.commands):
+            escaped = command.syntax.replace('\\', '\\\\').replace('"', '\\"')
+            code += f"        \"{escaped}\", // {i}\n"
+
+        code += "    };\n\n"
+        return code
+
+    # Encoding of each parameter type in a binary request, as decoded by Interpreter::executeBinary()
+    BINARY_ENCODINGS = {
+        'number': 'f64',
+        'boolean': 'u8',
+        'enum': 'u8',
+        'string': 'u16+bytes',
+        'arbitrarydata': 'u32+bytes',
+    }
+
+    def generate_opcode_map(self, scpi_definition: SCPIDefinition) -> str:
+        """Generate a JSON description of the opcode and binary parameters of every command.
+
+        The opcode of a command is its index in the command table, so host
+        tools can build binary requests for Interpreter::executeBinary()
+        without hard-coding the order of the YAML file.
+        """
+        commands = []
+
+        for opcode, command in enumerate(scpi_definition.commands):
+            parameters = []
+
+            for param in command.parameters or []:
+                entry = {
+                    'name': param.name,
+                    'type': param.type,
+                    'encoding': self.BINARY_ENCODINGS[param.type],
+                }
+
+                if param.choices:
+                    entry['choices'] = param.choices
+
+                if param.default is not None:
+                    entry['default'] = param.default
+
+                parameters.append(entry)
+
+            entry = {
+                'opcode': opcode,
+                'syntax': command.syntax,
+                'handler': command.handler,
+                'parameters': parameters,
+            }
+
+            if isinstance(command.constant, str):
+                entry['constant'] = command.constant
+
+            commands.append(entry)
+
+        return json.dumps({
+            'class_name': scpi_definition.class_name,
+            'namespace': scpi_definition.namespace,
+            'commands': commands,
+        }, indent=2) + "\n"
+
     def _generate_cpp_footer(self) -> str:
         """Generate the C++ file footer."""
         return "} // namespace\n"
@@ -629,13 +1255,21 @@ class SCPITrie:
         # struct TrieNode {
         #     const uint8_t character;     // 1 byte
         #     const uint8_t flags;         // 1 byte
-        #     const uint8_t childCount;    # 1 byte
+        #     const uint8_t childCount;    // 1 byte
+        #     const uint8_t segmentLength; // 1 byte
         #     const TrieNode *children;    // 4 bytes (pointer)
-        #     const uint8_t commandIndex;  // 1 byte
-        # } __attribute__((packed));       # Total: 8 bytes per node
+        #     const uint16_t segmentOffset; // 2 bytes
+        #     const uint16_t commandIndex; // 2 bytes
+        # };                               // Total: 12 bytes per node
+
+        # Dense nodes also store null nodes between their children
+        filler_nodes = self.calculate_lookup_cost()['filler_nodes']
 
-        trie_node_size = 8  # bytes per TrieNode (packed)
-        trie_nodes_memory = total_nodes * trie_node_size
+        trie_node_size = 12  # bytes per TrieNode
+        trie_nodes_memory = (total_nodes + filler_nodes) * trie_node_size
+
+        # Path-compressed segments, plus the null terminator of the literal
+        segments_memory = len(self.segment_pool) + 1
 
         # Parameter descriptors memory
         # type + defaultValue + choiceCount + choices pointer = 16 bytes
@@ -646,11 +1280,14 @@ class SCPITrie:
 
         # Command array memory
         # struct Command {
-        #     CommandHandler handler;      // 4 bytes (member function pointer)
-        #     uint8_t parameterCount;      // 1 byte
+        #     CommandHandler handler;      // 8 bytes (member function pointer, ARM ABI)
+        #     uint8_t parameterCount;      // 1 byte + 3 bytes padding
         #     const ParameterDescriptor* parameters; // 4 bytes (pointer)
-        # };                              // Total: 12 bytes per command (assuming 4-byte alignment)
-        command_size = 12  # bytes per Command
+        #     ABDChunkHandler chunkHandler; // 8 bytes (member function pointer, ARM ABI)
+        #     CommandTrampoline trampoline; // 4 bytes (function pointer)
+        #     ConstantResponse constant;    // 4 bytes (function pointer)
+        # };                              // Total: 32 bytes per command
+        command_size = 32  # bytes per Command
         commands_memory = len(scpi_definition.commands) * command_size
 
         # String literals memory (approximate)
@@ -665,11 +1302,24 @@ class SCPITrie:
                             string_memory += len(choice) + 1
 
         # Code memory (read-only, stored in flash)
-        code_memory = trie_nodes_memory + \
+        code_memory = trie_nodes_memory + segments_memory + \
             param_descriptors_memory + commands_memory + string_memory
 
-        # Runtime memory (SRAM) - minimal, just pointers and state
-        runtime_memory = 64  # Conservative estimate for interpreter state
+        # Parameter storage, allocated once when the interpreter is created:
+        # one ParameterValue (32 bytes) per parameter, and one parameter
+        # buffer's worth (256 bytes) per string or block parameter
+        parameter_value_size = 32
+        parameter_buffer_size = 256
+        max_params = max((len(cmd.parameters) if cmd.parameters else 0
+                          for cmd in scpi_definition.commands), default=0)
+        max_string_params = max((sum(1 for param in (cmd.parameters or [])
+                                     if param.type in ('string', 'arbitrarydata'))
+                                 for cmd in scpi_definition.commands), default=0)
+        parameter_storage_memory = max_params * parameter_value_size + \
+            max_string_params * parameter_buffer_size
+
+        # Runtime memory (SRAM) - interpreter state and parameter storage
+        runtime_memory = 64 + parameter_storage_memory  # Conservative estimate for interpreter state
 
         return {
             'rp2350_specs': rp2350_specs,
@@ -677,6 +1327,8 @@ class SCPITrie:
                 'total_nodes': total_nodes,
                 'total_arrays': total_arrays,
                 'total_children': total_children,
+                'filler_nodes': filler_nodes,
+                'segment_bytes': segments_memory,
                 'node_size_bytes': trie_node_size
             },
             'memory_breakdown': {
@@ -685,6 +1337,7 @@ class SCPITrie:
                 'commands': commands_memory,
                 'string_literals': string_memory,
                 'total_code': code_memory,
+                'parameter_storage': parameter_storage_memory,
                 'runtime_sram': runtime_memory
             },
             'utilization': {
@@ -693,9 +1346,10 @@ class SCPITrie:
             }
         }
 
-    def _generate_memory_comment(self, scpi_definition: SCPIDefinition) -> str:
+    def _generate_memory_comment(self, scpi_definition: SCPIDefinition, dispatch: bool = False) -> str:
         """Generate a comment block with memory usage information."""
         memory_usage = self.calculate_memory_usage(scpi_definition)
+        lookup_cost = self.calculate_lookup_cost()
 
         comment = f"""/*
  * Memory Usage Estimate:
@@ -703,28 +1357,34 @@ class SCPITrie:
  * Trie Structure:
  *   - Total nodes: {memory_usage['trie_stats']['total_nodes']}
  *   - Children arrays: {memory_usage['trie_stats']['total_arrays']}
+ *   - Dense table filler nodes: {memory_usage['trie_stats']['filler_nodes']} ({memory_usage['trie_stats']['filler_nodes'] * memory_usage['trie_stats']['node_size_bytes']} bytes)
  *   - Node size: {memory_usage['trie_stats']['node_size_bytes']} bytes each
+ *   - Compressed segments: {memory_usage['trie_stats']['segment_bytes']} bytes
  *   - Trie memory: {memory_usage['memory_breakdown']['trie_nodes']} bytes
  * 
  * Command System:
- *   - Commands: {len(scpi_definition.commands)} ({memory_usage['memory_breakdown']['commands']} bytes)
+ *   - Commands: {len(scpi_definition.commands)} of up to {self.MAX_COMMANDS} ({memory_usage['memory_breakdown']['commands']} bytes)
+ *   - Index widths: 16-bit command index, 8-bit child count (no size cost, both fit the node's padding)
+ *   - Dispatch: {'generated switch with constant arity checks' if dispatch else 'handler pointers in the command table'}
  *   - Parameter descriptors: {memory_usage['memory_breakdown']['param_descriptors']} bytes
  *   - String literals: {memory_usage['memory_breakdown']['string_literals']} bytes
  * 
  * Total Memory Usage:
  *   - Code/Data (Flash): {memory_usage['memory_breakdown']['total_code']} bytes ({memory_usage['utilization']['flash_percent']:.2f}% of 2MB)
  *   - Runtime (SRAM): {memory_usage['memory_breakdown']['runtime_sram']} bytes ({memory_usage['utilization']['sram_percent']:.2f}% of 264KB)
+ *   - Parameter storage: {memory_usage['memory_breakdown']['parameter_storage']} bytes, allocated once, included in runtime
  * 
  * Performance Characteristics:
- *   - Average lookup depth: ~{self.calculate_average_lookup_depth():.1f} character comparisons
- *   - Memory access pattern: Sequential (cache-friendly)
+ *   - Average lookup depth: ~{self.calculate_average_lookup_depth():.1f} node transitions
+ *   - Child lookups: {lookup_cost['linear_nodes']} linear, {lookup_cost['binary_nodes']} binary search, {lookup_cost['dense_nodes']} dense
+ *   - Average character comparisons: {lookup_cost['selected_compares']:.1f} ({lookup_cost['linear_compares']:.1f} with linear scans only)
  *   - Space complexity: O(total_command_chars)
  */"""
 
         return comment
 
     def calculate_average_lookup_depth(self) -> float:
-        """Calculate average character lookup depth for terminal commands."""
+        """Calculate the average number of node transitions needed to reach a command."""
         def get_terminal_depths(node: SCPITrieNode, depth: int = 0) -> List[int]:
             depths = []
             if node.terminal:
@@ -742,6 +1402,15 @@ if __name__ == "__main__":
         description="Generate trie data structure for SCPI commands.")
     parser.add_argument(
         "input_file", help="Path to the input YAML file containing SCPI commands.")
+    parser.add_argument(
+        "--linear-max", type=int, default=4,
+        help="Largest number of children looked up with a linear scan (default: 4).")
+    parser.add_argument(
+        "--dense-min", type=int, default=8,
+        help="Smallest number of children stored as a dense jump table (default: 8).")
+    parser.add_argument(
+        "--no-compress", action="store_true",
+        help="Keep one trie node per character instead of collapsing single-child chains.")
 
     # Create mutually exclusive group for output options
     output_group = parser.add_mutually_exclusive_group(required=True)
@@ -752,6 +1421,22 @@ if __name__ == "__main__":
         "-i", "--info", action="store_true",
         help="Print trie structure and statistical information.")
 
+    parser.add_argument(
+        "--opcodes",
+        help="Also write a JSON map of the opcode and binary parameter encoding of every command, "
+             "for host tools that send binary requests.")
+    parser.add_argument(
+        "--dispatch", action="store_true",
+        help="Call the handlers from a generated switch instead of through the command table; "
+             "the interpreter must be built with T76_SCPI_GENERATED_DISPATCH.")
+    parser.add_argument(
+        "--profile", action="store_true",
+        help="Also emit the command names used by the per-command profile; "
+             "the interpreter must be built with T76_SCPI_PROFILE.")
+    parser.add_argument(
+        "--header",
+        help="Also write a header that declares the enums taken by typed handlers; "
+             "required if any typed handler has an enum parameter.")
     args = parser.parse_args()
 
     with open(args.input_file, 'r', encoding='utf-8') as f:
@@ -759,7 +1444,8 @@ if __name__ == "__main__":
         definition = SCPIDefinition.from_dict(scpi_commands)
         definition.validate()
 
-    trie = SCPITrie(definition.commands)
+    trie = SCPITrie(definition.commands, args.linear_max, args.dense_min,
+                    compress=not args.no_compress)
 
     if args.info:
         # Print trie structure and statistical information
@@ -801,12 +1487,16 @@ if __name__ == "__main__":
 
         print("Trie Structure:")
         print(
-            f"  - Nodes: {usage['trie_stats']['total_nodes']} × {usage['trie_stats']['node_size_bytes']} bytes = {usage['memory_breakdown']['trie_nodes']} bytes")
+            f"  - Nodes: ({usage['trie_stats']['total_nodes']} + {usage['trie_stats']['filler_nodes']} filler) × {usage['trie_stats']['node_size_bytes']} bytes = {usage['memory_breakdown']['trie_nodes']} bytes")
         print(f"  - Arrays: {usage['trie_stats']['total_arrays']}")
+        print(f"  - Compressed segments: {usage['trie_stats']['segment_bytes']} bytes")
+        print(
+            f"  - Dense table filler nodes: {usage['trie_stats']['filler_nodes']} "
+            f"({usage['trie_stats']['filler_nodes'] * usage['trie_stats']['node_size_bytes']} bytes)")
 
         print("\nCommand System:")
         print(
-            f"  - Commands: {len(definition.commands)} × 12 bytes = {usage['memory_breakdown']['commands']} bytes")
+            f"  - Commands: {len(definition.commands)} × 28 bytes = {usage['memory_breakdown']['commands']} bytes")
         print(
             f"  - Parameter descriptors: {usage['memory_breakdown']['param_descriptors']} bytes")
         print(
@@ -820,7 +1510,15 @@ if __name__ == "__main__":
 
         print("\nPerformance:")
         print(
-            f"  - Average lookup depth: {trie.calculate_average_lookup_depth():.1f} character comparisons")
+            f"  - Average lookup depth: {trie.calculate_average_lookup_depth():.1f} node transitions")
+
+        cost = trie.calculate_lookup_cost()
+        print(
+            f"  - Child lookups: {cost['linear_nodes']} linear, {cost['binary_nodes']} binary search, "
+            f"{cost['dense_nodes']} dense")
+        print(
+            f"  - Average character comparisons: {cost['selected_compares']:.1f} "
+            f"({cost['linear_compares']:.1f} with linear scans only)")
 
         # List all recognized command variations
         print("\nAll recognized command variations:")
@@ -832,7 +1530,7 @@ if __name__ == "__main__":
                 paths.append(current_path)
             for child in node.children.values():
                 paths.extend(get_all_paths(
-                    child, current_path + child.character))
+                    child, current_path + child.text))
             return paths
 
         all_paths = get_all_paths(trie.root)
@@ -843,7 +1541,22 @@ if __name__ == "__main__":
 
     else:
         # Generate output file
-        cpp_code = trie.generate_cpp_code(definition)
+        header_include = None
+        if args.header:
+            header_include = os.path.relpath(
+                args.header, os.path.dirname(os.path.abspath(args.output_file))).replace(os.sep, '/')
+
+        cpp_code = trie.generate_cpp_code(definition, header_include, args.dispatch, args.profile)
         with open(args.output_file, 'w', encoding='utf-8') as output_file:
             output_file.write(cpp_code)
         print(f"Generated C++ code written to: {args.output_file}")
+
+        if args.header:
+            with open(args.header, 'w', encoding='utf-8') as header_file:
+                header_file.write(trie.generate_header(definition, args.header))
+            print(f"Generated C++ header written to: {args.header}")
+
+        if args.opcodes:
+            with open(args.opcodes, 'w', encoding='utf-8') as opcodes_file:
+                opcodes_file.write(trie.generate_opcode_map(definition))
+            print(f"Generated opcode map written to: {args.opcodes}")
@@ -0,0 +1,8 @@
+# Configurable options for the settings store
+
+set(T76_IC_SETTINGS_SECTORS 4 CACHE STRING "Number of flash sectors at the end of the flash used by the settings log; must fit in the updater's protected tail")
+set(T76_IC_SETTINGS_MAX_KEYS 64 CACHE STRING "Maximum number of settings keys")
+set(T76_IC_SETTINGS_POOL_SIZE 4096 CACHE STRING "Size of the RAM that holds the values of all settings (bytes)")
+set(T76_IC_SETTINGS_COMMIT_DELAY_MS 50 CACHE STRING "Time changes are collected before they are written to flash as one batch (milliseconds)")
+set(T76_IC_SETTINGS_TASK_PRIORITY 1 CACHE STRING "FreeRTOS priority of the task that writes settings to flash")
+set(T76_IC_SETTINGS_TASK_STACK_SIZE "(configMINIMAL_STACK_SIZE * 2)" CACHE STRING "Stack size of the task that writes settings to flash")
@@ -0,0 +1,837 @@
+/**
+ * @file settings.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the settings store.
+ *
+ * Flash layout: each sector of the region starts with a header holding a
+ * magic number and a sequence number that grows by one every time the log
+ * moves to a new sector. Records follow, aligned to four bytes:
+ *
+ *     key (4 bytes) | length (2 bytes) | CRC-16 (2 bytes) | value, padded
+ *
+ * A record with a length of 0 removes its key. The first erased word marks
+ * the end of a sector's log.
+ *
+ * RAM layout: a table of entries sorted by key, whose values live in a pool
+ * that is compacted when it runs out of room. Each entry remembers which
+ * sector holds its latest record, so that reclaiming a sector only copies
+ * forward the values that would otherwise be lost.
+ *
+ * The entries, the pool and the statistics are guarded by a mutex. The log
+ * position is only used by the settings task after init(), and the task
+ * never holds the mutex while it waits for the flash.
+ *
+ */
+
+#include "t76/settings.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+
+#include <hardware/flash.h>
+
+#include <t76/flash.hpp>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+
+using namespace T76::Core::Settings;
+
+
+namespace {
+
+    constexpr uint32_t SectorMagic = 0x53363754;                    // "T76S"
+    constexpr uint32_t ErasedKey = 0xffffffff;
+    constexpr uint32_t SectorCount = T76_IC_SETTINGS_SECTORS;
+    constexpr uint32_t RegionSize = SectorCount * FLASH_SECTOR_SIZE;
+    constexpr uint32_t RegionOffset = PICO_FLASH_SIZE_BYTES - RegionSize;
+    constexpr uint8_t NoSector = 0xff;
+    constexpr uint32_t RetryDelayMs = 1000;
+
+    struct SectorHeader {
+        uint32_t magic;
+        uint32_t sequence;
+    };
+
+    struct RecordHeader {
+        uint32_t key;
+        uint16_t length;
+        uint16_t crc;
+    };
+
+    constexpr std::size_t SectorPayload = FLASH_SECTOR_SIZE - sizeof(SectorHeader);
+    constexpr std::size_t MaxValueLength = std::min<std::size_t>({ T76_IC_SETTINGS_POOL_SIZE,
+                                                                   SectorPayload - sizeof(RecordHeader),
+                                                                   UINT16_MAX });
+
+    static_assert(SectorCount >= 3 && SectorCount < NoSector, "The settings store needs at least three sectors");
+    static_assert(T76_IC_SETTINGS_POOL_SIZE <= UINT16_MAX, "Pool offsets are 16 bits wide");
+
+    // With every value live, at least one sector's worth of the log must still be garbage or free,
+    // so that moving to a new sector always frees some room
+    static_assert(T76_IC_SETTINGS_POOL_SIZE + T76_IC_SETTINGS_MAX_KEYS * (sizeof(RecordHeader) + 3) <= (SectorCount - 2) * SectorPayload,
+                  "The settings pool is too large for the number of settings sectors");
+
+#ifdef T76_UPDATER_PROTECTED_TAIL_BYTES
+    static_assert(RegionSize <= T76_UPDATER_PROTECTED_TAIL_BYTES, "The settings region must fit in the updater's protected flash tail");
+#endif
+
+    struct Entry {
+        uint32_t key;
+        uint16_t length;                // 0 for a removed key whose older records are still in flash
+        uint16_t offset;                // Offset of the value in gPool
+        uint8_t sector;                 // Sector holding the latest record, or NoSector
+        bool dirty;                     // Changed in RAM since the latest record was written
+    };
+
+    // A record in the batch being written, so that it can be marked dirty again if the write fails
+    struct BatchItem {
+        uint32_t key;
+        uint8_t previousSector;
+    };
+
+    SemaphoreHandle_t gMutex = nullptr;
+    TaskHandle_t gTask = nullptr;
+    std::atomic<bool> gCommitNow{false};
+
+    Entry gEntries[T76_IC_SETTINGS_MAX_KEYS];
+    uint32_t gEntryCount = 0;
+
+    uint8_t gPool[T76_IC_SETTINGS_POOL_SIZE] __attribute__((aligned(4)));
+    uint32_t gPoolEnd = 0;              // Allocated part of the pool, including values no longer used
+    uint32_t gPoolLive = 0;             // Bytes of the pool used by current values
+
+    uint32_t gPending = 0;
+    Stats gStats{};
+
+    // Log position, used by the settings task only
+    uint8_t gHead = NoSector;
+    uint32_t gHeadOffset = FLASH_SECTOR_SIZE;
+    uint32_t gSequence = 0;
+    bool gErased[SectorCount];
+
+    // Image of the part of the head sector being programmed
+    uint8_t gBatch[FLASH_SECTOR_SIZE] __attribute__((aligned(4)));
+    BatchItem gBatchItems[T76_IC_SETTINGS_MAX_KEYS];
+    uint32_t gBatchItemCount = 0;
+    uint32_t gBatchStart = 0;           // Offset in the head sector where gBatch starts; page aligned
+    uint32_t gBatchEnd = 0;             // Offset in the head sector where the batch ends
+
+    constexpr uint32_t align4(uint32_t value) {
+        return (value + 3) & ~3u;
+    }
+
+    const uint8_t *flashAt(uint8_t sector, uint32_t offset) {
+        return reinterpret_cast<const uint8_t *>(XIP_BASE + RegionOffset + sector * FLASH_SECTOR_SIZE + offset);
+    }
+
+    uint32_t sectorOffset(uint8_t sector) {
+        return RegionOffset + sector * FLASH_SECTOR_SIZE;
+    }
+
+    uint16_t crc16(const uint8_t *data, std::size_t length, uint16_t crc) {
+        // CRC-16/CCITT, bitwise: records are short and only checked at boot and when written
+        for (std::size_t i = 0; i < length; i++) {
+            crc ^= static_cast<uint16_t>(data[i]) << 8;
+
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+            }
+        }
+
+        return crc;
+    }
+
+    uint16_t recordCrc(uint32_t key, uint16_t length, const uint8_t *value) {
+        const uint8_t header[6] = {
+            uint8_t(key), uint8_t(key >> 8), uint8_t(key >> 16), uint8_t(key >> 24),
+            uint8_t(length), uint8_t(length >> 8),
+        };
+
+        return crc16(value, length, crc16(header, sizeof(header), 0xffff));
+    }
+
+    // === RAM cache; the caller holds gMutex ===
+
+    /**
+     * @brief Find the position of a key in the sorted entry table
+     * @return The index of the key, or the index at which it would be inserted
+     */
+    uint32_t lowerBound(uint32_t key) {
+        uint32_t low = 0;
+        uint32_t high = gEntryCount;
+
+        while (low < high) {
+            const uint32_t middle = (low + high) / 2;
+
+            if (gEntries[middle].key < key) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        return low;
+    }
+
+    Entry *find(uint32_t key) {
+        const uint32_t index = lowerBound(key);
+        return (index < gEntryCount && gEntries[index].key == key) ? &gEntries[index] : nullptr;
+    }
+
+    Entry *insert(uint32_t key) {
+        if (gEntryCount >= T76_IC_SETTINGS_MAX_KEYS) {
+            return nullptr;
+        }
+
+        const uint32_t index = lowerBound(key);
+
+        memmove(&gEntries[index + 1], &gEntries[index], (gEntryCount - index) * sizeof(Entry));
+        gEntries[index] = { key, 0, 0, NoSector, false };
+        gEntryCount++;
+
+        return &gEntries[index];
+    }
+
+    void erase(Entry *entry) {
+        const uint32_t index = static_cast<uint32_t>(entry - gEntries);
+
+        if (entry->dirty) {
+            gPending--;
+        }
+
+        gPoolLive -= align4(entry->length);
+        memmove(&gEntries[index], &gEntries[index + 1], (gEntryCount - index - 1) * sizeof(Entry));
+        gEntryCount--;
+    }
+
+    void markDirty(Entry &entry) {
+        if (!entry.dirty) {
+            entry.dirty = true;
+            gPending++;
+        }
+    }
+
+    void markClean(Entry &entry) {
+        if (entry.dirty) {
+            entry.dirty = false;
+            gPending--;
+        }
+    }
+
+    /**
+     * @brief Slide every value to the start of the pool, in pool order
+     */
+    void compactPool() {
+        uint8_t order[T76_IC_SETTINGS_MAX_KEYS];
+        uint32_t count = 0;
+
+        for (uint32_t i = 0; i < gEntryCount; i++) {
+            if (gEntries[i].length == 0) {
+                continue;
+            }
+
+            uint32_t position = count++;
+
+            while (position > 0 && gEntries[order[position - 1]].offset > gEntries[i].offset) {
+                order[position] = order[position - 1];
+                position--;
+            }
+
+            order[position] = static_cast<uint8_t>(i);
+        }
+
+        uint32_t cursor = 0;
+
+        for (uint32_t i = 0; i < count; i++) {
+            Entry &entry = gEntries[order[i]];
+
+            memmove(&gPool[cursor], &gPool[entry.offset], entry.length);
+            entry.offset = static_cast<uint16_t>(cursor);
+            cursor += align4(entry.length);
+        }
+
+        gPoolEnd = cursor;
+    }
+
+    /**
+     * @brief Replace the value of an entry in RAM
+     * @return false if the pool has no room for the value
+     */
+    bool storeValue(Entry &entry, const uint8_t *value, uint16_t length) {
+        const uint32_t oldSize = align4(entry.length);
+        const uint32_t newSize = align4(length);
+
+        if (newSize != oldSize || entry.length == 0) {
+            if (gPoolLive - oldSize + newSize > T76_IC_SETTINGS_POOL_SIZE) {
+                return false;
+            }
+
+            // The old value is no longer needed, so it does not have to survive a compaction
+            gPoolLive -= oldSize;
+            entry.length = 0;
+
+            if (gPoolEnd + newSize > T76_IC_SETTINGS_POOL_SIZE) {
+                compactPool();
+            }
+
+            entry.offset = static_cast<uint16_t>(gPoolEnd);
+            gPoolEnd += newSize;
+            gPoolLive += newSize;
+        }
+
+        memcpy(&gPool[entry.offset], value, length);
+        entry.length = length;
+
+        return true;
+    }
+
+    // === Flash log; used by the settings task only ===
+
+    /**
+     * @brief Start a batch at the current end of the head sector's log
+     */
+    void beginBatch() {
+        gBatchStart = gHeadOffset & ~(FLASH_PAGE_SIZE - 1);
+        gBatchEnd = gHeadOffset;
+        gBatchItemCount = 0;
+
+        // Programming 0xff leaves the records already in the first page untouched
+        memset(gBatch, 0xff, gHeadOffset - gBatchStart);
+    }
+
+    /**
+     * @brief Append an entry's current value to the batch, if it fits in the head sector
+     *
+     * Records the entry as living in the head sector and marks it clean; the
+     * caller holds gMutex.
+     */
+    bool addToBatch(Entry &entry) {
+        const uint32_t recordSize = sizeof(RecordHeader) + align4(entry.length);
+
+        if (gHead == NoSector || gBatchEnd + recordSize > FLASH_SECTOR_SIZE) {
+            return false;
+        }
+
+        uint8_t *record = &gBatch[gBatchEnd - gBatchStart];
+        const RecordHeader header = { entry.key, entry.length, recordCrc(entry.key, entry.length, &gPool[entry.offset]) };
+
+        memcpy(record, &header, sizeof(header));
+        memcpy(record + sizeof(header), &gPool[entry.offset], entry.length);
+        memset(record + sizeof(header) + entry.length, 0xff, align4(entry.length) - entry.length);
+
+        gBatchItems[gBatchItemCount++] = { entry.key, entry.sector };
+        gBatchEnd += recordSize;
+
+        entry.sector = gHead;
+        markClean(entry);
+
+        return true;
+    }
+
+    /**
+     * @brief Program the batch into the head sector
+     *
+     * If the write fails, every entry in the batch is marked dirty again and
+     * the rest of the head sector is abandoned, since its state is unknown.
+     */
+    bool writeBatch() {
+        if (gBatchItemCount == 0) {
+            return true;
+        }
+
+        const bool success = T76::Core::Flash::program(sectorOffset(gHead) + gBatchStart, gBatch, gBatchEnd - gBatchStart);
+
+        xSemaphoreTake(gMutex, portMAX_DELAY);
+
+        if (success) {
+            gHeadOffset = gBatchEnd;
+            gStats.batches++;
+            gStats.recordsWritten += gBatchItemCount;
+        } else {
+            for (uint32_t i = 0; i < gBatchItemCount; i++) {
+                Entry *entry = find(gBatchItems[i].key);
+
+                if (entry != nullptr && entry->sector == gHead) {
+                    entry->sector = gBatchItems[i].previousSector;
+                    markDirty(*entry);
+                }
+            }
+
+            gHeadOffset = FLASH_SECTOR_SIZE;
+            gStats.failures++;
+        }
+
+        xSemaphoreGive(gMutex);
+        return success;
+    }
+
+    bool eraseSector(uint8_t sector) {
+        if (!T76::Core::Flash::erase(sectorOffset(sector), FLASH_SECTOR_SIZE)) {
+            xSemaphoreTake(gMutex, portMAX_DELAY);
+            gStats.failures++;
+            xSemaphoreGive(gMutex);
+            return false;
+        }
+
+        gErased[sector] = true;
+
+        xSemaphoreTake(gMutex, portMAX_DELAY);
+        gStats.sectorsErased++;
+        xSemaphoreGive(gMutex);
+
+        return true;
+    }
+
+    /**
+     * @brief Move the log to the next sector, which reclaim() has already erased
+     */
+    bool advance() {
+        const uint8_t next = (gHead == NoSector) ? 0 : static_cast<uint8_t>((gHead + 1) % SectorCount);
+
+        if (!gErased[next] && !eraseSector(next)) {
+            return false;
+        }
+
+        const SectorHeader header = { SectorMagic, gSequence + 1 };
+
+        // The sector is now in use whatever happens, so it must be erased again before it is reused
+        gErased[next] = false;
+
+        if (!T76::Core::Flash::program(sectorOffset(next), &header, sizeof(header))) {
+            xSemaphoreTake(gMutex, portMAX_DELAY);
+            gStats.failures++;
+            xSemaphoreGive(gMutex);
+            return false;
+        }
+
+        xSemaphoreTake(gMutex, portMAX_DELAY);
+        gHead = next;
+        gHeadOffset = sizeof(SectorHeader);
+        gSequence++;
+        gStats.sequence = gSequence;
+        xSemaphoreGive(gMutex);
+
+        return true;
+    }
+
+    /**
+     * @brief Free the sector after the head, so that the log can move into it
+     *
+     * That sector holds the oldest part of the log. The values whose latest
+     * record is in it are copied forward from RAM; removals recorded in it are
+     * dropped, since every older record of their keys is in the same sector.
+     * Copying forward always fits when the head sector has just been started.
+     * Otherwise, which can only happen after a power failure during a
+     * reclaim, the values that do not fit are marked dirty and rewritten once
+     * the log has moved on.
+     */
+    bool reclaim() {
+        const uint8_t oldest = static_cast<uint8_t>((gHead + 1) % SectorCount);
+
+        xSemaphoreTake(gMutex, portMAX_DELAY);
+        beginBatch();
+
+        for (uint32_t i = 0; i < gEntryCount; ) {
+            Entry &entry = gEntries[i];
+
+            if (entry.sector != oldest) {
+                i++;
+                continue;
+            }
+
+            if (entry.length == 0) {
+                erase(&entry);
+                continue;
+            }
+
+            if (!addToBatch(entry)) {
+                entry.sector = NoSector;
+                markDirty(entry);
+            }
+
+            i++;
+        }
+
+        const uint32_t copied = gBatchItemCount;
+
+        gStats.recordsCopied += copied;
+        xSemaphoreGive(gMutex);
+
+        if (!writeBatch()) {
+            return false;
+        }
+
+        return eraseSector(oldest);
+    }
+
+    /**
+     * @brief Write every pending change to flash
+     * @return true once nothing is pending, false if a flash operation failed
+     */
+    bool commitPending() {
+        for (;;) {
+            if (gHead != NoSector && !gErased[(gHead + 1) % SectorCount]) {
+                if (!reclaim()) {
+                    return false;
+                }
+
+                continue;
+            }
+
+            xSemaphoreTake(gMutex, portMAX_DELAY);
+
+            if (gPending == 0) {
+                xSemaphoreGive(gMutex);
+                return true;
+            }
+
+            beginBatch();
+
+            for (uint32_t i = 0; i < gEntryCount; ) {
+                Entry &entry = gEntries[i];
+
+                if (!entry.dirty) {
+                    i++;
+                    continue;
+                }
+
+                // A removal that never reached flash has nothing to remove
+                if (entry.length == 0 && entry.sector == NoSector) {
+                    erase(&entry);
+                    continue;
+                }
+
+                addToBatch(entry);
+                i++;
+            }
+
+            const uint32_t batched = gBatchItemCount;
+
+            xSemaphoreGive(gMutex);
+
+            if (batched == 0) {
+                // Nothing pending fits in the head sector
+                if (!advance()) {
+                    return false;
+                }
+
+                continue;
+            }
+
+            if (!writeBatch()) {
+                return false;
+            }
+        }
+    }
+
+    void settingsTask(void *) {
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+            // Give closely spaced changes, such as a recalled instrument state, a chance to join one batch
+            if (!gCommitNow.exchange(false, std::memory_order_relaxed)) {
+                vTaskDelay(pdMS_TO_TICKS(T76_IC_SETTINGS_COMMIT_DELAY_MS));
+            }
+
+            if (!commitPending()) {
+                LOGE("Settings: commit failed, retrying every %lu ms\n", (unsigned long)RetryDelayMs);
+
+                do {
+                    vTaskDelay(pdMS_TO_TICKS(RetryDelayMs));
+                } while (!commitPending());
+            }
+        }
+    }
+
+    // === Loading ===
+
+    bool sectorIsErased(uint8_t sector) {
+        const uint32_t *words = reinterpret_cast<const uint32_t *>(flashAt(sector, 0));
+
+        for (uint32_t i = 0; i < FLASH_SECTOR_SIZE / sizeof(uint32_t); i++) {
+            if (words[i] != 0xffffffff) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Apply every valid record of a sector to the RAM cache
+     * @return The offset at which the sector's log ends, or the sector size if it ends with a damaged record
+     */
+    uint32_t loadSector(uint8_t sector) {
+        uint32_t offset = sizeof(SectorHeader);
+
+        while (offset + sizeof(RecordHeader) <= FLASH_SECTOR_SIZE) {
+            RecordHeader header;
+            memcpy(&header, flashAt(sector, offset), sizeof(header));
+
+            if (header.key == ErasedKey) {
+                return offset;
+            }
+
+            const uint8_t *value = flashAt(sector, offset + sizeof(RecordHeader));
+            const uint32_t recordSize = sizeof(RecordHeader) + align4(header.length);
+
+            if (offset + recordSize > FLASH_SECTOR_SIZE || header.crc != recordCrc(header.key, header.length, value)) {
+                LOGW("Settings: damaged record at offset %lu of sector %u; the rest of the sector is ignored\n", (unsigned long)offset, (unsigned)sector);
+                return FLASH_SECTOR_SIZE;
+            }
+
+            Entry *entry = find(header.key);
+
+            if (header.length == 0) {
+                // The removal only matters while an older record of the key exists
+                if (entry != nullptr) {
+                    gPoolLive -= align4(entry->length);
+                    entry->length = 0;
+                    entry->sector = sector;
+                }
+            } else if (header.length <= MaxValueLength) {
+                if (entry == nullptr) {
+                    entry = insert(header.key);
+                }
+
+                if (entry != nullptr && storeValue(*entry, value, header.length)) {
+                    entry->sector = sector;
+                } else {
+                    LOGE("Settings: no room to load the value of key 0x%08lx\n", (unsigned long)header.key);
+                }
+            }
+
+            offset += recordSize;
+        }
+
+        return offset;
+    }
+
+    void load() {
+        uint8_t order[SectorCount];
+        uint32_t sequences[SectorCount];
+        uint32_t count = 0;
+
+        // Sort the sectors in use by sequence number, which is the order in which the log went through them
+        for (uint8_t sector = 0; sector < SectorCount; sector++) {
+            SectorHeader header;
+            memcpy(&header, flashAt(sector, 0), sizeof(header));
+
+            gErased[sector] = false;
+
+            if (header.magic != SectorMagic) {
+                gErased[sector] = sectorIsErased(sector);
+                continue;
+            }
+
+            uint32_t position = count++;
+
+            while (position > 0 && sequences[position - 1] > header.sequence) {
+                order[position] = order[position - 1];
+                sequences[position] = sequences[position - 1];
+                position--;
+            }
+
+            order[position] = sector;
+            sequences[position] = header.sequence;
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            const uint32_t end = loadSector(order[i]);
+
+            gHead = order[i];
+            gHeadOffset = end;
+            gSequence = sequences[i];
+        }
+
+        gStats.sequence = gSequence;
+    }
+
+} // namespace
+
+
+std::size_t T76::Core::Settings::maxValueLength() {
+    return MaxValueLength;
+}
+
+bool T76::Core::Settings::init() {
+    if (gMutex != nullptr) {
+        return true;
+    }
+
+    gMutex = xSemaphoreCreateMutex();
+
+    if (gMutex == nullptr) {
+        LOGE("Settings: cannot create the mutex\n");
+        return false;
+    }
+
+    load();
+
+    if (xTaskCreate(settingsTask, "Settings", T76_IC_SETTINGS_TASK_STACK_SIZE, nullptr, T76_IC_SETTINGS_TASK_PRIORITY, &gTask) != pdPASS) {
+        LOGE("Settings: cannot create the commit task\n");
+        return false;
+    }
+
+    return true;
+}
+
+bool T76::Core::Settings::set(uint32_t key, const void *value, std::size_t length) {
+    if (gMutex == nullptr || key == ErasedKey || value == nullptr || length == 0 || length > MaxValueLength) {
+        return false;
+    }
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(value);
+
+    xSemaphoreTake(gMutex, portMAX_DELAY);
+
+    Entry *entry = find(key);
+
+    // Storing the same value again costs nothing, so recalling a state does not wear the flash
+    if (entry != nullptr && entry->length == length && memcmp(&gPool[entry->offset], bytes, length) == 0) {
+        xSemaphoreGive(gMutex);
+        return true;
+    }
+
+    const bool created = (entry == nullptr);
+
+    if (created) {
+        entry = insert(key);
+    }
+
+    const bool stored = (entry != nullptr) && storeValue(*entry, bytes, static_cast<uint16_t>(length));
+
+    if (stored) {
+        markDirty(*entry);
+    } else if (entry != nullptr && created) {
+        erase(entry);
+    }
+
+    xSemaphoreGive(gMutex);
+
+    if (stored) {
+        xTaskNotifyGive(gTask);
+    }
+
+    return stored;
+}
+
+bool T76::Core::Settings::get(uint32_t key, void *value, std::size_t length) {
+    if (gMutex == nullptr || value == nullptr) {
+        return false;
+    }
+
+    xSemaphoreTake(gMutex, portMAX_DELAY);
+
+    const Entry *entry = find(key);
+    const bool found = (entry != nullptr && entry->length != 0 && entry->length == length);
+
+    if (found) {
+        memcpy(value, &gPool[entry->offset], length);
+    }
+
+    xSemaphoreGive(gMutex);
+    return found;
+}
+
+std::size_t T76::Core::Settings::size(uint32_t key) {
+    if (gMutex == nullptr) {
+        return 0;
+    }
+
+    xSemaphoreTake(gMutex, portMAX_DELAY);
+
+    const Entry *entry = find(key);
+    const std::size_t length = entry ? entry->length : 0;
+
+    xSemaphoreGive(gMutex);
+    return length;
+}
+
+bool T76::Core::Settings::remove(uint32_t key) {
+    if (gMutex == nullptr) {
+        return false;
+    }
+
+    xSemaphoreTake(gMutex, portMAX_DELAY);
+
+    Entry *entry = find(key);
+    bool changed = false;
+
+    if (entry != nullptr && entry->length != 0) {
+        if (entry->sector == NoSector) {
+            erase(entry); // Never written to flash
+        } else {
+            gPoolLive -= align4(entry->length);
+            entry->length = 0;
+            markDirty(*entry);
+            changed = true;
+        }
+    }
+
+    xSemaphoreGive(gMutex);
+
+    if (changed) {
+        xTaskNotifyGive(gTask);
+    }
+
+    return true;
+}
+
+void T76::Core::Settings::commit() {
+    if (gTask != nullptr) {
+        gCommitNow.store(true, std::memory_order_relaxed);
+        xTaskNotifyGive(gTask);
+    }
+}
+
+bool T76::Core::Settings::flush(uint32_t timeoutMs) {
+    commit();
+
+    const TickType_t start = xTaskGetTickCount();
+
+    while (stats().pending != 0) {
+        if ((xTaskGetTickCount() - start) >= pdMS_TO_TICKS(timeoutMs)) {
+            return false;
+        }
+
+        vTaskDelay(1);
+    }
+
+    return gMutex != nullptr;
+}
+
+Stats T76::Core::Settings::stats() {
+    Stats stats{};
+
+    if (gMutex == nullptr) {
+        return stats;
+    }
+
+    xSemaphoreTake(gMutex, portMAX_DELAY);
+
+    stats = gStats;
+    stats.keys = 0;
+
+    for (uint32_t i = 0; i < gEntryCount; i++) {
+        if (gEntries[i].length != 0) {
+            stats.keys++;
+        }
+    }
+
+    stats.bytesUsed = gPoolLive;
+    stats.pending = gPending;
+
+    xSemaphoreGive(gMutex);
+    return stats;
+}
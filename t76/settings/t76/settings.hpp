@@ -0,0 +1,132 @@
+/**
+ * @file settings.hpp
+ * @brief Persistent key/value settings, cached in RAM and logged to flash
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The settings store keeps every value in RAM, so that reading a setting, or
+ * recalling a complete instrument state, is a copy from RAM that never
+ * touches the flash. Changes are made in RAM and written to flash in batches
+ * by a low-priority task, so that callers such as SCPI handlers never wait
+ * for the flash.
+ *
+ * In flash, the store is a log of records spread over a ring of sectors at
+ * the end of the flash, inside the tail that the resident updater protects.
+ * Each change appends a record to the sector being written; when that sector
+ * is full, the log moves on to the next one, so that every sector is erased
+ * equally often. Before a sector is reused, the values whose latest record
+ * is in it are copied forward from RAM. Every record carries a CRC, so a
+ * record torn by a power failure is ignored at the next boot, and the previous
+ * value of its key is used instead.
+ *
+ * Keys are application-defined 32-bit numbers; 0xffffffff is reserved. Values
+ * are byte strings between 1 byte and maxValueLength bytes long.
+ *
+ * All functions must be called from core 0. init() is called by App::run(),
+ * so settings can already be read in App::_init().
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace T76::Core::Settings {
+
+    /**
+     * @brief Statistics of the settings store
+     */
+    struct Stats {
+        uint32_t keys;                  ///< Keys that have a value
+        uint32_t bytesUsed;             ///< RAM used by the values
+        uint32_t pending;               ///< Changes made in RAM and not yet written to flash
+        uint32_t batches;               ///< Batches of records written to flash
+        uint32_t recordsWritten;        ///< Records written to flash, including those copied forward
+        uint32_t recordsCopied;         ///< Records copied forward to free a sector
+        uint32_t sectorsErased;         ///< Sectors erased since boot
+        uint32_t failures;              ///< Flash operations that failed and were retried
+        uint32_t sequence;              ///< Number of sectors the log has moved through since the store was created
+    };
+
+    /**
+     * @brief Longest value that can be stored, in bytes
+     */
+    std::size_t maxValueLength();
+
+    /**
+     * @brief Load the settings from flash and start the task that writes them back
+     * @return true if the store is ready
+     *
+     * Called by App::run(), after the flash service has been initialized.
+     */
+    bool init();
+
+    /**
+     * @brief Set the value of a key
+     * @param key Key to set
+     * @param value Value to store; copied before the function returns
+     * @param length Length of the value in bytes
+     * @return true if the value was stored in RAM; it reaches flash shortly afterwards
+     */
+    bool set(uint32_t key, const void *value, std::size_t length);
+
+    /**
+     * @brief Get the value of a key
+     * @param key Key to read
+     * @param value Receives the value
+     * @param length Length of the value; must match the stored length
+     * @return true if the key has a value of the given length
+     */
+    bool get(uint32_t key, void *value, std::size_t length);
+
+    /**
+     * @brief Get the length of a key's value
+     * @return The length in bytes, or 0 if the key has no value
+     */
+    std::size_t size(uint32_t key);
+
+    /**
+     * @brief Remove a key and its value
+     * @return true if the key no longer has a value
+     */
+    bool remove(uint32_t key);
+
+    /**
+     * @brief Write pending changes now, rather than after the batching delay
+     */
+    void commit();
+
+    /**
+     * @brief Write pending changes and wait until they are in flash
+     * @param timeoutMs Longest time to wait
+     * @return true if every change made before the call is in flash
+     */
+    bool flush(uint32_t timeoutMs);
+
+    /**
+     * @brief Get the statistics of the settings store
+     */
+    Stats stats();
+
+    /**
+     * @brief Set a key to the contents of a trivially copyable object
+     */
+    template<typename T>
+    bool set(uint32_t key, const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Settings are stored as raw bytes");
+        return set(key, &value, sizeof(T));
+    }
+
+    /**
+     * @brief Read a key into a trivially copyable object
+     * @return true if the key has a value of exactly sizeof(T) bytes
+     */
+    template<typename T>
+    bool get(uint32_t key, T &value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Settings are stored as raw bytes");
+        return get(key, &value, sizeof(T));
+    }
+
+} // namespace T76::Core::Settings
@@ -0,0 +1,29 @@
+/**
+ * @file FreeRTOS.h
+ * @brief The part of FreeRTOS that the settings store uses, for host tests
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Tasks are threads, mutexes are std::mutex, and a tick is a millisecond;
+ * see freertos_host.cpp.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE                     ((BaseType_t)0)
+#define pdTRUE                      ((BaseType_t)1)
+#define pdFAIL                      pdFALSE
+#define pdPASS                      pdTRUE
+
+#define portMAX_DELAY               ((TickType_t)0xffffffffu)
+
+#define configTICK_RATE_HZ          1000
+#define configMINIMAL_STACK_SIZE    256
+
+#define pdMS_TO_TICKS(ms)           ((TickType_t)(ms))
@@ -0,0 +1,94 @@
+/**
+ * @file freertos_host.cpp
+ * @brief FreeRTOS tasks, mutexes and notifications over host threads
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Only what the settings store uses, with portMAX_DELAY as the only
+ * timeout of mutexes and notifications.
+ *
+ */
+
+#include "semphr.h"
+#include "task.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct HostMutex {
+    std::mutex mutex;
+};
+
+struct HostTask {
+    std::mutex mutex;
+    std::condition_variable notified;
+    uint32_t notifications = 0;
+};
+
+namespace {
+
+    thread_local HostTask *currentTask = nullptr;
+
+    const auto bootTime = std::chrono::steady_clock::now();
+
+} // namespace
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return new HostMutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t) {
+    semaphore->mutex.lock();
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    semaphore->mutex.unlock();
+    return pdTRUE;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char *, uint32_t, void *parameters, UBaseType_t, TaskHandle_t *createdTask) {
+    HostTask *task = new HostTask;
+
+    if (createdTask != nullptr) {
+        *createdTask = task;
+    }
+
+    // Tasks never return, and end with the process
+    std::thread([function, parameters, task]() {
+        currentTask = task;
+        function(parameters);
+    }).detach();
+
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t) {
+    std::unique_lock<std::mutex> lock(currentTask->mutex);
+
+    currentTask->notified.wait(lock, []() { return currentTask->notifications > 0; });
+
+    const uint32_t count = currentTask->notifications;
+
+    currentTask->notifications = clearCountOnExit ? 0 : count - 1;
+    return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notifications++;
+    }
+
+    task->notified.notify_one();
+    return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - bootTime).count());
+}
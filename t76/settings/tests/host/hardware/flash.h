@@ -0,0 +1,22 @@
+/**
+ * @file flash.h
+ * @brief Flash geometry, for host tests
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The host flash only holds the settings region, which the store places at
+ * the end of the flash, and is read through hostFlashImage rather than XIP.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#define FLASH_PAGE_SIZE         (1u << 8)
+#define FLASH_SECTOR_SIZE       (1u << 12)
+
+#define PICO_FLASH_SIZE_BYTES   (T76_IC_SETTINGS_SECTORS * FLASH_SECTOR_SIZE)
+
+extern uint8_t *hostFlashImage;
+
+#define XIP_BASE                (reinterpret_cast<uintptr_t>(hostFlashImage))
@@ -0,0 +1,15 @@
+/**
+ * @file semphr.h
+ * @brief FreeRTOS mutexes, for host tests
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef struct HostMutex *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
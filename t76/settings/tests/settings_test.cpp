@@ -0,0 +1,390 @@
+/**
+ * @file settings_test.cpp
+ * @brief Test of the settings store, across reboots, flash failures and power cuts.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The store runs unchanged over the FreeRTOS shim in host/, with a flash
+ * image in memory shared between processes. Each boot of the device is a
+ * child process, which starts with an empty RAM cache and loads the store
+ * from the image that the previous boots left behind. The flash stub can
+ * fail programs, and can cut the power by ending the child in the middle
+ * of a program.
+ *
+ */
+
+#include <t76/settings.hpp>
+#include <t76/flash.hpp>
+
+#include <hardware/flash.h>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Settings = T76::Core::Settings;
+
+uint8_t *hostFlashImage = nullptr;
+
+namespace {
+
+    constexpr uint32_t RegionSize = T76_IC_SETTINGS_SECTORS * FLASH_SECTOR_SIZE;
+    constexpr int PowerCutExit = 3;
+    constexpr uint32_t FlushTimeoutMs = 5000;
+
+    constexpr uint32_t KeyCalibration = 0x100;
+    constexpr uint32_t KeyCount = 0x101;
+    constexpr uint32_t KeyName = 0x102;
+    constexpr uint32_t KeyLarge = 0x103;
+    constexpr uint32_t KeyLog = 0x200;
+    constexpr uint32_t KeyStatic = 0x300;       // StaticKeys keys from here
+    constexpr uint32_t KeyCut = 0x400;          // CutKeys keys from here
+
+    constexpr uint32_t StaticKeys = 20;
+    constexpr uint32_t CutKeys = 8;
+    constexpr uint32_t LogRounds = 300;         // Changes of KeyLog in the wear test
+
+    /**
+     * @brief The flash, shared by every boot
+     */
+    struct HostFlash {
+        uint8_t image[RegionSize];
+        uint32_t failPrograms;          // Programs that fail before they change anything
+        int64_t cutAfterBytes;          // Bytes programmed before the power is cut, or -1
+        uint32_t overwrites;            // Bytes programmed over bytes that were not erased
+        uint32_t misused;               // Misaligned operations, or operations outside the region
+    };
+
+    /**
+     * @brief Results of the power-cut boots, which only a shared counter carries back from a child
+     */
+    struct PowerCutResults {
+        uint32_t neither;               // Values that were neither the old nor the new one after a cut
+        uint32_t lost;                  // Values missing after they were written again and the device rebooted
+    };
+
+    HostFlash *gFlash = nullptr;
+    PowerCutResults *gPowerCuts = nullptr;
+
+    struct Calibration {
+        float gain;
+        float offset;
+        uint32_t serial;
+    };
+
+    void check(const std::string &name, bool passed, const std::string &detail = "") {
+        if (passed) {
+            std::cout << "✓ " << name << std::endl;
+        } else {
+            std::cout << "✗ " << name << (detail.empty() ? "" : " (" + detail + ")") << std::endl;
+        }
+    }
+
+    /**
+     * @brief Run one boot of the device in a child process
+     * @param name Name of the boot in the results
+     * @param body Checks and changes made after Settings::init()
+     * @param powerCut Whether the boot may end with a power cut
+     */
+    template<typename Body>
+    void boot(const std::string &name, Body body, bool powerCut = false) {
+        std::cout.flush();
+
+        const pid_t pid = fork();
+
+        if (pid == 0) {
+            if (!Settings::init()) {
+                check(name + ": init()", false);
+            }
+
+            body();
+            std::cout.flush();
+            _exit(0);
+        }
+
+        int status = 0;
+
+        waitpid(pid, &status, 0);
+
+        const bool exited = WIFEXITED(status) && (WEXITSTATUS(status) == 0 || (powerCut && WEXITSTATUS(status) == PowerCutExit));
+
+        if (!exited) {
+            check(name + ": boot ends normally", false, "status " + std::to_string(status));
+        }
+    }
+
+    std::vector<uint8_t> pattern(uint32_t key, uint32_t generation, std::size_t length) {
+        std::vector<uint8_t> value(length);
+
+        for (std::size_t index = 0; index < length; index++) {
+            value[index] = static_cast<uint8_t>(key * 7 + generation * 13 + index);
+        }
+
+        return value;
+    }
+
+    bool holds(uint32_t key, const std::vector<uint8_t> &expected) {
+        std::vector<uint8_t> value(expected.size());
+
+        return Settings::get(key, value.data(), value.size()) && value == expected;
+    }
+
+    void testBasics() {
+        const Calibration calibration = { 1.5f, -0.25f, 1234 };
+
+        boot("First boot", [&]() {
+            Calibration read{};
+            uint16_t shorter = 0;
+
+            check("An erased store is empty", Settings::stats().keys == 0 && Settings::size(KeyCalibration) == 0 &&
+                                              !Settings::get(KeyCalibration, read));
+
+            std::vector<uint8_t> large(Settings::maxValueLength() + 1, 0x5a);
+
+            check("set() rejects the reserved key", !Settings::set(0xffffffffu, calibration));
+            check("set() rejects an empty value", !Settings::set(KeyName, &calibration, 0));
+            check("set() rejects a value longer than maxValueLength()", !Settings::set(KeyLarge, large.data(), large.size()));
+            check("set() takes a value of maxValueLength()", Settings::set(KeyLarge, large.data(), large.size() - 1));
+            check("remove() of a value never written to flash", Settings::remove(KeyLarge) && Settings::size(KeyLarge) == 0 &&
+                                                                Settings::stats().pending == 0);
+
+            check("set() stores a value", Settings::set(KeyCalibration, calibration));
+            check("get() returns it", Settings::get(KeyCalibration, read) && memcmp(&read, &calibration, sizeof(read)) == 0);
+            check("get() rejects another length", !Settings::get(KeyCalibration, shorter));
+            check("size() returns its length", Settings::size(KeyCalibration) == sizeof(Calibration));
+
+            Settings::set(KeyCount, uint32_t(7));
+            Settings::set(KeyName, "T76", 4);
+
+            check("flush() writes every change", Settings::flush(FlushTimeoutMs) && Settings::stats().pending == 0 &&
+                                                 Settings::stats().batches > 0);
+            check("Setting the same value again changes nothing", Settings::set(KeyCalibration, calibration) &&
+                                                                  Settings::stats().pending == 0);
+        });
+
+        boot("Second boot", [&]() {
+            Calibration read{};
+            uint32_t count = 0;
+            char name[4] = {};
+
+            check("Values survive a reboot", Settings::get(KeyCalibration, read) && memcmp(&read, &calibration, sizeof(read)) == 0 &&
+                                             Settings::get(KeyCount, count) && count == 7 &&
+                                             Settings::get(KeyName, name, sizeof(name)) && strcmp(name, "T76") == 0 &&
+                                             Settings::stats().keys == 3);
+
+            check("remove() removes a value", Settings::remove(KeyCount) && Settings::size(KeyCount) == 0);
+            check("flush() writes the removal", Settings::flush(FlushTimeoutMs));
+        });
+
+        boot("Third boot", [&]() {
+            check("A removal survives a reboot", Settings::size(KeyCount) == 0 && Settings::stats().keys == 2 &&
+                                                 Settings::size(KeyCalibration) == sizeof(Calibration));
+            check("remove() of a missing key", Settings::remove(KeyCount));
+        });
+    }
+
+    void testWear() {
+        boot("Wear boot", [&]() {
+            bool flushed = true;
+
+            for (uint32_t index = 0; index < StaticKeys; index++) {
+                Settings::set(KeyStatic + index, pattern(KeyStatic + index, 0, 64).data(), 64);
+            }
+
+            // One key rewritten over and over moves the log through every sector several times
+            for (uint32_t round = 0; round < LogRounds; round++) {
+                Settings::set(KeyLog, pattern(KeyLog, round, 200).data(), 200);
+                flushed = flushed && Settings::flush(FlushTimeoutMs);
+            }
+
+            const Settings::Stats stats = Settings::stats();
+
+            check("Repeated changes are all written", flushed && stats.pending == 0 && stats.failures == 0);
+            check("The log goes round every sector", stats.sequence > 2 * T76_IC_SETTINGS_SECTORS &&
+                                                     stats.sectorsErased >= 2 * T76_IC_SETTINGS_SECTORS,
+                  "sequence " + std::to_string(stats.sequence) + ", " + std::to_string(stats.sectorsErased) + " erases");
+            check("Values are copied forward from reclaimed sectors", stats.recordsCopied >= StaticKeys);
+        });
+
+        boot("Boot after wear", [&]() {
+            bool intact = true;
+
+            for (uint32_t index = 0; index < StaticKeys; index++) {
+                intact = intact && holds(KeyStatic + index, pattern(KeyStatic + index, 0, 64));
+            }
+
+            check("Values written once survive the reclaims", intact);
+            check("The latest of many changes survives a reboot", holds(KeyLog, pattern(KeyLog, LogRounds - 1, 200)));
+            check("The log continues where it was", Settings::stats().sequence > 2 * T76_IC_SETTINGS_SECTORS);
+        });
+    }
+
+    void testFailures() {
+        const Calibration calibration = { 2.0f, 0.5f, 5678 };
+
+        gFlash->failPrograms = 1;
+
+        boot("Boot with a failing flash", [&]() {
+            Settings::set(KeyCalibration, calibration);
+
+            // The task retries after a second
+            check("A failed write is retried", Settings::flush(FlushTimeoutMs) && Settings::stats().failures >= 1,
+                  std::to_string(Settings::stats().failures) + " failures");
+        });
+
+        boot("Boot after a failure", [&]() {
+            Calibration read{};
+
+            check("A retried write survives a reboot", Settings::get(KeyCalibration, read) &&
+                                                       memcmp(&read, &calibration, sizeof(read)) == 0);
+        });
+    }
+
+    void testPowerCuts() {
+        uint32_t generation = 0;
+
+        boot("Boot before the power cuts", [&]() {
+            for (uint32_t index = 0; index < CutKeys; index++) {
+                Settings::set(KeyCut + index, pattern(KeyCut + index, 0, 16).data(), 16);
+            }
+
+            Settings::flush(FlushTimeoutMs);
+        });
+
+        // A batch of CutKeys records is 192 bytes; cut it at every stage, including the headers of new sectors
+        for (int64_t cut = 0; cut < 200; cut += 7, generation += 2) {
+            gFlash->cutAfterBytes = cut;
+
+            boot("Boot with a power cut after " + std::to_string(cut) + " bytes", [&]() {
+                for (uint32_t index = 0; index < CutKeys; index++) {
+                    Settings::set(KeyCut + index, pattern(KeyCut + index, generation + 1, 16).data(), 16);
+                }
+
+                Settings::flush(FlushTimeoutMs);
+            }, true);
+
+            gFlash->cutAfterBytes = -1;
+
+            boot("Boot after a power cut", [&]() {
+                for (uint32_t index = 0; index < CutKeys; index++) {
+                    const uint32_t key = KeyCut + index;
+
+                    if (!holds(key, pattern(key, generation, 16)) && !holds(key, pattern(key, generation + 1, 16))) {
+                        gPowerCuts->neither++;
+                    }
+
+                    Settings::set(key, pattern(key, generation + 2, 16).data(), 16);
+                }
+
+                if (!Settings::flush(FlushTimeoutMs)) {
+                    check("The store is written after a power cut of " + std::to_string(cut) + " bytes", false);
+                }
+            });
+
+            boot("Check after a power cut", [&]() {
+                for (uint32_t index = 0; index < CutKeys; index++) {
+                    if (!holds(KeyCut + index, pattern(KeyCut + index, generation + 2, 16))) {
+                        gPowerCuts->lost++;
+                    }
+                }
+
+                // As well as the values written before the power cuts began
+                if (!holds(KeyLog, pattern(KeyLog, LogRounds - 1, 200))) {
+                    gPowerCuts->lost++;
+                }
+            });
+        }
+
+        check("After a power cut, every value is the old or the new one", gPowerCuts->neither == 0,
+              std::to_string(gPowerCuts->neither) + " values");
+        check("The store keeps working after power cuts", gPowerCuts->lost == 0, std::to_string(gPowerCuts->lost) + " values lost");
+    }
+
+} // namespace
+
+
+namespace T76::Core::Flash {
+
+    bool erase(uint32_t offset, std::size_t length) {
+        if (offset % FLASH_SECTOR_SIZE != 0 || length % FLASH_SECTOR_SIZE != 0 || offset + length > RegionSize) {
+            gFlash->misused++;
+            return false;
+        }
+
+        memset(gFlash->image + offset, 0xff, length);
+        return true;
+    }
+
+    bool program(uint32_t offset, const void *data, std::size_t length) {
+        if (offset % FLASH_PAGE_SIZE != 0 || offset + length > RegionSize) {
+            gFlash->misused++;
+            return false;
+        }
+
+        if (gFlash->failPrograms > 0) {
+            gFlash->failPrograms--;
+            return false;
+        }
+
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+        for (std::size_t index = 0; index < length; index++) {
+            if (gFlash->cutAfterBytes == 0) {
+                std::cout.flush();
+                _exit(PowerCutExit);
+            }
+
+            if (gFlash->cutAfterBytes > 0) {
+                gFlash->cutAfterBytes--;
+            }
+
+            // Programming can only clear bits, so a byte other than 0xff must land on an erased one
+            uint8_t &target = gFlash->image[offset + index];
+
+            if (bytes[index] != 0xff && target != 0xff) {
+                gFlash->overwrites++;
+            }
+
+            target &= bytes[index];
+        }
+
+        return true;
+    }
+
+} // namespace T76::Core::Flash
+
+
+int main() {
+    std::cout << "=== Settings Test ===" << std::endl;
+
+    // Shared with every boot
+    void *flash = mmap(nullptr, sizeof(HostFlash), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    void *powerCuts = mmap(nullptr, sizeof(PowerCutResults), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if (flash == MAP_FAILED || powerCuts == MAP_FAILED) {
+        check("Map the shared memory", false);
+        return 1;
+    }
+
+    gFlash = static_cast<HostFlash *>(flash);
+    gPowerCuts = static_cast<PowerCutResults *>(powerCuts);
+    memset(gFlash->image, 0xff, sizeof(gFlash->image));
+    gFlash->cutAfterBytes = -1;
+    hostFlashImage = gFlash->image;
+
+    testBasics();
+    testWear();
+    testFailures();
+    testPowerCuts();
+
+    check("Programs only write over erased bytes", gFlash->overwrites == 0, std::to_string(gFlash->overwrites) + " bytes");
+    check("Flash operations stay aligned and inside the region", gFlash->misused == 0, std::to_string(gFlash->misused) + " operations");
+
+    std::cout << "\n=== Settings Test Complete ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file device.cpp
+ * @brief Instrument run by the host simulation
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#include "device.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include <t76/memory.hpp>
+
+
+using namespace T76::Sim;
+
+
+Device::Device() : _usbInterface(*this), _interpreter(*this) {
+    // Constant queries, such as *IDN?, are answered over USBTMC
+    _interpreter.setResponseWriter(T76::Core::USB::Interface::usbtmcResponseWriter, &_usbInterface);
+}
+
+void Device::init() {
+    _usbInterface.init();
+}
+
+void Device::_resetInstrument(T76::SCPI::Parameters params) {
+    _interpreter.reset();
+    _value = 0;
+}
+
+void Device::_setValue(T76::SCPI::Parameters params) {
+    _value = params[0].numberValue;
+}
+
+void Device::_queryValue(T76::SCPI::Parameters params) {
+    char response[32];
+
+    snprintf(response, sizeof(response), "%g", _value);
+    _usbInterface.sendUSBTMCBulkData(std::string(response));
+}
+
+void Device::_queryData(T76::SCPI::Parameters params) {
+    if (params[0].numberValue < 1 || params[0].numberValue > maxDataLength) {
+        _interpreter.addError(-222, "Data out of range");
+        return;
+    }
+
+    // The payload and its newline are written straight into the bulk IN ring
+    size_t length = static_cast<size_t>(params[0].numberValue) + 1;
+
+    _usbInterface.fillUSBTMCBulkData(length, _fillData, &length);
+}
+
+void Device::_fillData(void *context, uint8_t *destination, size_t offset, size_t length) {
+    const size_t total = *static_cast<size_t*>(context);
+
+    for (size_t index = 0; index < length; index++) {
+        const size_t position = offset + index;
+
+        destination[index] = position == total - 1 ? '\n' : static_cast<uint8_t>('A' + position % 26);
+    }
+}
+
+void Device::_queryMemoryStats(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(T76::Core::Memory::allocationStatsReport());
+}
+
+void Device::_queryUSBStats(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(_usbInterface.statsReport());
+}
+
+void Device::_queryUSBLatency(T76::SCPI::Parameters params) {
+    _usbInterface.sendUSBTMCBulkData(_usbInterface.dispatchLatencyReport());
+}
+
+void Device::_resetUSBStats(T76::SCPI::Parameters params) {
+    _usbInterface.resetStats();
+}
+
+void Device::_onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) {
+    _interpreter.processInput(data, length);
+
+    if (transfer_complete) {
+        _interpreter.processInputCharacter('\n'); // Finalize the command if transfer is complete
+    }
+}
+
+void Device::_onVendorBytesReceived(const uint8_t *data, size_t length) {
+    _usbInterface.sendVendorBulkData(std::vector<uint8_t>(data, data + length));
+}
+
+void Device::_onWinUSBBulkBytesReceived(const uint8_t *data, size_t length) {
+    _usbInterface.sendWinUSBBulkData(std::vector<uint8_t>(data, data + length));
+}
+
+void Device::_onVendorDataReceived(const std::vector<uint8_t> &data) {
+    // Handled by _onVendorBytesReceived()
+}
+
+bool Device::_onVendorControlTransferIn(uint8_t port, const tusb_control_request_t *request) {
+    return false;
+}
+
+bool Device::_onVendorControlTransferOut(uint8_t request, uint16_t value, const std::vector<uint8_t> &data) {
+    return false;
+}
+
+void Device::_onUSBTMCDataReceived(const std::vector<uint8_t> &data, bool transfer_complete) {
+    // Handled by _onUSBTMCBytesReceived()
+}
+
+void Device::_onUSBTMCAbortBulkIn() {
+}
+
+void Device::_onUSBTMCAbortBulkOut() {
+}
+
+void Device::_onUSBTMCClear() {
+    _interpreter.reset();
+}
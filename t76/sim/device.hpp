@@ -0,0 +1,73 @@
+/**
+ * @file device.hpp
+ * @brief Instrument run by the host simulation
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * A minimal instrument, along the lines of the blinky example, that puts the
+ * framework's USB interface and SCPI interpreter to work without anything
+ * specific to the RP2350: SCPI commands arrive over USBTMC, and data written
+ * to the vendor and WinUSB interfaces is echoed back.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <t76/scpi_interpreter.hpp>
+#include <t76/usb_interface.hpp>
+
+
+namespace T76::Sim {
+
+    class Device : public T76::Core::USB::InterfaceDelegate {
+    public:
+
+        /**
+         * @brief Largest payload SIMulate:DATA? returns, which keeps each response in the bulk IN ring
+         */
+        static constexpr size_t maxDataLength = 1024;
+
+        Device();
+
+        /**
+         * @brief Start the USB interface; call before the scheduler starts.
+         */
+        void init();
+
+        // SCPI handlers, see scpi.yaml
+
+        void _resetInstrument(T76::SCPI::Parameters params);
+        void _setValue(T76::SCPI::Parameters params);
+        void _queryValue(T76::SCPI::Parameters params);
+        void _queryData(T76::SCPI::Parameters params);
+        void _queryMemoryStats(T76::SCPI::Parameters params);
+        void _queryUSBStats(T76::SCPI::Parameters params);
+        void _queryUSBLatency(T76::SCPI::Parameters params);
+        void _resetUSBStats(T76::SCPI::Parameters params);
+
+    protected:
+        T76::Core::USB::Interface _usbInterface;
+        T76::SCPI::Interpreter<Device> _interpreter;
+        double _value = 0;
+
+        static void _fillData(void *context, uint8_t *destination, size_t offset, size_t length);
+
+        // InterfaceDelegate
+
+        void _onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) override;
+        void _onVendorBytesReceived(const uint8_t *data, size_t length) override;
+        void _onWinUSBBulkBytesReceived(const uint8_t *data, size_t length) override;
+
+        void _onVendorDataReceived(const std::vector<uint8_t> &data) override;
+        bool _onVendorControlTransferIn(uint8_t port, const tusb_control_request_t *request) override;
+        bool _onVendorControlTransferOut(uint8_t request, uint16_t value, const std::vector<uint8_t> &data) override;
+        void _onUSBTMCDataReceived(const std::vector<uint8_t> &data, bool transfer_complete) override;
+        void _onUSBTMCAbortBulkIn() override;
+        void _onUSBTMCAbortBulkOut() override;
+        void _onUSBTMCClear() override;
+
+    }; // class Device
+
+} // namespace T76::Sim
@@ -0,0 +1,21 @@
+/**
+ * @file host_allocator.h
+ * @brief Keeps the host's C allocator in the simulation
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Included ahead of memory.cpp, whose malloc(), free(), calloc() and
+ * realloc() replace the C library's on the device. Here they are compiled
+ * under other names, so that only operator new and delete use the FreeRTOS
+ * heap. <cstdlib> removes macros with these names when it is included, so it
+ * is included first.
+ *
+ */
+
+#pragma once
+
+#include <cstdlib>
+
+#define malloc t76_sim_malloc
+#define free t76_sim_free
+#define calloc t76_sim_calloc
+#define realloc t76_sim_realloc
@@ -0,0 +1,352 @@
+/**
+ * @file main.cpp
+ * @brief Entry point of the host simulation
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Usage: t76_sim [--iterations N] SESSION
+ *
+ * Starts the simulated instrument, plays the session through the simulated
+ * host N times (1 by default), and prints the figures of the run as a single
+ * line of JSON. A session is a text file with one step per line:
+ *
+ *   # comment
+ *   > MESSAGE       send MESSAGE over USBTMC
+ *   < RESPONSE      read a USBTMC response, which must be RESPONSE
+ *   <*              read a USBTMC response, whatever it holds
+ *   V> DATA         send DATA on the vendor interface
+ *   V< DATA         read as many bytes as DATA has from the vendor interface, which must be DATA
+ *   W> DATA         send DATA on the WinUSB interface
+ *   W< DATA         read from the WinUSB interface, as for V<
+ *
+ * Responses are compared without their trailing newline. The latency of a
+ * read is measured from the start of the last write to the end of the read.
+ * Allocations made by the host are left out of the allocation counts, so
+ * that they only cover the framework.
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <pico/time.h>
+#include <t76/boot_profile.hpp>
+#include <t76/memory.hpp>
+
+#include "device.hpp"
+#include "usb_host.hpp"
+
+
+namespace {
+
+    constexpr TickType_t hostTimeout = pdMS_TO_TICKS(1000);
+    constexpr configSTACK_DEPTH_TYPE hostTaskStackSize = 16384;
+
+    enum class StepType : uint8_t {
+        Write,
+        Read,
+        ReadAny,
+        VendorWrite,
+        VendorRead,
+        WinUSBWrite,
+        WinUSBRead,
+    };
+
+    struct Step {
+        StepType type;
+        std::string data;
+    };
+
+    struct Run {
+        std::string session;
+        uint32_t iterations = 1;
+        std::vector<Step> steps;
+
+        uint32_t commands = 0;
+        uint64_t bytesOut = 0;
+        uint64_t bytesIn = 0;
+        uint32_t mismatches = 0;
+        uint32_t timeouts = 0;
+        std::vector<uint32_t> latencies;
+    };
+
+    Run gRun;
+
+    bool loadSession(const char *path, std::vector<Step> &steps) {
+        static const struct {
+            const char *prefix;
+            StepType type;
+        } prefixes[] = {
+            {"V> ", StepType::VendorWrite},
+            {"V< ", StepType::VendorRead},
+            {"W> ", StepType::WinUSBWrite},
+            {"W< ", StepType::WinUSBRead},
+            {"<*", StepType::ReadAny},
+            {"> ", StepType::Write},
+            {"< ", StepType::Read},
+        };
+
+        std::ifstream file(path);
+        std::string line;
+        uint32_t number = 0;
+
+        if (!file) {
+            fprintf(stderr, "Cannot open %s\n", path);
+            return false;
+        }
+
+        while (std::getline(file, line)) {
+            number++;
+
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            bool known = false;
+
+            for (const auto &prefix : prefixes) {
+                const size_t length = strlen(prefix.prefix);
+
+                if (line.compare(0, length, prefix.prefix) == 0) {
+                    steps.push_back({prefix.type, line.substr(length)});
+                    known = true;
+                    break;
+                }
+            }
+
+            if (!known) {
+                fprintf(stderr, "%s:%u: unknown step\n", path, number);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void check(const Step &step, const std::string &received) {
+        if (received != step.data) {
+            // Only the first few are shown, so that a broken run stays readable
+            if (gRun.mismatches < 5) {
+                fprintf(stderr, "Expected \"%s\", received \"%s\"\n", step.data.c_str(), received.c_str());
+            }
+
+            gRun.mismatches++;
+        }
+    }
+
+    void runStep(const Step &step, uint64_t &writeStartUs) {
+        using namespace T76::Sim;
+
+        const uint8_t *data = reinterpret_cast<const uint8_t*>(step.data.data());
+
+        switch (step.type) {
+            case StepType::Write:
+            case StepType::VendorWrite:
+            case StepType::WinUSBWrite: {
+                    bool written;
+
+                    writeStartUs = time_us_64();
+
+                    if (step.type == StepType::Write) {
+                        written = Host::writeUSBTMC(data, step.data.size(), hostTimeout);
+                        gRun.commands++;
+                    } else if (step.type == StepType::VendorWrite) {
+                        written = Host::writeVendor(data, step.data.size(), hostTimeout);
+                    } else {
+                        written = Host::writeWinUSB(data, step.data.size(), hostTimeout);
+                    }
+
+                    if (!written) {
+                        gRun.timeouts++;
+                        return;
+                    }
+
+                    gRun.bytesOut += step.data.size();
+                }
+                break;
+
+            case StepType::Read:
+            case StepType::ReadAny: {
+                    std::string response;
+
+                    if (!Host::readUSBTMC(response, hostTimeout)) {
+                        gRun.timeouts++;
+                        return;
+                    }
+
+                    gRun.latencies.push_back(static_cast<uint32_t>(time_us_64() - writeStartUs));
+                    gRun.bytesIn += response.size();
+
+                    if (!response.empty() && response.back() == '\n') {
+                        response.pop_back();
+                    }
+
+                    if (step.type == StepType::Read) {
+                        check(step, response);
+                    }
+                }
+                break;
+
+            case StepType::VendorRead:
+            case StepType::WinUSBRead: {
+                    std::string received(step.data.size(), '\0');
+                    uint8_t *buffer = reinterpret_cast<uint8_t*>(received.data());
+
+                    const size_t length = step.type == StepType::VendorRead
+                        ? Host::readVendor(buffer, received.size(), hostTimeout)
+                        : Host::readWinUSB(buffer, received.size(), hostTimeout);
+
+                    if (length < received.size()) {
+                        gRun.timeouts++;
+                        return;
+                    }
+
+                    gRun.latencies.push_back(static_cast<uint32_t>(time_us_64() - writeStartUs));
+                    gRun.bytesIn += length;
+                    check(step, received);
+                }
+                break;
+        }
+    }
+
+    uint32_t percentile(const std::vector<uint32_t> &sorted, uint32_t percent) {
+        if (sorted.empty()) {
+            return 0;
+        }
+
+        return sorted[std::min(sorted.size() - 1, sorted.size() * percent / 100)];
+    }
+
+    void report(uint64_t elapsedUs) {
+        using namespace T76::Core;
+
+        T76::Core::Memory::AllocationStats stats = {};
+        uint32_t hostAllocs = 0;
+        uint32_t hostFrees = 0;
+
+        Memory::allocationStats(stats);
+
+        for (uint8_t index = 0; index < Memory::taskAllocationStatsCount(); index++) {
+            Memory::TaskAllocationStats task;
+
+            if (Memory::taskAllocationStats(index, task) && strcmp(task.name, "SimHost") == 0) {
+                hostAllocs = task.allocCount;
+                hostFrees = task.freeCount;
+            }
+        }
+
+        std::vector<uint32_t> &latencies = gRun.latencies;
+        uint64_t latencyTotal = 0;
+
+        std::sort(latencies.begin(), latencies.end());
+
+        for (uint32_t latency : latencies) {
+            latencyTotal += latency;
+        }
+
+        const double elapsed = elapsedUs / 1e6;
+        const uint32_t allocs = stats.allocCount - hostAllocs;
+
+        printf("{\"session\":\"%s\",\"iterations\":%u,\"commands\":%u,\"bytes_out\":%llu,\"bytes_in\":%llu,"
+               "\"elapsed_s\":%.3f,\"mb_per_s\":%.3f,"
+               "\"lat_min_us\":%u,\"lat_p50_us\":%u,\"lat_p90_us\":%u,\"lat_p99_us\":%u,\"lat_max_us\":%u,\"lat_mean_us\":%.1f,"
+               "\"allocs\":%u,\"frees\":%u,\"allocs_per_command\":%.2f,\"peak_bytes\":%u,"
+               "\"first_response_us\":%u,\"mismatches\":%u,\"timeouts\":%u}\n",
+            gRun.session.c_str(),
+            gRun.iterations,
+            gRun.commands,
+            static_cast<unsigned long long>(gRun.bytesOut),
+            static_cast<unsigned long long>(gRun.bytesIn),
+            elapsed,
+            elapsed > 0 ? (gRun.bytesOut + gRun.bytesIn) / elapsed / 1e6 : 0.0,
+            latencies.empty() ? 0 : latencies.front(),
+            percentile(latencies, 50),
+            percentile(latencies, 90),
+            percentile(latencies, 99),
+            latencies.empty() ? 0 : latencies.back(),
+            latencies.empty() ? 0.0 : static_cast<double>(latencyTotal) / latencies.size(),
+            allocs,
+            stats.freeCount - hostFrees,
+            gRun.commands > 0 ? static_cast<double>(allocs) / gRun.commands : 0.0,
+            stats.peakBytesInUse,
+            BootProfile::time(BootProfile::Phase::FirstResponse),
+            gRun.mismatches,
+            gRun.timeouts);
+    }
+
+    void hostTask(void *param) {
+        T76::Sim::Host::connect();
+
+        // Only the session itself is counted, not the device's startup
+        T76::Core::Memory::resetAllocationStats();
+
+        const uint64_t startUs = time_us_64();
+        uint64_t writeStartUs = startUs;
+
+        for (uint32_t iteration = 0; iteration < gRun.iterations; iteration++) {
+            for (const Step &step : gRun.steps) {
+                runStep(step, writeStartUs);
+            }
+        }
+
+        report(time_us_64() - startUs);
+
+        // The scheduler of the POSIX port cannot be stopped cleanly from a task
+        fflush(stdout);
+        fflush(stderr);
+        _Exit(gRun.mismatches == 0 && gRun.timeouts == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+} // namespace
+
+
+extern "C" void vAssertCalled(const char *file, unsigned long line) {
+    fprintf(stderr, "FreeRTOS assertion failed at %s:%lu\n", file, line);
+    fflush(stderr);
+    abort();
+}
+
+int main(int argc, char **argv) {
+    const char *path = nullptr;
+
+    for (int index = 1; index < argc; index++) {
+        if (strcmp(argv[index], "--iterations") == 0 && index + 1 < argc) {
+            gRun.iterations = static_cast<uint32_t>(strtoul(argv[++index], nullptr, 10));
+        } else {
+            path = argv[index];
+        }
+    }
+
+    if (path == nullptr || gRun.iterations == 0) {
+        fprintf(stderr, "Usage: %s [--iterations N] SESSION\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    T76::Core::BootProfile::init();
+    T76::Core::Memory::init();
+
+    if (!loadSession(path, gRun.steps)) {
+        return EXIT_FAILURE;
+    }
+
+    // Named after the file, without its directory and extension
+    gRun.session = path;
+    gRun.session.erase(0, gRun.session.find_last_of('/') + 1);
+    gRun.session.erase(std::min(gRun.session.size(), gRun.session.find('.')));
+
+    static T76::Sim::Device device;
+
+    device.init();
+
+    xTaskCreate(hostTask, "SimHost", hostTaskStackSize, nullptr, tskIDLE_PRIORITY + 1, nullptr);
+    vTaskStartScheduler();
+
+    return EXIT_FAILURE;
+}
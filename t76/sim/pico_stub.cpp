@@ -0,0 +1,46 @@
+/**
+ * @file pico_stub.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Host implementation of the Pico SDK functions the framework calls.
+ *
+ * The microsecond timer is the host's monotonic clock, counted from the
+ * first reading so that, as on the device, it starts near zero at boot.
+ *
+ */
+
+#include <ctime>
+
+#include <pico/stdio.h>
+#include <pico/time.h>
+
+
+namespace {
+
+    uint64_t monotonicUs() {
+        timespec now;
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000000u + static_cast<uint64_t>(now.tv_nsec) / 1000u;
+    }
+
+    // Taken during static initialization, before main() and any task
+    const uint64_t gBootUs = monotonicUs() - 1;
+
+    stdio_driver_t *gStdioDriver = nullptr;
+
+} // namespace
+
+
+extern "C" uint64_t time_us_64(void) {
+    return monotonicUs() - gBootUs;
+}
+
+extern "C" bool stdio_init_all(void) {
+    return true;
+}
+
+extern "C" void stdio_set_driver_enabled(stdio_driver_t *driver, bool enabled) {
+    // Extra drivers only count output on the device; nothing is routed to them here
+    gStdioDriver = enabled ? driver : nullptr;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file board.h
+ * @brief Host stand-in for TinyUSB's board support header
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void board_init(void);
+
+#ifdef __cplusplus
+}
+#endif
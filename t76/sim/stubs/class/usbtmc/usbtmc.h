@@ -0,0 +1,138 @@
+/**
+ * @file usbtmc.h
+ * @brief Host stand-in for TinyUSB's USBTMC and USB488 definitions
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Message layouts follow the USBTMC 1.0 and USB488 1.0 specifications.
+ *
+ */
+
+#pragma once
+
+#include "common/tusb_common.h"
+
+#define USBTMC_VERSION          0x0100
+#define USBTMC_488_VERSION      0x0100
+
+typedef enum {
+    USBTMC_MSGID_DEV_DEP_MSG_OUT = 1u,
+    USBTMC_MSGID_DEV_DEP_MSG_IN = 2u,
+    USBTMC_MSGID_VENDOR_SPECIFIC_MSG_OUT = 126u,
+    USBTMC_MSGID_VENDOR_SPECIFIC_IN = 127u,
+    USBTMC_MSGID_USB488_TRIGGER = 128u,
+} usbtmc_msgid_enum;
+
+typedef enum {
+    USBTMC_STATUS_SUCCESS = 0x01,
+    USBTMC_STATUS_PENDING = 0x02,
+    USBTMC_STATUS_FAILED = 0x80,
+    USBTMC_STATUS_TRANSFER_NOT_IN_PROGRESS = 0x81,
+    USBTMC_STATUS_SPLIT_NOT_IN_PROGRESS = 0x82,
+    USBTMC_STATUS_SPLIT_IN_PROGRESS = 0x83
+} usbtmc_status_enum;
+
+#define USB488_bNOTIFY1_SRQ     0x81
+
+typedef struct TU_ATTR_PACKED {
+    uint8_t MsgID;
+    uint8_t bTag;
+    uint8_t bTagInverse;
+    uint8_t _reserved;
+} usbtmc_msg_header_t;
+
+typedef struct TU_ATTR_PACKED {
+    usbtmc_msg_header_t header;
+    uint8_t data[8];
+} usbtmc_msg_generic_t;
+
+typedef struct TU_ATTR_PACKED {
+    usbtmc_msg_header_t header;
+    uint32_t TransferSize;
+
+    struct TU_ATTR_PACKED {
+        uint8_t EOM : 1;
+    } bmTransferAttributes;
+
+    uint8_t _reserved[3];
+} usbtmc_msg_request_dev_dep_out;
+
+typedef struct TU_ATTR_PACKED {
+    usbtmc_msg_header_t header;
+    uint32_t TransferSize;
+
+    struct TU_ATTR_PACKED {
+        uint8_t TermCharEnabled : 1;
+    } bmTransferAttributes;
+
+    uint8_t TermChar;
+    uint8_t _reserved[2];
+} usbtmc_msg_request_dev_dep_in;
+
+typedef struct TU_ATTR_PACKED {
+    usbtmc_msg_header_t header;
+    uint32_t TransferSize;
+
+    struct TU_ATTR_PACKED {
+        uint8_t EOM : 1;
+    } bmTransferAttributes;
+
+    uint8_t _reserved[3];
+} usbtmc_msg_dev_dep_msg_in_header_t;
+
+typedef struct TU_ATTR_PACKED {
+    uint8_t USBTMC_status;
+
+    struct TU_ATTR_PACKED {
+        uint8_t BulkInFifoBytes : 1;
+    } bmClear;
+} usbtmc_get_clear_status_rsp_t;
+
+typedef struct TU_ATTR_PACKED {
+    uint8_t USBTMC_status;
+
+    struct TU_ATTR_PACKED {
+        uint8_t BulkInFifoBytes : 1;
+    } bmAbortBulkIn;
+
+    uint8_t _reserved[2];
+    uint32_t NBYTES_RXD_TXD;
+} usbtmc_check_abort_bulk_rsp_t;
+
+typedef struct TU_ATTR_PACKED {
+    uint8_t USBTMC_status;
+    uint8_t _reserved;
+    uint16_t bcdUSBTMC;
+
+    struct TU_ATTR_PACKED {
+        uint8_t listenOnly : 1;
+        uint8_t talkOnly : 1;
+        uint8_t supportsIndicatorPulse : 1;
+    } bmIntfcCapabilities;
+
+    struct TU_ATTR_PACKED {
+        uint8_t canEndBulkInOnTermChar : 1;
+    } bmDevCapabilities;
+
+    uint8_t _reserved2[6];
+    uint16_t bcdUSB488;
+
+    struct TU_ATTR_PACKED {
+        uint8_t supportsTrigger : 1;
+        uint8_t supportsREN_GTL_LLO : 1;
+        uint8_t is488_2 : 1;
+    } bmIntfcCapabilities488;
+
+    struct TU_ATTR_PACKED {
+        uint8_t DT1 : 1;
+        uint8_t RL1 : 1;
+        uint8_t SR1 : 1;
+        uint8_t SCPI : 1;
+    } bmDevCapabilities488;
+
+    uint8_t _reserved3[8];
+} usbtmc_response_capabilities_488_t;
+
+typedef struct TU_ATTR_PACKED {
+    uint8_t bNotify1;
+    uint8_t StatusByte;
+} usbtmc_srq_interrupt_488_t;
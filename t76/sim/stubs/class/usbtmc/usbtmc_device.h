@@ -0,0 +1,26 @@
+/**
+ * @file usbtmc_device.h
+ * @brief Host stand-in for TinyUSB's USBTMC class driver
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The application callbacks are declared by the framework's callbacks.hpp.
+ *
+ */
+
+#pragma once
+
+#include "class/usbtmc/usbtmc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool tud_usbtmc_start_bus_read(void);
+
+bool tud_usbtmc_transmit_dev_msg_data(const void *data, size_t len, bool endOfMessage, bool usingTermChar);
+
+bool tud_usbtmc_transmit_notification_data(const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,18 @@
+/**
+ * @file tusb_common.h
+ * @brief Host stand-in for TinyUSB's common definitions
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define TU_ATTR_PACKED          __attribute__((packed))
+
+#include "common/tusb_types.h"
+#include "common/tusb_verify.h"
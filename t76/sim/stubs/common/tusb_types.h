@@ -0,0 +1,53 @@
+/**
+ * @file tusb_types.h
+ * @brief Host stand-in for TinyUSB's USB types
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef enum {
+    TUSB_DIR_OUT = 0,
+    TUSB_DIR_IN  = 1,
+} tusb_dir_t;
+
+typedef enum {
+    TUSB_REQ_TYPE_STANDARD = 0,
+    TUSB_REQ_TYPE_CLASS,
+    TUSB_REQ_TYPE_VENDOR,
+    TUSB_REQ_TYPE_INVALID
+} tusb_request_type_t;
+
+typedef enum {
+    TUSB_REQ_RCPT_DEVICE = 0,
+    TUSB_REQ_RCPT_INTERFACE,
+    TUSB_REQ_RCPT_ENDPOINT,
+    TUSB_REQ_RCPT_OTHER
+} tusb_request_recipient_t;
+
+typedef struct __attribute__((packed)) {
+    union {
+        struct __attribute__((packed)) {
+            uint8_t recipient :  5;
+            uint8_t type      :  2;
+            uint8_t direction :  1;
+        } bmRequestType_bit;
+
+        uint8_t bmRequestType;
+    };
+
+    uint8_t  bRequest;
+    uint16_t wValue;
+    uint16_t wIndex;
+    uint16_t wLength;
+} tusb_control_request_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint8_t bScheme;
+    char    url[127];
+} tusb_desc_webusb_url_t;
@@ -0,0 +1,11 @@
+/**
+ * @file tusb_verify.h
+ * @brief Host stand-in for TinyUSB's verification macros
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#pragma once
+
+#define TU_VERIFY(_cond, ...)   do { if (!(_cond)) return false; } while (0)
+#define TU_ASSERT(_cond, ...)   TU_VERIFY(_cond)
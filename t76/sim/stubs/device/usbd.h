@@ -0,0 +1,31 @@
+/**
+ * @file usbd.h
+ * @brief Host stand-in for TinyUSB's device API
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#pragma once
+
+#include "common/tusb_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    CONTROL_STAGE_IDLE,
+    CONTROL_STAGE_SETUP,
+    CONTROL_STAGE_DATA,
+    CONTROL_STAGE_ACK
+};
+
+void tud_task(void);
+
+bool tud_mounted(void);
+
+bool tud_control_xfer(uint8_t rhport, tusb_control_request_t const *request, void *buffer, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
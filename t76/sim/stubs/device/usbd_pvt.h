@@ -0,0 +1,26 @@
+/**
+ * @file usbd_pvt.h
+ * @brief Host stand-in for TinyUSB's endpoint API
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#pragma once
+
+#include "common/tusb_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*osal_task_func_t)(void *param);
+
+bool usbd_edpt_busy(uint8_t rhport, uint8_t ep_addr);
+
+bool usbd_edpt_xfer(uint8_t rhport, uint8_t ep_addr, uint8_t *buffer, uint16_t total_bytes);
+
+void usbd_defer_func(osal_task_func_t func, void *param, bool in_isr);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,10 @@
+/**
+ * @file sync.h
+ * @brief Host stand-in for the Pico SDK's hardware synchronization header
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#pragma once
+
+#include <pico/platform.h>
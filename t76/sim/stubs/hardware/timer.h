@@ -0,0 +1,27 @@
+/**
+ * @file timer.h
+ * @brief Host stand-in for the Pico SDK's timer header
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The microsecond counter is the host's monotonic clock, counted from the
+ * start of the simulation; see pico_stub.cpp.
+ *
+ */
+
+#pragma once
+
+#include <pico/platform.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,42 @@
+/**
+ * @file critical_section.h
+ * @brief Host stand-in for the Pico SDK's critical sections
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * With a single simulated core, a FreeRTOS critical section excludes every
+ * other task, as the spin lock and masked interrupts do on the device.
+ *
+ */
+
+#pragma once
+
+#include <pico/platform.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct critical_section {
+    uint8_t unused;
+} critical_section_t;
+
+static inline void critical_section_init(critical_section_t *crit_sec) {
+    (void)crit_sec;
+}
+
+static inline void critical_section_enter_blocking(critical_section_t *crit_sec) {
+    (void)crit_sec;
+    taskENTER_CRITICAL();
+}
+
+static inline void critical_section_exit(critical_section_t *crit_sec) {
+    (void)crit_sec;
+    taskEXIT_CRITICAL();
+}
+
+#ifdef __cplusplus
+}
+#endif
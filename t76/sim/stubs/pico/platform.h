@@ -0,0 +1,32 @@
+/**
+ * @file platform.h
+ * @brief Host stand-in for the Pico SDK's platform header
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The simulation runs every task on a single simulated core and never in an
+ * exception handler.
+ *
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline uint get_core_num(void) {
+    return 0;
+}
+
+static inline uint __get_current_exception(void) {
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,27 @@
+/**
+ * @file stdio.h
+ * @brief Host stand-in for the Pico SDK's stdio header
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Extra drivers are recorded and otherwise ignored; the simulation's own
+ * output goes straight to the host's stdout.
+ *
+ */
+
+#pragma once
+
+#include <pico/platform.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct stdio_driver stdio_driver_t;
+
+bool stdio_init_all(void);
+
+void stdio_set_driver_enabled(stdio_driver_t *driver, bool enabled);
+
+#ifdef __cplusplus
+}
+#endif
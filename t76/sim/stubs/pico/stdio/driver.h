@@ -0,0 +1,17 @@
+/**
+ * @file driver.h
+ * @brief Host stand-in for the Pico SDK's stdio driver structure
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#pragma once
+
+#include <pico/stdio.h>
+
+struct stdio_driver {
+    void (*out_chars)(const char *buf, int len);
+    void (*out_flush)(void);
+    int (*in_chars)(char *buf, int len);
+    stdio_driver_t *next;
+};
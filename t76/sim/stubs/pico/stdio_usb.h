@@ -0,0 +1,12 @@
+/**
+ * @file stdio_usb.h
+ * @brief Host stand-in for the Pico SDK's USB stdio header
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The simulation has no CDC port; stdio is the host's.
+ *
+ */
+
+#pragma once
+
+#include <pico/stdio.h>
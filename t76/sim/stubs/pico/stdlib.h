@@ -0,0 +1,12 @@
+/**
+ * @file stdlib.h
+ * @brief Host stand-in for the Pico SDK's standard library header
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#pragma once
+
+#include <pico/platform.h>
+#include <pico/stdio.h>
+#include <pico/time.h>
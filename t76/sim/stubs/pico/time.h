@@ -0,0 +1,10 @@
+/**
+ * @file time.h
+ * @brief Host stand-in for the Pico SDK's time header
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ */
+
+#pragma once
+
+#include <hardware/timer.h>
@@ -0,0 +1,28 @@
+/**
+ * @file tusb.h
+ * @brief Host stand-in for TinyUSB's main header
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Declares the part of TinyUSB's device API that the framework uses. The
+ * functions are implemented by usb_stub.cpp, which takes the place of the
+ * device stack and its class drivers.
+ *
+ */
+
+#pragma once
+
+#include "tusb_option.h"
+#include "common/tusb_common.h"
+#include "device/usbd.h"
+#include "class/usbtmc/usbtmc_device.h"
+#include "class/vendor/vendor_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool tusb_init(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,25 @@
+/**
+ * @file tusb_option.h
+ * @brief Host stand-in for TinyUSB's option header
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Reads the framework's tusb_config.h, as TinyUSB does, so that the buffer
+ * sizes the interface depends on are the device's.
+ *
+ */
+
+#pragma once
+
+#define OPT_MODE_NONE           0x0000
+#define OPT_MODE_DEVICE         0x0001
+
+#define OPT_OS_NONE             1
+#define OPT_OS_FREERTOS         2
+
+#include "tusb_config.h"
+
+#define TUD_OPT_HIGH_SPEED      0
+
+#ifndef CFG_TUD_VENDOR_EPSIZE
+#define CFG_TUD_VENDOR_EPSIZE   64
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file usb_host.hpp
+ * @brief Host side of the simulated USB bus
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The simulation replaces TinyUSB with usb_stub.cpp, which delivers packets
+ * to the framework's callbacks from the USB runtime task, as the device stack
+ * does. These functions play the part of the host: they are called from a
+ * FreeRTOS task of the simulation, block it while the device works, and
+ * give up after a timeout instead of waiting forever on a device that does
+ * not answer.
+ *
+ * USBTMC transfers follow the USBTMC framing: a write is one DEV_DEP_MSG_OUT
+ * transfer, split into 64-byte packets, and a read sends REQUEST_DEV_DEP_MSG_IN
+ * until the device ends a transfer with EOM. A read that times out aborts the
+ * bulk IN transfer, as VISA libraries do.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <FreeRTOS.h>
+
+
+namespace T76::Sim::Host {
+
+    /**
+     * @brief Largest transfer the host asks the device for in a single USBTMC read
+     */
+    constexpr uint32_t usbtmcTransferSize = 4096;
+
+    /**
+     * @brief Configure the device, which opens its interfaces.
+     */
+    void connect();
+
+    /**
+     * @brief Send a USBTMC message.
+     * @param data The message.
+     * @param length The length of the message.
+     * @param timeout How long to wait for the device to accept each packet.
+     * @return false if the device stopped accepting packets.
+     */
+    bool writeUSBTMC(const uint8_t *data, size_t length, TickType_t timeout);
+
+    /**
+     * @brief Read a USBTMC response, up to the end of the message.
+     * @param response Set to the response.
+     * @param timeout How long to wait for each transfer.
+     * @return false if the device did not answer, in which case the transfer was aborted.
+     */
+    bool readUSBTMC(std::string &response, TickType_t timeout);
+
+    /**
+     * @brief Send data on the vendor bulk OUT endpoint.
+     * @return false if the device stopped accepting packets.
+     */
+    bool writeVendor(const uint8_t *data, size_t length, TickType_t timeout);
+
+    /**
+     * @brief Read data from the vendor bulk IN endpoint.
+     * @return The number of bytes read, which is less than length if the device sent nothing for timeout.
+     */
+    size_t readVendor(uint8_t *data, size_t length, TickType_t timeout);
+
+    /**
+     * @brief Send data on the WinUSB bulk OUT endpoint.
+     * @return false if the device stopped accepting packets.
+     */
+    bool writeWinUSB(const uint8_t *data, size_t length, TickType_t timeout);
+
+    /**
+     * @brief Read data from the WinUSB bulk IN endpoint.
+     * @return The number of bytes read, which is less than length if the device sent nothing for timeout.
+     */
+    size_t readWinUSB(uint8_t *data, size_t length, TickType_t timeout);
+
+    /**
+     * @brief Get the number of SRQ notifications the device has sent.
+     */
+    uint32_t srqCount();
+
+} // namespace T76::Sim::Host
@@ -0,0 +1,669 @@
+/**
+ * @file usb_stub.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Host implementation of the TinyUSB functions the framework calls, and of
+ * the simulated host that drives them.
+ *
+ * As with TinyUSB's FreeRTOS OSAL, everything the bus does is posted to an
+ * event queue, and tud_task(), which the interface's runtime task calls in a
+ * loop, takes one event at a time and runs the matching class callbacks. The
+ * callbacks therefore run in the same task, and in the same order, as on the
+ * device, and the interface cannot tell the difference.
+ *
+ * Host packets wait in one queue per OUT endpoint. USBTMC packets are only
+ * taken while the endpoint is armed by tud_usbtmc_start_bus_read(), so that
+ * the interface's flow control works as it does with the real driver. Bulk
+ * IN data goes to stream buffers that the host reads; a transfer that does
+ * not fit waits until the host has made room.
+ *
+ * Control transfers, the CDC port and the streaming interfaces are not
+ * simulated.
+ *
+ */
+
+#include "usb_host.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <semphr.h>
+#include <stream_buffer.h>
+#include <task.h>
+
+#include "callbacks.hpp"
+#include "device/usbd_pvt.h"
+
+
+// Descriptors the interface sends in answer to vendor control requests
+
+uint8_t const desc_ms_os_20[] = {
+    0x0A, 0x00,                 // wLength
+    0x00, 0x00,                 // wDescriptorType: set header
+    0x00, 0x00, 0x03, 0x06,     // dwWindowsVersion: Windows 8.1
+    0x0A, 0x00                  // wTotalLength
+};
+
+const tusb_desc_webusb_url_t desc_url = {
+    .bLength = 3 + sizeof(T76_IC_USB_URL) - 1,
+    .bDescriptorType = 3,
+    .bScheme = 1,
+    .url = T76_IC_USB_URL
+};
+
+uint8_t reset_interface_number = ITF_NUM_RESET;
+uint8_t winusb_interface_number = ITF_NUM_WINUSB;
+
+
+namespace {
+
+    constexpr size_t packetSize = 64;                   // Full-speed bulk packet
+    constexpr size_t usbtmcHeaderSize = 12;             // Bulk-OUT header of every USBTMC transfer
+    constexpr size_t outQueueDepth = 16;                // Packets the host can queue on each OUT endpoint
+    constexpr size_t eventQueueDepth = 32;              // Every event kind is posted at most a few times at once
+    constexpr size_t captureSize = 64 * 1024;           // Bulk IN data the host has not read yet
+
+    enum class EventType : uint8_t {
+        Mount,
+        USBTMCPoll,
+        USBTMCInComplete,
+        USBTMCAbortBulkIn,
+        NotificationComplete,
+        VendorPoll,
+        WinUSBPoll,
+        PipeContinue,
+        PipeComplete,
+        Deferred,
+    };
+
+    struct Event {
+        EventType type;
+        osal_task_func_t func;
+        void *param;
+    };
+
+    struct Packet {
+        uint16_t length;
+        uint8_t data[packetSize];
+    };
+
+    /**
+     * @brief A bulk IN endpoint and the host's buffer behind it
+     *
+     * The FIFO holds what the device has written; a transfer moves its first
+     * inFlight bytes to the capture stream buffer, and completes once they
+     * are all there.
+     */
+    struct InPipe {
+        StreamBufferHandle_t capture;
+        uint8_t fifo[CFG_TUD_VENDOR_TX_BUFSIZE];
+        size_t length;                      // Bytes in the FIFO
+        size_t inFlight;                    // Bytes of the FIFO in the current transfer
+        size_t sent;                        // Bytes of the current transfer already captured
+        bool busy;                          // A transfer has been started
+        bool done;                          // Its completion has been posted
+        std::atomic<bool> waiting{false};   // It needs the host to read before it can go on
+        void (*complete)(uint32_t sent);
+    };
+
+    enum class USBTMCState : uint8_t {
+        Idle,
+        Receiving,
+        TxRequested,
+        Transmitting,
+    };
+
+    QueueHandle_t gEvents;
+    QueueHandle_t gUSBTMCOut;
+    QueueHandle_t gVendorOut;
+    QueueHandle_t gWinUSBOut;
+    SemaphoreHandle_t gPipeLock;
+
+    std::atomic<bool> gMounted{false};
+
+    std::atomic<bool> gUSBTMCPollPending{false};
+    std::atomic<bool> gVendorPollPending{false};
+    std::atomic<bool> gWinUSBPollPending{false};
+
+    // USBTMC driver state, only used by the runtime task
+    std::atomic<bool> gUSBTMCArmed{false};
+    USBTMCState gUSBTMCState = USBTMCState::Idle;
+    uint32_t gUSBTMCRemaining = 0;
+
+    // Last USBTMC transfer sent to the host, read by the host once gUSBTMCInDone is given
+    uint8_t gUSBTMCIn[T76::Sim::Host::usbtmcTransferSize];
+    size_t gUSBTMCInLength = 0;
+    bool gUSBTMCInEOM = false;
+    SemaphoreHandle_t gUSBTMCInDone;
+    SemaphoreHandle_t gUSBTMCAbortDone;
+    uint8_t gHostTag = 0;
+
+    std::atomic<bool> gInterruptBusy{false};
+    std::atomic<uint32_t> gSRQCount{0};
+
+    InPipe gVendorIn;
+    InPipe gWinUSBIn;
+
+    void post(EventType type, osal_task_func_t func = nullptr, void *param = nullptr) {
+        const Event event = {type, func, param};
+
+        xQueueSend(gEvents, &event, portMAX_DELAY);
+    }
+
+    void postOnce(std::atomic<bool> &pending, EventType type) {
+        if (!pending.exchange(true, std::memory_order_acq_rel)) {
+            post(type);
+        }
+    }
+
+    // Called with gPipeLock held
+    void pipeContinue(InPipe &pipe) {
+        if (!pipe.busy || pipe.done) {
+            return;
+        }
+
+        pipe.waiting.store(true, std::memory_order_release);
+        pipe.sent += xStreamBufferSend(pipe.capture, pipe.fifo + pipe.sent, pipe.inFlight - pipe.sent, 0);
+
+        if (pipe.sent < pipe.inFlight) {
+            return; // Carried on once the host reads
+        }
+
+        pipe.waiting.store(false, std::memory_order_release);
+        pipe.done = true;
+        post(EventType::PipeComplete, nullptr, &pipe);
+    }
+
+    // Called with gPipeLock held
+    void pipeStart(InPipe &pipe, size_t length) {
+        pipe.busy = true;
+        pipe.done = false;
+        pipe.inFlight = length;
+        pipe.sent = 0;
+
+        pipeContinue(pipe);
+    }
+
+    void pipeComplete(InPipe &pipe) {
+        xSemaphoreTake(gPipeLock, portMAX_DELAY);
+
+        const size_t sent = pipe.inFlight;
+
+        memmove(pipe.fifo, pipe.fifo + sent, pipe.length - sent);
+        pipe.length -= sent;
+        pipe.inFlight = 0;
+        pipe.busy = false;
+
+        xSemaphoreGive(gPipeLock);
+
+        // The callback may start the next transfer
+        pipe.complete(static_cast<uint32_t>(sent));
+    }
+
+    void vendorInComplete(uint32_t sent) {
+        tud_vendor_tx_cb(0, sent);
+
+        // Whatever was written during the transfer goes out next, as with TinyUSB's FIFO
+        xSemaphoreTake(gPipeLock, portMAX_DELAY);
+
+        if (!gVendorIn.busy && gVendorIn.length > 0) {
+            pipeStart(gVendorIn, gVendorIn.length);
+        }
+
+        xSemaphoreGive(gPipeLock);
+    }
+
+    void winUSBInComplete(uint32_t sent) {
+        t76_winusb_bulk_in_complete_cb(sent);
+    }
+
+    void initPipe(InPipe &pipe, void (*complete)(uint32_t)) {
+        pipe.capture = xStreamBufferCreate(captureSize, 1);
+        pipe.length = 0;
+        pipe.inFlight = 0;
+        pipe.sent = 0;
+        pipe.busy = false;
+        pipe.done = false;
+        pipe.complete = complete;
+    }
+
+    /**
+     * @brief Take one USBTMC packet, if the endpoint is armed, and run the driver's callbacks for it
+     */
+    void usbtmcReceive() {
+        Packet packet;
+
+        if (!gUSBTMCArmed.load(std::memory_order_acquire) || xQueueReceive(gUSBTMCOut, &packet, 0) != pdTRUE) {
+            return;
+        }
+
+        gUSBTMCArmed.store(false, std::memory_order_release);
+
+        if (gUSBTMCState == USBTMCState::Receiving) {
+            const uint32_t length = std::min<uint32_t>(gUSBTMCRemaining, packet.length);
+
+            gUSBTMCRemaining -= length;
+
+            if (gUSBTMCRemaining == 0) {
+                gUSBTMCState = USBTMCState::Idle;
+            }
+
+            tud_usbtmc_msg_data_cb(packet.data, length, gUSBTMCRemaining == 0);
+            return;
+        }
+
+        usbtmc_msg_generic_t message;
+        memcpy(&message, packet.data, sizeof(message));
+
+        switch (message.header.MsgID) {
+            case USBTMC_MSGID_DEV_DEP_MSG_OUT: {
+                    usbtmc_msg_request_dev_dep_out request;
+                    memcpy(&request, packet.data, sizeof(request));
+
+                    gUSBTMCRemaining = request.TransferSize;
+                    tud_usbtmc_msgBulkOut_start_cb(&request);
+
+                    const uint32_t length = std::min<uint32_t>(gUSBTMCRemaining, packet.length - usbtmcHeaderSize);
+
+                    gUSBTMCRemaining -= length;
+                    gUSBTMCState = gUSBTMCRemaining > 0 ? USBTMCState::Receiving : USBTMCState::Idle;
+
+                    tud_usbtmc_msg_data_cb(packet.data + usbtmcHeaderSize, length, gUSBTMCRemaining == 0);
+                }
+                break;
+
+            case USBTMC_MSGID_DEV_DEP_MSG_IN: {
+                    usbtmc_msg_request_dev_dep_in request;
+                    memcpy(&request, packet.data, sizeof(request));
+
+                    // The endpoint stays disarmed until the response has been sent
+                    gUSBTMCState = USBTMCState::TxRequested;
+                    tud_usbtmc_msgBulkIn_request_cb(&request);
+                }
+                break;
+
+            case USBTMC_MSGID_USB488_TRIGGER:
+                tud_usbtmc_msg_trigger_cb(&message);
+                tud_usbtmc_start_bus_read();
+                break;
+
+            default:
+                // Not a message the framework uses; drop it as the driver would
+                tud_usbtmc_start_bus_read();
+                break;
+        }
+    }
+
+    void usbtmcAbortBulkIn() {
+        // The request being aborted may not even have been taken yet
+        xQueueReset(gUSBTMCOut);
+
+        uint8_t status;
+        usbtmc_check_abort_bulk_rsp_t response = {};
+
+        tud_usbtmc_initiate_abort_bulk_in_cb(&status);
+        gUSBTMCState = USBTMCState::Idle;
+        tud_usbtmc_check_abort_bulk_in_cb(&response);
+
+        xSemaphoreGive(gUSBTMCAbortDone);
+    }
+
+    bool hostSend(QueueHandle_t queue, const Packet &packet, TickType_t timeout, std::atomic<bool> &pending, EventType poll) {
+        if (xQueueSend(queue, &packet, timeout) != pdTRUE) {
+            return false;
+        }
+
+        postOnce(pending, poll);
+        return true;
+    }
+
+    bool hostWrite(QueueHandle_t queue, const uint8_t *data, size_t length, TickType_t timeout, std::atomic<bool> &pending, EventType poll) {
+        for (size_t offset = 0; offset < length; offset += packetSize) {
+            Packet packet;
+
+            packet.length = static_cast<uint16_t>(std::min(packetSize, length - offset));
+            memcpy(packet.data, data + offset, packet.length);
+
+            if (!hostSend(queue, packet, timeout, pending, poll)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    size_t hostRead(InPipe &pipe, uint8_t *data, size_t length, TickType_t timeout) {
+        const TickType_t start = xTaskGetTickCount();
+        size_t received = 0;
+
+        while (received < length) {
+            const TickType_t elapsed = xTaskGetTickCount() - start;
+
+            if (elapsed > timeout) {
+                break;
+            }
+
+            received += xStreamBufferReceive(pipe.capture, data + received, length - received, timeout - elapsed);
+
+            if (pipe.waiting.exchange(false, std::memory_order_acq_rel)) {
+                post(EventType::PipeContinue, nullptr, &pipe);
+            }
+        }
+
+        return received;
+    }
+
+    uint8_t hostNextTag() {
+        // bTag runs from 1 to 255
+        gHostTag = gHostTag == 255 ? 1 : gHostTag + 1;
+        return gHostTag;
+    }
+
+} // namespace
+
+
+// TinyUSB device API
+
+extern "C" void board_init(void) {
+}
+
+extern "C" bool tusb_init(void) {
+    gEvents = xQueueCreate(eventQueueDepth, sizeof(Event));
+    gUSBTMCOut = xQueueCreate(outQueueDepth, sizeof(Packet));
+    gVendorOut = xQueueCreate(outQueueDepth, sizeof(Packet));
+    gWinUSBOut = xQueueCreate(outQueueDepth, sizeof(Packet));
+    gPipeLock = xSemaphoreCreateMutex();
+    gUSBTMCInDone = xSemaphoreCreateBinary();
+    gUSBTMCAbortDone = xSemaphoreCreateBinary();
+
+    initPipe(gVendorIn, vendorInComplete);
+    initPipe(gWinUSBIn, winUSBInComplete);
+
+    return true;
+}
+
+extern "C" void tud_task(void) {
+    Event event;
+
+    if (xQueueReceive(gEvents, &event, portMAX_DELAY) != pdTRUE) {
+        return;
+    }
+
+    switch (event.type) {
+        case EventType::Mount:
+            gMounted.store(true, std::memory_order_release);
+            tud_usbtmc_open_cb(ITF_NUM_USBTMC);
+            break;
+
+        case EventType::USBTMCPoll:
+            gUSBTMCPollPending.store(false, std::memory_order_release);
+            usbtmcReceive();
+            break;
+
+        case EventType::USBTMCInComplete:
+            gUSBTMCState = USBTMCState::Idle;
+            xSemaphoreGive(gUSBTMCInDone);
+            tud_usbtmc_msgBulkIn_complete_cb();
+            break;
+
+        case EventType::USBTMCAbortBulkIn:
+            usbtmcAbortBulkIn();
+            break;
+
+        case EventType::NotificationComplete:
+            gInterruptBusy.store(false, std::memory_order_release);
+            tud_usbtmc_notification_complete_cb();
+            break;
+
+        case EventType::VendorPoll: {
+                gVendorPollPending.store(false, std::memory_order_release);
+
+                Packet packet;
+
+                while (xQueueReceive(gVendorOut, &packet, 0) == pdTRUE) {
+                    tud_vendor_rx_cb(0, packet.data, packet.length);
+                }
+            }
+            break;
+
+        case EventType::WinUSBPoll: {
+                gWinUSBPollPending.store(false, std::memory_order_release);
+
+                Packet packet;
+
+                while (xQueueReceive(gWinUSBOut, &packet, 0) == pdTRUE) {
+                    t76_winusb_bulk_out_received_cb(packet.data, packet.length);
+                }
+            }
+            break;
+
+        case EventType::PipeContinue:
+            xSemaphoreTake(gPipeLock, portMAX_DELAY);
+            pipeContinue(*static_cast<InPipe*>(event.param));
+            xSemaphoreGive(gPipeLock);
+            break;
+
+        case EventType::PipeComplete:
+            pipeComplete(*static_cast<InPipe*>(event.param));
+            break;
+
+        case EventType::Deferred:
+            event.func(event.param);
+            break;
+    }
+}
+
+extern "C" bool tud_mounted(void) {
+    return gMounted.load(std::memory_order_acquire);
+}
+
+extern "C" bool tud_control_xfer(uint8_t rhport, tusb_control_request_t const *request, void *buffer, uint16_t len) {
+    // The host never sends control requests
+    return false;
+}
+
+extern "C" bool usbd_edpt_busy(uint8_t rhport, uint8_t ep_addr) {
+    return ep_addr == EPNUM_USBTMC_INT && gInterruptBusy.load(std::memory_order_acquire);
+}
+
+extern "C" bool usbd_edpt_xfer(uint8_t rhport, uint8_t ep_addr, uint8_t *buffer, uint16_t total_bytes) {
+    // Only the SRQ notification is sent this way
+    if (ep_addr != EPNUM_USBTMC_INT || gInterruptBusy.exchange(true, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    gSRQCount.fetch_add(1, std::memory_order_relaxed);
+    post(EventType::NotificationComplete);
+    return true;
+}
+
+extern "C" void usbd_defer_func(osal_task_func_t func, void *param, bool in_isr) {
+    post(EventType::Deferred, func, param);
+}
+
+// USBTMC class driver
+
+extern "C" bool tud_usbtmc_start_bus_read(void) {
+    gUSBTMCArmed.store(true, std::memory_order_release);
+    postOnce(gUSBTMCPollPending, EventType::USBTMCPoll);
+    return true;
+}
+
+extern "C" bool tud_usbtmc_transmit_dev_msg_data(const void *data, size_t len, bool endOfMessage, bool usingTermChar) {
+    if (gUSBTMCState != USBTMCState::TxRequested || len > sizeof(gUSBTMCIn)) {
+        return false;
+    }
+
+    // The driver would send from the caller's buffer; the host's copy is made now instead
+    memcpy(gUSBTMCIn, data, len);
+    gUSBTMCInLength = len;
+    gUSBTMCInEOM = endOfMessage;
+    gUSBTMCState = USBTMCState::Transmitting;
+
+    post(EventType::USBTMCInComplete);
+    return true;
+}
+
+extern "C" bool tud_usbtmc_transmit_notification_data(const void *data, size_t len) {
+    return false;
+}
+
+// Vendor class driver
+
+extern "C" bool tud_vendor_n_mounted(uint8_t itf) {
+    return gMounted.load(std::memory_order_acquire);
+}
+
+extern "C" uint32_t tud_vendor_n_write(uint8_t itf, void const *buffer, uint32_t bufsize) {
+    xSemaphoreTake(gPipeLock, portMAX_DELAY);
+
+    const size_t written = std::min<size_t>(bufsize, sizeof(gVendorIn.fifo) - gVendorIn.length);
+
+    memcpy(gVendorIn.fifo + gVendorIn.length, buffer, written);
+    gVendorIn.length += written;
+
+    xSemaphoreGive(gPipeLock);
+    return static_cast<uint32_t>(written);
+}
+
+extern "C" uint32_t tud_vendor_n_write_flush(uint8_t itf) {
+    xSemaphoreTake(gPipeLock, portMAX_DELAY);
+
+    const size_t length = gVendorIn.busy ? 0 : gVendorIn.length;
+
+    if (length > 0) {
+        pipeStart(gVendorIn, length);
+    }
+
+    xSemaphoreGive(gPipeLock);
+    return static_cast<uint32_t>(length);
+}
+
+extern "C" void tud_vendor_n_read_flush(uint8_t itf) {
+    // Packets are handed over whole, so there is nothing left to discard
+}
+
+// WinUSB bulk endpoints
+
+extern "C" bool t76_winusb_bulk_in_xfer(uint8_t const *buffer, uint16_t bufsize) {
+    xSemaphoreTake(gPipeLock, portMAX_DELAY);
+
+    const bool start = !gWinUSBIn.busy && bufsize <= sizeof(gWinUSBIn.fifo);
+
+    if (start) {
+        memcpy(gWinUSBIn.fifo, buffer, bufsize);
+        gWinUSBIn.length = bufsize;
+        pipeStart(gWinUSBIn, bufsize);
+    }
+
+    xSemaphoreGive(gPipeLock);
+    return start;
+}
+
+extern "C" bool t76_winusb_bulk_in_xfer_direct(uint8_t const *buffer, uint16_t bufsize) {
+    return t76_winusb_bulk_in_xfer(buffer, bufsize);
+}
+
+extern "C" bool t76_winusb_bulk_in_zlp(void) {
+    xSemaphoreTake(gPipeLock, portMAX_DELAY);
+
+    const bool start = !gWinUSBIn.busy;
+
+    if (start) {
+        pipeStart(gWinUSBIn, 0);
+    }
+
+    xSemaphoreGive(gPipeLock);
+    return start;
+}
+
+// Simulated host
+
+void T76::Sim::Host::connect() {
+    post(EventType::Mount);
+}
+
+bool T76::Sim::Host::writeUSBTMC(const uint8_t *data, size_t length, TickType_t timeout) {
+    usbtmc_msg_request_dev_dep_out header = {};
+    const uint8_t tag = hostNextTag();
+
+    header.header.MsgID = USBTMC_MSGID_DEV_DEP_MSG_OUT;
+    header.header.bTag = tag;
+    header.header.bTagInverse = static_cast<uint8_t>(~tag);
+    header.TransferSize = static_cast<uint32_t>(length);
+    header.bmTransferAttributes.EOM = 1;
+
+    // The header and the start of the message share the first packet
+    Packet packet;
+    const size_t first = std::min(length, packetSize - usbtmcHeaderSize);
+
+    memcpy(packet.data, &header, usbtmcHeaderSize);
+    memcpy(packet.data + usbtmcHeaderSize, data, first);
+    packet.length = static_cast<uint16_t>(usbtmcHeaderSize + first);
+
+    if (!hostSend(gUSBTMCOut, packet, timeout, gUSBTMCPollPending, EventType::USBTMCPoll)) {
+        return false;
+    }
+
+    return hostWrite(gUSBTMCOut, data + first, length - first, timeout, gUSBTMCPollPending, EventType::USBTMCPoll);
+}
+
+bool T76::Sim::Host::readUSBTMC(std::string &response, TickType_t timeout) {
+    response.clear();
+
+    for (;;) {
+        usbtmc_msg_request_dev_dep_in request = {};
+        const uint8_t tag = hostNextTag();
+
+        request.header.MsgID = USBTMC_MSGID_DEV_DEP_MSG_IN;
+        request.header.bTag = tag;
+        request.header.bTagInverse = static_cast<uint8_t>(~tag);
+        request.TransferSize = usbtmcTransferSize;
+
+        Packet packet;
+
+        memcpy(packet.data, &request, usbtmcHeaderSize);
+        packet.length = usbtmcHeaderSize;
+
+        if (!hostSend(gUSBTMCOut, packet, timeout, gUSBTMCPollPending, EventType::USBTMCPoll)) {
+            return false;
+        }
+
+        if (xSemaphoreTake(gUSBTMCInDone, timeout) != pdTRUE) {
+            // INITIATE_ABORT_BULK_IN, then CHECK_ABORT_BULK_IN_STATUS
+            post(EventType::USBTMCAbortBulkIn);
+            xSemaphoreTake(gUSBTMCAbortDone, portMAX_DELAY);
+            xSemaphoreTake(gUSBTMCInDone, 0);
+            return false;
+        }
+
+        response.append(reinterpret_cast<const char*>(gUSBTMCIn), gUSBTMCInLength);
+
+        if (gUSBTMCInEOM) {
+            return true;
+        }
+    }
+}
+
+bool T76::Sim::Host::writeVendor(const uint8_t *data, size_t length, TickType_t timeout) {
+    return hostWrite(gVendorOut, data, length, timeout, gVendorPollPending, EventType::VendorPoll);
+}
+
+size_t T76::Sim::Host::readVendor(uint8_t *data, size_t length, TickType_t timeout) {
+    return hostRead(gVendorIn, data, length, timeout);
+}
+
+bool T76::Sim::Host::writeWinUSB(const uint8_t *data, size_t length, TickType_t timeout) {
+    return hostWrite(gWinUSBOut, data, length, timeout, gWinUSBPollPending, EventType::WinUSBPoll);
+}
+
+size_t T76::Sim::Host::readWinUSB(uint8_t *data, size_t length, TickType_t timeout) {
+    return hostRead(gWinUSBIn, data, length, timeout);
+}
+
+uint32_t T76::Sim::Host::srqCount() {
+    return gSRQCount.load(std::memory_order_relaxed);
+}
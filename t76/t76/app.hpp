@@ -37,8 +37,16 @@
 
 #include <pico/multicore.h>
 
+#include <t76/boot_profile.hpp>
+#include <t76/deferred_log.hpp>
+#include <t76/dma.hpp>
+#include <t76/flash.hpp>
+#include <t76/flight_recorder.hpp>
 #include <t76/memory.hpp>
 #include <t76/safety.hpp>
+#include <t76/settings.hpp>
+#include <t76/task_monitor.hpp>
+#include <t76/trace.hpp>
 #include <t76/usb_interface.hpp>
 
 
@@ -54,7 +62,7 @@ namespace T76::Core {
      * 
      * Initialization sequence:
      * 1. Safety system initialization on Core 0
-     * 2. Memory management system initialization
+     * 2. Memory management system and USB interface initialization
      * 3. Application-specific initialization via _init()
      * 4. Core 1 launch and initialization via _startCore1()
      * 5. Dual-core watchdog system setup
@@ -129,16 +137,38 @@ namespace T76::Core {
          * a static C-style function pointer, but we need to call instance methods.
          * The singleton pattern bridges this gap.
          * 
-         * @note Called automatically by multicore_launch_core1()
+         * @note Called automatically by multicore_launch_core1(), or with
+         *       T76_IC_SMP by a task pinned to Core 1
          * @note Must be static to serve as a C-style function pointer
          * @note Relies on the global singleton being properly initialized
          */
         static void _core1EntryPoint() {
+            // Lets core 0 park this core while it erases or programs the flash
+            T76::Core::Flash::core1Init();
+
+            // Lets a fault on core 0 have this core safe its own components
+            T76::Core::Safety::core1Init();
+
+            T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::Core1Start);
+
             if (_globalInstance) {
                 _globalInstance->_startCore1();
             }
         }
 
+#ifdef T76_IC_TRACE
+        /**
+         * @brief Trace sink that streams the trace over the vendor bulk IN endpoint
+         * 
+         * @param context The App instance
+         * @param data Next part of the trace stream
+         * @param length Length of the data in bytes
+         */
+        static void _traceSink(void *context, const uint8_t *data, size_t length) {
+            static_cast<App *>(context)->_usbInterface.sendVendorBulkData(std::vector<uint8_t>(data, data + length));
+        }
+#endif
+
         /**
          * @brief Early application initialization hook
          * 
@@ -175,6 +205,12 @@ namespace T76::Core {
          * - Create FreeRTOS tasks for Core 1 and return (scheduler will be started)
          * - Enter a main loop for non-RTOS Core 1 operation
          * 
+         * With T76_IC_SMP, Core 1 runs the FreeRTOS scheduler: this hook is
+         * called from a task pinned to Core 1 at the highest priority and
+         * must return. The tasks it creates run on either core unless they
+         * are pinned with vTaskCoreAffinitySet(). The Core 1 heartbeat is
+         * sent by the safety system rather than by the application.
+         * 
          * Must be implemented by derived classes.
          * 
          * @note Called on Core 1 only
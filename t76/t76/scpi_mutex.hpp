@@ -0,0 +1,73 @@
+/**
+ * @file scpi_mutex.hpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * SCPI Mutex - A FreeRTOS implementation of `T76::SCPI::TargetLock`
+ *
+ * Give the same SCPIMutex to every interpreter session of a target that is
+ * fed from its own task, such as an `SCPITask` for USBTMC and the USB runtime
+ * task for CDC, so that their handlers never run at the same time:
+ *
+ * ```cpp
+ * App() : _interpreter(*this), _cdcInterpreter(*this), _scpiTask(_interpreter, _usbInterface) {
+ *     _interpreter.setTargetLock(&_scpiMutex);
+ *     _cdcInterpreter.setTargetLock(&_scpiMutex);
+ * }
+ * ```
+ *
+ * The mutex is recursive, so that a handler can feed another session from
+ * its own task, and it uses priority inheritance, so that a low-priority
+ * session does not hold up a higher-priority one for longer than a handler.
+ * A handler that blocks, like the `*OPC?` handler in `waitForOperations()`,
+ * holds the mutex, and the other sessions, while it waits.
+ *
+ * Requires `configUSE_RECURSIVE_MUTEXES`.
+ */
+
+#pragma once
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+
+#include <t76/scpi_target_lock.hpp>
+
+
+namespace T76::Core {
+
+    /**
+     * @class SCPIMutex
+     * @brief Serializes the handlers of interpreter sessions that share a target
+     */
+    class SCPIMutex : public T76::SCPI::TargetLock {
+    public:
+        SCPIMutex() {
+            _mutex = xSemaphoreCreateRecursiveMutex();
+        }
+
+        ~SCPIMutex() override {
+            if (_mutex) {
+                vSemaphoreDelete(_mutex);
+            }
+        }
+
+        SCPIMutex(const SCPIMutex &) = delete;
+        SCPIMutex &operator=(const SCPIMutex &) = delete;
+
+        void lock() override {
+            if (_mutex) {
+                xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+            }
+        }
+
+        void unlock() override {
+            if (_mutex) {
+                xSemaphoreGiveRecursive(_mutex);
+            }
+        }
+
+    protected:
+        SemaphoreHandle_t _mutex;                               ///< Recursive mutex, or nullptr if it could not be created
+
+    }; // class SCPIMutex
+
+} // namespace T76::Core
@@ -0,0 +1,701 @@
+/**
+ * @file scpi_task.hpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * SCPI Task - Runs a SCPI interpreter on its own FreeRTOS task
+ *
+ * Without this class, USBTMC data is parsed, and command handlers run, from
+ * `_onUSBTMCBytesReceived()`, which is called by the USB runtime task. A slow
+ * handler then stops the whole USB stack: enumeration requests, SRQ
+ * notifications and the other classes all wait until it returns.
+ *
+ * SCPITask moves the interpreter to a task of its own. The USB callback only
+ * copies each packet into a FreeRTOS stream buffer, and the task feeds the
+ * buffered input to the interpreter. When the buffer is close to full, the
+ * USBTMC bulk OUT endpoint is paused, so the host is NAKed instead of losing
+ * data, and it is resumed as soon as the task has made room. Because handlers
+ * no longer run on the runtime task, their USBTMC sends can also wait for
+ * room in the bulk IN ring.
+ *
+ * Handlers of `*WAI` and `*OPC?` call waitForOperations(), which blocks the
+ * task, and with it the interpreter, until the overlapped operations started
+ * by earlier commands have completed.
+ *
+ * The task can also execute binary requests received as WinUSB frames (see
+ * `<t76/updater/winusb_frame.h>`). A `COMMAND_REQUEST` or `QUERY_REQUEST`
+ * frame carries the opcode of a command, as a little-endian 16-bit integer,
+ * followed by its packed parameters, which `Interpreter::executeBinary()`
+ * passes to the same handler as the text command. The response that the
+ * handler sends over USBTMC is captured and returned in the reply frame
+ * instead: `COMMAND_ACK` if there is none, `BINARY_RESPONSE` with the data of
+ * a binary block, `TEXT_RESPONSE` otherwise, or `ERROR_RESPONSE` with the
+ * SCPI error if the command failed. Requests are executed one at a time,
+ * between batches of text input; a frame that arrives while another is
+ * pending is dropped.
+ *
+ * The task also maintains the status byte. After every batch of input, and
+ * at least every `T76_IC_SCPI_TASK_STATUS_POLL_MS` while it is idle, it
+ * evaluates the enable masks of the interpreter's status registers, so that
+ * condition and event bits set from interrupts or core 1 are picked up, and
+ * sends a USBTMC SRQ interrupt whenever the master summary bit gets set.
+ * The last status byte is returned by statusByte(), which applications
+ * return from `_onUSBTMCReadStatusByte()`.
+ *
+ * The task times every batch of input that it passes to the interpreter,
+ * which, with 64-byte USBTMC packets, usually holds a single command. Batches
+ * that take longer than the handler budget are counted, and the longest is
+ * recorded, so that slow handlers can be found and moved to tasks of their
+ * own.
+ *
+ * The task is configured with the following macros, set from CMake:
+ *
+ * - `T76_IC_SCPI_TASK_STACK_SIZE`: Stack size of the task, in words. Command
+ *   handlers run on this stack.
+ * - `T76_IC_SCPI_TASK_PRIORITY`: Priority of the task. Keep it at or below
+ *   `T76_IC_USB_RUNTIME_TASK_PRIORITY`, so that the USB stack is serviced
+ *   while commands execute.
+ * - `T76_IC_SCPI_TASK_BUFFER_SIZE`: Size of the stream buffer, in bytes.
+ * - `T76_IC_SCPI_TASK_HANDLER_BUDGET_US`: Default handler budget, in
+ *   microseconds; see `setHandlerBudget()`.
+ * - `T76_IC_SCPI_TASK_STATUS_POLL_MS`: Longest time between two updates of
+ *   the status byte while no input is received, in milliseconds.
+ * - `T76_IC_SCPI_TASK_FRAME_SIZE`: Largest WinUSB request frame, including
+ *   its header, in bytes, or 0 to disable binary requests.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <stream_buffer.h>
+#include <tusb.h>
+
+#include <pico/time.h>
+
+#include <t76/scpi_interpreter.hpp>
+#include <t76/usb_interface.hpp>
+#include <t76/updater/winusb_frame.h>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+#ifndef T76_IC_SCPI_TASK_STACK_SIZE
+#define T76_IC_SCPI_TASK_STACK_SIZE 1024
+#endif
+
+#ifndef T76_IC_SCPI_TASK_PRIORITY
+#define T76_IC_SCPI_TASK_PRIORITY 1
+#endif
+
+#ifndef T76_IC_SCPI_TASK_BUFFER_SIZE
+#define T76_IC_SCPI_TASK_BUFFER_SIZE 1024
+#endif
+
+#ifndef T76_IC_SCPI_TASK_HANDLER_BUDGET_US
+#define T76_IC_SCPI_TASK_HANDLER_BUDGET_US 10000
+#endif
+
+#ifndef T76_IC_SCPI_TASK_STATUS_POLL_MS
+#define T76_IC_SCPI_TASK_STATUS_POLL_MS 10
+#endif
+
+#ifndef T76_IC_SCPI_TASK_FRAME_SIZE
+#define T76_IC_SCPI_TASK_FRAME_SIZE 1024
+#endif
+
+
+namespace T76::Core {
+
+    /**
+     * @brief Executes SCPI commands received over USBTMC on a dedicated task
+     *
+     * Applications create one alongside their interpreter, start it from
+     * `_initCore0()`, and forward USBTMC input and device clears to it:
+     *
+     * ```cpp
+     * App::App() : _interpreter(*this), _scpiTask(_interpreter, _usbInterface) {}
+     *
+     * void App::_onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) {
+     *     _scpiTask.receive(data, length, transfer_complete);
+     * }
+     *
+     * void App::_onUSBTMCClear() {
+     *     _scpiTask.clear();
+     * }
+     *
+     * uint8_t App::_onUSBTMCReadStatusByte() {
+     *     return _scpiTask.statusByte();
+     * }
+     *
+     * void App::_onWinUSBBulkBytesReceived(const uint8_t *data, size_t length) {
+     *     _scpiTask.receiveFrame(data, length);   // Only if binary requests are wanted
+     * }
+     *
+     * void App::_initCore0() {
+     *     _scpiTask.start();
+     * }
+     * ```
+     *
+     * @tparam TargetT The command handler class of the interpreter.
+     */
+    template<typename TargetT>
+    class SCPITask {
+    public:
+        /**
+         * @brief Counters describing the work done by the task.
+         */
+        struct Stats {
+            uint32_t bytesProcessed;        ///< Bytes passed to the interpreter
+            uint32_t bytesDropped;          ///< Bytes that did not fit in the stream buffer
+            uint32_t pauses;                ///< Times USBTMC input was paused because the buffer was full
+            uint32_t budgetOverruns;        ///< Batches of input that took longer than the handler budget
+            uint32_t longestBatchUs;        ///< Longest time spent on one batch of input, in microseconds
+            uint32_t framesExecuted;        ///< Binary requests executed
+            uint32_t framesDropped;         ///< WinUSB frames dropped because they were invalid, too large, or another was pending
+        };
+
+        /**
+         * @brief Create the task object; the task itself is created by start().
+         *
+         * @param interpreter The interpreter that executes the commands. It
+         *                    must only be used from the task once started.
+         * @param usbInterface The USB interface whose USBTMC input is paused
+         *                     when the stream buffer is full, and over which
+         *                     the interpreter answers constant queries.
+         */
+        SCPITask(T76::SCPI::Interpreter<TargetT> &interpreter, T76::Core::USB::Interface &usbInterface) :
+            _interpreter(interpreter),
+            _usbInterface(usbInterface) {
+            // Constant queries are answered over USBTMC, like every other response of the session
+            _interpreter.setResponseWriter(T76::Core::USB::Interface::usbtmcResponseWriter, &_usbInterface);
+        }
+
+        /**
+         * @brief Create the stream buffer and the task.
+         *
+         * @param name The name of the task.
+         * @return true if the task was created, false otherwise.
+         */
+        bool start(const char *name = "SCPI") {
+            _streamBuffer = xStreamBufferCreate(T76_IC_SCPI_TASK_BUFFER_SIZE, 1);
+
+            if (_streamBuffer == nullptr) {
+                LOGE("SCPI: cannot create the input stream buffer\n");
+                return false;
+            }
+
+            if (T76_IC_SCPI_TASK_FRAME_SIZE > 0) {
+                // Buffers for binary requests are allocated once, so that requests do not allocate
+                _frameInput = std::make_unique<uint8_t[]>(T76_IC_SCPI_TASK_FRAME_SIZE);
+                _frame = std::make_unique<uint8_t[]>(T76_IC_SCPI_TASK_FRAME_SIZE);
+                _response.reserve(T76_IC_SCPI_TASK_FRAME_SIZE);
+                _reply.reserve(T76_WINUSB_FRAME_HEADER_SIZE + T76_IC_SCPI_TASK_FRAME_SIZE);
+            }
+
+            const BaseType_t result = xTaskCreate(
+                [](void* param) {
+                    static_cast<SCPITask*>(param)->_run();
+                },
+                name,
+                T76_IC_SCPI_TASK_STACK_SIZE,
+                this,
+                T76_IC_SCPI_TASK_PRIORITY,
+                &_taskHandle
+            );
+
+            if (result != pdPASS) {
+                LOGE("SCPI: cannot create the interpreter task\n");
+                return false;
+            }
+
+#ifdef T76_IC_SMP
+            // Parses and runs commands away from the USB tasks by default
+            vTaskCoreAffinitySet(_taskHandle, T76_IC_SCPI_TASK_CORE_AFFINITY);
+#endif
+
+            return true;
+        }
+
+        /**
+         * @brief Queue USBTMC input for the interpreter.
+         *
+         * Call this from `_onUSBTMCBytesReceived()`. It never blocks: if the
+         * stream buffer cannot take another packet after this one, USBTMC
+         * input is paused until the task has made room.
+         *
+         * @param data The received bytes.
+         * @param length The number of bytes.
+         * @param endOfMessage Whether the bytes end a USBTMC transfer, which
+         *                     also ends the program message.
+         */
+        void receive(const uint8_t *data, size_t length, bool endOfMessage) {
+            static const uint8_t newline = '\n';
+
+            if (_streamBuffer == nullptr) {
+                return;
+            }
+
+            size_t queued = xStreamBufferSend(_streamBuffer, data, length, 0);
+            const size_t expected = length + (endOfMessage ? 1 : 0);
+
+            if (endOfMessage && queued == length) {
+                queued += xStreamBufferSend(_streamBuffer, &newline, 1, 0);
+            }
+
+            _bytesReceived.fetch_add(static_cast<uint32_t>(queued), std::memory_order_release);
+
+            if (queued < expected) {
+                LOGW("SCPI: input stream buffer full; %lu bytes dropped\n", (unsigned long)(expected - queued));
+                _bytesDropped.fetch_add(static_cast<uint32_t>(expected - queued), std::memory_order_relaxed);
+            }
+
+            _notify();
+
+            if (xStreamBufferSpacesAvailable(_streamBuffer) < _packetReserve) {
+                // The endpoint is paused first, so that _resume() always finds it paused
+                _usbInterface.pauseUSBTMCBulkOut();
+                _paused.store(true);
+                _pauses.fetch_add(1, std::memory_order_relaxed);
+
+                // The task may have made room since the buffer was checked
+                if (xStreamBufferSpacesAvailable(_streamBuffer) >= _packetReserve) {
+                    _resume();
+                }
+            }
+        }
+
+        /**
+         * @brief Assemble WinUSB frames and queue binary requests for the task.
+         *
+         * Call this from `_onWinUSBBulkBytesReceived()`. Frames can span any
+         * number of packets, but must be sent one after the other; the host
+         * is expected to wait for the reply to a request before sending the
+         * next one.
+         *
+         * @param data The received bytes.
+         * @param length The number of bytes.
+         */
+        void receiveFrame(const uint8_t *data, size_t length) {
+            if (!_frameInput) {
+                return;
+            }
+
+            while (length > 0) {
+                // The rest of a frame that was too large is skipped
+                if (_frameSkip > 0) {
+                    const size_t count = std::min<size_t>(length, _frameSkip);
+
+                    _frameSkip -= count;
+                    data += count;
+                    length -= count;
+                    continue;
+                }
+
+                const size_t expected = _frameInputLength < T76_WINUSB_FRAME_HEADER_SIZE ?
+                    T76_WINUSB_FRAME_HEADER_SIZE : _frameLength(_frameInput.get());
+                const size_t count = std::min(length, expected - _frameInputLength);
+
+                memcpy(_frameInput.get() + _frameInputLength, data, count);
+                _frameInputLength += count;
+                data += count;
+                length -= count;
+
+                if (_frameInputLength == T76_WINUSB_FRAME_HEADER_SIZE) {
+                    const uint8_t *header = _frameInput.get();
+
+                    if (header[0] != T76_WINUSB_FRAME_MAGIC0 || header[1] != T76_WINUSB_FRAME_MAGIC1 ||
+                        header[2] != T76_WINUSB_FRAME_VERSION) {
+                        // Not a frame; drop the packet and wait for one that starts a frame
+                        _framesDropped.fetch_add(1, std::memory_order_relaxed);
+                        _frameInputLength = 0;
+                        return;
+                    }
+
+                    // Compared without adding the header, which a length near 4 GiB would wrap
+                    if (_payloadLength(header) > T76_IC_SCPI_TASK_FRAME_SIZE - T76_WINUSB_FRAME_HEADER_SIZE) {
+                        _framesDropped.fetch_add(1, std::memory_order_relaxed);
+                        _frameSkip = _payloadLength(header);
+                        _frameInputLength = 0;
+                        continue;
+                    }
+                }
+
+                if (_frameInputLength < T76_WINUSB_FRAME_HEADER_SIZE || _frameInputLength < _frameLength(_frameInput.get())) {
+                    continue;
+                }
+
+                // The frame is complete; hand it to the task unless it is still busy with the previous one
+                if (_framePending.load(std::memory_order_acquire)) {
+                    _framesDropped.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    memcpy(_frame.get(), _frameInput.get(), _frameInputLength);
+                    _framePending.store(true, std::memory_order_release);
+                    _notify();
+                }
+
+                _frameInputLength = 0;
+            }
+        }
+
+        /**
+         * @brief Discard the input that has not been executed yet.
+         *
+         * Call this from `_onUSBTMCClear()`. Input received after the call is
+         * executed normally.
+         */
+        void clear() {
+            _discardUntil.store(_bytesReceived.load(std::memory_order_acquire), std::memory_order_release);
+        }
+
+        /**
+         * @brief Wait until no overlapped operation is pending.
+         *
+         * Call this from the handlers of `*WAI` and `*OPC?`, which must not
+         * let the interpreter go on until the pending operations have
+         * completed. Since operations can be completed from any context,
+         * the task checks for completion once per tick. USBTMC input keeps
+         * being buffered while it waits, and the time spent waiting does not
+         * count towards the handler budget.
+         *
+         * @param timeout Maximum time to wait, in ticks.
+         * @return true once no operation is pending, or false if the timeout
+         *         expired or the host cleared the device in the meantime.
+         */
+        bool waitForOperations(TickType_t timeout = portMAX_DELAY) {
+            const uint32_t clearMark = _discardUntil.load(std::memory_order_acquire);
+            const uint32_t start = time_us_32();
+            const TickType_t startTick = xTaskGetTickCount();
+            bool idle;
+
+            while (!(idle = _interpreter.operations.idle())) {
+                if (_discardUntil.load(std::memory_order_acquire) != clearMark ||
+                    (timeout != portMAX_DELAY && xTaskGetTickCount() - startTick >= timeout)) {
+                    break;
+                }
+
+                vTaskDelay(1);
+            }
+
+            _waitedUs += time_us_32() - start;
+            return idle;
+        }
+
+        /**
+         * @brief Get the status byte, as of the last update by the task.
+         *
+         * Can be called from any task, including the USB runtime task that
+         * answers `READ_STATUS_BYTE` requests.
+         */
+        uint8_t statusByte() const {
+            return _statusByte.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Set the handler budget.
+         *
+         * @param budgetUs The time the interpreter may spend on one batch of
+         *                 input before it is counted as an overrun, in
+         *                 microseconds.
+         */
+        void setHandlerBudget(uint32_t budgetUs) {
+            _handlerBudgetUs.store(budgetUs, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the task's counters.
+         */
+        Stats stats() const {
+            return {
+                .bytesProcessed = _bytesProcessed.load(std::memory_order_relaxed),
+                .bytesDropped = _bytesDropped.load(std::memory_order_relaxed),
+                .pauses = _pauses.load(std::memory_order_relaxed),
+                .budgetOverruns = _budgetOverruns.load(std::memory_order_relaxed),
+                .longestBatchUs = _longestBatchUs.load(std::memory_order_relaxed),
+                .framesExecuted = _framesExecuted.load(std::memory_order_relaxed),
+                .framesDropped = _framesDropped.load(std::memory_order_relaxed),
+            };
+        }
+
+        /**
+         * @brief Reset the task's counters.
+         */
+        void resetStats() {
+            _bytesProcessed.store(0, std::memory_order_relaxed);
+            _bytesDropped.store(0, std::memory_order_relaxed);
+            _pauses.store(0, std::memory_order_relaxed);
+            _budgetOverruns.store(0, std::memory_order_relaxed);
+            _longestBatchUs.store(0, std::memory_order_relaxed);
+            _framesExecuted.store(0, std::memory_order_relaxed);
+            _framesDropped.store(0, std::memory_order_relaxed);
+        }
+
+    protected:
+        static constexpr size_t _packetSize = TUD_OPT_HIGH_SPEED ? 512 : 64;  ///< Largest USBTMC bulk OUT packet
+        static constexpr size_t _packetReserve = _packetSize + 1;            ///< Room for a packet and the newline that ends its message
+
+        static constexpr UBaseType_t _notifyIndex = 1;                        ///< Notification that wakes the task; index 0 belongs to the stream buffer
+
+        static_assert(T76_IC_SCPI_TASK_BUFFER_SIZE >= 2 * _packetReserve, "The SCPI task buffer must hold at least two USBTMC packets");
+        static_assert(configTASK_NOTIFICATION_ARRAY_ENTRIES > _notifyIndex, "The SCPI task needs configTASK_NOTIFICATION_ARRAY_ENTRIES of at least 2");
+        static_assert(T76_IC_SCPI_TASK_FRAME_SIZE == 0 || T76_IC_SCPI_TASK_FRAME_SIZE >= T76_WINUSB_FRAME_HEADER_SIZE + 2,
+                      "The SCPI task frame size must hold a frame header and an opcode");
+
+        T76::SCPI::Interpreter<TargetT> &_interpreter;          ///< Interpreter that executes the commands
+        T76::Core::USB::Interface &_usbInterface;               ///< Interface whose USBTMC input is paused
+        StreamBufferHandle_t _streamBuffer = nullptr;           ///< Input waiting for the interpreter
+        TaskHandle_t _taskHandle = nullptr;                     ///< Handle of the task
+
+        std::atomic<bool> _paused{false};                       ///< Whether USBTMC input is paused
+        std::atomic<uint8_t> _statusByte{0};                    ///< Status byte as of the last update
+        std::atomic<uint32_t> _bytesReceived{0};                ///< Bytes written to the stream buffer, modulo 2^32
+        std::atomic<uint32_t> _discardUntil{0};                 ///< Bytes received before the last clear, modulo 2^32
+        uint32_t _bytesConsumed = 0;                            ///< Bytes read from the stream buffer, modulo 2^32; only used by the task
+        uint32_t _waitedUs = 0;                                 ///< Time spent in waitForOperations() during the current batch; only used by the task
+
+        std::atomic<uint32_t> _handlerBudgetUs{T76_IC_SCPI_TASK_HANDLER_BUDGET_US};
+        std::atomic<uint32_t> _bytesProcessed{0};
+        std::atomic<uint32_t> _bytesDropped{0};
+        std::atomic<uint32_t> _pauses{0};
+        std::atomic<uint32_t> _budgetOverruns{0};
+        std::atomic<uint32_t> _longestBatchUs{0};
+        std::atomic<uint32_t> _framesExecuted{0};
+        std::atomic<uint32_t> _framesDropped{0};
+
+        std::unique_ptr<uint8_t[]> _frameInput;                 ///< Frame being assembled; only used by receiveFrame()
+        size_t _frameInputLength = 0;                           ///< Bytes of the frame assembled so far
+        size_t _frameSkip = 0;                                  ///< Bytes left of a frame that is too large
+        std::unique_ptr<uint8_t[]> _frame;                      ///< Complete frame waiting to be executed
+        std::atomic<bool> _framePending{false};                 ///< Whether _frame holds a request for the task
+        std::vector<uint8_t> _response;                         ///< USBTMC response captured while a request executes
+        std::vector<uint8_t> _reply;                            ///< Reply frame
+
+        /**
+         * @brief Get the length of a frame's payload from its header.
+         */
+        static uint32_t _payloadLength(const uint8_t *header) {
+            uint32_t payloadLength;
+            memcpy(&payloadLength, header + 8, sizeof(payloadLength));
+
+            return payloadLength;
+        }
+
+        /**
+         * @brief Get the length of a frame, including its header, from the header.
+         *
+         * Only called for headers that receiveFrame() accepted, whose payload
+         * fits T76_IC_SCPI_TASK_FRAME_SIZE, so the sum cannot wrap.
+         */
+        static size_t _frameLength(const uint8_t *header) {
+            return T76_WINUSB_FRAME_HEADER_SIZE + static_cast<size_t>(_payloadLength(header));
+        }
+
+        /**
+         * @brief Wake the task, which then looks for input and requests.
+         */
+        void _notify() {
+            if (_taskHandle != nullptr) {
+                xTaskNotifyGiveIndexed(_taskHandle, _notifyIndex);
+            }
+        }
+
+        /**
+         * @brief Send a reply frame over WinUSB.
+         */
+        void _sendReply(uint8_t type, uint8_t tag, const uint8_t *payload, size_t length) {
+            const uint32_t payloadLength = static_cast<uint32_t>(length);
+
+            _reply.resize(T76_WINUSB_FRAME_HEADER_SIZE + length);
+            _reply[0] = T76_WINUSB_FRAME_MAGIC0;
+            _reply[1] = T76_WINUSB_FRAME_MAGIC1;
+            _reply[2] = T76_WINUSB_FRAME_VERSION;
+            _reply[3] = type;
+            _reply[4] = tag;
+            _reply[5] = 0;
+            _reply[6] = 0;
+            _reply[7] = 0;
+            memcpy(&_reply[8], &payloadLength, sizeof(payloadLength));
+
+            if (length > 0) {
+                memcpy(&_reply[T76_WINUSB_FRAME_HEADER_SIZE], payload, length);
+            }
+
+            _usbInterface.sendWinUSBBulkData(_reply);
+        }
+
+        /**
+         * @brief Execute the pending frame and send its reply.
+         */
+        void _executeFrame() {
+            const uint8_t *frame = _frame.get();
+            const uint8_t type = frame[3];
+            const uint8_t tag = frame[4];
+            const uint8_t *payload = frame + T76_WINUSB_FRAME_HEADER_SIZE;
+            const size_t length = _payloadLength(frame);
+
+            if (type == T76_WINUSB_FRAME_SESSION_RESET_REQUEST) {
+                _sendReply(T76_WINUSB_FRAME_SESSION_RESET_ACK, tag, nullptr, 0);
+                return;
+            }
+
+            // Requests start with a 16-bit opcode, which is taken off the length below
+            if ((type != T76_WINUSB_FRAME_COMMAND_REQUEST && type != T76_WINUSB_FRAME_QUERY_REQUEST) || length < 2) {
+                static const char unsupported[] = "Unsupported frame";
+
+                _sendReply(T76_WINUSB_FRAME_ERROR_RESPONSE, tag, reinterpret_cast<const uint8_t*>(unsupported), sizeof(unsupported) - 1);
+                return;
+            }
+
+            const uint16_t opcode = static_cast<uint16_t>(payload[0] | (payload[1] << 8));
+            T76::SCPI::Error error;
+
+            _response.clear();
+            _usbInterface.captureUSBTMCBulkData(&_response);
+            const bool executed = _interpreter.executeBinary(opcode, payload + 2, length - 2, error);
+            _usbInterface.captureUSBTMCBulkData(nullptr);
+
+            _framesExecuted.fetch_add(1, std::memory_order_relaxed);
+
+            if (!executed) {
+                char message[128];
+                const size_t messageLength = T76::SCPI::ErrorQueue::format(error, message, sizeof(message));
+
+                _sendReply(T76_WINUSB_FRAME_ERROR_RESPONSE, tag, reinterpret_cast<const uint8_t*>(message), messageLength);
+                return;
+            }
+
+            if (_response.empty()) {
+                _sendReply(T76_WINUSB_FRAME_COMMAND_ACK, tag, nullptr, 0);
+                return;
+            }
+
+            // Responses end with a newline, which the frame does not need
+            size_t responseLength = _response.size();
+
+            if (_response.back() == '\n') {
+                responseLength--;
+            }
+
+            // A definite-length block (`#<n><length><data>`) is returned as its data
+            if (responseLength >= 2 && _response[0] == '#' && _response[1] >= '1' && _response[1] <= '9') {
+                const size_t digits = _response[1] - '0';
+                size_t blockLength = 0;
+
+                for (size_t i = 0; i < digits && 2 + i < responseLength; i++) {
+                    blockLength = blockLength * 10 + (_response[2 + i] - '0');
+                }
+
+                if (2 + digits + blockLength == responseLength) {
+                    _sendReply(T76_WINUSB_FRAME_BINARY_RESPONSE, tag, _response.data() + 2 + digits, blockLength);
+                    return;
+                }
+            }
+
+            _sendReply(T76_WINUSB_FRAME_TEXT_RESPONSE, tag, _response.data(), responseLength);
+        }
+
+        /**
+         * @brief Resume USBTMC input if it is paused.
+         */
+        void _resume() {
+            if (_paused.exchange(false)) {
+                _usbInterface.resumeUSBTMCBulkOut();
+            }
+        }
+
+        /**
+         * @brief Update the status byte, and request service if MSS was just set.
+         */
+        void _updateStatus() {
+            const uint8_t statusByte = _interpreter.statusByte();
+            const uint8_t previous = _statusByte.exchange(statusByte, std::memory_order_acq_rel);
+
+            // An SRQ that finds the interrupt endpoint busy is sent once it is free
+            if ((statusByte & ~previous) & T76::SCPI::StatusByte::MasterSummary) {
+                _usbInterface.sendUSBTMCSRQInterrupt(statusByte);
+            }
+        }
+
+        /**
+         * @brief Feed one batch of buffered input to the interpreter.
+         */
+        void _processBatch(const uint8_t *batch, size_t length) {
+            // Bytes that were already buffered when the host cleared the device are dropped
+            const uint32_t pending = _discardUntil.load(std::memory_order_acquire) - _bytesConsumed;
+            const size_t skip = static_cast<int32_t>(pending) > 0 ? std::min<size_t>(length, pending) : 0;
+
+            _bytesConsumed += static_cast<uint32_t>(length);
+
+            if (_paused.load() && xStreamBufferSpacesAvailable(_streamBuffer) >= _packetReserve) {
+                _resume();
+            }
+
+            if (skip > 0) {
+                _interpreter.discardInput();
+            }
+
+            if (skip == length) {
+                return;
+            }
+
+            _waitedUs = 0;
+
+            const uint32_t start = time_us_32();
+            _interpreter.processInput(batch + skip, length - skip);
+            const uint32_t elapsed = time_us_32() - start - _waitedUs;
+
+            _bytesProcessed.fetch_add(static_cast<uint32_t>(length - skip), std::memory_order_relaxed);
+
+            if (elapsed > _handlerBudgetUs.load(std::memory_order_relaxed)) {
+                _budgetOverruns.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (elapsed > _longestBatchUs.load(std::memory_order_relaxed)) {
+                _longestBatchUs.store(elapsed, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief The task body, which feeds buffered input and requests to the interpreter.
+         *
+         * The task sleeps on its own notification rather than on the stream
+         * buffer, so that either text input or a binary request wakes it.
+         */
+        void _run() {
+            uint8_t batch[_packetReserve];
+
+            for (;;) {
+                ulTaskNotifyTakeIndexed(_notifyIndex, pdTRUE, pdMS_TO_TICKS(T76_IC_SCPI_TASK_STATUS_POLL_MS));
+
+                for (;;) {
+                    const size_t length = xStreamBufferReceive(_streamBuffer, batch, sizeof(batch), 0);
+
+                    // Requests run between batches, so that a long text transfer does not hold them back
+                    if (_framePending.load(std::memory_order_acquire)) {
+                        _executeFrame();
+                        _framePending.store(false, std::memory_order_release);
+                    }
+
+                    if (length == 0) {
+                        break;
+                    }
+
+                    _processBatch(batch, length);
+                    _updateStatus();
+                }
+
+                _updateStatus();
+            }
+        }
+    };
+
+} // namespace T76::Core
@@ -0,0 +1,10 @@
+# Configurable options for the trace recorder
+
+option(T76_IC_TRACE "Record task switches, interrupts and spans, and stream them to the host on request" OFF)
+set(T76_IC_TRACE_RING_SIZE 256 CACHE STRING "Number of trace events each core can hold before events are dropped; must be a power of two")
+set(T76_IC_TRACE_MAX_TASKS 32 CACHE STRING "Number of FreeRTOS tasks whose names are kept for the trace")
+set(T76_IC_TRACE_MAX_NAMES 64 CACHE STRING "Number of span names the streamer remembers having sent")
+set(T76_IC_TRACE_PACKET_SIZE 512 CACHE STRING "Largest block of trace data passed to the sink at once (bytes)")
+set(T76_IC_TRACE_FLUSH_PERIOD_MS 10 CACHE STRING "Interval at which recorded events are streamed (milliseconds)")
+set(T76_IC_TRACE_TASK_PRIORITY 1 CACHE STRING "FreeRTOS priority of the task that streams trace events")
+set(T76_IC_TRACE_TASK_STACK_SIZE "(configMINIMAL_STACK_SIZE * 2)" CACHE STRING "Stack size of the task that streams trace events")
@@ -0,0 +1,225 @@
+/**
+ * @file trace.hpp
+ * @brief Recorder for task switches, interrupts and spans, streamed to the host
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The trace recorder timestamps events in a lock-free ring per core: FreeRTOS
+ * task switches (through the hooks in <t76/trace_hooks.h>), interrupt entry
+ * and exit, and spans that mark the start and end of a piece of work:
+ *
+ *     void Interface::_processDispatchItem(DispatchItem *item) {
+ *         T76_TRACE_SPAN("usb.dispatch");
+ *         ...
+ *     }
+ *
+ * Recording an event takes a few tens of cycles and never blocks, so spans
+ * and interrupt events can be used on core 1 and in interrupt handlers,
+ * including from SRAM. Nothing is recorded until start() is called. A
+ * low-priority task then streams the events to a sink, normally the vendor
+ * bulk IN endpoint, as a byte stream that t76/trace/trace_to_perfetto.py
+ * converts to the Chrome trace format that Perfetto opens.
+ *
+ * The stream is a sequence of little-endian 12-byte records:
+ *
+ *     uint32_t timestamp;     // Timebase::now32() when the event was recorded
+ *     uint32_t value;         // Task number, exception number or name id
+ *     uint8_t  type;          // EventType
+ *     uint8_t  core;          // Core that recorded the event
+ *     uint16_t length;        // Bytes of name that follow the record, padded to 4
+ *
+ * Every span name is sent once, in a SpanName record, before the first event
+ * that uses it; every task name is sent once in a TaskName record. A Start
+ * record, whose value is the format version, begins the stream after each
+ * start().
+ *
+ * Span names must stay valid, as string literals do. When the T76_IC_TRACE
+ * CMake option is off, the T76_TRACE_* macros expand to nothing.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef T76_IC_TRACE
+
+#include <atomic>
+
+#include <pico/platform.h>
+
+#include <t76/timebase.hpp>
+#include "t76/ring_queue.hpp"
+
+#endif
+
+
+namespace T76::Core::Trace {
+
+    /**
+     * @brief Types of the records in the trace stream
+     */
+    enum class EventType : uint8_t {
+        Start       = 0x00,     ///< Beginning of the stream; value is the format version
+        TaskSwitch  = 0x01,     ///< A task was switched in; value is its task number
+        IsrEnter    = 0x02,     ///< An interrupt handler started; value is its exception number
+        IsrExit     = 0x03,     ///< The interrupt handler that started last returned
+        SpanBegin   = 0x04,     ///< A span started; value is its name id
+        SpanEnd     = 0x05,     ///< A span ended; value is its name id
+        Instant     = 0x06,     ///< A point event; value is its name id
+        TaskCreated = 0x07,     ///< A task was created; value is its task number
+        Dropped     = 0x08,     ///< Events were lost because a ring was full; value is how many
+        TaskName    = 0x80,     ///< Name of a task number, followed by the name
+        SpanName    = 0x81,     ///< Name of a name id, followed by the name
+    };
+
+    /**
+     * @brief Version of the stream format, sent in the Start record
+     */
+    constexpr uint32_t streamVersion = 1;
+
+    /**
+     * @brief Function that receives the trace stream
+     * @param context The context pointer passed to setSink()
+     * @param data Next part of the stream
+     * @param length Length of the data in bytes
+     */
+    using SinkFunction = void (*)(void *context, const uint8_t *data, std::size_t length);
+
+    /**
+     * @brief Statistics of the trace recorder
+     */
+    struct Stats {
+        bool running;                   ///< Whether events are being recorded
+        uint32_t events;                ///< Events streamed since boot
+        uint32_t dropped;               ///< Events lost because a ring was full
+        uint64_t bytesStreamed;         ///< Bytes passed to the sink since boot
+    };
+
+    /**
+     * @brief Create the task that streams trace events
+     * @return true if the task was created
+     *
+     * Called by App::run() when T76_IC_TRACE is on.
+     */
+    bool init();
+
+    /**
+     * @brief Set the function that receives the trace stream
+     *
+     * The application template sends the stream to the vendor bulk IN
+     * endpoint. Must be called before start().
+     */
+    void setSink(SinkFunction sink, void *context);
+
+    /**
+     * @brief Start recording and streaming events
+     *
+     * Each start begins a new stream, which repeats the task and span names.
+     */
+    void start();
+
+    /**
+     * @brief Stop recording events; those already recorded are still streamed
+     */
+    void stop();
+
+    /**
+     * @brief Get the statistics of the trace recorder
+     */
+    Stats stats();
+
+#ifdef T76_IC_TRACE
+
+    /**
+     * @brief An event, as stored in the ring until it is streamed
+     */
+    struct Event {
+        uint32_t timestamp;
+        uint32_t value;
+        EventType type;
+    };
+
+    using Ring = Utils::MPSCRingQueue<Event, T76_IC_TRACE_RING_SIZE, Utils::OverflowPolicy::DropNewest>;
+
+    /**
+     * @brief The event rings of core 0 and core 1
+     */
+    extern Ring gRings[2];
+
+    /**
+     * @brief Whether events are recorded
+     */
+    extern std::atomic<bool> gRunning;
+
+    /**
+     * @brief Record an event on the calling core's ring
+     */
+    inline __attribute__((always_inline)) void record(EventType type, uint32_t value) {
+        if (!gRunning.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        gRings[get_core_num()].push(Event{T76::Core::Timebase::now32(), value, type});
+    }
+
+    /**
+     * @brief Identifier of a span name in the stream
+     */
+    inline __attribute__((always_inline)) uint32_t nameId(const char *name) {
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(name));
+    }
+
+    /**
+     * @brief Record a span that lasts as long as the object
+     */
+    class Span {
+    public:
+        inline __attribute__((always_inline)) explicit Span(const char *name) : _name(name) {
+            record(EventType::SpanBegin, nameId(name));
+        }
+
+        inline __attribute__((always_inline)) ~Span() {
+            record(EventType::SpanEnd, nameId(_name));
+        }
+
+        Span(const Span &) = delete;
+        Span &operator=(const Span &) = delete;
+
+    private:
+        const char *_name;
+    };
+
+#endif
+
+} // namespace T76::Core::Trace
+
+
+#ifdef T76_IC_TRACE
+
+#define T76_TRACE_CONCAT_INNER(a, b) a##b
+#define T76_TRACE_CONCAT(a, b) T76_TRACE_CONCAT_INNER(a, b)
+
+// Record a span from here to the end of the enclosing scope
+#define T76_TRACE_SPAN(name) \
+    T76::Core::Trace::Span T76_TRACE_CONCAT(_t76TraceSpan, __LINE__)(name)
+
+// Record a point event
+#define T76_TRACE_INSTANT(name) \
+    T76::Core::Trace::record(T76::Core::Trace::EventType::Instant, T76::Core::Trace::nameId(name))
+
+// Mark the start and end of an interrupt handler
+#define T76_TRACE_ISR_ENTER() \
+    T76::Core::Trace::record(T76::Core::Trace::EventType::IsrEnter, __get_current_exception())
+
+#define T76_TRACE_ISR_EXIT() \
+    T76::Core::Trace::record(T76::Core::Trace::EventType::IsrExit, 0)
+
+#else
+
+#define T76_TRACE_SPAN(name)
+#define T76_TRACE_INSTANT(name)
+#define T76_TRACE_ISR_ENTER()
+#define T76_TRACE_ISR_EXIT()
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file trace_hooks.h
+ * @brief FreeRTOS trace macros that feed the trace recorder
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * FreeRTOSConfig.h includes this file when T76_IC_TRACE is defined. The
+ * macros expand inside the kernel's tasks.c, where the task control block is
+ * visible, and forward task switches and task creation to the recorder in
+ * <t76/trace.hpp>. Tasks are identified by the number the kernel gives them
+ * when configUSE_TRACE_FACILITY is enabled.
+ *
+ * The traceISR_* macros are only invoked by ports that support them; the
+ * framework's own interrupt handlers use T76_TRACE_ISR_ENTER() and
+ * T76_TRACE_ISR_EXIT() instead, which also work on core 1.
+ *
+ */
+
+#pragma once
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void t76_trace_task_switched_in(uint32_t taskNumber);
+void t76_trace_task_created(uint32_t taskNumber, const char *name);
+void t76_trace_isr_enter(void);
+void t76_trace_isr_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if configUSE_TRACE_FACILITY != 1
+#error "Tracing requires configUSE_TRACE_FACILITY, which numbers the tasks"
+#endif
+
+#define traceTASK_SWITCHED_IN()         t76_trace_task_switched_in((uint32_t)pxCurrentTCB->uxTCBNumber)
+#define traceTASK_CREATE(pxNewTCB)      t76_trace_task_created((uint32_t)(pxNewTCB)->uxTCBNumber, (pxNewTCB)->pcTaskName)
+#define traceISR_ENTER()                t76_trace_isr_enter()
+#define traceISR_EXIT()                 t76_trace_isr_exit()
+#define traceISR_EXIT_TO_SCHEDULER()    t76_trace_isr_exit()
+
+#endif // __ASSEMBLER__
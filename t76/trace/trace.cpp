@@ -0,0 +1,283 @@
+/**
+ * @file trace.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the trace recorder.
+ *
+ * The streaming task drains both rings every T76_IC_TRACE_FLUSH_PERIOD_MS
+ * into a packet buffer, which it passes to the sink whenever it is full and
+ * at the end of each pass. Events are not merged across cores; the host sorts
+ * them by timestamp. Task names are copied by the creation hook into a table
+ * indexed by task number, because a task's control block may be gone by the
+ * time its creation event is streamed.
+ *
+ */
+
+#include "t76/trace.hpp"
+
+#ifdef T76_IC_TRACE
+
+#include <algorithm>
+#include <cstring>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+
+using namespace T76::Core::Trace;
+
+
+T76::Core::Trace::Ring T76::Core::Trace::gRings[2];
+std::atomic<bool> T76::Core::Trace::gRunning{false};
+
+
+namespace {
+
+    struct Record {
+        uint32_t timestamp;
+        uint32_t value;
+        uint8_t type;
+        uint8_t core;
+        uint16_t length;
+    };
+
+    static_assert(sizeof(Record) == 12, "Trace records must be 12 bytes");
+
+    TaskHandle_t gTask = nullptr;
+
+    SinkFunction gSink = nullptr;
+    void *gSinkContext = nullptr;
+
+    std::atomic<bool> gRestart{false};
+
+    // Written by the creation hook inside a kernel critical section, read by the streaming task
+    char gTaskNames[T76_IC_TRACE_MAX_TASKS][configMAX_TASK_NAME_LEN];
+
+    // Span names already sent in the current stream
+    uint32_t gSentNames[T76_IC_TRACE_MAX_NAMES];
+    std::size_t gSentNameCount = 0;
+
+    uint8_t gPacket[T76_IC_TRACE_PACKET_SIZE] __attribute__((aligned(4)));
+    std::size_t gPacketLength = 0;
+
+    // Written by the streaming task only
+    uint32_t gEvents = 0;
+    uint64_t gBytesStreamed = 0;
+    uint32_t gReportedDrops = 0;
+
+    uint32_t droppedCount() {
+        return static_cast<uint32_t>(gRings[0].droppedCount() + gRings[1].droppedCount());
+    }
+
+    void flushPacket() {
+        if (gPacketLength == 0) {
+            return;
+        }
+
+        if (gSink != nullptr) {
+            gSink(gSinkContext, gPacket, gPacketLength);
+        }
+
+        gBytesStreamed += gPacketLength;
+        gPacketLength = 0;
+    }
+
+    /**
+     * @brief Append a record, and the name that follows it, to the packet
+     */
+    void append(EventType type, uint8_t core, uint32_t timestamp, uint32_t value, const char *name = nullptr, std::size_t nameLength = 0) {
+        const std::size_t padded = (nameLength + 3) & ~std::size_t(3);
+
+        if (gPacketLength + sizeof(Record) + padded > sizeof(gPacket)) {
+            flushPacket();
+        }
+
+        const Record record = { timestamp, value, static_cast<uint8_t>(type), core, static_cast<uint16_t>(padded) };
+
+        memcpy(gPacket + gPacketLength, &record, sizeof(record));
+        gPacketLength += sizeof(record);
+
+        if (padded > 0) {
+            memset(gPacket + gPacketLength, 0, padded);
+            memcpy(gPacket + gPacketLength, name, nameLength);
+            gPacketLength += padded;
+        }
+    }
+
+    void appendTaskName(uint8_t core, uint32_t timestamp, uint32_t taskNumber) {
+        if (taskNumber >= T76_IC_TRACE_MAX_TASKS || gTaskNames[taskNumber][0] == '\0') {
+            return;
+        }
+
+        append(EventType::TaskName, core, timestamp, taskNumber, gTaskNames[taskNumber], strnlen(gTaskNames[taskNumber], configMAX_TASK_NAME_LEN));
+    }
+
+    void appendSpanName(uint8_t core, uint32_t timestamp, uint32_t id) {
+        if (std::find(gSentNames, gSentNames + gSentNameCount, id) != gSentNames + gSentNameCount) {
+            return;
+        }
+
+        // Names that do not fit in the table are sent again at every use
+        if (gSentNameCount < T76_IC_TRACE_MAX_NAMES) {
+            gSentNames[gSentNameCount++] = id;
+        }
+
+        const char *name = reinterpret_cast<const char *>(static_cast<uintptr_t>(id));
+        append(EventType::SpanName, core, timestamp, id, name, std::min<std::size_t>(strlen(name), 0xfff0));
+    }
+
+    void beginStream() {
+        const uint32_t now = T76::Core::Timebase::now32();
+
+        gSentNameCount = 0;
+        gPacketLength = 0;
+
+        append(EventType::Start, static_cast<uint8_t>(get_core_num()), now, streamVersion);
+
+        for (uint32_t taskNumber = 0; taskNumber < T76_IC_TRACE_MAX_TASKS; taskNumber++) {
+            appendTaskName(0, now, taskNumber);
+        }
+    }
+
+    void streamEvent(const Event &event, uint8_t core) {
+        switch (event.type) {
+            case EventType::TaskCreated:
+                appendTaskName(core, event.timestamp, event.value);
+                return;
+
+            case EventType::SpanBegin:
+            case EventType::SpanEnd:
+            case EventType::Instant:
+                appendSpanName(core, event.timestamp, event.value);
+                break;
+
+            default:
+                break;
+        }
+
+        append(event.type, core, event.timestamp, event.value);
+        gEvents++;
+    }
+
+    void traceTask(void *) {
+        for (;;) {
+            vTaskDelay(pdMS_TO_TICKS(T76_IC_TRACE_FLUSH_PERIOD_MS));
+
+            if (gRestart.exchange(false, std::memory_order_acquire)) {
+                beginStream();
+            }
+
+            for (uint8_t core = 0; core < 2; core++) {
+                Event event;
+
+                while (gRings[core].tryPop(event)) {
+                    streamEvent(event, core);
+                }
+            }
+
+            const uint32_t drops = droppedCount();
+
+            if (drops != gReportedDrops) {
+                append(EventType::Dropped, 0, T76::Core::Timebase::now32(), drops - gReportedDrops);
+                gReportedDrops = drops;
+            }
+
+            flushPacket();
+        }
+    }
+
+} // namespace
+
+
+extern "C" void t76_trace_task_switched_in(uint32_t taskNumber) {
+    record(EventType::TaskSwitch, taskNumber);
+}
+
+extern "C" void t76_trace_task_created(uint32_t taskNumber, const char *name) {
+    if (taskNumber < T76_IC_TRACE_MAX_TASKS && name != nullptr) {
+        strncpy(gTaskNames[taskNumber], name, configMAX_TASK_NAME_LEN);
+    }
+
+    record(EventType::TaskCreated, taskNumber);
+}
+
+extern "C" void t76_trace_isr_enter(void) {
+    record(EventType::IsrEnter, __get_current_exception());
+}
+
+extern "C" void t76_trace_isr_exit(void) {
+    record(EventType::IsrExit, 0);
+}
+
+
+bool T76::Core::Trace::init() {
+    if (gTask != nullptr) {
+        return true;
+    }
+
+    if (xTaskCreate(traceTask, "Trace", T76_IC_TRACE_TASK_STACK_SIZE, nullptr, T76_IC_TRACE_TASK_PRIORITY, &gTask) != pdPASS) {
+        LOGE("Trace: cannot create the trace task\n");
+        gTask = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void T76::Core::Trace::setSink(SinkFunction sink, void *context) {
+    gSinkContext = context;
+    gSink = sink;
+}
+
+void T76::Core::Trace::start() {
+    if (gRunning.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    gRestart.store(true, std::memory_order_release);
+    gRunning.store(true, std::memory_order_release);
+}
+
+void T76::Core::Trace::stop() {
+    gRunning.store(false, std::memory_order_release);
+}
+
+Stats T76::Core::Trace::stats() {
+    Stats stats{};
+
+    // Keeps the streaming task from updating the counters halfway through the copy
+    vTaskSuspendAll();
+    stats.events = gEvents;
+    stats.bytesStreamed = gBytesStreamed;
+    xTaskResumeAll();
+
+    stats.running = gRunning.load(std::memory_order_relaxed);
+    stats.dropped = droppedCount();
+    return stats;
+}
+
+#else
+
+bool T76::Core::Trace::init() {
+    return false;
+}
+
+void T76::Core::Trace::setSink(SinkFunction, void *) {
+}
+
+void T76::Core::Trace::start() {
+}
+
+void T76::Core::Trace::stop() {
+}
+
+T76::Core::Trace::Stats T76::Core::Trace::stats() {
+    return Stats{};
+}
+
+#endif
@@ -0,0 +1,285 @@
+"""Capture a trace from an Instrument Core device and convert it for Perfetto.
+
+The firmware streams its trace over the vendor bulk IN endpoint as 12-byte
+records (see t76/trace/t76/trace.hpp). This script can capture that stream
+from a device whose application binds SYSTem:TRACe to the trace recorder, as
+the usb_bench example does, and converts a stream to the Chrome trace JSON
+format, which https://ui.perfetto.dev and chrome://tracing open directly.
+
+    python3 trace_to_perfetto.py capture -d 5 -o trace.json
+    python3 trace_to_perfetto.py convert trace.bin -o trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+RECORD = struct.Struct("<IIBBH")
+
+# Record types, from T76::Core::Trace::EventType
+START = 0x00
+TASK_SWITCH = 0x01
+ISR_ENTER = 0x02
+ISR_EXIT = 0x03
+SPAN_BEGIN = 0x04
+SPAN_END = 0x05
+INSTANT = 0x06
+DROPPED = 0x08
+TASK_NAME = 0x80
+SPAN_NAME = 0x81
+
+STREAM_VERSION = 1
+
+# Thread ids of the tracks that do not belong to a task
+SCHEDULER_TID = 1000
+INTERRUPT_TID = 1001
+MAIN_TID = 0
+
+EXCEPTION_NAMES = {2: "NMI", 3: "HardFault", 11: "SVCall", 14: "PendSV", 15: "SysTick"}
+
+DEFAULT_RESOURCE_FRAGMENT = "USB0::0x2E8A::0x000A"
+DEFAULT_VENDOR_ID = 0x2E8A
+DEFAULT_PRODUCT_ID = 0x000A
+EPNUM_VENDOR_IN = 0x85          # From t76/usb/usb_descriptors.h
+
+
+def parse(data):
+    """Yield (type, core, timestamp, value, name) for every record of a stream."""
+    offset = 0
+
+    while offset + RECORD.size <= len(data):
+        timestamp, value, kind, core, length = RECORD.unpack_from(data, offset)
+        offset += RECORD.size
+
+        name = None
+        if length:
+            name = data[offset:offset + length].split(b"\0", 1)[0].decode("utf-8", "replace")
+            offset += length
+
+        yield kind, core, timestamp, value, name
+
+
+def exception_name(number):
+    if number >= 16:
+        return f"IRQ {number - 16}"
+    return EXCEPTION_NAMES.get(number, f"Exception {number}")
+
+
+class Converter:
+    """Turns trace records into Chrome trace events."""
+
+    def __init__(self):
+        self.events = []
+        self.task_names = {}
+        self.span_names = {}
+        self.reference = None
+
+    def unwrap(self, timestamp):
+        # The device timer is 32 bits of microseconds; records from the two
+        # cores are interleaved out of order, so unwrap relative to the last one
+        if self.reference is None:
+            self.reference = timestamp
+            return timestamp
+
+        delta = (timestamp - self.reference) & 0xFFFFFFFF
+        if delta >= 0x80000000:
+            delta -= 0x100000000
+
+        self.reference += delta
+        return self.reference
+
+    def convert(self, data):
+        records = []
+
+        for index, (kind, core, timestamp, value, name) in enumerate(parse(data)):
+            if kind == START:
+                if value != STREAM_VERSION:
+                    raise ValueError(f"Unsupported trace stream version {value}")
+                continue
+
+            if kind == TASK_NAME:
+                self.task_names[value] = name
+                continue
+
+            if kind == SPAN_NAME:
+                self.span_names[value] = name
+                continue
+
+            records.append((self.unwrap(timestamp), index, kind, core, value))
+
+        records.sort()
+
+        # Start the timeline at the first event
+        base = records[0][0] if records else 0
+        records = [(timestamp - base, *rest) for timestamp, *rest in records]
+
+        current_task = {}
+        switched_in = {}
+        isr_depth = {}
+
+        for timestamp, _, kind, core, value in records:
+            depth = isr_depth.get(core, 0)
+
+            if kind == TASK_SWITCH:
+                previous = current_task.get(core)
+
+                if previous is not None:
+                    self.complete(core, SCHEDULER_TID, self.task_name(previous), switched_in[core], timestamp)
+
+                current_task[core] = value
+                switched_in[core] = timestamp
+
+            elif kind == ISR_ENTER:
+                isr_depth[core] = depth + 1
+                self.event("B", core, INTERRUPT_TID, exception_name(value), timestamp)
+
+            elif kind == ISR_EXIT:
+                if depth > 0:
+                    isr_depth[core] = depth - 1
+                    self.event("E", core, INTERRUPT_TID, None, timestamp)
+
+            elif kind in (SPAN_BEGIN, SPAN_END, INSTANT):
+                tid = INTERRUPT_TID if depth > 0 else current_task.get(core, MAIN_TID)
+                name = self.span_names.get(value, f"0x{value:08x}")
+
+                if kind == SPAN_BEGIN:
+                    self.event("B", core, tid, name, timestamp)
+                elif kind == SPAN_END:
+                    self.event("E", core, tid, name, timestamp)
+                else:
+                    self.event("i", core, tid, name, timestamp, s="t")
+
+            elif kind == DROPPED:
+                self.event("i", core, SCHEDULER_TID, f"{value} events dropped", timestamp, s="p")
+
+        # Close the slices of the tasks that were running when the stream ended
+        end = records[-1][0] if records else 0
+
+        for core, task in current_task.items():
+            self.complete(core, SCHEDULER_TID, self.task_name(task), switched_in[core], end)
+
+        self.metadata()
+        return {"traceEvents": self.events, "displayTimeUnit": "ns"}
+
+    def task_name(self, number):
+        return self.task_names.get(number, f"Task {number}")
+
+    def event(self, phase, core, tid, name, timestamp, **extra):
+        event = {"ph": phase, "pid": core, "tid": tid, "ts": timestamp}
+        if name is not None:
+            event["name"] = name
+        event.update(extra)
+        self.events.append(event)
+
+    def complete(self, core, tid, name, start, end):
+        self.events.append({"ph": "X", "pid": core, "tid": tid, "name": name, "ts": start, "dur": end - start})
+
+    def metadata(self):
+        cores = {event["pid"] for event in self.events}
+
+        for core in sorted(cores):
+            self.events.append({"ph": "M", "pid": core, "name": "process_name", "args": {"name": f"Core {core}"}})
+            self.events.append({"ph": "M", "pid": core, "tid": SCHEDULER_TID, "name": "thread_name",
+                                "args": {"name": "Scheduler"}})
+            self.events.append({"ph": "M", "pid": core, "tid": INTERRUPT_TID, "name": "thread_name",
+                                "args": {"name": "Interrupts"}})
+            self.events.append({"ph": "M", "pid": core, "tid": MAIN_TID, "name": "thread_name",
+                                "args": {"name": "Main"}})
+
+        for number, name in self.task_names.items():
+            self.events.append({"ph": "M", "pid": 0, "tid": number, "name": "thread_name", "args": {"name": name}})
+
+
+def capture(args):
+    """Start a trace, read the vendor bulk IN endpoint for a while and stop it."""
+    import pyvisa
+    import usb.core
+    import usb.util
+
+    rm = pyvisa.ResourceManager()
+    resource = next((res for res in rm.list_resources() if args.resource_fragment in res), None)
+    if resource is None:
+        raise RuntimeError("USBTMC device not found.")
+
+    instrument = rm.open_resource(resource)
+    instrument.timeout = 2000
+
+    device = usb.core.find(idVendor=args.vid, idProduct=args.pid)
+    if device is None:
+        raise RuntimeError("USB device not found.")
+
+    data = bytearray()
+
+    def read(timeout_ms):
+        try:
+            data.extend(device.read(EPNUM_VENDOR_IN, 16384, timeout=timeout_ms))
+            return True
+        except usb.core.USBTimeoutError:
+            return False
+
+    try:
+        # Discard anything a previous trace left in the endpoint
+        while read(50):
+            pass
+        data.clear()
+
+        instrument.write("SYST:TRAC ON")
+        deadline = time.monotonic() + args.duration
+
+        while time.monotonic() < deadline:
+            read(100)
+
+        instrument.write("SYST:TRAC OFF")
+
+        while read(200):
+            pass
+    finally:
+        instrument.close()
+        usb.util.dispose_resources(device)
+
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Capture and convert Instrument Core traces for Perfetto.")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    capture_parser = commands.add_parser("capture", help="Capture a trace from a device.")
+    capture_parser.add_argument("-d", "--duration", type=float, default=5.0, help="Seconds to trace.")
+    capture_parser.add_argument("-o", "--output", required=True, help="Chrome trace JSON file to write.")
+    capture_parser.add_argument("--raw", help="Also keep the raw stream in this file.")
+    capture_parser.add_argument("-r", "--resource-fragment", default=DEFAULT_RESOURCE_FRAGMENT,
+                                help="Substring used to select the VISA resource.")
+    capture_parser.add_argument("--vid", type=lambda value: int(value, 0), default=DEFAULT_VENDOR_ID,
+                                help="USB vendor ID.")
+    capture_parser.add_argument("--pid", type=lambda value: int(value, 0), default=DEFAULT_PRODUCT_ID,
+                                help="USB product ID.")
+
+    convert_parser = commands.add_parser("convert", help="Convert a raw stream captured earlier.")
+    convert_parser.add_argument("input", help="Raw trace stream.")
+    convert_parser.add_argument("-o", "--output", required=True, help="Chrome trace JSON file to write.")
+
+    args = parser.parse_args()
+
+    if args.command == "capture":
+        data = capture(args)
+
+        if args.raw:
+            with open(args.raw, "wb") as raw:
+                raw.write(data)
+    else:
+        with open(args.input, "rb") as raw:
+            data = raw.read()
+
+    trace = Converter().convert(data)
+
+    with open(args.output, "w") as output:
+        json.dump(trace, output)
+
+    print(f"{len(data)} bytes, {len(trace['traceEvents'])} trace events written to {args.output}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
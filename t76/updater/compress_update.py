@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Compress an application image into LZ4 update write payloads."""
+
+from __future__ import annotations
+
+import argparse
+from pathlib import Path
+from typing import Iterator
+
+
+PAGE_SIZE = 256
+SECTOR_SIZE = 4096
+MIN_MATCH = 4
+MAX_DISTANCE = 0xFFFF
+# The LZ4 block format ends with at least five literals, and the last match
+# starts at least twelve bytes before the end
+LAST_LITERALS = 5
+MATCH_LIMIT = 12
+
+
+def _length_bytes(length: int) -> bytes:
+    out = bytearray()
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+    return bytes(out)
+
+
+def _sequence(literals: bytes, distance: int = 0, match: int = 0) -> bytes:
+    literal_nibble = min(len(literals), 15)
+    match_nibble = min(match - MIN_MATCH, 15) if match else 0
+    out = bytearray([(literal_nibble << 4) | match_nibble])
+    if literal_nibble == 15:
+        out += _length_bytes(len(literals) - 15)
+    out += literals
+    if match:
+        out += distance.to_bytes(2, "little")
+        if match_nibble == 15:
+            out += _length_bytes(match - MIN_MATCH - 15)
+    return bytes(out)
+
+
+def compress_block(data: bytes) -> bytes:
+    """Compress data as a single LZ4 block, greedily, with a 4-byte hash table."""
+    out = bytearray()
+    table: dict[bytes, int] = {}
+    anchor = 0
+    position = 0
+    end = len(data) - MATCH_LIMIT
+    while position < end:
+        key = data[position:position + MIN_MATCH]
+        candidate = table.get(key)
+        table[key] = position
+        if candidate is None or position - candidate > MAX_DISTANCE:
+            position += 1
+            continue
+        match = MIN_MATCH
+        limit = len(data) - LAST_LITERALS
+        while position + match < limit and data[candidate + match] == data[position + match]:
+            match += 1
+        out += _sequence(data[anchor:position], position - candidate, match)
+        position += match
+        anchor = position
+    out += _sequence(data[anchor:])
+    return bytes(out)
+
+
+def write_payloads(image: bytes, base_offset: int) -> Iterator[bytes]:
+    """Yield the UPDATE_WRITE payloads of a session begun with T76_WINUSB_UPDATE_FLAG_LZ4.
+
+    Each payload covers up to one sector: the flash offset, the length of
+    the data, and the data compressed on its own. The image is padded with
+    0xff to a whole number of pages.
+    """
+    if base_offset % PAGE_SIZE != 0:
+        raise ValueError("base offset must be page aligned")
+    padding = -len(image) % PAGE_SIZE
+    image = image + b"\xff" * padding
+    for start in range(0, len(image), SECTOR_SIZE):
+        chunk = image[start:start + SECTOR_SIZE]
+        yield (
+            (base_offset + start).to_bytes(4, "little")
+            + len(chunk).to_bytes(4, "little")
+            + compress_block(chunk)
+        )
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--base-offset", type=lambda value: int(value, 0), default=0)
+    parser.add_argument("image", type=Path, help="raw application image (.bin)")
+    args = parser.parse_args()
+
+    image = args.image.read_bytes()
+    payloads = list(write_payloads(image, args.base_offset))
+    compressed = sum(len(payload) for payload in payloads)
+    print(f"{len(image)} bytes in {len(payloads)} writes, {compressed} bytes compressed "
+          f"({100.0 * compressed / max(len(image), 1):.1f}%)")
+
+
+if __name__ == "__main__":
+    main()
@@ -12,6 +12,7 @@
 #include <string.h>
 
 #include "bsp/board_api.h"
+#include "hardware/dma.h"
 #include "hardware/flash.h"
 #include "hardware/regs/addressmap.h"
 #include "hardware/structs/watchdog.h"
@@ -26,6 +27,7 @@
 #include "device/usbd_pvt.h"
 
 #include <t76/updater/boot_request.h>
+#include <t76/updater/lz4_block.h>
 
 #ifndef T76_IC_USB_VENDOR_ID
 #define T76_IC_USB_VENDOR_ID 0x2E8A
@@ -80,6 +82,13 @@
 #define T76_STAGE3_UPDATER_WINUSB_DESC_LEN 23u
 #define T76_STAGE3_UPDATER_RESET_DESC_LEN 9u
 #define T76_STAGE3_UPDATER_MIN_WRITE_PAYLOAD 4u
+#define T76_STAGE3_UPDATER_WRITE_BUFFERS 2u
+#define T76_STAGE3_UPDATER_RX_FRAMES 4u
+#define T76_STAGE3_UPDATER_MAX_WINDOW 32u
+#define T76_STAGE3_UPDATER_MAX_HASH_SECTORS 32u
+#define T76_STAGE3_UPDATER_LZ4_MAX_LENGTH FLASH_SECTOR_SIZE
+#define T76_STAGE3_UPDATER_CRC_DMA_MIN_SIZE 64u
+#define T76_STAGE3_UPDATER_CRC_DMA_MAX_CHUNK (1u << 24)
 #define T76_STAGE3_UPDATER_STATE_IDLE 0u
 #define T76_STAGE3_UPDATER_STATE_ACTIVE 1u
 #define T76_STAGE3_BOOTLOADER_SRAM_START 0x20000000u
@@ -118,9 +127,11 @@
 
 static uint8_t rx_frame[T76_STAGE3_UPDATER_MAX_FRAME_SIZE];
 static uint32_t rx_frame_len;
-static uint8_t pending_frame[T76_STAGE3_UPDATER_MAX_FRAME_SIZE];
-static uint32_t pending_frame_len;
-static bool pending_frame_ready;
+static uint8_t pending_frames[T76_STAGE3_UPDATER_RX_FRAMES][T76_STAGE3_UPDATER_MAX_FRAME_SIZE];
+static uint32_t pending_frame_lens[T76_STAGE3_UPDATER_RX_FRAMES];
+static uint32_t pending_frames_first;
+static uint32_t pending_frames_count;
+static bool winusb_rx_paused;
 static uint8_t response_frame[256];
 static uint32_t update_base_offset;
 static uint32_t update_total_length;
@@ -128,7 +139,26 @@ static uint32_t update_crc32;
 static uint32_t update_bytes_written;
 static uint32_t update_running_crc32;
 static uint32_t update_next_offset;
+static uint32_t update_write_end;
+static uint32_t update_last_write_len;
+static uint32_t update_last_write_crc32;
 static uint32_t update_state;
+static uint32_t update_flags;
+static uint32_t update_window;
+static uint32_t update_next_sequence;
+static uint32_t update_window_unacked;
+static bool update_window_nacked;
+static uint32_t update_erased_end;
+static uint32_t update_erase_limit;
+static uint32_t update_page_offsets[T76_STAGE3_UPDATER_WRITE_BUFFERS];
+static uint8_t update_pages[T76_STAGE3_UPDATER_WRITE_BUFFERS][FLASH_PAGE_SIZE];
+static uint32_t update_pages_first;
+static uint8_t update_lz4_buffer[T76_STAGE3_UPDATER_LZ4_MAX_LENGTH];
+static uint32_t update_pages_count;
+static uint32_t crc32_table[256];
+static int crc32_dma_channel = -1;
+static uint32_t crc32_dma_sink;
+static uint8_t crc32_erased[T76_STAGE3_UPDATER_CRC_DMA_MIN_SIZE];
 static uint8_t const desc_ms_os_20[T76_STAGE3_UPDATER_MS_OS_20_DESC_LEN];
 static uint8_t reset_interface_number;
 static uint8_t winusb_interface_number;
@@ -155,12 +185,76 @@ static void write_u32_le(uint8_t *data, uint32_t value) {
     data[3] = (uint8_t)((value >> 24u) & 0xffu);
 }
 
-static uint32_t crc32_update(uint32_t crc, const uint8_t *data, uint32_t size) {
-    for (uint32_t index = 0; index < size; ++index) {
-        crc ^= data[index];
+static uint32_t bit_reverse_u32(uint32_t value) {
+    value = ((value >> 1u) & 0x55555555u) | ((value & 0x55555555u) << 1u);
+    value = ((value >> 2u) & 0x33333333u) | ((value & 0x33333333u) << 2u);
+    value = ((value >> 4u) & 0x0f0f0f0fu) | ((value & 0x0f0f0f0fu) << 4u);
+    value = ((value >> 8u) & 0x00ff00ffu) | ((value & 0x00ff00ffu) << 8u);
+    return (value >> 16u) | (value << 16u);
+}
+
+static void crc32_init(void) {
+    for (uint32_t index = 0; index < 256u; ++index) {
+        uint32_t crc = index;
         for (uint32_t bit = 0; bit < 8u; ++bit) {
             crc = (crc >> 1u) ^ ((crc & 1u) != 0u ? 0xedb88320u : 0u);
         }
+        crc32_table[index] = crc;
+    }
+    memset(crc32_erased, 0xff, sizeof(crc32_erased));
+    // Without a free channel, every CRC is computed with the table
+    crc32_dma_channel = dma_claim_unused_channel(false);
+}
+
+static uint32_t crc32_update_table(uint32_t crc, const uint8_t *data, uint32_t size) {
+    for (uint32_t index = 0; index < size; ++index) {
+        crc = (crc >> 8u) ^ crc32_table[(crc ^ data[index]) & 0xffu];
+    }
+    return crc;
+}
+
+// The sniffer computes the MSB-first CRC-32 of bit-reversed bytes, which is the
+// reflected CRC-32 with its register bit-reversed; the seed is reversed on the
+// way in and the output reversal undoes it on the way out.
+static uint32_t crc32_update_dma(uint32_t crc, const uint8_t *data, uint32_t size, bool read_increment) {
+    dma_channel_config config = dma_channel_get_default_config((uint)crc32_dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, read_increment);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_sniff_enable(&config, true);
+
+    dma_sniffer_enable((uint)crc32_dma_channel, DMA_SNIFF_CTRL_CALC_VALUE_CRC32R, true);
+    dma_sniffer_set_output_reverse_enabled(true);
+    dma_sniffer_set_data_accumulator(bit_reverse_u32(crc));
+
+    while (size > 0u) {
+        const uint32_t chunk = size < T76_STAGE3_UPDATER_CRC_DMA_MAX_CHUNK ? size : T76_STAGE3_UPDATER_CRC_DMA_MAX_CHUNK;
+        dma_channel_configure((uint)crc32_dma_channel, &config, &crc32_dma_sink, data, chunk, true);
+        dma_channel_wait_for_finish_blocking((uint)crc32_dma_channel);
+        data += read_increment ? chunk : 0u;
+        size -= chunk;
+    }
+
+    crc = dma_sniffer_get_data_accumulator();
+    dma_sniffer_disable();
+    return crc;
+}
+
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, uint32_t size) {
+    if (crc32_dma_channel >= 0 && size >= T76_STAGE3_UPDATER_CRC_DMA_MIN_SIZE) {
+        return crc32_update_dma(crc, data, size, true);
+    }
+    return crc32_update_table(crc, data, size);
+}
+
+static uint32_t crc32_update_erased(uint32_t crc, uint32_t size) {
+    if (crc32_dma_channel >= 0 && size >= T76_STAGE3_UPDATER_CRC_DMA_MIN_SIZE) {
+        return crc32_update_dma(crc, crc32_erased, size, false);
+    }
+    while (size > 0u) {
+        const uint32_t chunk = size < sizeof(crc32_erased) ? size : (uint32_t)sizeof(crc32_erased);
+        crc = crc32_update(crc, crc32_erased, chunk);
+        size -= chunk;
     }
     return crc;
 }
@@ -249,27 +343,131 @@ static void send_ack(uint8_t tag) {
     send_frame(T76_WINUSB_FRAME_UPDATE_ACK, tag, NULL, 0u);
 }
 
+static void send_window_ack(uint8_t tag) {
+    uint8_t payload[4];
+    write_u32_le(&payload[0], update_next_sequence);
+    send_frame(T76_WINUSB_FRAME_UPDATE_WINDOW_ACK, tag, payload, sizeof(payload));
+    update_window_unacked = 0u;
+}
+
+// The window fields follow the original 16 bytes, so hosts that read only
+// those are unaffected
 static void send_status(uint8_t tag) {
-    uint8_t payload[16];
+    uint8_t payload[28];
     write_u32_le(&payload[0], update_state);
     write_u32_le(&payload[4], update_base_offset);
     write_u32_le(&payload[8], update_total_length);
     write_u32_le(&payload[12], update_bytes_written);
+    write_u32_le(&payload[16], T76_STAGE3_UPDATER_MAX_WINDOW);
+    write_u32_le(&payload[20], update_window);
+    write_u32_le(&payload[24], update_next_sequence);
     send_frame(T76_WINUSB_FRAME_UPDATE_STATUS_RESPONSE, tag, payload, sizeof(payload));
 }
 
-static void erase_application_region(uint32_t base_offset, uint32_t total_length) {
-    const uint32_t erase_start = base_offset & ~(FLASH_SECTOR_SIZE - 1u);
-    const uint32_t erase_end = (base_offset + total_length + FLASH_SECTOR_SIZE - 1u) & ~(FLASH_SECTOR_SIZE - 1u);
-    flash_range_erase(erase_start, erase_end - erase_start);
+// Sectors are erased as the writes reach them rather than all at UPDATE_BEGIN,
+// so the host starts sending at once and the erase time is spread over the
+// transfer. update_erased_end is the end of the erased part of the region;
+// in a differential update, the part from the last sector written.
+static void erase_application_sectors(uint32_t erase_end) {
+    if (erase_end > update_erase_limit) {
+        erase_end = update_erase_limit;
+    }
+    if (erase_end <= update_erased_end) {
+        return;
+    }
+#if T76_UPDATER_DRY_RUN_FLASH == 0
+    uint32_t ints = save_and_disable_interrupts();
+    flash_range_erase(update_erased_end, erase_end - update_erased_end);
+    restore_interrupts(ints);
+#endif
+    update_erased_end = erase_end;
 }
 
 static void __not_in_flash_func(program_flash)(uint32_t flash_offset, const uint8_t *payload, uint32_t payload_len) {
     flash_range_program(flash_offset, payload, payload_len);
 }
 
+static bool update_differential(void) {
+    return (update_flags & T76_WINUSB_UPDATE_FLAG_DIFFERENTIAL) != 0u;
+}
+
+static bool update_compressed(void) {
+    return (update_flags & T76_WINUSB_UPDATE_FLAG_LZ4) != 0u;
+}
+
+#if T76_UPDATER_DRY_RUN_FLASH != 0
+// Bytes that no write reached read as erased. In a differential update, only
+// the rest of a sector that a write entered does; the sectors that no write
+// entered keep their current contents.
+static void update_running_crc32_gap(uint32_t gap) {
+    if (update_differential()) {
+        const uint32_t sector_rest = update_next_offset == update_base_offset ? 0u :
+            (FLASH_SECTOR_SIZE - (update_next_offset & (FLASH_SECTOR_SIZE - 1u))) & (FLASH_SECTOR_SIZE - 1u);
+        const uint32_t erased = gap < sector_rest ? gap : sector_rest;
+        update_running_crc32 = crc32_update_erased(update_running_crc32, erased);
+        update_running_crc32 = crc32_update(update_running_crc32, (const uint8_t *)(XIP_BASE + update_next_offset + erased), gap - erased);
+    } else {
+        update_running_crc32 = crc32_update_erased(update_running_crc32, gap);
+    }
+}
+#endif
+
+static void commit_update_page(void) {
+    const uint32_t flash_offset = update_page_offsets[update_pages_first];
+    const uint8_t *data = update_pages[update_pages_first];
+    update_pages_first = (update_pages_first + 1u) % T76_STAGE3_UPDATER_WRITE_BUFFERS;
+    update_pages_count -= 1u;
+#if T76_UPDATER_DRY_RUN_FLASH != 0
+    if (update_next_offset < flash_offset) {
+        const uint32_t gap = flash_offset - update_next_offset;
+        update_running_crc32_gap(gap);
+        update_bytes_written += gap;
+    }
+    update_running_crc32 = crc32_update(update_running_crc32, data, FLASH_PAGE_SIZE);
+#else
+    const uint32_t sector = flash_offset & ~(FLASH_SECTOR_SIZE - 1u);
+    if (update_differential() && sector > update_erased_end) {
+        // Skip the unchanged sectors in between
+        update_erased_end = sector;
+    }
+    erase_application_sectors(sector + FLASH_SECTOR_SIZE);
+    uint32_t ints = save_and_disable_interrupts();
+    program_flash(flash_offset, data, FLASH_PAGE_SIZE);
+    restore_interrupts(ints);
+#endif
+    update_next_offset = flash_offset + FLASH_PAGE_SIZE;
+    update_bytes_written += FLASH_PAGE_SIZE;
+}
+
+static void flush_update_pages(void) {
+    while (update_pages_count > 0u) {
+        commit_update_page();
+    }
+}
+
+// Called from the main loop after the USB stack and any received frame have
+// been serviced. Each call programs at most one buffered page, or erases the
+// sector after the write cursor, so reception of the next frame resumes in
+// between.
+static void service_update(void) {
+    if (update_state != T76_STAGE3_UPDATER_STATE_ACTIVE) {
+        return;
+    }
+    if (update_pages_count > 0u) {
+        commit_update_page();
+        return;
+    }
+    if (update_differential()) {
+        return;
+    }
+    const uint32_t cursor_sector = update_next_offset & ~(FLASH_SECTOR_SIZE - 1u);
+    if (update_erased_end <= cursor_sector + FLASH_SECTOR_SIZE) {
+        erase_application_sectors(update_erased_end + FLASH_SECTOR_SIZE);
+    }
+}
+
 static void handle_update_begin(uint8_t tag, const uint8_t *payload, uint32_t payload_len) {
-    if (payload_len != 12u) {
+    if (payload_len != 12u && payload_len != 16u && payload_len != 20u) {
         send_error(tag, "Invalid update begin payload");
         return;
     }
@@ -279,59 +477,163 @@ static void handle_update_begin(uint8_t tag, const uint8_t *payload, uint32_t pa
         send_error(tag, "Update range is outside application flash");
         return;
     }
+    if (payload_len == 20u && (read_u32_le(&payload[16]) & ~(T76_WINUSB_UPDATE_FLAG_DIFFERENTIAL | T76_WINUSB_UPDATE_FLAG_LZ4)) != 0u) {
+        send_error(tag, "Unsupported update flags");
+        return;
+    }
     update_base_offset = base_offset;
     update_total_length = total_length;
     update_crc32 = read_u32_le(&payload[8]);
     update_bytes_written = 0u;
     update_running_crc32 = 0xffffffffu;
     update_next_offset = update_base_offset;
+    update_write_end = update_base_offset;
+    update_last_write_len = 0u;
+    update_erased_end = base_offset & ~(FLASH_SECTOR_SIZE - 1u);
+    update_erase_limit = (base_offset + total_length + FLASH_SECTOR_SIZE - 1u) & ~(FLASH_SECTOR_SIZE - 1u);
+    update_pages_first = 0u;
+    update_pages_count = 0u;
+    update_next_sequence = 0u;
+    update_window_unacked = 0u;
+    update_window_nacked = false;
+    update_window = 0u;
+    update_flags = payload_len == 20u ? read_u32_le(&payload[16]) : 0u;
     update_state = T76_STAGE3_UPDATER_STATE_ACTIVE;
-#if T76_UPDATER_DRY_RUN_FLASH == 0
-    uint32_t ints = save_and_disable_interrupts();
-    erase_application_region(update_base_offset, update_total_length);
-    restore_interrupts(ints);
-#endif
-    send_ack(tag);
+    if (payload_len == 12u) {
+        send_ack(tag);
+        return;
+    }
+    // A host that asks for a window gets one of at least a single write
+    update_window = read_u32_le(&payload[12]);
+    if (update_window == 0u) {
+        update_window = 1u;
+    } else if (update_window > T76_STAGE3_UPDATER_MAX_WINDOW) {
+        update_window = T76_STAGE3_UPDATER_MAX_WINDOW;
+    }
+    uint8_t granted[4];
+    write_u32_le(&granted[0], update_window);
+    send_frame(T76_WINUSB_FRAME_UPDATE_ACK, tag, granted, sizeof(granted));
 }
 
-static void handle_update_write(uint8_t tag, const uint8_t *payload, uint32_t payload_len) {
+// The page is acknowledged once it is buffered, and programmed by
+// service_update() while the host sends the next one
+static void buffer_update_page(uint32_t flash_offset, const uint8_t *data) {
+    if (update_pages_count == T76_STAGE3_UPDATER_WRITE_BUFFERS) {
+        commit_update_page();
+    }
+    const uint32_t slot = (update_pages_first + update_pages_count) % T76_STAGE3_UPDATER_WRITE_BUFFERS;
+    update_page_offsets[slot] = flash_offset;
+    memcpy(update_pages[slot], data, FLASH_PAGE_SIZE);
+    update_pages_count += 1u;
+}
+
+// Validates and buffers one write; returns false after sending an error. A
+// plain write holds one page, a compressed one the length of a whole number
+// of pages, up to a sector, and an LZ4 block that expands to it.
+static bool queue_update_write(uint8_t tag, const uint8_t *payload, uint32_t payload_len) {
     if (update_state != T76_STAGE3_UPDATER_STATE_ACTIVE) {
         send_error(tag, "Update has not begun");
-        return;
+        return false;
     }
-    if (payload_len < T76_STAGE3_UPDATER_MIN_WRITE_PAYLOAD) {
+    const uint32_t header_len = update_compressed() ? 8u : 4u;
+    if (payload_len < T76_STAGE3_UPDATER_MIN_WRITE_PAYLOAD || payload_len < header_len) {
         send_error(tag, "Invalid update write payload");
-        return;
+        return false;
     }
     const uint32_t flash_offset = read_u32_le(payload);
-    const uint32_t data_len = payload_len - 4u;
+    const uint32_t data_len = update_compressed() ? read_u32_le(&payload[4]) : payload_len - 4u;
+    const uint32_t max_len = update_compressed() ? T76_STAGE3_UPDATER_LZ4_MAX_LENGTH : FLASH_PAGE_SIZE;
     if ((flash_offset & (FLASH_PAGE_SIZE - 1u)) != 0u ||
-        data_len != FLASH_PAGE_SIZE) {
+        (data_len & (FLASH_PAGE_SIZE - 1u)) != 0u ||
+        data_len == 0u || data_len > max_len ||
+        (!update_compressed() && data_len != FLASH_PAGE_SIZE)) {
         send_error(tag, "Update writes must be flash-page aligned");
-        return;
+        return false;
     }
     if (!range_allowed(flash_offset, data_len) ||
         flash_offset < update_base_offset ||
         flash_offset + data_len > update_base_offset + update_total_length) {
         send_error(tag, "Update write is outside the active range");
+        return false;
+    }
+    // Sectors are only erased once, as the writes reach them, so a page
+    // below the end of the previous write could land on programmed flash
+    if (flash_offset < update_write_end) {
+        send_error(tag, "Update writes must be in increasing order of offset");
+        return false;
+    }
+    // The first write to a sector erases all of it, so a differential update
+    // may only skip whole sectors: the sector it leaves must be complete,
+    // and the one it enters must be written from its start
+    if (update_differential() && flash_offset != update_write_end &&
+        ((update_write_end != update_base_offset && (update_write_end & (FLASH_SECTOR_SIZE - 1u)) != 0u) ||
+         (flash_offset & (FLASH_SECTOR_SIZE - 1u)) != 0u)) {
+        send_error(tag, "Differential updates must write whole sectors");
+        return false;
+    }
+    const uint8_t *data = payload + header_len;
+    if (update_compressed()) {
+        if (!t76_lz4_decompress(data, payload_len - header_len, update_lz4_buffer, data_len)) {
+            send_error(tag, "Invalid compressed update write");
+            return false;
+        }
+        data = update_lz4_buffer;
+    }
+    for (uint32_t offset = 0u; offset < data_len; offset += FLASH_PAGE_SIZE) {
+        buffer_update_page(flash_offset + offset, data + offset);
+    }
+    update_write_end = flash_offset + data_len;
+    return true;
+}
+
+// A stop-and-wait host that lost or timed out on an UPDATE_ACK sends the
+// same write again. An exact repeat of the most recent write is acked
+// without being programmed again, as it was before sectors were erased
+// lazily.
+static void handle_update_write(uint8_t tag, const uint8_t *payload, uint32_t payload_len) {
+    const uint32_t payload_crc32 = ~crc32_update(0xffffffffu, payload, payload_len);
+    if (update_state == T76_STAGE3_UPDATER_STATE_ACTIVE && update_last_write_len != 0u &&
+        payload_len == update_last_write_len && payload_crc32 == update_last_write_crc32) {
+        send_ack(tag);
         return;
     }
-#if T76_UPDATER_DRY_RUN_FLASH != 0
-    while (update_next_offset < flash_offset) {
-        const uint8_t erased = 0xffu;
-        update_running_crc32 = crc32_update(update_running_crc32, &erased, sizeof(erased));
-        update_next_offset += 1u;
-        update_bytes_written += 1u;
-    }
-    update_running_crc32 = crc32_update(update_running_crc32, payload + 4u, data_len);
-    update_next_offset = flash_offset + data_len;
-#else
-    uint32_t ints = save_and_disable_interrupts();
-    program_flash(flash_offset, payload + 4u, data_len);
-    restore_interrupts(ints);
-#endif
-    update_bytes_written += data_len;
-    send_ack(tag);
+    if (queue_update_write(tag, payload, payload_len)) {
+        update_last_write_len = payload_len;
+        update_last_write_crc32 = payload_crc32;
+        send_ack(tag);
+    }
+}
+
+// Go-back-N: a write that is out of sequence, or follows one that failed, is
+// discarded, and the host resends from the sequence number in the next ack.
+// Acks are cumulative; one is sent when no further frame is queued, or when
+// half the window is unacknowledged, whichever comes first.
+static void handle_update_write_window(uint8_t tag, const uint8_t *payload, uint32_t payload_len) {
+    if (update_state != T76_STAGE3_UPDATER_STATE_ACTIVE || update_window == 0u) {
+        send_error(tag, "Windowed update has not begun");
+        return;
+    }
+    if (payload_len < 4u) {
+        send_error(tag, "Invalid update write payload");
+        return;
+    }
+    if (read_u32_le(payload) != update_next_sequence) {
+        if (!update_window_nacked) {
+            update_window_nacked = true;
+            send_window_ack(tag);
+        }
+        return;
+    }
+    if (!queue_update_write(tag, payload + 4u, payload_len - 4u)) {
+        update_window_nacked = true;
+        return;
+    }
+    update_next_sequence += 1u;
+    update_window_unacked += 1u;
+    update_window_nacked = false;
+    if (pending_frames_count <= 1u || update_window_unacked * 2u >= update_window) {
+        send_window_ack(tag);
+    }
 }
 
 static void handle_update_finish(uint8_t tag) {
@@ -339,14 +641,19 @@ static void handle_update_finish(uint8_t tag) {
         send_error(tag, "Update has not begun");
         return;
     }
+    flush_update_pages();
 #if T76_UPDATER_DRY_RUN_FLASH != 0
-    while (update_bytes_written < update_total_length) {
-        const uint8_t erased = 0xffu;
-        update_running_crc32 = crc32_update(update_running_crc32, &erased, sizeof(erased));
-        update_bytes_written += 1u;
+    if (update_bytes_written < update_total_length) {
+        update_running_crc32_gap(update_total_length - update_bytes_written);
+        update_bytes_written = update_total_length;
     }
     const uint32_t computed_crc = ~update_running_crc32;
 #else
+    // Sectors that no write reached must still read as erased, unless the
+    // update is differential and they hold the unchanged parts of the image
+    if (!update_differential()) {
+        erase_application_sectors(update_erase_limit);
+    }
     const uint8_t *image = (const uint8_t *)(XIP_BASE + update_base_offset);
     const uint32_t computed_crc = ~crc32_update(0xffffffffu, image, update_total_length);
 #endif
@@ -360,6 +667,33 @@ static void handle_update_finish(uint8_t tag) {
     watchdog_reboot(0, 0, 10);
 }
 
+// Reports the CRC32 of each of a run of sectors of the current image, so a
+// host can tell which sectors of a new image differ. Allowed in any state,
+// but a differential update must be computed from hashes taken before it
+// began writing.
+static void handle_update_hash(uint8_t tag, const uint8_t *payload, uint32_t payload_len) {
+    if (payload_len != 8u) {
+        send_error(tag, "Invalid update hash payload");
+        return;
+    }
+    const uint32_t flash_offset = read_u32_le(&payload[0]);
+    const uint32_t count = read_u32_le(&payload[4]);
+    if ((flash_offset & (FLASH_SECTOR_SIZE - 1u)) != 0u ||
+        count == 0u || count > T76_STAGE3_UPDATER_MAX_HASH_SECTORS ||
+        !range_allowed(flash_offset, count * FLASH_SECTOR_SIZE)) {
+        send_error(tag, "Invalid update hash range");
+        return;
+    }
+    uint8_t response[8u + 4u * T76_STAGE3_UPDATER_MAX_HASH_SECTORS];
+    write_u32_le(&response[0], flash_offset);
+    write_u32_le(&response[4], count);
+    for (uint32_t i = 0u; i < count; i++) {
+        const uint8_t *sector = (const uint8_t *)(XIP_BASE + flash_offset + i * FLASH_SECTOR_SIZE);
+        write_u32_le(&response[8u + 4u * i], ~crc32_update(0xffffffffu, sector, FLASH_SECTOR_SIZE));
+    }
+    send_frame(T76_WINUSB_FRAME_UPDATE_HASH_RESPONSE, tag, response, 8u + 4u * count);
+}
+
 static void handle_frame(const uint8_t *frame, uint32_t frame_len) {
     if (frame_len < T76_WINUSB_FRAME_HEADER_SIZE ||
         frame[0] != T76_WINUSB_FRAME_MAGIC0 ||
@@ -381,16 +715,23 @@ static void handle_frame(const uint8_t *frame, uint32_t frame_len) {
         case T76_WINUSB_FRAME_UPDATE_WRITE:
             handle_update_write(tag, payload, payload_len);
             break;
+        case T76_WINUSB_FRAME_UPDATE_WRITE_WINDOW:
+            handle_update_write_window(tag, payload, payload_len);
+            break;
         case T76_WINUSB_FRAME_UPDATE_FINISH:
             handle_update_finish(tag);
             break;
         case T76_WINUSB_FRAME_UPDATE_ABORT:
             update_state = T76_STAGE3_UPDATER_STATE_IDLE;
+            update_pages_count = 0u;
             send_ack(tag);
             break;
         case T76_WINUSB_FRAME_UPDATE_STATUS:
             send_status(tag);
             break;
+        case T76_WINUSB_FRAME_UPDATE_HASH:
+            handle_update_hash(tag, payload, payload_len);
+            break;
         default:
             send_error(tag, "Unsupported updater frame");
             break;
@@ -414,15 +755,27 @@ static void stage3_winusb_rx(const uint8_t *buffer, uint16_t bufsize) {
         return;
     }
     if (rx_frame_len >= frame_len) {
-        if (!pending_frame_ready) {
-            memcpy(pending_frame, rx_frame, frame_len);
-            pending_frame_len = frame_len;
-            pending_frame_ready = true;
+        if (pending_frames_count < T76_STAGE3_UPDATER_RX_FRAMES) {
+            const uint32_t slot = (pending_frames_first + pending_frames_count) % T76_STAGE3_UPDATER_RX_FRAMES;
+            memcpy(pending_frames[slot], rx_frame, frame_len);
+            pending_frame_lens[slot] = frame_len;
+            pending_frames_count += 1u;
         }
         rx_frame_len = 0u;
     }
 }
 
+// The OUT endpoint is only armed while a frame slot is free, so a host with
+// several frames in flight is held off with NAKs instead of losing frames
+static bool arm_winusb_rx(uint8_t rhport) {
+    if (pending_frames_count == T76_STAGE3_UPDATER_RX_FRAMES) {
+        winusb_rx_paused = true;
+        return true;
+    }
+    winusb_rx_paused = false;
+    return usbd_edpt_xfer(rhport, winusb_ep_out_address, winusb_ep_out_buffer, sizeof(winusb_ep_out_buffer));
+}
+
 void tud_vendor_rx_cb(uint8_t itf, uint8_t const *buffer, uint16_t bufsize) {
     (void)itf;
     (void)buffer;
@@ -493,7 +846,8 @@ static uint16_t resetd_open(uint8_t rhport, tusb_desc_interface_t const *itf_des
 
             if (tu_edpt_dir(desc_ep->bEndpointAddress) == TUSB_DIR_OUT) {
                 winusb_ep_out_address = desc_ep->bEndpointAddress;
-                TU_ASSERT(usbd_edpt_xfer(rhport, winusb_ep_out_address, winusb_ep_out_buffer, sizeof(winusb_ep_out_buffer)), 0);
+                pending_frames_count = 0u;
+                TU_ASSERT(arm_winusb_rx(rhport), 0);
             } else {
                 winusb_ep_in_address = desc_ep->bEndpointAddress;
             }
@@ -542,7 +896,7 @@ static bool resetd_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result
         if (xferred_bytes > 0u) {
             stage3_winusb_rx(winusb_ep_out_buffer, (uint16_t)xferred_bytes);
         }
-        return usbd_edpt_xfer(rhport, winusb_ep_out_address, winusb_ep_out_buffer, sizeof(winusb_ep_out_buffer));
+        return arm_winusb_rx(rhport);
     }
 
     if (ep_addr == winusb_ep_in_address) {
@@ -816,13 +1170,18 @@ int main(void) {
     }
 
     board_init();
+    crc32_init();
     tusb_init();
     while (true) {
         tud_task();
-        if (pending_frame_ready) {
-            handle_frame(pending_frame, pending_frame_len);
-            pending_frame_ready = false;
-            pending_frame_len = 0u;
+        if (pending_frames_count > 0u) {
+            handle_frame(pending_frames[pending_frames_first], pending_frame_lens[pending_frames_first]);
+            pending_frames_first = (pending_frames_first + 1u) % T76_STAGE3_UPDATER_RX_FRAMES;
+            pending_frames_count -= 1u;
+            if (winusb_rx_paused && winusb_ep_out_address != 0u) {
+                arm_winusb_rx(0);
+            }
         }
+        service_update();
     }
 }
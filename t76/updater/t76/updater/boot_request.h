@@ -2,13 +2,16 @@
  * @file boot_request.h
  * @copyright Copyright (c) 2026 MTA, Inc.
  *
- * Shared retained-boot and WinUSB updater protocol constants.
+ * Shared retained-boot constants. The WinUSB frame constants are in
+ * `<t76/updater/winusb_frame.h>`.
  */
 
 #pragma once
 
 #include <stdint.h>
 
+#include <t76/updater/winusb_frame.h>
+
 #define T76_UPDATER_BOOT_MAGIC 0x54375550u
 #define T76_UPDATER_BOOT_ARM_VALUE 0x424f4f54u
 #define T76_UPDATER_BOOT_SCRATCH_MAGIC 0u
@@ -21,25 +24,3 @@
 #endif
 
 #define T76_UPDATER_APPLICATION_XIP_BASE (0x10000000u + T76_UPDATER_APPLICATION_FLASH_OFFSET_BYTES)
-
-#define T76_WINUSB_FRAME_MAGIC0 0x57u
-#define T76_WINUSB_FRAME_MAGIC1 0x55u
-#define T76_WINUSB_FRAME_VERSION 0x01u
-#define T76_WINUSB_FRAME_HEADER_SIZE 12u
-
-#define T76_WINUSB_FRAME_COMMAND_REQUEST 0x01u
-#define T76_WINUSB_FRAME_SESSION_RESET_REQUEST 0x02u
-#define T76_WINUSB_FRAME_QUERY_REQUEST 0x03u
-#define T76_WINUSB_FRAME_UPDATE_BEGIN 0x10u
-#define T76_WINUSB_FRAME_UPDATE_WRITE 0x11u
-#define T76_WINUSB_FRAME_UPDATE_FINISH 0x12u
-#define T76_WINUSB_FRAME_UPDATE_ABORT 0x13u
-#define T76_WINUSB_FRAME_UPDATE_STATUS 0x14u
-
-#define T76_WINUSB_FRAME_COMMAND_ACK 0x80u
-#define T76_WINUSB_FRAME_TEXT_RESPONSE 0x81u
-#define T76_WINUSB_FRAME_BINARY_RESPONSE 0x82u
-#define T76_WINUSB_FRAME_ERROR_RESPONSE 0x83u
-#define T76_WINUSB_FRAME_SESSION_RESET_ACK 0x84u
-#define T76_WINUSB_FRAME_UPDATE_ACK 0x85u
-#define T76_WINUSB_FRAME_UPDATE_STATUS_RESPONSE 0x86u
@@ -0,0 +1,70 @@
+/**
+ * @file lz4_block.h
+ * @copyright Copyright (c) 2026 MTA, Inc.
+ *
+ * LZ4 block decoder of the updater bootloader. It has no dependencies
+ * beyond the C library, so that it can also be tested on the host.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Decodes one LZ4 block, which must produce exactly dst_len bytes. Every
+// write is compressed on its own, so matches only reach back into the same
+// write and the window is the destination buffer.
+static inline bool t76_lz4_decompress(const uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_len) {
+    uint32_t s = 0u;
+    uint32_t d = 0u;
+    while (s < src_len) {
+        const uint8_t token = src[s++];
+        uint32_t literals = token >> 4;
+        if (literals == 15u) {
+            uint8_t extra;
+            do {
+                if (s == src_len) {
+                    return false;
+                }
+                extra = src[s++];
+                literals += extra;
+            } while (extra == 255u);
+        }
+        if (literals > src_len - s || literals > dst_len - d) {
+            return false;
+        }
+        memcpy(dst + d, src + s, literals);
+        s += literals;
+        d += literals;
+        // The last sequence ends with its literals
+        if (s == src_len) {
+            break;
+        }
+        if (src_len - s < 2u) {
+            return false;
+        }
+        const uint32_t distance = (uint32_t)src[s] | ((uint32_t)src[s + 1u] << 8);
+        s += 2u;
+        uint32_t match = token & 15u;
+        if (match == 15u) {
+            uint8_t extra;
+            do {
+                if (s == src_len) {
+                    return false;
+                }
+                extra = src[s++];
+                match += extra;
+            } while (extra == 255u);
+        }
+        match += 4u;
+        if (distance == 0u || distance > d || match > dst_len - d) {
+            return false;
+        }
+        // Byte by byte, as the match may overlap the bytes it produces
+        for (uint32_t i = 0u; i < match; i++, d++) {
+            dst[d] = dst[d - distance];
+        }
+    }
+    return d == dst_len;
+}
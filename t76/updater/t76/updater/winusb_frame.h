@@ -0,0 +1,66 @@
+/**
+ * @file winusb_frame.h
+ * @copyright Copyright (c) 2026 MTA, Inc.
+ *
+ * WinUSB frame protocol constants, shared by the updater bootloader, the
+ * application and host code.
+ *
+ * Every frame starts with a 12-byte header: the two magic bytes, the
+ * version, the frame type, a tag that the reply echoes, three reserved
+ * bytes, and the payload length as a little-endian 32-bit integer.
+ *
+ * Update writes come in increasing order of offset. A stop-and-wait host
+ * that did not get the UPDATE_ACK of a write may send it again: an exact
+ * repeat of the most recent UPDATE_WRITE is acknowledged without being
+ * programmed twice.
+ *
+ * Updates are stop-and-wait unless the host asks for a window: an
+ * UPDATE_BEGIN payload with a fourth word requests that many writes in
+ * flight, and its UPDATE_ACK carries the window granted. Within a window the
+ * host sends UPDATE_WRITE_WINDOW frames, whose payload starts with a
+ * sequence number counting from 0, and the device answers with
+ * UPDATE_WINDOW_ACK frames carrying the next sequence number it expects.
+ *
+ * A fifth UPDATE_BEGIN word holds T76_WINUSB_UPDATE_FLAG_* bits. A
+ * differential update only erases the sectors it writes, so the host can
+ * compare the CRC32s returned by UPDATE_HASH with those of the new image and
+ * send only the sectors that differ. The unit is the sector, not the page:
+ * the first write to a sector erases all of it, so the host must send every
+ * sector that differs in full, from its first page, up to the end of the
+ * image. A write that skips part of a sector is rejected.
+ *
+ * With T76_WINUSB_UPDATE_FLAG_LZ4, the offset of every write of the session
+ * is followed by the length of its data, a whole number of pages up to a
+ * sector, and the data as one LZ4 block that expands to exactly that length.
+ */
+
+#pragma once
+
+#define T76_WINUSB_FRAME_MAGIC0 0x57u
+#define T76_WINUSB_FRAME_MAGIC1 0x55u
+#define T76_WINUSB_FRAME_VERSION 0x01u
+#define T76_WINUSB_FRAME_HEADER_SIZE 12u
+
+#define T76_WINUSB_FRAME_COMMAND_REQUEST 0x01u
+#define T76_WINUSB_FRAME_SESSION_RESET_REQUEST 0x02u
+#define T76_WINUSB_FRAME_QUERY_REQUEST 0x03u
+#define T76_WINUSB_FRAME_UPDATE_BEGIN 0x10u
+#define T76_WINUSB_FRAME_UPDATE_WRITE 0x11u
+#define T76_WINUSB_FRAME_UPDATE_FINISH 0x12u
+#define T76_WINUSB_FRAME_UPDATE_ABORT 0x13u
+#define T76_WINUSB_FRAME_UPDATE_STATUS 0x14u
+#define T76_WINUSB_FRAME_UPDATE_WRITE_WINDOW 0x15u
+#define T76_WINUSB_FRAME_UPDATE_HASH 0x16u
+
+#define T76_WINUSB_FRAME_COMMAND_ACK 0x80u
+#define T76_WINUSB_FRAME_TEXT_RESPONSE 0x81u
+#define T76_WINUSB_FRAME_BINARY_RESPONSE 0x82u
+#define T76_WINUSB_FRAME_ERROR_RESPONSE 0x83u
+#define T76_WINUSB_FRAME_SESSION_RESET_ACK 0x84u
+#define T76_WINUSB_FRAME_UPDATE_ACK 0x85u
+#define T76_WINUSB_FRAME_UPDATE_STATUS_RESPONSE 0x86u
+#define T76_WINUSB_FRAME_UPDATE_WINDOW_ACK 0x87u
+#define T76_WINUSB_FRAME_UPDATE_HASH_RESPONSE 0x88u
+
+#define T76_WINUSB_UPDATE_FLAG_DIFFERENTIAL 0x00000001u
+#define T76_WINUSB_UPDATE_FLAG_LZ4 0x00000002u
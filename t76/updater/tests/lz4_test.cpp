@@ -0,0 +1,182 @@
+/**
+ * @file lz4_test.cpp
+ * @brief Test of the updater bootloader's LZ4 block decoder.
+ * @copyright Copyright (c) 2026 MTA, Inc.
+ *
+ * The decoder must expand the blocks of compress_update.py, and blocks
+ * written by hand for the cases that the compressor does not produce. It
+ * must reject every malformed block without writing outside the
+ * destination, since the blocks come from the host.
+ *
+ */
+
+#include <t76/updater/lz4_block.h>
+
+#include "lz4_vectors.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr std::size_t guardSize = 64;
+    constexpr uint8_t guardByte = 0xa5;
+
+    void check(const std::string &name, bool passed, const std::string &detail = "") {
+        if (passed) {
+            std::cout << "✓ " << name << std::endl;
+        } else {
+            std::cout << "✗ " << name << (detail.empty() ? "" : " (" + detail + ")") << std::endl;
+        }
+    }
+
+    /**
+     * @brief Result of decoding into a buffer followed by guard bytes
+     */
+    struct Decoded {
+        bool success;
+        std::vector<uint8_t> data;      // The dstLength bytes of the destination
+        bool guardIntact;               // Nothing was written past the destination
+    };
+
+    Decoded decode(const std::vector<uint8_t> &block, std::size_t dstLength) {
+        std::vector<uint8_t> buffer(dstLength + guardSize, guardByte);
+        const bool success = t76_lz4_decompress(block.data(), static_cast<uint32_t>(block.size()), buffer.data(), static_cast<uint32_t>(dstLength));
+        bool guardIntact = true;
+
+        for (std::size_t index = dstLength; index < buffer.size(); index++) {
+            guardIntact = guardIntact && buffer[index] == guardByte;
+        }
+
+        buffer.resize(dstLength);
+        return {success, buffer, guardIntact};
+    }
+
+    std::vector<uint8_t> bytes(const std::string &text) {
+        return std::vector<uint8_t>(text.begin(), text.end());
+    }
+
+    void testVectors() {
+        for (std::size_t index = 0; index < lz4VectorCount; index++) {
+            const Lz4Vector &vector = lz4Vectors[index];
+            const std::vector<uint8_t> block(vector.block, vector.block + vector.blockLength);
+            const std::vector<uint8_t> raw(vector.raw, vector.raw + vector.rawLength);
+            const Decoded decoded = decode(block, raw.size());
+
+            check(std::string("Decodes ") + vector.name, decoded.success && decoded.data == raw && decoded.guardIntact);
+
+            // The length of the data is part of each write, and must match exactly
+            check(std::string("Rejects a longer destination for ") + vector.name, !decode(block, raw.size() + 1).success);
+
+            // An empty block is a valid encoding of nothing, so only a non-empty input can be cut short
+            if (raw.empty()) {
+                continue;
+            }
+
+            const Decoded shorter = decode(block, raw.size() - 1);
+            check(std::string("Rejects a shorter destination for ") + vector.name, !shorter.success && shorter.guardIntact);
+
+            bool truncationsRejected = true;
+
+            for (std::size_t length = 0; length < block.size(); length++) {
+                const Decoded truncated = decode(std::vector<uint8_t>(block.begin(), block.begin() + length), raw.size());
+
+                truncationsRejected = truncationsRejected && !truncated.success && truncated.guardIntact;
+            }
+
+            check(std::string("Rejects every truncation of ") + vector.name, truncationsRejected);
+        }
+    }
+
+    void testHandWritten() {
+        // A match that overlaps its own output repeats the byte before it
+        {
+            std::vector<uint8_t> block = { 0x16, 'a', 0x01, 0x00, 0x50 };
+            const std::vector<uint8_t> tail = bytes("bcdef");
+
+            block.insert(block.end(), tail.begin(), tail.end());
+
+            const Decoded decoded = decode(block, 16);
+            check("Overlapping match", decoded.success && decoded.data == bytes("aaaaaaaaaaabcdef"));
+        }
+
+        // Lengths of 15 and more continue in extra bytes, ending with one below 255
+        {
+            std::vector<uint8_t> block = { 0xf0, 0xff, 0x00 };
+            std::vector<uint8_t> expected;
+
+            for (int index = 0; index < 270; index++) {
+                block.push_back(static_cast<uint8_t>(index));
+                expected.push_back(static_cast<uint8_t>(index));
+            }
+
+            const Decoded decoded = decode(block, expected.size());
+            check("Literal length with extra bytes", decoded.success && decoded.data == expected);
+        }
+
+        {
+            // 4 + 15 + 1 = 20 bytes copied from 4 back
+            const std::vector<uint8_t> block = { 0x4f, 'w', 'x', 'y', 'z', 0x04, 0x00, 0x01, 0x50, '1', '2', '3', '4', '5' };
+            const Decoded decoded = decode(block, 29);
+            check("Match length with extra bytes", decoded.success && decoded.data == bytes("wxyzwxyzwxyzwxyzwxyzwxyz12345"));
+        }
+
+        const std::vector<std::pair<const char *, std::vector<uint8_t>>> malformed = {
+            { "Rejects a match distance of 0", { 0x10, 'a', 0x00, 0x00, 0x50, 'b', 'c', 'd', 'e', 'f' } },
+            { "Rejects a match before the start of the output", { 0x10, 'a', 0x02, 0x00, 0x50, 'b', 'c', 'd', 'e', 'f' } },
+            { "Rejects a match past the end of the output", { 0x1f, 'a', 0x01, 0x00, 0x40, 0x50, 'b', 'c', 'd', 'e', 'f' } },
+            { "Rejects a missing match distance", { 0x10, 'a', 0x01 } },
+            { "Rejects a missing length byte", { 0xf0 } },
+            { "Rejects literals past the end of the block", { 0x50, 'a', 'b' } },
+        };
+
+        for (const auto &[name, block] : malformed) {
+            const Decoded decoded = decode(block, 16);
+            check(name, !decoded.success && decoded.guardIntact);
+        }
+    }
+
+    void testCorruption() {
+        std::mt19937 generator(76);
+        uint32_t outside = 0;
+        uint32_t blocks = 0;
+
+        // Corrupted blocks may decode to anything, but must never write outside the destination
+        for (std::size_t index = 0; index < lz4VectorCount; index++) {
+            const Lz4Vector &vector = lz4Vectors[index];
+
+            for (int round = 0; round < 2000; round++) {
+                std::vector<uint8_t> block(vector.block, vector.block + vector.blockLength);
+                const int changes = 1 + static_cast<int>(generator() % 4);
+
+                for (int change = 0; change < changes; change++) {
+                    block[generator() % block.size()] = static_cast<uint8_t>(generator());
+                }
+
+                if (!decode(block, vector.rawLength).guardIntact) {
+                    outside++;
+                }
+
+                blocks++;
+            }
+        }
+
+        check("Corrupted blocks never write past the destination", outside == 0,
+              std::to_string(outside) + " of " + std::to_string(blocks) + " blocks");
+    }
+
+} // namespace
+
+int main() {
+    std::cout << "=== LZ4 Decoder Test ===" << std::endl;
+
+    testVectors();
+    testHandWritten();
+    testCorruption();
+
+    std::cout << "\n=== LZ4 Decoder Test Complete ===" << std::endl;
+    return 0;
+}
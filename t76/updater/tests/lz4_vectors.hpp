@@ -0,0 +1,22 @@
+#ifndef LZ4_VECTORS_HPP
+#define LZ4_VECTORS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief An input and the LZ4 block that compress_update.py makes of it.
+ */
+struct Lz4Vector {
+    const char *name;
+    const uint8_t *raw;         // nullptr for an empty input
+    std::size_t rawLength;
+    const uint8_t *block;
+    std::size_t blockLength;
+};
+
+// Defined in lz4_vectors.cpp, which lz4_vectors.py generates at build time
+extern const Lz4Vector lz4Vectors[];
+extern const std::size_t lz4VectorCount;
+
+#endif // LZ4_VECTORS_HPP
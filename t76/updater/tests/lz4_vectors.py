@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""Generate the LZ4 test vectors of lz4_test.cpp with compress_update.py.
+
+Each vector is an input and the block that compress_block() makes of it,
+so that the test checks the bootloader's decoder against the compressor
+that produces real update payloads.
+"""
+
+from __future__ import annotations
+
+import argparse
+import random
+import sys
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from compress_update import PAGE_SIZE, compress_block  # noqa: E402
+
+
+def _inputs() -> list[tuple[str, bytes]]:
+    generator = random.Random(76)
+    noise = bytes(generator.randrange(256) for _ in range(4096))
+    text = b"".join(b"SOUR%d:VOLT:LEV:IMM:AMPL %d.%03d\n" % (i % 4, i % 17, (i * 37) % 1000) for i in range(160))[:4096]
+    image = bytes(generator.randrange(256) for _ in range(300)) + bytes(range(100)) * 3
+    # The end of an image, padded to a whole page as write_payloads() does
+    padded = image + b"\xff" * (-len(image) % PAGE_SIZE)
+    return [
+        ("empty", b""),
+        ("single byte", b"a"),
+        ("short literals", b"hello world"),
+        ("zeros", bytes(4096)),
+        ("noise", noise),
+        ("text", text),
+        ("repeating pattern", b"abc" * 1365),
+        ("padded image", padded),
+    ]
+
+
+def _array(name: str, data: bytes) -> str:
+    if not data:
+        return ""
+    rows = [", ".join(f"0x{byte:02x}" for byte in data[start:start + 16]) for start in range(0, len(data), 16)]
+    return f"    const uint8_t {name}[] = {{\n        " + ",\n        ".join(rows) + "\n    };\n\n"
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-o", "--output", type=Path, required=True)
+    args = parser.parse_args()
+
+    arrays = ""
+    entries = ""
+    for index, (name, data) in enumerate(_inputs()):
+        block = compress_block(data)
+        arrays += _array(f"raw{index}", data) + _array(f"block{index}", block)
+        raw = f"raw{index}" if data else "nullptr"
+        entries += f'    {{"{name}", {raw}, {len(data)}, block{index}, {len(block)}}},\n'
+
+    args.output.write_text(
+        "// Generated by lz4_vectors.py; do not edit\n\n"
+        '#include "lz4_vectors.hpp"\n\n'
+        "namespace {\n\n" + arrays + "} // namespace\n\n"
+        "const Lz4Vector lz4Vectors[] = {\n" + entries + "};\n\n"
+        "const std::size_t lz4VectorCount = sizeof(lz4Vectors) / sizeof(lz4Vectors[0]);\n"
+    )
+
+
+if __name__ == "__main__":
+    main()
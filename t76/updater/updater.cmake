@@ -45,6 +45,7 @@ function(t76_add_stage3_updater_bootloader target)
     )
 
     target_link_libraries(${target}
+        hardware_dma
         hardware_flash
         hardware_sync
         pico_stdlib
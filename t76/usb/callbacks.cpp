@@ -12,6 +12,26 @@ extern "C" void tud_vendor_rx_cb(uint8_t itf, uint8_t const* buffer, uint16_t bu
     Interface::_singleton->_vendorDataReceived(itf, (uint8_t*)buffer, bufsize);
 }
 
+extern "C" void tud_vendor_tx_cb(uint8_t itf, uint32_t sent_bytes) {
+    Interface::_singleton->_vendorBulkInComplete(itf, sent_bytes);
+}
+
+#ifdef T76_IC_USB_CDC_DATA
+
+extern "C" void tud_cdc_rx_cb(uint8_t itf) {
+    if (itf == Interface::_cdcDataInstance) {
+        Interface::_singleton->_cdcDataReceived();
+    }
+}
+
+extern "C" void tud_cdc_tx_complete_cb(uint8_t itf) {
+    if (itf == Interface::_cdcDataInstance) {
+        Interface::_singleton->_kickCDCDataTransfer();
+    }
+}
+
+#endif
+
 extern "C" bool tud_vendor_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request) {
     return Interface::_singleton->_vendorControlTransfer(rhport, stage, request);
 }
@@ -28,6 +48,22 @@ extern "C" void t76_winusb_bulk_in_complete_cb(uint32_t xferred_bytes) {
     Interface::_singleton->_winusbBulkInComplete(xferred_bytes);
 }
 
+#ifdef T76_IC_USB_ISO_STREAM
+
+extern "C" void t76_iso_stream_started_cb(void) {
+    Interface::_singleton->_isoStreamStarted();
+}
+
+extern "C" void t76_iso_stream_stopped_cb(void) {
+    Interface::_singleton->_isoStreamStopped();
+}
+
+extern "C" void t76_iso_stream_in_complete_cb(uint32_t xferred_bytes) {
+    Interface::_singleton->_isoStreamInComplete(xferred_bytes);
+}
+
+#endif
+
 extern "C" usbtmc_response_capabilities_488_t const * tud_usbtmc_get_capabilities_cb(void) {
     return Interface::_singleton->_usbtmcCapabilities();
 }
@@ -12,6 +12,7 @@ extern "C" {
 
 void tud_vendor_rx_cb(uint8_t itf, uint8_t const* buffer, uint16_t bufsize);
 bool tud_vendor_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request);
+void tud_vendor_tx_cb(uint8_t itf, uint32_t sent_bytes);
 
 /**
  * @brief Route a control transfer to the WinUSB interface handler.
@@ -47,6 +48,19 @@ void t76_winusb_bulk_in_complete_cb(uint32_t xferred_bytes);
  */
 bool t76_winusb_bulk_in_xfer(uint8_t const* buffer, uint16_t bufsize);
 
+/**
+ * @brief Start a WinUSB bulk IN transfer directly from the caller's buffer.
+ *
+ * Unlike t76_winusb_bulk_in_xfer(), the payload is not copied, so the buffer
+ * must remain valid until the transfer completes. The payload can span
+ * several packets.
+ *
+ * @param buffer Pointer to the payload to send.
+ * @param bufsize Number of bytes to transfer.
+ * @return true if the transfer was started, false otherwise.
+ */
+bool t76_winusb_bulk_in_xfer_direct(uint8_t const* buffer, uint16_t bufsize);
+
 /**
  * @brief Start a zero-length WinUSB bulk IN transfer.
  *
@@ -54,6 +68,49 @@ bool t76_winusb_bulk_in_xfer(uint8_t const* buffer, uint16_t bufsize);
  */
 bool t76_winusb_bulk_in_zlp(void);
 
+#ifdef T76_IC_USB_ISO_STREAM
+
+// Isochronous stream interface
+
+/**
+ * @brief Notify the runtime that the host selected the streaming alternate setting.
+ */
+void t76_iso_stream_started_cb(void);
+
+/**
+ * @brief Notify the runtime that the host deselected the streaming alternate setting, or that the bus was reset.
+ */
+void t76_iso_stream_stopped_cb(void);
+
+/**
+ * @brief Notify the runtime that an isochronous IN packet was sent.
+ *
+ * @param xferred_bytes Number of bytes transferred to the host.
+ */
+void t76_iso_stream_in_complete_cb(uint32_t xferred_bytes);
+
+/**
+ * @brief Queue an isochronous IN packet directly from the caller's buffer.
+ *
+ * The buffer must remain valid until the transfer completes.
+ *
+ * @param buffer Pointer to the payload to send; ignored for a zero-length packet.
+ * @param bufsize Number of bytes to send, at most the endpoint's packet size.
+ * @return true if the packet was queued, false otherwise.
+ */
+bool t76_iso_stream_in_xfer(uint8_t const* buffer, uint16_t bufsize);
+
+#endif
+
+#ifdef T76_IC_USB_CDC_DATA
+
+// CDC callbacks, for the data CDC port; the stdio port does not use them
+
+void tud_cdc_rx_cb(uint8_t itf);
+void tud_cdc_tx_complete_cb(uint8_t itf);
+
+#endif
+
 // USBTMC callbacks
 
 usbtmc_response_capabilities_488_t const * tud_usbtmc_get_capabilities_cb(void);
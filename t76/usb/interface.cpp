@@ -9,317 +9,1632 @@
 #include <FreeRTOS.h>
 #include <task.h>
 
+#include <cstdio>
+#include <cstring>
+
+#include <pico/time.h>
+
+#include <pico/error.h>
+#include <pico/stdio.h>
+#include <pico/stdio/driver.h>
+
+#if defined(T76_IC_USB_WINUSB_STREAM) || defined(T76_IC_USB_TRIGGER)
+#include <pico/multicore.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
+#endif
+
+#ifdef T76_IC_USB_ISO_STREAM
+#include <hardware/structs/usb.h>
+#endif
+
+#ifdef T76_IC_DMA_OFFLOAD
+#include <t76/dma.hpp>
+#endif
+
+#include <t76/boot_profile.hpp>
+#include <t76/placement.hpp>
+#include <t76/trace.hpp>
+
 #include "callbacks.hpp"
 #include "interface_interrupt.hpp"
 
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
 namespace T76::Core::USB {
 
 Interface* Interface::_singleton = nullptr;
+Interface::ClassCounters Interface::_cdcCounters;
+
+namespace {
+    // stdio driver of the CDC port. It replaces the one of pico_stdio_usb,
+    // which runs tud_task() from whichever task calls printf()
+    stdio_driver_t gCDCStdioDriver;
+}
+
+#ifdef T76_IC_DMA_OFFLOAD
+namespace {
+    // Fill function that copies a large payload into the USBTMC ring, or a
+    // captured response, by DMA; the context is the payload
+    void dmaCopyFill(void *context, uint8_t *destination, size_t offset, size_t length) {
+        T76::Core::DMA::copy(destination, static_cast<const uint8_t*>(context) + offset, length);
+    }
+}
+#endif
 
 
 Interface::Interface(InterfaceDelegate &delegate) : 
-    _delegate(delegate),
-    _usbtmcBulkInDataQueue(T76_IC_USB_INTERFACE_BULK_IN_QUEUE_SIZE) {
+    _delegate(delegate) {
+}
+
+void Interface::init() {
+    // Initialize the USB interface
+    _singleton = this;
+
+    // Create one queue per dispatch lane. Received data only ever uses items
+    // from the USB stack's pool, while completions and sends can use any item,
+    // as well as the two static kick items.
+    _dispatchQueue = xQueueCreate(T76_IC_USB_DISPATCH_QUEUE_SIZE, sizeof(DispatchItem*));
+    _dispatchCompletionQueue = xQueueCreate(T76_IC_USB_DISPATCH_QUEUE_SIZE + T76_IC_USB_DISPATCH_SEND_ITEMS + 2, sizeof(DispatchItem*));
+
+#ifndef T76_IC_USB_DISPATCH_COMPLETION_TASK
+    // A single dispatch task waits on both lanes
+    _dispatchQueueSet = xQueueCreateSet(2 * T76_IC_USB_DISPATCH_QUEUE_SIZE + T76_IC_USB_DISPATCH_SEND_ITEMS + 2);
+    xQueueAddToSet(_dispatchQueue, _dispatchQueueSet);
+    xQueueAddToSet(_dispatchCompletionQueue, _dispatchQueueSet);
+#endif
+
+    // Seed the free lists with every preallocated dispatch item
+    _dispatchFreeQueue = xQueueCreate(T76_IC_USB_DISPATCH_QUEUE_SIZE, sizeof(DispatchItem*));
+    _dispatchSendFreeQueue = xQueueCreate(T76_IC_USB_DISPATCH_SEND_ITEMS, sizeof(DispatchItem*));
+
+    for (size_t i = 0; i < T76_IC_USB_DISPATCH_QUEUE_SIZE + T76_IC_USB_DISPATCH_SEND_ITEMS; i++) {
+        DispatchItem *item = &_dispatchItemPool[i];
+        xQueueSend(i < T76_IC_USB_DISPATCH_QUEUE_SIZE ? _dispatchFreeQueue : _dispatchSendFreeQueue, &item, 0);
+    }
+
+    gCDCStdioDriver.out_chars = _cdcStdioOutChars;
+    gCDCStdioDriver.in_chars = _cdcStdioInChars;
+#if PICO_STDIO_ENABLE_CRLF_SUPPORT
+    gCDCStdioDriver.crlf_enabled = PICO_STDIO_DEFAULT_CRLF;
+#endif
+    stdio_set_driver_enabled(&gCDCStdioDriver, true);
+
+    _usbtmcBulkInSpaceSemaphore = xSemaphoreCreateBinary();
+    _usbtmcBulkInCoalesceMutex = xSemaphoreCreateMutex();
+    _usbtmcBulkInCoalesceTimer = xTimerCreate("USBTMCFlush", 1, pdFALSE, this, _usbtmcCoalesceTimerCallback);
+
+#ifdef T76_IC_USB_WINUSB_STREAM
+    // The stream producer rings a doorbell on core 0 whenever it publishes a
+    // frame, so that an idle endpoint is restarted without polling
+    _winUSBStreamKickItem.type = DispatchType::WinUSBStreamKick;
+    _winUSBStreamDoorbell = multicore_doorbell_claim_unused((1u << NUM_CORES) - 1, true);
+
+    const uint doorbellIrq = multicore_doorbell_irq_num(_winUSBStreamDoorbell);
+    irq_add_shared_handler(doorbellIrq, _winUSBStreamDoorbellHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(doorbellIrq, true);
+#endif
+
+#ifdef T76_IC_USB_CDC_DATA
+    _cdcDataKickItem.type = DispatchType::CDCDataKick;
+    _cdcDataTxSpaceSemaphore = xSemaphoreCreateBinary();
+    _cdcDataRxSemaphore = xSemaphoreCreateBinary();
+    _cdcDataRxMutex = xSemaphoreCreateMutex();
+#endif
+
+#ifdef T76_IC_USB_TRIGGER
+    // Claimed for both cores; the interrupt is only enabled on the core
+    // that attaches the trigger action
+    _triggerDoorbell = multicore_doorbell_claim_unused((1u << NUM_CORES) - 1, false);
+#endif
+
+    // Attach to the bus now rather than from the runtime task, so that the
+    // host's connect debounce and reset run while the rest of startup does;
+    // the events they raise wait in TinyUSB's queue for the runtime task
+    board_init();
+    tusb_init();
+
+    TaskHandle_t taskHandle = nullptr;
+
+    // Create a task for runtime operations
+    xTaskCreate(
+        [](void* param) {
+            Interface* iface = static_cast<Interface*>(param);
+            iface->_runtimeTask();
+        }, 
+        "USBRuntime", 
+        T76_IC_USB_RUNTIME_TASK_STACK_SIZE, 
+        this, 
+        T76_IC_USB_RUNTIME_TASK_PRIORITY,
+        &_runtimeTaskHandle
+    );
+
+#ifdef T76_IC_SMP
+    // TinyUSB's interrupt is enabled on this core, so the runtime task normally stays on it
+    vTaskCoreAffinitySet(_runtimeTaskHandle, T76_IC_USB_RUNTIME_TASK_CORE_AFFINITY);
+#endif
+
+    xTaskCreate(
+        [](void* param) {
+            Interface* iface = static_cast<Interface*>(param);
+            iface->_dispatchTask();
+        }, 
+        "USBDispatch", 
+        T76_IC_USB_DISPATCH_TASK_STACK_SIZE, 
+        this, 
+        T76_IC_USB_DISPATCH_TASK_PRIORITY, 
+        &taskHandle
+    );
+
+#ifdef T76_IC_SMP
+    vTaskCoreAffinitySet(taskHandle, T76_IC_USB_DISPATCH_TASK_CORE_AFFINITY);
+#endif
+
+#ifdef T76_IC_USB_DISPATCH_COMPLETION_TASK
+    xTaskCreate(
+        [](void* param) {
+            Interface* iface = static_cast<Interface*>(param);
+            iface->_completionTask();
+        }, 
+        "USBCompletion", 
+        T76_IC_USB_COMPLETION_TASK_STACK_SIZE, 
+        this, 
+        T76_IC_USB_COMPLETION_TASK_PRIORITY, 
+        &taskHandle
+    );
+
+#ifdef T76_IC_SMP
+    vTaskCoreAffinitySet(taskHandle, T76_IC_USB_COMPLETION_TASK_CORE_AFFINITY);
+#endif
+#endif
+}
+
+void Interface::sendVendorBulkData(const std::vector<uint8_t> &data) {
+    _dispatchData(DispatchType::SendData, data.data(), data.size());
+}
+
+bool Interface::sendVendorControlTransferData(uint8_t port, const tusb_control_request_t *request, const std::vector<uint8_t> &data) {
+    if (request->bmRequestType_bit.direction == TUSB_DIR_IN) {
+        if (data.size() != request->wLength) {
+            //TODO: Log error
+            return false;
+        }
+
+        _vendorControlDataOutBuffer = data; // Store the data to be sent
+
+        // Handle IN control transfer
+        return tud_control_xfer(port, request, static_cast<void*>(_vendorControlDataOutBuffer.data()), _vendorControlDataOutBuffer.size());
+    }
+
+    return false; // Only IN transfers are supported for control transfers
+}
+
+bool Interface::sendWinUSBControlTransferData(uint8_t port, const tusb_control_request_t *request, const std::vector<uint8_t> &data) {
+    if (request->bmRequestType_bit.direction == TUSB_DIR_IN) {
+        if (data.size() != request->wLength) {
+            return false;
+        }
+
+        _winusbControlDataOutBuffer = data;
+        return tud_control_xfer(port, request, static_cast<void*>(_winusbControlDataOutBuffer.data()), _winusbControlDataOutBuffer.size());
+    }
+
+    return false;
+}
+
+void Interface::sendWinUSBBulkData(const std::vector<uint8_t> &data) {
+    DispatchItem *item = _acquireDispatchItem(DispatchType::SendWinUSBBulkData);
+
+    if (item == nullptr) {
+        LOGW("USB: no free dispatch item; WinUSB bulk data dropped\n");
+        _count(_winUSBCounters.dropped);
+        return;
+    }
+
+    // Frames keep their own storage so that ZLP framing is preserved
+    item->frame = data;
+    _sendDispatchItem(item);
+}
+
+bool Interface::sendUSBTMCBulkData(const std::vector<uint8_t> &data) {
+    return sendUSBTMCBulkData(data.data(), data.size(), true);
+}
+
+bool Interface::sendUSBTMCBulkData(const uint8_t *data, size_t length, bool endOfMessage) {
+    return _writeUSBTMCBulkData(data, length, nullptr, 0, endOfMessage);
+}
+
+bool Interface::sendUSBTMCBulkData(const std::string &data, bool addNewline) {
+    // Terminate and close the current response message with a newline
+    static const uint8_t newline = '\n';
+
+    return _writeUSBTMCBulkData(
+        reinterpret_cast<const uint8_t*>(data.data()),
+        data.size(),
+        addNewline ? &newline : nullptr,
+        addNewline ? 1 : 0,
+        addNewline
+    );
+}
+
+bool Interface::fillUSBTMCBulkData(size_t length, T76::Core::Utils::MessageFillFunction fill, void *context, bool endOfMessage) {
+    return _writeUSBTMCBulkData(nullptr, length, nullptr, 0, endOfMessage, fill, context);
+}
+
+bool Interface::sendUSBTMCResponse(std::string_view response) {
+    static const uint8_t newline = '\n';
+
+    return _writeUSBTMCBulkData(
+        reinterpret_cast<const uint8_t*>(response.data()),
+        response.size(),
+        &newline,
+        1,
+        true
+    );
+}
+
+bool Interface::usbtmcResponseWriter(void *context, std::string_view response) {
+    return static_cast<Interface*>(context)->sendUSBTMCResponse(response);
+}
+
+bool Interface::_writeUSBTMCBulkData(const uint8_t *data, size_t length, const uint8_t *suffix, size_t suffixLength, bool endOfMessage,
+                                     T76::Core::Utils::MessageFillFunction fill, void *context) {
+    const size_t total = length + suffixLength;
+
+#ifdef T76_IC_DMA_OFFLOAD
+    // Large payloads move by DMA while this task blocks, so that the core
+    // runs other tasks, such as the SCPI parser, in the meantime. The copy
+    // runs with the ring locked, so the runtime task waits for it if it needs
+    // the ring for a bulk IN request: about a microsecond per 512 bytes, plus
+    // two task switches, with this task raised to its priority meanwhile.
+    if (!fill && length >= T76_IC_DMA_THRESHOLD) {
+        fill = dmaCopyFill;
+        context = const_cast<uint8_t*>(data);
+    }
+#endif
+
+    const TaskHandle_t captureTask = _usbtmcCaptureTask.load(std::memory_order_acquire);
+
+    if (captureTask != nullptr && captureTask == xTaskGetCurrentTaskHandle()) {
+        // Only the capturing task gets here, so the buffer needs no lock
+        const size_t offset = _usbtmcCapture->size();
+        _usbtmcCapture->resize(offset + total);
+
+        if (fill) {
+            fill(context, _usbtmcCapture->data() + offset, 0, length);
+        } else if (length > 0) {
+            memcpy(_usbtmcCapture->data() + offset, data, length);
+        }
+
+        if (suffixLength > 0) {
+            memcpy(_usbtmcCapture->data() + offset + length, suffix, suffixLength);
+        }
+
+        return true;
+    }
+
+    if (!_usbtmcBulkInCoalesce || _usbtmcBulkInCoalesceMutex == nullptr) {
+        if (!_waitForUSBTMCBulkInSpace(total, endOfMessage)) {
+            return false;
+        }
+
+        // One locked step, so that another task's response cannot land
+        // between the payload, its suffix and the end of the message
+        const bool result = fill ? _usbtmcBulkInRing.write(length, fill, context, suffix, suffixLength, endOfMessage)
+                                 : _usbtmcBulkInRing.write(data, length, suffix, suffixLength, endOfMessage);
+
+        if (endOfMessage) {
+            _noteUSBTMCQueueDepth();
+        }
+
+        if (!result) {
+            LOGW("USBTMC: a response of %lu bytes did not fit in the bulk IN ring\n", (unsigned long)total);
+        }
+
+        return result;
+    }
+
+    // Close the open group first if this response would make it too large or
+    // would not fit behind it, so that a full ring never discards the
+    // responses already in the group
+    xSemaphoreTake(_usbtmcBulkInCoalesceMutex, portMAX_DELAY);
+
+    if (_usbtmcBulkInCoalescedLength > 0 && !_usbtmcBulkInCoalescePartial &&
+        (_usbtmcBulkInCoalescedLength + total > T76_IC_USB_INTERFACE_BULK_IN_COALESCE_MAX_SIZE ||
+         !_usbtmcBulkInRing.canWrite(total, true))) {
+        _closeUSBTMCCoalescedGroup();
+    }
+
+    xSemaphoreGive(_usbtmcBulkInCoalesceMutex);
+
+    // The group is only closed later, but there must be room to close it
+    if (!_waitForUSBTMCBulkInSpace(total, true)) {
+        return false;
+    }
+
+    xSemaphoreTake(_usbtmcBulkInCoalesceMutex, portMAX_DELAY);
+
+    const bool startsGroup = _usbtmcBulkInCoalescedLength == 0;
+    const bool result = fill ? _usbtmcBulkInRing.write(length, fill, context, suffix, suffixLength, false)
+                             : _usbtmcBulkInRing.write(data, length, suffix, suffixLength, false);
+
+    if (!result) {
+        // The ring has discarded the whole group; count it and start over
+        LOGW("USBTMC: coalesced responses did not fit in the bulk IN ring and were discarded\n");
+        _usbtmcBulkInRing.endMessage();
+        _usbtmcBulkInCoalescedLength = 0;
+        _usbtmcBulkInCoalescePartial = false;
+        xTimerStop(_usbtmcBulkInCoalesceTimer, 0);
+    } else {
+        _usbtmcBulkInCoalescedLength += total;
+        _usbtmcBulkInCoalescePartial = !endOfMessage;
+
+        if (endOfMessage && _usbtmcBulkInCoalescedLength >= T76_IC_USB_INTERFACE_BULK_IN_COALESCE_MAX_SIZE) {
+            _closeUSBTMCCoalescedGroup();
+        } else if (startsGroup && _usbtmcBulkInCoalesceWindowUs > 0) {
+            // Round the window up to whole ticks; a changed period also starts the timer
+            const TickType_t ticks = std::max<TickType_t>(1, pdMS_TO_TICKS((_usbtmcBulkInCoalesceWindowUs + 999) / 1000));
+            xTimerChangePeriod(_usbtmcBulkInCoalesceTimer, ticks, 0);
+        }
+    }
+
+    xSemaphoreGive(_usbtmcBulkInCoalesceMutex);
+    return result;
+}
+
+void Interface::captureUSBTMCBulkData(std::vector<uint8_t> *capture) {
+    if (capture == nullptr) {
+        _usbtmcCaptureTask.store(nullptr, std::memory_order_release);
+        _usbtmcCapture = nullptr;
+        return;
+    }
+
+    _usbtmcCapture = capture;
+    _usbtmcCaptureTask.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+}
+
+void Interface::setUSBTMCBulkInCoalescing(bool enable, uint32_t windowUs) {
+    if (_usbtmcBulkInCoalesceMutex == nullptr) {
+        // Not initialized yet, so there is no group to flush
+        _usbtmcBulkInCoalesce = enable;
+        _usbtmcBulkInCoalesceWindowUs = windowUs;
+        return;
+    }
+
+    xSemaphoreTake(_usbtmcBulkInCoalesceMutex, portMAX_DELAY);
+
+    _usbtmcBulkInCoalesceWindowUs = windowUs;
+
+    if (!enable && !_usbtmcBulkInCoalescePartial) {
+        _closeUSBTMCCoalescedGroup();
+    }
+
+    _usbtmcBulkInCoalesce = enable;
+
+    xSemaphoreGive(_usbtmcBulkInCoalesceMutex);
+}
+
+void Interface::flushUSBTMCBulkData() {
+    if (_usbtmcBulkInCoalesceMutex == nullptr) {
+        return;
+    }
+
+    xSemaphoreTake(_usbtmcBulkInCoalesceMutex, portMAX_DELAY);
+
+    if (!_usbtmcBulkInCoalescePartial) {
+        _closeUSBTMCCoalescedGroup();
+    }
+
+    xSemaphoreGive(_usbtmcBulkInCoalesceMutex);
+}
+
+void Interface::_closeUSBTMCCoalescedGroup() {
+    if (_usbtmcBulkInCoalescedLength == 0) {
+        return;
+    }
+
+    if (!_usbtmcBulkInRing.endMessage()) {
+        LOGE("USBTMC: cannot end a coalesced response\n");
+    }
+
+    _noteUSBTMCQueueDepth();
+    _usbtmcBulkInCoalescedLength = 0;
+    xTimerStop(_usbtmcBulkInCoalesceTimer, 0);
+}
+
+void Interface::_discardUSBTMCBulkInData() {
+    xSemaphoreTake(_usbtmcBulkInCoalesceMutex, portMAX_DELAY);
+
+    _usbtmcBulkInRing.clear();
+    _usbtmcBulkInInFlight = 0;
+    _usbtmcBulkInCoalescedLength = 0;
+    _usbtmcBulkInCoalescePartial = false;
+    xTimerStop(_usbtmcBulkInCoalesceTimer, 0);
+
+    xSemaphoreGive(_usbtmcBulkInCoalesceMutex);
+}
+
+void Interface::_usbtmcCoalesceTimerCallback(TimerHandle_t timer) {
+    static_cast<Interface*>(pvTimerGetTimerID(timer))->flushUSBTMCBulkData();
+}
+
+void Interface::setUSBTMCBulkInSendTimeout(TickType_t timeout) {
+    _usbtmcBulkInSendTimeout = timeout;
+}
+
+void Interface::setUSBTMCBulkInDropWhenFull(bool drop) {
+    _usbtmcBulkInDropWhenFull = drop;
+}
+
+size_t Interface::usbtmcBulkInDroppedCount() const {
+    return _usbtmcBulkInRing.droppedCount();
+}
+
+bool Interface::_waitForUSBTMCBulkInSpace(size_t length, bool endOfMessage) {
+    if (_usbtmcBulkInDropWhenFull || length > _usbtmcBulkInRing.capacity()) {
+        // Let the ring discard the message if it does not fit
+        return true;
+    }
+
+    // The runtime task is the one that frees space, so it must never wait
+    const bool canWait = _usbtmcBulkInSpaceSemaphore != nullptr && xTaskGetCurrentTaskHandle() != _runtimeTaskHandle;
+    const TickType_t start = xTaskGetTickCount();
+    bool waited = false;
+
+    while (!_usbtmcBulkInRing.canWrite(length, endOfMessage)) {
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+
+        if (!canWait || elapsed >= _usbtmcBulkInSendTimeout) {
+            // Would block; ask to be told when space is released
+            _usbtmcBulkInSpaceWanted.store(true, std::memory_order_release);
+            return false;
+        }
+
+        xSemaphoreTake(_usbtmcBulkInSpaceSemaphore, _usbtmcBulkInSendTimeout - elapsed);
+        waited = true;
+    }
+
+    if (waited) {
+        // Pass the wake-up on in case another sender is also waiting
+        xSemaphoreGive(_usbtmcBulkInSpaceSemaphore);
+    }
+
+    return true;
+}
+
+void Interface::_releaseUSBTMCBulkInSpace(size_t length) {
+    _usbtmcBulkInRing.consume(length);
+
+    if (_usbtmcBulkInSpaceSemaphore != nullptr) {
+        xSemaphoreGive(_usbtmcBulkInSpaceSemaphore);
+    }
+
+    if (_usbtmcBulkInSpaceWanted.exchange(false, std::memory_order_acq_rel)) {
+        _delegate._onUSBTMCBulkInSpaceAvailable();
+    }
+}
+
+void Interface::pauseUSBTMCBulkOut() {
+    _usbtmcBulkOutPaused.store(true, std::memory_order_release);
+}
+
+void Interface::resumeUSBTMCBulkOut() {
+    if (_usbtmcBulkOutPaused.exchange(false, std::memory_order_acq_rel)) {
+        // The endpoint can only be re-armed from the runtime task
+        usbd_defer_func(_resumeUSBTMCBulkOut, this, false);
+    }
+}
+
+void Interface::_startUSBTMCBulkOut() {
+    if (_usbtmcBulkOutPaused.load(std::memory_order_acquire)) {
+        _usbtmcBulkOutParked = true; // Re-armed by resumeUSBTMCBulkOut()
+        return;
+    }
+
+    _usbtmcBulkOutParked = false;
+    tud_usbtmc_start_bus_read(); // Start reading from the USBTMC bus
+}
+
+void Interface::_resumeUSBTMCBulkOut(void *param) {
+    Interface *iface = static_cast<Interface*>(param);
+
+    // The endpoint may have been re-armed since, for example by a clear
+    if (iface->_usbtmcBulkOutParked) {
+        iface->_startUSBTMCBulkOut();
+    }
+}
+
+bool Interface::sendUSBTMCSRQInterrupt(const uint8_t srq) {
+    _usbtmcSRQInterruptData.bNotify1 = USB488_bNOTIFY1_SRQ;
+    _usbtmcSRQInterruptData.StatusByte = srq;
+    _usbtmcSRQPending.store(true, std::memory_order_release);
+
+    return _trySendUSBTMCSRQInterrupt();
+}
+
+bool Interface::mounted() const {
+    return tud_mounted();
+}
+
+bool Interface::stats(Stats &stats) const {
+    const auto snapshot = [](const ClassCounters &counters, ClassStats &result) {
+        result.bytesIn = counters.bytesIn.load(std::memory_order_relaxed);
+        result.bytesOut = counters.bytesOut.load(std::memory_order_relaxed);
+        result.messagesIn = counters.messagesIn.load(std::memory_order_relaxed);
+        result.messagesOut = counters.messagesOut.load(std::memory_order_relaxed);
+        result.dropped = counters.dropped.load(std::memory_order_relaxed);
+    };
+
+    memset(&stats, 0, sizeof(stats));
+
+#ifdef T76_IC_USB_STATS
+    snapshot(_usbtmcCounters, stats.usbtmc);
+    snapshot(_vendorCounters, stats.vendor);
+    snapshot(_winUSBCounters, stats.winUSB);
+    snapshot(_cdcCounters, stats.cdc);
+
+    // Responses the ring discarded are counted by the ring itself
+    stats.usbtmc.dropped += static_cast<uint32_t>(_usbtmcBulkInRing.droppedCount());
+
+    stats.usbtmcQueueHighWater = _usbtmcQueueHighWater.load(std::memory_order_relaxed);
+    stats.winUSBQueueHighWater = _winUSBQueueHighWater.load(std::memory_order_relaxed);
+    stats.dispatchQueueHighWater = _dispatchQueueHighWater.load(std::memory_order_relaxed);
+    stats.zlpsSent = _zlpsSent.load(std::memory_order_relaxed);
+
+    for (uint8_t i = 0; i < T76_IC_USB_STATS_LATENCY_BUCKETS; i++) {
+        stats.dispatchLatency[i] = _dispatchLatency[i].load(std::memory_order_relaxed);
+    }
+
+    return true;
+#else
+    (void)snapshot;
+    return false;
+#endif
+}
+
+void Interface::resetStats() {
+    for (ClassCounters *counters : {&_usbtmcCounters, &_vendorCounters, &_winUSBCounters, &_cdcCounters}) {
+        counters->bytesIn.store(0, std::memory_order_relaxed);
+        counters->bytesOut.store(0, std::memory_order_relaxed);
+        counters->messagesIn.store(0, std::memory_order_relaxed);
+        counters->messagesOut.store(0, std::memory_order_relaxed);
+        counters->dropped.store(0, std::memory_order_relaxed);
+    }
+
+    _usbtmcQueueHighWater.store(0, std::memory_order_relaxed);
+    _winUSBQueueHighWater.store(0, std::memory_order_relaxed);
+    _dispatchQueueHighWater.store(0, std::memory_order_relaxed);
+    _zlpsSent.store(0, std::memory_order_relaxed);
+
+    for (auto &bucket : _dispatchLatency) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint32_t Interface::dispatchLatencyBucketLimit(uint8_t bucket) {
+    return bucket + 1 < T76_IC_USB_STATS_LATENCY_BUCKETS ? (16u << bucket) : UINT32_MAX;
+}
+
+std::string Interface::statsReport() const {
+    Stats current;
+    stats(current);
+
+    std::string report;
+
+    for (const ClassStats *counters : {&current.usbtmc, &current.vendor, &current.winUSB, &current.cdc}) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%lu,%lu,%lu,%lu,%lu,",
+                 (unsigned long)counters->bytesIn,
+                 (unsigned long)counters->bytesOut,
+                 (unsigned long)counters->messagesIn,
+                 (unsigned long)counters->messagesOut,
+                 (unsigned long)counters->dropped);
+        report += buffer;
+    }
+
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%lu,%lu,%lu,%lu",
+             (unsigned long)current.usbtmcQueueHighWater,
+             (unsigned long)current.winUSBQueueHighWater,
+             (unsigned long)current.dispatchQueueHighWater,
+             (unsigned long)current.zlpsSent);
+
+    return report + buffer;
+}
+
+std::string Interface::dispatchLatencyReport() const {
+    Stats current;
+    stats(current);
+
+    std::string report;
+
+    for (uint8_t i = 0; i < T76_IC_USB_STATS_LATENCY_BUCKETS; i++) {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), i == 0 ? "%lu" : ",%lu", (unsigned long)current.dispatchLatency[i]);
+        report += buffer;
+    }
+
+    return report;
+}
+
+void Interface::_cdcStdioOutChars(const char *buffer, int length) {
+    // Only queues the data; the runtime task is the only caller of tud_task(),
+    // and moves it to the host
+    if (!tud_cdc_n_connected(_cdcStdioInstance)) {
+        return;
+    }
+
+    int written = 0;
+    TickType_t waited = 0;
+
+    while (written < length) {
+        const uint32_t count = tud_cdc_n_write(_cdcStdioInstance, buffer + written, static_cast<uint32_t>(length - written));
+        tud_cdc_n_write_flush(_cdcStdioInstance);
+        written += static_cast<int>(count);
+
+        if (count > 0) {
+            continue;
+        }
+
+        // Wait for the host to drain the FIFO, but drop the rest of the
+        // output rather than stall the caller when it does not
+        if (__get_current_exception() != 0 || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING ||
+            waited >= pdMS_TO_TICKS(PICO_STDIO_USB_STDOUT_TIMEOUT_US / 1000) ||
+            !tud_cdc_n_connected(_cdcStdioInstance)) {
+            break;
+        }
+
+        vTaskDelay(1);
+        waited++;
+    }
+
+    _count(_cdcCounters.bytesOut, static_cast<uint32_t>(written));
+    _count(_cdcCounters.messagesOut);
+}
+
+int Interface::_cdcStdioInChars(char *buffer, int length) {
+    const uint32_t count = tud_cdc_n_read(_cdcStdioInstance, buffer, static_cast<uint32_t>(length));
+    return count > 0 ? static_cast<int>(count) : PICO_ERROR_NO_DATA;
+}
+
+void Interface::_noteDispatchLatency(const DispatchItem *item) {
+#ifdef T76_IC_USB_STATS
+    const uint32_t latency = time_us_32() - item->postedAt;
+    uint8_t bucket = 0;
+
+    while (bucket + 1 < T76_IC_USB_STATS_LATENCY_BUCKETS && latency > dispatchLatencyBucketLimit(bucket)) {
+        bucket++;
+    }
+
+    _count(_dispatchLatency[bucket]);
+#else
+    (void)item;
+#endif
+}
+
+void Interface::_noteUSBTMCQueueDepth() {
+#ifdef T76_IC_USB_STATS
+    _noteHighWater(_usbtmcQueueHighWater, static_cast<uint32_t>(_usbtmcBulkInRing.messageCount()));
+#endif
+}
+
+bool Interface::_trySendUSBTMCSRQInterrupt() {
+    if (!_usbtmcSRQPending.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    // A bug in TinyUSB (see https://github.com/hathach/tinyusb/issues/2735)
+    // forces us to hack around the fact that the following call:
+    //
+    // tud_usbtmc_transmit_notification_data(&_usbtmcSRQInterruptData, sizeof(_usbtmcSRQInterruptData));
+    //
+    // would never work because the USB stack doesn't properly check
+    // whether the interrupt endpoint is, in fact, busy. Therefore,
+    // we hardcode the port and endpoint numbers here.
+    //
+    // TODO: Check if this works universally.
+
+    uint8_t rhport = 0;
+    uint8_t endpoint = EPNUM_USBTMC_INT;
+
+    if (usbd_edpt_busy(rhport, endpoint)) {
+        return false;
+    }
+
+    if (!usbd_edpt_xfer(rhport, endpoint, reinterpret_cast<uint8_t*>(&_usbtmcSRQInterruptData), (uint16_t)sizeof(_usbtmcSRQInterruptData))) {
+        //TODO: Log error
+        return false;
+    }
+
+    _usbtmcSRQPending.store(false, std::memory_order_release);
+    return true;
+}
+
+void Interface::_runtimeTask() {
+    // Runs as soon as the scheduler starts, unless a task of higher priority is ready
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::Scheduler);
+
+    for(;;) {
+        // With the FreeRTOS OSAL, this blocks on the TinyUSB event queue until
+        // the USB interrupt posts an event, so the task only runs when there
+        // is work to do
+        tud_task();
+    }
+}
+
+void Interface::_dispatchTask() {
+    DispatchItem *item;
+
+    for(;;) {
+#ifdef T76_IC_USB_DISPATCH_COMPLETION_TASK
+        if (xQueueReceive(_dispatchQueue, &item, portMAX_DELAY) == pdTRUE) {
+            _processDispatchItem(item);
+        }
+#else
+        xQueueSelectFromSet(_dispatchQueueSet, portMAX_DELAY);
+
+        // Each set event corresponds to exactly one queued item; always take
+        // completions first so they are not stuck behind received data
+        if (xQueueReceive(_dispatchCompletionQueue, &item, 0) == pdTRUE ||
+            xQueueReceive(_dispatchQueue, &item, 0) == pdTRUE) {
+            _processDispatchItem(item);
+        }
+#endif
+    }
+}
+
+#ifdef T76_IC_USB_DISPATCH_COMPLETION_TASK
+void Interface::_completionTask() {
+    DispatchItem *item;
+
+    for(;;) {
+        if (xQueueReceive(_dispatchCompletionQueue, &item, portMAX_DELAY) == pdTRUE) {
+            _processDispatchItem(item);
+        }
+    }
+}
+#endif
+
+bool Interface::_isCompletionLane(DispatchType type) {
+    switch (type) {
+        case DispatchType::DataReceived:
+        case DispatchType::WinUSBBulkDataReceived:
+            return false;
+
+        default:
+            return true;
+    }
+}
+
+void Interface::_processDispatchItem(DispatchItem *item) {
+    T76_TRACE_SPAN("usb.dispatch");
+
+    // Items are recycled before calling into the delegate wherever
+    // possible, so that handlers can send data from this task without
+    // waiting on the item they were called for
+    _noteDispatchLatency(item);
+
+    switch (item->type) {
+        case DispatchType::DataReceived: {
+                const size_t length = item->length;
+                memcpy(_dispatchDeliveryBuffer, item->data, length);
+                _releaseDispatchItem(item);
+                _delegate._onVendorBytesReceived(_dispatchDeliveryBuffer, length);
+            }
+            break;
+
+        case DispatchType::SendData:
+            // The item is released once the vendor FIFO has taken all of its data
+            _vendorBulkInQueue.push_back(item);
+            _continueVendorBulkInTransfer();
+            break;
+
+        case DispatchType::VendorBulkInComplete:
+            _releaseDispatchItem(item);
+            _continueVendorBulkInTransfer();
+            break;
+
+        case DispatchType::WinUSBBulkDataReceived: {
+                const size_t length = item->length;
+                memcpy(_dispatchDeliveryBuffer, item->data, length);
+                _releaseDispatchItem(item);
+                _delegate._onWinUSBBulkBytesReceived(_dispatchDeliveryBuffer, length);
+            }
+            break;
+
+        case DispatchType::WinUSBBulkInComplete: {
+                const uint32_t xferredBytes = item->xferred_bytes;
+                _releaseDispatchItem(item);
+
+                _delegate._onWinUSBBulkInComplete(xferredBytes);
+
+#ifdef T76_IC_USB_WINUSB_STREAM
+                const bool streamFrame = _winUSBStreamInFlight;
+
+                if (streamFrame) {
+                    _finishWinUSBStreamFrame(xferredBytes);
+                }
+#else
+                const bool streamFrame = false;
+#endif
+
+                if (!streamFrame && _winUSBBulkInZlpInFlight) {
+                    _winUSBBulkInZlpInFlight = false;
+                    _winUSBBulkInZlpComplete = true;
+                }
+                _continueWinUSBBulkInTransfer();
+            }
+            break;
+
+        case DispatchType::SendWinUSBBulkData: {
+                std::vector<uint8_t> frame = std::move(item->frame);
+                item->frame = std::vector<uint8_t>();
+                _releaseDispatchItem(item);
+
+                _queueWinUSBBulkInData(std::move(frame));
+            }
+            break;
+
+#ifdef T76_IC_USB_WINUSB_STREAM
+        case DispatchType::WinUSBStreamKick:
+            // The kick item is static and never returned to the pool
+            _winUSBStreamKickPending.store(false, std::memory_order_release);
+            _continueWinUSBBulkInTransfer();
+            break;
+#endif
+
+#ifdef T76_IC_USB_CDC_DATA
+        case DispatchType::CDCDataKick:
+            // The kick item is static and never returned to the pool
+            _cdcDataKickPending.store(false, std::memory_order_release);
+            _continueCDCDataTransfer();
+            break;
+#endif
+
+        default:
+            LOGE("USB: unexpected dispatch type %d\n", static_cast<int>(item->type));
+            _releaseDispatchItem(item);
+            break;
+    }
+}
+
+Interface::DispatchItem *Interface::_acquireDispatchItem(DispatchType type) {
+    DispatchItem *item = nullptr;
+    const bool outgoing = (type == DispatchType::SendData || type == DispatchType::SendWinUSBBulkData);
+    QueueHandle_t freeQueue = outgoing ? _dispatchSendFreeQueue : _dispatchFreeQueue;
+
+    if (freeQueue == nullptr || xQueueReceive(freeQueue, &item, portMAX_DELAY) != pdTRUE) {
+        return nullptr;
+    }
+
+    item->type = type;
+    item->length = 0;
+    item->xferred_bytes = 0;
+
+    return item;
+}
+
+void Interface::_releaseDispatchItem(DispatchItem *item) {
+    const bool outgoing = (item >= &_dispatchItemPool[T76_IC_USB_DISPATCH_QUEUE_SIZE]);
+
+    if (xQueueSend(outgoing ? _dispatchSendFreeQueue : _dispatchFreeQueue, &item, 0) != pdTRUE) {
+        LOGE("USB: cannot return a dispatch item to its pool\n");
+    }
+}
+
+void Interface::_sendDispatchItem(DispatchItem *item) {
+    const bool payload = !_isCompletionLane(item->type);
+    QueueHandle_t queue = payload ? _dispatchQueue : _dispatchCompletionQueue;
+
+    item->postedAt = time_us_32();
+
+    if (xQueueSend(queue, &item, portMAX_DELAY) != pdTRUE) {
+        //TODO: Log error
+        _releaseDispatchItem(item);
+        return;
+    }
+
+#ifdef T76_IC_USB_STATS
+    if (payload) {
+        _noteHighWater(_dispatchQueueHighWater, static_cast<uint32_t>(uxQueueMessagesWaiting(_dispatchQueue)));
+    }
+#endif
+}
+
+void Interface::_dispatchData(DispatchType type, const uint8_t *data, size_t size) {
+    size_t offset = 0;
+
+    while (offset < size) {
+        DispatchItem *item = _acquireDispatchItem(type);
+
+        if (item == nullptr) {
+            LOGW("USB: no free dispatch item; %lu bytes of received data dropped\n", (unsigned long)(size - offset));
+            _count(type == DispatchType::WinUSBBulkDataReceived ? _winUSBCounters.dropped : _vendorCounters.dropped);
+            return;
+        }
+
+        const size_t chunkSize = std::min(size - offset, _dispatchBufferSize);
+
+        memcpy(item->data, data + offset, chunkSize);
+        item->length = static_cast<uint16_t>(chunkSize);
+        offset += chunkSize;
+
+        _sendDispatchItem(item);
+    }
+}
+
+void Interface::_vendorDataReceived(uint8_t itf, uint8_t* buffer, uint16_t bufsize) {
+    _count(_vendorCounters.bytesIn, bufsize);
+    _count(_vendorCounters.messagesIn);
+
+    _dispatchData(DispatchType::DataReceived, buffer, bufsize);
+
+    tud_vendor_n_read_flush(itf); // Flush the vendor read buffer
+}
+
+void Interface::_vendorBulkInComplete(uint8_t itf, uint32_t sentBytes) {
+    (void)sentBytes;
+
+    if (itf != _vendorInterfaceInstance) {
+        return;
+    }
+
+    DispatchItem *item = _acquireDispatchItem(DispatchType::VendorBulkInComplete);
+
+    if (item == nullptr) {
+        LOGE("USB: no free dispatch item for a vendor bulk IN completion\n");
+        return;
+    }
+
+    _sendDispatchItem(item);
+}
+
+void Interface::_continueVendorBulkInTransfer() {
+    while (!_vendorBulkInQueue.empty()) {
+        DispatchItem *item = _vendorBulkInQueue.front();
+
+        if (!tud_vendor_n_mounted(_vendorInterfaceInstance)) {
+            // Nobody to send to; drop the data rather than hold the item forever
+            _vendorBulkInOffset = item->length;
+            _count(_vendorCounters.dropped);
+        } else if (_vendorBulkInOffset == 0) {
+            _count(_vendorCounters.messagesOut);
+        }
+
+        if (_vendorBulkInOffset < item->length) {
+            const uint32_t written = tud_vendor_n_write(
+                _vendorInterfaceInstance,
+                item->data + _vendorBulkInOffset,
+                item->length - _vendorBulkInOffset
+            );
+
+            tud_vendor_n_write_flush(_vendorInterfaceInstance);
+            _vendorBulkInOffset += written;
+            _count(_vendorCounters.bytesOut, written);
+
+            if (_vendorBulkInOffset < item->length) {
+                // The FIFO is full; carry on when the current transfer completes
+                return;
+            }
+        }
+
+        _vendorBulkInQueue.pop_front();
+        _vendorBulkInOffset = 0;
+        _releaseDispatchItem(item);
+    }
+}
+
+void Interface::_winusbBulkOutReceived(uint8_t const* buffer, uint16_t bufsize) {
+    _count(_winUSBCounters.bytesIn, bufsize);
+    _count(_winUSBCounters.messagesIn);
+
+    _dispatchData(DispatchType::WinUSBBulkDataReceived, buffer, bufsize);
+}
+
+void Interface::_winusbBulkInComplete(uint32_t xferred_bytes) {
+    DispatchItem *item = _acquireDispatchItem(DispatchType::WinUSBBulkInComplete);
+
+    if (item == nullptr) {
+        LOGE("USB: no free dispatch item for a WinUSB bulk IN completion\n");
+        return;
+    }
+
+    item->xferred_bytes = xferred_bytes;
+    _sendDispatchItem(item);
+}
+
+void Interface::_queueWinUSBBulkInData(std::vector<uint8_t> data) {
+    _winUSBBulkInQueue.push_back(std::move(data));
+    _noteHighWater(_winUSBQueueHighWater, static_cast<uint32_t>(_winUSBBulkInQueue.size()));
+    _continueWinUSBBulkInTransfer();
+}
+
+void Interface::_continueWinUSBBulkInTransfer() {
+    while (!_winUSBBulkInQueue.empty()) {
+        std::vector<uint8_t> &data = _winUSBBulkInQueue.front();
+
+        if (_winUSBBulkInOffset < data.size()) {
+            const size_t chunkSize = std::min(
+                data.size() - _winUSBBulkInOffset,
+                static_cast<size_t>(CFG_TUD_VENDOR_TX_BUFSIZE)
+            );
+            if (!t76_winusb_bulk_in_xfer(
+                    data.data() + _winUSBBulkInOffset,
+                    static_cast<uint16_t>(chunkSize))) {
+                return;
+            }
+
+            _winUSBBulkInOffset += chunkSize;
+            _count(_winUSBCounters.bytesOut, static_cast<uint32_t>(chunkSize));
+            return;
+        }
+
+        const bool needsZlp =
+            !data.empty()
+            && (data.size() % _winUSBEndpointPacketSize) == 0;
+        if (needsZlp && !_winUSBBulkInZlpComplete) {
+            if (!t76_winusb_bulk_in_zlp()) {
+                return;
+            }
+
+            _winUSBBulkInZlpInFlight = true;
+            _count(_zlpsSent);
+            return;
+        }
+
+        _winUSBBulkInQueue.pop_front();
+        _winUSBBulkInOffset = 0;
+        _count(_winUSBCounters.messagesOut);
+        _winUSBBulkInZlpInFlight = false;
+        _winUSBBulkInZlpComplete = false;
+    }
+
+#ifdef T76_IC_USB_WINUSB_STREAM
+    // Framed messages have been sent; the endpoint can carry stream data
+    _continueWinUSBStream();
+#endif
+}
+
+#ifdef T76_IC_USB_WINUSB_STREAM
+uint8_t * T76_CORE1_CODE Interface::acquireWinUSBStreamFrame() {
+    const uint32_t head = _winUSBStreamHead.load(std::memory_order_relaxed);
+    const uint32_t tail = _winUSBStreamTail.load(std::memory_order_acquire);
+
+    if (head - tail >= T76_IC_USB_WINUSB_STREAM_FRAME_COUNT) {
+        _winUSBStreamOverruns.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    return _winUSBStreamFrames[head % T76_IC_USB_WINUSB_STREAM_FRAME_COUNT].data;
+}
+
+bool T76_CORE1_CODE Interface::commitWinUSBStreamFrame(size_t length) {
+    const uint32_t head = _winUSBStreamHead.load(std::memory_order_relaxed);
+    const uint32_t tail = _winUSBStreamTail.load(std::memory_order_acquire);
+
+    if (length == 0 || length > T76_IC_USB_WINUSB_STREAM_FRAME_SIZE || head - tail >= T76_IC_USB_WINUSB_STREAM_FRAME_COUNT) {
+        return false;
+    }
+
+    _winUSBStreamFrames[head % T76_IC_USB_WINUSB_STREAM_FRAME_COUNT].length = static_cast<uint16_t>(length);
+    _winUSBStreamHead.store(head + 1, std::memory_order_release);
+
+    if (_winUSBStreamDoorbell >= 0) {
+        if (get_core_num() == 0) {
+            multicore_doorbell_set_current_core(_winUSBStreamDoorbell);
+        } else {
+            multicore_doorbell_set_other_core(_winUSBStreamDoorbell);
+        }
+    }
+
+    return true;
+}
+
+Interface::WinUSBStreamStats Interface::winUSBStreamStats() const {
+    WinUSBStreamStats stats;
+
+    taskENTER_CRITICAL();
+    stats.framesSent = _winUSBStreamFramesSent;
+    stats.bytesSent = _winUSBStreamBytesSent;
+    stats.bytesPerSecond = _winUSBStreamBytesPerSecond;
+    taskEXIT_CRITICAL();
+
+    stats.overruns = _winUSBStreamOverruns.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+void Interface::_continueWinUSBStream() {
+    if (_winUSBStreamInFlight) {
+        return;
+    }
+
+    const uint32_t tail = _winUSBStreamTail.load(std::memory_order_relaxed);
+
+    if (tail == _winUSBStreamHead.load(std::memory_order_acquire)) {
+        return; // Nothing published
+    }
+
+    const WinUSBStreamFrame &frame = _winUSBStreamFrames[tail % T76_IC_USB_WINUSB_STREAM_FRAME_COUNT];
+
+    if (!t76_winusb_bulk_in_xfer_direct(frame.data, frame.length)) {
+        return; // Endpoint busy or not configured; retried on the next completion or kick
+    }
+
+    _winUSBStreamInFlight = true;
+}
+
+void Interface::_finishWinUSBStreamFrame(uint32_t xferredBytes) {
+    _winUSBStreamInFlight = false;
+
+    // Hand the frame back to the producer
+    _winUSBStreamTail.fetch_add(1, std::memory_order_release);
+
+    _count(_winUSBCounters.bytesOut, xferredBytes);
+    _count(_winUSBCounters.messagesOut);
+
+    const uint64_t now = time_us_64();
+
+    taskENTER_CRITICAL();
+    _winUSBStreamFramesSent++;
+    _winUSBStreamBytesSent += xferredBytes;
+    _winUSBStreamWindowBytes += xferredBytes;
+
+    if (now - _winUSBStreamWindowStart >= 1000000) {
+        _winUSBStreamBytesPerSecond = static_cast<uint32_t>((static_cast<uint64_t>(_winUSBStreamWindowBytes) * 1000000) / (now - _winUSBStreamWindowStart));
+        _winUSBStreamWindowStart = now;
+        _winUSBStreamWindowBytes = 0;
+    }
+    taskEXIT_CRITICAL();
 }
 
-void Interface::init() {
-    // Initialize the USB interface
-    _singleton = this;
+void Interface::_winUSBStreamDoorbellHandler() {
+    Interface *iface = _singleton;
 
-    // Create a queue for dispatching USB events
-    _dispatchQueue = xQueueCreate(10, sizeof(DispatchItem*));
+    if (iface == nullptr || !multicore_doorbell_is_set_current_core(iface->_winUSBStreamDoorbell)) {
+        return;
+    }
 
-    TaskHandle_t taskHandle = nullptr;
+    multicore_doorbell_clear_current_core(iface->_winUSBStreamDoorbell);
 
-    // Create a task for runtime operations
-    xTaskCreate(
-        [](void* param) {
-            Interface* iface = static_cast<Interface*>(param);
-            iface->_runtimeTask();
-        }, 
-        "USBRuntime", 
-        T76_IC_USB_RUNTIME_TASK_STACK_SIZE, 
-        this, 
-        T76_IC_USB_RUNTIME_TASK_PRIORITY,
-        &taskHandle
-    );
+    if (iface->_winUSBStreamKickPending.exchange(true, std::memory_order_acq_rel)) {
+        return; // Already queued
+    }
 
-    xTaskCreate(
-        [](void* param) {
-            Interface* iface = static_cast<Interface*>(param);
-            iface->_dispatchTask();
-        }, 
-        "USBDispatch", 
-        T76_IC_USB_DISPATCH_TASK_STACK_SIZE, 
-        this, 
-        T76_IC_USB_DISPATCH_TASK_PRIORITY, 
-        &taskHandle
-    );
-}
+    DispatchItem *item = &iface->_winUSBStreamKickItem;
+    item->postedAt = time_us_32();
 
-void Interface::sendVendorBulkData(const std::vector<uint8_t> &data) {
-    DispatchItem *item = new DispatchItem;
-    
-    item->type = DispatchType::SendData;
-    item->data = std::move(data);
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
 
-    if (xQueueSend(_dispatchQueue, &item, portMAX_DELAY) != pdTRUE) {
-        //TODO: Log error
-        delete item; // Clean up the item if sending to the queue fails
+    if (xQueueSendFromISR(iface->_dispatchCompletionQueue, &item, &higherPriorityTaskWoken) != pdTRUE) {
+        iface->_winUSBStreamKickPending.store(false, std::memory_order_release);
     }
-}
 
-bool Interface::sendVendorControlTransferData(uint8_t port, const tusb_control_request_t *request, const std::vector<uint8_t> &data) {
-    if (request->bmRequestType_bit.direction == TUSB_DIR_IN) {
-        if (data.size() != request->wLength) {
-            //TODO: Log error
-            return false;
-        }
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+#endif
 
-        _vendorControlDataOutBuffer = data; // Store the data to be sent
+#ifdef T76_IC_USB_ISO_STREAM
+uint8_t * T76_CORE1_CODE Interface::acquireIsoStreamFrame() {
+    const uint32_t head = _isoStreamHead.load(std::memory_order_relaxed);
+    const uint32_t tail = _isoStreamTail.load(std::memory_order_acquire);
 
-        // Handle IN control transfer
-        return tud_control_xfer(port, request, static_cast<void*>(_vendorControlDataOutBuffer.data()), _vendorControlDataOutBuffer.size());
+    if (head - tail >= T76_IC_USB_ISO_STREAM_FRAME_COUNT) {
+        _isoStreamOverruns.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
     }
 
-    return false; // Only IN transfers are supported for control transfers
+    return _isoStreamFrames[head % T76_IC_USB_ISO_STREAM_FRAME_COUNT].data;
 }
 
-bool Interface::sendWinUSBControlTransferData(uint8_t port, const tusb_control_request_t *request, const std::vector<uint8_t> &data) {
-    if (request->bmRequestType_bit.direction == TUSB_DIR_IN) {
-        if (data.size() != request->wLength) {
-            return false;
-        }
+bool T76_CORE1_CODE Interface::commitIsoStreamFrame(size_t length) {
+    const uint32_t head = _isoStreamHead.load(std::memory_order_relaxed);
+    const uint32_t tail = _isoStreamTail.load(std::memory_order_acquire);
 
-        _winusbControlDataOutBuffer = data;
-        return tud_control_xfer(port, request, static_cast<void*>(_winusbControlDataOutBuffer.data()), _winusbControlDataOutBuffer.size());
+    if (length == 0 || length > T76_IC_USB_ISO_STREAM_PACKET_SIZE || head - tail >= T76_IC_USB_ISO_STREAM_FRAME_COUNT) {
+        return false;
     }
 
-    return false;
+    // No doorbell: while streaming, the endpoint completes a packet every
+    // USB frame, and each completion picks up the oldest published frame
+    _isoStreamFrames[head % T76_IC_USB_ISO_STREAM_FRAME_COUNT].length = static_cast<uint16_t>(length);
+    _isoStreamHead.store(head + 1, std::memory_order_release);
+
+    return true;
 }
 
-void Interface::sendWinUSBBulkData(const std::vector<uint8_t> &data) {
-    DispatchItem *item = new DispatchItem;
+Interface::IsoStreamStats Interface::isoStreamStats() const {
+    IsoStreamStats stats;
 
-    item->type = DispatchType::SendWinUSBBulkData;
-    item->data = data;
+    taskENTER_CRITICAL();
+    stats.active = _isoStreamActive;
+    stats.framesSent = _isoStreamFramesSent;
+    stats.bytesSent = _isoStreamBytesSent;
+    stats.underruns = _isoStreamUnderruns;
+    stats.missedFrames = _isoStreamMissedFrames;
+    taskEXIT_CRITICAL();
 
-    if (xQueueSend(_dispatchQueue, &item, portMAX_DELAY) != pdTRUE) {
-        delete item;
-    }
+    stats.overruns = _isoStreamOverruns.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+void Interface::_isoStreamStarted() {
+    taskENTER_CRITICAL();
+    _isoStreamActive = true;
+    _isoStreamFrameInFlight = false;
+    _isoStreamLastSof = static_cast<uint16_t>(usb_hw->sof_rd & USB_SOF_RD_BITS);
+    taskEXIT_CRITICAL();
+
+    _continueIsoStream();
 }
 
-void Interface::sendUSBTMCBulkData(const std::vector<uint8_t> &data) {
-    _usbtmcBulkInDataQueue.push(data);
+void Interface::_isoStreamStopped() {
+    // The class driver closes the endpoint, which abandons the packet in
+    // flight; its frame has not been released, so it is sent again first
+    taskENTER_CRITICAL();
+    _isoStreamActive = false;
+    _isoStreamFrameInFlight = false;
+    taskEXIT_CRITICAL();
 }
 
-void Interface::sendUSBTMCBulkData(std::string data, bool addNewline) {
-    std::vector<uint8_t> byteData(data.begin(), data.end());
+void Interface::_isoStreamInComplete(uint32_t xferredBytes) {
+    if (!_isoStreamActive) {
+        return;
+    }
 
-    // Append byteData to the USBTMC bulk IN buffer
+    // Every USB frame between two completions beyond the first went by
+    // without a packet queued
+    const uint16_t sof = static_cast<uint16_t>(usb_hw->sof_rd & USB_SOF_RD_BITS);
+    const uint16_t elapsed = static_cast<uint16_t>((sof - _isoStreamLastSof) & USB_SOF_RD_BITS);
 
-    _usbtmcBulkInDataBuffer.insert(_usbtmcBulkInDataBuffer.end(), byteData.begin(), byteData.end());
+    _isoStreamLastSof = sof;
 
-    if (addNewline) {
-        // Flush the current buffer with a newline to the queue
-        _usbtmcBulkInDataBuffer.push_back('\n');
-        _usbtmcBulkInDataQueue.push(_usbtmcBulkInDataBuffer);
-        _usbtmcBulkInDataBuffer.clear();
+    if (_isoStreamFrameInFlight) {
+        // Hand the frame back to the producer
+        _isoStreamTail.fetch_add(1, std::memory_order_release);
     }
-}
 
-bool Interface::sendUSBTMCSRQInterrupt(const uint8_t srq) {
-    _usbtmcSRQInterruptData.bNotify1 = USB488_bNOTIFY1_SRQ;
-    _usbtmcSRQInterruptData.StatusByte = srq;
-    _usbtmcSRQPending.store(true, std::memory_order_release);
+    taskENTER_CRITICAL();
+    if (_isoStreamFrameInFlight) {
+        _isoStreamFramesSent++;
+        _isoStreamBytesSent += xferredBytes;
+    }
 
-    return _trySendUSBTMCSRQInterrupt();
+    if (elapsed > 1) {
+        _isoStreamMissedFrames += elapsed - 1;
+    }
+    taskEXIT_CRITICAL();
+
+    _isoStreamFrameInFlight = false;
+    _continueIsoStream();
 }
 
-bool Interface::mounted() const {
-    return tud_mounted();
+void Interface::_continueIsoStream() {
+    const uint32_t tail = _isoStreamTail.load(std::memory_order_relaxed);
+
+    if (tail != _isoStreamHead.load(std::memory_order_acquire)) {
+        const IsoStreamFrame &frame = _isoStreamFrames[tail % T76_IC_USB_ISO_STREAM_FRAME_COUNT];
+
+        if (t76_iso_stream_in_xfer(frame.data, frame.length)) {
+            _isoStreamFrameInFlight = true;
+        }
+
+        return;
+    }
+
+    // Keep a packet queued in every USB frame, so that the host sees an
+    // empty packet rather than nothing, and the next completion comes a
+    // frame later to pick up new data
+    if (t76_iso_stream_in_xfer(nullptr, 0)) {
+        taskENTER_CRITICAL();
+        _isoStreamUnderruns++;
+        taskEXIT_CRITICAL();
+    }
 }
+#endif
 
-bool Interface::_trySendUSBTMCSRQInterrupt() {
-    if (!_usbtmcSRQPending.load(std::memory_order_acquire)) {
+#ifdef T76_IC_USB_CDC_DATA
+bool Interface::writeCDCData(const uint8_t *data, size_t length, TickType_t timeout) {
+    if (length == 0) {
+        return true;
+    }
+
+    if (length > _cdcDataTxRing.capacity() || !tud_cdc_n_connected(_cdcDataInstance)) {
         return false;
     }
 
-    // A bug in TinyUSB (see https://github.com/hathach/tinyusb/issues/2735)
-    // forces us to hack around the fact that the following call:
-    //
-    // tud_usbtmc_transmit_notification_data(&_usbtmcSRQInterruptData, sizeof(_usbtmcSRQInterruptData));
-    //
-    // would never work because the USB stack doesn't properly check
-    // whether the interrupt endpoint is, in fact, busy. Therefore,
-    // we hardcode the port and endpoint numbers here.
-    //
-    // TODO: Check if this works universally.
+    // The runtime task reports the completions that free space, so it must never wait
+    const bool canWait = xTaskGetCurrentTaskHandle() != _runtimeTaskHandle;
+    const TickType_t start = xTaskGetTickCount();
+    bool waited = false;
 
-    uint8_t rhport = 0;
-    uint8_t endpoint = EPNUM_USBTMC_INT;
+    while (!_cdcDataTxRing.writeMessage(data, length)) {
+        const TickType_t elapsed = xTaskGetTickCount() - start;
 
-    if (usbd_edpt_busy(rhport, endpoint)) {
-        return false;
+        if (!canWait || elapsed >= timeout) {
+            return false;
+        }
+
+        xSemaphoreTake(_cdcDataTxSpaceSemaphore, timeout - elapsed);
+        waited = true;
     }
 
-    if (!usbd_edpt_xfer(rhport, endpoint, reinterpret_cast<uint8_t*>(&_usbtmcSRQInterruptData), (uint16_t)sizeof(_usbtmcSRQInterruptData))) {
-        //TODO: Log error
-        return false;
+    if (waited) {
+        // Pass the wake-up on in case another writer is also waiting
+        xSemaphoreGive(_cdcDataTxSpaceSemaphore);
     }
 
-    _usbtmcSRQPending.store(false, std::memory_order_release);
+    _kickCDCDataTransfer();
     return true;
 }
 
-void Interface::_runtimeTask() {
-    board_init();
-    tusb_init();
+size_t Interface::readCDCData(uint8_t *buffer, size_t maxLength, TickType_t timeout) {
+    if (maxLength == 0) {
+        return 0;
+    }
 
-    for(;;) {
-        tud_task();
-        
-        if (!tud_task_event_ready()) {
-            vTaskDelay(pdMS_TO_TICKS(T76_IC_USB_TASK_DELAY_MS));
+    // Pick up anything left in TinyUSB while the ring was full
+    _cdcDataReceived();
+
+    const TickType_t start = xTaskGetTickCount();
+
+    while (_cdcDataRxRing.messageCount() == 0) {
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+
+        if (elapsed >= timeout) {
+            return 0;
+        }
+
+        xSemaphoreTake(_cdcDataRxSemaphore, timeout - elapsed);
+    }
+
+    size_t total = 0;
+
+    while (total < maxLength) {
+        const uint8_t *data;
+        bool endOfMessage;
+        const size_t length = _cdcDataRxRing.peek(data, maxLength - total, endOfMessage);
+
+        if (length == 0) {
+            break;
         }
+
+        memcpy(buffer + total, data, length);
+        _cdcDataRxRing.consume(length);
+        total += length;
     }
+
+    // Now that there is room, take more from TinyUSB so that it rearms the endpoint
+    _cdcDataReceived();
+
+    return total;
 }
 
-void Interface::_dispatchTask() {
-    DispatchItem *item;
+size_t Interface::cdcDataAvailable() const {
+    return (_cdcDataRxRing.capacity() - _cdcDataRxRing.freeSpace()) + tud_cdc_n_available(_cdcDataInstance);
+}
 
-    for(;;) {
-        if (xQueueReceive(_dispatchQueue, &item, portMAX_DELAY) == pdTRUE) {
-            switch (item->type) {
-                case DispatchType::DataReceived:
-                    _delegate._onVendorDataReceived(item->data);
-                    break;
-
-                case DispatchType::SendData: {
-                        size_t offset = 0;
-                        size_t total = item->data.size();
-                        uint8_t *buffer = item->data.data();
-
-                        while (offset < total) {
-                            size_t written = tud_vendor_n_write(_vendorInterfaceInstance, buffer + offset, total - offset);
-                            tud_vendor_n_write_flush(_vendorInterfaceInstance);
-                            offset += written;
-                            taskYIELD(); // Yield to allow other tasks to run
-                        }
-                    }
-                    break;
+bool Interface::cdcDataConnected() const {
+    return tud_cdc_n_connected(_cdcDataInstance);
+}
 
-                case DispatchType::WinUSBBulkDataReceived:
-                    _delegate._onWinUSBBulkDataReceived(item->data);
-                    break;
+void Interface::_kickCDCDataTransfer() {
+    if (_cdcDataKickPending.exchange(true, std::memory_order_acq_rel)) {
+        return; // Already queued
+    }
 
-                case DispatchType::WinUSBBulkInComplete:
-                    _delegate._onWinUSBBulkInComplete(item->xferred_bytes);
-                    if (_winUSBBulkInZlpInFlight) {
-                        _winUSBBulkInZlpInFlight = false;
-                        _winUSBBulkInZlpComplete = true;
-                    }
-                    _continueWinUSBBulkInTransfer();
-                    break;
+    DispatchItem *item = &_cdcDataKickItem;
+    item->postedAt = time_us_32();
+
+    if (xQueueSend(_dispatchCompletionQueue, &item, 0) != pdTRUE) {
+        LOGW("CDC data: completion queue full; the next write retries the transfer\n");
+        _cdcDataKickPending.store(false, std::memory_order_release);
+    }
+}
 
-                case DispatchType::SendWinUSBBulkData:
-                    _queueWinUSBBulkInData(std::move(item->data));
-                    break;
+void Interface::_continueCDCDataTransfer() {
+    const bool connected = tud_cdc_n_connected(_cdcDataInstance);
+    bool released = false;
 
-                default:
-                    // Handle unexpected dispatch type
-                    //TODO: Log error
-                    break;
-            }
+    for (;;) {
+        const uint8_t *data;
+        bool endOfMessage;
+        const size_t length = _cdcDataTxRing.peek(data, SIZE_MAX, endOfMessage);
+
+        if (length == 0) {
+            break;
+        }
+
+        // Once the host has closed the port, nobody will read the data; discard it
+        const size_t written = connected ? tud_cdc_n_write(_cdcDataInstance, data, static_cast<uint32_t>(length)) : length;
+
+        if (written == 0) {
+            break;
+        }
+
+        _cdcDataTxRing.consume(written);
+        released = true;
 
-            delete item; // Clean up the item after processing
+        if (written < length) {
+            // The TinyUSB FIFO is full; the rest goes when this transfer completes
+            break;
         }
     }
+
+    if (connected) {
+        tud_cdc_n_write_flush(_cdcDataInstance);
+    }
+
+    if (released) {
+        xSemaphoreGive(_cdcDataTxSpaceSemaphore);
+    }
 }
 
-void Interface::_vendorDataReceived(uint8_t itf, uint8_t* buffer, uint16_t bufsize) {
-    std::vector<uint8_t> data(buffer, buffer + bufsize);
+void Interface::_cdcDataReceived() {
+    bool received = false;
 
-    DispatchItem *item = new DispatchItem;
-    
-    item->type = DispatchType::DataReceived;
-    item->data = std::move(data);
+    xSemaphoreTake(_cdcDataRxMutex, portMAX_DELAY);
 
-    tud_vendor_n_read_flush(itf); // Flush the vendor read buffer
+    while (tud_cdc_n_available(_cdcDataInstance) > 0) {
+        uint8_t chunk[64];
+        const size_t length = std::min<size_t>(tud_cdc_n_available(_cdcDataInstance), sizeof(chunk));
 
-    if (xQueueSend(_dispatchQueue, &item, portMAX_DELAY) != pdTRUE) {
-        //TODO: Log error
-        delete item;
+        // Data that does not fit stays in TinyUSB, which holds off the host
+        if (!_cdcDataRxRing.canWrite(length, true)) {
+            break;
+        }
+
+        const size_t read = tud_cdc_n_read(_cdcDataInstance, chunk, static_cast<uint32_t>(length));
+
+        if (read == 0) {
+            break;
+        }
+
+        _cdcDataRxRing.writeMessage(chunk, read);
+        received = true;
+    }
+
+    xSemaphoreGive(_cdcDataRxMutex);
+
+    if (received) {
+        xSemaphoreGive(_cdcDataRxSemaphore);
     }
 }
+#endif
 
-void Interface::_winusbBulkOutReceived(uint8_t const* buffer, uint16_t bufsize) {
-    std::vector<uint8_t> data(buffer, buffer + bufsize);
+#ifdef T76_IC_USB_TRIGGER
+bool Interface::attachTriggerAction(TriggerAction action, void *context) {
+    if (_triggerDoorbell < 0) {
+        return false;
+    }
 
-    DispatchItem *item = new DispatchItem;
+    const uint doorbellIrq = multicore_doorbell_irq_num(_triggerDoorbell);
 
-    item->type = DispatchType::WinUSBBulkDataReceived;
-    item->data = std::move(data);
+    irq_set_enabled(doorbellIrq, false);
 
-    if (xQueueSend(_dispatchQueue, &item, portMAX_DELAY) != pdTRUE) {
-        delete item;
+    _triggerContext = context;
+    _triggerAction.store(action, std::memory_order_release);
+
+    if (action) {
+        // The handler is shared with the stream doorbell, and only acts on its own doorbell
+        static bool handlerAdded = false;
+
+        if (!handlerAdded) {
+            irq_add_shared_handler(doorbellIrq, _triggerDoorbellHandler, PICO_SHARED_IRQ_HANDLER_HIGHEST_ORDER_PRIORITY);
+            handlerAdded = true;
+        }
+
+        // The stream handler on the same interrupt calls FreeRTOS, which rules out any higher priority
+        irq_set_priority(doorbellIrq, configMAX_SYSCALL_INTERRUPT_PRIORITY);
+        irq_set_enabled(doorbellIrq, true);
     }
+
+    return true;
 }
 
-void Interface::_winusbBulkInComplete(uint32_t xferred_bytes) {
-    DispatchItem *item = new DispatchItem;
+void Interface::fireTrigger() {
+    const uint32_t now = time_us_32();
 
-    item->type = DispatchType::WinUSBBulkInComplete;
-    item->xferred_bytes = xferred_bytes;
+    _triggersFired.fetch_add(1, std::memory_order_relaxed);
 
-    if (xQueueSend(_dispatchQueue, &item, portMAX_DELAY) != pdTRUE) {
-        delete item;
+    if (_triggerClaimed.exchange(true, std::memory_order_acq_rel)) {
+        _triggersMissed.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
+
+    _triggerTimestamp.store(now, std::memory_order_relaxed);
+    _triggerReady.store(true, std::memory_order_release);
+
+    if (_triggerDoorbell >= 0) {
+        if (get_core_num() == 0) {
+            multicore_doorbell_set_other_core(_triggerDoorbell);
+        } else {
+            multicore_doorbell_set_current_core(_triggerDoorbell);
+        }
+    }
+
+    // Wakes a core that waits for the trigger in __wfe() instead of attaching an action
+    __sev();
 }
 
-void Interface::_queueWinUSBBulkInData(std::vector<uint8_t> data) {
-    _winUSBBulkInQueue.push_back(std::move(data));
-    _continueWinUSBBulkInTransfer();
+bool Interface::pollTrigger(uint32_t &timestampUs) {
+    return _takeTrigger(timestampUs);
 }
 
-void Interface::_continueWinUSBBulkInTransfer() {
-    while (!_winUSBBulkInQueue.empty()) {
-        std::vector<uint8_t> &data = _winUSBBulkInQueue.front();
+bool Interface::_takeTrigger(uint32_t &timestampUs) {
+    if (!_triggerReady.exchange(false, std::memory_order_acquire)) {
+        return false;
+    }
 
-        if (_winUSBBulkInOffset < data.size()) {
-            const size_t chunkSize = std::min(
-                data.size() - _winUSBBulkInOffset,
-                static_cast<size_t>(CFG_TUD_VENDOR_TX_BUFSIZE)
-            );
-            if (!t76_winusb_bulk_in_xfer(
-                    data.data() + _winUSBBulkInOffset,
-                    static_cast<uint16_t>(chunkSize))) {
-                return;
-            }
+    timestampUs = _triggerTimestamp.load(std::memory_order_relaxed);
+    _triggerClaimed.store(false, std::memory_order_release);
 
-            _winUSBBulkInOffset += chunkSize;
-            return;
-        }
+    // Triggers are delivered by a single consumer, so the extremes need no compare-and-swap
+    const uint32_t latency = time_us_32() - timestampUs;
 
-        const bool needsZlp =
-            !data.empty()
-            && (data.size() % _winUSBEndpointPacketSize) == 0;
-        if (needsZlp && !_winUSBBulkInZlpComplete) {
-            if (!t76_winusb_bulk_in_zlp()) {
-                return;
-            }
+    _triggerLastLatency.store(latency, std::memory_order_relaxed);
+    _triggerTotalLatency.fetch_add(latency, std::memory_order_relaxed);
 
-            _winUSBBulkInZlpInFlight = true;
-            return;
-        }
+    if (latency < _triggerMinLatency.load(std::memory_order_relaxed)) {
+        _triggerMinLatency.store(latency, std::memory_order_relaxed);
+    }
 
-        _winUSBBulkInQueue.pop_front();
-        _winUSBBulkInOffset = 0;
-        _winUSBBulkInZlpInFlight = false;
-        _winUSBBulkInZlpComplete = false;
+    if (latency > _triggerMaxLatency.load(std::memory_order_relaxed)) {
+        _triggerMaxLatency.store(latency, std::memory_order_relaxed);
+    }
+
+    _triggersDelivered.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void Interface::_triggerDoorbellHandler() {
+    Interface *iface = _singleton;
+
+    if (iface == nullptr || !multicore_doorbell_is_set_current_core(iface->_triggerDoorbell)) {
+        return;
+    }
+
+    multicore_doorbell_clear_current_core(iface->_triggerDoorbell);
+
+    const TriggerAction action = iface->_triggerAction.load(std::memory_order_acquire);
+    uint32_t timestamp;
+
+    if (action && iface->_takeTrigger(timestamp)) {
+        action(iface->_triggerContext, timestamp);
     }
 }
 
+Interface::TriggerStats Interface::triggerStats() const {
+    TriggerStats stats;
+
+    stats.fired = _triggersFired.load(std::memory_order_relaxed);
+    stats.delivered = _triggersDelivered.load(std::memory_order_acquire);
+    stats.missed = _triggersMissed.load(std::memory_order_relaxed);
+    stats.lastLatencyUs = _triggerLastLatency.load(std::memory_order_relaxed);
+    stats.maxLatencyUs = _triggerMaxLatency.load(std::memory_order_relaxed);
+
+    const uint32_t minLatency = _triggerMinLatency.load(std::memory_order_relaxed);
+    stats.minLatencyUs = minLatency == UINT32_MAX ? 0 : minLatency;
+    stats.meanLatencyUs = stats.delivered ? _triggerTotalLatency.load(std::memory_order_relaxed) / stats.delivered : 0;
+
+    return stats;
+}
+
+void Interface::resetTriggerStats() {
+    _triggersFired.store(0, std::memory_order_relaxed);
+    _triggersDelivered.store(0, std::memory_order_relaxed);
+    _triggersMissed.store(0, std::memory_order_relaxed);
+    _triggerLastLatency.store(0, std::memory_order_relaxed);
+    _triggerMinLatency.store(UINT32_MAX, std::memory_order_relaxed);
+    _triggerMaxLatency.store(0, std::memory_order_relaxed);
+    _triggerTotalLatency.store(0, std::memory_order_relaxed);
+}
+#endif
+
 bool Interface::_processWebUSBRequest(uint8_t rhport, const tusb_control_request_t* request) {
     switch (request->bmRequestType_bit.type) {
         case TUSB_REQ_TYPE_VENDOR:
@@ -370,7 +1685,7 @@ bool Interface::_vendorControlTransfer(uint8_t rhport, uint8_t stage, const tusb
         case CONTROL_STAGE_DATA:
 
             if (request->bmRequestType_bit.direction == TUSB_DIR_OUT) {
-                return _delegate._onVendorControlTransferOut(request->bRequest, request->wValue, std::vector<uint8_t>(_vendorControlDataInBuffer.begin(), _vendorControlDataInBuffer.begin() + request->wLength));
+                return _delegate._onVendorControlTransferOutBytes(request->bRequest, request->wValue, _vendorControlDataInBuffer.data(), request->wLength);
             }
 
             break;
@@ -397,10 +1712,11 @@ bool Interface::_winusbControlTransfer(uint8_t rhport, uint8_t stage, const tusb
 
         case CONTROL_STAGE_DATA:
             if (request->bmRequestType_bit.direction == TUSB_DIR_OUT) {
-                return _delegate._onWinUSBControlTransferOut(
+                return _delegate._onWinUSBControlTransferOutBytes(
                     request->bRequest,
                     request->wValue,
-                    std::vector<uint8_t>(_winusbControlDataInBuffer.begin(), _winusbControlDataInBuffer.begin() + request->wLength)
+                    _winusbControlDataInBuffer.data(),
+                    request->wLength
                 );
             }
             break;
@@ -421,11 +1737,17 @@ usbtmc_response_capabilities_488_t const * Interface::_usbtmcCapabilities() {
 
 void Interface::_usbtmcOpen(uint8_t interface_id) {
     // Handle USBTMC open event
-    tud_usbtmc_start_bus_read(); // Start reading from the USBTMC bus
+    T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::USBConfigured);
+    _startUSBTMCBulkOut();
 }
 
 bool Interface::_usbtmcMsgTrigger(usbtmc_msg_generic_t* msg) {
-    // Handle USBTMC message trigger
+#ifdef T76_IC_USB_TRIGGER
+    // Timestamped here rather than after the message has been through a
+    // task or the parser, so that the latency covers the whole path
+    fireTrigger();
+#endif
+
     return true;
 }
 
@@ -435,59 +1757,83 @@ bool Interface::_usbtmcMsgBulkOutStart(usbtmc_msg_request_dev_dep_out const *msg
 }
 
 bool Interface::_usbtmcMsgData(void *data, size_t len, bool transfer_complete) {    
-    if (len == 0) {
-        //TODO: Log error
-        return false; // Invalid data
+    T76_TRACE_SPAN("usbtmc.data");
+
+    // TinyUSB calls this once per received packet, so messages of any length
+    // are streamed straight through to the delegate without reassembly. An
+    // empty chunk is only meaningful if it ends the transfer.
+    if (len == 0 && !transfer_complete) {
+        _startUSBTMCBulkOut();
+        return true;
     }
 
-    if (len > T76_IC_USB_INTERFACE_BULK_IN_MAX_MESSAGE_SIZE) {
-        //TODO: Log error
-        return false; // Data too large
+    _count(_usbtmcCounters.bytesIn, static_cast<uint32_t>(len));
+
+    if (transfer_complete) {
+        _count(_usbtmcCounters.messagesIn);
+        T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::FirstRequest);
     }
 
-    _delegate._onUSBTMCDataReceived(std::vector<uint8_t>(static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + len), transfer_complete);
+    _delegate._onUSBTMCBytesReceived(static_cast<const uint8_t*>(data), len, transfer_complete);
     
-    tud_usbtmc_start_bus_read(); // Start reading from the USBTMC bus
+    if (transfer_complete && _usbtmcBulkInCoalesce && _usbtmcBulkInCoalesceWindowUs == 0) {
+        // Everything produced by this input message goes out as one response
+        flushUSBTMCBulkData();
+    }
+
+    _startUSBTMCBulkOut();
 
     return true; // Always return true so as not to stall the USBTMC interface
 }
 
 bool Interface::_usbtmcMsgBulkInComplete() {
-    // Handle USBTMC bulk IN message completion
-    tud_usbtmc_start_bus_read(); // Start reading from the USBTMC bus
+    // Handle USBTMC bulk IN message completion; the data sent can now be
+    // released from the ring
+    const size_t released = _usbtmcBulkInInFlight;
+    _usbtmcBulkInInFlight = 0;
+    _releaseUSBTMCBulkInSpace(released);
+
+    _startUSBTMCBulkOut();
     return true;
 }
 
 bool Interface::_usbtmcMsgBulkInRequest(usbtmc_msg_request_dev_dep_in const *request) {
-    if (_usbtmcBulkInDataPending.size() == 0) {
-        // No pending data, try to get the next message from the queue
+    if (_usbtmcBulkInInFlight > 0) {
+        LOGW("USBTMC: bulk IN request while a transfer is in progress\n");
+        return true; // A transfer is already in progress
+    }
 
-        if (_usbtmcBulkInDataQueue.size() == 0) {
-            return true; // Never stall, always return true as per USBTMC spec
-        }
+    // Send at most request->TransferSize bytes of the oldest message straight
+    // from the ring. If the message wraps around the end of the ring, or is
+    // larger than the request, the rest is sent on the next request.
 
-        _usbtmcBulkInDataQueue.tryPop(_usbtmcBulkInDataPending);
-        _usbtmcBulkInPendingOffset = 0;
+    if (_usbtmcBulkInCoalesce && _usbtmcBulkInRing.messageCount() == 0) {
+        // The host is waiting, so send whatever has been coalesced so far
+        flushUSBTMCBulkData();
     }
 
-    // Send at most request->TransferSize bytes from the pending data
-    // If that's less than the pending data size, keep the rest for next time
+    const uint8_t *data = nullptr;
+    bool endOfMessage = false;
+    size_t toSend = _usbtmcBulkInRing.peek(data, static_cast<size_t>(request->TransferSize), endOfMessage);
 
-    size_t toSend = std::min(static_cast<size_t>(request->TransferSize), _usbtmcBulkInDataPending.size() - _usbtmcBulkInPendingOffset);
-    bool endOfMessage = ((toSend + _usbtmcBulkInPendingOffset) == _usbtmcBulkInDataPending.size());
-
-    if (!tud_usbtmc_transmit_dev_msg_data(_usbtmcBulkInDataPending.data() + _usbtmcBulkInPendingOffset, toSend, endOfMessage, false)) {
-        _usbtmcBulkInDataPending.clear();
-        _usbtmcBulkInPendingOffset = 0;
+    if (toSend == 0) {
+        return true; // Never stall, always return true as per USBTMC spec
+    }
 
+    // TinyUSB keeps a pointer to the data until the transfer completes, so the
+    // bytes are only consumed in _usbtmcMsgBulkInComplete()
+    if (!tud_usbtmc_transmit_dev_msg_data(data, toSend, endOfMessage, false)) {
+        LOGE("USBTMC: cannot start a bulk IN transfer of %lu bytes\n", (unsigned long)toSend);
         return true; // Failed to send data
     }
 
+    _usbtmcBulkInInFlight = toSend;
+
+    _count(_usbtmcCounters.bytesOut, static_cast<uint32_t>(toSend));
+
     if (endOfMessage) {
-        _usbtmcBulkInDataPending.clear();
-        _usbtmcBulkInPendingOffset = 0;
-    } else {
-        _usbtmcBulkInPendingOffset += toSend;
+        _count(_usbtmcCounters.messagesOut);
+        T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::FirstResponse);
     }
 
     return true; // Never stall, always return true as per USBTMC spec
@@ -497,13 +1843,12 @@ bool Interface::_usbtmcInitiateClear(uint8_t *tmcResult) {
     // Initiate USBTMC clear operation
     *tmcResult = USBTMC_STATUS_SUCCESS;
 
-    _usbtmcBulkInDataQueue.clear(); // Clear the bulk IN data queue
-    _usbtmcBulkInDataPending.clear();
-    _usbtmcBulkInPendingOffset = 0;
+    _discardUSBTMCBulkInData(); // Discard any queued responses
+    _releaseUSBTMCBulkInSpace(0);
 
     _delegate._onUSBTMCClear(); // Notify the delegate about the clear operation
 
-    tud_usbtmc_start_bus_read(); // Start reading from the USBTMC bus
+    _startUSBTMCBulkOut();
 
     return true;
 }
@@ -522,9 +1867,8 @@ bool Interface::_usbtmcInitiateAbortBulkIn(uint8_t *tmcResult) {
 
     *tmcResult = USBTMC_STATUS_SUCCESS;
 
-    _usbtmcBulkInDataQueue.clear();
-    _usbtmcBulkInDataPending.clear();
-    _usbtmcBulkInPendingOffset = 0;
+    _discardUSBTMCBulkInData(); // Discard any queued responses
+    _releaseUSBTMCBulkInSpace(0);
 
     _delegate._onUSBTMCAbortBulkIn(); // Notify the delegate about the abort
 
@@ -534,7 +1878,7 @@ bool Interface::_usbtmcInitiateAbortBulkIn(uint8_t *tmcResult) {
 bool Interface::_usbtmcCheckAbortBulkIn(usbtmc_check_abort_bulk_rsp_t *rsp) {
     // Check USBTMC abort bulk IN status
 
-    tud_usbtmc_start_bus_read(); // Start reading from the USBTMC bus
+    _startUSBTMCBulkOut();
 
     return true;
 }
@@ -551,7 +1895,7 @@ bool Interface::_usbtmcInitiateAbortBulkOut(uint8_t *tmcResult) {
 
 bool Interface::_usbtmcCheckAbortBulkOut(usbtmc_check_abort_bulk_rsp_t *rsp) {
     // Check USBTMC abort bulk OUT status
-    tud_usbtmc_start_bus_read(); // Start reading from the USBTMC bus
+    _startUSBTMCBulkOut();
 
     return true;
 }
@@ -567,13 +1911,13 @@ void Interface::_usbtmcBulkInClearFeature() {
 
 void Interface::_usbtmcBulkOutClearFeature() {
     // Handle USBTMC bulk OUT clear feature
-    tud_usbtmc_start_bus_read(); // Start reading from the USBTMC bus
+    _startUSBTMCBulkOut();
 }
 
 uint8_t Interface::_usbtmcGetStb(uint8_t *tmcResult) {
     // Get USBTMC status byte (STB)
-    *tmcResult = USBTMC_STATUS_SUCCESS; 
-    return 0; // Return 0 by default. 
+    *tmcResult = USBTMC_STATUS_SUCCESS;
+    return _delegate._onUSBTMCReadStatusByte();
 }
 
 bool Interface::_usbtmcIndicatorPulse(tusb_control_request_t const * msg, uint8_t *tmcResult) {
@@ -1,14 +1,41 @@
 # Configurable options for the USB interface library
 
-set(T76_IC_USB_INTERFACE_BULK_IN_QUEUE_SIZE 8 CACHE STRING "Size of the bulk IN queue for USB interface (number of messages)")
+set(T76_IC_USB_INTERFACE_BULK_IN_BUFFER_SIZE 2048 CACHE STRING "Size of the USBTMC bulk IN ring (in bytes, power of two)")
+set(T76_IC_USB_INTERFACE_BULK_IN_QUEUE_SIZE 16 CACHE STRING "Maximum number of responses waiting in the USBTMC bulk IN ring")
+set(T76_IC_USB_INTERFACE_BULK_IN_SEND_TIMEOUT_MS 1000 CACHE STRING "How long USBTMC sends wait for room in the bulk IN ring (in ms)")
+option(T76_IC_USB_INTERFACE_BULK_IN_DROP_WHEN_FULL "Drop USBTMC responses that do not fit in the bulk IN ring instead of blocking" OFF)
+option(T76_IC_USB_INTERFACE_BULK_IN_COALESCE "Coalesce USBTMC responses into fewer bulk IN messages by default" OFF)
+set(T76_IC_USB_INTERFACE_BULK_IN_COALESCE_WINDOW_US 0 CACHE STRING "Window after which coalesced USBTMC responses are flushed (in us, 0 to group per input message)")
+set(T76_IC_USB_INTERFACE_BULK_IN_COALESCE_MAX_SIZE 512 CACHE STRING "Maximum size of a group of coalesced USBTMC responses (in bytes)")
 set(T76_IC_USB_RUNTIME_TASK_STACK_SIZE 1024 CACHE STRING "Stack size for the USB runtime task (in words)")
 set(T76_IC_USB_RUNTIME_TASK_PRIORITY 1 CACHE STRING "Priority for the USB runtime task")
+set(T76_IC_USB_RUNTIME_TASK_CORE_AFFINITY 0x1 CACHE STRING "Mask of the cores the USB runtime task may run on with T76_IC_SMP (bit 0 for core 0, bit 1 for core 1)")
 
 set(T76_IC_USB_DISPATCH_TASK_STACK_SIZE 1024 CACHE STRING "Stack size for the USB dispatch task (in words)")
 set(T76_IC_USB_DISPATCH_TASK_PRIORITY 1 CACHE STRING "Priority for the USB dispatch task")
-set(T76_IC_USB_TASK_DELAY_MS 1 CACHE STRING "Delay (in ms) for the USB task loop when idle")
+set(T76_IC_USB_DISPATCH_TASK_CORE_AFFINITY 0x3 CACHE STRING "Mask of the cores the USB dispatch task may run on with T76_IC_SMP")
+option(T76_IC_USB_DISPATCH_COMPLETION_TASK "Handle USB transfer completions and outgoing bulk data on a dedicated task" ON)
+set(T76_IC_USB_COMPLETION_TASK_STACK_SIZE 1024 CACHE STRING "Stack size for the USB completion task (in words)")
+set(T76_IC_USB_COMPLETION_TASK_PRIORITY 2 CACHE STRING "Priority for the USB completion task")
+set(T76_IC_USB_COMPLETION_TASK_CORE_AFFINITY 0x1 CACHE STRING "Mask of the cores the USB completion task may run on with T76_IC_SMP; keep it on the runtime task's core, as both call into TinyUSB")
+set(T76_IC_USB_DISPATCH_QUEUE_SIZE 10 CACHE STRING "Number of preallocated dispatch items for data and events from the USB stack")
+set(T76_IC_USB_DISPATCH_SEND_ITEMS 4 CACHE STRING "Number of preallocated dispatch items for outgoing vendor and WinUSB bulk data")
 
-set(T76_IC_USB_INTERFACE_BULK_IN_MAX_MESSAGE_SIZE 255 CACHE STRING "Maximum size of a single USB bulk IN message (in bytes)")
+option(T76_IC_USB_WINUSB_STREAM "Enable zero-copy WinUSB bulk IN streaming from fixed frames filled by core 1 or DMA" OFF)
+set(T76_IC_USB_WINUSB_STREAM_FRAME_SIZE 1024 CACHE STRING "Size of each WinUSB stream frame (in bytes, multiple of 64)")
+set(T76_IC_USB_WINUSB_STREAM_FRAME_COUNT 4 CACHE STRING "Number of WinUSB stream frames")
+
+option(T76_IC_USB_ISO_STREAM "Add an isochronous IN interface that streams one fixed frame per USB frame" OFF)
+set(T76_IC_USB_ISO_STREAM_PACKET_SIZE 512 CACHE STRING "Maximum size of each isochronous packet, reserved on the bus while streaming (in bytes, up to 1023)")
+set(T76_IC_USB_ISO_STREAM_FRAME_COUNT 8 CACHE STRING "Number of isochronous stream frames")
+
+option(T76_IC_USB_CDC_DATA "Add a second CDC port for binary data, separate from the stdio port" OFF)
+set(T76_IC_USB_CDC_DATA_TX_BUFFER_SIZE 4096 CACHE STRING "Size of the data CDC transmit ring (in bytes, power of two)")
+set(T76_IC_USB_CDC_DATA_RX_BUFFER_SIZE 2048 CACHE STRING "Size of the data CDC receive ring (in bytes, power of two)")
+
+option(T76_IC_USB_TRIGGER "Deliver USBTMC TRIGGER messages to an action on core 1 through a doorbell, and measure their latency" OFF)
+
+option(T76_IC_USB_STATS "Count USB traffic per class, track queue high-water marks and build a dispatch latency histogram" OFF)
 
 set(T76_IC_USB_URL "t76.org" CACHE STRING "URL string for the USB WebUSB descriptor")
 set(T76_IC_USB_VENDOR_ID "0x2E8A" CACHE STRING "USB Vendor ID")
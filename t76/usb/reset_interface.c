@@ -29,16 +29,31 @@ static uint8_t winusb_ep_in_address;
 static CFG_TUD_MEM_ALIGN uint8_t winusb_ep_out_buffer[CFG_TUD_VENDOR_EPSIZE];
 static CFG_TUD_MEM_ALIGN uint8_t winusb_ep_in_buffer[CFG_TUD_VENDOR_TX_BUFSIZE];
 
+#ifdef T76_IC_USB_ISO_STREAM
+uint8_t iso_stream_interface_number;
+
+static tusb_desc_endpoint_t const *iso_stream_ep_desc;  // In the configuration descriptor, opened on alternate setting 1
+static uint8_t iso_stream_ep_in_address;                // Non-zero while the endpoint is open
+static uint8_t iso_stream_alternate_setting;
+
+static CFG_TUD_MEM_ALIGN uint8_t iso_stream_zlp_buffer[4];
+#endif
+
 // Support for Microsoft OS 2.0 descriptor
 #define BOS_TOTAL_LEN      (TUD_BOS_DESC_LEN + TUD_BOS_WEBUSB_DESC_LEN + TUD_BOS_MICROSOFT_OS_DESC_LEN)
 
+#ifdef T76_IC_USB_ISO_STREAM
+#define MS_OS_20_DESC_LEN            634
+#else
 #define MS_OS_20_DESC_LEN            478
+#endif
 #define MS_OS_20_FUNCTION_DESC_LEN   156
 #define MS_OS_20_VENDOR_PROPERTY_LEN 128
 
 #define RESET_INTERFACE_GUID "{bc7398c1-73cd-4cb7-98b8-913a8fca7bf6}"
 #define VENDOR_INTERFACE_GUID "{06b63d79-4f6b-4d9c-9918-32b9c1d6f7b2}"
 #define WINUSB_INTERFACE_GUID "{e6a8e15c-d6be-4a1d-8c25-2a8973d8cb5f}"
+#define ISO_STREAM_INTERFACE_GUID "{5b0e2f47-9c3a-4d61-a8f2-71c4e0b93d58}"
 
 #define MS_OS_20_FUNCTION_SUBSET(_itfnum, _guid_literal) \
     /* Function subset header */ \
@@ -86,7 +101,10 @@ const uint8_t desc_ms_os_20[] = {
     U16_TO_U8S_LE(0x000A), U16_TO_U8S_LE(MS_OS_20_SET_HEADER_DESCRIPTOR), U32_TO_U8S_LE(0x06030000), U16_TO_U8S_LE(MS_OS_20_DESC_LEN),
     MS_OS_20_FUNCTION_SUBSET(ITF_NUM_RESET, RESET_INTERFACE_GUID),
     MS_OS_20_FUNCTION_SUBSET(ITF_NUM_VENDOR, VENDOR_INTERFACE_GUID),
-    MS_OS_20_FUNCTION_SUBSET(ITF_NUM_WINUSB, WINUSB_INTERFACE_GUID)
+    MS_OS_20_FUNCTION_SUBSET(ITF_NUM_WINUSB, WINUSB_INTERFACE_GUID),
+#ifdef T76_IC_USB_ISO_STREAM
+    MS_OS_20_FUNCTION_SUBSET(ITF_NUM_ISO_STREAM, ISO_STREAM_INTERFACE_GUID),
+#endif
 };
 
 TU_VERIFY_STATIC(sizeof(desc_ms_os_20) == MS_OS_20_DESC_LEN, "Incorrect size");
@@ -106,6 +124,17 @@ static void resetd_reset(uint8_t __unused rhport) {
     winusb_interface_number = 0;
     winusb_ep_out_address = 0;
     winusb_ep_in_address = 0;
+
+#ifdef T76_IC_USB_ISO_STREAM
+    if (iso_stream_ep_in_address != 0) {
+        t76_iso_stream_stopped_cb();
+    }
+
+    iso_stream_interface_number = 0;
+    iso_stream_ep_desc = NULL;
+    iso_stream_ep_in_address = 0;
+    iso_stream_alternate_setting = 0;
+#endif
 }
 
 static uint16_t resetd_open(uint8_t rhport, tusb_desc_interface_t const *itf_desc, uint16_t max_len) {
@@ -155,9 +184,88 @@ static uint16_t resetd_open(uint8_t rhport, tusb_desc_interface_t const *itf_des
         return (uint16_t) ((uintptr_t) p_desc - (uintptr_t) itf_desc);
     }
 
+#ifdef T76_IC_USB_ISO_STREAM
+    if (itf_desc->bInterfaceSubClass == ISO_STREAM_INTERFACE_SUBCLASS &&
+        itf_desc->bInterfaceProtocol == ISO_STREAM_INTERFACE_PROTOCOL) {
+        TU_VERIFY(itf_desc->bAlternateSetting == 0 && itf_desc->bNumEndpoints == 0, 0);
+
+        const uint8_t* p_desc = tu_desc_next(itf_desc);
+        const uint8_t* desc_end = ((uint8_t const*) itf_desc) + max_len;
+
+        // Alternate setting 1 holds the endpoint, which is only opened when the host selects it
+        TU_VERIFY(p_desc < desc_end && tu_desc_type(p_desc) == TUSB_DESC_INTERFACE, 0);
+
+        tusb_desc_interface_t const *alt_desc = (tusb_desc_interface_t const *) p_desc;
+        TU_VERIFY(alt_desc->bInterfaceNumber == itf_desc->bInterfaceNumber && alt_desc->bAlternateSetting == 1 && alt_desc->bNumEndpoints == 1, 0);
+
+        p_desc = tu_desc_next(p_desc);
+        TU_VERIFY(p_desc < desc_end && tu_desc_type(p_desc) == TUSB_DESC_ENDPOINT, 0);
+
+        tusb_desc_endpoint_t const *desc_ep = (tusb_desc_endpoint_t const *) p_desc;
+        TU_VERIFY(desc_ep->bmAttributes.xfer == TUSB_XFER_ISOCHRONOUS && tu_edpt_dir(desc_ep->bEndpointAddress) == TUSB_DIR_IN, 0);
+
+#ifdef TUP_DCD_EDPT_ISO_ALLOC
+        // Reserve the endpoint's buffer now; it is activated with the alternate setting
+        TU_ASSERT(usbd_edpt_iso_alloc(rhport, desc_ep->bEndpointAddress, tu_edpt_packet_size(desc_ep)), 0);
+#endif
+
+        iso_stream_interface_number = itf_desc->bInterfaceNumber;
+        iso_stream_ep_desc = desc_ep;
+        iso_stream_ep_in_address = 0;
+        iso_stream_alternate_setting = 0;
+
+        p_desc = tu_desc_next(p_desc);
+        return (uint16_t) ((uintptr_t) p_desc - (uintptr_t) itf_desc);
+    }
+#endif
+
     return 0;
 }
 
+#ifdef T76_IC_USB_ISO_STREAM
+static bool iso_stream_set_alternate_setting(uint8_t rhport, uint8_t alternate_setting) {
+    if (iso_stream_ep_in_address != 0) {
+        t76_iso_stream_stopped_cb();
+        usbd_edpt_close(rhport, iso_stream_ep_in_address);
+        iso_stream_ep_in_address = 0;
+    }
+
+    if (alternate_setting == 1) {
+#ifdef TUP_DCD_EDPT_ISO_ALLOC
+        TU_ASSERT(usbd_edpt_iso_activate(rhport, iso_stream_ep_desc));
+#else
+        TU_ASSERT(usbd_edpt_open(rhport, iso_stream_ep_desc));
+#endif
+
+        iso_stream_ep_in_address = iso_stream_ep_desc->bEndpointAddress;
+        t76_iso_stream_started_cb();
+    }
+
+    iso_stream_alternate_setting = alternate_setting;
+    return true;
+}
+
+// Standard requests to the isochronous interface select and report its alternate setting
+static bool iso_stream_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request) {
+    switch (request->bRequest) {
+        case TUSB_REQ_SET_INTERFACE:
+            if (stage != CONTROL_STAGE_SETUP) return true;
+
+            TU_VERIFY(request->wValue <= 1);
+            TU_VERIFY(iso_stream_set_alternate_setting(rhport, (uint8_t) request->wValue));
+            return tud_control_status(rhport, request);
+
+        case TUSB_REQ_GET_INTERFACE:
+            if (stage != CONTROL_STAGE_SETUP) return true;
+
+            return tud_control_xfer(rhport, request, &iso_stream_alternate_setting, 1);
+
+        default:
+            return false;
+    }
+}
+#endif
+
 // Support for parameterized reset via vendor interface control request
 static bool resetd_control_xfer_cb(uint8_t __unused rhport, uint8_t stage, tusb_control_request_t const * request) {
     if (request->wIndex == reset_interface_number) {
@@ -184,6 +292,13 @@ static bool resetd_control_xfer_cb(uint8_t __unused rhport, uint8_t stage, tusb_
         return t76_winusb_control_xfer_cb(rhport, stage, request);
     }
 
+#ifdef T76_IC_USB_ISO_STREAM
+    if (iso_stream_ep_desc != NULL && request->wIndex == iso_stream_interface_number &&
+        request->bmRequestType_bit.type == TUSB_REQ_TYPE_STANDARD) {
+        return iso_stream_control_xfer_cb(rhport, stage, request);
+    }
+#endif
+
     return false;
 }
 
@@ -201,6 +316,14 @@ static bool resetd_xfer_cb(uint8_t __unused rhport, uint8_t __unused ep_addr, xf
         return true;
     }
 
+#ifdef T76_IC_USB_ISO_STREAM
+    if (iso_stream_ep_in_address != 0 && ep_addr == iso_stream_ep_in_address) {
+        // Queues the next packet right away, since the endpoint must have one for every frame
+        t76_iso_stream_in_complete_cb(xferred_bytes);
+        return true;
+    }
+#endif
+
     return true;
 }
 
@@ -228,9 +351,25 @@ bool t76_winusb_bulk_in_xfer(uint8_t const* buffer, uint16_t bufsize) {
     return usbd_edpt_xfer(0, winusb_ep_in_address, winusb_ep_in_buffer, bufsize);
 }
 
+bool t76_winusb_bulk_in_xfer_direct(uint8_t const* buffer, uint16_t bufsize) {
+    TU_VERIFY(winusb_ep_in_address != 0, false);
+    TU_VERIFY(!usbd_edpt_busy(0, winusb_ep_in_address), false);
+
+    return usbd_edpt_xfer(0, winusb_ep_in_address, (uint8_t*) buffer, bufsize);
+}
+
 bool t76_winusb_bulk_in_zlp(void) {
     TU_VERIFY(winusb_ep_in_address != 0, false);
     TU_VERIFY(!usbd_edpt_busy(0, winusb_ep_in_address), false);
 
     return usbd_edpt_xfer(0, winusb_ep_in_address, winusb_ep_in_buffer, 0);
 }
+
+#ifdef T76_IC_USB_ISO_STREAM
+bool t76_iso_stream_in_xfer(uint8_t const* buffer, uint16_t bufsize) {
+    TU_VERIFY(iso_stream_ep_in_address != 0, false);
+    TU_VERIFY(!usbd_edpt_busy(0, iso_stream_ep_in_address), false);
+
+    return usbd_edpt_xfer(0, iso_stream_ep_in_address, bufsize > 0 ? (uint8_t*) buffer : iso_stream_zlp_buffer, bufsize);
+}
+#endif
@@ -8,8 +8,9 @@
  * 
  * The runtime exposes four interfaces:
  * 
- * - A CDC interface for serial communication. This is co-opted by stdio so
- *   that printf and other stdio functions can be dumped directly to USB.
+ * - A CDC interface for serial communication. The runtime installs a stdio
+ *   driver on it, so that printf and other stdio functions can be dumped
+ *   directly to USB.
  * - An interface that's compatible with picotool's reset mechanism.
  *   This allows you to reset the device and enter bootloader mode,
  *   _provided_ that you set the USB properties correctly at compile time.
@@ -21,6 +22,10 @@
  *   measurement devices.
  * - A WinUSB-compatible vendor interface that exposes dedicated bulk endpoints
  *   for Windows-native frontend access.
+ * - Optionally, a second CDC interface for binary data, separate from the
+ *   stdio port; see `writeCDCData()`.
+ * - Optionally, a vendor interface with an isochronous IN endpoint, for
+ *   streams that need bandwidth reserved on the bus; see `acquireIsoStreamFrame()`.
  * 
  * The runtime is multithreaded and fully reentrant, allowing you to
  * send and receive data from multiple threads without blocking. It uses
@@ -49,14 +54,23 @@
  * - `_onVendorDataReceived`: called when bulk data is received from the vendor 
  *   interface.
  * - `_onUSBTMCDataReceived`: called when bulk data is received from the USBTMC 
- *   interface. Remember that USBTMC transfers can be fragmented, so you may need to
- *   accumulate data until the transfer is complete. The speed USBTMC replies
+ *   interface. Messages of any length are streamed to this callback one packet
+ *   at a time, with `transfer_complete` set on the last chunk, so process data
+ *   incrementally rather than accumulating the whole transfer. The speed USBTMC replies
  *   can be processed asynchronously, but you must be cognizant of the fact that
  *   USBTMC generally requires a specific response format and timing. Also,
  *   the runtime doesn't provide any mechanism for ensuring that a request is
  *   completely processed before the next request is handled, so you must
  *   ensure that your implementation can handle this.
  *
+ * Each receive callback also has a non-owning counterpart that takes a
+ * pointer and length (`_onVendorBytesReceived`, `_onVendorControlTransferOutBytes`,
+ * `_onWinUSBControlTransferOutBytes`, `_onUSBTMCBytesReceived` and
+ * `_onWinUSBBulkBytesReceived`). The interface always calls these; by default
+ * they copy the data into a vector and forward it to the callbacks above, so
+ * override them instead to process received data without allocating. The
+ * data is only valid for the duration of the call.
+ *
  * If you choose to subclass `Interface` itself, you can change the USBTMC
  * capabilities by initializing the `_usbtmcStoredCapabilities` member in your
  * subclass constructor.
@@ -91,32 +105,55 @@
  * - `T76_IC_USB_DISPATCH_TASK_STACK_SIZE`: The stack size for the USB dispatch task. Like the
  *   runtime task stack size, this should be large enough to handle the dispatch task's
  *   requirements.
- * - `T76_IC_USB_INTERFACE_BULK_IN_QUEUE_SIZE`: The size of the USB interface bulk IN queue. This
- *   should be large enough to handle the maximum expected number of bulk IN transfers.
- * - `T76_IC_USB_INTERFACE_BULK_IN_MAX_MESSAGE_SIZE`: The maximum message size for USB interface
- *   bulk IN transfers. This should be large enough to handle the maximum expected
- *   size of bulk IN messages.
+ * - `T76_IC_USB_DISPATCH_COMPLETION_TASK`: When defined, transfer completions and outgoing
+ *   bulk data are handled by a dedicated task, separate from the dispatch task that runs
+ *   receive handlers. Its priority and stack size are set with
+ *   `T76_IC_USB_COMPLETION_TASK_PRIORITY` and `T76_IC_USB_COMPLETION_TASK_STACK_SIZE`.
+ * - `T76_IC_USB_INTERFACE_BULK_IN_BUFFER_SIZE`: The size, in bytes, of the USBTMC bulk IN ring
+ *   that holds responses until the host reads them. Must be a power of two.
+ * - `T76_IC_USB_INTERFACE_BULK_IN_QUEUE_SIZE`: The maximum number of USBTMC responses that
+ *   can be waiting in the bulk IN ring at the same time.
+ * - `T76_IC_USB_INTERFACE_BULK_IN_COALESCE`: When defined, USBTMC responses are coalesced
+ *   by default; see `setUSBTMCBulkInCoalescing()`. The grouping window and maximum size
+ *   are set with `T76_IC_USB_INTERFACE_BULK_IN_COALESCE_WINDOW_US` and
+ *   `T76_IC_USB_INTERFACE_BULK_IN_COALESCE_MAX_SIZE`.
+ * - `T76_IC_USB_CDC_DATA`: When defined, the device exposes a second CDC port for
+ *   binary data. Its transmit and receive rings are sized with
+ *   `T76_IC_USB_CDC_DATA_TX_BUFFER_SIZE` and `T76_IC_USB_CDC_DATA_RX_BUFFER_SIZE`,
+ *   both powers of two.
+ * - `T76_IC_USB_ISO_STREAM`: When defined, the device exposes an isochronous
+ *   IN interface that sends one packet of `T76_IC_USB_ISO_STREAM_PACKET_SIZE`
+ *   bytes per USB frame from a ring of `T76_IC_USB_ISO_STREAM_FRAME_COUNT`
+ *   frames.
+ * - `T76_IC_USB_TRIGGER`: When defined, USBTMC TRIGGER messages are timestamped
+ *   in the USB callback and delivered to an action on core 1 through a SIO
+ *   doorbell, without going through the SCPI parser; see `fireTrigger()`.
  */
 
 #pragma once
 
 
+#include <algorithm>
 #include <memory>
 #include <atomic>
 #include <deque>
 #include <queue>
 #include <stdint.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <FreeRTOS.h>
 #include <task.h>
 #include <queue.h>
 #include <semphr.h>
+#include <timers.h>
 
-#include <t76/fixed_queue.hpp>
+#include <t76/message_ring.hpp>
 #include "callbacks.hpp"
 
+#define T76_IC_USB_STATS_LATENCY_BUCKETS 10     ///< Number of dispatch latency histogram buckets (16 us to >4 ms)
+
 namespace T76::Core::USB {
 
     class Interface;
@@ -208,6 +245,11 @@ namespace T76::Core::USB {
          * This method is called when bulk data is received from the USB host on the USBTMC interface.
          * You can implement this method in a subclass to handle the received data.
          * 
+         * Bulk OUT messages have no size limit: each packet is delivered as
+         * soon as it arrives, and `transfer_complete` is set on the last
+         * chunk of the message. Process the data incrementally rather than
+         * buffering the whole message.
+         * 
          */
         virtual void _onUSBTMCDataReceived(const std::vector<uint8_t> &data, bool transfer_complete) = 0;
 
@@ -250,12 +292,108 @@ namespace T76::Core::USB {
         /**
          * @brief WinUSB bulk IN transfer completion callback.
          *
-         * Called when a WinUSB bulk IN transfer completes.
+         * Called when a WinUSB bulk IN transfer completes. This runs on the
+         * USB completion lane, so keep it short to avoid delaying other
+         * transfers.
          *
          * @param xferred_bytes Number of bytes transferred to the host.
          */
         virtual void _onWinUSBBulkInComplete(uint32_t xferred_bytes) { }
 
+        /**
+         * @brief USBTMC bulk IN space available callback.
+         *
+         * Called from the USB runtime task when a bulk IN transfer completes
+         * and frees space in the USBTMC response ring after a call to
+         * `sendUSBTMCBulkData()` was refused because the ring was full. Use
+         * it to resume sending responses without polling.
+         */
+        virtual void _onUSBTMCBulkInSpaceAvailable() { }
+
+        /**
+         * @brief USBTMC read status byte callback.
+         *
+         * Called from the USB runtime task when the host reads the status
+         * byte with a USB488 `READ_STATUS_BYTE` request, for example during
+         * a serial poll. Keep it short; applications that run an
+         * `SCPITask` return its cached `statusByte()`.
+         *
+         * @return The IEEE 488.2 status byte.
+         */
+        virtual uint8_t _onUSBTMCReadStatusByte() { return 0; }
+
+        /**
+         * @brief Vendor bulk data received callback, non-owning version.
+         *
+         * Called from the USB dispatch task. The default implementation forwards
+         * a copy of the data to `_onVendorDataReceived()`.
+         *
+         * @param data The data received from the USB host, valid only during the call.
+         * @param length The number of bytes received.
+         */
+        virtual void _onVendorBytesReceived(const uint8_t *data, size_t length) {
+            _onVendorDataReceived(std::vector<uint8_t>(data, data + length));
+        }
+
+        /**
+         * @brief Vendor control transfer OUT callback, non-owning version.
+         *
+         * The default implementation forwards a copy of the data to
+         * `_onVendorControlTransferOut()`.
+         *
+         * @param request The control request that was received.
+         * @param value The value associated with the control request.
+         * @param data The data received in the control transfer, valid only during the call.
+         * @param length The number of bytes received.
+         * @return true if the control transfer was successfully handled, false otherwise.
+         */
+        virtual bool _onVendorControlTransferOutBytes(uint8_t request, uint16_t value, const uint8_t *data, size_t length) {
+            return _onVendorControlTransferOut(request, value, std::vector<uint8_t>(data, data + length));
+        }
+
+        /**
+         * @brief WinUSB control transfer OUT callback, non-owning version.
+         *
+         * The default implementation forwards a copy of the data to
+         * `_onWinUSBControlTransferOut()`.
+         *
+         * @param request The control request code from the host.
+         * @param value The request value field.
+         * @param data The control transfer payload, valid only during the call.
+         * @param length The number of bytes received.
+         * @return true if the request was handled, false otherwise.
+         */
+        virtual bool _onWinUSBControlTransferOutBytes(uint8_t request, uint16_t value, const uint8_t *data, size_t length) {
+            return _onWinUSBControlTransferOut(request, value, std::vector<uint8_t>(data, data + length));
+        }
+
+        /**
+         * @brief USBTMC data received callback, non-owning version.
+         *
+         * The data points straight into TinyUSB's endpoint buffer. The default
+         * implementation forwards a copy of the data to `_onUSBTMCDataReceived()`.
+         *
+         * @param data The data received from the USB host, valid only during the call.
+         * @param length The number of bytes received.
+         * @param transfer_complete Indicates whether the transfer is complete.
+         */
+        virtual void _onUSBTMCBytesReceived(const uint8_t *data, size_t length, bool transfer_complete) {
+            _onUSBTMCDataReceived(std::vector<uint8_t>(data, data + length), transfer_complete);
+        }
+
+        /**
+         * @brief WinUSB bulk data received callback, non-owning version.
+         *
+         * Called from the USB dispatch task. The default implementation forwards
+         * a copy of the data to `_onWinUSBBulkDataReceived()`.
+         *
+         * @param data The raw USB packet payload, valid only during the call.
+         * @param length The number of bytes received.
+         */
+        virtual void _onWinUSBBulkBytesReceived(const uint8_t *data, size_t length) {
+            _onWinUSBBulkDataReceived(std::vector<uint8_t>(data, data + length));
+        }
+
     };
 
     /**
@@ -283,8 +421,9 @@ namespace T76::Core::USB {
      * - `_onVendorDataReceived`: called when bulk data is received from the vendor 
      *   interface.
      * - `_onUSBTMCDataReceived`: called when bulk data is received from the USBTMC 
-     *   interface. Remember that USBTMC transfers can be fragmented, so you may need to
-     *   accumulate data until the transfer is complete. The speed USBTMC replies
+     *   interface. Messages of any length are streamed to this callback one packet
+     *   at a time, with `transfer_complete` set on the last chunk, so process data
+     *   incrementally rather than accumulating the whole transfer. The speed USBTMC replies
      *   can be processed asynchronously, but you must be cognizant of the fact that
      *   USBTMC generally requires a specific response format and timing. Also,
      *   the runtime doesn't provide any mechanism for ensuring that a request is
@@ -311,7 +450,10 @@ namespace T76::Core::USB {
         /**
          * @brief Initialize the USB interface. 
          * 
-         * This method should be called before using the class.
+         * This method should be called before using the class. It starts
+         * the USB controller, so the device attaches to the bus at once;
+         * the host's requests are handled once the scheduler runs the
+         * runtime task.
          * 
          * You can oveerride this method to perform additional initialization, but 
          * you must call the base class implementation to ensure that the USB 
@@ -363,26 +505,449 @@ namespace T76::Core::USB {
          */
         void sendWinUSBBulkData(const std::vector<uint8_t> &data);
 
+#ifdef T76_IC_USB_WINUSB_STREAM
+        /**
+         * @brief Statistics for the WinUSB streaming mode.
+         */
+        struct WinUSBStreamStats {
+            uint32_t framesSent;        ///< Number of stream frames sent to the host
+            uint64_t bytesSent;         ///< Number of stream bytes sent to the host
+            uint32_t overruns;          ///< Number of times the producer found no free frame
+            uint32_t bytesPerSecond;    ///< Sustained throughput over the last full second
+        };
+
+        /**
+         * @brief Size of each WinUSB stream frame, in bytes.
+         */
+        static constexpr size_t winUSBStreamFrameSize = T76_IC_USB_WINUSB_STREAM_FRAME_SIZE;
+
+        /**
+         * @brief Get the next free WinUSB stream frame for the producer to fill.
+         *
+         * The stream is a ring of T76_IC_USB_WINUSB_STREAM_FRAME_COUNT fixed
+         * frames of `winUSBStreamFrameSize` bytes. The producer, typically
+         * code running on core 1 or a DMA channel it programs, fills the frame
+         * in place and publishes it with `commitWinUSBStreamFrame()`; the USB
+         * side then sends it straight from the frame, without copying, over
+         * the WinUSB bulk IN endpoint. Queued `sendWinUSBBulkData()` frames
+         * take precedence over stream frames.
+         *
+         * There must be a single producer. This method is lock-free, placed in
+         * SRAM, and can be called from either core, including from interrupt
+         * handlers.
+         *
+         * @return Pointer to the frame, or nullptr if every frame is waiting to
+         *         be sent. In that case, the overrun counter is incremented.
+         */
+        uint8_t *acquireWinUSBStreamFrame();
+
+        /**
+         * @brief Publish the frame returned by `acquireWinUSBStreamFrame()`.
+         *
+         * @param length Number of valid bytes in the frame. Hosts should read in
+         *               multiples of the frame size, since no zero-length packet
+         *               follows a frame that is a multiple of the packet size.
+         * @return true if the frame was queued for sending, false otherwise.
+         */
+        bool commitWinUSBStreamFrame(size_t length);
+
+        /**
+         * @brief Get the WinUSB streaming statistics.
+         *
+         * @return A snapshot of the stream counters.
+         */
+        WinUSBStreamStats winUSBStreamStats() const;
+#endif
+
+#ifdef T76_IC_USB_ISO_STREAM
+        /**
+         * @brief Statistics for the isochronous stream.
+         */
+        struct IsoStreamStats {
+            bool active;                ///< Whether the host has selected the streaming alternate setting
+            uint32_t framesSent;        ///< Number of stream frames sent to the host
+            uint64_t bytesSent;         ///< Number of stream bytes sent to the host
+            uint32_t overruns;          ///< Number of times the producer found no free frame
+            uint32_t underruns;         ///< USB frames that carried a zero-length packet because no stream frame was published
+            uint32_t missedFrames;      ///< USB frames that carried nothing because the USB side was too late to queue a packet
+        };
+
+        /**
+         * @brief Size of each isochronous stream frame, in bytes.
+         *
+         * Each frame is sent as the single packet of one USB frame, so this is
+         * also the bandwidth reserved on the bus, in bytes per millisecond.
+         */
+        static constexpr size_t isoStreamFrameSize = T76_IC_USB_ISO_STREAM_PACKET_SIZE;
+
+        /**
+         * @brief Get the next free isochronous stream frame for the producer to fill.
+         *
+         * Works like `acquireWinUSBStreamFrame()`, over a separate ring of
+         * T76_IC_USB_ISO_STREAM_FRAME_COUNT frames of `isoStreamFrameSize`
+         * bytes. While the host has selected the streaming alternate setting
+         * of the isochronous interface, the USB side sends the oldest
+         * published frame, without copying it, in every USB frame; when none
+         * is published, it sends a zero-length packet and counts an underrun.
+         *
+         * There must be a single producer. This method is lock-free, placed in
+         * SRAM, and can be called from either core, including from interrupt
+         * handlers.
+         *
+         * @return Pointer to the frame, or nullptr if every frame is waiting to
+         *         be sent. In that case, the overrun counter is incremented.
+         */
+        uint8_t *acquireIsoStreamFrame();
+
+        /**
+         * @brief Publish the frame returned by `acquireIsoStreamFrame()`.
+         *
+         * @param length Number of valid bytes in the frame, which is the size
+         *               of the packet the host receives for it.
+         * @return true if the frame was queued for sending, false otherwise.
+         */
+        bool commitIsoStreamFrame(size_t length);
+
+        /**
+         * @brief Get the isochronous streaming statistics.
+         *
+         * @return A snapshot of the stream counters.
+         */
+        IsoStreamStats isoStreamStats() const;
+#endif
+
+#ifdef T76_IC_USB_CDC_DATA
+        /**
+         * @brief Queue a block of data for the data CDC port.
+         *
+         * The data CDC port is a second serial port, separate from the one
+         * stdio writes to, for binary data that should not be mixed with log
+         * output. The block is copied into a ring of
+         * T76_IC_USB_CDC_DATA_TX_BUFFER_SIZE bytes and sent in the background:
+         * every completed transfer pulls the next data from the ring, so a
+         * stream of writes keeps the endpoint busy without the caller having
+         * to flush it.
+         *
+         * A block is queued whole or not at all. If the ring is full, the call
+         * waits up to `timeout` for the host to read enough of it; calls made
+         * from the USB runtime task never wait.
+         *
+         * @param data Bytes to send.
+         * @param length Number of bytes, at most T76_IC_USB_CDC_DATA_TX_BUFFER_SIZE.
+         * @param timeout Maximum time to wait for room in the ring, in ticks.
+         * @return true if the block was queued, false if the host has not opened
+         *         the port or the block did not fit in time.
+         */
+        bool writeCDCData(const uint8_t *data, size_t length, TickType_t timeout = portMAX_DELAY);
+
+        /**
+         * @brief Read data received on the data CDC port.
+         *
+         * Waits up to `timeout` for data to arrive, then returns as much as is
+         * buffered, up to `maxLength` bytes. Received data is held in a ring of
+         * T76_IC_USB_CDC_DATA_RX_BUFFER_SIZE bytes; when it is full, the
+         * endpoint is left unarmed, so the host waits instead of losing data.
+         *
+         * There must be a single reader.
+         *
+         * @param buffer Where to store the data.
+         * @param maxLength Size of the buffer.
+         * @param timeout Maximum time to wait for data, in ticks.
+         * @return Number of bytes read, or 0 if no data arrived in time.
+         */
+        size_t readCDCData(uint8_t *buffer, size_t maxLength, TickType_t timeout = portMAX_DELAY);
+
+        /**
+         * @brief Get the number of received bytes waiting to be read from the data CDC port.
+         */
+        size_t cdcDataAvailable() const;
+
+        /**
+         * @brief Check whether the host has opened the data CDC port.
+         */
+        bool cdcDataConnected() const;
+#endif
+
+#ifdef T76_IC_USB_TRIGGER
+        /**
+         * @brief Action run on core 1 when a trigger is delivered.
+         *
+         * @param context The context passed to `attachTriggerAction()`.
+         * @param timestampUs When the trigger was fired, from `time_us_32()`.
+         */
+        using TriggerAction = void (*)(void *context, uint32_t timestampUs);
+
+        /**
+         * @brief Statistics of the trigger channel.
+         *
+         * Latencies run from the moment the trigger is fired, in the USB
+         * callback or in `fireTrigger()`, to the moment its action starts.
+         */
+        struct TriggerStats {
+            uint32_t fired;             ///< Triggers fired by USBTMC TRIGGER messages and fireTrigger()
+            uint32_t delivered;         ///< Triggers whose action ran, or that were taken with pollTrigger()
+            uint32_t missed;            ///< Triggers fired while the previous one was still pending
+            uint32_t lastLatencyUs;     ///< Latency of the last delivered trigger
+            uint32_t minLatencyUs;      ///< Shortest latency, or 0 if no trigger was delivered
+            uint32_t maxLatencyUs;      ///< Longest latency
+            uint32_t meanLatencyUs;     ///< Mean latency of the delivered triggers
+        };
+
+        /**
+         * @brief Run an action whenever a trigger is fired.
+         *
+         * Enables the trigger doorbell interrupt on the calling core, normally
+         * core 1, and runs the action from it, at configMAX_SYSCALL_INTERRUPT_PRIORITY:
+         * the doorbell interrupt is shared with handlers that call FreeRTOS,
+         * so it cannot go higher, but it preempts interrupts at the SDK's
+         * default priority.
+         * The action runs in interrupt context, so it must be short and must
+         * only use interrupt-safe calls; on a core without FreeRTOS, it can
+         * start the acquisition directly.
+         *
+         * @param action The action, or nullptr to stop running one.
+         * @param context Passed to the action.
+         * @return true if the action was attached, false if no doorbell is available.
+         */
+        bool attachTriggerAction(TriggerAction action, void *context);
+
+        /**
+         * @brief Fire a trigger, as a USBTMC TRIGGER message does.
+         *
+         * Call it from the handler of `*TRG` so that both paths share the same
+         * channel. The trigger is timestamped, published, and the doorbell of
+         * the other core is rung, together with an event for cores waiting in
+         * `__wfe()`. If the previous trigger has not been delivered yet, the
+         * trigger is counted as missed.
+         *
+         * This method is lock-free and can be called from either core,
+         * including from interrupt handlers.
+         */
+        void fireTrigger();
+
+        /**
+         * @brief Take the pending trigger without an action.
+         *
+         * For a core 1 loop that waits with `__wfe()` instead of attaching an
+         * action. The latency is recorded when the trigger is taken.
+         *
+         * @param timestampUs Where to store when the trigger was fired.
+         * @return true if a trigger was pending, false otherwise.
+         */
+        bool pollTrigger(uint32_t &timestampUs);
+
+        /**
+         * @brief Get the statistics of the trigger channel.
+         *
+         * @return A snapshot of the counters; each is read atomically, but they
+         *         are not read together.
+         */
+        TriggerStats triggerStats() const;
+
+        /**
+         * @brief Clear the statistics of the trigger channel.
+         */
+        void resetTriggerStats();
+#endif
+
         /**
          * @brief Send USBTMC bulk data to the USB host.
-         * @param data The data to be sent. The function takes ownership of the data
-         *            and will copy it to the USBTMC buffer asynchronously.
+         * @param data The data to be sent. The data is copied into the USBTMC
+         *             bulk IN ring and ends the current response message.
          * 
          * This method is thread-safe and can be called from any thread. The data
-         * transfer operation is queued and processed in the USB dispatch task.
+         * is sent when the host next requests bulk IN data. See
+         * `setUSBTMCBulkInSendTimeout()` for what happens when the ring is full.
+         *
+         * @return true if the data was queued, false otherwise.
          */
-        void sendUSBTMCBulkData(const std::vector<uint8_t> &data);
+        bool sendUSBTMCBulkData(const std::vector<uint8_t> &data);
 
         /**
          * @brief Send USBTMC bulk data to the USB host.
-         * @param data The data to be sent as a string. The function will convert
-         *             the string to a byte array and send it asynchronously.
-         * @param addNewline Whether to add a newline at the end of the data.
+         * @param data Pointer to the data to be sent. The data is copied into the
+         *             USBTMC bulk IN ring.
+         * @param length Number of bytes to send.
+         * @param endOfMessage Whether this data ends the current response message.
+         *                     If false, subsequent data is appended to the same
+         *                     message.
          * 
          * This method is thread-safe and can be called from any thread. The data
-         * transfer operation is queued and processed in the USB dispatch task.
+         * is sent when the host next requests bulk IN data. See
+         * `setUSBTMCBulkInSendTimeout()` for what happens when the ring is full.
+         * Each call is stored in one locked step, but a response built over
+         * several calls with `endOfMessage` false is only kept whole if no
+         * other task sends USBTMC data in between.
+         *
+         * @return true if the data was queued, false otherwise.
+         */
+        bool sendUSBTMCBulkData(const uint8_t *data, size_t length, bool endOfMessage = true);
+
+        /**
+         * @brief Send USBTMC bulk data to the USB host.
+         * @param data The data to be sent as a string. The string is copied
+         *             directly into the USBTMC bulk IN ring.
+         * @param addNewline Whether to add a newline at the end of the data. Adding
+         *                   a newline also ends the current response message;
+         *                   otherwise, subsequent data is appended to it.
+         * 
+         * This method is thread-safe and can be called from any thread. The data
+         * is sent when the host next requests bulk IN data. See
+         * `setUSBTMCBulkInSendTimeout()` for what happens when the ring is full.
+         *
+         * @return true if the data was queued, false otherwise.
+         */
+        bool sendUSBTMCBulkData(const std::string &data, bool addNewline = true);
+
+        /**
+         * @brief Send a complete USBTMC response.
+         * @param response The response, without its terminator. It is copied,
+         *                 followed by a newline, straight into the USBTMC bulk
+         *                 IN ring, and ends the current response message.
+         *
+         * Unlike the `std::string` overload of `sendUSBTMCBulkData()`, this
+         * does not build a temporary string from a literal or a view. The same
+         * rules about room in the ring apply.
+         *
+         * @return true if the response was queued, false otherwise.
+         */
+        bool sendUSBTMCResponse(std::string_view response);
+
+        /**
+         * @brief Response writer for `T76::SCPI::Interpreter::setResponseWriter()`.
+         * @param context Pointer to the Interface.
+         * @param response The response, sent with `sendUSBTMCResponse()`.
+         *
+         * @return true if the response was queued, false otherwise.
+         */
+        static bool usbtmcResponseWriter(void *context, std::string_view response);
+
+        /**
+         * @brief Send USBTMC bulk data written directly into the bulk IN ring.
+         * @param length Number of bytes to send.
+         * @param fill Callback that writes the bytes into the ring, in one or two
+         *             pieces, such as `T76::SCPI::BlockEncoder::fill()`. It runs
+         *             with the ring locked and must not send USBTMC data itself;
+         *             the runtime task cannot serve bulk IN requests until it
+         *             returns, so it should not block for long.
+         * @param context Passed to the callback.
+         * @param endOfMessage Whether this data ends the current response message.
+         *
+         * This avoids building a response in a temporary buffer when its data
+         * has to be converted anyway, such as a binary block of samples. The
+         * same rules about room in the ring apply as for `sendUSBTMCBulkData()`.
+         *
+         * @return true if the data was queued, false otherwise.
+         */
+        bool fillUSBTMCBulkData(size_t length, T76::Core::Utils::MessageFillFunction fill, void *context, bool endOfMessage = true);
+
+        /**
+         * @brief Collect the USBTMC responses sent by the calling task in a buffer.
+         *
+         * While a capture is active, the USBTMC sends made by the task that
+         * started it are appended to `capture` instead of the bulk IN ring,
+         * so that a command handler's response can be returned over another
+         * transport, such as a WinUSB reply frame. Sends from other tasks
+         * are not affected. Pass nullptr to end the capture.
+         *
+         * @param capture The buffer that receives the responses, or nullptr.
+         */
+        void captureUSBTMCBulkData(std::vector<uint8_t> *capture);
+
+        /**
+         * @brief Set how long USBTMC sends wait for room in the response ring.
+         *
+         * When the ring is full, `sendUSBTMCBulkData()` blocks until the host
+         * reads enough data to make room, or until the timeout expires. If the
+         * timeout expires, nothing is written, the call returns false, and the
+         * delegate's `_onUSBTMCBulkInSpaceAvailable()` is called once room is
+         * available, so the send can be retried. A timeout of zero makes sends
+         * non-blocking.
+         *
+         * Sends made from the USB runtime task itself (for example, from
+         * `_onUSBTMCDataReceived()`) never block, since that task is the one
+         * that frees space in the ring.
+         *
+         * The default is `T76_IC_USB_INTERFACE_BULK_IN_SEND_TIMEOUT_MS`.
+         *
+         * @param timeout Maximum time to wait, in ticks.
+         */
+        void setUSBTMCBulkInSendTimeout(TickType_t timeout);
+
+        /**
+         * @brief Select whether USBTMC responses that do not fit are dropped.
+         *
+         * When enabled, `sendUSBTMCBulkData()` never blocks; a response that
+         * does not fit in the ring is discarded whole and counted in
+         * `usbtmcBulkInDroppedCount()`. This is disabled by default unless
+         * `T76_IC_USB_INTERFACE_BULK_IN_DROP_WHEN_FULL` is set.
+         *
+         * @param drop true to drop responses instead of applying backpressure.
+         */
+        void setUSBTMCBulkInDropWhenFull(bool drop);
+
+        /**
+         * @brief Get the number of USBTMC responses dropped because the ring was full.
          */
-        void sendUSBTMCBulkData(std::string data, bool addNewline = true);
+        size_t usbtmcBulkInDroppedCount() const;
+
+        /**
+         * @brief Select whether USBTMC responses are coalesced into fewer bulk IN messages.
+         *
+         * Normally, every response ends its own bulk IN message, so a host
+         * that queues several queries has to issue one `REQUEST_DEV_DEP_MSG_IN`
+         * per response. When coalescing is enabled, complete responses are
+         * appended to an open group instead, and the group is sent to the host
+         * as a single message once it is flushed.
+         *
+         * With a window of zero, a group holds the responses produced while
+         * handling one input message and is flushed when that message has been
+         * fully received. With a non-zero window, a group is flushed once the
+         * window has elapsed since its first response, so responses to several
+         * input messages can be merged.
+         *
+         * In both cases, a group is also flushed when it reaches
+         * `T76_IC_USB_INTERFACE_BULK_IN_COALESCE_MAX_SIZE` bytes, when the
+         * host requests data and nothing else is queued, and when
+         * `flushUSBTMCBulkData()` is called. Since FreeRTOS timers run on the
+         * tick, the timed flush happens no sooner than one tick after the
+         * first response.
+         *
+         * The defaults come from `T76_IC_USB_INTERFACE_BULK_IN_COALESCE` and
+         * `T76_IC_USB_INTERFACE_BULK_IN_COALESCE_WINDOW_US`.
+         *
+         * @param enable true to coalesce responses.
+         * @param windowUs Grouping window, in microseconds.
+         */
+        void setUSBTMCBulkInCoalescing(bool enable, uint32_t windowUs = T76_IC_USB_INTERFACE_BULK_IN_COALESCE_WINDOW_US);
+
+        /**
+         * @brief Send the open group of coalesced USBTMC responses now.
+         *
+         * Has no effect if coalescing is disabled, no group is open, or a
+         * response is still being written with `endOfMessage` set to false.
+         */
+        void flushUSBTMCBulkData();
+
+        /**
+         * @brief Stop accepting USBTMC bulk OUT data after the current packet.
+         *
+         * Call this from `_onUSBTMCBytesReceived()` when no more data can be
+         * taken, for example because the buffer that feeds a command task is
+         * full. The bulk OUT endpoint is not re-armed when the callback
+         * returns, so the host is NAKed until `resumeUSBTMCBulkOut()` is
+         * called, while the other classes, and USBTMC responses, keep being
+         * serviced.
+         */
+        void pauseUSBTMCBulkOut();
+
+        /**
+         * @brief Accept USBTMC bulk OUT data again after `pauseUSBTMCBulkOut()`.
+         *
+         * This method is thread-safe and can be called from any task; the
+         * endpoint is re-armed from the USB runtime task.
+         */
+        void resumeUSBTMCBulkOut();
 
         /**
          * @brief Send a USBTMC SRQ interrupt to the USB host.
@@ -401,10 +966,92 @@ namespace T76::Core::USB {
          */
         bool mounted() const;
 
+        /**
+         * @brief Traffic counters for one USB class.
+         *
+         * A message is a USBTMC transfer, a vendor or WinUSB packet or frame,
+         * or a write to the CDC stdio driver.
+         */
+        struct ClassStats {
+            uint32_t bytesIn;               ///< Bytes received from the host
+            uint32_t bytesOut;              ///< Bytes sent to the host
+            uint32_t messagesIn;            ///< Messages received from the host
+            uint32_t messagesOut;           ///< Messages sent to the host
+            uint32_t dropped;               ///< Messages discarded before reaching their destination
+        };
+
+        /**
+         * @brief Snapshot of the USB instrumentation counters.
+         */
+        struct Stats {
+            ClassStats usbtmc;              ///< USBTMC bulk traffic
+            ClassStats vendor;              ///< Vendor bulk traffic
+            ClassStats winUSB;              ///< WinUSB bulk traffic, including stream frames
+            ClassStats cdc;                 ///< Output written to stdio, which is carried by the CDC interface
+            uint32_t usbtmcQueueHighWater;  ///< Most USBTMC responses waiting in the bulk IN ring at once
+            uint32_t winUSBQueueHighWater;  ///< Most frames waiting in the WinUSB bulk IN queue at once
+            uint32_t dispatchQueueHighWater;///< Most items waiting in the payload dispatch lane at once
+            uint32_t zlpsSent;              ///< Zero-length packets sent to terminate WinUSB frames
+            uint32_t dispatchLatency[T76_IC_USB_STATS_LATENCY_BUCKETS]; ///< Dispatched items per latency bucket, see dispatchLatencyBucketLimit()
+        };
+
+        /**
+         * @brief Get a snapshot of the USB instrumentation counters.
+         *
+         * @param stats Receives the counters.
+         * @return true if the counters are valid, false if T76_IC_USB_STATS is
+         *         disabled (stats is then zeroed).
+         */
+        bool stats(Stats &stats) const;
+
+        /**
+         * @brief Clear the USB instrumentation counters and high-water marks.
+         */
+        void resetStats();
+
+        /**
+         * @brief Get the upper latency limit of a dispatch latency bucket.
+         *
+         * Bucket i counts items handled within 16 << i microseconds of the
+         * USB callback that produced them; the last bucket counts everything
+         * slower.
+         *
+         * @param bucket Bucket index
+         * @return Upper limit in microseconds, or UINT32_MAX for the last bucket
+         */
+        static uint32_t dispatchLatencyBucketLimit(uint8_t bucket);
+
+        /**
+         * @brief Format the USB traffic counters as a comma-separated list.
+         *
+         * Suitable as the response to a SYSTem:USB:STATistics? query. Each
+         * class, in the order USBTMC, vendor, WinUSB, CDC, contributes
+         * bytesIn,bytesOut,messagesIn,messagesOut,dropped; the list ends with
+         * the USBTMC, WinUSB and dispatch queue high-water marks and the
+         * number of ZLPs sent.
+         */
+        std::string statsReport() const;
+
+        /**
+         * @brief Format the dispatch latency histogram as a comma-separated list.
+         *
+         * Suitable as the response to a SYSTem:USB:LATency? query. Counts are
+         * listed from the fastest bucket to the slowest.
+         */
+        std::string dispatchLatencyReport() const;
+
     protected:
         static constexpr uint8_t _vendorInterfaceInstance = 0; ///< TinyUSB vendor-interface instance used for legacy bulk transfers.
         static constexpr size_t _winUSBEndpointPacketSize = 64; ///< Max packet size for the WinUSB bulk IN endpoint.
 
+        /**
+         * @brief Size of the fixed buffer in each dispatch item.
+         * 
+         * Large enough to hold a full vendor RX FIFO or a full WinUSB bulk OUT
+         * packet, so received data never needs more than one item.
+         */
+        static constexpr size_t _dispatchBufferSize = CFG_TUD_VENDOR_RX_BUFSIZE > CFG_TUD_VENDOR_EPSIZE ? CFG_TUD_VENDOR_RX_BUFSIZE : CFG_TUD_VENDOR_EPSIZE;
+
         /**
          * @brief Registered delegate that receives interface callbacks.
          */
@@ -421,9 +1068,12 @@ namespace T76::Core::USB {
         enum class DispatchType {
             DataReceived,
             SendData,
+            VendorBulkInComplete,
             WinUSBBulkDataReceived,
             WinUSBBulkInComplete,
             SendWinUSBBulkData,
+            WinUSBStreamKick,
+            CDCDataKick,
         };
 
         /**
@@ -432,17 +1082,33 @@ namespace T76::Core::USB {
          * This struct represents a single item in the dispatch queue.
          * It contains the type of the item and the data associated with it.
          * 
-         * Note that ownership of the data property is transferred to the
-         * dispatch queue when the item is sent. The queue will manage the
-         * lifetime of the data, and you should not access it after sending
-         * the item to the queue.
-         * 
-         */
-        typedef struct {
-            DispatchType type;
-            std::vector<uint8_t> data;
-            uint32_t xferred_bytes = 0;
-        } DispatchItem;
+         * Items are preallocated in a fixed pool and recycled through a free
+         * list, so dispatching a USB packet never touches the heap. Packet
+         * data is copied into the fixed buffer; only SendWinUSBBulkData items,
+         * whose frames can be arbitrarily large, carry their payload in the
+         * frame vector.
+         * 
+         * The pool is split in two: items for data and events coming from
+         * the USB stack, and items for data the application sends. SendData
+         * items stay in use until the vendor endpoint has accepted all of their
+         * data, so keeping them in a separate pool guarantees that outgoing
+         * data can never starve the USB stack of the items it needs to report
+         * the completions that free them.
+         * 
+         * Note that ownership of the item is transferred to the dispatch
+         * queue when the item is sent. The dispatch task returns it to the
+         * free list once processed, and you should not access it after
+         * sending it to the queue.
+         * 
+         */
+        struct DispatchItem {
+            DispatchType type;                          ///< Kind of event
+            uint16_t length = 0;                        ///< Number of valid bytes in data
+            uint32_t xferred_bytes = 0;                 ///< Bytes transferred, for WinUSBBulkInComplete
+            uint32_t postedAt = 0;                      ///< Time the item was queued, in microseconds
+            std::vector<uint8_t> frame;                 ///< Frame payload, for SendWinUSBBulkData only
+            uint8_t data[_dispatchBufferSize];          ///< Packet payload
+        };
 
         /**
          * @brief The singleton instance of the USB interface.
@@ -456,9 +1122,67 @@ namespace T76::Core::USB {
         static Interface *_singleton;
 
         /**
-         * @brief Queue used to dispatch USB events to the worker task.
+         * @brief Queue used to dispatch received bulk data to the worker task.
+         * 
+         * This is the payload lane: every item in it results in a call to
+         * application code, which may take arbitrarily long.
+         */
+        QueueHandle_t _dispatchQueue = nullptr;
+
+        /**
+         * @brief Queue used to dispatch transfer completions and outgoing data.
+         * 
+         * This is the completion lane. It is serviced by its own task when
+         * T76_IC_USB_DISPATCH_COMPLETION_TASK is enabled, or ahead of the
+         * payload lane by the dispatch task otherwise, so that streaming is
+         * never held up behind a slow receive handler.
+         */
+        QueueHandle_t _dispatchCompletionQueue = nullptr;
+
+#ifndef T76_IC_USB_DISPATCH_COMPLETION_TASK
+        /**
+         * @brief Queue set used by the dispatch task to wait on both lanes.
+         */
+        QueueSetHandle_t _dispatchQueueSet = nullptr;
+#endif
+
+        /**
+         * @brief Queue holding the unused dispatch items for USB stack events.
+         */
+        QueueHandle_t _dispatchFreeQueue = nullptr;
+
+        /**
+         * @brief Queue holding the unused dispatch items for outgoing data.
+         */
+        QueueHandle_t _dispatchSendFreeQueue = nullptr;
+
+        /**
+         * @brief Preallocated dispatch items.
+         * 
+         * The first T76_IC_USB_DISPATCH_QUEUE_SIZE items are recycled through
+         * _dispatchFreeQueue; the rest through _dispatchSendFreeQueue.
+         */
+        DispatchItem _dispatchItemPool[T76_IC_USB_DISPATCH_QUEUE_SIZE + T76_IC_USB_DISPATCH_SEND_ITEMS];
+
+        /**
+         * @brief SendData items waiting for room in the vendor bulk IN FIFO.
+         * 
+         * Only accessed by the dispatch task.
+         */
+        std::deque<DispatchItem*> _vendorBulkInQueue;
+
+        /**
+         * @brief Number of bytes of the front item already written to the vendor FIFO.
+         */
+        size_t _vendorBulkInOffset = 0;
+
+        /**
+         * @brief Buffer used to hand received packets to the delegate.
+         * 
+         * Only accessed by the dispatch task. Packets are copied here so that
+         * their dispatch item can be recycled before the delegate runs.
          */
-        QueueHandle_t _dispatchQueue;
+        uint8_t _dispatchDeliveryBuffer[_dispatchBufferSize];
 
         /**
          * @brief Buffer that stores IN-direction vendor control transfer data.
@@ -485,25 +1209,342 @@ namespace T76::Core::USB {
         bool _winUSBBulkInZlpInFlight = false; ///< Whether a WinUSB ZLP is currently in flight.
         bool _winUSBBulkInZlpComplete = false; ///< Whether the current frame's trailing ZLP has completed.
 
+#ifdef T76_IC_USB_WINUSB_STREAM
+        static_assert(T76_IC_USB_WINUSB_STREAM_FRAME_SIZE % _winUSBEndpointPacketSize == 0, "WinUSB stream frames must be a multiple of the packet size");
+        static_assert(T76_IC_USB_WINUSB_STREAM_FRAME_SIZE <= UINT16_MAX, "WinUSB stream frames must fit in a single transfer");
+
+        /**
+         * @brief A single WinUSB stream frame.
+         */
+        struct WinUSBStreamFrame {
+            alignas(4) uint8_t data[T76_IC_USB_WINUSB_STREAM_FRAME_SIZE];   ///< Frame payload, sent in place
+            uint16_t length = 0;                                            ///< Number of valid bytes
+        };
+
+        WinUSBStreamFrame _winUSBStreamFrames[T76_IC_USB_WINUSB_STREAM_FRAME_COUNT]; ///< Stream frame ring.
+        std::atomic<uint32_t> _winUSBStreamHead{0}; ///< Frames published by the producer.
+        std::atomic<uint32_t> _winUSBStreamTail{0}; ///< Frames sent by the USB side.
+        std::atomic<uint32_t> _winUSBStreamOverruns{0}; ///< Times the producer found no free frame.
+        bool _winUSBStreamInFlight = false; ///< Whether a stream frame is currently being sent.
+        uint32_t _winUSBStreamFramesSent = 0; ///< Stream frames sent.
+        uint64_t _winUSBStreamBytesSent = 0; ///< Stream bytes sent.
+        uint64_t _winUSBStreamWindowStart = 0; ///< Start of the current throughput window, in microseconds.
+        uint32_t _winUSBStreamWindowBytes = 0; ///< Bytes sent in the current throughput window.
+        uint32_t _winUSBStreamBytesPerSecond = 0; ///< Throughput measured over the last full window.
+        int _winUSBStreamDoorbell = -1; ///< Doorbell rung by the producer when a frame is published.
+        std::atomic<bool> _winUSBStreamKickPending{false}; ///< Whether a kick item is queued.
+
+        /**
+         * @brief Static item posted to the completion lane to start sending stream frames.
+         *
+         * It is never part of the dispatch pool and is not released.
+         */
+        DispatchItem _winUSBStreamKickItem;
+#endif
+
+#ifdef T76_IC_USB_ISO_STREAM
+        static_assert(T76_IC_USB_ISO_STREAM_PACKET_SIZE > 0 && T76_IC_USB_ISO_STREAM_PACKET_SIZE <= 1023, "Full-speed isochronous packets hold at most 1023 bytes");
+
+        /**
+         * @brief A single isochronous stream frame.
+         */
+        struct IsoStreamFrame {
+            alignas(4) uint8_t data[T76_IC_USB_ISO_STREAM_PACKET_SIZE];     ///< Frame payload, sent in place
+            uint16_t length = 0;                                            ///< Number of valid bytes
+        };
+
+        IsoStreamFrame _isoStreamFrames[T76_IC_USB_ISO_STREAM_FRAME_COUNT]; ///< Stream frame ring.
+        std::atomic<uint32_t> _isoStreamHead{0}; ///< Frames published by the producer.
+        std::atomic<uint32_t> _isoStreamTail{0}; ///< Frames sent by the USB side.
+        std::atomic<uint32_t> _isoStreamOverruns{0}; ///< Times the producer found no free frame.
+        bool _isoStreamActive = false; ///< Whether the host has selected the streaming alternate setting.
+        bool _isoStreamFrameInFlight = false; ///< Whether the packet in flight is a stream frame rather than a zero-length packet.
+        uint16_t _isoStreamLastSof = 0; ///< USB frame number when the previous packet completed.
+        uint32_t _isoStreamFramesSent = 0; ///< Stream frames sent.
+        uint64_t _isoStreamBytesSent = 0; ///< Stream bytes sent.
+        uint32_t _isoStreamUnderruns = 0; ///< Zero-length packets sent for lack of a frame.
+        uint32_t _isoStreamMissedFrames = 0; ///< USB frames in which no packet was queued.
+#endif
+
+#ifdef T76_IC_USB_CDC_DATA
+        static constexpr uint8_t _cdcDataInstance = 1; ///< TinyUSB CDC instance of the data port; instance 0 is the stdio port.
+
+        T76::Core::Utils::MessageRing<T76_IC_USB_CDC_DATA_TX_BUFFER_SIZE, T76_IC_USB_CDC_DATA_TX_BUFFER_SIZE / 16> _cdcDataTxRing; ///< Blocks waiting to be sent.
+        T76::Core::Utils::MessageRing<T76_IC_USB_CDC_DATA_RX_BUFFER_SIZE, T76_IC_USB_CDC_DATA_RX_BUFFER_SIZE / 16> _cdcDataRxRing; ///< Received data, one message per read from TinyUSB.
+        SemaphoreHandle_t _cdcDataTxSpaceSemaphore = nullptr; ///< Given when data leaves the transmit ring.
+        SemaphoreHandle_t _cdcDataRxSemaphore = nullptr; ///< Given when data enters the receive ring.
+        SemaphoreHandle_t _cdcDataRxMutex = nullptr; ///< Keeps moves from TinyUSB into the receive ring in order.
+        std::atomic<bool> _cdcDataKickPending{false}; ///< Whether a kick item is queued.
+
+        /**
+         * @brief Static item posted to the completion lane to send data from the transmit ring.
+         *
+         * It is never part of the dispatch pool and is not released.
+         */
+        DispatchItem _cdcDataKickItem;
+#endif
+
+#ifdef T76_IC_USB_TRIGGER
+        int _triggerDoorbell = -1; ///< Doorbell rung on the core that runs the trigger action.
+        std::atomic<TriggerAction> _triggerAction{nullptr}; ///< Action run from the doorbell interrupt.
+        void *_triggerContext = nullptr; ///< Passed to the trigger action.
+        std::atomic<bool> _triggerClaimed{false}; ///< Whether a fired trigger has not been delivered yet.
+        std::atomic<bool> _triggerReady{false}; ///< Whether the timestamp of the claimed trigger has been published.
+        std::atomic<uint32_t> _triggerTimestamp{0}; ///< When the pending trigger was fired.
+        std::atomic<uint32_t> _triggersFired{0}; ///< Triggers fired.
+        std::atomic<uint32_t> _triggersDelivered{0}; ///< Triggers delivered.
+        std::atomic<uint32_t> _triggersMissed{0}; ///< Triggers fired while one was pending.
+        std::atomic<uint32_t> _triggerLastLatency{0}; ///< Latency of the last delivered trigger, in microseconds.
+        std::atomic<uint32_t> _triggerMinLatency{UINT32_MAX}; ///< Shortest latency, in microseconds.
+        std::atomic<uint32_t> _triggerMaxLatency{0}; ///< Longest latency, in microseconds.
+        std::atomic<uint32_t> _triggerTotalLatency{0}; ///< Sum of the latencies, in microseconds.
+#endif
+
+        /**
+         * @brief Live traffic counters for one USB class.
+         *
+         * Counters are updated from several tasks, interrupts and the stdio
+         * driver, so each one is a relaxed atomic rather than being protected
+         * by a lock.
+         */
+        struct ClassCounters {
+            std::atomic<uint32_t> bytesIn{0};
+            std::atomic<uint32_t> bytesOut{0};
+            std::atomic<uint32_t> messagesIn{0};
+            std::atomic<uint32_t> messagesOut{0};
+            std::atomic<uint32_t> dropped{0};
+        };
+
+        ClassCounters _usbtmcCounters;                          ///< USBTMC bulk traffic
+        ClassCounters _vendorCounters;                          ///< Vendor bulk traffic
+        ClassCounters _winUSBCounters;                          ///< WinUSB bulk traffic
+        static ClassCounters _cdcCounters;                      ///< stdio output, counted by a static stdio driver
+        std::atomic<uint32_t> _usbtmcQueueHighWater{0};         ///< Most responses waiting in the USBTMC ring
+        std::atomic<uint32_t> _winUSBQueueHighWater{0};         ///< Most frames waiting in _winUSBBulkInQueue
+        std::atomic<uint32_t> _dispatchQueueHighWater{0};       ///< Most items waiting in _dispatchQueue
+        std::atomic<uint32_t> _zlpsSent{0};                     ///< WinUSB ZLPs sent
+        std::atomic<uint32_t> _dispatchLatency[T76_IC_USB_STATS_LATENCY_BUCKETS] = {}; ///< Dispatch latency histogram
+
+        /**
+         * @brief Add to an instrumentation counter; does nothing unless T76_IC_USB_STATS is defined.
+         */
+        static inline void _count(std::atomic<uint32_t> &counter, uint32_t amount = 1) {
+#ifdef T76_IC_USB_STATS
+            counter.fetch_add(amount, std::memory_order_relaxed);
+#else
+            (void)counter;
+            (void)amount;
+#endif
+        }
+
+        /**
+         * @brief Raise a high-water mark; does nothing unless T76_IC_USB_STATS is defined.
+         */
+        static inline void _noteHighWater(std::atomic<uint32_t> &mark, uint32_t value) {
+#ifdef T76_IC_USB_STATS
+            uint32_t current = mark.load(std::memory_order_relaxed);
+
+            while (value > current && !mark.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+#else
+            (void)mark;
+            (void)value;
+#endif
+        }
+
+        static constexpr uint8_t _cdcStdioInstance = 0; ///< TinyUSB CDC instance of the stdio port.
+
+        /**
+         * @brief stdio driver output hook of the CDC port.
+         *
+         * Queues the output in TinyUSB's FIFO and counts it. Unlike the driver
+         * of pico_stdio_usb, it never calls `tud_task()`, which only the runtime
+         * task may run. When the FIFO is full, it waits for up to
+         * PICO_STDIO_USB_STDOUT_TIMEOUT_US for the host, then drops the rest.
+         */
+        static void _cdcStdioOutChars(const char *buffer, int length);
+
+        /**
+         * @brief stdio driver input hook of the CDC port.
+         *
+         * @return The number of characters read, or PICO_ERROR_NO_DATA.
+         */
+        static int _cdcStdioInChars(char *buffer, int length);
+
+        /**
+         * @brief Record how long a dispatch item waited between its USB callback and handling.
+         */
+        void _noteDispatchLatency(const DispatchItem *item);
+
+        /**
+         * @brief Record the number of complete responses waiting in the USBTMC ring.
+         */
+        void _noteUSBTMCQueueDepth();
+
+        /**
+         * @brief Byte ring backing USBTMC bulk IN transfers.
+         *
+         * Responses are written straight into the ring and read from it in
+         * place by the bulk IN transfer, so queries do not allocate.
+         */
+        T76::Core::Utils::MessageRing<T76_IC_USB_INTERFACE_BULK_IN_BUFFER_SIZE, T76_IC_USB_INTERFACE_BULK_IN_QUEUE_SIZE> _usbtmcBulkInRing;
+
+        static_assert(T76_IC_USB_INTERFACE_BULK_IN_COALESCE_MAX_SIZE <= T76_IC_USB_INTERFACE_BULK_IN_BUFFER_SIZE,
+                      "Coalesced USBTMC responses must fit in the bulk IN ring");
+
+        /**
+         * @brief Number of ring bytes used by the USBTMC bulk IN transfer in flight.
+         *
+         * These bytes are released from the ring when the transfer completes.
+         */
+        size_t _usbtmcBulkInInFlight = 0;
+
+        /**
+         * @brief Semaphore given whenever space is released in the USBTMC bulk IN ring.
+         */
+        SemaphoreHandle_t _usbtmcBulkInSpaceSemaphore = nullptr;
+
+        /**
+         * @brief Maximum time a USBTMC send waits for room in the ring, in ticks.
+         */
+        TickType_t _usbtmcBulkInSendTimeout = pdMS_TO_TICKS(T76_IC_USB_INTERFACE_BULK_IN_SEND_TIMEOUT_MS);
+
+        /**
+         * @brief Whether USBTMC responses that do not fit are dropped instead of blocking.
+         */
+#ifdef T76_IC_USB_INTERFACE_BULK_IN_DROP_WHEN_FULL
+        bool _usbtmcBulkInDropWhenFull = true;
+#else
+        bool _usbtmcBulkInDropWhenFull = false;
+#endif
+
+        /**
+         * @brief Whether a send was refused and the delegate should be told when space frees up.
+         */
+        std::atomic<bool> _usbtmcBulkInSpaceWanted{false};
+
+        /**
+         * @brief Buffer that receives the responses of `_usbtmcCaptureTask`, see captureUSBTMCBulkData()
+         */
+        std::vector<uint8_t> *_usbtmcCapture = nullptr;
+
+        /**
+         * @brief Task whose USBTMC responses are captured, or nullptr
+         */
+        std::atomic<TaskHandle_t> _usbtmcCaptureTask{nullptr};
+
+        /**
+         * @brief Whether complete USBTMC responses are coalesced into one message.
+         */
+#ifdef T76_IC_USB_INTERFACE_BULK_IN_COALESCE
+        bool _usbtmcBulkInCoalesce = true;
+#else
+        bool _usbtmcBulkInCoalesce = false;
+#endif
+
+        /**
+         * @brief Window after the first response of a group at which the group is flushed, in microseconds.
+         */
+        uint32_t _usbtmcBulkInCoalesceWindowUs = T76_IC_USB_INTERFACE_BULK_IN_COALESCE_WINDOW_US;
+
+        /**
+         * @brief Number of bytes in the open group of coalesced responses.
+         */
+        size_t _usbtmcBulkInCoalescedLength = 0;
+
+        /**
+         * @brief Whether the open group ends with a response that is still being written.
+         */
+        bool _usbtmcBulkInCoalescePartial = false;
+
+        /**
+         * @brief Mutex that serializes writes to, and flushes of, the open group.
+         *
+         * It is never held while waiting for ring space, so the runtime task
+         * can always take it.
+         */
+        SemaphoreHandle_t _usbtmcBulkInCoalesceMutex = nullptr;
+
         /**
-         * @brief Buffer that stores USBTMC bulk IN data.
+         * @brief One-shot timer that flushes the open group at the end of the window.
          */
-        std::vector<uint8_t> _usbtmcBulkInDataBuffer;
+        TimerHandle_t _usbtmcBulkInCoalesceTimer = nullptr;
 
         /**
-         * @brief Fixed-size queue backing USBTMC bulk IN transfers.
+         * @brief Handle of the USB runtime task, which must never wait for ring space.
          */
-        T76::Core::Utils::FixedSizeQueue<std::vector<uint8_t>> _usbtmcBulkInDataQueue;
+        TaskHandle_t _runtimeTaskHandle = nullptr;
 
         /**
-         * @brief Data currently in-flight for a USBTMC bulk IN transfer.
+         * @brief Wait until the USBTMC bulk IN ring can accept a write.
+         *
+         * @param length Number of bytes that will be written.
+         * @param endOfMessage Whether the write will end the current message.
+         * @return true if the data can be written; false if the send should be
+         *         refused without writing anything.
+         */
+        bool _waitForUSBTMCBulkInSpace(size_t length, bool endOfMessage);
+
+        /**
+         * @brief Release bytes from the USBTMC bulk IN ring and wake any waiting senders.
+         *
+         * @param length Number of bytes to release.
+         */
+        void _releaseUSBTMCBulkInSpace(size_t length);
+
+        /**
+         * @brief Write a response, optionally followed by a suffix, to the USBTMC bulk IN ring.
+         *
+         * @param data Bytes of the response.
+         * @param length Number of bytes in the response.
+         * @param suffix Bytes appended after the response, such as a newline; may be null.
+         * @param suffixLength Number of bytes in the suffix.
+         * @param endOfMessage Whether this write ends the current response.
+         * @param fill If set, writes the response into the ring in place of `data`.
+         * @param context Passed to `fill`.
+         * @return true if the data was queued, false otherwise.
+         */
+        bool _writeUSBTMCBulkData(const uint8_t *data, size_t length, const uint8_t *suffix, size_t suffixLength, bool endOfMessage,
+                                  T76::Core::Utils::MessageFillFunction fill = nullptr, void *context = nullptr);
+
+        /**
+         * @brief Close the open group of coalesced responses so that it can be sent.
+         *
+         * Must be called with `_usbtmcBulkInCoalesceMutex` held.
+         */
+        void _closeUSBTMCCoalescedGroup();
+
+        /**
+         * @brief Discard every queued USBTMC response, including the open group.
+         */
+        void _discardUSBTMCBulkInData();
+
+        /**
+         * @brief Timer callback that flushes the open group at the end of the window.
+         */
+        static void _usbtmcCoalesceTimerCallback(TimerHandle_t timer);
+
+        /**
+         * @brief Whether the delegate has asked for USBTMC bulk OUT data to be held off.
+         */
+        std::atomic<bool> _usbtmcBulkOutPaused{false};
+
+        /**
+         * @brief Whether the bulk OUT endpoint was left unarmed because input was paused.
+         *
+         * Only used from the runtime task.
+         */
+        bool _usbtmcBulkOutParked = false;
+
+        /**
+         * @brief Re-arm the USBTMC bulk OUT endpoint, unless input is paused.
          */
-        std::vector<uint8_t> _usbtmcBulkInDataPending;
+        void _startUSBTMCBulkOut();
 
         /**
-         * @brief Offset into the pending USBTMC bulk IN payload.
+         * @brief Re-arm a parked bulk OUT endpoint; deferred to the runtime task by `resumeUSBTMCBulkOut()`.
          */
-        size_t _usbtmcBulkInPendingOffset = 0;
+        static void _resumeUSBTMCBulkOut(void *param);
 
         /**
          * @brief Default USBTMC capability descriptor returned to the host.
@@ -554,7 +1595,10 @@ namespace T76::Core::USB {
          * @brief The runtime task.
          * 
          * This task simply calls `tud_task()` in a loop, allowing the TinyUSB stack
-         * to process USB events. It is created during the initialization of the USB
+         * to process USB events. TinyUSB is built with the FreeRTOS OSAL, so
+         * `tud_task()` blocks on the stack's event queue and the task wakes as
+         * soon as the USB interrupt posts an event, rather than polling on the
+         * scheduler tick. It is created during the initialization of the USB
          * interface and runs indefinitely.
          * 
          */
@@ -570,6 +1614,65 @@ namespace T76::Core::USB {
          */
         void _dispatchTask();
 
+#ifdef T76_IC_USB_DISPATCH_COMPLETION_TASK
+        /**
+         * @brief The completion task.
+         * 
+         * This task services the completion lane: transfer completion events
+         * and outgoing vendor and WinUSB data.
+         */
+        void _completionTask();
+#endif
+
+        /**
+         * @brief Process a single item taken from either dispatch lane.
+         * 
+         * @param item The item to process. It is returned to its free list.
+         */
+        void _processDispatchItem(DispatchItem *item);
+
+        /**
+         * @brief Determine which dispatch lane an item type travels in.
+         * 
+         * @param type The type of the item.
+         * @return true for the completion lane, false for the payload lane.
+         */
+        static bool _isCompletionLane(DispatchType type);
+
+        /**
+         * @brief Take a dispatch item from the free list.
+         * 
+         * Blocks until an item is available, which throttles producers when
+         * the dispatch task falls behind.
+         * 
+         * @param type The type to assign to the item.
+         * @return The item, or nullptr if the interface is not initialized.
+         */
+        DispatchItem *_acquireDispatchItem(DispatchType type);
+
+        /**
+         * @brief Return a dispatch item to the free list.
+         * 
+         * @param item The item to release.
+         */
+        void _releaseDispatchItem(DispatchItem *item);
+
+        /**
+         * @brief Send an item to the dispatch queue, releasing it on failure.
+         * 
+         * @param item The item to send.
+         */
+        void _sendDispatchItem(DispatchItem *item);
+
+        /**
+         * @brief Queue a block of data, split across as many items as needed.
+         * 
+         * @param type The type of the items.
+         * @param data The data to queue.
+         * @param size Number of bytes to queue.
+         */
+        void _dispatchData(DispatchType type, const uint8_t *data, size_t size);
+
         /**
          * @brief Process a WebUSB request.
          * 
@@ -598,6 +1701,25 @@ namespace T76::Core::USB {
          */
         void _vendorDataReceived(uint8_t itf, uint8_t* buffer, uint16_t bufsize);
 
+        /**
+         * @brief Handle vendor bulk IN transfer completion.
+         *
+         * Called from the USB runtime task when the vendor endpoint finishes a
+         * transfer, so more queued data can be written to its FIFO.
+         *
+         * @param itf The vendor interface instance.
+         * @param sentBytes Number of bytes transferred.
+         */
+        void _vendorBulkInComplete(uint8_t itf, uint32_t sentBytes);
+
+        /**
+         * @brief Write as much queued vendor bulk IN data as the FIFO accepts.
+         *
+         * Items whose data has been fully written are released; the rest is
+         * written when the next transfer completes.
+         */
+        void _continueVendorBulkInTransfer();
+
         /**
          * @brief Handle WinUSB bulk OUT data received.
          *
@@ -625,6 +1747,99 @@ namespace T76::Core::USB {
          */
         void _continueWinUSBBulkInTransfer();
 
+#ifdef T76_IC_USB_WINUSB_STREAM
+        /**
+         * @brief Start sending the oldest published stream frame if the endpoint is idle.
+         */
+        void _continueWinUSBStream();
+
+        /**
+         * @brief Release the stream frame that was just sent and update the statistics.
+         *
+         * @param xferredBytes Number of bytes transferred.
+         */
+        void _finishWinUSBStreamFrame(uint32_t xferredBytes);
+
+        /**
+         * @brief Interrupt handler for the stream doorbell.
+         *
+         * Posts the kick item to the completion lane so that new frames are
+         * picked up even when the endpoint is idle.
+         */
+        static void _winUSBStreamDoorbellHandler();
+#endif
+
+#ifdef T76_IC_USB_ISO_STREAM
+        /**
+         * @brief Start streaming when the host selects the streaming alternate setting.
+         *
+         * Called by the class driver on the runtime task, after it has opened
+         * the endpoint.
+         */
+        void _isoStreamStarted();
+
+        /**
+         * @brief Stop streaming when the host deselects the alternate setting or the bus resets.
+         *
+         * A frame that was in flight stays in the ring and is sent first when
+         * streaming starts again.
+         */
+        void _isoStreamStopped();
+
+        /**
+         * @brief Release the packet that was just sent and queue the next one.
+         *
+         * Called by the class driver on the runtime task, once per USB frame
+         * while streaming, so that the endpoint always has a packet queued.
+         *
+         * @param xferredBytes Number of bytes transferred.
+         */
+        void _isoStreamInComplete(uint32_t xferredBytes);
+
+        /**
+         * @brief Queue the oldest published frame, or a zero-length packet if there is none.
+         */
+        void _continueIsoStream();
+#endif
+
+#ifdef T76_IC_USB_CDC_DATA
+        /**
+         * @brief Post the kick item to the completion lane, unless one is already queued.
+         */
+        void _kickCDCDataTransfer();
+
+        /**
+         * @brief Move data from the transmit ring into TinyUSB and start a transfer.
+         *
+         * Runs on the completion lane. Whatever does not fit in the TinyUSB FIFO
+         * stays in the ring until the next transfer completes.
+         */
+        void _continueCDCDataTransfer();
+
+        /**
+         * @brief Move received data from TinyUSB into the receive ring while it has room.
+         */
+        void _cdcDataReceived();
+#endif
+
+#ifdef T76_IC_USB_TRIGGER
+        /**
+         * @brief Take the pending trigger and record its latency.
+         *
+         * @param timestampUs Where to store when the trigger was fired.
+         * @return true if a trigger was pending, false otherwise.
+         */
+        bool _takeTrigger(uint32_t &timestampUs);
+
+        /**
+         * @brief Interrupt handler for the trigger doorbell.
+         *
+         * Runs on the core that attached the trigger action, and calls the
+         * action with the timestamp of the pending trigger.
+         */
+        static void _triggerDoorbellHandler();
+#endif
+
         /**
          * @brief Handle vendor control transfer.
          * 
@@ -836,7 +2051,7 @@ namespace T76::Core::USB {
          * This method retrieves the status byte for USBTMC and returns it. The status byte
          * indicates the current status of the USBTMC interface.
          * 
-         * Override this method in your subclass to provide the actual status byte.
+         * By default, returns the delegate's `_onUSBTMCReadStatusByte()`.
          * 
          * @return The status byte, or an error code if the operation failed.
          */
@@ -862,10 +2077,26 @@ namespace T76::Core::USB {
 
         friend void ::tud_vendor_rx_cb(uint8_t itf, uint8_t const* buffer, uint16_t bufsize);
         friend bool ::tud_vendor_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request);
+        friend void ::tud_vendor_tx_cb(uint8_t itf, uint32_t sent_bytes);
         friend bool ::t76_winusb_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request);
         friend void ::t76_winusb_bulk_out_received_cb(uint8_t const* buffer, uint16_t bufsize);
         friend void ::t76_winusb_bulk_in_complete_cb(uint32_t xferred_bytes);
 
+#ifdef T76_IC_USB_ISO_STREAM
+        // Isochronous interface callbacks
+
+        friend void ::t76_iso_stream_started_cb(void);
+        friend void ::t76_iso_stream_stopped_cb(void);
+        friend void ::t76_iso_stream_in_complete_cb(uint32_t xferred_bytes);
+#endif
+
+#ifdef T76_IC_USB_CDC_DATA
+        // Data CDC port callbacks
+
+        friend void ::tud_cdc_rx_cb(uint8_t itf);
+        friend void ::tud_cdc_tx_complete_cb(uint8_t itf);
+#endif
+
         // USBTMC interface callbacks
 
         friend usbtmc_response_capabilities_488_t const * ::tud_usbtmc_get_capabilities_cb();
@@ -29,7 +29,30 @@
 
 #define CFG_TUSB_RHPORT0_MODE   (OPT_MODE_DEVICE)
 
+// Use the FreeRTOS OSAL so that tud_task() blocks on the TinyUSB event queue
+// instead of having to be polled. The Pico SDK defaults to OPT_OS_PICO on the
+// command line, so override it here.
+#undef CFG_TUSB_OS
+#define CFG_TUSB_OS             (OPT_OS_FREERTOS)
+
+#ifdef T76_IC_USB_CDC_DATA
+// Instance 0 is the stdio port, instance 1 the data port of Interface::writeCDCData()
+#define CFG_TUD_CDC             (2)
+
+// Larger FIFOs and endpoint buffers, so that the data port moves several
+// packets per transfer. These apply to both ports.
+#ifndef CFG_TUD_CDC_RX_BUFSIZE
+#define CFG_TUD_CDC_RX_BUFSIZE   (1024)
+#endif
+#ifndef CFG_TUD_CDC_TX_BUFSIZE
+#define CFG_TUD_CDC_TX_BUFSIZE   (1024)
+#endif
+#ifndef CFG_TUD_CDC_EP_BUFSIZE
+#define CFG_TUD_CDC_EP_BUFSIZE   (512)
+#endif
+#else
 #define CFG_TUD_CDC             (1)
+#endif
 
 // CDC FIFO size of TX and RX
 #ifndef CFG_TUD_CDC_RX_BUFSIZE
@@ -69,7 +69,28 @@ uint8_t const *tud_descriptor_device_cb(void) {
 
 #define WINUSB_DESCRIPTOR_LEN 23
 
-#define CONFIG_TOTAL_LEN    (TUD_CONFIG_DESC_LEN + TUD_CDC_DESC_LEN + RPI_RESET_DESCRIPTOR_LEN + TUD_VENDOR_DESC_LEN + TUD_USBTMC_IF_DESCRIPTOR_LEN + TUD_USBTMC_BULK_DESCRIPTORS_LEN + TUD_USBTMC_INT_DESCRIPTOR_LEN + WINUSB_DESCRIPTOR_LEN)
+// Alternate setting 0 has no endpoint, so that the bus only reserves the
+// isochronous bandwidth once the host selects setting 1 to start streaming
+#define ISO_STREAM_DESCRIPTOR(_itfnum, _stridx, _epin, _epsize) \
+  9, TUSB_DESC_INTERFACE, _itfnum, 0, 0, TUSB_CLASS_VENDOR_SPECIFIC, ISO_STREAM_INTERFACE_SUBCLASS, ISO_STREAM_INTERFACE_PROTOCOL, _stridx, \
+  9, TUSB_DESC_INTERFACE, _itfnum, 1, 1, TUSB_CLASS_VENDOR_SPECIFIC, ISO_STREAM_INTERFACE_SUBCLASS, ISO_STREAM_INTERFACE_PROTOCOL, _stridx, \
+  7, TUSB_DESC_ENDPOINT, _epin, (TUSB_XFER_ISOCHRONOUS | TUSB_ISO_EP_ATT_ASYNCHRONOUS | TUSB_ISO_EP_ATT_DATA), TU_U16_LOW(_epsize), TU_U16_HIGH(_epsize), 1
+
+#define ISO_STREAM_DESCRIPTOR_LEN 25
+
+#ifdef T76_IC_USB_CDC_DATA
+#define DATA_CDC_DESC_LEN   TUD_CDC_DESC_LEN
+#else
+#define DATA_CDC_DESC_LEN   0
+#endif
+
+#ifdef T76_IC_USB_ISO_STREAM
+#define ISO_STREAM_DESC_LEN ISO_STREAM_DESCRIPTOR_LEN
+#else
+#define ISO_STREAM_DESC_LEN 0
+#endif
+
+#define CONFIG_TOTAL_LEN    (TUD_CONFIG_DESC_LEN + TUD_CDC_DESC_LEN + RPI_RESET_DESCRIPTOR_LEN + TUD_VENDOR_DESC_LEN + TUD_USBTMC_IF_DESCRIPTOR_LEN + TUD_USBTMC_BULK_DESCRIPTORS_LEN + TUD_USBTMC_INT_DESCRIPTOR_LEN + WINUSB_DESCRIPTOR_LEN + DATA_CDC_DESC_LEN + ISO_STREAM_DESC_LEN)
 
 uint8_t const desc_fs_configuration[] = {
     // Config number, interface count, string index, total length, attribute, power in mA
@@ -88,6 +109,16 @@ uint8_t const desc_fs_configuration[] = {
     TUD_USBTMC_INT_DESCRIPTOR(EPNUM_USBTMC_INT, 64, 0x1),
 
     WINUSB_DESCRIPTOR(ITF_NUM_WINUSB, 8, EPNUM_WINUSB_OUT, EPNUM_WINUSB_IN, ITF_BUFFER_SIZE),
+
+#ifdef T76_IC_USB_CDC_DATA
+    // Second CDC port for binary data, kept apart from the stdio port
+    TUD_CDC_DESCRIPTOR(ITF_NUM_DATA_CDC, 9, EPNUM_DATA_CDC_NOTIF, 8, EPNUM_DATA_CDC_OUT, EPNUM_DATA_CDC_IN, ITF_BUFFER_SIZE),
+#endif
+
+#ifdef T76_IC_USB_ISO_STREAM
+    // Isochronous IN stream, one packet per frame
+    ISO_STREAM_DESCRIPTOR(ITF_NUM_ISO_STREAM, 10, EPNUM_ISO_STREAM_IN, T76_IC_USB_ISO_STREAM_PACKET_SIZE),
+#endif
 };
 
 uint8_t const *tud_descriptor_configuration_cb(uint8_t index) {
@@ -108,6 +139,8 @@ enum {
   VENDOR_INTERFACE,
   USBTMC_INTERFACE,
   WINUSB_INTERFACE,
+  DATA_CDC_INTERFACE,
+  ISO_STREAM_INTERFACE,
   STRING_COUNT
 };
 
@@ -122,6 +155,8 @@ char const* string_desc_arr [] = {
   "Vendor",                         // 6: Vendor Interface
   "USBTMC",                        // 7: USBTMC Interface
   "WinUSB",                        // 8: WinUSB Interface
+  "Data CDC",                      // 9: Data CDC Interface
+  "Iso Stream",                    // 10: Isochronous Stream Interface
 };
 
 static const char *_product_string_override = NULL;
@@ -39,9 +39,18 @@
 #define EPNUM_WINUSB_OUT    0x06
 #define EPNUM_WINUSB_IN     0x86
 
+#define EPNUM_DATA_CDC_NOTIF 0x87
+#define EPNUM_DATA_CDC_OUT   0x08
+#define EPNUM_DATA_CDC_IN    0x88
+
+#define EPNUM_ISO_STREAM_IN  0x89
+
 #define WINUSB_INTERFACE_SUBCLASS 0x01
 #define WINUSB_INTERFACE_PROTOCOL 0x02
 
+#define ISO_STREAM_INTERFACE_SUBCLASS 0x02
+#define ISO_STREAM_INTERFACE_PROTOCOL 0x01
+
 enum {
   ITF_NUM_CDC = 0,
   ITF_NUM_CDC_DATA,
@@ -49,6 +58,13 @@ enum {
   ITF_NUM_VENDOR,
   ITF_NUM_USBTMC,
   ITF_NUM_WINUSB,
+#ifdef T76_IC_USB_CDC_DATA
+  ITF_NUM_DATA_CDC,
+  ITF_NUM_DATA_CDC_DATA,
+#endif
+#ifdef T76_IC_USB_ISO_STREAM
+  ITF_NUM_ISO_STREAM,
+#endif
   ITF_NUM_TOTAL
 };
 
@@ -61,6 +77,9 @@ extern uint8_t const desc_ms_os_20[];
 extern const tusb_desc_webusb_url_t desc_url;
 extern uint8_t reset_interface_number;
 extern uint8_t winusb_interface_number;
+#ifdef T76_IC_USB_ISO_STREAM
+extern uint8_t iso_stream_interface_number;
+#endif
 
 #ifdef __cplusplus
 extern "C" {
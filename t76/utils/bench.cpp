@@ -0,0 +1,190 @@
+/**
+ * @file bench.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the micro-benchmark registry and runner.
+ *
+ * Benchmarks register themselves during static initialization. The list is
+ * built from two pointers that are zero-initialized before any constructor
+ * runs, so registration does not depend on the order in which translation
+ * units are initialized, and benchmarks of a file are listed in the order
+ * in which they are defined.
+ *
+ * Both cores fill the same sample buffer, and core 0 sorts it once the
+ * samples are in. A core 1 run is handed over through gRequest: core 0
+ * publishes the benchmark, core 1 clears the pointer once the samples are
+ * written, and while it is set no other run may touch the buffer.
+ *
+ */
+
+#include "t76/bench.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+#include <log.hpp>
+
+
+using namespace T76::Core::Bench;
+
+
+namespace T76::Core::Bench {
+
+    /**
+     * @brief Calls benchmarks and reads back their timing
+     */
+    class Runner {
+    public:
+        /**
+         * @brief Measure a benchmark on the calling core
+         * @return false if the benchmark did not call State::measure()
+         */
+        static bool T76_CORE1_CODE collect(const Benchmark &benchmark, uint32_t samples, uint32_t *cycles);
+    };
+
+} // namespace T76::Core::Bench
+
+
+namespace {
+
+    constexpr uint32_t warmUpCalls = 4;
+    constexpr uint32_t calibrationCalls = 16;
+
+    const Benchmark *gFirst = nullptr;
+    Benchmark *gLast = nullptr;
+
+    uint32_t gSamples[T76_IC_BENCH_MAX_SAMPLES];
+
+    // Core 1 request, set by core 0 and cleared by core 1 once it has run
+    std::atomic<const Benchmark *> gRequest{nullptr};
+    uint32_t gRequestSamples = 0;
+    bool gRequestMeasured = false;
+
+    /**
+     * @brief Enable the cycle counter of the calling core, unless it already runs
+     *
+     * Leaves the count alone, in case something else, such as the executive, is using it.
+     */
+    void T76_CORE1_CODE enableCycleCounter() {
+        if ((m33_hw->dwt_ctrl & M33_DWT_CTRL_CYCCNTENA_BITS) == 0) {
+            m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+            m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+        }
+    }
+
+} // namespace
+
+
+Benchmark::Benchmark(const char *name, Function function, uint8_t core) : _name(name), _function(function), _core(core) {
+    if (gLast == nullptr) {
+        gFirst = this;
+    } else {
+        gLast->_next = this;
+    }
+
+    gLast = this;
+}
+
+const Benchmark *Benchmark::first() {
+    return gFirst;
+}
+
+const Benchmark *Benchmark::find(std::string_view name) {
+    for (const Benchmark *benchmark = gFirst; benchmark != nullptr; benchmark = benchmark->_next) {
+        if (name == benchmark->_name) {
+            return benchmark;
+        }
+    }
+
+    return nullptr;
+}
+
+bool T76_CORE1_CODE Runner::collect(const Benchmark &benchmark, uint32_t samples, uint32_t *cycles) {
+    enableCycleCounter();
+
+    // Cost of reading the counter around an empty operation
+    State calibration;
+    uint32_t overhead = UINT32_MAX;
+
+    for (uint32_t i = 0; i < calibrationCalls; i++) {
+        calibration.measure([]() {});
+        overhead = std::min(overhead, calibration._cycles);
+    }
+
+    State state;
+
+    for (uint32_t i = 0; i < warmUpCalls + samples; i++) {
+        state._iteration = i;
+        state._measured = false;
+
+        benchmark.function()(state);
+
+        if (!state._measured) {
+            return false;
+        }
+
+        if (i >= warmUpCalls) {
+            cycles[i - warmUpCalls] = state._cycles > overhead ? state._cycles - overhead : 0;
+        }
+    }
+
+    return true;
+}
+
+bool T76::Core::Bench::run(const Benchmark &benchmark, uint32_t samples, Result &result, uint32_t timeoutMs) {
+    if (samples == 0 || samples > T76_IC_BENCH_MAX_SAMPLES || benchmark.core() > 1 ||
+        gRequest.load(std::memory_order_acquire) != nullptr) {
+        return false;
+    }
+
+    if (benchmark.core() == 0) {
+        if (!Runner::collect(benchmark, samples, gSamples)) {
+            return false;
+        }
+    } else {
+        gRequestSamples = samples;
+        gRequest.store(&benchmark, std::memory_order_release);
+
+        const TickType_t start = xTaskGetTickCount();
+
+        while (gRequest.load(std::memory_order_acquire) != nullptr) {
+            if (xTaskGetTickCount() - start >= pdMS_TO_TICKS(timeoutMs)) {
+                LOGE("Bench: core 1 did not run %s within %lu ms\n", benchmark.name(), (unsigned long)timeoutMs);
+                return false;
+            }
+
+            vTaskDelay(1);
+        }
+
+        if (!gRequestMeasured) {
+            return false;
+        }
+    }
+
+    std::sort(gSamples, gSamples + samples);
+
+    result.samples = samples;
+    result.min = gSamples[0];
+    result.median = gSamples[samples / 2];
+    result.p99 = gSamples[(samples * 99 + 99) / 100 - 1];
+    result.max = gSamples[samples - 1];
+
+    return true;
+}
+
+void T76_CORE1_CODE T76::Core::Bench::serviceCore1() {
+    const Benchmark *benchmark = gRequest.load(std::memory_order_acquire);
+
+    if (benchmark == nullptr) {
+        return;
+    }
+
+    gRequestMeasured = Runner::collect(*benchmark, gRequestSamples, gSamples);
+    gRequest.store(nullptr, std::memory_order_release);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file boot_profile.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the boot profile.
+ *
+ * The two profiles and the index of the current one live in the
+ * .uninitialized_data section, so nothing the startup code does clears them.
+ * A magic number tells a power-on, after which their contents are garbage,
+ * from a reset. A timestamp of 0 means that the phase was not reached; a
+ * phase reached at exactly 0 µs is recorded as 1 µs.
+ */
+
+#include "t76/boot_profile.hpp"
+
+#include <t76/placement.hpp>
+
+
+using namespace T76::Core::BootProfile;
+
+
+namespace {
+
+    constexpr uint32_t bootProfileMagic = 0x424f4f54;
+    constexpr std::size_t phaseCount = static_cast<std::size_t>(Phase::Count);
+
+    struct RetainedState {
+        uint32_t magic;                         // bootProfileMagic once initialized
+        uint32_t current;                       // Index of the current profile
+        uint32_t previousValid;                 // Nonzero if the other profile is a previous boot's
+        uint32_t times[2][phaseCount];
+    };
+
+    RetainedState gRetained __attribute__((section(".uninitialized_data"))) __attribute__((aligned(4)));
+
+    constexpr const char *gNames[phaseCount] = {
+        "RUN", "SAFETY", "MEMORY", "USB", "SERVICES", "INIT", "CORE1LAUNCH", "CORE1START",
+        "WATCHDOG", "INITCORE0", "SCHEDULER", "USBCONFIGURED", "FIRSTREQUEST", "FIRSTRESPONSE",
+        "FIRSTMEASUREMENT",
+    };
+
+} // namespace
+
+
+T76_CORE1_DATA std::atomic<uint32_t *> T76::Core::BootProfile::gCurrent{nullptr};
+
+
+void T76::Core::BootProfile::init() {
+    if (gCurrent.load(std::memory_order_relaxed) != nullptr) {
+        return;
+    }
+
+    if (gRetained.magic != bootProfileMagic || gRetained.current > 1) {
+        // Power-on: nothing worth keeping
+        gRetained.magic = bootProfileMagic;
+        gRetained.current = 0;
+        gRetained.previousValid = 0;
+    } else {
+        gRetained.current ^= 1;
+        gRetained.previousValid = 1;
+    }
+
+    for (uint32_t &time : gRetained.times[gRetained.current]) {
+        time = 0;
+    }
+
+    gCurrent.store(gRetained.times[gRetained.current], std::memory_order_release);
+}
+
+uint32_t T76::Core::BootProfile::time(Phase phase, bool previous) {
+    if (gCurrent.load(std::memory_order_acquire) == nullptr || phase >= Phase::Count ||
+        (previous && gRetained.previousValid == 0)) {
+        return 0;
+    }
+
+    return gRetained.times[gRetained.current ^ (previous ? 1 : 0)][static_cast<std::size_t>(phase)];
+}
+
+bool T76::Core::BootProfile::hasPrevious() {
+    return gCurrent.load(std::memory_order_acquire) != nullptr && gRetained.previousValid != 0;
+}
+
+const char *T76::Core::BootProfile::name(Phase phase) {
+    return phase < Phase::Count ? gNames[static_cast<std::size_t>(phase)] : "";
+}
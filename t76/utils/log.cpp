@@ -0,0 +1,396 @@
+/**
+ * @file log.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the deferred log task.
+ *
+ * The task takes one record at a time from each core's ring and outputs the
+ * older of the two, so that lines from both cores come out in the order they
+ * were logged. Records are formatted one conversion at a time: the task walks
+ * the format string, copies each conversion specification into a format of
+ * its own and passes it to snprintf with the argument read back from the
+ * record, using the length modifier to know how many words it takes.
+ *
+ */
+
+#include "t76/deferred_log.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+
+using namespace T76::Core::Log;
+
+
+T76::Core::Log::Ring T76::Core::Log::gRings[2];
+
+
+namespace {
+
+    TaskHandle_t gTask = nullptr;
+
+    SinkFunction gSink = nullptr;
+    void *gSinkContext = nullptr;
+
+    char gLine[T76_IC_LOG_LINE_LENGTH];
+
+    /**
+     * @brief Reads the arguments of a record back, in order
+     */
+    struct ArgumentReader {
+        const Record &record;
+        std::size_t next = 0;
+
+        bool available(std::size_t words) const {
+            return next + words <= record.words;
+        }
+
+        uint32_t word() {
+            return record.arguments[next++];
+        }
+
+        uint64_t wide() {
+            uint64_t value;
+
+            memcpy(&value, &record.arguments[next], sizeof(value));
+            next += 2;
+            return value;
+        }
+    };
+
+    /**
+     * @brief Appends formatted text to the line buffer
+     */
+    struct LineWriter {
+        char *buffer;
+        std::size_t size;
+        std::size_t length = 0;
+
+        void append(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+            if (length >= size - 1) {
+                return;
+            }
+
+            va_list args;
+            va_start(args, format);
+            const int written = vsnprintf(buffer + length, size - length, format, args);
+            va_end(args);
+
+            if (written > 0) {
+                length = std::min(length + static_cast<std::size_t>(written), size - 1);
+            }
+        }
+
+        void appendText(const char *text, std::size_t count) {
+            append("%.*s", static_cast<int>(count), text);
+        }
+
+        bool truncated() const {
+            return length >= size - 1;
+        }
+    };
+
+    // Indexed by the LOG_LEVEL_* values of log.hpp
+    const char *const gLevelNames[] = { "DEBUG", "WARNING", "ERROR", "CRITICAL" };
+
+    const char *levelName(uint8_t level) {
+        return level < std::size(gLevelNames) ? gLevelNames[level] : "?";
+    }
+
+    /**
+     * @brief Number of argument words taken by an integer with a length modifier
+     */
+    std::size_t integerWords(char modifier, bool doubled) {
+        std::size_t size = sizeof(int);
+
+        switch (modifier) {
+            case 'l':
+                size = doubled ? sizeof(long long) : sizeof(long);
+                break;
+
+            case 'j':
+                size = sizeof(intmax_t);
+                break;
+
+            case 'z':
+                size = sizeof(std::size_t);
+                break;
+
+            case 't':
+                size = sizeof(ptrdiff_t);
+                break;
+
+            default:
+                break;
+        }
+
+        return size > sizeof(uint32_t) ? 2 : 1;
+    }
+
+    /**
+     * @brief Format one record into gLine
+     */
+    void formatRecord(const Record &record, uint8_t core) {
+        LineWriter line{gLine, sizeof(gLine)};
+        ArgumentReader reader{record};
+
+        line.append("[%lu.%06lu/%u] [%s] ",
+                    static_cast<unsigned long>(record.timestamp / 1000000),
+                    static_cast<unsigned long>(record.timestamp % 1000000),
+                    core,
+                    levelName(record.level));
+
+        const char *cursor = record.format;
+
+        while (*cursor != '\0' && !line.truncated()) {
+            const char *percent = strchr(cursor, '%');
+
+            if (percent == nullptr) {
+                line.append("%s", cursor);
+                break;
+            }
+
+            line.appendText(cursor, percent - cursor);
+
+            // Collect the specification, leaving out the length modifier, which is applied when reading the argument
+            char spec[24];
+            std::size_t specLength = 0;
+            const char *p = percent + 1;
+
+            spec[specLength++] = '%';
+
+            while (*p != '\0' && strchr("-+ #0123456789.", *p) != nullptr) {
+                if (specLength < sizeof(spec) - 4) {
+                    spec[specLength++] = *p;
+                }
+
+                p++;
+            }
+
+            char modifier = '\0';
+            bool doubled = false;
+
+            if (*p != '\0' && strchr("hlLjzt", *p) != nullptr) {
+                modifier = *p++;
+
+                if ((modifier == 'h' || modifier == 'l') && *p == modifier) {
+                    doubled = true;
+                    p++;
+                }
+            }
+
+            const char conversion = *p;
+
+            if (conversion == '\0') {
+                line.append("%s", percent);
+                break;
+            }
+
+            cursor = p + 1;
+
+            switch (conversion) {
+                case '%':
+                    line.append("%%");
+                    continue;
+
+                case 'd':
+                case 'i':
+                case 'u':
+                case 'o':
+                case 'x':
+                case 'X': {
+                    const std::size_t words = integerWords(modifier, doubled);
+
+                    if (!reader.available(words)) {
+                        break;
+                    }
+
+                    const bool isSigned = conversion == 'd' || conversion == 'i';
+
+                    if (words == 2) {
+                        spec[specLength++] = 'l';
+                        spec[specLength++] = 'l';
+                        spec[specLength++] = conversion;
+                        spec[specLength] = '\0';
+
+                        const uint64_t value = reader.wide();
+
+                        if (isSigned) {
+                            line.append(spec, static_cast<long long>(value));
+                        } else {
+                            line.append(spec, static_cast<unsigned long long>(value));
+                        }
+                    } else {
+                        // Narrow the value as printf would for hh and h
+                        if (modifier == 'h') {
+                            spec[specLength++] = 'h';
+
+                            if (doubled) {
+                                spec[specLength++] = 'h';
+                            }
+                        }
+
+                        spec[specLength++] = conversion;
+                        spec[specLength] = '\0';
+
+                        const uint32_t value = reader.word();
+
+                        if (isSigned) {
+                            line.append(spec, static_cast<int>(value));
+                        } else {
+                            line.append(spec, static_cast<unsigned int>(value));
+                        }
+                    }
+
+                    continue;
+                }
+
+                case 'c':
+                    if (!reader.available(1)) {
+                        break;
+                    }
+
+                    spec[specLength++] = 'c';
+                    spec[specLength] = '\0';
+                    line.append(spec, static_cast<int>(reader.word()));
+                    continue;
+
+                case 'f':
+                case 'F':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                case 'a':
+                case 'A': {
+                    if (!reader.available(2)) {
+                        break;
+                    }
+
+                    const uint64_t bits = reader.wide();
+                    double value;
+
+                    memcpy(&value, &bits, sizeof(value));
+
+                    spec[specLength++] = conversion;
+                    spec[specLength] = '\0';
+                    line.append(spec, value);
+                    continue;
+                }
+
+                case 's':
+                case 'p': {
+                    constexpr std::size_t words = sizeof(uintptr_t) > sizeof(uint32_t) ? 2 : 1;
+
+                    if (!reader.available(words)) {
+                        break;
+                    }
+
+                    const uintptr_t address = words == 2 ? static_cast<uintptr_t>(reader.wide()) : reader.word();
+
+                    spec[specLength++] = conversion;
+                    spec[specLength] = '\0';
+
+                    if (conversion == 's') {
+                        const char *text = reinterpret_cast<const char *>(address);
+                        line.append(spec, text != nullptr ? text : "(null)");
+                    } else {
+                        line.append(spec, reinterpret_cast<void *>(address));
+                    }
+
+                    continue;
+                }
+
+                default:
+                    break;
+            }
+
+            // Unsupported conversion, or missing argument: show the specification as written
+            line.appendText(percent, cursor - percent);
+        }
+
+        // Keep lines apart even when a message was cut short
+        if (line.truncated()) {
+            gLine[sizeof(gLine) - 2] = '\n';
+        }
+    }
+
+    void output(const char *text) {
+        if (gSink != nullptr) {
+            gSink(gSinkContext, text);
+        } else {
+            fputs(text, stdout);
+        }
+    }
+
+    void logTask(void *) {
+        Record pending[2];
+        bool hasPending[2] = { false, false };
+        uint32_t reportedDrops = 0;
+
+        for (;;) {
+            for (;;) {
+                for (std::size_t core = 0; core < 2; core++) {
+                    if (!hasPending[core]) {
+                        hasPending[core] = gRings[core].tryPop(pending[core]);
+                    }
+                }
+
+                if (!hasPending[0] && !hasPending[1]) {
+                    break;
+                }
+
+                // Output the older record first; the signed difference handles the timer wrapping
+                std::size_t core = hasPending[0] ? 0 : 1;
+
+                if (hasPending[0] && hasPending[1] && static_cast<int32_t>(pending[1].timestamp - pending[0].timestamp) < 0) {
+                    core = 1;
+                }
+
+                formatRecord(pending[core], static_cast<uint8_t>(core));
+                output(gLine);
+                hasPending[core] = false;
+            }
+
+            const uint32_t drops = droppedCount();
+
+            if (drops != reportedDrops) {
+                snprintf(gLine, sizeof(gLine), "[WARNING] %lu log records dropped\n", static_cast<unsigned long>(drops - reportedDrops));
+                output(gLine);
+                reportedDrops = drops;
+            }
+
+            vTaskDelay(pdMS_TO_TICKS(T76_IC_LOG_DRAIN_PERIOD_MS));
+        }
+    }
+
+} // namespace
+
+
+bool T76::Core::Log::init() {
+    if (gTask != nullptr) {
+        return true;
+    }
+
+    if (xTaskCreate(logTask, "Log", T76_IC_LOG_TASK_STACK_SIZE, nullptr, T76_IC_LOG_TASK_PRIORITY, &gTask) != pdPASS) {
+        gTask = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void T76::Core::Log::setSink(SinkFunction sink, void *context) {
+    gSinkContext = context;
+    gSink = sink;
+}
+
+uint32_t T76::Core::Log::droppedCount() {
+    return static_cast<uint32_t>(gRings[0].droppedCount() + gRings[1].droppedCount());
+}
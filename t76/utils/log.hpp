@@ -14,12 +14,24 @@
  * - `LOG_LEVEL_ERROR`: Error messages
  * - `LOG_LEVEL_CRITICAL`: Critical messages (highest level, least verbose)
  * 
+ * When the `T76_IC_LOG_DEFERRED` CMake option is on (the default), the macros
+ * do not call printf. They queue the format string and the arguments, and a
+ * background task formats and outputs them later (see <t76/deferred_log.hpp>),
+ * so that a log call is cheap enough for interrupt handlers and core 1. The
+ * format string, and any string passed for `%s`, must then stay valid after
+ * the call, as string literals do. The compiler still checks the arguments
+ * against the format string in both modes.
+ * 
  */
 
 #pragma once
 
 #include <cstdio>
 
+#ifdef T76_IC_LOG_DEFERRED
+#include "t76/deferred_log.hpp"
+#endif
+
 
 // Define log levels
 #define LOG_LEVEL_DEBUG     0
@@ -33,32 +45,48 @@
 #define LOG_LEVEL LOG_LEVEL_CRITICAL
 #endif
 
+// Output of a message at a given level
+
+#ifdef T76_IC_LOG_DEFERRED
+// The unreachable printf keeps the compiler's format checks
+#define T76_LOG(level, tag, fmt, ...) \
+    do { \
+        if (false) { \
+            printf(fmt, ##__VA_ARGS__); \
+        } \
+        T76::Core::Log::record(level, fmt, ##__VA_ARGS__); \
+    } while (0)
+#else
+#define T76_LOG(level, tag, fmt, ...) \
+    printf("[" tag "] " fmt, ##__VA_ARGS__)
+#endif
+
 // Logging macros
 
 #if LOG_LEVEL <= LOG_LEVEL_DEBUG
 #define LOGD(fmt, ...) \
-    printf("[DEBUG] " fmt, ##__VA_ARGS__)
+    T76_LOG(LOG_LEVEL_DEBUG, "DEBUG", fmt, ##__VA_ARGS__)
 #else
 #define LOGD(fmt, ...)
 #endif
 
 #if LOG_LEVEL <= LOG_LEVEL_WARNING
 #define LOGW(fmt, ...) \
-    printf("[WARNING] " fmt, ##__VA_ARGS__)
+    T76_LOG(LOG_LEVEL_WARNING, "WARNING", fmt, ##__VA_ARGS__)
 #else
 #define LOGW(fmt, ...)
 #endif  
 
 #if LOG_LEVEL <= LOG_LEVEL_ERROR
 #define LOGE(fmt, ...) \
-    printf("[ERROR] " fmt, ##__VA_ARGS__)
+    T76_LOG(LOG_LEVEL_ERROR, "ERROR", fmt, ##__VA_ARGS__)
 #else
 #define LOGE(fmt, ...)
 #endif
 
 #if LOG_LEVEL <= LOG_LEVEL_CRITICAL
 #define LOGC(fmt, ...) \
-    printf("[CRITICAL] " fmt, ##__VA_ARGS__)
+    T76_LOG(LOG_LEVEL_CRITICAL, "CRITICAL", fmt, ##__VA_ARGS__)
 #else
 #define LOGC(fmt, ...)
 #endif
@@ -0,0 +1,17 @@
+# Configurable options for the utilities library
+
+option(T76_IC_CORE1_IN_SRAM "Run designated core 1 code from SRAM and place its data in the scratch banks" ON)
+
+option(T76_IC_SMP "Run the FreeRTOS SMP kernel on both cores instead of FreeRTOS on core 0 and bare-metal code on core 1" OFF)
+
+option(T76_IC_LOG_DEFERRED "Have the LOG macros queue their arguments and format them in a background task instead of calling printf in the caller" ON)
+set(T76_IC_LOG_RING_SIZE 64 CACHE STRING "Number of log records each core can queue before records are dropped; must be a power of two")
+set(T76_IC_LOG_MAX_ARGUMENT_WORDS 6 CACHE STRING "Maximum size of the arguments of one log call, in 32-bit words; doubles and 64-bit integers take two")
+set(T76_IC_LOG_LINE_LENGTH 128 CACHE STRING "Longest formatted log line, including the timestamp and level (bytes)")
+set(T76_IC_LOG_DRAIN_PERIOD_MS 10 CACHE STRING "Interval at which the log task outputs queued records (milliseconds)")
+set(T76_IC_LOG_TASK_PRIORITY 1 CACHE STRING "FreeRTOS priority of the task that formats log records")
+set(T76_IC_LOG_TASK_STACK_SIZE "(configMINIMAL_STACK_SIZE * 4)" CACHE STRING "Stack size of the task that formats log records")
+
+set(T76_IC_BENCH_MAX_SAMPLES 512 CACHE STRING "Largest number of samples a micro-benchmark run can measure; each takes 4 bytes of RAM")
+
+set(T76_IC_TIMEBASE_SYNC_POINTS 8 CACHE STRING "Number of recent host time sync points the clock offset and drift are fitted to")
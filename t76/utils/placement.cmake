@@ -0,0 +1,26 @@
+set(T76_UTILS_MODULE_DIR "${CMAKE_CURRENT_LIST_DIR}" CACHE INTERNAL "instrument-core utilities module directory")
+
+# Write <target>.placement.txt next to the firmware image after every build,
+# listing the code in SRAM and the contents of the scratch banks, and check
+# that the framework's core 1 paths and any EXPECT functions are not in flash
+function(t76_add_placement_report target)
+    cmake_parse_arguments(T76_PLACEMENT "" "" "EXPECT" ${ARGN})
+
+    find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+    set(expect_args "")
+    foreach(symbol IN LISTS T76_PLACEMENT_EXPECT)
+        list(APPEND expect_args --expect "${symbol}")
+    endforeach()
+
+    add_custom_command(TARGET ${target} POST_BUILD
+        COMMAND ${Python3_EXECUTABLE}
+            ${T76_UTILS_MODULE_DIR}/placement_report.py
+            --objdump ${CMAKE_OBJDUMP}
+            --output $<TARGET_FILE_DIR:${target}>/${target}.placement.txt
+            ${expect_args}
+            $<TARGET_FILE:${target}>
+        COMMENT "Reporting code and data placement for ${target}"
+        VERBATIM
+    )
+endfunction()
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""
+Report where code and data ended up in an RP2350 firmware image.
+
+Reads the symbol table of an ELF file with objdump and lists the functions
+that run from SRAM, the objects in the SCRATCH_X and SCRATCH_Y banks, and how
+much of each bank is in use. It then checks that the framework's core 1 paths,
+and any symbols passed with --expect, were placed in SRAM rather than flash,
+and reports every one that was not.
+
+The report is written to --output (or printed), and a one-line summary is
+always printed so that it shows up in the build log.
+"""
+
+import argparse
+import subprocess
+import sys
+
+
+FLASH_START = 0x10000000
+FLASH_END = 0x12000000
+SRAM_START = 0x20000000
+SCRATCH_X_START = 0x20080000
+SCRATCH_Y_START = 0x20081000
+SCRATCH_END = 0x20082000
+
+# Framework functions that run on core 1 in every application
+FRAMEWORK_CORE1_SYMBOLS = [
+    "T76::Core::Safety::feedWatchdogFromCore1",
+    "T76::Core::Executive::tick",
+    "T76::Core::InterCore::ChannelBase::_notify",
+]
+
+
+def read_symbols(objdump, elf):
+    """Return (address, size, kind, section, name) for every sized symbol."""
+    output = subprocess.run([objdump, "-t", "-C", elf], check=True, capture_output=True, text=True).stdout
+    symbols = []
+
+    for line in output.splitlines():
+        # 20000110 g     F .data	00000044 name
+        if "\t" not in line:
+            continue
+
+        left, right = line.split("\t", 1)
+        fields = left.split()
+        size_and_name = right.split(None, 1)
+
+        if len(fields) < 2 or len(size_and_name) < 2:
+            continue
+
+        try:
+            address = int(fields[0], 16)
+            size = int(size_and_name[0], 16)
+        except ValueError:
+            continue
+
+        if size == 0:
+            continue
+
+        kind = "F" if "F" in fields[1:-1] else "O"
+        symbols.append((address, size, kind, fields[-1], size_and_name[1].strip()))
+
+    return symbols
+
+
+def region(address):
+    if FLASH_START <= address < FLASH_END:
+        return "flash"
+    if SCRATCH_X_START <= address < SCRATCH_Y_START:
+        return "scratch_x"
+    if SCRATCH_Y_START <= address < SCRATCH_END:
+        return "scratch_y"
+    if SRAM_START <= address < SCRATCH_X_START:
+        return "sram"
+    return "other"
+
+
+def base_name(name):
+    """Strip the parameter list from a demangled name."""
+    return name.split("(", 1)[0]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware image")
+    parser.add_argument("--objdump", default="arm-none-eabi-objdump", help="objdump executable")
+    parser.add_argument("--output", help="file to write the report to")
+    parser.add_argument("--expect", action="append", default=[], help="function that must run from SRAM (repeatable)")
+    args = parser.parse_args()
+
+    symbols = read_symbols(args.objdump, args.elf)
+
+    sram_code = sorted((s for s in symbols if s[2] == "F" and region(s[0]) == "sram"), key=lambda s: -s[1])
+    scratch = {bank: sorted((s for s in symbols if region(s[0]) == bank), key=lambda s: s[0])
+               for bank in ("scratch_x", "scratch_y")}
+
+    lines = []
+    lines.append("Code in SRAM: %d functions, %d bytes" % (len(sram_code), sum(s[1] for s in sram_code)))
+
+    for address, size, _, _, name in sram_code:
+        lines.append("  %08x %6d  %s" % (address, size, name))
+
+    for bank, entries in scratch.items():
+        used = (max(s[0] + s[1] for s in entries) - min(s[0] for s in entries)) if entries else 0
+        lines.append("")
+        lines.append("%s: %d of 4096 bytes spanned, including stacks" % (bank.upper(), used))
+
+        for address, size, kind, _, name in entries:
+            lines.append("  %08x %6d %s %s" % (address, size, kind, name))
+
+    # Check the functions that are expected to run from SRAM
+    expected = FRAMEWORK_CORE1_SYMBOLS + args.expect
+    functions = {}
+
+    for address, _, kind, _, name in symbols:
+        if kind == "F":
+            functions.setdefault(base_name(name), []).append(address)
+
+    misplaced = []
+    lines.append("")
+    lines.append("Core 1 paths:")
+
+    for name in expected:
+        if name not in functions:
+            lines.append("  not linked  %s" % name)
+            continue
+
+        places = sorted(set(region(address) for address in functions[name]))
+        lines.append("  %-10s  %s" % (",".join(places), name))
+
+        if places != ["sram"]:
+            misplaced.append(name)
+
+    report = "\n".join(lines) + "\n"
+
+    if args.output:
+        with open(args.output, "w") as file:
+            file.write(report)
+    else:
+        sys.stdout.write(report)
+
+    summary = "Placement: %d bytes of code in SRAM, %d symbols in SCRATCH_X, %d in SCRATCH_Y" % (
+        sum(s[1] for s in sram_code), len(scratch["scratch_x"]), len(scratch["scratch_y"]))
+
+    if misplaced:
+        summary += "; not in SRAM: " + ", ".join(misplaced)
+
+    print(summary)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,206 @@
+/**
+ * @file bench.hpp
+ * @brief Registry of micro-benchmarks timed with the DWT cycle counter
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * A benchmark is a function that does one operation per call and times it
+ * with State::measure(), leaving any setup and cleanup outside:
+ *
+ *     T76_BENCH(memory_alloc_64) {
+ *         void *block;
+ *
+ *         state.measure([&]() { block = malloc(64); });
+ *         free(block);
+ *     }
+ *
+ *     T76_BENCH_CORE1(safety_feed_watchdog) {
+ *         state.measure([]() { T76::Core::Safety::feedWatchdogFromCore1(); });
+ *     }
+ *
+ * The macros register the benchmark when the program starts, so an
+ * application adds its own by defining them in any source file. Benchmarks
+ * declared with T76_BENCH_CORE1() are placed in SRAM with T76_CORE1_CODE and
+ * run on core 1.
+ *
+ * run() calls a benchmark a few times to warm the caches, then once per
+ * sample, and reports the minimum, median, 99th percentile and maximum in
+ * CPU cycles, less the cost of reading the counter. Core 0 benchmarks run in
+ * the calling task and can be preempted, which shows in the 99th percentile
+ * and the maximum. Core 1 benchmarks run the next time core 1 calls
+ * serviceCore1(), which the application calls from its core 1 loop.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <hardware/structs/m33.h>
+
+#include <t76/placement.hpp>
+
+#ifndef T76_IC_BENCH_MAX_SAMPLES
+#define T76_IC_BENCH_MAX_SAMPLES 512
+#endif
+
+
+namespace T76::Core::Bench {
+
+    /**
+     * @brief Timing of one call of a benchmark
+     */
+    class State {
+    public:
+        /**
+         * @brief Time an operation
+         *
+         * Must be called once per call of the benchmark. The compiler is not
+         * allowed to move memory accesses into or out of the timed region.
+         */
+        template<typename Operation>
+        inline __attribute__((always_inline)) void measure(Operation &&operation) {
+            asm volatile("" ::: "memory");
+            const uint32_t start = m33_hw->dwt_cyccnt;
+            asm volatile("" ::: "memory");
+
+            operation();
+
+            asm volatile("" ::: "memory");
+            const uint32_t end = m33_hw->dwt_cyccnt;
+            asm volatile("" ::: "memory");
+
+            _cycles = end - start;
+            _measured = true;
+        }
+
+        /**
+         * @brief Index of the current call, counting the warm-up calls
+         */
+        uint32_t iteration() const {
+            return _iteration;
+        }
+
+        /**
+         * @brief Keep the compiler from optimizing away a value computed by the operation
+         */
+        template<typename T>
+        static inline __attribute__((always_inline)) void keep(const T &value) {
+            asm volatile("" : : "r,m"(value) : "memory");
+        }
+
+    protected:
+        friend class Runner;
+
+        uint32_t _iteration = 0;
+        uint32_t _cycles = 0;
+        bool _measured = false;
+    };
+
+    /**
+     * @brief Body of a benchmark
+     */
+    using Function = void (*)(State &state);
+
+    /**
+     * @brief A registered benchmark
+     *
+     * Usually declared through T76_BENCH() or T76_BENCH_CORE1(); constructing
+     * one adds it to the registry, so it must have static storage duration.
+     */
+    class Benchmark {
+    public:
+        Benchmark(const char *name, Function function, uint8_t core);
+
+        Benchmark(const Benchmark&) = delete;
+        Benchmark& operator=(const Benchmark&) = delete;
+
+        /**
+         * @brief First registered benchmark, or nullptr if there are none
+         */
+        static const Benchmark *first();
+
+        /**
+         * @brief Find a benchmark by name
+         * @return The benchmark, or nullptr if there is none with that name
+         */
+        static const Benchmark *find(std::string_view name);
+
+        /**
+         * @brief Next registered benchmark, or nullptr after the last one
+         */
+        const Benchmark *next() const {
+            return _next;
+        }
+
+        const char *name() const {
+            return _name;
+        }
+
+        Function function() const {
+            return _function;
+        }
+
+        uint8_t core() const {
+            return _core;
+        }
+
+    protected:
+        const char *_name;
+        Function _function;
+        uint8_t _core;
+        const Benchmark *_next = nullptr;
+    };
+
+    /**
+     * @brief Statistics of a run, in CPU cycles
+     */
+    struct Result {
+        uint32_t samples;       ///< Calls measured, not counting the warm-up calls
+        uint32_t min;
+        uint32_t median;
+        uint32_t p99;           ///< 99th percentile
+        uint32_t max;
+    };
+
+    /**
+     * @brief Run a benchmark and compute its statistics
+     * @param benchmark The benchmark
+     * @param samples Calls to measure, up to T76_IC_BENCH_MAX_SAMPLES
+     * @param result Where to store the statistics
+     * @param timeoutMs Time to wait for core 1 to run a core 1 benchmark
+     * @return false if samples is out of range, the benchmark did not call
+     *         State::measure(), or core 1 did not run it in time
+     *
+     * Must be called from a task on core 0, by one task at a time. After a
+     * timeout, the core 1 benchmark is still pending, and every other run
+     * fails until core 1 has run it.
+     */
+    bool run(const Benchmark &benchmark, uint32_t samples, Result &result, uint32_t timeoutMs = 5000);
+
+    /**
+     * @brief Run the core 1 benchmark requested by run(), if any
+     *
+     * Called on core 1, from its main loop or a background job. Returns
+     * immediately when there is nothing to do.
+     */
+    void T76_CORE1_CODE serviceCore1();
+
+} // namespace T76::Core::Bench
+
+
+#define T76_BENCH_DEFINE(name, core, placement) \
+    static void placement t76Bench_##name(T76::Core::Bench::State &state); \
+    static T76::Core::Bench::Benchmark t76BenchEntry_##name(#name, t76Bench_##name, core); \
+    static void placement t76Bench_##name([[maybe_unused]] T76::Core::Bench::State &state)
+
+/**
+ * @brief Define and register a benchmark that runs on core 0
+ */
+#define T76_BENCH(name) T76_BENCH_DEFINE(name, 0, )
+
+/**
+ * @brief Define and register a benchmark that runs on core 1, from SRAM
+ */
+#define T76_BENCH_CORE1(name) T76_BENCH_DEFINE(name, 1, T76_CORE1_CODE)
@@ -0,0 +1,111 @@
+/**
+ * @file boot_profile.hpp
+ * @brief Timestamps of the phases of startup, kept across a reset
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * App::run() marks each step of the startup sequence as it completes, and
+ * the USB interface marks when the host configures the device and when the
+ * first request and response go through, so the time from reset until the
+ * instrument answers can be read back and broken down:
+ *
+ *     T76::Core::BootProfile::mark(T76::Core::BootProfile::Phase::FirstMeasurement);   // In the control loop
+ *
+ *     const uint32_t us = T76::Core::BootProfile::time(T76::Core::BootProfile::Phase::FirstResponse);
+ *
+ * Times are in microseconds since reset. Only the first mark of a phase
+ * counts, and mark() is inlined, so marking a phase in a loop costs a couple
+ * of loads and a comparison, and can be done from code placed in SRAM.
+ *
+ * The timestamps live in uninitialized RAM, like the flight recorder, and
+ * the ones of the previous boot are kept until the next one, so a boot that
+ * hung or faulted part of the way through can be examined after the reset.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <hardware/timer.h>
+
+
+namespace T76::Core::BootProfile {
+
+    /**
+     * @brief Phases of startup, in the order App::run() normally reaches them
+     */
+    enum class Phase : uint8_t {
+        Run,                ///< App::run() entered
+        Safety,             ///< Safety system initialized
+        Memory,             ///< Memory management initialized
+        USB,                ///< USB interface initialized and the controller attached
+        Services,           ///< Log, trace, task monitor, flash service and settings initialized
+        Init,               ///< App::_init() returned
+        Core1Launch,        ///< Core 1 launched
+        Core1Start,         ///< Core 1 about to call App::_startCore1()
+        Watchdog,           ///< Dual-core watchdog initialized
+        InitCore0,          ///< App::_initCore0() returned, just before the scheduler starts
+        Scheduler,          ///< First task running
+        USBConfigured,      ///< Host configured the device
+        FirstRequest,       ///< First USBTMC message received
+        FirstResponse,      ///< First USBTMC response sent
+        FirstMeasurement,   ///< Marked by the application
+        Count,
+    };
+
+    /**
+     * @brief Timestamps of the current profile, indexed by phase, or nullptr before init()
+     */
+    extern std::atomic<uint32_t *> gCurrent;
+
+    /**
+     * @brief Start a new profile
+     *
+     * Called first thing by App::run(). Keeps the previous boot's profile,
+     * unless this is a power-on, and clears the current one.
+     */
+    void init();
+
+    /**
+     * @brief Record that a phase has been reached, unless it already has
+     *
+     * Does nothing before init(). Safe to call from any core and from
+     * interrupt handlers; when two cores mark the same phase at once, either
+     * time is kept.
+     */
+    inline __attribute__((always_inline)) void mark(Phase phase) {
+        uint32_t *times = gCurrent.load(std::memory_order_acquire);
+
+        if (times == nullptr) {
+            return;
+        }
+
+        uint32_t &time = times[static_cast<std::size_t>(phase)];
+
+        if (time == 0) {
+            const uint32_t now = time_us_32();
+            time = now != 0 ? now : 1;
+        }
+    }
+
+    /**
+     * @brief Get the time at which a phase was reached
+     * @param phase The phase
+     * @param previous Whether to read the previous boot's profile
+     * @return Microseconds since reset, or 0 if the phase was not reached
+     */
+    uint32_t time(Phase phase, bool previous = false);
+
+    /**
+     * @brief Whether the profile of a previous boot is available
+     */
+    bool hasPrevious();
+
+    /**
+     * @brief Get the name of a phase, in upper case
+     */
+    const char *name(Phase phase);
+
+} // namespace T76::Core::BootProfile
@@ -0,0 +1,154 @@
+/**
+ * @file deferred_log.hpp
+ * @brief Logging that defers formatting to a background task
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * A log call only stores a pointer to its format string, a timestamp and its
+ * raw arguments in a lock-free ring belonging to the calling core, which takes
+ * a few tens of cycles and never blocks. A low-priority FreeRTOS task takes
+ * the records from both rings in timestamp order, formats them and hands the
+ * resulting lines to a sink, by default stdout. Log calls can therefore be
+ * made from interrupt handlers, from core 1 and from time-critical code.
+ *
+ * Because formatting happens later, every argument is copied by value except
+ * strings: a `%s` argument must point to a string that stays valid, such as a
+ * string literal. Field widths and precisions given with `*` are not
+ * supported.
+ *
+ * The LOGD/LOGW/LOGE/LOGC macros in log.hpp use this backend when the
+ * T76_IC_LOG_DEFERRED CMake option is on.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <pico/platform.h>
+
+#include "t76/ring_queue.hpp"
+#include "t76/timebase.hpp"
+
+
+namespace T76::Core::Log {
+
+    /**
+     * @brief Function that receives each formatted log line
+     * @param context The context pointer passed to setSink()
+     * @param line The formatted line, including the timestamp and level
+     */
+    using SinkFunction = void (*)(void *context, const char *line);
+
+    /**
+     * @brief A log call, as stored until it is formatted
+     */
+    struct Record {
+        const char *format;                                 ///< Format string; must stay valid
+        uint32_t timestamp;                                 ///< Timebase::now32() at the call
+        uint8_t level;                                      ///< LOG_LEVEL_* of the call
+        uint8_t words;                                      ///< Number of argument words used
+        uint32_t arguments[T76_IC_LOG_MAX_ARGUMENT_WORDS];  ///< Arguments, packed as printf would read them
+    };
+
+    using Ring = Utils::MPSCRingQueue<Record, T76_IC_LOG_RING_SIZE, Utils::OverflowPolicy::DropNewest>;
+
+    /**
+     * @brief The log rings of core 0 and core 1
+     */
+    extern Ring gRings[2];
+
+    /**
+     * @brief Start the task that formats and outputs log records
+     * @return true if the task was created
+     *
+     * Called by App::run(). Records logged before are kept until the task
+     * starts, as long as the rings do not overflow.
+     */
+    bool init();
+
+    /**
+     * @brief Send formatted log lines somewhere other than stdout
+     * @param sink Function that receives each line, or nullptr for stdout
+     * @param context Passed to the sink
+     */
+    void setSink(SinkFunction sink, void *context);
+
+    /**
+     * @brief Get the number of records dropped because a ring was full
+     */
+    uint32_t droppedCount();
+
+    /**
+     * @brief Number of argument words an argument of a given type occupies
+     */
+    template<typename T>
+    constexpr std::size_t argumentWords() {
+        using U = std::decay_t<T>;
+
+        if constexpr (std::is_floating_point_v<U>) {
+            return sizeof(double) / sizeof(uint32_t);       // Promoted to double, as for printf
+        } else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+            return sizeof(U) > sizeof(uint32_t) ? 2 : 1;
+        } else {
+            static_assert(std::is_pointer_v<U> || std::is_null_pointer_v<U>, "Log arguments must be numbers or pointers");
+            return sizeof(uintptr_t) > sizeof(uint32_t) ? 2 : 1;
+        }
+    }
+
+    /**
+     * @brief Append one argument to a record
+     */
+    template<typename T>
+    inline __attribute__((always_inline)) void packArgument(uint32_t *&cursor, T value) {
+        using U = std::decay_t<T>;
+
+        if constexpr (std::is_floating_point_v<U>) {
+            const double promoted = static_cast<double>(value);
+            memcpy(cursor, &promoted, sizeof(promoted));
+            cursor += 2;
+        } else if constexpr (std::is_enum_v<U>) {
+            packArgument(cursor, static_cast<std::underlying_type_t<U>>(value));
+        } else if constexpr (std::is_integral_v<U> && sizeof(U) > sizeof(uint32_t)) {
+            const uint64_t wide = static_cast<uint64_t>(value);
+            memcpy(cursor, &wide, sizeof(wide));
+            cursor += 2;
+        } else if constexpr (std::is_integral_v<U>) {
+            // Sign-extended like a promoted int, so that %d and %u both read the right value
+            *cursor++ = std::is_signed_v<U> ? static_cast<uint32_t>(static_cast<int32_t>(value)) : static_cast<uint32_t>(value);
+        } else if constexpr (std::is_null_pointer_v<U>) {
+            packArgument(cursor, uintptr_t(0));
+        } else {
+            packArgument(cursor, reinterpret_cast<uintptr_t>(value));
+        }
+    }
+
+    /**
+     * @brief Queue a log record on the calling core's ring
+     * @param level LOG_LEVEL_* of the message
+     * @param format printf-style format string; must stay valid
+     * @param arguments Arguments matching the format
+     *
+     * Never blocks; if the ring is full, the record is dropped and counted.
+     */
+    template<typename... Arguments>
+    inline __attribute__((always_inline)) void record(uint8_t level, const char *format, Arguments... arguments) {
+        constexpr std::size_t words = (std::size_t(0) + ... + argumentWords<Arguments>());
+        static_assert(words <= T76_IC_LOG_MAX_ARGUMENT_WORDS, "Too many log arguments; raise T76_IC_LOG_MAX_ARGUMENT_WORDS");
+
+        Record entry;
+        uint32_t *cursor = entry.arguments;
+
+        entry.format = format;
+        entry.timestamp = T76::Core::Timebase::now32();
+        entry.level = level;
+        entry.words = static_cast<uint8_t>(words);
+        (packArgument(cursor, arguments), ...);
+        (void)cursor; // Unused by calls without arguments
+
+        gRings[get_core_num()].push(entry);
+    }
+
+} // namespace T76::Core::Log
@@ -11,7 +11,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <deque>
+#include <iterator>
+#include <optional>
 
 #include "FreeRTOS.h"
 #include "semphr.h"
@@ -115,6 +118,100 @@ namespace T76::Core::Utils {
             return true;
         }
 
+        /**
+         * @brief Push a range of elements to the back of the queue
+         * @tparam InputIt Input iterator type
+         * @param first Iterator to the first element to add
+         * @param last Iterator past the last element to add
+         * @return true if the operation was successful, false if mutex acquisition failed
+         *
+         * All elements are added under a single mutex acquisition. If the queue
+         * fills up, the oldest elements are discarded in the same way as by
+         * push(), so only the last maxSize elements of the queue and the range
+         * combined are kept. Use std::make_move_iterator() to move the elements
+         * out of the range.
+         */
+        template<typename InputIt>
+        bool pushRange(InputIt first, InputIt last) {
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+            for (; first != last; ++first) {
+                if (_queue.size() == _maxSize) {
+                    _queue.pop_front();
+                    _droppedCount++;
+                }
+                _queue.push_back(*first);
+            }
+
+            xSemaphoreGive(_mutex);
+            return true;
+        }
+
+        /**
+         * @brief Pop the element at the front of the queue
+         * @return The popped element, or std::nullopt if the queue is empty or mutex acquisition failed
+         *
+         * The element is moved out of the queue, so unlike tryPop() the caller
+         * does not need a default-constructed element to assign into.
+         */
+        std::optional<T> pop() {
+            std::optional<T> result;
+
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return result;
+
+            if (!_queue.empty()) {
+                result.emplace(std::move(_queue.front()));
+                _queue.pop_front();
+            }
+
+            xSemaphoreGive(_mutex);
+            return result;
+        }
+
+        /**
+         * @brief Remove all elements from the queue and return them
+         * @return The elements, oldest first; empty if the queue is empty or mutex acquisition failed
+         *
+         * The queue's storage is swapped out rather than copied, so this takes
+         * constant time under the mutex regardless of the number of elements.
+         */
+        std::deque<T> popAll() {
+            std::deque<T> result;
+
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return result;
+
+            result.swap(_queue);
+
+            xSemaphoreGive(_mutex);
+            return result;
+        }
+
+        /**
+         * @brief Move elements from the front of the queue to the back of a container
+         * @tparam Container Type of the container; must provide push_back()
+         * @param container The container to append the elements to
+         * @param maxCount Maximum number of elements to move
+         * @return The number of elements moved, 0 if the queue is empty or mutex acquisition failed
+         *
+         * All elements are moved under a single mutex acquisition, so a
+         * consumer can drain the queue without paying one lock per element.
+         */
+        template<typename Container>
+        std::size_t drainInto(Container& container, std::size_t maxCount = SIZE_MAX) {
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return 0;
+
+            std::size_t count = 0;
+
+            while (count < maxCount && !_queue.empty()) {
+                container.push_back(std::move(_queue.front()));
+                _queue.pop_front();
+                count++;
+            }
+
+            xSemaphoreGive(_mutex);
+            return count;
+        }
+
         /**
          * @brief Check if the queue is empty
          * @return true if the queue is empty, false otherwise
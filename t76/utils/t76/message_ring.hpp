@@ -0,0 +1,430 @@
+/**
+ * @file message_ring.hpp
+ * @brief Fixed-size thread-safe byte ring with message boundaries
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * This file implements a statically sized byte ring that stores a sequence of
+ * variable-length messages back to back. Message boundaries are kept as a
+ * separate table of end offsets, so writing a message never allocates and the
+ * number of bytes in flight is limited only by the size of the ring.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+
+namespace T76::Core::Utils {
+
+    /**
+     * @brief Callback that writes part of a message directly into a ring
+     * @param context The context pointer passed along with the callback
+     * @param destination Where to write the bytes
+     * @param offset The offset in the written data of the first byte to write
+     * @param length The number of bytes to write
+     */
+    using MessageFillFunction = void (*)(void *context, uint8_t *destination, std::size_t offset, std::size_t length);
+
+    /**
+     * @brief A thread-safe byte ring that stores complete messages
+     * @tparam Capacity Size of the ring in bytes, must be a power of two
+     * @tparam MaxMessages Maximum number of complete messages that can be queued
+     *
+     * Producers append bytes to an open message with write() and close it with
+     * endMessage(); a message only becomes visible to the consumer once it is
+     * closed. If a message does not fit in the ring, the whole message is
+     * discarded and counted in droppedCount(), so the consumer never sees a
+     * truncated message.
+     *
+     * The consumer reads the oldest message in place with peek(), which returns
+     * the largest contiguous chunk available, and releases it with consume().
+     * Because the data is read in place, a peeked chunk remains valid until it
+     * is consumed or the ring is cleared.
+     */
+    template<std::size_t Capacity, std::size_t MaxMessages>
+    class MessageRing {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "MessageRing capacity must be a power of two");
+        static_assert(MaxMessages > 0, "MessageRing must hold at least one message");
+
+    public:
+        /**
+         * @brief Construct a new, empty MessageRing
+         */
+        MessageRing() {
+            _mutex = xSemaphoreCreateMutex();
+        }
+
+        /**
+         * @brief Destroy the MessageRing and clean up resources
+         */
+        ~MessageRing() {
+            if (_mutex) {
+                vSemaphoreDelete(_mutex);
+            }
+        }
+
+        MessageRing(const MessageRing&) = delete;
+        MessageRing& operator=(const MessageRing&) = delete;
+
+        /**
+         * @brief Append bytes to the open message
+         * @param data Bytes to append
+         * @param length Number of bytes to append
+         * @return true if the bytes were stored, false if the message has been discarded
+         *
+         * If there is not enough free space in the ring, the open message is
+         * discarded and all further writes to it are ignored until endMessage()
+         * is called.
+         */
+        bool write(const uint8_t *data, std::size_t length) {
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+            bool result = _write(data, length);
+
+            xSemaphoreGive(_mutex);
+            return result;
+        }
+
+        /**
+         * @brief Append bytes produced by a callback to the open message
+         * @param length Number of bytes to append
+         * @param fill Callback that writes the bytes straight into the ring's storage
+         * @param context Passed to the callback
+         * @return true if the bytes were stored, false if the message has been discarded
+         *
+         * The callback is called once, or twice if the bytes wrap around the end
+         * of the storage, with the ring locked, so it must not use the ring. This
+         * avoids staging data that has to be converted before it is sent.
+         *
+         * Because the ring stays locked while the callback runs, the consumer
+         * and other producers wait for it, with the priority of the waiting
+         * task lent to the caller. A callback that blocks, such as a DMA copy,
+         * therefore holds up the consumer for the whole transfer, even though
+         * the core is free to run tasks that do not use the ring.
+         */
+        bool write(std::size_t length, MessageFillFunction fill, void *context) {
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+            bool result = _fill(length, fill, context);
+
+            xSemaphoreGive(_mutex);
+            return result;
+        }
+
+        /**
+         * @brief Append bytes and a suffix to the open message in one step, optionally closing it
+         * @param data Bytes to append
+         * @param length Number of bytes to append
+         * @param suffix Bytes to append after the data, such as a terminator
+         * @param suffixLength Number of bytes in the suffix
+         * @param endsMessage Whether to close the message afterwards
+         * @return true if the bytes were stored and, if required, the message was queued
+         *
+         * The ring stays locked for the whole sequence, so the bytes of another
+         * producer cannot end up between the data and the suffix, or in the
+         * closed message. Producers that build a message over several calls
+         * must still serialize among themselves.
+         */
+        bool write(const uint8_t *data, std::size_t length, const uint8_t *suffix, std::size_t suffixLength, bool endsMessage) {
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+            bool result = _write(data, length);
+            result = _write(suffix, suffixLength) && result;
+
+            if (endsMessage) {
+                result = _endMessage() && result;
+            }
+
+            xSemaphoreGive(_mutex);
+            return result;
+        }
+
+        /**
+         * @brief Append bytes produced by a callback and a suffix to the open message in one step, optionally closing it
+         * @param length Number of bytes the callback produces
+         * @param fill Callback that writes the bytes straight into the ring's storage
+         * @param context Passed to the callback
+         * @param suffix Bytes to append after the produced ones
+         * @param suffixLength Number of bytes in the suffix
+         * @param endsMessage Whether to close the message afterwards
+         * @return true if the bytes were stored and, if required, the message was queued
+         *
+         * Combines write(length, fill, context) with the single-lock sequence
+         * of the overload above; the same caveats about the callback apply.
+         */
+        bool write(std::size_t length, MessageFillFunction fill, void *context, const uint8_t *suffix, std::size_t suffixLength, bool endsMessage) {
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+            bool result = _fill(length, fill, context);
+            result = _write(suffix, suffixLength) && result;
+
+            if (endsMessage) {
+                result = _endMessage() && result;
+            }
+
+            xSemaphoreGive(_mutex);
+            return result;
+        }
+
+        /**
+         * @brief Close the open message and make it visible to the consumer
+         * @return true if a message was queued, false if it was empty or discarded
+         *
+         * If the message table is full, the message is discarded and counted
+         * as dropped.
+         */
+        bool endMessage() {
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+            bool result = _endMessage();
+
+            xSemaphoreGive(_mutex);
+            return result;
+        }
+
+        /**
+         * @brief Append bytes as a complete message
+         * @param data Bytes of the message
+         * @param length Number of bytes in the message
+         * @return true if the message was queued, false otherwise
+         *
+         * Any bytes already written to the open message become part of this
+         * message.
+         */
+        bool writeMessage(const uint8_t *data, std::size_t length) {
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+            _write(data, length);
+            bool result = _endMessage();
+
+            xSemaphoreGive(_mutex);
+            return result;
+        }
+
+        /**
+         * @brief Check whether bytes can be written without discarding the open message
+         * @param length Number of bytes to be written
+         * @param endsMessage Whether the write will be followed by endMessage()
+         * @return true if there is room for the bytes and, if required, for the message
+         *
+         * Returns false if mutex acquisition fails for safety reasons.
+         */
+        bool canWrite(std::size_t length, bool endsMessage) const {
+            bool result = false;
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) == pdTRUE) {
+                result = !_discarding &&
+                         length <= Capacity - (_writeIndex - _readIndex) &&
+                         (!endsMessage || _messageCount < MaxMessages);
+                xSemaphoreGive(_mutex);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Get the next contiguous chunk of the oldest complete message
+         * @param data Set to the start of the chunk
+         * @param maxLength Maximum number of bytes to return
+         * @param endOfMessage Set to true if the chunk ends the message
+         * @return The number of bytes in the chunk, or 0 if no complete message is queued
+         *
+         * The chunk stops at the end of the message, at the end of the ring's
+         * storage, or after maxLength bytes, whichever comes first. The data is
+         * not removed from the ring until consume() is called.
+         */
+        std::size_t peek(const uint8_t *&data, std::size_t maxLength, bool &endOfMessage) const {
+            std::size_t result = 0;
+            endOfMessage = false;
+
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return 0;
+
+            if (_messageCount > 0) {
+                const std::size_t remaining = _messageEnds[_messageTail] - _readIndex;
+                const std::size_t position = _readIndex & (Capacity - 1);
+
+                result = std::min({remaining, Capacity - position, maxLength});
+                data = &_buffer[position];
+                endOfMessage = (result == remaining);
+            }
+
+            xSemaphoreGive(_mutex);
+            return result;
+        }
+
+        /**
+         * @brief Release bytes previously returned by peek()
+         * @param length Number of bytes to release
+         */
+        void consume(std::size_t length) {
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return;
+
+            if (_messageCount > 0) {
+                _readIndex += std::min(length, _messageEnds[_messageTail] - _readIndex);
+
+                if (_readIndex == _messageEnds[_messageTail]) {
+                    _messageTail = (_messageTail + 1) % MaxMessages;
+                    _messageCount--;
+                }
+            }
+
+            xSemaphoreGive(_mutex);
+        }
+
+        /**
+         * @brief Get the number of complete messages waiting to be read
+         * @return The number of queued messages
+         *
+         * Returns 0 if mutex acquisition fails for safety reasons.
+         */
+        std::size_t messageCount() const {
+            std::size_t result = 0;
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) == pdTRUE) {
+                result = _messageCount;
+                xSemaphoreGive(_mutex);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Get the number of bytes that can still be written
+         * @return The number of free bytes in the ring
+         *
+         * Returns 0 if mutex acquisition fails for safety reasons.
+         */
+        std::size_t freeSpace() const {
+            std::size_t result = 0;
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) == pdTRUE) {
+                result = Capacity - (_writeIndex - _readIndex);
+                xSemaphoreGive(_mutex);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Discard all messages, including the open one, and reset the dropped count
+         */
+        void clear() {
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) == pdTRUE) {
+                _readIndex = 0;
+                _writeIndex = 0;
+                _messageStart = 0;
+                _messageTail = 0;
+                _messageCount = 0;
+                _discarding = false;
+                _droppedCount = 0;
+                xSemaphoreGive(_mutex);
+            }
+        }
+
+        /**
+         * @brief Get the number of messages that have been dropped because they did not fit
+         * @return The total number of messages dropped since construction or last clear
+         *
+         * Returns 0 if mutex acquisition fails.
+         */
+        std::size_t droppedCount() const {
+            std::size_t result = 0;
+            if (xSemaphoreTake(_mutex, portMAX_DELAY) == pdTRUE) {
+                result = _droppedCount;
+                xSemaphoreGive(_mutex);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Get the size of the ring in bytes
+         */
+        static constexpr std::size_t capacity() {
+            return Capacity;
+        }
+
+    protected:
+        bool _reserve(std::size_t length) {
+            if (_discarding) {
+                return false;
+            }
+
+            if (length > Capacity - (_writeIndex - _readIndex)) {
+                // Roll back the open message; it is counted as dropped when it ends
+                _writeIndex = _messageStart;
+                _discarding = true;
+                return false;
+            }
+
+            return true;
+        }
+
+        bool _write(const uint8_t *data, std::size_t length) {
+            if (!_reserve(length)) {
+                return false;
+            }
+
+            if (length == 0) {
+                return true;
+            }
+
+            const std::size_t position = _writeIndex & (Capacity - 1);
+            const std::size_t firstChunk = std::min(length, Capacity - position);
+
+            memcpy(&_buffer[position], data, firstChunk);
+            memcpy(&_buffer[0], data + firstChunk, length - firstChunk);
+
+            _writeIndex += length;
+            return true;
+        }
+
+        bool _fill(std::size_t length, MessageFillFunction fill, void *context) {
+            if (!_reserve(length)) {
+                return false;
+            }
+
+            const std::size_t position = _writeIndex & (Capacity - 1);
+            const std::size_t firstChunk = std::min(length, Capacity - position);
+
+            fill(context, &_buffer[position], 0, firstChunk);
+
+            if (firstChunk < length) {
+                fill(context, &_buffer[0], firstChunk, length - firstChunk);
+            }
+
+            _writeIndex += length;
+            return true;
+        }
+
+        bool _endMessage() {
+            bool result = false;
+
+            if (_discarding || (_writeIndex != _messageStart && _messageCount == MaxMessages)) {
+                _writeIndex = _messageStart;
+                _droppedCount++;
+            } else if (_writeIndex != _messageStart) {
+                _messageEnds[(_messageTail + _messageCount) % MaxMessages] = _writeIndex;
+                _messageCount++;
+                _messageStart = _writeIndex;
+                result = true;
+            }
+
+            _discarding = false;
+            return result;
+        }
+
+        uint8_t _buffer[Capacity];                  ///< Message storage
+        std::size_t _messageEnds[MaxMessages];      ///< End index of each complete message
+        std::size_t _readIndex = 0;                 ///< Index of the next byte to read
+        std::size_t _writeIndex = 0;                ///< Index of the next byte to write
+        std::size_t _messageStart = 0;              ///< Index of the first byte of the open message
+        std::size_t _messageTail = 0;               ///< Slot of the oldest complete message
+        std::size_t _messageCount = 0;              ///< Number of complete messages
+        bool _discarding = false;                   ///< Whether the open message is being discarded
+        std::size_t _droppedCount = 0;              ///< Messages dropped since the last clear
+        SemaphoreHandle_t _mutex;
+    };
+
+} // namespace T76::Core::Utils
+
@@ -0,0 +1,44 @@
+/**
+ * @file placement.hpp
+ * @brief Macros that keep time-critical core 1 code and data out of flash
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Code executed from XIP flash can stall on a cache miss, and stalls for as
+ * long as core 0 erases or programs the flash. For a control loop with a
+ * period of a few tens of microseconds, either adds visible jitter.
+ *
+ * These macros place designated code in SRAM and designated data in the two
+ * 4 kB scratch banks, which sit on their own bus ports and therefore do not
+ * compete with accesses to the striped main SRAM. They rely on the sections
+ * that the SDK's default linker script already provides: `.time_critical.*`
+ * is copied to SRAM at startup, and `.scratch_x.*` and `.scratch_y.*` to the
+ * scratch banks.
+ *
+ * - T76_CORE1_CODE goes between the return type and the name of a function:
+ *
+ *       void T76_CORE1_CODE controlLoop() { ... }
+ *
+ * - T76_CORE1_DATA goes before a static variable used by core 1, and places
+ *   it in SCRATCH_X, which also holds the core 1 stack.
+ * - T76_CORE0_DATA does the same for SCRATCH_Y, which holds the core 0 stack.
+ *
+ * Code in SRAM must only call code that is also in SRAM, or inline functions,
+ * to be immune to flash stalls. t76_add_placement_report() writes a report of
+ * what ended up where after every build.
+ *
+ * The placement is enabled by the T76_IC_CORE1_IN_SRAM CMake option; when it
+ * is off, the macros expand to nothing.
+ *
+ */
+
+#pragma once
+
+#ifdef T76_IC_CORE1_IN_SRAM
+#define T76_CORE1_CODE __attribute__((section(".time_critical.t76")))
+#define T76_CORE1_DATA __attribute__((section(".scratch_x.t76")))
+#define T76_CORE0_DATA __attribute__((section(".scratch_y.t76")))
+#else
+#define T76_CORE1_CODE
+#define T76_CORE1_DATA
+#define T76_CORE0_DATA
+#endif
@@ -0,0 +1,324 @@
+/**
+ * @file ring_queue.hpp
+ * @brief Lock-free, statically allocated ring queue
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * This file implements a fixed-capacity queue that never allocates and never
+ * blocks, so that it can be used from interrupt handlers, from bare-metal code
+ * on core 1 and from FreeRTOS tasks alike. It complements FixedSizeQueue, which
+ * is simpler to use from tasks but takes a mutex and allocates on push.
+ *
+ * The queue is built on per-slot sequence numbers: each slot records which lap
+ * of the ring it is ready for, so a producer knows that a slot is free, and the
+ * consumer knows that it has been written, without a lock shared by both. All
+ * state is in std::atomic<uint32_t> variables, which the Cortex-M33 implements
+ * with exclusive loads and stores. The RP2350 has a global exclusive monitor
+ * for SRAM, so the queue is safe between cores as long as it is placed in SRAM.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+
+namespace T76::Core::Utils {
+
+    /**
+     * @brief What a RingQueue does when an element is pushed while it is full
+     */
+    enum class OverflowPolicy {
+        Reject,         ///< The push fails and the caller keeps the element
+        DropNewest,     ///< The new element is discarded and counted as dropped
+        DropOldest,     ///< The oldest element is discarded to make room and counted as dropped
+    };
+
+    /**
+     * @brief How many contexts may push into a RingQueue concurrently
+     */
+    enum class RingProducers {
+        Single,         ///< One producer; pushes cost a load and two stores
+        Multiple,       ///< Any number of producers, on any core or interrupt
+    };
+
+    /**
+     * @brief A lock-free queue with a capacity fixed at compile time
+     * @tparam T The type of elements stored in the queue; must be default-constructible and movable
+     * @tparam N Number of elements the queue can hold, must be a power of two
+     * @tparam Policy What happens when an element is pushed while the queue is full
+     * @tparam Producers Whether one or several contexts may push at the same time
+     *
+     * There is always a single consumer, which may run on either core and in
+     * either a task or an interrupt handler; it simply must not call tryPop()
+     * from two contexts at once. Producers follow the same rule unless the
+     * queue is declared with RingProducers::Multiple.
+     *
+     * With OverflowPolicy::DropOldest, a producer that finds the queue full
+     * removes the oldest element itself, and removes the next one if another
+     * producer takes the freed slot first. If the consumer or another producer
+     * is removing the oldest element at that moment (for example, because the
+     * producer is an interrupt that preempted it), its slot is about to be
+     * freed but cannot be taken yet, and the new element is dropped instead,
+     * so that a push never waits. Either way, an element is only removed to
+     * make room for one that is stored, and each lost element is counted once
+     * in droppedCount().
+     *
+     * The storage is part of the object, so the queue is usually declared as
+     * a static or as a member of a statically allocated object.
+     */
+    template<typename T, std::size_t N, OverflowPolicy Policy = OverflowPolicy::Reject, RingProducers Producers = RingProducers::Single>
+    class RingQueue {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "RingQueue capacity must be a power of two");
+        static_assert(N <= (std::size_t(1) << 31), "RingQueue capacity must fit in a 32-bit sequence number");
+        static_assert(std::atomic<uint32_t>::is_always_lock_free, "RingQueue requires lock-free 32-bit atomics");
+        static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>, "RingQueue elements must be default-constructible and move-assignable");
+
+    public:
+        /**
+         * @brief Construct a new, empty RingQueue
+         */
+        RingQueue() {
+            for (uint32_t i = 0; i < N; i++) {
+                _slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        RingQueue(const RingQueue&) = delete;
+        RingQueue& operator=(const RingQueue&) = delete;
+
+        /**
+         * @brief Push a new element to the back of the queue (copy version)
+         * @param value The value to be added to the queue
+         * @return true if the element was stored, false if it was rejected or dropped
+         */
+        bool push(const T& value) {
+            return _push(value);
+        }
+
+        /**
+         * @brief Push a new element to the back of the queue (move version)
+         * @param value The value to be moved into the queue
+         * @return true if the element was stored, false if it was rejected or dropped
+         *
+         * The value is only moved from if the element was stored.
+         */
+        bool push(T&& value) {
+            return _push(std::move(value));
+        }
+
+        /**
+         * @brief Try to pop an element from the front of the queue
+         * @param out Reference to store the popped element
+         * @return true if an element was popped, false if the queue is empty
+         *
+         * The element is moved out of the queue. An element that a producer
+         * is still writing is not visible yet, so the queue may look empty
+         * for a moment even though a push has started.
+         */
+        bool tryPop(T& out) {
+            uint32_t position;
+            Slot *slot = _claimOldest(position);
+
+            if (!slot) {
+                return false;
+            }
+
+            out = std::move(slot->value);
+            slot->sequence.store(position + N, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Check if the queue is empty
+         * @return true if the queue is empty, false otherwise
+         *
+         * Only the consumer gets an exact answer; for other contexts the
+         * result may be out of date as soon as it is returned.
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Get the current number of elements in the queue
+         * @return The number of elements in the queue, including those still being written or read
+         */
+        std::size_t size() const {
+            const uint32_t tail = _tail.load(std::memory_order_acquire);
+            const uint32_t head = _head.load(std::memory_order_acquire);
+            const uint32_t count = head - tail;
+
+            // The two indices are not read at once, so a concurrent pop can make head appear behind tail
+            return static_cast<int32_t>(count) < 0 ? 0 : (count > N ? N : count);
+        }
+
+        /**
+         * @brief Remove all elements from the queue and reset the dropped count
+         *
+         * Must be called from the consumer; concurrent pushes either end up in
+         * the queue or are removed.
+         */
+        void clear() {
+            T discarded;
+
+            while (tryPop(discarded)) {
+            }
+
+            _droppedCount.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the number of elements that have been dropped due to overflow
+         * @return The total number of elements dropped since construction or last clear
+         *
+         * Rejected pushes are not counted, since the caller still owns the
+         * element.
+         */
+        std::size_t droppedCount() const {
+            return _droppedCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the number of elements the queue can hold
+         */
+        static constexpr std::size_t capacity() {
+            return N;
+        }
+
+    protected:
+        struct Slot {
+            std::atomic<uint32_t> sequence;     ///< Position the slot is ready for; position + 1 once written
+            T value;
+        };
+
+        // Producers may also remove elements under DropOldest, so the tail is then claimed with a CAS
+        static constexpr bool _sharedTail = (Policy == OverflowPolicy::DropOldest);
+
+        template<typename U>
+        bool _push(U&& value) {
+            uint32_t position;
+            Slot *slot = _claimFree(position);
+
+            if (Policy == OverflowPolicy::DropOldest) {
+                // Drop the element that holds the head's slot. It is the
+                // oldest one, unless the consumer or another producer has
+                // already claimed it and is about to free the slot. If another
+                // producer takes the freed slot first, the queue is full of
+                // newer elements again, so drop the next one.
+                while (!slot) {
+                    uint32_t oldestPosition = position - N;
+                    Slot &oldest = _slots[position & (N - 1)];
+
+                    if (oldest.sequence.load(std::memory_order_acquire) != oldestPosition + 1 ||
+                        !_tail.compare_exchange_strong(oldestPosition, oldestPosition + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+
+                    oldest.value = T();
+                    oldest.sequence.store(position, std::memory_order_release);
+                    _droppedCount.fetch_add(1, std::memory_order_relaxed);
+
+                    slot = _claimFree(position);
+                }
+            }
+
+            if (!slot) {
+                if (Policy != OverflowPolicy::Reject) {
+                    _droppedCount.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                return false;
+            }
+
+            slot->value = std::forward<U>(value);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Reserve the slot at the head of the queue for writing
+         * @param position Set to the position of the reserved slot
+         * @return The slot, or nullptr if the queue is full
+         */
+        Slot *_claimFree(uint32_t &position) {
+            position = _head.load(std::memory_order_relaxed);
+
+            while (true) {
+                Slot &slot = _slots[position & (N - 1)];
+                const int32_t difference = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - position);
+
+                if (difference < 0) {
+                    return nullptr;
+                }
+
+                if (difference == 0) {
+                    if (Producers == RingProducers::Single) {
+                        _head.store(position + 1, std::memory_order_relaxed);
+                        return &slot;
+                    }
+
+                    if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        return &slot;
+                    }
+                } else {
+                    // Another producer took this position
+                    position = _head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Reserve the slot at the tail of the queue for reading
+         * @param position Set to the position of the reserved slot
+         * @return The slot, or nullptr if the queue is empty
+         */
+        Slot *_claimOldest(uint32_t &position) {
+            position = _tail.load(std::memory_order_relaxed);
+
+            while (true) {
+                Slot &slot = _slots[position & (N - 1)];
+                const int32_t difference = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - (position + 1));
+
+                if (difference < 0) {
+                    return nullptr;
+                }
+
+                if (difference == 0) {
+                    if (!_sharedTail) {
+                        _tail.store(position + 1, std::memory_order_relaxed);
+                        return &slot;
+                    }
+
+                    if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        return &slot;
+                    }
+                } else {
+                    // A producer dropped this element
+                    position = _tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        Slot _slots[N];                                 ///< Element storage
+        std::atomic<uint32_t> _head{0};                 ///< Position of the next element to write
+        std::atomic<uint32_t> _tail{0};                 ///< Position of the next element to read
+        std::atomic<uint32_t> _droppedCount{0};         ///< Elements dropped since the last clear
+    };
+
+    /**
+     * @brief A RingQueue with a single producer and a single consumer
+     */
+    template<typename T, std::size_t N, OverflowPolicy Policy = OverflowPolicy::Reject>
+    using SPSCRingQueue = RingQueue<T, N, Policy, RingProducers::Single>;
+
+    /**
+     * @brief A RingQueue with any number of producers and a single consumer
+     */
+    template<typename T, std::size_t N, OverflowPolicy Policy = OverflowPolicy::Reject>
+    using MPSCRingQueue = RingQueue<T, N, Policy, RingProducers::Multiple>;
+
+} // namespace T76::Core::Utils
@@ -0,0 +1,155 @@
+/**
+ * @file timebase.hpp
+ * @brief Shared microsecond timebase of both cores, and its relation to the host's clock
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The framework stamps events with the 64-bit microsecond counter of the
+ * RP2350's timer. Both cores read the same counter, so a sample taken by an
+ * interrupt on core 1 and a command handled by a task on core 0 are on the
+ * same clock, without any exchange between the cores:
+ *
+ *     const uint64_t stamp = T76::Core::Timebase::now();
+ *
+ * now() and now32() read the timer's registers directly, are inlined, and
+ * can be called from code placed in SRAM and from interrupt handlers. Records
+ * that keep 32-bit stamps, such as trace events, flight recorder events and
+ * log records, store now32(), the low half of the same count; extend() turns
+ * such a stamp back into a full one as long as it is less than about 35
+ * minutes old.
+ *
+ * To align data from several instruments, the host periodically measures
+ * its clock against the device's and feeds the result to addSyncPoint():
+ * it notes its own time, asks for the device's time, notes its time again
+ * when the answer arrives, and sends the midpoint of its two readings
+ * together with the device's time and the round trip. The timebase fits the
+ * offset and the drift between the two clocks over the most recent points,
+ * so that toHost() converts any device stamp to host time:
+ *
+ *     int64_t hostUs;
+ *
+ *     if (T76::Core::Timebase::toHost(stamp, hostUs)) {
+ *         // hostUs is on the host's clock
+ *     }
+ *
+ * addSyncPoint() and resetSync() must only be used from one task at a time,
+ * typically the one that runs SCPI commands; toHost(), fromHost() and
+ * syncStatus() can be called from either core at any time.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <hardware/structs/timer.h>
+
+#include <t76/placement.hpp>
+
+
+namespace T76::Core::Timebase {
+
+    /**
+     * @brief Relation between the host's clock and the device's
+     */
+    struct SyncStatus {
+        uint32_t points;            ///< Sync points the estimate is based on, 0 if the host has not synchronized
+        int64_t offsetUs;           ///< Host time minus device time, now
+        int32_t driftPpb;           ///< How much faster the host's clock runs than the device's, in parts per billion
+        uint32_t roundTripUs;       ///< Shortest round trip among the points in use
+        uint64_t lastSyncUs;        ///< Device time of the newest point
+    };
+
+    /**
+     * @brief Get the device time, in microseconds since boot
+     *
+     * Reads the high half of the counter on both sides of the low half, so a
+     * carry between the two reads cannot produce a wrong value.
+     */
+    inline __attribute__((always_inline)) uint64_t now() {
+        uint32_t high = timer_hw->timerawh;
+        uint32_t low;
+
+        for (;;) {
+            low = timer_hw->timerawl;
+            const uint32_t next = timer_hw->timerawh;
+
+            if (next == high) {
+                break;
+            }
+
+            high = next;
+        }
+
+        return (static_cast<uint64_t>(high) << 32) | low;
+    }
+
+    /**
+     * @brief Get the low 32 bits of the device time
+     *
+     * A single register read; the value wraps every 71 minutes.
+     */
+    inline __attribute__((always_inline)) uint32_t now32() {
+        return timer_hw->timerawl;
+    }
+
+    /**
+     * @brief Widen a stamp taken with now32() to a full device time
+     * @param stamp A stamp no more than 2^31 microseconds old
+     */
+    inline __attribute__((always_inline)) uint64_t extend(uint32_t stamp) {
+        const uint64_t current = now();
+
+        return current - static_cast<uint32_t>(static_cast<uint32_t>(current) - stamp);
+    }
+
+    /**
+     * @brief Add a measurement of the host's clock against the device's
+     * @param hostUs Host time at the midpoint of the exchange, in microseconds
+     * @param deviceUs Device time the host read during the exchange
+     * @param roundTripUs Time between the host's two readings
+     * @return false if the point is older than the newest one already added
+     *
+     * The estimate uses the last T76_IC_TIMEBASE_SYNC_POINTS points, leaving
+     * out those whose round trip is more than twice the shortest, since their
+     * midpoint is the least certain. The host can use any epoch, as long as
+     * it keeps to it until resetSync().
+     */
+    bool addSyncPoint(int64_t hostUs, uint64_t deviceUs, uint32_t roundTripUs);
+
+    /**
+     * @brief Forget the sync points, for example after the host's clock was stepped
+     */
+    void resetSync();
+
+    /**
+     * @brief Convert a device time to host time
+     * @param deviceUs Device time, from now() or extend()
+     * @param hostUs Set to the host time, or to deviceUs if the host has not synchronized
+     * @return Whether the host has synchronized
+     */
+    bool T76_CORE1_CODE toHost(uint64_t deviceUs, int64_t &hostUs);
+
+    /**
+     * @brief Convert a host time to device time, for example to schedule an action
+     * @param hostUs Host time
+     * @param deviceUs Set to the device time, or to hostUs if the host has not synchronized
+     * @return Whether the host has synchronized
+     */
+    bool T76_CORE1_CODE fromHost(int64_t hostUs, uint64_t &deviceUs);
+
+    /**
+     * @brief Get the current estimate of the host's clock
+     */
+    SyncStatus syncStatus();
+
+    /**
+     * @brief Format the estimate as a SCPI response
+     *
+     * Suitable as the response to a SYSTem:CLOCk:SYNC? query.
+     *
+     * @return "points,offsetUs,driftPpb,roundTripUs,lastSyncUs"
+     */
+    std::string syncReport();
+
+} // namespace T76::Core::Timebase
@@ -0,0 +1,265 @@
+/**
+ * @file ring_queue_test.cpp
+ * @brief Test of the RingQueue overflow policies.
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * The policies are first checked one push at a time, then with several
+ * producer threads and a consumer thread, which stand in for the tasks,
+ * interrupts and cores that share a queue on the device.
+ *
+ */
+
+#include <t76/ring_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using T76::Core::Utils::MPSCRingQueue;
+using T76::Core::Utils::OverflowPolicy;
+using T76::Core::Utils::SPSCRingQueue;
+
+namespace {
+
+    constexpr int producerCount = 4;
+    constexpr uint32_t pushesPerProducer = 200000;
+
+    void check(const char *name, bool passed, const std::string &detail = "") {
+        if (passed) {
+            std::cout << "✓ " << name << std::endl;
+        } else {
+            std::cout << "✗ " << name << (detail.empty() ? "" : " (" + detail + ")") << std::endl;
+        }
+    }
+
+    /**
+     * @brief An element that runs a hook when a producer drops it.
+     *
+     * Dropping assigns a default-constructed element to the slot, so the
+     * hook runs in the middle of the drop, like an interrupt that preempts
+     * the producer there.
+     */
+    struct Hooked {
+        int value = -1;
+
+        inline static std::function<void()> onDrop;
+
+        Hooked() = default;
+        explicit Hooked(int v) : value(v) {}
+        Hooked(const Hooked &) = default;
+        Hooked &operator=(const Hooked &) = default;
+
+        Hooked &operator=(Hooked &&other) {
+            value = other.value;
+
+            if (other.value == -1 && onDrop) {
+                std::function<void()> hook = std::move(onDrop);
+                onDrop = nullptr;
+                hook();
+            }
+
+            return *this;
+        }
+    };
+
+    template<typename Queue>
+    std::vector<int> drain(Queue &queue) {
+        std::vector<int> values;
+        int value;
+
+        while (queue.tryPop(value)) {
+            values.push_back(value);
+        }
+
+        return values;
+    }
+
+    // Elements carry their producer in the top byte and a sequence number below it
+    uint32_t element(int producer, uint32_t sequence) {
+        return (static_cast<uint32_t>(producer) << 24) | sequence;
+    }
+
+    /**
+     * @brief Totals of a run of concurrent producers and a consumer.
+     */
+    struct ConcurrentResult {
+        uint64_t stored = 0;            // Pushes that returned true
+        uint64_t failed = 0;            // Pushes that returned false
+        uint64_t popped = 0;            // Elements the consumer received
+        bool ordered = true;            // Whether each producer's elements came out in order
+    };
+
+    template<typename Queue>
+    ConcurrentResult runConcurrent(Queue &queue, bool consume) {
+        ConcurrentResult result;
+        std::atomic<uint64_t> stored{0};
+        std::atomic<uint64_t> failed{0};
+        std::atomic<int> running{producerCount};
+        std::vector<std::thread> producers;
+
+        for (int p = 0; p < producerCount; p++) {
+            producers.emplace_back([&, p]() {
+                for (uint32_t i = 0; i < pushesPerProducer; i++) {
+                    if (queue.push(element(p, i))) {
+                        stored.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        failed.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+
+                running.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        std::vector<int64_t> last(producerCount, -1);
+
+        const auto receive = [&](uint32_t value) {
+            const int producer = static_cast<int>(value >> 24);
+            const int64_t sequence = value & 0xFFFFFF;
+
+            if (sequence <= last[producer]) {
+                result.ordered = false;
+            }
+
+            last[producer] = sequence;
+            result.popped++;
+        };
+
+        uint32_t value;
+
+        while (consume && running.load(std::memory_order_acquire) > 0) {
+            if (queue.tryPop(value)) {
+                receive(value);
+            }
+        }
+
+        for (std::thread &producer : producers) {
+            producer.join();
+        }
+
+        while (queue.tryPop(value)) {
+            receive(value);
+        }
+
+        result.stored = stored.load();
+        result.failed = failed.load();
+        return result;
+    }
+
+} // namespace
+
+int main() {
+    std::cout << "=== RingQueue Test ===" << std::endl;
+
+    {
+        SPSCRingQueue<int, 4, OverflowPolicy::Reject> queue;
+
+        for (int i = 0; i < 4; i++) {
+            queue.push(i);
+        }
+
+        check("Reject refuses a push when full", !queue.push(4));
+        check("Reject does not count refused pushes", queue.droppedCount() == 0);
+        check("Reject keeps the stored elements", drain(queue) == std::vector<int>{0, 1, 2, 3});
+    }
+
+    {
+        SPSCRingQueue<int, 4, OverflowPolicy::DropNewest> queue;
+
+        for (int i = 0; i < 6; i++) {
+            queue.push(i);
+        }
+
+        check("DropNewest counts each discarded push", queue.droppedCount() == 2);
+        check("DropNewest keeps the oldest elements", drain(queue) == std::vector<int>{0, 1, 2, 3});
+    }
+
+    {
+        MPSCRingQueue<int, 4, OverflowPolicy::DropOldest> queue;
+        bool stored = true;
+
+        for (int i = 0; i < 6; i++) {
+            stored = queue.push(i) && stored;
+        }
+
+        check("DropOldest stores every push", stored);
+        check("DropOldest counts one element per overflowing push", queue.droppedCount() == 2);
+        check("DropOldest keeps the newest elements", drain(queue) == std::vector<int>{2, 3, 4, 5});
+
+        queue.push(6);
+        check("DropOldest reuses the slots after draining", drain(queue) == std::vector<int>{6});
+
+        queue.clear();
+        check("clear() resets the dropped count", queue.droppedCount() == 0);
+    }
+
+    {
+        MPSCRingQueue<uint32_t, 64, OverflowPolicy::DropNewest> queue;
+        const ConcurrentResult result = runConcurrent(queue, true);
+        const uint64_t pushed = static_cast<uint64_t>(producerCount) * pushesPerProducer;
+
+        check("Concurrent DropNewest accounts for every push",
+              result.popped + queue.droppedCount() == pushed && result.failed == queue.droppedCount(),
+              std::to_string(result.popped) + " popped, " + std::to_string(queue.droppedCount()) + " dropped");
+        check("Concurrent DropNewest keeps each producer's order", result.ordered);
+    }
+
+    {
+        MPSCRingQueue<uint32_t, 64, OverflowPolicy::DropOldest> queue;
+        const ConcurrentResult result = runConcurrent(queue, true);
+        const uint64_t pushed = static_cast<uint64_t>(producerCount) * pushesPerProducer;
+
+        check("Concurrent DropOldest accounts for every push",
+              result.popped + queue.droppedCount() == pushed && result.stored + result.failed == pushed,
+              std::to_string(result.popped) + " popped, " + std::to_string(queue.droppedCount()) + " dropped");
+        check("Concurrent DropOldest keeps each producer's order", result.ordered);
+    }
+
+    {
+        // Without a consumer, an element is only removed to make room for one
+        // that is stored, so the queue ends up full whichever pushes failed
+        MPSCRingQueue<uint32_t, 64, OverflowPolicy::DropOldest> queue;
+        const ConcurrentResult result = runConcurrent(queue, false);
+        const uint64_t pushed = static_cast<uint64_t>(producerCount) * pushesPerProducer;
+
+        check("Racing DropOldest producers leave the queue full",
+              result.popped == queue.capacity() && queue.droppedCount() == pushed - queue.capacity(),
+              std::to_string(result.popped) + " popped, " + std::to_string(queue.droppedCount()) + " dropped");
+        check("Racing DropOldest producers keep each producer's order", result.ordered);
+    }
+
+    {
+        // A producer that preempts another one while it drops the oldest
+        // element cannot take the slot being freed. It must give up its own
+        // element rather than drop the next oldest as well.
+        MPSCRingQueue<Hooked, 4, OverflowPolicy::DropOldest> queue;
+        bool preemptingStored = true;
+
+        for (int i = 0; i < 4; i++) {
+            queue.push(Hooked(i));
+        }
+
+        Hooked::onDrop = [&]() {
+            preemptingStored = queue.push(Hooked(100));
+        };
+
+        const bool stored = queue.push(Hooked(4));
+        std::vector<int> values;
+        Hooked value;
+
+        while (queue.tryPop(value)) {
+            values.push_back(value.value);
+        }
+
+        check("A preempted drop still stores the element", stored);
+        check("The preempting push drops only its own element", !preemptingStored && values == std::vector<int>{1, 2, 3, 4});
+        check("Both lost elements are counted", queue.droppedCount() == 2);
+    }
+
+    std::cout << "\n=== RingQueue Test Complete ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,244 @@
+/**
+ * @file timebase.cpp
+ * @copyright Copyright (c) 2025 MTA, Inc.
+ *
+ * Implementation of the host clock estimate.
+ *
+ * The sync points belong to the writer. Each new point refits the estimate,
+ * which readers on either core pick up through a sequence counter: the
+ * writer makes it odd while it copies a new estimate in, and readers retry
+ * until they see the same even value before and after their copy. The copy
+ * is done with interrupts disabled, so that an interrupt handler on the
+ * writer's core never spins on a half-written estimate.
+ *
+ * The drift is applied as a 32.32 fixed-point fraction, so that conversions
+ * only need a 64-bit multiply and a shift, which keeps them free of library
+ * calls that would live in flash.
+ *
+ */
+
+#include "t76/timebase.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+
+using namespace T76::Core::Timebase;
+
+
+namespace {
+
+    struct SyncPoint {
+        int64_t hostUs;
+        uint64_t deviceUs;
+        uint32_t roundTripUs;
+    };
+
+    struct Estimate {
+        uint64_t referenceDeviceUs;     // Device time at which referenceHostUs applies
+        int64_t referenceHostUs;
+        int64_t driftQ32;               // Drift as a fraction, times 2^32
+        int32_t driftPpb;
+        uint32_t points;                // 0 until the host synchronizes
+        uint32_t roundTripUs;
+    };
+
+    // Points spanning less than this give a drift that is mostly noise
+    constexpr uint64_t minDriftSpanUs = 1000000;
+
+    // A crystal is within a few tens of ppm; anything beyond 1000 ppm is an error
+    constexpr double maxDrift = 1e-3;
+
+    // Writer state
+    SyncPoint gPoints[T76_IC_TIMEBASE_SYNC_POINTS];
+    uint32_t gPointCount = 0;
+    uint32_t gNextPoint = 0;
+    double gDrift = 0;
+
+    Estimate gEstimate = {};
+    std::atomic<uint32_t> gSequence{0};
+
+    void publish(const Estimate &estimate) {
+        taskENTER_CRITICAL();
+
+        const uint32_t sequence = gSequence.load(std::memory_order_relaxed);
+
+        gSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        gEstimate = estimate;
+        gSequence.store(sequence + 2, std::memory_order_release);
+
+        taskEXIT_CRITICAL();
+    }
+
+    Estimate T76_CORE1_CODE read() {
+        Estimate estimate;
+        uint32_t before;
+        uint32_t after;
+
+        do {
+            before = gSequence.load(std::memory_order_acquire);
+            estimate = gEstimate;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = gSequence.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        return estimate;
+    }
+
+    /**
+     * @brief Fit the offset and drift to the points with the shortest round trips
+     */
+    Estimate fit() {
+        const SyncPoint &newest = gPoints[(gNextPoint + T76_IC_TIMEBASE_SYNC_POINTS - 1) % T76_IC_TIMEBASE_SYNC_POINTS];
+        const int64_t newestOffset = newest.hostUs - static_cast<int64_t>(newest.deviceUs);
+        uint32_t shortest = UINT32_MAX;
+
+        for (uint32_t i = 0; i < gPointCount; i++) {
+            shortest = std::min(shortest, gPoints[i].roundTripUs);
+        }
+
+        // Offsets relative to the newest point's, against device time relative to it
+        double sumX = 0;
+        double sumY = 0;
+        uint64_t oldestUs = newest.deviceUs;
+        uint32_t count = 0;
+
+        for (uint32_t i = 0; i < gPointCount; i++) {
+            const SyncPoint &point = gPoints[i];
+
+            if (point.roundTripUs > 2 * static_cast<uint64_t>(shortest)) {
+                continue;
+            }
+
+            sumX += static_cast<double>(static_cast<int64_t>(point.deviceUs - newest.deviceUs));
+            sumY += static_cast<double>(point.hostUs - static_cast<int64_t>(point.deviceUs) - newestOffset);
+            oldestUs = std::min(oldestUs, point.deviceUs);
+            count++;
+        }
+
+        const double meanX = sumX / count;
+        const double meanY = sumY / count;
+
+        if (newest.deviceUs - oldestUs >= minDriftSpanUs) {
+            double sumXX = 0;
+            double sumXY = 0;
+
+            for (uint32_t i = 0; i < gPointCount; i++) {
+                const SyncPoint &point = gPoints[i];
+
+                if (point.roundTripUs > 2 * static_cast<uint64_t>(shortest)) {
+                    continue;
+                }
+
+                const double x = static_cast<double>(static_cast<int64_t>(point.deviceUs - newest.deviceUs)) - meanX;
+                const double y = static_cast<double>(point.hostUs - static_cast<int64_t>(point.deviceUs) - newestOffset) - meanY;
+
+                sumXX += x * x;
+                sumXY += x * y;
+            }
+
+            gDrift = std::clamp(sumXY / sumXX, -maxDrift, maxDrift);
+        }
+
+        return {
+            .referenceDeviceUs = newest.deviceUs,
+            .referenceHostUs = static_cast<int64_t>(newest.deviceUs) + newestOffset + std::llround(meanY - gDrift * meanX),
+            .driftQ32 = std::llround(gDrift * 4294967296.0),
+            .driftPpb = static_cast<int32_t>(std::lround(gDrift * 1e9)),
+            .points = count,
+            .roundTripUs = shortest,
+        };
+    }
+
+} // namespace
+
+
+bool T76::Core::Timebase::addSyncPoint(int64_t hostUs, uint64_t deviceUs, uint32_t roundTripUs) {
+    if (gPointCount != 0) {
+        const SyncPoint &newest = gPoints[(gNextPoint + T76_IC_TIMEBASE_SYNC_POINTS - 1) % T76_IC_TIMEBASE_SYNC_POINTS];
+
+        if (deviceUs <= newest.deviceUs) {
+            return false;
+        }
+    }
+
+    gPoints[gNextPoint] = {hostUs, deviceUs, roundTripUs};
+    gNextPoint = (gNextPoint + 1) % T76_IC_TIMEBASE_SYNC_POINTS;
+    gPointCount = std::min<uint32_t>(gPointCount + 1, T76_IC_TIMEBASE_SYNC_POINTS);
+
+    publish(fit());
+    return true;
+}
+
+void T76::Core::Timebase::resetSync() {
+    gPointCount = 0;
+    gNextPoint = 0;
+    gDrift = 0;
+
+    publish({});
+}
+
+bool T76_CORE1_CODE T76::Core::Timebase::toHost(uint64_t deviceUs, int64_t &hostUs) {
+    const Estimate estimate = read();
+
+    if (estimate.points == 0) {
+        hostUs = static_cast<int64_t>(deviceUs);
+        return false;
+    }
+
+    const int64_t elapsed = static_cast<int64_t>(deviceUs - estimate.referenceDeviceUs);
+
+    hostUs = estimate.referenceHostUs + elapsed + ((elapsed * estimate.driftQ32) >> 32);
+    return true;
+}
+
+bool T76_CORE1_CODE T76::Core::Timebase::fromHost(int64_t hostUs, uint64_t &deviceUs) {
+    const Estimate estimate = read();
+
+    if (estimate.points == 0) {
+        deviceUs = static_cast<uint64_t>(hostUs);
+        return false;
+    }
+
+    // First order inverse of toHost(); the error is the drift squared, below a part per million of a ppm
+    const int64_t elapsed = hostUs - estimate.referenceHostUs;
+
+    deviceUs = estimate.referenceDeviceUs + static_cast<uint64_t>(elapsed - ((elapsed * estimate.driftQ32) >> 32));
+    return true;
+}
+
+SyncStatus T76::Core::Timebase::syncStatus() {
+    const Estimate estimate = read();
+    const uint64_t deviceUs = now();
+    int64_t hostUs;
+
+    toHost(deviceUs, hostUs);
+
+    return {
+        .points = estimate.points,
+        .offsetUs = hostUs - static_cast<int64_t>(deviceUs),
+        .driftPpb = estimate.driftPpb,
+        .roundTripUs = estimate.roundTripUs,
+        .lastSyncUs = estimate.referenceDeviceUs,
+    };
+}
+
+std::string T76::Core::Timebase::syncReport() {
+    const SyncStatus status = syncStatus();
+    char buffer[96];
+
+    snprintf(buffer, sizeof(buffer), "%lu,%lld,%ld,%lu,%llu",
+             (unsigned long)status.points,
+             (long long)status.offsetUs,
+             (long)status.driftPpb,
+             (unsigned long)status.roundTripUs,
+             (unsigned long long)status.lastSyncUs);
+
+    return std::string(buffer);
+}